@@ -444,9 +444,7 @@ class FFXD3D12Backend : public IFFXSharedBackend
 	void* FfxModule;
 	TQueue<TPair<uint64, FFXFrameResources>> FrameResources;
 	uint32 NumPresentsIssued;
-	static double LastTime;
-	static float AverageTime;
-	static float AverageFPS;
+	static FFXFrameTimeStats FrameTimeStats;
 public:
 	static FFXD3D12Backend sFFXD3D12Backend[FFXTechnique::Count];
 
@@ -692,16 +690,12 @@ public:
 		}
 
 		{
-			double CurrentTime = FPlatformTime::Seconds();
-			float FrameTimeMS = (float)((CurrentTime - LastTime) * 1000.0);
-			AverageTime = AverageTime * 0.75f + FrameTimeMS * 0.25f;
-			LastTime = CurrentTime;
-			AverageFPS = 1000.f / AverageTime;
+			FrameTimeStats.AddPresent(FPlatformTime::Seconds(), params->isGeneratedFrame);
 
 			if (CVarFFXFIUpdateGlobalFrameTime.GetValueOnAnyThread() != 0 && (CVarEnableFFXFI.GetValueOnAnyThread() != 0))
 			{
-				GAverageMS = AverageTime;
-				GAverageFPS = AverageFPS;
+				GAverageMS = FrameTimeStats.GetAverageTimeMs();
+				GAverageFPS = FrameTimeStats.GetAverageFPS();
 			}
 		}
 
@@ -789,11 +783,16 @@ public:
 
 	bool GetAverageFrameTimes(float& AvgTimeMs, float& AvgFPS) final
 	{
-		AvgTimeMs = AverageTime;
-		AvgFPS = AverageFPS;
+		AvgTimeMs = FrameTimeStats.GetAverageTimeMs();
+		AvgFPS = FrameTimeStats.GetAverageFPS();
 		return true;
 	}
 
+	FFXFrameTimeStats* GetFrameTimeStats() final
+	{
+		return &FrameTimeStats;
+	}
+
 	void CopySubRect(FfxCommandList CmdList, FfxApiResource Src, FfxApiResource Dst, FIntPoint OutputExtents, FIntPoint OutputPoint) final
 	{
 		ID3D12GraphicsCommandList* pCmdList = (ID3D12GraphicsCommandList*)CmdList;
@@ -841,9 +840,7 @@ public:
 #endif
 	}
 };
-double FFXD3D12Backend::LastTime = FPlatformTime::Seconds();
-float FFXD3D12Backend::AverageTime = 0.f;
-float FFXD3D12Backend::AverageFPS = 0.f;
+FFXFrameTimeStats FFXD3D12Backend::FrameTimeStats;
 FFXD3D12Backend FFXD3D12Backend::sFFXD3D12Backend[FFXTechnique::Count];
 
 //-------------------------------------------------------------------------------------
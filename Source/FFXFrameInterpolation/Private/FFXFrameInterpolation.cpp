@@ -186,9 +186,6 @@ inline void TransitionAndCopyTexture(FRHICommandList& RHICmdList, FRHITexture* S
 //------------------------------------------------------------------------------------------------------
 FFXFrameInterpolation::FFXFrameInterpolation()
 : GameDeltaTime(0.0)
-, LastTime(FPlatformTime::Seconds())
-, AverageTime(0.f)
-, AverageFPS(0.f)
 , InterpolationCount(0llu)
 , PresentCount(0llu)
 , Index(0u)
@@ -235,14 +232,36 @@ bool FFXFrameInterpolation::GetAverageFrameTimes(float& AvgTimeMs, float& AvgFPS
 		}
 		else if (Presenter->GetMode() == EFFXFrameInterpolationPresentModeRHI)
 		{
-			AvgTimeMs = AverageTime;
-			AvgFPS = AverageFPS;
+			AvgTimeMs = FrameTimeStats.GetAverageTimeMs();
+			AvgFPS = FrameTimeStats.GetAverageFPS();
 			bOK = true;
 		}
 	}
 	return bOK;
 }
 
+FFXFrameTimeStats* FFXFrameInterpolation::GetFrameTimeStats()
+{
+	FFXFrameTimeStats* Stats = nullptr;
+	auto* Engine = GEngine;
+	auto GameViewport = Engine ? Engine->GameViewport : nullptr;
+	auto Viewport = GameViewport ? GameViewport->Viewport : nullptr;
+	auto ViewportRHI = Viewport ? Viewport->GetViewportRHI() : nullptr;
+	FFXFrameInterpolationCustomPresent* Presenter = ViewportRHI.IsValid() ? (FFXFrameInterpolationCustomPresent*)ViewportRHI->GetCustomPresent() : nullptr;
+	if (Presenter)
+	{
+		if ((Presenter->GetMode() == EFFXFrameInterpolationPresentModeNative) || Presenter->GetUseFFXSwapchain())
+		{
+			Stats = Presenter->GetBackend()->GetFrameTimeStats();
+		}
+		else if (Presenter->GetMode() == EFFXFrameInterpolationPresentModeRHI)
+		{
+			Stats = &FrameTimeStats;
+		}
+	}
+	return Stats;
+}
+
 void FFXFrameInterpolation::OnViewportCreatedHandler_SetCustomPresent()
 {
     if (GEngine && GEngine->GameViewport)
@@ -268,7 +287,7 @@ void FFXFrameInterpolation::OnBeginDrawHandler()
 	}
 }
 
-void FFXFrameInterpolation::CalculateFPSTimings()
+void FFXFrameInterpolation::CalculateFPSTimings(bool bInterpolated)
 {
 	auto* Engine = GEngine;
 	auto GameViewport = Engine ? Engine->GameViewport : nullptr;
@@ -277,16 +296,12 @@ void FFXFrameInterpolation::CalculateFPSTimings()
 	FFXFrameInterpolationCustomPresent* Presenter = ViewportRHI.IsValid() ? (FFXFrameInterpolationCustomPresent*)ViewportRHI->GetCustomPresent() : nullptr;
 	if (CVarEnableFFXFI.GetValueOnAnyThread() != 0 && Presenter && Presenter->GetMode() == EFFXFrameInterpolationPresentModeRHI)
 	{
-		double CurrentTime = FPlatformTime::Seconds();
-		float FrameTimeMS = (float)((CurrentTime - LastTime) * 1000.0);
-		AverageTime = AverageTime * 0.75f + FrameTimeMS * 0.25f;
-		LastTime = CurrentTime;
-		AverageFPS = 1000.f / AverageTime;
+		FrameTimeStats.AddPresent(FPlatformTime::Seconds(), bInterpolated);
 
 		if (CVarFFXFIUpdateGlobalFrameTime.GetValueOnAnyThread() != 0)
 		{
-			GAverageMS = AverageTime;
-			GAverageFPS = AverageFPS;
+			GAverageMS = FrameTimeStats.GetAverageTimeMs();
+			GAverageFPS = FrameTimeStats.GetAverageFPS();
 		}
 	}
 }
@@ -317,7 +332,7 @@ void FFXFrameInterpolation::OnPostEngineInit()
 		{
 			ENQUEUE_RENDER_COMMAND(BeginFrameRT)([Self](FRHICommandListImmediate& RHICmdList)
 			{
-				Self->CalculateFPSTimings();
+				Self->CalculateFPSTimings(false);
 			});
 		});
 
@@ -1107,7 +1122,7 @@ void FFXFrameInterpolation::OnSlateWindowRendered(SWindow& SlateWindow, void* Vi
 						FFXFrameInterpolationCustomPresent* Presenter = (FFXFrameInterpolationCustomPresent*)Viewport->GetCustomPresent();
 						if (Presenter && BackBufferRT.IsValid())
 						{
-							this->CalculateFPSTimings();
+							this->CalculateFPSTimings(true);
 							FTextureRHIRef InterpolatedFrame = BackBufferRT->GetRHI(GET_RHI_TARGET_ARG);
 							{
 #if UE_VERSION_AT_LEAST(5, 5, 0)
@@ -25,6 +25,7 @@
 #include "SceneViewExtension.h"
 
 #include "IFFXFrameInterpolation.h"
+#include "FFXFrameTimeStats.h"
 
 //-------------------------------------------------------------------------------------
 // Forward declarations.
@@ -59,6 +60,7 @@ public:
 
 	IFFXFrameInterpolationCustomPresent* CreateCustomPresent(IFFXSharedBackend* Backend, uint32_t Flags, FIntPoint RenderSize, FIntPoint DisplaySize, FfxSwapchain RawSwapChain, FfxCommandQueue Queue, FfxApiSurfaceFormat Format, EFFXBackendAPI Api) final;
 	bool GetAverageFrameTimes(float& AvgTimeMs, float& AvgFPS) final;
+	FFXFrameTimeStats* GetFrameTimeStats() final;
 
 private:
 	struct FFXFrameInterpolationView
@@ -76,7 +78,7 @@ private:
 		bool bReset;
 		bool bEnabled;
 	};
-	void CalculateFPSTimings();
+	void CalculateFPSTimings(bool bInterpolated);
 	bool InterpolateView(FRDGBuilder& GraphBuilder, FFXFrameInterpolationCustomPresent* Presenter, const FSceneView* View, FFXFrameInterpolationView const& ViewDesc, FRDGTextureRef FinalBuffer, FRDGTextureRef InterpolatedRDG, FRDGTextureRef BackBufferRDG, uint32 Index);
 	TMap<const FSceneView*, FFXFrameInterpolationView> Views;
 	TSharedPtr<FFXFrameInterpolationViewExtension, ESPMode::ThreadSafe> ViewExtension;
@@ -86,9 +88,7 @@ private:
 	TMap<FfxSwapchain, FFXFrameInterpolationCustomPresent*> SwapChains;
 	TMap<SWindow*, FRHIViewport*> Windows;
 	float GameDeltaTime;
-	double LastTime;
-	float AverageTime;
-	float AverageFPS;
+	FFXFrameTimeStats FrameTimeStats;
 	uint64 InterpolationCount;
 	uint64 PresentCount;
 	uint32 Index;
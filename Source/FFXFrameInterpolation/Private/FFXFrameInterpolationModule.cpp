@@ -24,8 +24,12 @@
 #include "FFXFrameInterpolation.h"
 
 #include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #if UE_VERSION_AT_LEAST(5, 1, 0)
 #include "Misc/ConfigUtilities.h"
 #endif
@@ -36,6 +40,55 @@ IMPLEMENT_MODULE(FFXFrameInterpolationModule, FFXFrameInterpolation)
 
 DEFINE_LOG_CATEGORY(LogFFXFI);
 
+//------------------------------------------------------------------------------------------------------
+// Console commands to export & reset the frame time statistics.
+//------------------------------------------------------------------------------------------------------
+static FFXFrameTimeStats* GetFFXFrameTimeStats()
+{
+	IFFXFrameInterpolationModule* Module = FModuleManager::GetModulePtr<IFFXFrameInterpolationModule>(TEXT("FFXFrameInterpolation"));
+	IFFXFrameInterpolation* Impl = Module ? Module->GetImpl() : nullptr;
+	return Impl ? Impl->GetFrameTimeStats() : nullptr;
+}
+
+static FAutoConsoleCommand CmdFFXFIDumpFrameTimeStats(
+	TEXT("r.FidelityFX.FI.DumpFrameTimeStats"),
+	TEXT("Write the frame time samples (CSV) and the percentile & pacing error summary (JSON) for frame interpolation to the profiling directory."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FFXFrameTimeStats* Stats = GetFFXFrameTimeStats();
+		if (Stats)
+		{
+			FString BaseName = FPaths::ProfilingDir() / TEXT("FidelityFX") / FString::Printf(TEXT("FrameTimes-%s"), *FDateTime::Now().ToString());
+			FString CSV, JSON;
+			Stats->ExportCSV(CSV);
+			Stats->ExportJSON(JSON);
+			if (FFileHelper::SaveStringToFile(CSV, *(BaseName + TEXT(".csv"))) && FFileHelper::SaveStringToFile(JSON, *(BaseName + TEXT(".json"))))
+			{
+				UE_LOG(LogFFXFI, Log, TEXT("Frame time statistics written to %s.[csv|json]"), *BaseName);
+			}
+			else
+			{
+				UE_LOG(LogFFXFI, Warning, TEXT("Failed to write frame time statistics to %s"), *BaseName);
+			}
+		}
+		else
+		{
+			UE_LOG(LogFFXFI, Warning, TEXT("Frame time statistics are unavailable, frame interpolation is not presenting."));
+		}
+	}));
+
+static FAutoConsoleCommand CmdFFXFIResetFrameTimeStats(
+	TEXT("r.FidelityFX.FI.ResetFrameTimeStats"),
+	TEXT("Reset the frame interpolation frame time statistics."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FFXFrameTimeStats* Stats = GetFFXFrameTimeStats();
+		if (Stats)
+		{
+			Stats->Reset();
+		}
+	}));
+
 void FFXFrameInterpolationModule::StartupModule()
 {
 	Impl = new FFXFrameInterpolation;
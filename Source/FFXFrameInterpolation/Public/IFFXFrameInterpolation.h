@@ -30,6 +30,7 @@ class FViewport;
 class FRHIViewport;
 typedef TRefCountPtr<FRHIViewport> FViewportRHIRef;
 class IFFXSharedBackend;
+class FFXFrameTimeStats;
 enum class EFFXBackendAPI : uint8;
 
 enum EFFXFrameInterpolationPresentMode
@@ -51,4 +52,5 @@ class IFFXFrameInterpolation
 public:
 	virtual IFFXFrameInterpolationCustomPresent* CreateCustomPresent(IFFXSharedBackend* Backend, uint32_t Flags, FIntPoint RenderSize, FIntPoint DisplaySize, FfxSwapchain RawSwapChain, FfxCommandQueue Queue, FfxApiSurfaceFormat Format, EFFXBackendAPI Api) = 0;
 	virtual bool GetAverageFrameTimes(float& AvgTimeMs, float& AvgFPS) = 0;
+	virtual FFXFrameTimeStats* GetFrameTimeStats() = 0;
 };
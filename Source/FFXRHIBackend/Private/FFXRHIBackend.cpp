@@ -1587,6 +1587,11 @@ bool FFXRHIBackend::GetAverageFrameTimes(float& AvgTimeMs, float& AvgFPS)
 	return false;
 }
 
+FFXFrameTimeStats* FFXRHIBackend::GetFrameTimeStats()
+{
+	return nullptr;
+}
+
 void FFXRHIBackend::CopySubRect(FfxCommandList CmdList, FfxApiResource Src, FfxApiResource Dst, FIntPoint OutputExtents, FIntPoint OutputPoint)
 {
 	// Deliberately blank
@@ -160,6 +160,7 @@ public:
 	void* GetInterpolationCommandList(FfxSwapchain SwapChain) final;
 	void RegisterFrameResources(FRHIResource* FIResources, uint64 FrameID) final;
 	bool GetAverageFrameTimes(float& AvgTimeMs, float& AvgFPS) final;
+	FFXFrameTimeStats* GetFrameTimeStats() final;
 	void CopySubRect(FfxCommandList CmdList, FfxApiResource Src, FfxApiResource Dst, FIntPoint OutputExtents, FIntPoint OutputPoint) final;
 	void Flush(FRHITexture* Tex, FRHICommandListImmediate& RHICmdList) final;
 };
@@ -0,0 +1,369 @@
+// This file is part of the FidelityFX Super Resolution 4.0 Unreal Engine Plugin.
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "FFXFrameTimeStats.h"
+
+#include "Algo/Sort.h"
+
+//------------------------------------------------------------------------------------------------------
+// Upper bounds of the pacing error histogram buckets in milliseconds.
+//------------------------------------------------------------------------------------------------------
+static const float GFFXPacingBucketLimitsMs[FFXFrameTimeSummary::NumPacingBuckets] = {
+	0.1f, 0.25f, 0.5f, 1.f, 2.f, 4.f, 8.f, 16.f, 32.f, 64.f, 128.f, FLT_MAX
+};
+
+//------------------------------------------------------------------------------------------------------
+// P-Square quantile estimator.
+//------------------------------------------------------------------------------------------------------
+FFXQuantileEstimator::FFXQuantileEstimator(float InQuantile)
+: Quantile(InQuantile)
+{
+	Reset();
+}
+
+void FFXQuantileEstimator::Reset()
+{
+	Count = 0;
+	for (int32 i = 0; i < 5; i++)
+	{
+		Heights[i] = 0.f;
+		Positions[i] = (float)(i + 1);
+	}
+	Desired[0] = 1.f;
+	Desired[1] = 1.f + 2.f * Quantile;
+	Desired[2] = 1.f + 4.f * Quantile;
+	Desired[3] = 3.f + 2.f * Quantile;
+	Desired[4] = 5.f;
+	Increments[0] = 0.f;
+	Increments[1] = Quantile / 2.f;
+	Increments[2] = Quantile;
+	Increments[3] = (1.f + Quantile) / 2.f;
+	Increments[4] = 1.f;
+}
+
+float FFXQuantileEstimator::Parabolic(int32 i, float d) const
+{
+	return Heights[i] + d / (Positions[i + 1] - Positions[i - 1]) *
+		((Positions[i] - Positions[i - 1] + d) * (Heights[i + 1] - Heights[i]) / (Positions[i + 1] - Positions[i]) +
+		 (Positions[i + 1] - Positions[i] - d) * (Heights[i] - Heights[i - 1]) / (Positions[i] - Positions[i - 1]));
+}
+
+float FFXQuantileEstimator::Linear(int32 i, int32 d) const
+{
+	return Heights[i] + (float)d * (Heights[i + d] - Heights[i]) / (Positions[i + d] - Positions[i]);
+}
+
+void FFXQuantileEstimator::Add(float Value)
+{
+	// The first five samples seed the markers directly.
+	if (Count < 5)
+	{
+		Heights[Count++] = Value;
+		if (Count == 5)
+		{
+			Algo::Sort(MakeArrayView(Heights, 5));
+		}
+		return;
+	}
+	Count++;
+
+	int32 k = 0;
+	if (Value < Heights[0])
+	{
+		Heights[0] = Value;
+		k = 0;
+	}
+	else if (Value >= Heights[4])
+	{
+		Heights[4] = Value;
+		k = 3;
+	}
+	else
+	{
+		for (k = 0; k < 3 && Value >= Heights[k + 1]; k++)
+		{
+		}
+	}
+
+	for (int32 i = k + 1; i < 5; i++)
+	{
+		Positions[i] += 1.f;
+	}
+	for (int32 i = 0; i < 5; i++)
+	{
+		Desired[i] += Increments[i];
+	}
+
+	// Move the three middle markers towards their desired positions.
+	for (int32 i = 1; i < 4; i++)
+	{
+		float d = Desired[i] - Positions[i];
+		if ((d >= 1.f && Positions[i + 1] - Positions[i] > 1.f) || (d <= -1.f && Positions[i - 1] - Positions[i] < -1.f))
+		{
+			int32 Sign = d > 0.f ? 1 : -1;
+			float Candidate = Parabolic(i, (float)Sign);
+			if (Heights[i - 1] < Candidate && Candidate < Heights[i + 1])
+			{
+				Heights[i] = Candidate;
+			}
+			else
+			{
+				Heights[i] = Linear(i, Sign);
+			}
+			Positions[i] += (float)Sign;
+		}
+	}
+}
+
+float FFXQuantileEstimator::Get() const
+{
+	if (Count == 0)
+	{
+		return 0.f;
+	}
+	else if (Count < 5)
+	{
+		float Sorted[5];
+		FMemory::Memcpy(Sorted, Heights, sizeof(float) * Count);
+		Algo::Sort(MakeArrayView(Sorted, Count));
+		return Sorted[FMath::Clamp(FMath::RoundToInt(Quantile * (float)(Count - 1)), 0, (int32)Count - 1)];
+	}
+	return Heights[2];
+}
+
+//------------------------------------------------------------------------------------------------------
+// Frame time statistics.
+//------------------------------------------------------------------------------------------------------
+FFXFrameTimeStats::FFXFrameTimeStats()
+: WriteIndex(0llu)
+, FirstIndex(0llu)
+, ResetRequested(0u)
+, P50(0.50f)
+, P95(0.95f)
+, P99(0.99f)
+, LastPresentTime(0.0)
+, ExpectedTimeMs(0.f)
+, TotalTimeMs(0.0)
+, NumFrames(0llu)
+, NumInterpolatedFrames(0llu)
+, AverageTimeMs(0.f)
+, AverageFPS(0.f)
+, MeanTimeMs(0.f)
+, P50Ms(0.f)
+, P95Ms(0.f)
+, P99Ms(0.f)
+, MaxPacingErrorMs(0.f)
+{
+	for (FSlot& Slot : Ring)
+	{
+		Slot.Sequence.store(0llu, std::memory_order_relaxed);
+	}
+	for (std::atomic<uint32>& Bucket : PacingHistogram)
+	{
+		Bucket.store(0u, std::memory_order_relaxed);
+	}
+}
+
+float FFXFrameTimeStats::GetPacingBucketLimitMs(uint32 Bucket)
+{
+	return GFFXPacingBucketLimitsMs[FMath::Min(Bucket, FFXFrameTimeSummary::NumPacingBuckets - 1)];
+}
+
+void FFXFrameTimeStats::Reset()
+{
+	ResetRequested.store(1u, std::memory_order_release);
+}
+
+void FFXFrameTimeStats::ApplyReset()
+{
+	P50.Reset();
+	P95.Reset();
+	P99.Reset();
+	ExpectedTimeMs = 0.f;
+	TotalTimeMs = 0.0;
+	NumFrames.store(0llu, std::memory_order_relaxed);
+	NumInterpolatedFrames.store(0llu, std::memory_order_relaxed);
+	MeanTimeMs.store(0.f, std::memory_order_relaxed);
+	P50Ms.store(0.f, std::memory_order_relaxed);
+	P95Ms.store(0.f, std::memory_order_relaxed);
+	P99Ms.store(0.f, std::memory_order_relaxed);
+	MaxPacingErrorMs.store(0.f, std::memory_order_relaxed);
+	for (std::atomic<uint32>& Bucket : PacingHistogram)
+	{
+		Bucket.store(0u, std::memory_order_relaxed);
+	}
+	// Samples already in the ring are left alone, readers only look at the ones written after the reset.
+	FirstIndex.store(WriteIndex.load(std::memory_order_relaxed), std::memory_order_release);
+	ResetRequested.store(0u, std::memory_order_release);
+}
+
+void FFXFrameTimeStats::AddPresent(double PresentTime, bool bInterpolated)
+{
+	if (ResetRequested.load(std::memory_order_acquire) != 0)
+	{
+		ApplyReset();
+	}
+
+	if (LastPresentTime == 0.0)
+	{
+		LastPresentTime = PresentTime;
+		return;
+	}
+
+	float FrameTimeMS = (float)((PresentTime - LastPresentTime) * 1000.0);
+	LastPresentTime = PresentTime;
+
+	// Keep the same exponential moving average as before so GetAverageFrameTimes is unchanged.
+	float Average = AverageTimeMs.load(std::memory_order_relaxed);
+	Average = Average * 0.75f + FrameTimeMS * 0.25f;
+	AverageTimeMs.store(Average, std::memory_order_relaxed);
+	AverageFPS.store(1000.f / Average, std::memory_order_relaxed);
+
+	// Pacing error is the deviation of this present from the expected interval.
+	float PacingErrorMs = ExpectedTimeMs > 0.f ? FMath::Abs(FrameTimeMS - ExpectedTimeMs) : 0.f;
+	ExpectedTimeMs = ExpectedTimeMs > 0.f ? ExpectedTimeMs * 0.9f + FrameTimeMS * 0.1f : FrameTimeMS;
+
+	uint32 Bucket = 0;
+	while (PacingErrorMs > GFFXPacingBucketLimitsMs[Bucket] && Bucket < FFXFrameTimeSummary::NumPacingBuckets - 1)
+	{
+		Bucket++;
+	}
+	PacingHistogram[Bucket].fetch_add(1u, std::memory_order_relaxed);
+	if (PacingErrorMs > MaxPacingErrorMs.load(std::memory_order_relaxed))
+	{
+		MaxPacingErrorMs.store(PacingErrorMs, std::memory_order_relaxed);
+	}
+
+	P50.Add(FrameTimeMS);
+	P95.Add(FrameTimeMS);
+	P99.Add(FrameTimeMS);
+	P50Ms.store(P50.Get(), std::memory_order_relaxed);
+	P95Ms.store(P95.Get(), std::memory_order_relaxed);
+	P99Ms.store(P99.Get(), std::memory_order_relaxed);
+
+	TotalTimeMs += FrameTimeMS;
+	uint64 Frames = NumFrames.load(std::memory_order_relaxed) + 1;
+	MeanTimeMs.store((float)(TotalTimeMs / (double)Frames), std::memory_order_relaxed);
+	NumFrames.store(Frames, std::memory_order_relaxed);
+	if (bInterpolated)
+	{
+		NumInterpolatedFrames.fetch_add(1llu, std::memory_order_relaxed);
+	}
+
+	// Sequence is odd while the slot is being written and 2 * (Index + 1) once it is complete.
+	uint64 Index = WriteIndex.load(std::memory_order_relaxed);
+	FSlot& Slot = Ring[Index % RingSize];
+	Slot.Sequence.store(Index * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Slot.Sample.PresentTime = PresentTime;
+	Slot.Sample.FrameTimeMs = FrameTimeMS;
+	Slot.Sample.PacingErrorMs = PacingErrorMs;
+	Slot.Sample.bInterpolated = bInterpolated;
+	Slot.Sequence.store(Index * 2 + 2, std::memory_order_release);
+	WriteIndex.store(Index + 1, std::memory_order_release);
+}
+
+void FFXFrameTimeStats::GetSummary(FFXFrameTimeSummary& OutSummary) const
+{
+	OutSummary.NumFrames = NumFrames.load(std::memory_order_relaxed);
+	OutSummary.NumInterpolatedFrames = NumInterpolatedFrames.load(std::memory_order_relaxed);
+	OutSummary.AverageMs = MeanTimeMs.load(std::memory_order_relaxed);
+	OutSummary.AverageFPS = OutSummary.AverageMs > 0.f ? 1000.f / OutSummary.AverageMs : 0.f;
+	OutSummary.P50Ms = P50Ms.load(std::memory_order_relaxed);
+	OutSummary.P95Ms = P95Ms.load(std::memory_order_relaxed);
+	OutSummary.P99Ms = P99Ms.load(std::memory_order_relaxed);
+	OutSummary.OnePercentLowFPS = OutSummary.P99Ms > 0.f ? 1000.f / OutSummary.P99Ms : 0.f;
+	OutSummary.MaxPacingErrorMs = MaxPacingErrorMs.load(std::memory_order_relaxed);
+	for (uint32 i = 0; i < FFXFrameTimeSummary::NumPacingBuckets; i++)
+	{
+		OutSummary.PacingHistogram[i] = PacingHistogram[i].load(std::memory_order_relaxed);
+	}
+}
+
+uint32 FFXFrameTimeStats::GetSamples(TArray<FFXFrameTimeSample>& OutSamples) const
+{
+	uint64 End = WriteIndex.load(std::memory_order_acquire);
+	uint64 Begin = FMath::Max<uint64>(End > RingSize ? End - RingSize : 0llu, FirstIndex.load(std::memory_order_acquire));
+	OutSamples.Reset((int32)(End - Begin));
+
+	for (uint64 Index = Begin; Index < End; Index++)
+	{
+		const FSlot& Slot = Ring[Index % RingSize];
+		uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+		if (Sequence != Index * 2 + 2)
+		{
+			// Overwritten by the producer since WriteIndex was read.
+			continue;
+		}
+		FFXFrameTimeSample Sample = Slot.Sample;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) == Sequence)
+		{
+			OutSamples.Add(Sample);
+		}
+	}
+	return (uint32)OutSamples.Num();
+}
+
+bool FFXFrameTimeStats::ExportCSV(FString& OutString) const
+{
+	TArray<FFXFrameTimeSample> Samples;
+	GetSamples(Samples);
+
+	OutString = TEXT("PresentTime,FrameTimeMs,PacingErrorMs,Interpolated\n");
+	for (const FFXFrameTimeSample& Sample : Samples)
+	{
+		OutString += FString::Printf(TEXT("%.6f,%.4f,%.4f,%d\n"), Sample.PresentTime, Sample.FrameTimeMs, Sample.PacingErrorMs, Sample.bInterpolated ? 1 : 0);
+	}
+	return Samples.Num() > 0;
+}
+
+bool FFXFrameTimeStats::ExportJSON(FString& OutString) const
+{
+	FFXFrameTimeSummary Summary;
+	GetSummary(Summary);
+
+	OutString = TEXT("{\n");
+	OutString += FString::Printf(TEXT("\t\"NumFrames\": %llu,\n"), Summary.NumFrames);
+	OutString += FString::Printf(TEXT("\t\"NumInterpolatedFrames\": %llu,\n"), Summary.NumInterpolatedFrames);
+	OutString += FString::Printf(TEXT("\t\"AverageMs\": %.4f,\n"), Summary.AverageMs);
+	OutString += FString::Printf(TEXT("\t\"AverageFPS\": %.4f,\n"), Summary.AverageFPS);
+	OutString += FString::Printf(TEXT("\t\"P50Ms\": %.4f,\n"), Summary.P50Ms);
+	OutString += FString::Printf(TEXT("\t\"P95Ms\": %.4f,\n"), Summary.P95Ms);
+	OutString += FString::Printf(TEXT("\t\"P99Ms\": %.4f,\n"), Summary.P99Ms);
+	OutString += FString::Printf(TEXT("\t\"OnePercentLowFPS\": %.4f,\n"), Summary.OnePercentLowFPS);
+	OutString += FString::Printf(TEXT("\t\"MaxPacingErrorMs\": %.4f,\n"), Summary.MaxPacingErrorMs);
+	OutString += TEXT("\t\"PacingHistogram\": [\n");
+	for (uint32 i = 0; i < FFXFrameTimeSummary::NumPacingBuckets; i++)
+	{
+		bool const bLast = (i == FFXFrameTimeSummary::NumPacingBuckets - 1);
+		if (bLast)
+		{
+			OutString += FString::Printf(TEXT("\t\t{ \"MaxMs\": null, \"Count\": %u }\n"), Summary.PacingHistogram[i]);
+		}
+		else
+		{
+			OutString += FString::Printf(TEXT("\t\t{ \"MaxMs\": %.2f, \"Count\": %u },\n"), GFFXPacingBucketLimitsMs[i], Summary.PacingHistogram[i]);
+		}
+	}
+	OutString += TEXT("\t]\n}\n");
+	return Summary.NumFrames > 0;
+}
@@ -0,0 +1,145 @@
+// This file is part of the FidelityFX Super Resolution 4.0 Unreal Engine Plugin.
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+//-------------------------------------------------------------------------------------
+// A single present recorded by FFXFrameTimeStats.
+//-------------------------------------------------------------------------------------
+struct FFXFrameTimeSample
+{
+	double PresentTime;
+	float FrameTimeMs;
+	float PacingErrorMs;
+	bool bInterpolated;
+};
+
+//-------------------------------------------------------------------------------------
+// Snapshot of the aggregate statistics, all times are in milliseconds.
+//-------------------------------------------------------------------------------------
+struct FFXFrameTimeSummary
+{
+	static constexpr uint32 NumPacingBuckets = 12;
+
+	uint64 NumFrames;
+	uint64 NumInterpolatedFrames;
+	float AverageMs;
+	float AverageFPS;
+	float P50Ms;
+	float P95Ms;
+	float P99Ms;
+	float OnePercentLowFPS;
+	float MaxPacingErrorMs;
+	uint32 PacingHistogram[NumPacingBuckets];
+};
+
+//-------------------------------------------------------------------------------------
+// Streaming quantile estimator using the P-Square algorithm (Jain & Chlamtac).
+// Needs constant memory and O(1) work per sample.
+//-------------------------------------------------------------------------------------
+class FFXSHARED_API FFXQuantileEstimator
+{
+public:
+	explicit FFXQuantileEstimator(float InQuantile);
+
+	void Reset();
+	void Add(float Value);
+	float Get() const;
+
+private:
+	float Parabolic(int32 i, float d) const;
+	float Linear(int32 i, int32 d) const;
+
+	float Quantile;
+	float Heights[5];
+	float Positions[5];
+	float Desired[5];
+	float Increments[5];
+	uint32 Count;
+};
+
+//-------------------------------------------------------------------------------------
+// Per-present frame time statistics for frame generation.
+// Samples are written by a single producer (the thread that presents) into a fixed
+// ring and the aggregate values are published through atomics, so readers on any
+// thread never block the present.
+//-------------------------------------------------------------------------------------
+class FFXSHARED_API FFXFrameTimeStats
+{
+public:
+	static constexpr uint32 RingSize = 4096;
+
+	FFXFrameTimeStats();
+
+	// Producer side, must only be called from one thread at a time.
+	void AddPresent(double PresentTime, bool bInterpolated);
+
+	// Consumer side, safe from any thread. Reset is applied by the producer on the next present.
+	void Reset();
+	float GetAverageTimeMs() const { return AverageTimeMs.load(std::memory_order_relaxed); }
+	float GetAverageFPS() const { return AverageFPS.load(std::memory_order_relaxed); }
+	void GetSummary(FFXFrameTimeSummary& OutSummary) const;
+	uint32 GetSamples(TArray<FFXFrameTimeSample>& OutSamples) const;
+
+	bool ExportCSV(FString& OutString) const;
+	bool ExportJSON(FString& OutString) const;
+
+	// Upper bound in milliseconds of each pacing error bucket, the last bucket is unbounded.
+	static float GetPacingBucketLimitMs(uint32 Bucket);
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence;
+		FFXFrameTimeSample Sample;
+	};
+
+	FSlot Ring[RingSize];
+	std::atomic<uint64> WriteIndex;
+	std::atomic<uint64> FirstIndex;
+	std::atomic<uint32> ResetRequested;
+
+	// Producer owned state.
+	void ApplyReset();
+
+	FFXQuantileEstimator P50;
+	FFXQuantileEstimator P95;
+	FFXQuantileEstimator P99;
+	double LastPresentTime;
+	float ExpectedTimeMs;
+	double TotalTimeMs;
+
+	// Published state.
+	std::atomic<uint64> NumFrames;
+	std::atomic<uint64> NumInterpolatedFrames;
+	std::atomic<float> AverageTimeMs;
+	std::atomic<float> AverageFPS;
+	std::atomic<float> MeanTimeMs;
+	std::atomic<float> P50Ms;
+	std::atomic<float> P95Ms;
+	std::atomic<float> P99Ms;
+	std::atomic<float> MaxPacingErrorMs;
+	std::atomic<uint32> PacingHistogram[FFXFrameTimeSummary::NumPacingBuckets];
+};
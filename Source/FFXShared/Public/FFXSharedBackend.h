@@ -22,6 +22,7 @@
 #pragma once
 
 #include "FFXShared.h"
+#include "FFXFrameTimeStats.h"
 
 #include "Modules/ModuleManager.h"
 #if UE_VERSION_AT_LEAST(5, 2, 0)
@@ -106,6 +107,7 @@ public:
 	virtual void* GetInterpolationCommandList(FfxSwapchain SwapChain) = 0;
 	virtual void RegisterFrameResources(FRHIResource* FIResources, uint64 FrameID) = 0;
 	virtual bool GetAverageFrameTimes(float& AvgTimeMs, float& AvgFPS) = 0;
+	virtual FFXFrameTimeStats* GetFrameTimeStats() = 0;
 	virtual void CopySubRect(FfxCommandList CmdList, FfxApiResource Src, FfxApiResource Dst, FIntPoint OutputExtents, FIntPoint OutputPoint) = 0;
 	virtual void Flush(FRHITexture* Tex, FRHICommandListImmediate& RHICmdList) = 0;
 
@@ -45,6 +45,14 @@ struct ffxCreateBackendVKDesc
     PFN_vkGetDeviceProcAddr    vkDeviceProcAddr;  ///< function pointer to get device procedure addresses
 };
 
+#define FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_ENABLED_FEATURES 0x0000004u
+/// Optional, chained with ffxCreateBackendVKDesc. Without it the backend assumes no optional device features were enabled.
+struct ffxCreateBackendVKEnabledFeaturesDesc
+{
+    ffxCreateContextDescHeader header;
+    const void*                pEnabledFeatures;  ///< the pNext chain of feature structures the logical device was created with.
+};
+
 #define FFX_API_EFFECT_ID_FGSC_VK 0x00040000u
 
 #define FFX_API_CREATE_CONTEXT_DESC_TYPE_FGSWAPCHAIN_VK 0x40001u
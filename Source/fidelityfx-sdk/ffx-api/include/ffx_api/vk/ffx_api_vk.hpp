@@ -35,6 +35,11 @@ struct struct_type<ffxCreateBackendVKDesc> : std::integral_constant<uint64_t, FF
 
 struct CreateBackendVKDesc : public InitHelper<ffxCreateBackendVKDesc> {};
 
+template<>
+struct struct_type<ffxCreateBackendVKEnabledFeaturesDesc> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_ENABLED_FEATURES> {};
+
+struct CreateBackendVKEnabledFeaturesDesc : public InitHelper<ffxCreateBackendVKEnabledFeaturesDesc> {};
+
 template<>
 struct struct_type<ffxCreateContextDescFrameGenerationSwapChainVK> : std::integral_constant<uint64_t, FFX_API_CREATE_CONTEXT_DESC_TYPE_FGSWAPCHAIN_VK> {};
 
@@ -31,6 +31,30 @@
 #include <FidelityFX/host/backends/vk/ffx_vk.h>
 #endif // #ifdef FFX_BACKEND_VK
 
+#ifdef FFX_BACKEND_VK
+// The backend only records synchronization2 barriers when the application enabled the feature on its device
+static VkBool32 GetSynchronization2EnabledVK(const ffxCreateContextDescHeader* desc)
+{
+    for (const auto* it = desc->pNext; it; it = it->pNext)
+    {
+        if (it->type != FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_ENABLED_FEATURES)
+            continue;
+
+        const auto* featuresDesc = reinterpret_cast<const ffxCreateBackendVKEnabledFeaturesDesc*>(it);
+        for (const auto* feature = static_cast<const VkBaseInStructure*>(featuresDesc->pEnabledFeatures); feature; feature = feature->pNext)
+        {
+            if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR &&
+                reinterpret_cast<const VkPhysicalDeviceSynchronization2FeaturesKHR*>(feature)->synchronization2)
+                return VK_TRUE;
+            if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES &&
+                reinterpret_cast<const VkPhysicalDeviceVulkan13Features*>(feature)->synchronization2)
+                return VK_TRUE;
+        }
+    }
+    return VK_FALSE;
+}
+#endif // FFX_BACKEND_VK
+
 ffxReturnCode_t CreateBackend(const ffxCreateContextDescHeader *desc, bool& backendFound, FfxInterface *iface, size_t contexts, Allocator& alloc)
 {
     for (const auto* it = desc->pNext; it; it = it->pNext)
@@ -62,7 +86,7 @@ ffxReturnCode_t CreateBackend(const ffxCreateContextDescHeader *desc, bool& back
             backendFound = true;
 
             const auto *backendDesc = reinterpret_cast<const ffxCreateBackendVKDesc*>(it);
-            VkDeviceContext deviceContext = { backendDesc->vkDevice, backendDesc->vkPhysicalDevice, backendDesc->vkDeviceProcAddr };
+            VkDeviceContext deviceContext = { backendDesc->vkDevice, backendDesc->vkPhysicalDevice, backendDesc->vkDeviceProcAddr, GetSynchronization2EnabledVK(desc) };
             FfxDevice device = ffxGetDeviceVK(&deviceContext);
             size_t scratchBufferSize = ffxGetScratchMemorySizeVK(backendDesc->vkPhysicalDevice, contexts);
             void* scratchBuffer = alloc.alloc(scratchBufferSize);
@@ -49,7 +49,10 @@ FFX_API_ENTRY ffxReturnCode_t ffxCreateContext(ffxContext* context, ffxCreateCon
     VERIFY(provider != nullptr, FFX_API_RETURN_NO_PROVIDER);
     
     Allocator alloc{memCb};
-    return provider->CreateContext(context, desc, alloc);
+    TRY(provider->CreateContext(context, desc, alloc));
+
+    TrackContextCreated();
+    return FFX_API_RETURN_OK;
 }
 
 FFX_API_ENTRY ffxReturnCode_t ffxDestroyContext(ffxContext* context, const ffxAllocationCallbacks* memCb)
@@ -57,7 +60,10 @@ FFX_API_ENTRY ffxReturnCode_t ffxDestroyContext(ffxContext* context, const ffxAl
     VERIFY(context != nullptr, FFX_API_RETURN_ERROR_PARAMETER);
 
     Allocator alloc{memCb};
-    return GetAssociatedProvider(context)->DestroyContext(context, alloc);
+    TRY(GetAssociatedProvider(context)->DestroyContext(context, alloc));
+
+    TrackContextDestroyed();
+    return FFX_API_RETURN_OK;
 }
 
 FFX_API_ENTRY ffxReturnCode_t ffxConfigure(ffxContext* context, const ffxConfigureDescHeader* desc)
@@ -28,7 +28,11 @@
 #include "ffx_provider_external.h"
 
 #include <array>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <d3d12.h>
 
@@ -71,13 +75,15 @@ struct ExternalProviderData
 };
 #define FFX_EXTERNAL_PROVIDER_STRUCT_VERSION 1u
 
-void GetExternalProviders(ID3D12Device* device, uint64_t descType)
-{
-    static IAmdExtFfxApi* apiExtension = nullptr;
+// Driver extension of the device the first provider probe was made on, reset together with the provider table.
+static IAmdExtFfxApi* apiExtension = nullptr;
+static bool ranOnce = false;
 
+// Returns true when a provider was added to externalProviders.
+static bool GetExternalProviders(ID3D12Device* device, uint64_t descType)
+{
     if (nullptr != device)
     {
-        static bool ranOnce = false;
         if (!ranOnce)
         {
             ranOnce = true;
@@ -110,7 +116,7 @@ void GetExternalProviders(ID3D12Device* device, uint64_t descType)
         data.descType = descType;
         HRESULT hr = apiExtension->UpdateFfxApiProvider(&data, sizeof(data));
         if (hr != S_OK)
-            return;
+            return false;
 
         for (auto& slot : externalProviders)
         {
@@ -124,18 +130,88 @@ void GetExternalProviders(ID3D12Device* device, uint64_t descType)
                 // first free slot. slots are filled start to end and never released.
                 // we do not have this provider yet, add it to the list.
                 slot = ffxProviderExternal{data.provider};
-                break;
+                return true;
             }
         }
     }
-    
+
+    return false;
 }
 
-const ffxProvider* GetffxProvider(ffxStructType_t descType, uint64_t overrideId, void* device)
+// Provider resolution is cached per device, keyed by descriptor type and version override, so that creating contexts
+// and querying per frame do not go back to the driver and walk the provider lists on every call.
+struct ProviderTableKey
 {
-    // check driver-side providers
-    GetExternalProviders(reinterpret_cast<ID3D12Device*>(device), descType);
+    void*           device;
+    ffxStructType_t descType;
+    uint64_t        overrideId;
+
+    bool operator==(const ProviderTableKey& other) const
+    {
+        return device == other.device && descType == other.descType && overrideId == other.overrideId;
+    }
+};
+
+struct ProviderTableKeyHash
+{
+    size_t operator()(const ProviderTableKey& key) const
+    {
+        size_t hash = std::hash<void*>{}(key.device);
+        hash ^= std::hash<uint64_t>{}(key.descType) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint64_t>{}(key.overrideId) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+static std::shared_mutex providerTableMutex;
+// (device, descType) pairs the driver has already been asked about, overrideId is unused.
+static std::unordered_set<ProviderTableKey, ProviderTableKeyHash> probedExternalProviders;
+static std::unordered_map<ProviderTableKey, const ffxProvider*, ProviderTableKeyHash> providerTable;
+// Contexts currently alive, the devices they were created on may be destroyed once this drops to zero.
+static uint64_t liveContextCount = 0;
+
+// Must be called with providerTableMutex held exclusively.
+static void ClearProviderTable()
+{
+    providerTable.clear();
+    probedExternalProviders.clear();
+
+    // The extension was created for a device that may be gone, the next probe creates one for the device it is given.
+    if (apiExtension)
+        apiExtension->Release();
+    apiExtension = nullptr;
+    ranOnce = false;
+}
+
+void TrackContextCreated()
+{
+    std::unique_lock<std::shared_mutex> lock(providerTableMutex);
+    ++liveContextCount;
+}
+
+void TrackContextDestroyed()
+{
+    std::unique_lock<std::shared_mutex> lock(providerTableMutex);
+    // With no context left the application may recreate its device (device removal, adapter change), and a new device
+    // can reuse the address of the old one. Start over so the driver is asked again for the new device.
+    if (liveContextCount > 0 && --liveContextCount == 0)
+        ClearProviderTable();
+}
 
+// Asks the driver for providers of descType once per device. Must be called with providerTableMutex held exclusively.
+static void ProbeExternalProviders(void* device, ffxStructType_t descType)
+{
+    if (probedExternalProviders.insert(ProviderTableKey{device, descType, 0}).second)
+    {
+        // a new provider may take over keys that were already resolved, for any descriptor type. Probes done so far
+        // stay valid, the providers they found are still in externalProviders.
+        if (GetExternalProviders(reinterpret_cast<ID3D12Device*>(device), descType))
+            providerTable.clear();
+    }
+}
+
+static const ffxProvider* ResolveProvider(ffxStructType_t descType, uint64_t overrideId)
+{
     for (const auto& provider : externalProviders)
     {
         if (provider.has_value())
@@ -154,6 +230,26 @@ const ffxProvider* GetffxProvider(ffxStructType_t descType, uint64_t overrideId,
     return nullptr;
 }
 
+const ffxProvider* GetffxProvider(ffxStructType_t descType, uint64_t overrideId, void* device)
+{
+    const ProviderTableKey key{device, descType, overrideId};
+    {
+        std::shared_lock<std::shared_mutex> lock(providerTableMutex);
+        auto it = providerTable.find(key);
+        if (it != providerTable.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(providerTableMutex);
+
+    // check driver-side providers
+    ProbeExternalProviders(device, descType);
+
+    const ffxProvider* provider = ResolveProvider(descType, overrideId);
+    providerTable[key] = provider;
+    return provider;
+}
+
 const ffxProvider* GetAssociatedProvider(ffxContext* context)
 {
     const InternalContextHeader* hdr = (const InternalContextHeader*)(*context);
@@ -171,7 +267,8 @@ uint64_t GetProviderVersions(ffxStructType_t descType, void* device, uint64_t ca
     uint64_t count = 0;
 
     // check driver-side providers
-    GetExternalProviders(reinterpret_cast<ID3D12Device*>(device), descType);
+    std::unique_lock<std::shared_mutex> lock(providerTableMutex);
+    ProbeExternalProviders(device, descType);
 
     for (const auto& provider : externalProviders)
     {
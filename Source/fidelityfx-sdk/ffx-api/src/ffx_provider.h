@@ -89,6 +89,10 @@ public:
 
 const ffxProvider* GetffxProvider(ffxStructType_t descType, uint64_t overrideId, void* device);
 
+// Live context tracking for the provider table, the table is invalidated when the last context is destroyed.
+void TrackContextCreated();
+void TrackContextDestroyed();
+
 const ffxProvider* GetAssociatedProvider(ffxContext* context);
 
 uint64_t GetProviderCount(ffxStructType_t descType, void* device);
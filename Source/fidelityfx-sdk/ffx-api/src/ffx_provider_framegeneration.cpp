@@ -22,6 +22,7 @@
 
 #include "ffx_provider_framegeneration.h"
 #include "backends.h"
+#include "ffx_shared_intermediates.h"
 #include <ffx_api/ffx_framegeneration.hpp>
 #include <FidelityFX/host/ffx_fsr3.h>
 #include <FidelityFX/host/ffx_frameinterpolation.h>
@@ -37,6 +38,20 @@ bool ffxProvider_FrameGeneration::CanProvide(uint64_t type) const
 
 const uint32_t MAX_QUEUED_FRAMES = 2;
 
+static uint32_t GetSharedIntermediateCompatFlags(uint32_t apiFlags)
+{
+    uint32_t outFlags = 0;
+    if (apiFlags & FFX_FRAMEGENERATION_ENABLE_DEPTH_INVERTED)
+        outFlags |= SHARED_INTERMEDIATE_DEPTH_INVERTED;
+    if (apiFlags & FFX_FRAMEGENERATION_ENABLE_DEPTH_INFINITE)
+        outFlags |= SHARED_INTERMEDIATE_DEPTH_INFINITE;
+    if (apiFlags & FFX_FRAMEGENERATION_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS)
+        outFlags |= SHARED_INTERMEDIATE_DISPLAY_RESOLUTION_MOTION_VECTORS;
+    if (apiFlags & FFX_FRAMEGENERATION_ENABLE_MOTION_VECTORS_JITTER_CANCELLATION)
+        outFlags |= SHARED_INTERMEDIATE_MOTION_VECTORS_JITTER_CANCELLATION;
+    return outFlags;
+}
+
 struct InternalFgContext
 {
     InternalContextHeader header;
@@ -47,6 +62,15 @@ struct InternalFgContext
     FfxFrameInterpolationContext fiContext;
     FfxResourceInternal sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_COUNT];
     uint32_t            sharedResoureFrameToggle;
+    FfxSurfaceFormat    sharedIntermediateFormats[SHARED_INTERMEDIATE_COUNT];
+    uint32_t            createFlags;
+
+    // intermediates taken over from an upscaler on the same device, indexed by frameID % MAX_QUEUED_FRAMES
+    struct BrokeredIntermediates {
+        bool                     consumed;
+        SharedIntermediateTicket ticket;
+        FfxResource              resources[SHARED_INTERMEDIATE_COUNT];
+    } brokered[MAX_QUEUED_FRAMES];
     uint32_t effectContextIdShared;
     float deltaTime;
     bool asyncWorkloadSupported;
@@ -96,6 +120,7 @@ ffxReturnCode_t ffxProvider_FrameGeneration::CreateContext(ffxContext* context,
 
         { // copied from ffxFsr3ContextCreate, simplified.
             internal_context->asyncWorkloadSupported = (desc->flags & FFX_FRAMEGENERATION_ENABLE_ASYNC_WORKLOAD_SUPPORT) != 0;
+            internal_context->createFlags = desc->flags;
 
             TRY2(internal_context->backendInterfaceShared.fpCreateBackendContext(&internal_context->backendInterfaceShared, FFX_EFFECT_SHAREDAPIBACKEND, nullptr, &internal_context->effectContextIdShared));
         
@@ -143,6 +168,9 @@ ffxReturnCode_t ffxProvider_FrameGeneration::CreateContext(ffxContext* context,
             TRY2(ffxFrameInterpolationGetSharedResourceDescriptions(&internal_context->fiContext, &fiResourceDescs));
 
             internal_context->sharedResoureFrameToggle = 0;
+            internal_context->sharedIntermediateFormats[SHARED_INTERMEDIATE_DILATED_DEPTH]                    = fiResourceDescs.dilatedDepth.resourceDescription.format;
+            internal_context->sharedIntermediateFormats[SHARED_INTERMEDIATE_DILATED_MOTION_VECTORS]           = fiResourceDescs.dilatedMotionVectors.resourceDescription.format;
+            internal_context->sharedIntermediateFormats[SHARED_INTERMEDIATE_RECONSTRUCTED_PREV_NEAREST_DEPTH] = fiResourceDescs.reconstructedPrevNearestDepth.resourceDescription.format;
             wchar_t Name[256] = {};
             for (FfxUInt32 i = 0; i < 2; i++)
             {
@@ -175,6 +203,9 @@ ffxReturnCode_t ffxProvider_FrameGeneration::CreateContext(ffxContext* context,
             }
         }
 
+        // let upscalers on the same device know their dilated intermediates will be picked up
+        SharedIntermediateBroker::Get().RegisterConsumer(internal_context->backendInterfaceShared.device);
+
         *context = internal_context;
         return FFX_API_RETURN_OK;
     }
@@ -190,6 +221,8 @@ ffxReturnCode_t ffxProvider_FrameGeneration::DestroyContext(ffxContext* context,
     VERIFY(*context, FFX_API_RETURN_ERROR_PARAMETER);
 
     InternalFgContext* internal_context = reinterpret_cast<InternalFgContext*>(*context);
+
+    SharedIntermediateBroker::Get().UnregisterConsumer(internal_context->backendInterfaceShared.device);
     
     { // copied from ffxFsr3ContextDestroy, simplified.
         for (FfxUInt32 i = 0; i < FFX_FSR3_RESOURCE_IDENTIFIER_COUNT; i++)
@@ -434,6 +467,11 @@ ffxReturnCode_t ffxProvider_FrameGeneration::Dispatch(ffxContext* context, const
             fiDispatchDesc.currentBackBuffer_HUDLess = internal_context->HUDLessColor;
             fiDispatchDesc.reset = desc->reset;
 
+            const InternalFgContext::BrokeredIntermediates& brokered = internal_context->brokered[desc->frameID % MAX_QUEUED_FRAMES];
+            const bool useBrokered = brokered.consumed && SharedIntermediateBroker::Get().IsPublished(brokered.ticket);
+            // the upscaler went away or overwrote its intermediates since prepare, our own were not written this frame
+            fiDispatchDesc.reset |= brokered.consumed && !useBrokered;
+
             fiDispatchDesc.renderSize.width  = prepDesc->renderSize.width;
             fiDispatchDesc.renderSize.height = prepDesc->renderSize.height;
             fiDispatchDesc.output = Convert(desc->outputs[0]);
@@ -450,6 +488,12 @@ ffxReturnCode_t ffxProvider_FrameGeneration::Dispatch(ffxContext* context, const
             fiDispatchDesc.dilatedDepth = internal_context->backendInterfaceShared.fpGetResource( &internal_context->backendInterfaceShared, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_DEPTH_0 + (internal_context->sharedResoureFrameToggle * FFX_FSR3_RESOURCE_IDENTIFIER_UPSCALED_COUNT)]);
             fiDispatchDesc.dilatedMotionVectors = internal_context->backendInterfaceShared.fpGetResource( &internal_context->backendInterfaceShared, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_MOTION_VECTORS_0 + (internal_context->sharedResoureFrameToggle * FFX_FSR3_RESOURCE_IDENTIFIER_UPSCALED_COUNT)]);
             fiDispatchDesc.reconstructedPrevDepth = internal_context->backendInterfaceShared.fpGetResource( &internal_context->backendInterfaceShared, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH_0 + (internal_context->sharedResoureFrameToggle * FFX_FSR3_RESOURCE_IDENTIFIER_UPSCALED_COUNT)]);
+            if (useBrokered)
+            {
+                fiDispatchDesc.dilatedDepth           = brokered.resources[SHARED_INTERMEDIATE_DILATED_DEPTH];
+                fiDispatchDesc.dilatedMotionVectors   = brokered.resources[SHARED_INTERMEDIATE_DILATED_MOTION_VECTORS];
+                fiDispatchDesc.reconstructedPrevDepth = brokered.resources[SHARED_INTERMEDIATE_RECONSTRUCTED_PREV_NEAREST_DEPTH];
+            }
 
             if (desc->generationRect.height == 0 && desc->generationRect.width == 0)
             {
@@ -525,6 +569,24 @@ ffxReturnCode_t ffxProvider_FrameGeneration::Dispatch(ffxContext* context, const
         dispatchDesc.dilatedMotionVectors = internal_context->backendInterfaceShared.fpGetResource( &internal_context->backendInterfaceShared, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_MOTION_VECTORS_0 + (internal_context->sharedResoureFrameToggle * FFX_FSR3_RESOURCE_IDENTIFIER_UPSCALED_COUNT)]);
         dispatchDesc.reconstructedPrevDepth = internal_context->backendInterfaceShared.fpGetResource( &internal_context->backendInterfaceShared, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH_0 + (internal_context->sharedResoureFrameToggle * FFX_FSR3_RESOURCE_IDENTIFIER_UPSCALED_COUNT)]);
 
+        // When an upscaler on the same device already produced matching intermediates for this frame, reference those
+        // and only update the constants instead of reconstructing and dilating the inputs a second time.
+        SharedIntermediateSet expected = {};
+        expected.renderSize        = dispatchDesc.renderSize;
+        expected.jitterOffset      = dispatchDesc.jitterOffset;
+        expected.motionVectorScale = dispatchDesc.motionVectorScale;
+        expected.compatFlags       = GetSharedIntermediateCompatFlags(internal_context->createFlags);
+
+        SharedIntermediateSet published = {};
+        InternalFgContext::BrokeredIntermediates& brokered = internal_context->brokered[desc->frameID % MAX_QUEUED_FRAMES];
+        brokered.consumed = SharedIntermediateBroker::Get().Consume(internal_context->backendInterfaceShared.device, expected, internal_context->sharedIntermediateFormats, published, brokered.ticket);
+        if (brokered.consumed)
+        {
+            for (uint32_t i = 0; i < SHARED_INTERMEDIATE_COUNT; ++i)
+                brokered.resources[i] = published.resources[i];
+            dispatchDesc.flags |= FFX_FRAMEINTERPOLATION_PREPARE_SKIP_RECONSTRUCT;
+        }
+
         TRY2(ffxFrameInterpolationPrepare(&internal_context->fiContext, &dispatchDesc));
 
         return FFX_API_RETURN_OK;
@@ -23,6 +23,7 @@
 #include "ffx_provider_fsr3upscale.h"
 #include "backends.h"
 #include "validation.h"
+#include "ffx_shared_intermediates.h"
 #include <ffx_api/ffx_upscale.hpp>
 #ifdef FFX_BACKEND_DX12
 #include <ffx_api/dx12/ffx_api_dx12.h>
@@ -57,6 +58,20 @@ static uint32_t ConvertFlags(uint32_t apiFlags)
     return outFlags;
 }
 
+static uint32_t GetSharedIntermediateCompatFlags(uint32_t apiFlags)
+{
+    uint32_t outFlags = 0;
+    if (apiFlags & FFX_UPSCALE_ENABLE_DEPTH_INVERTED)
+        outFlags |= SHARED_INTERMEDIATE_DEPTH_INVERTED;
+    if (apiFlags & FFX_UPSCALE_ENABLE_DEPTH_INFINITE)
+        outFlags |= SHARED_INTERMEDIATE_DEPTH_INFINITE;
+    if (apiFlags & FFX_UPSCALE_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS)
+        outFlags |= SHARED_INTERMEDIATE_DISPLAY_RESOLUTION_MOTION_VECTORS;
+    if (apiFlags & FFX_UPSCALE_ENABLE_MOTION_VECTORS_JITTER_CANCELLATION)
+        outFlags |= SHARED_INTERMEDIATE_MOTION_VECTORS_JITTER_CANCELLATION;
+    return outFlags;
+}
+
 bool ffxProvider_FSR3Upscale::CanProvide(uint64_t type) const
 {
     return (type & FFX_API_EFFECT_MASK) == FFX_API_EFFECT_ID_UPSCALE;
@@ -82,10 +97,52 @@ struct InternalFsr3UpscalerUContext
     InternalContextHeader   header;
     FfxInterface            backendInterface;
     FfxResourceInternal     sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_COUNT];
+    uint32_t                sharedResourceSetCount;
+    uint32_t                sharedResourceFrameToggle;
+    uint32_t                createFlags;
     FfxFsr3UpscalerContext  context;
     ffxApiMessage           fpMessage;
 };
 
+static ffxReturnCode_t CreateSharedResourceSet(InternalFsr3UpscalerUContext* internal_context, uint32_t set)
+{
+    FfxFsr3UpscalerSharedResourceDescriptions fs3UpscalerResourceDescs = {};
+    TRY2(ffxFsr3UpscalerGetSharedResourceDescriptions(&internal_context->context, &fs3UpscalerResourceDescs));
+
+    wchar_t Name[256] = {};
+    const uint32_t offset = set * FFX_FSR3_RESOURCE_IDENTIFIER_UPSCALED_COUNT;
+
+    FfxCreateResourceDescription dilD = fs3UpscalerResourceDescs.dilatedDepth;
+    swprintf(Name, 255, L"%s%d", fs3UpscalerResourceDescs.dilatedDepth.name, set);
+    dilD.name = Name;
+    TRY2(internal_context->backendInterface.fpCreateResource(
+        &internal_context->backendInterface,
+        &dilD,
+        0,
+        &internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_DEPTH_0 + offset]));
+
+    FfxCreateResourceDescription dilMVs = fs3UpscalerResourceDescs.dilatedMotionVectors;
+    swprintf(Name, 255, L"%s%d", fs3UpscalerResourceDescs.dilatedMotionVectors.name, set);
+    dilMVs.name = Name;
+    TRY2(internal_context->backendInterface.fpCreateResource(
+        &internal_context->backendInterface,
+        &dilMVs,
+        0,
+        &internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_MOTION_VECTORS_0 + offset]));
+
+    FfxCreateResourceDescription recND = fs3UpscalerResourceDescs.reconstructedPrevNearestDepth;
+    swprintf(Name, 255, L"%s%d", fs3UpscalerResourceDescs.reconstructedPrevNearestDepth.name, set);
+    recND.name = Name;
+    TRY2(internal_context->backendInterface.fpCreateResource(
+        &internal_context->backendInterface,
+        &recND,
+        0,
+        &internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH_0 + offset]));
+
+    internal_context->sharedResourceSetCount = set + 1;
+    return FFX_API_RETURN_OK;
+}
+
 ffxReturnCode_t ffxProvider_FSR3Upscale::CreateContext(ffxContext* context, ffxCreateContextDescHeader* header, Allocator& alloc) const
 {
     VERIFY(context, FFX_API_RETURN_ERROR_PARAMETER);
@@ -98,7 +155,7 @@ ffxReturnCode_t ffxProvider_FSR3Upscale::CreateContext(ffxContext* context, ffxC
 #ifdef FFX_BACKEND_DX12
             Validator{desc->fpMessage, header}.AcceptExtensions({FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_DX12, FFX_API_DESC_TYPE_OVERRIDE_VERSION});
 #elif FFX_BACKEND_VK
-            Validator{ desc->fpMessage, header }.AcceptExtensions({ FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK, FFX_API_DESC_TYPE_OVERRIDE_VERSION });
+            Validator{ desc->fpMessage, header }.AcceptExtensions({ FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK, FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK_ENABLED_FEATURES, FFX_API_DESC_TYPE_OVERRIDE_VERSION });
 #endif // FFX_BACKEND_DX12
         }
         InternalFsr3UpscalerUContext* internal_context = alloc.construct<InternalFsr3UpscalerUContext>();
@@ -119,41 +176,16 @@ ffxReturnCode_t ffxProvider_FSR3Upscale::CreateContext(ffxContext* context, ffxC
 
         // Grab this fp for use in extensions later
         internal_context->fpMessage = desc->fpMessage;
+        internal_context->createFlags = desc->flags;
 
         // Create the FSR3UPSCALER context
         TRY2(ffxFsr3UpscalerContextCreate(&internal_context->context, &initializationParameters));
 
-        // set up FSR3Upscaler "shared" resources (no resource sharing in the upscaler provider though, since providers are fully independent and we can't guarantee all upscale providers will be compatible with other effects)
-        {
-            FfxFsr3UpscalerSharedResourceDescriptions fs3UpscalerResourceDescs = {};
-            TRY2(ffxFsr3UpscalerGetSharedResourceDescriptions(&internal_context->context, &fs3UpscalerResourceDescs));
-
-            {
-                FfxCreateResourceDescription dilD = fs3UpscalerResourceDescs.dilatedDepth;
-                dilD.name = fs3UpscalerResourceDescs.dilatedDepth.name;
-                TRY2(internal_context->backendInterface.fpCreateResource(
-                    &internal_context->backendInterface,
-                    &dilD,
-                    0,
-                    &internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_DEPTH_0]));
-
-                FfxCreateResourceDescription dilMVs = fs3UpscalerResourceDescs.dilatedMotionVectors;
-                dilD.name   = fs3UpscalerResourceDescs.dilatedMotionVectors.name;
-                TRY2(internal_context->backendInterface.fpCreateResource(
-                    &internal_context->backendInterface,
-                    &dilMVs,
-                    0,
-                    &internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_MOTION_VECTORS_0]));
-
-                FfxCreateResourceDescription recND = fs3UpscalerResourceDescs.reconstructedPrevNearestDepth;
-                recND.name = fs3UpscalerResourceDescs.reconstructedPrevNearestDepth.name;
-                TRY2(internal_context->backendInterface.fpCreateResource(
-                    &internal_context->backendInterface,
-                    &recND,
-                    0,
-                    &internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH_0]));
-            }
-        }
+        // set up FSR3Upscaler "shared" resources. Only one set is needed until a frame generation context on the same
+        // device asks for the intermediates, the second set is created on demand so the consumer can read one set while
+        // the next frame writes the other.
+        internal_context->sharedResourceFrameToggle = 0;
+        TRY(CreateSharedResourceSet(internal_context, 0));
 
         *context = internal_context;
         return FFX_API_RETURN_OK;
@@ -170,6 +202,8 @@ ffxReturnCode_t ffxProvider_FSR3Upscale::DestroyContext(ffxContext* context, All
     VERIFY(*context, FFX_API_RETURN_ERROR_PARAMETER);
 
     InternalFsr3UpscalerUContext* internal_context = reinterpret_cast<InternalFsr3UpscalerUContext*>(*context);
+
+    SharedIntermediateBroker::Get().Revoke(internal_context);
     
     for (FfxUInt32 i = 0; i < FFX_FSR3_RESOURCE_IDENTIFIER_COUNT; i++)
     {
@@ -335,9 +369,18 @@ ffxReturnCode_t ffxProvider_FSR3Upscale::Dispatch(ffxContext* context, const ffx
         dispatchParameters.viewSpaceToMetersFactor    = desc->viewSpaceToMetersFactor;
         dispatchParameters.flags = 0;
 
-        dispatchParameters.dilatedDepth                     = internal_context->backendInterface.fpGetResource( &internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_DEPTH_0]);
-        dispatchParameters.dilatedMotionVectors             = internal_context->backendInterface.fpGetResource( &internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_MOTION_VECTORS_0]);
-        dispatchParameters.reconstructedPrevNearestDepth    = internal_context->backendInterface.fpGetResource( &internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH_0]);
+        SharedIntermediateBroker& broker = SharedIntermediateBroker::Get();
+        const bool publish = broker.HasConsumer(internal_context->backendInterface.device);
+        if (publish && internal_context->sharedResourceSetCount < 2)
+        {
+            TRY(CreateSharedResourceSet(internal_context, 1));
+        }
+        internal_context->sharedResourceFrameToggle = (internal_context->sharedResourceFrameToggle + 1) % internal_context->sharedResourceSetCount;
+        const uint32_t offset = internal_context->sharedResourceFrameToggle * FFX_FSR3_RESOURCE_IDENTIFIER_UPSCALED_COUNT;
+
+        dispatchParameters.dilatedDepth                     = internal_context->backendInterface.fpGetResource( &internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_DEPTH_0 + offset]);
+        dispatchParameters.dilatedMotionVectors             = internal_context->backendInterface.fpGetResource( &internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_MOTION_VECTORS_0 + offset]);
+        dispatchParameters.reconstructedPrevNearestDepth    = internal_context->backendInterface.fpGetResource( &internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH_0 + offset]);
 
         if (desc->flags & FFX_UPSCALE_FLAG_DRAW_DEBUG_VIEW)
         {
@@ -345,6 +388,19 @@ ffxReturnCode_t ffxProvider_FSR3Upscale::Dispatch(ffxContext* context, const ffx
         }
 
         TRY2(ffxFsr3UpscalerContextDispatch(&internal_context->context, &dispatchParameters));
+
+        if (publish)
+        {
+            SharedIntermediateSet set = {};
+            set.resources[SHARED_INTERMEDIATE_DILATED_DEPTH]                    = internal_context->backendInterface.fpGetResource(&internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_DEPTH_0 + offset]);
+            set.resources[SHARED_INTERMEDIATE_DILATED_MOTION_VECTORS]           = internal_context->backendInterface.fpGetResource(&internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_DILATED_MOTION_VECTORS_0 + offset]);
+            set.resources[SHARED_INTERMEDIATE_RECONSTRUCTED_PREV_NEAREST_DEPTH] = internal_context->backendInterface.fpGetResource(&internal_context->backendInterface, internal_context->sharedResources[FFX_FSR3_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH_0 + offset]);
+            set.renderSize        = dispatchParameters.renderSize;
+            set.jitterOffset      = dispatchParameters.jitterOffset;
+            set.motionVectorScale = dispatchParameters.motionVectorScale;
+            set.compatFlags       = GetSharedIntermediateCompatFlags(internal_context->createFlags);
+            broker.Publish(internal_context->backendInterface.device, internal_context, set, internal_context->sharedResourceSetCount);
+        }
         break;
     }
     case FFX_API_DISPATCH_DESC_TYPE_UPSCALE_GENERATEREACTIVEMASK:
@@ -0,0 +1,166 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ffx_shared_intermediates.h"
+
+SharedIntermediateBroker& SharedIntermediateBroker::Get()
+{
+    static SharedIntermediateBroker broker;
+    return broker;
+}
+
+void SharedIntermediateBroker::RegisterConsumer(FfxDevice device)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& consumer : consumers)
+    {
+        if (consumer.device == device)
+        {
+            consumer.refCount++;
+            return;
+        }
+    }
+    consumers.push_back({device, 1});
+}
+
+void SharedIntermediateBroker::UnregisterConsumer(FfxDevice device)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = consumers.begin(); it != consumers.end(); ++it)
+    {
+        if (it->device == device)
+        {
+            if (--it->refCount == 0)
+                consumers.erase(it);
+            return;
+        }
+    }
+}
+
+bool SharedIntermediateBroker::HasConsumer(FfxDevice device) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& consumer : consumers)
+    {
+        if (consumer.device == device)
+            return true;
+    }
+    return false;
+}
+
+void SharedIntermediateBroker::Publish(FfxDevice device, const void* producer, const SharedIntermediateSet& set, uint32_t retainedFrames)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.published++;
+    for (auto& publication : publications)
+    {
+        if (publication.producer == producer)
+        {
+            publication.device         = device;
+            publication.set            = set;
+            publication.frame++;
+            publication.retainedFrames = retainedFrames;
+            publication.fresh          = true;
+            return;
+        }
+    }
+    publications.push_back({device, producer, set, nextSerial++, 0, retainedFrames, true});
+}
+
+void SharedIntermediateBroker::Revoke(const void* producer)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = publications.begin(); it != publications.end(); ++it)
+    {
+        if (it->producer == producer)
+        {
+            publications.erase(it);
+            return;
+        }
+    }
+}
+
+bool SharedIntermediateBroker::IsPublished(const SharedIntermediateTicket& ticket) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& publication : publications)
+    {
+        // a revoked producer's address can be reused by a new one, which gets a new serial
+        if (publication.producer == ticket.producer)
+            return publication.serial == ticket.serial && publication.frame - ticket.frame < publication.retainedFrames;
+    }
+    return false;
+}
+
+static bool IsCompatible(const SharedIntermediateSet& published, const SharedIntermediateSet& expected, const FfxSurfaceFormat (&formats)[SHARED_INTERMEDIATE_COUNT])
+{
+    if (published.compatFlags != expected.compatFlags ||
+        published.renderSize.width != expected.renderSize.width || published.renderSize.height != expected.renderSize.height ||
+        published.jitterOffset.x != expected.jitterOffset.x || published.jitterOffset.y != expected.jitterOffset.y ||
+        published.motionVectorScale.x != expected.motionVectorScale.x || published.motionVectorScale.y != expected.motionVectorScale.y)
+        return false;
+
+    for (uint32_t i = 0; i < SHARED_INTERMEDIATE_COUNT; ++i)
+    {
+        const FfxResourceDescription& desc = published.resources[i].description;
+        if (published.resources[i].resource == nullptr || desc.format != formats[i] ||
+            desc.width < expected.renderSize.width || desc.height < expected.renderSize.height)
+            return false;
+    }
+    return true;
+}
+
+bool SharedIntermediateBroker::Consume(FfxDevice device, const SharedIntermediateSet& expected, const FfxSurfaceFormat (&formats)[SHARED_INTERMEDIATE_COUNT],
+                                       SharedIntermediateSet& out, SharedIntermediateTicket& ticket)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Publication* match = nullptr;
+    bool ambiguous = false;
+    for (auto& publication : publications)
+    {
+        if (publication.device == device && publication.fresh && IsCompatible(publication.set, expected, formats))
+        {
+            // several views published this frame and we cannot tell which one belongs to the consumer
+            ambiguous |= match != nullptr;
+            match = &publication;
+        }
+    }
+
+    if (match == nullptr || ambiguous)
+    {
+        stats.fallbacks++;
+        return false;
+    }
+
+    match->fresh = false;
+    out    = match->set;
+    ticket = {match->producer, match->serial, match->frame};
+    stats.consumed++;
+    return true;
+}
+
+SharedIntermediateStats SharedIntermediateBroker::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
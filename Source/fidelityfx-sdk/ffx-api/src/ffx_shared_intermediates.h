@@ -0,0 +1,120 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <FidelityFX/host/ffx_types.h>
+
+#include <mutex>
+#include <vector>
+
+// Intermediates one provider can publish for another provider working on the same frame.
+enum SharedIntermediateId
+{
+    SHARED_INTERMEDIATE_DILATED_DEPTH,
+    SHARED_INTERMEDIATE_DILATED_MOTION_VECTORS,
+    SHARED_INTERMEDIATE_RECONSTRUCTED_PREV_NEAREST_DEPTH,
+
+    SHARED_INTERMEDIATE_COUNT
+};
+
+// Input conventions that change the content of the intermediates, producer and consumer must agree on all of them.
+enum SharedIntermediateCompatFlags
+{
+    SHARED_INTERMEDIATE_DEPTH_INVERTED                  = (1 << 0),
+    SHARED_INTERMEDIATE_DEPTH_INFINITE                  = (1 << 1),
+    SHARED_INTERMEDIATE_DISPLAY_RESOLUTION_MOTION_VECTORS = (1 << 2),
+    SHARED_INTERMEDIATE_MOTION_VECTORS_JITTER_CANCELLATION = (1 << 3),
+};
+
+struct SharedIntermediateSet
+{
+    FfxResource         resources[SHARED_INTERMEDIATE_COUNT];
+    FfxDimensions2D     renderSize;
+    FfxFloatCoords2D    jitterOffset;
+    FfxFloatCoords2D    motionVectorScale;
+    uint32_t            compatFlags;
+};
+
+// Identifies the publication a consumer took over. The serial tells apart producers created at the same address and
+// the frame tells apart the publications of one producer.
+struct SharedIntermediateTicket
+{
+    const void*         producer;
+    uint64_t            serial;
+    uint64_t            frame;
+};
+
+struct SharedIntermediateStats
+{
+    uint64_t published;
+    uint64_t consumed;
+    uint64_t fallbacks;
+};
+
+// Hands per-frame intermediates from a producing provider (the upscaler) to a consuming provider (frame generation)
+// on the same device so the consumer can skip recomputing them. Publications are consumed at most once, so a
+// consumer that runs without a matching publication for the frame falls back to computing the intermediates itself.
+class SharedIntermediateBroker
+{
+public:
+    static SharedIntermediateBroker& Get();
+
+    void RegisterConsumer(FfxDevice device);
+    void UnregisterConsumer(FfxDevice device);
+    bool HasConsumer(FfxDevice device) const;
+
+    // The producer keeps the published resources intact for retainedFrames publications, including this one.
+    void Publish(FfxDevice device, const void* producer, const SharedIntermediateSet& set, uint32_t retainedFrames);
+    void Revoke(const void* producer);
+    // Returns true while the resources of the ticket's publication have neither been released nor overwritten.
+    bool IsPublished(const SharedIntermediateTicket& ticket) const;
+
+    // Returns false when the consumer has to recompute, otherwise out and ticket describe the matching publication.
+    bool Consume(FfxDevice device, const SharedIntermediateSet& expected, const FfxSurfaceFormat (&formats)[SHARED_INTERMEDIATE_COUNT],
+                 SharedIntermediateSet& out, SharedIntermediateTicket& ticket);
+
+    SharedIntermediateStats GetStats() const;
+
+private:
+    struct Publication
+    {
+        FfxDevice               device;
+        const void*             producer;
+        SharedIntermediateSet   set;
+        uint64_t                serial;
+        uint64_t                frame;
+        uint32_t                retainedFrames;
+        bool                    fresh;
+    };
+
+    struct Consumer
+    {
+        FfxDevice               device;
+        uint32_t                refCount;
+    };
+
+    mutable std::mutex          mutex;
+    std::vector<Publication>    publications;
+    std::vector<Consumer>       consumers;
+    SharedIntermediateStats     stats = {};
+    uint64_t                    nextSerial = 1;
+};
@@ -0,0 +1,91 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Micro-benchmark for provider resolution. Context-less queries go through GetffxProvider on every call, so their cost
+// is dominated by the provider lookup: the first call probes the driver and resolves the provider, later calls hit the
+// provider table. Run it against the DLL built before and after a change to compare the per-call cost.
+
+#include <ffx_api/ffx_api_loader.h>
+#include <ffx_api/ffx_upscale.h>
+
+#include <chrono>
+#include <cstdio>
+
+static constexpr uint32_t s_IterationCount = 1000000;
+
+int main(int argc, char** argv)
+{
+    const char* dllName = argc > 1 ? argv[1] : FFX_API_DLL_NAME;
+    HMODULE     module  = LoadLibraryA(dllName);
+    if (!module)
+    {
+        printf("Unable to load %s\n", dllName);
+        return 1;
+    }
+
+    ffxFunctions functions = {};
+    ffxLoadFunctions(&functions, module);
+
+    int32_t                                phaseCount = 0;
+    ffxQueryDescUpscaleGetJitterPhaseCount phaseQuery = {};
+    phaseQuery.header.type                            = FFX_API_QUERY_DESC_TYPE_UPSCALE_GETJITTERPHASECOUNT;
+    phaseQuery.renderWidth                            = 1280;
+    phaseQuery.displayWidth                           = 1920;
+    phaseQuery.pOutPhaseCount                         = &phaseCount;
+
+    uint64_t                versionCount = 0;
+    ffxQueryDescGetVersions versionQuery = {};
+    versionQuery.header.type             = FFX_API_QUERY_DESC_TYPE_GET_VERSIONS;
+    versionQuery.createDescType          = FFX_API_CREATE_CONTEXT_DESC_TYPE_UPSCALE;
+    versionQuery.outputCount             = &versionCount;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    auto start = Clock::now();
+    if (functions.Query(nullptr, &phaseQuery.header) != FFX_API_RETURN_OK)
+    {
+        printf("Jitter phase count query failed\n");
+        return 1;
+    }
+    const double firstCallUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < s_IterationCount; ++i)
+        functions.Query(nullptr, &phaseQuery.header);
+    const double queryNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / s_IterationCount;
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < s_IterationCount; ++i)
+    {
+        versionCount = 0;
+        functions.Query(nullptr, &versionQuery.header);
+    }
+    const double versionNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / s_IterationCount;
+
+    printf("first context-less query (probe and resolve): %.2f us\n", firstCallUs);
+    printf("context-less jitter phase count query:        %.1f ns/call\n", queryNs);
+    printf("provider version count query:                 %.1f ns/call (%llu providers)\n", versionNs, (unsigned long long)versionCount);
+
+    FreeLibrary(module);
+    return 0;
+}
@@ -0,0 +1,178 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Checks for the intermediate broker between the upscale and frame generation providers. Frame generation skips its
+// reconstruct and dilate dispatch when Consume succeeds in Prepare, and only reads the upscaler's resources in Dispatch
+// while IsPublished still holds for the ticket. Anything else has to take the fallback that recomputes the intermediates.
+
+#include "../src/ffx_shared_intermediates.h"
+#include "ffx_test.h"
+
+static const FfxDevice s_Device = (FfxDevice)0x100;
+
+static const FfxSurfaceFormat s_Formats[SHARED_INTERMEDIATE_COUNT] = {
+    FFX_SURFACE_FORMAT_R32_FLOAT, FFX_SURFACE_FORMAT_R16G16_FLOAT, FFX_SURFACE_FORMAT_R32_UINT};
+
+// A set as the upscaler publishes it, resources are told apart by frame so a stale reference shows up in the checks.
+static SharedIntermediateSet makeSet(uint32_t frame)
+{
+    SharedIntermediateSet set = {};
+    for (uint32_t i = 0; i < SHARED_INTERMEDIATE_COUNT; ++i)
+    {
+        set.resources[i].resource           = (void*)(uintptr_t)(0x1000 * (frame + 1) + i);
+        set.resources[i].description.format = s_Formats[i];
+        set.resources[i].description.width  = 1280;
+        set.resources[i].description.height = 720;
+    }
+    set.renderSize        = {1280, 720};
+    set.jitterOffset      = {0.25f, -0.25f};
+    set.motionVectorScale = {1280.0f, 720.0f};
+    set.compatFlags       = SHARED_INTERMEDIATE_DEPTH_INVERTED;
+    return set;
+}
+
+static SharedIntermediateSet makeExpected()
+{
+    SharedIntermediateSet expected = makeSet(0);
+    for (auto& resource : expected.resources)
+        resource = {};
+    return expected;
+}
+
+// Prepare takes the upscaler's intermediates once per publication, Dispatch uses them while they are intact.
+static void testSkippedDispatch()
+{
+    SharedIntermediateBroker broker;
+    broker.RegisterConsumer(s_Device);
+    FFX_TEST_CHECK(broker.HasConsumer(s_Device));
+
+    int                      producer;
+    SharedIntermediateSet    published = {};
+    SharedIntermediateTicket ticket    = {};
+
+    broker.Publish(s_Device, &producer, makeSet(0), 2);
+    FFX_TEST_CHECK(broker.Consume(s_Device, makeExpected(), s_Formats, published, ticket));
+    FFX_TEST_CHECK(ticket.producer == &producer);
+    FFX_TEST_CHECK(published.resources[0].resource == makeSet(0).resources[0].resource);
+    FFX_TEST_CHECK(broker.IsPublished(ticket));
+
+    // A second prepare before the next upscale must not take the same publication.
+    SharedIntermediateTicket again = {};
+    FFX_TEST_CHECK(!broker.Consume(s_Device, makeExpected(), s_Formats, published, again));
+
+    // Double buffered: the next frame's publication leaves the consumed set intact, the one after overwrites it.
+    broker.Publish(s_Device, &producer, makeSet(1), 2);
+    FFX_TEST_CHECK(broker.IsPublished(ticket));
+    broker.Publish(s_Device, &producer, makeSet(2), 2);
+    FFX_TEST_CHECK(!broker.IsPublished(ticket));
+
+    // A single set is overwritten by the next publication.
+    FFX_TEST_CHECK(broker.Consume(s_Device, makeExpected(), s_Formats, published, ticket));
+    FFX_TEST_CHECK(published.resources[0].resource == makeSet(2).resources[0].resource);
+    broker.Publish(s_Device, &producer, makeSet(3), 1);
+    FFX_TEST_CHECK(!broker.IsPublished(ticket));
+
+    const SharedIntermediateStats stats = broker.GetStats();
+    FFX_TEST_CHECK(stats.published == 4);
+    FFX_TEST_CHECK(stats.consumed == 2);
+    FFX_TEST_CHECK(stats.fallbacks == 1);
+
+    broker.UnregisterConsumer(s_Device);
+    FFX_TEST_CHECK(!broker.HasConsumer(s_Device));
+}
+
+// A producer destroyed after Prepare must invalidate the ticket, also when a new producer takes its address and publishes.
+static void testRecreatedProducer()
+{
+    SharedIntermediateBroker broker;
+
+    int                      producer;
+    SharedIntermediateSet    published = {};
+    SharedIntermediateTicket ticket    = {};
+
+    broker.Publish(s_Device, &producer, makeSet(0), 2);
+    FFX_TEST_CHECK(broker.Consume(s_Device, makeExpected(), s_Formats, published, ticket));
+    broker.Revoke(&producer);
+    FFX_TEST_CHECK(!broker.IsPublished(ticket));
+
+    broker.Publish(s_Device, &producer, makeSet(0), 2);
+    FFX_TEST_CHECK(!broker.IsPublished(ticket));
+
+    SharedIntermediateTicket recreated = {};
+    FFX_TEST_CHECK(broker.Consume(s_Device, makeExpected(), s_Formats, published, recreated));
+    FFX_TEST_CHECK(recreated.serial != ticket.serial);
+    FFX_TEST_CHECK(broker.IsPublished(recreated));
+}
+
+// Publications that do not match what frame generation would compute take the fallback.
+static void testMismatch()
+{
+    SharedIntermediateBroker broker;
+
+    int                      producer;
+    SharedIntermediateSet    published = {};
+    SharedIntermediateTicket ticket    = {};
+
+    auto consumeAfterPublish = [&](const SharedIntermediateSet& set, FfxDevice device) {
+        broker.Publish(s_Device, &producer, set, 2);
+        return broker.Consume(device, makeExpected(), s_Formats, published, ticket);
+    };
+
+    SharedIntermediateSet set = makeSet(0);
+    FFX_TEST_CHECK(!consumeAfterPublish(set, (FfxDevice)0x200));
+
+    set = makeSet(0);
+    set.jitterOffset.x = 0.0f;
+    FFX_TEST_CHECK(!consumeAfterPublish(set, s_Device));
+
+    set = makeSet(0);
+    set.compatFlags |= SHARED_INTERMEDIATE_DEPTH_INFINITE;
+    FFX_TEST_CHECK(!consumeAfterPublish(set, s_Device));
+
+    set = makeSet(0);
+    set.resources[SHARED_INTERMEDIATE_DILATED_MOTION_VECTORS].description.format = FFX_SURFACE_FORMAT_R32G32_FLOAT;
+    FFX_TEST_CHECK(!consumeAfterPublish(set, s_Device));
+
+    set = makeSet(0);
+    set.resources[SHARED_INTERMEDIATE_DILATED_DEPTH].description.width = 640;
+    FFX_TEST_CHECK(!consumeAfterPublish(set, s_Device));
+
+    // Two views published this frame, the consumer cannot tell which one is its own.
+    int otherProducer;
+    broker.Publish(s_Device, &producer, makeSet(0), 2);
+    broker.Publish(s_Device, &otherProducer, makeSet(1), 2);
+    FFX_TEST_CHECK(!broker.Consume(s_Device, makeExpected(), s_Formats, published, ticket));
+
+    // Once the other view is gone the publication is unambiguous again.
+    broker.Revoke(&otherProducer);
+    FFX_TEST_CHECK(consumeAfterPublish(makeSet(0), s_Device));
+    FFX_TEST_CHECK(broker.GetStats().fallbacks == 6);
+}
+
+int main()
+{
+    testSkippedDispatch();
+    testRecreatedProducer();
+    testMismatch();
+    return FFX_TEST_RESULT();
+}
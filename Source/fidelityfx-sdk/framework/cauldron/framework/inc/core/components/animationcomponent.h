@@ -25,6 +25,7 @@
 #include "core/component.h"
 #include "misc/math.h"
 #include "render/animation.h"
+#include "render/animationbatch.h"
 
 #include "core/contentloader.h"
 
@@ -97,6 +98,13 @@ namespace cauldron
          */
         static AnimationComponentMgr* Get() { return s_pComponentManager; }
 
+        /**
+         * @brief   Samples the local transforms of all managed components. Keyframes are gathered into an
+         *          <c><i>AnimationKeyframeBatch</i></c> and interpolated four components at a time, large scenes
+         *          are split into chunks processed on the task manager's threads as well as the calling thread.
+         */
+        void SampleLocalTransforms(float time);
+
         /**
          * @brief   Returns the skinning matrices for the input modelId
          */
@@ -106,10 +114,15 @@ namespace cauldron
         }
 
     private:
+        void SampleLocalTransformRange(uint32_t begin, uint32_t end, float time);
+
         // <ModelID, SkinningData>
         std::unordered_map<uint32_t, SkinningData>     m_skinningData = {};
         static AnimationComponentMgr* s_pComponentManager;
 
+        AnimationKeyframeBatch  m_keyframeBatch = {};
+        uint32_t                m_workerThreadCount = 0;
+
         friend class GLTFLoader;
     };
 
@@ -175,6 +188,12 @@ namespace cauldron
          */
         void Update(double deltaTime) override;
 
+        /**
+         * @brief   Samples the keyframes surrounding <c><i>time</i></c> into the given lane of the batch.
+         *          Used by the <c><i>AnimationComponentMgr</i></c> to evaluate all components together.
+         */
+        void GatherKeyframes(uint32_t animationIndex, float time, AnimationKeyframeBatch& batch, uint32_t lane);
+
     private:
 
         AnimationComponent() = delete;
@@ -183,6 +202,9 @@ namespace cauldron
 
         Mat4 m_localTransform = Mat4::identity();
 
+        // Last key found per component sampler, playback moving forward resumes the search from there
+        int32_t m_keyCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Count)] = { 0 };
+
         // Keep a pointer on our initialization data for matrix reconstruction
         AnimationComponentData* m_pData;
     };
@@ -24,6 +24,7 @@
 
 #include "misc/assert.h"
 #include "misc/math.h"
+#include "render/animationinterpolants.h"
 #include "shaders/surfacerendercommon.h"
 
 #include <vector>
@@ -31,43 +32,6 @@
 
 namespace cauldron
 {
-    /**
-     * @struct AnimInterpolants
-     *
-     * Represents animation interpolation data for a specific frame of animation
-     *
-     * @ingroup CauldronRender
-     */
-    struct AnimInterpolants
-    {
-        std::vector<char> Data;
-        int32_t     Count = 0;
-        int32_t     Stride;
-        int32_t     Dimension;
-        Vec4        Min = Vec4(0.f, 0.f, 0.f, 0.f);
-        Vec4        Max = Vec4(0.f, 0.f, 0.f, 0.f);
-    };
-
-    /// Gets the <c><i>AnimInterpolants</i></c> for the given index (frame)
-    ///
-    /// @param [in] pInterpolant    The animation interpolants to read from.
-    /// @param [in] index           The index of frame of the data to fetch.
-    ///
-    /// @returns                    A pointer to the offsetted interpolant data.
-    ///
-    /// @ingroup CauldronRender
-    const void* GetInterpolant(const AnimInterpolants* pInterpolant, int32_t index);
-
-    /// Gets the closest <c><i>AnimInterpolants</i></c> for the given animation value
-    ///
-    /// @param [in] pInterpolant    The animation interpolants to read from.
-    /// @param [in] value           The value (time) at which to get nearest interpolated data from.
-    ///
-    /// @returns                    The index of the closest interpolant data to the desired value.
-    ///
-    /// @ingroup CauldronRender
-    int32_t FindClosestInterpolant(const AnimInterpolants* pInterpolant, float value);
-
     /**
      * @struct AnimationSkin
      *
@@ -163,7 +127,19 @@ namespace cauldron
         {
             if (HasComponentSampler(samplerID))
             {
-                SampleLinear(*m_pComponentSamplers[static_cast<uint32_t>(samplerID)], time, frac, pCurr, pNext);
+                SampleLinear(*m_pComponentSamplers[static_cast<uint32_t>(samplerID)], time, nullptr, frac, pCurr, pNext);
+            }
+        }
+
+        /**
+         * @brief   Samples the requested <c><i>ComponentSampler</i></c> at a specific time, resuming the key search from
+         *          <c><i>pCursor</i></c> and storing the key found back into it. Keep one cursor per sampler and caller.
+         */
+        void SampleAnimComponent(ComponentSampler samplerID, float time, int32_t* pCursor, float* frac, float** pCurr, float** pNext) const
+        {
+            if (HasComponentSampler(samplerID))
+            {
+                SampleLinear(*m_pComponentSamplers[static_cast<uint32_t>(samplerID)], time, pCursor, frac, pCurr, pNext);
             }
         }
 
@@ -200,7 +176,7 @@ namespace cauldron
             AnimInterpolants m_Value;
         } AnimSampler;
 
-        void SampleLinear(const AnimSampler& sampler, float time, float* frac, float** pCurr, float** pNext) const;
+        void SampleLinear(const AnimSampler& sampler, float time, int32_t* pCursor, float* frac, float** pCurr, float** pNext) const;
 
         AnimSampler* m_pComponentSamplers[static_cast<uint32_t>(ComponentSampler::Count)] = { nullptr };
     };
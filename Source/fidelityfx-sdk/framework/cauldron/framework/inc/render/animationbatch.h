@@ -0,0 +1,100 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include "misc/math.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @struct AnimationKeyframeBatch
+     *
+     * Keyframe pairs sampled for one frame in structure-of-arrays form, one lane per managed
+     * <c><i>AnimationComponent</i></c>. Lanes are padded to a multiple of 4 so they can be
+     * interpolated and turned into matrices four components at a time.
+     *
+     * @ingroup CauldronRender
+     */
+    struct AnimationKeyframeBatch
+    {
+        std::vector<float>      TranslationCurr[3];     ///< x, y, z of the key before the sample time
+        std::vector<float>      TranslationNext[3];     ///< x, y, z of the key after the sample time
+        std::vector<float>      TranslationFrac;        ///< Blend factor between the two translation keys
+        std::vector<float>      RotationCurr[4];        ///< x, y, z, w of the quaternion key before the sample time
+        std::vector<float>      RotationNext[4];        ///< x, y, z, w of the quaternion key after the sample time
+        std::vector<float>      RotationFrac;           ///< Blend factor between the two rotation keys
+        std::vector<float>      ScaleCurr[3];           ///< x, y, z of the key before the sample time
+        std::vector<float>      ScaleNext[3];           ///< x, y, z of the key after the sample time
+        std::vector<float>      ScaleFrac;              ///< Blend factor between the two scale keys
+        std::vector<uint8_t>    Animated;               ///< Non-zero when the lane's transform should be replaced
+
+        /**
+         * @brief   Sizes the batch for the given number of components and resets the padding lanes to identity.
+         */
+        void Resize(uint32_t componentCount);
+
+        /**
+         * @brief   Writes an identity transform into the given lane and marks it as not animated.
+         */
+        void SetIdentity(uint32_t lane);
+    };
+
+    /// Interpolates the 4 lanes of an <c><i>AnimationKeyframeBatch</i></c> starting at <c><i>lane</i></c>
+    /// and builds their translation * rotation * scale transforms.
+    ///
+    /// Rotation follows math::slerp lane for lane, so the results match per-component sampling.
+    ///
+    /// @param [in]  batch          The gathered keyframes.
+    /// @param [in]  lane           The first lane to evaluate, a multiple of 4.
+    /// @param [out] pTransforms    The 4 resulting local transforms.
+    ///
+    /// @ingroup CauldronRender
+    void EvaluateKeyframes(const AnimationKeyframeBatch& batch, uint32_t lane, Mat4* pTransforms);
+
+    /// Hands <c><i>taskCount</i></c> copies of a task to worker threads, such as the task manager's pool.
+    ///
+    /// @ingroup CauldronRender
+    typedef std::function<void(uint32_t taskCount, const std::function<void()>& task)> AnimationTaskLauncher;
+
+    /// Samples <c><i>componentCount</i></c> components in chunks of 128, spread over up to
+    /// <c><i>workerCount</i></c> worker tasks and the calling thread, and returns once every chunk is done.
+    ///
+    /// Each chunk starts on a 4 lane boundary. Small counts are sampled on the calling thread only.
+    ///
+    /// @param [in] componentCount  The number of components to sample.
+    /// @param [in] workerCount     The number of worker tasks that may help.
+    /// @param [in] launchTasks     Starts the worker tasks.
+    /// @param [in] sampleRange     Samples the components in [begin, end).
+    ///
+    /// @ingroup CauldronRender
+    void SampleAnimationChunks(uint32_t                                          componentCount,
+                               uint32_t                                          workerCount,
+                               const AnimationTaskLauncher&                      launchTasks,
+                               const std::function<void(uint32_t, uint32_t)>&    sampleRange);
+
+} // namespace cauldron
@@ -0,0 +1,84 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "misc/math.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @struct AnimInterpolants
+     *
+     * Represents animation interpolation data for a specific frame of animation
+     *
+     * @ingroup CauldronRender
+     */
+    struct AnimInterpolants
+    {
+        std::vector<char> Data;
+        int32_t     Count = 0;
+        int32_t     Stride;
+        int32_t     Dimension;
+        Vec4        Min = Vec4(0.f, 0.f, 0.f, 0.f);
+        Vec4        Max = Vec4(0.f, 0.f, 0.f, 0.f);
+    };
+
+    /// Gets the <c><i>AnimInterpolants</i></c> for the given index (frame)
+    ///
+    /// @param [in] pInterpolant    The animation interpolants to read from.
+    /// @param [in] index           The index of frame of the data to fetch.
+    ///
+    /// @returns                    A pointer to the offsetted interpolant data.
+    ///
+    /// @ingroup CauldronRender
+    const void* GetInterpolant(const AnimInterpolants* pInterpolant, int32_t index);
+
+    /// Gets the closest <c><i>AnimInterpolants</i></c> for the given animation value
+    ///
+    /// @param [in] pInterpolant    The animation interpolants to read from.
+    /// @param [in] value           The value (time) at which to get nearest interpolated data from.
+    ///
+    /// @returns                    The index of the closest interpolant data to the desired value.
+    ///
+    /// @ingroup CauldronRender
+    int32_t FindClosestInterpolant(const AnimInterpolants* pInterpolant, float value);
+
+    /// Gets the closest <c><i>AnimInterpolants</i></c> for the given animation value, starting from a previous result
+    ///
+    /// Playback time mostly moves forward, so the key found last time is usually the answer or a few keys
+    /// before it. Those cases are resolved by stepping forward from the cursor, anything else (looping back,
+    /// large jumps) falls back to <c><i>FindClosestInterpolant</i></c>.
+    ///
+    /// @param [in] pInterpolant    The animation interpolants to read from.
+    /// @param [in] value           The value (time) at which to get nearest interpolated data from.
+    /// @param [in] cursor          The index returned by the previous search on these interpolants.
+    ///
+    /// @returns                    The index of the closest interpolant data to the desired value.
+    ///
+    /// @ingroup CauldronRender
+    int32_t FindClosestInterpolant(const AnimInterpolants* pInterpolant, float value, int32_t cursor);
+
+} // namespace cauldron
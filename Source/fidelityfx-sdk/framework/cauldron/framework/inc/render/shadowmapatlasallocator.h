@@ -0,0 +1,138 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include "render/renderdefines.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cauldron
+{
+    /// An enumeration for shadow cell status
+    ///
+    /// @ingroup CauldronRender
+    enum class CellStatus
+    {
+        Empty,          ///< The cell is empty (its index is available for reuse).
+        Allocated,      ///< The cell has been allocated.
+    };
+
+    /// An structure represnting a shadow cell entry
+    ///
+    /// @ingroup CauldronRender
+    struct Cell
+    {
+        Rect rect;                              ///< The rect (coordinate representation) of the cell.
+        CellStatus status = CellStatus::Empty;  ///< The <c><i>CellStatus</i></c> (defaults to CellStatus::Empty).
+    };
+
+    /**
+     * @class ShadowMapAtlasAllocator
+     *
+     * Places the cells of a square shadow map atlas without touching any GPU resource.
+     *
+     * Free space is tracked as the list of maximal free rects. Cells of any rectangular size are placed in
+     * the free rect that fits them most tightly, and freed cells merge with all their free neighbours.
+     * Cell indices are stable handles, a cell's rect only changes when <c><i>Defragment</i></c> relocates it.
+     * Indices aren't validated here, <c><i>ShadowMapAtlas</i></c> checks them before forwarding.
+     *
+     * @ingroup CauldronRender
+     */
+    class ShadowMapAtlasAllocator
+    {
+    public:
+
+        /**
+         * @brief   Construction. The atlas starts as a single free rect of the given size (squared).
+         */
+        ShadowMapAtlasAllocator(uint32_t size);
+
+        /**
+         * @brief   Returns the size (squared) of the atlas.
+         */
+        uint32_t GetSize() const { return m_Size; }
+
+        /**
+         * @brief   Returns the number of cell indices handed out so far, allocated or not.
+         */
+        uint32_t GetCellCount() const { return static_cast<uint32_t>(m_Cells.size()); }
+
+        /**
+         * @brief   Returns the number of cells that are currently allocated.
+         */
+        uint32_t GetAllocatedCellCount() const { return static_cast<uint32_t>(m_Cells.size() - m_FreeCellIndices.size()); }
+
+        /**
+         * @brief   Returns the number of free rects currently tracked.
+         */
+        uint32_t GetFreeRectCount() const { return static_cast<uint32_t>(m_FreeRects.size()); }
+
+        /**
+         * @brief   Returns the <c><i>Cell</i></c> information for the atlas cell corresponding to the requested index.
+         */
+        const Cell& GetCell(int32_t index) const { return m_Cells[index]; }
+
+        /**
+         * @brief   Returns the free rect corresponding to the requested index.
+         */
+        const Rect& GetFreeRect(int32_t index) const { return m_FreeRects[index]; }
+
+        /**
+         * @brief   Returns an index to the free rect that best fits the requested size, or -1 if none was found.
+         *          The area left over in that free rect is returned in <c><i>pLeftoverArea</i></c> when provided.
+         */
+        int32_t FindBestFreeRect(uint32_t width, uint32_t height, uint64_t* pLeftoverArea = nullptr) const;
+
+        /**
+         * @brief   Allocates a new cell of specified size at the top left of the index-defined free rect and returns the cell index.
+         */
+        int32_t AllocateCell(uint32_t width, uint32_t height, int32_t freeRectIndex);
+
+        /**
+         * @brief   Frees the specified cell.
+         */
+        void FreeCell(int32_t index);
+
+        /**
+         * @brief   Relocates up to <c><i>maxMoves</i></c> cells towards the top left of the atlas so free space
+         *          gathers into large rects. Returns the number of cells moved, callers must refresh the rects
+         *          they hold for those cells.
+         */
+        uint32_t Defragment(uint32_t maxMoves);
+
+    private:
+        void ReserveRect(const Rect& usedRect);
+        void RebuildFreeRects();
+
+        // internal members
+        std::vector<Cell>    m_Cells;
+        std::vector<int32_t> m_FreeCellIndices;
+        std::vector<Rect>    m_FreeRects;
+        std::vector<Rect>    m_ScratchRects;
+        uint32_t             m_Size = 0;
+        bool                 m_Compacted = true;    // Nothing changed since the last defragmentation pass moved no cell
+    };
+
+} // namespace cauldron
@@ -24,6 +24,7 @@
 
 #include "misc/math.h"
 #include "render/gpuresource.h"
+#include "render/shadowmapatlasallocator.h"
 #include "render/texture.h"
 
 #include <mutex>
@@ -31,30 +32,11 @@
 
 namespace cauldron
 {
-    /// An enumeration for shadow cell status
-    ///
-    /// @ingroup CauldronRender
-    enum class CellStatus
-    {
-        Empty,          ///< The cell is empty.
-        Allocated,      ///< The cell has been allocated.
-        Subdivided      ///< The cell was subdivided into 4 cells.
-    };
-
-    /// An structure represnting a shadow cell entry
-    ///
-    /// @ingroup CauldronRender
-    struct Cell
-    {
-        uint32_t size = 0;                      ///< The size (squared) of the cell.
-        Rect rect;                              ///< The rect (coordinate representation) of the cell.
-        CellStatus status = CellStatus::Empty;  ///< The <c><i>CellStatus</i></c> (defaults to CellStatus::Empty).
-    };
-
     /**
      * @class ShadowMapAtlas
      *
-     * The <c><i>FidelityFX Cauldron Framework</i></c> shadow map atlas representation.
+     * The <c><i>FidelityFX Cauldron Framework</i></c> shadow map atlas representation. Owns the atlas render target
+     * and validates the requests it forwards to its <c><i>ShadowMapAtlasAllocator</i></c>.
      *
      * @ingroup CauldronRender
      */
@@ -83,28 +65,32 @@ namespace cauldron
         Cell GetCell(int32_t index) const;
 
         /**
-         * @brief   Returns an index to a cell that can hold the requested size of texture, or -1 if none was found.
+         * @brief   Returns an index to the free rect that best fits the requested size, or -1 if none was found.
+         *          The area left over in that free rect is returned in <c><i>pLeftoverArea</i></c> when provided.
          */
-        int32_t FindBestCell(uint32_t size) const;
+        int32_t FindBestFreeRect(uint32_t width, uint32_t height, uint64_t* pLeftoverArea = nullptr) const { return m_Allocator.FindBestFreeRect(width, height, pLeftoverArea); }
 
         /**
-         * @brief   Allocates a new sub-cell of specified size into the index-defined cell in the shadow atlas.
+         * @brief   Allocates a new cell of specified size at the top left of the index-defined free rect and returns the cell index.
          */
-        int32_t AllocateCell(uint32_t size, int32_t index);
+        int32_t AllocateCell(uint32_t width, uint32_t height, int32_t freeRectIndex);
 
         /**
          * @brief   Frees the specified cell.
          */
         void FreeCell(int32_t index);
 
-    private:
-        static int32_t GetChildrenBaseIndex(int32_t index);
-        static int32_t GetParentIndex(int32_t index);
-        void FindBestCellRecursive(size_t size, int32_t currentIndex, int32_t& foundCellIndex) const;
+        /**
+         * @brief   Relocates up to <c><i>maxMoves</i></c> cells towards the top left of the atlas so free space
+         *          gathers into large rects. Returns the number of cells moved, callers must refresh the rects
+         *          they hold for those cells.
+         */
+        uint32_t Defragment(uint32_t maxMoves) { return m_Allocator.Defragment(maxMoves); }
 
+    private:
         // internal members
-        std::vector<Cell> m_Cells;
-        Texture* m_pRenderTarget = nullptr;
+        ShadowMapAtlasAllocator m_Allocator;
+        Texture*                m_pRenderTarget = nullptr;
     };
 
     /// An enumeration for shadow map resolution occupancy
@@ -171,11 +157,28 @@ namespace cauldron
          */
         ShadowMapView GetNewShadowMap(ShadowMapResolution resolution = ShadowMapResolution::Full);
 
+        /**
+         * @brief   Same as above for a rectangular shadow map of the given size, which can't exceed <c><i>g_ShadowMapTextureSize</i></c>.
+         */
+        ShadowMapView GetNewShadowMap(uint32_t width, uint32_t height);
+
         /**
          * @brief   Releases the specified shadow map backing resource.
          */
         void ReleaseShadowMap(int index, int32_t cellIndex);
 
+        /**
+         * @brief   Returns the current rect of the specified shadow map, which changes when <c><i>Defragment</i></c> moves it.
+         */
+        Rect GetShadowMapRect(int index, int32_t cellIndex);
+
+        /**
+         * @brief   Compacts the shadow map atlases by relocating at most <c><i>maxMoves</i></c> shadow maps within their atlas.
+         *          Returns the number of shadow maps moved. Moved shadow maps keep their index and cell index but need
+         *          to be rendered to their new rect, see <c><i>GetShadowMapRect</i></c>.
+         */
+        uint32_t Defragment(uint32_t maxMoves);
+
         /**
          * @brief   Returns the format used by shadow map textures.
          */
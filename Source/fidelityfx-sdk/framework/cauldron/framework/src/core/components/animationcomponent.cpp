@@ -23,12 +23,15 @@
 #include "core/components/animationcomponent.h"
 #include "core/entity.h"
 #include "core/framework.h"
+#include "core/taskmanager.h"
 #include "render/rtresources.h"
 
 #include "misc/assert.h"
+#include "misc/corecounts.h"
 #include "misc/math.h"
 
 #include<algorithm>
+#include<queue>
 
 namespace cauldron
 {
@@ -64,6 +67,10 @@ namespace cauldron
 
         // Initialize the convenience accessor to avoid having to do a map::find each time we want the manager
         s_pComponentManager = this;
+
+        // Same pool size the task manager was created with
+        const uint32_t threadCount = GetRecommendedThreadCount();
+        m_workerThreadCount = threadCount > 1 ? threadCount - 1 : 0;
     }
 
     void AnimationComponentMgr::Shutdown()
@@ -118,7 +125,7 @@ namespace cauldron
             Vec4 translation = Vec4(0, 0, 0, 0);
             if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Translation))
             {
-                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Translation, time, &frac, &pCurr, &pNext);
+                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Translation, time, &m_keyCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Translation)], &frac, &pCurr, &pNext);
                 translation = ((1.0f - frac) * math::Vector4(pCurr[0], pCurr[1], pCurr[2], 0)) + ((frac)*math::Vector4(pNext[0], pNext[1], pNext[2], 0));
             }
             else
@@ -131,7 +138,7 @@ namespace cauldron
             Mat4 rotation = Mat4::identity();
             if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Rotation))
             {
-                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Rotation, time, &frac, &pCurr, &pNext);
+                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Rotation, time, &m_keyCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Rotation)], &frac, &pCurr, &pNext);
                 rotation =
                     math::Matrix4(math::slerp(frac, math::Quat(pCurr[0], pCurr[1], pCurr[2], pCurr[3]), math::Quat(pNext[0], pNext[1], pNext[2], pNext[3])),
                                   math::Vector3(0.0f, 0.0f, 0.0f));
@@ -142,7 +149,7 @@ namespace cauldron
             Vec4 scale = Vec4(1, 1, 1, 1);
             if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Scale))
             {
-                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Scale, time, &frac, &pCurr, &pNext);
+                pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Scale, time, &m_keyCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Scale)], &frac, &pCurr, &pNext);
                 scale = ((1.0f - frac) * math::Vector4(pCurr[0], pCurr[1], pCurr[2], 0)) + ((frac)*math::Vector4(pNext[0], pNext[1], pNext[2], 0));
             }
 
@@ -152,16 +159,116 @@ namespace cauldron
         }
     }
 
+    void AnimationComponent::GatherKeyframes(uint32_t animationIndex, float time, AnimationKeyframeBatch& batch, uint32_t lane)
+    {
+        batch.SetIdentity(lane);
+
+        if (animationIndex >= m_pData->m_pAnimRef->size())
+        {
+            CauldronWarning(L"Animation selected not available");
+            return;
+        }
+
+        Animation* animation = (*m_pData->m_pAnimRef)[animationIndex];
+
+        // Loop animation
+        time = fmod(time, animation->GetDuration());
+
+        const AnimChannel* pAnimChannel = animation->GetAnimationChannel(m_pData->m_nodeId);
+        if (!pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Translation) &&
+            !pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Rotation) &&
+            !pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Scale))
+            return;
+
+        batch.Animated[lane] = 1;
+
+        float frac, *pCurr, *pNext;
+        if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Translation))
+        {
+            pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Translation, time, &m_keyCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Translation)], &frac, &pCurr, &pNext);
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                batch.TranslationCurr[i][lane] = pCurr[i];
+                batch.TranslationNext[i][lane] = pNext[i];
+            }
+            batch.TranslationFrac[lane] = frac;
+        }
+        else
+        {
+            // Keep the current translation
+            const Vec4 translation = m_localTransform.getCol3();
+            for (uint32_t i = 0; i < 3; ++i)
+                batch.TranslationCurr[i][lane] = batch.TranslationNext[i][lane] = translation[i];
+        }
+
+        if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Rotation))
+        {
+            pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Rotation, time, &m_keyCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Rotation)], &frac, &pCurr, &pNext);
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                batch.RotationCurr[i][lane] = pCurr[i];
+                batch.RotationNext[i][lane] = pNext[i];
+            }
+            batch.RotationFrac[lane] = frac;
+        }
+
+        if (pAnimChannel->HasComponentSampler(AnimChannel::ComponentSampler::Scale))
+        {
+            pAnimChannel->SampleAnimComponent(AnimChannel::ComponentSampler::Scale, time, &m_keyCursors[static_cast<uint32_t>(AnimChannel::ComponentSampler::Scale)], &frac, &pCurr, &pNext);
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                batch.ScaleCurr[i][lane] = pCurr[i];
+                batch.ScaleNext[i][lane] = pNext[i];
+            }
+            batch.ScaleFrac[lane] = frac;
+        }
+    }
+
+    void AnimationComponentMgr::SampleLocalTransformRange(uint32_t begin, uint32_t end, float time)
+    {
+        CauldronAssert(ASSERT_CRITICAL, (begin & 3) == 0, L"Animation sample ranges must start on a 4 lane boundary");
+
+        for (uint32_t i = begin; i < end; ++i)
+            static_cast<AnimationComponent*>(m_ManagedComponents[i])->GatherKeyframes(0, time, m_keyframeBatch, i);
+
+        Mat4 transforms[4];
+        for (uint32_t lane = begin; lane < end; lane += 4)
+        {
+            EvaluateKeyframes(m_keyframeBatch, lane, transforms);
+
+            const uint32_t laneEnd = std::min(lane + 4, end);
+            for (uint32_t i = lane; i < laneEnd; ++i)
+            {
+                if (m_keyframeBatch.Animated[i])
+                    static_cast<AnimationComponent*>(m_ManagedComponents[i])->SetLocalTransform(transforms[i - lane]);
+            }
+        }
+    }
+
+    void AnimationComponentMgr::SampleLocalTransforms(float time)
+    {
+        const uint32_t componentCount = GetComponentCount();
+        m_keyframeBatch.Resize(componentCount);
+
+        SampleAnimationChunks(
+            componentCount,
+            m_workerThreadCount,
+            [](uint32_t taskCount, const std::function<void()>& task) {
+                std::queue<Task> taskList;
+                for (uint32_t i = 0; i < taskCount; ++i)
+                    taskList.push(Task([task](void*) { task(); }));
+                GetTaskManager()->AddTaskList(taskList);
+            },
+            [this, time](uint32_t begin, uint32_t end) { SampleLocalTransformRange(begin, end, time); });
+    }
+
     void cauldron::AnimationComponentMgr::UpdateComponents(double deltaTime)
     {
         static double time = 0.0;
         time += deltaTime;
 
         // Update local transforms
-        for (auto& component : m_ManagedComponents)
-        {
-            component->Update(time);
-        }
+        SampleLocalTransforms(static_cast<float>(time));
 
         // Update global transforms (process the hierarchy)
         for (auto& component : m_ManagedComponents)
@@ -24,38 +24,11 @@
 
 namespace cauldron
 {
-    const void* GetInterpolant(const AnimInterpolants* pInterpolant, int32_t index)
+    void AnimChannel::SampleLinear(const AnimSampler& sampler, float time, int32_t* pCursor, float* frac, float** pCurr, float** pNext) const
     {
-        if (index >= pInterpolant->Count)
-            index = pInterpolant->Count - 1;
-
-        return (const char*)pInterpolant->Data.data() + pInterpolant->Stride * index;
-    }
-
-    int FindClosestInterpolant(const AnimInterpolants* pInterpolant, float value)
-    {
-        int32_t iter = 0;
-        int32_t end  = pInterpolant->Count - 1;
-
-        while (iter <= end)
-        {
-            int32_t mid         = (iter + end) / 2;
-            float   interpolant = *(const float*)GetInterpolant(pInterpolant, mid);
-
-            if (value < interpolant)
-                end = mid - 1;
-            else if (value > interpolant)
-                iter = mid + 1;
-            else
-                return mid;
-        }
-
-        return end;
-    }
-
-    void AnimChannel::SampleLinear(const AnimSampler& sampler, float time, float* frac, float** pCurr, float** pNext) const
-    {
-        int curr_index = FindClosestInterpolant(&sampler.m_Time, time);
+        int curr_index = pCursor ? FindClosestInterpolant(&sampler.m_Time, time, *pCursor) : FindClosestInterpolant(&sampler.m_Time, time);
+        if (pCursor)
+            *pCursor = curr_index;
         int next_index = std::min<int>(curr_index + 1, sampler.m_Time.Count - 1);
 
         if (curr_index < 0)
@@ -0,0 +1,229 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "render/animationbatch.h"
+#include "misc/helpers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace cauldron
+{
+    void AnimationKeyframeBatch::Resize(uint32_t componentCount)
+    {
+        const uint32_t laneCount = AlignUp(componentCount, 4u);
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            TranslationCurr[i].resize(laneCount);
+            TranslationNext[i].resize(laneCount);
+            ScaleCurr[i].resize(laneCount);
+            ScaleNext[i].resize(laneCount);
+        }
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            RotationCurr[i].resize(laneCount);
+            RotationNext[i].resize(laneCount);
+        }
+        TranslationFrac.resize(laneCount);
+        RotationFrac.resize(laneCount);
+        ScaleFrac.resize(laneCount);
+        Animated.resize(laneCount);
+
+        for (uint32_t lane = componentCount; lane < laneCount; ++lane)
+            SetIdentity(lane);
+    }
+
+    void AnimationKeyframeBatch::SetIdentity(uint32_t lane)
+    {
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            TranslationCurr[i][lane] = TranslationNext[i][lane] = 0.f;
+            ScaleCurr[i][lane]       = ScaleNext[i][lane]       = 1.f;
+        }
+        for (uint32_t i = 0; i < 4; ++i)
+            RotationCurr[i][lane] = RotationNext[i][lane] = (i == 3) ? 1.f : 0.f;
+
+        TranslationFrac[lane] = RotationFrac[lane] = ScaleFrac[lane] = 0.f;
+        Animated[lane] = 0;
+    }
+
+#if VECTORMATH_MODE_SSE
+
+    static inline __m128 LoadLanes(const std::vector<float>& values, uint32_t lane)
+    {
+        return _mm_loadu_ps(values.data() + lane);
+    }
+
+    static inline __m128 LerpLanes(__m128 curr, __m128 next, __m128 frac)
+    {
+        return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.f), frac), curr), _mm_mul_ps(frac, next));
+    }
+
+    // Interpolates and builds translation * rotation * scale for the 4 lanes starting at lane.
+    // Rotation follows math::slerp lane for lane: shortest path, and a linear blend once the keys are
+    // closer than VECTORMATH_SLERP_TOL.
+    void EvaluateKeyframes(const AnimationKeyframeBatch& batch, uint32_t lane, Mat4* pTransforms)
+    {
+        const __m128 translationFrac = LoadLanes(batch.TranslationFrac, lane);
+        const __m128 tx = LerpLanes(LoadLanes(batch.TranslationCurr[0], lane), LoadLanes(batch.TranslationNext[0], lane), translationFrac);
+        const __m128 ty = LerpLanes(LoadLanes(batch.TranslationCurr[1], lane), LoadLanes(batch.TranslationNext[1], lane), translationFrac);
+        const __m128 tz = LerpLanes(LoadLanes(batch.TranslationCurr[2], lane), LoadLanes(batch.TranslationNext[2], lane), translationFrac);
+
+        const __m128 scaleFrac = LoadLanes(batch.ScaleFrac, lane);
+        const __m128 sx = LerpLanes(LoadLanes(batch.ScaleCurr[0], lane), LoadLanes(batch.ScaleNext[0], lane), scaleFrac);
+        const __m128 sy = LerpLanes(LoadLanes(batch.ScaleCurr[1], lane), LoadLanes(batch.ScaleNext[1], lane), scaleFrac);
+        const __m128 sz = LerpLanes(LoadLanes(batch.ScaleCurr[2], lane), LoadLanes(batch.ScaleNext[2], lane), scaleFrac);
+
+        __m128 q0[4], q1[4];
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            q0[i] = LoadLanes(batch.RotationCurr[i], lane);
+            q1[i] = LoadLanes(batch.RotationNext[i], lane);
+        }
+
+        __m128 cosAngle = _mm_add_ps(_mm_add_ps(_mm_mul_ps(q0[0], q1[0]), _mm_mul_ps(q0[1], q1[1])), _mm_add_ps(_mm_mul_ps(q0[2], q1[2]), _mm_mul_ps(q0[3], q1[3])));
+        const __m128 negateMask = _mm_cmpgt_ps(_mm_setzero_ps(), cosAngle);
+        const __m128 signBit    = _mm_and_ps(negateMask, _mm_set1_ps(-0.f));
+        cosAngle = _mm_xor_ps(cosAngle, signBit);
+        for (uint32_t i = 0; i < 4; ++i)
+            q0[i] = _mm_xor_ps(q0[i], signBit);
+
+        const __m128 rotationFrac = LoadLanes(batch.RotationFrac, lane);
+        const __m128 oneMinusFrac = _mm_sub_ps(_mm_set1_ps(1.f), rotationFrac);
+        const __m128 slerpMask    = _mm_cmpgt_ps(_mm_set1_ps(math::VECTORMATH_SLERP_TOL), cosAngle);
+        const __m128 angle        = math::sseACosf(cosAngle);
+        const __m128 sinAngle     = math::sseSinf(angle);
+        const __m128 scale0       = math::sseSelect(oneMinusFrac, _mm_div_ps(math::sseSinf(_mm_mul_ps(oneMinusFrac, angle)), sinAngle), slerpMask);
+        const __m128 scale1       = math::sseSelect(rotationFrac, _mm_div_ps(math::sseSinf(_mm_mul_ps(rotationFrac, angle)), sinAngle), slerpMask);
+
+        const __m128 qx = _mm_add_ps(_mm_mul_ps(q0[0], scale0), _mm_mul_ps(q1[0], scale1));
+        const __m128 qy = _mm_add_ps(_mm_mul_ps(q0[1], scale0), _mm_mul_ps(q1[1], scale1));
+        const __m128 qz = _mm_add_ps(_mm_mul_ps(q0[2], scale0), _mm_mul_ps(q1[2], scale1));
+        const __m128 qw = _mm_add_ps(_mm_mul_ps(q0[3], scale0), _mm_mul_ps(q1[3], scale1));
+
+        // Rotation matrix of the quaternion, columns scaled by the lane's scale
+        const __m128 one = _mm_set1_ps(1.f);
+        const __m128 two = _mm_set1_ps(2.f);
+        const __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+        const __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+        const __m128 xw = _mm_mul_ps(qx, qw), yw = _mm_mul_ps(qy, qw), zw = _mm_mul_ps(qz, qw);
+
+        __m128 col0[4] = { _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                           _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, zw)), sx),
+                           _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, yw)), sx),
+                           _mm_setzero_ps() };
+        __m128 col1[4] = { _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, zw)), sy),
+                           _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                           _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, xw)), sy),
+                           _mm_setzero_ps() };
+        __m128 col2[4] = { _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, yw)), sz),
+                           _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, xw)), sz),
+                           _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+                           _mm_setzero_ps() };
+        __m128 col3[4] = { tx, ty, tz, one };
+
+        // Lanes to matrices
+        _MM_TRANSPOSE4_PS(col0[0], col0[1], col0[2], col0[3]);
+        _MM_TRANSPOSE4_PS(col1[0], col1[1], col1[2], col1[3]);
+        _MM_TRANSPOSE4_PS(col2[0], col2[1], col2[2], col2[3]);
+        _MM_TRANSPOSE4_PS(col3[0], col3[1], col3[2], col3[3]);
+        for (uint32_t i = 0; i < 4; ++i)
+            pTransforms[i] = Mat4(Vec4(col0[i]), Vec4(col1[i]), Vec4(col2[i]), Vec4(col3[i]));
+    }
+
+#else
+
+    void EvaluateKeyframes(const AnimationKeyframeBatch& batch, uint32_t lane, Mat4* pTransforms)
+    {
+        for (uint32_t i = 0; i < 4; ++i, ++lane)
+        {
+            float frac = batch.TranslationFrac[lane];
+            const Vec3 translation = ((1.0f - frac) * Vec3(batch.TranslationCurr[0][lane], batch.TranslationCurr[1][lane], batch.TranslationCurr[2][lane])) +
+                                     (frac * Vec3(batch.TranslationNext[0][lane], batch.TranslationNext[1][lane], batch.TranslationNext[2][lane]));
+
+            frac = batch.ScaleFrac[lane];
+            const Vec3 scale = ((1.0f - frac) * Vec3(batch.ScaleCurr[0][lane], batch.ScaleCurr[1][lane], batch.ScaleCurr[2][lane])) +
+                               (frac * Vec3(batch.ScaleNext[0][lane], batch.ScaleNext[1][lane], batch.ScaleNext[2][lane]));
+
+            const math::Quat rotation = math::slerp(batch.RotationFrac[lane],
+                                                    math::Quat(batch.RotationCurr[0][lane], batch.RotationCurr[1][lane], batch.RotationCurr[2][lane], batch.RotationCurr[3][lane]),
+                                                    math::Quat(batch.RotationNext[0][lane], batch.RotationNext[1][lane], batch.RotationNext[2][lane], batch.RotationNext[3][lane]));
+
+            pTransforms[i] = math::Matrix4::translation(translation) * math::Matrix4(rotation, Vec3(0.0f, 0.0f, 0.0f)) * math::Matrix4::scale(scale);
+        }
+    }
+
+#endif // VECTORMATH_MODE_SSE
+
+    // Components sampled per task, a multiple of the 4 lanes evaluated together
+    static const uint32_t s_ComponentsPerSampleChunk = 128;
+
+    // Progress of one frame's sampling, shared with the tasks so late starters find nothing left to do
+    struct SampleTaskState
+    {
+        std::function<void(uint32_t, uint32_t)> SampleRange;
+        uint32_t                                ComponentCount  = 0;
+        uint32_t                                ChunkCount      = 0;
+        std::atomic_uint                        NextChunk       = { 0 };
+        std::atomic_uint                        CompletedChunks = { 0 };
+    };
+
+    static void RunSampleTasks(SampleTaskState* pState)
+    {
+        for (uint32_t chunk = pState->NextChunk++; chunk < pState->ChunkCount; chunk = pState->NextChunk++)
+        {
+            const uint32_t begin = chunk * s_ComponentsPerSampleChunk;
+            pState->SampleRange(begin, std::min(begin + s_ComponentsPerSampleChunk, pState->ComponentCount));
+            ++pState->CompletedChunks;
+        }
+    }
+
+    void SampleAnimationChunks(uint32_t                                          componentCount,
+                               uint32_t                                          workerCount,
+                               const AnimationTaskLauncher&                      launchTasks,
+                               const std::function<void(uint32_t, uint32_t)>&    sampleRange)
+    {
+        const uint32_t chunkCount = DivideRoundingUp(componentCount, s_ComponentsPerSampleChunk);
+        const uint32_t taskCount  = std::min(chunkCount, workerCount + 1);
+        if (taskCount <= 1)
+        {
+            sampleRange(0, componentCount);
+            return;
+        }
+
+        // Workers and this thread pull chunks until none are left. The state is shared so a task that only
+        // starts after the frame's work is done still has something valid to look at.
+        std::shared_ptr<SampleTaskState> pState = std::make_shared<SampleTaskState>();
+        pState->SampleRange    = sampleRange;
+        pState->ComponentCount = componentCount;
+        pState->ChunkCount     = chunkCount;
+        launchTasks(taskCount - 1, [pState]() { RunSampleTasks(pState.get()); });
+
+        RunSampleTasks(pState.get());
+        while (pState->CompletedChunks.load() < chunkCount)
+            std::this_thread::yield();
+    }
+
+} // namespace cauldron
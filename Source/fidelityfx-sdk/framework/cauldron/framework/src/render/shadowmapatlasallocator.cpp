@@ -0,0 +1,225 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "render/shadowmapatlasallocator.h"
+#include "misc/helpers.h"
+
+#include <algorithm>
+
+namespace cauldron
+{
+    static inline uint32_t GetRectWidth(const Rect& rect) { return rect.Right - rect.Left; }
+    static inline uint32_t GetRectHeight(const Rect& rect) { return rect.Bottom - rect.Top; }
+
+    static inline bool RectsOverlap(const Rect& a, const Rect& b)
+    {
+        return a.Left < b.Right && b.Left < a.Right && a.Top < b.Bottom && b.Top < a.Bottom;
+    }
+
+    static inline bool RectContains(const Rect& outer, const Rect& inner)
+    {
+        return outer.Left <= inner.Left && outer.Top <= inner.Top && outer.Right >= inner.Right && outer.Bottom >= inner.Bottom;
+    }
+
+    // Cells are aligned to the largest power of two dividing their size so cells of the same size line up
+    // like quadtree cells do, which keeps the space freed between them reusable
+    static inline uint32_t GetPlacementAlignment(uint32_t size) { return size & (~size + 1); }
+
+    static inline bool FitAligned(const Rect& freeRect, uint32_t width, uint32_t height, uint32_t& left, uint32_t& top)
+    {
+        left = AlignUp(freeRect.Left, GetPlacementAlignment(width));
+        top  = AlignUp(freeRect.Top, GetPlacementAlignment(height));
+        return left + width <= freeRect.Right && top + height <= freeRect.Bottom;
+    }
+
+    ShadowMapAtlasAllocator::ShadowMapAtlasAllocator(uint32_t size)
+        : m_Size{ size }
+    {
+        m_FreeRects.push_back({ 0, 0, size, size });
+    }
+
+    int32_t ShadowMapAtlasAllocator::FindBestFreeRect(uint32_t width, uint32_t height, uint64_t* pLeftoverArea) const
+    {
+        // Best short side fit, ties go to the rect with the least area left over
+        int32_t  foundRectIndex   = -1;
+        uint64_t bestLeftoverArea = 0;
+        uint32_t bestShortSide    = 0;
+        for (int32_t i = 0; i < static_cast<int32_t>(m_FreeRects.size()); ++i)
+        {
+            const Rect& freeRect = m_FreeRects[i];
+            uint32_t left, top;
+            if (!FitAligned(freeRect, width, height, left, top))
+                continue;
+
+            const uint64_t leftoverArea = static_cast<uint64_t>(GetRectWidth(freeRect)) * GetRectHeight(freeRect) - static_cast<uint64_t>(width) * height;
+            const uint32_t shortSide    = std::min(GetRectWidth(freeRect) - width, GetRectHeight(freeRect) - height);
+            if (foundRectIndex < 0 || shortSide < bestShortSide || (shortSide == bestShortSide && leftoverArea < bestLeftoverArea))
+            {
+                foundRectIndex   = i;
+                bestLeftoverArea = leftoverArea;
+                bestShortSide    = shortSide;
+            }
+        }
+
+        if (pLeftoverArea)
+            *pLeftoverArea = bestLeftoverArea;
+        return foundRectIndex;
+    }
+
+    int32_t ShadowMapAtlasAllocator::AllocateCell(uint32_t width, uint32_t height, int32_t freeRectIndex)
+    {
+        const Rect freeRect = m_FreeRects[freeRectIndex];
+
+        Cell cell;
+        uint32_t left = 0, top = 0;
+        FitAligned(freeRect, width, height, left, top);
+        cell.rect   = { left, top, left + width, top + height };
+        cell.status = CellStatus::Allocated;
+        ReserveRect(cell.rect);
+
+        // reuse a released cell index if there is one
+        int32_t index = static_cast<int32_t>(m_Cells.size());
+        if (!m_FreeCellIndices.empty())
+        {
+            index = m_FreeCellIndices.back();
+            m_FreeCellIndices.pop_back();
+            m_Cells[index] = cell;
+        }
+        else
+            m_Cells.push_back(cell);
+
+        m_Compacted = false;
+        return index;
+    }
+
+    void ShadowMapAtlasAllocator::FreeCell(int32_t index)
+    {
+        m_Cells[index].status = CellStatus::Empty;
+        m_FreeCellIndices.push_back(index);
+        RebuildFreeRects();
+
+        m_Compacted = false;
+    }
+
+    uint32_t ShadowMapAtlasAllocator::Defragment(uint32_t maxMoves)
+    {
+        if (m_Compacted || maxMoves == 0)
+            return 0;
+
+        // Cells furthest from the top left get the first chance to move up
+        std::vector<int32_t> candidates;
+        for (int32_t i = 0; i < static_cast<int32_t>(m_Cells.size()); ++i)
+        {
+            if (m_Cells[i].status == CellStatus::Allocated)
+                candidates.push_back(i);
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](int32_t a, int32_t b) {
+            const Rect& rectA = m_Cells[a].rect;
+            const Rect& rectB = m_Cells[b].rect;
+            return rectA.Top != rectB.Top ? rectA.Top > rectB.Top : rectA.Left > rectB.Left;
+        });
+
+        uint32_t moveCount = 0;
+        for (int32_t index : candidates)
+        {
+            if (moveCount == maxMoves)
+                return moveCount;
+
+            // Free space above or to the left of the cell, the highest then leftmost one wins
+            const Rect currentRect = m_Cells[index].rect;
+            const uint32_t width   = GetRectWidth(currentRect);
+            const uint32_t height  = GetRectHeight(currentRect);
+            uint32_t bestLeft = currentRect.Left, bestTop = currentRect.Top;
+            for (const Rect& freeRect : m_FreeRects)
+            {
+                uint32_t left, top;
+                if (FitAligned(freeRect, width, height, left, top) && (top < bestTop || (top == bestTop && left < bestLeft)))
+                {
+                    bestLeft = left;
+                    bestTop  = top;
+                }
+            }
+
+            if (bestLeft != currentRect.Left || bestTop != currentRect.Top)
+            {
+                m_Cells[index].rect = { bestLeft, bestTop, bestLeft + width, bestTop + height };
+                RebuildFreeRects();
+                ++moveCount;
+            }
+        }
+
+        // A full pass without moves means only allocations and frees can give us more work
+        m_Compacted = (moveCount == 0);
+        return moveCount;
+    }
+
+    void ShadowMapAtlasAllocator::ReserveRect(const Rect& usedRect)
+    {
+        // Every free rect the used rect overlaps is replaced by the (up to 4) largest rects around it
+        m_ScratchRects.clear();
+        for (const Rect& freeRect : m_FreeRects)
+        {
+            if (!RectsOverlap(freeRect, usedRect))
+            {
+                m_ScratchRects.push_back(freeRect);
+                continue;
+            }
+
+            if (usedRect.Left > freeRect.Left)
+                m_ScratchRects.push_back({ freeRect.Left, freeRect.Top, usedRect.Left, freeRect.Bottom });
+            if (usedRect.Right < freeRect.Right)
+                m_ScratchRects.push_back({ usedRect.Right, freeRect.Top, freeRect.Right, freeRect.Bottom });
+            if (usedRect.Top > freeRect.Top)
+                m_ScratchRects.push_back({ freeRect.Left, freeRect.Top, freeRect.Right, usedRect.Top });
+            if (usedRect.Bottom < freeRect.Bottom)
+                m_ScratchRects.push_back({ freeRect.Left, usedRect.Bottom, freeRect.Right, freeRect.Bottom });
+        }
+
+        // Only keep maximal rects, dropping those contained in another one (the first of two equal rects is kept)
+        m_FreeRects.clear();
+        for (size_t i = 0; i < m_ScratchRects.size(); ++i)
+        {
+            bool contained = false;
+            for (size_t j = 0; j < m_ScratchRects.size() && !contained; ++j)
+            {
+                if (i != j && RectContains(m_ScratchRects[j], m_ScratchRects[i]))
+                    contained = !RectContains(m_ScratchRects[i], m_ScratchRects[j]) || j < i;
+            }
+            if (!contained)
+                m_FreeRects.push_back(m_ScratchRects[i]);
+        }
+    }
+
+    void ShadowMapAtlasAllocator::RebuildFreeRects()
+    {
+        // Freed space merges with all its free neighbours by carving the remaining cells out of an empty atlas
+        m_FreeRects.clear();
+        m_FreeRects.push_back({ 0, 0, m_Size, m_Size });
+        for (const Cell& cell : m_Cells)
+        {
+            if (cell.status == CellStatus::Allocated)
+                ReserveRect(cell.rect);
+        }
+    }
+
+} // namespace cauldron
@@ -23,166 +23,43 @@
 #include "render/shadowmapresourcepool.h"
 #include "misc/assert.h"
 #include "core/framework.h"
+#include "misc/helpers.h"
 
 namespace cauldron
 {
     ShadowMapAtlas::ShadowMapAtlas(uint32_t size, Texture* pRenderTarget)
-        : m_pRenderTarget{ pRenderTarget }
+        : m_Allocator{ size }
+        , m_pRenderTarget{ pRenderTarget }
     {
-        Cell rootCell = { size, { 0, 0, size, size }, CellStatus::Empty };
-        m_Cells.push_back(rootCell);
     }
 
     ShadowMapAtlas::~ShadowMapAtlas()
     {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[0].status == CellStatus::Empty, L"All the cells haven't been freed.");
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.GetAllocatedCellCount() == 0, L"All the cells haven't been freed.");
         CauldronAssert(ASSERT_ERROR, m_pRenderTarget != nullptr, L"A shadow map atlas texture is null.");
         delete m_pRenderTarget;
     }
 
     Cell ShadowMapAtlas::GetCell(int32_t index) const
     {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index %d doesn't exist yet.", index);
-        return m_Cells[index];
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.GetCellCount() > static_cast<uint32_t>(index), L"This cell index %d doesn't exist yet.", index);
+        return m_Allocator.GetCell(index);
     }
 
-    int32_t ShadowMapAtlas::FindBestCell(uint32_t size) const
+    int32_t ShadowMapAtlas::AllocateCell(uint32_t width, uint32_t height, int32_t freeRectIndex)
     {
-        int32_t foundCellIndex = -1;
-        FindBestCellRecursive(size, 0, foundCellIndex);
-        return foundCellIndex;
-    }
-
-    int32_t ShadowMapAtlas::AllocateCell(uint32_t size, int32_t index)
-    {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index %d doesn't exist yet.", index);
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Empty, L"The cell %d we are trying to allocate/subdivide isn't empty.", index);
-        while (m_Cells[index].size > size)
-        {
-            // subdivide
-            int32_t childrenBaseIndex = GetChildrenBaseIndex(index);
-            if (m_Cells.size() < childrenBaseIndex + 4)
-                m_Cells.resize(childrenBaseIndex + 4);
-
-            Cell currentCell = m_Cells[index];
-            uint32_t childCellSize = currentCell.size / 2;
-            // init the children
-            for (int32_t i = 0; i < 4; ++i)
-            {
-                Cell childCell;
-
-                childCell.size = childCellSize;
-                childCell.status = CellStatus::Empty;
-                childCell.rect = currentCell.rect;
-
-                switch (i)
-                {
-                case 0: // top left
-                    childCell.rect.Right = childCell.rect.Left + childCellSize;
-                    childCell.rect.Bottom = childCell.rect.Top + childCellSize;
-                    break;
-                case 1: // top right
-                    childCell.rect.Left = childCell.rect.Right - childCellSize;
-                    childCell.rect.Bottom = childCell.rect.Top + childCellSize;
-                    break;
-                case 2: // bottom right
-                    childCell.rect.Right = childCell.rect.Left + childCellSize;
-                    childCell.rect.Top = childCell.rect.Bottom - childCellSize;
-                    break;
-                case 3: // bottom right
-                    childCell.rect.Left = childCell.rect.Right - childCellSize;
-                    childCell.rect.Top = childCell.rect.Bottom - childCellSize;
-                    break;
-                }
-
-                m_Cells[childrenBaseIndex + i] = childCell;
-            }
-
-            // mark the cell non empty
-            m_Cells[index].status = CellStatus::Subdivided;
-
-            // select the first child cell
-            index = childrenBaseIndex;
-        }
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.GetFreeRectCount() > static_cast<uint32_t>(freeRectIndex), L"This free rect index %d doesn't exist.", freeRectIndex);
 
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index doesn't exist yet.");
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].size == size, L"This cell size doesn't match the expected one.");
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Empty, L"The cell %d we are trying to allocate isn't empty.", index);
-
-        m_Cells[index].status = CellStatus::Allocated;
-        return index;
+        const Rect& freeRect = m_Allocator.GetFreeRect(freeRectIndex);
+        CauldronAssert(ASSERT_CRITICAL, freeRect.Right - freeRect.Left >= width && freeRect.Bottom - freeRect.Top >= height, L"The free rect %d is too small for the requested cell.", freeRectIndex);
+        return m_Allocator.AllocateCell(width, height, freeRectIndex);
     }
 
     void ShadowMapAtlas::FreeCell(int32_t index)
     {
-        CauldronAssert(ASSERT_CRITICAL, m_Cells.size() > index, L"This cell index %d doesn't exist.", index);
-        CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Allocated, L"The cell %d we are trying to free isn't allocated.", index);
-
-        // free the cell
-        m_Cells[index].status = CellStatus::Empty;
-
-        // merge with the sibling cells
-        while (index != 0)
-        {
-            // move to parent
-            index = GetParentIndex(index);
-
-            CauldronAssert(ASSERT_CRITICAL, m_Cells[index].status == CellStatus::Subdivided, L"The cell %d isn't subdivided. We are trying to merge its children so it should be subdivided.", index);
-            bool allChildrenEmpty = true;
-            int32_t childrenBaseIndex = GetChildrenBaseIndex(index);
-            for (int32_t i = 0; i < 4; ++i)
-            {
-                allChildrenEmpty &= (m_Cells[childrenBaseIndex + i].status == CellStatus::Empty);
-            }
-
-            if (allChildrenEmpty)
-            {
-                // merge the cells
-                m_Cells[index].status = CellStatus::Empty;
-            }
-            else
-            {
-                // cannot merge because only child is still allocated or subdivided
-                break;
-            }
-        }
-    }
-
-    int32_t ShadowMapAtlas::GetChildrenBaseIndex(int32_t index)
-    {
-        return (index << 2) + 1;
-    }
-
-    int32_t ShadowMapAtlas::GetParentIndex(int32_t index)
-    {
-        return (index - 1) >> 2;
-    }
-
-    void ShadowMapAtlas::FindBestCellRecursive(size_t size, int32_t currentIndex, int32_t& foundCellIndex) const
-    {
-        if (currentIndex < m_Cells.size())
-        {
-            Cell cell = m_Cells[currentIndex];
-
-            if (cell.status == CellStatus::Empty) // we can only select this cell if it is completely empty
-            {
-                // only replace if this is a better cell
-                //   - size is bigger than the requested one
-                //   - size is smaller than the current best cell
-                if (cell.size >= size && (foundCellIndex < 0 || m_Cells[foundCellIndex].size > cell.size))
-                {
-                    foundCellIndex = currentIndex;
-                }
-            }
-            else if (cell.status == CellStatus::Subdivided) // explore children
-            {
-                int32_t childrenBaseIndex = GetChildrenBaseIndex(currentIndex);
-                for (int32_t i = 0; i < 4; ++i)
-                {
-                    FindBestCellRecursive(size, childrenBaseIndex + i, foundCellIndex);
-                }
-            }
-        }
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.GetCellCount() > static_cast<uint32_t>(index), L"This cell index %d doesn't exist.", index);
+        CauldronAssert(ASSERT_CRITICAL, m_Allocator.GetCell(index).status == CellStatus::Allocated, L"The cell %d we are trying to free isn't allocated.", index);
+        m_Allocator.FreeCell(index);
     }
 
     ShadowMapResourcePool::ShadowMapResourcePool()
@@ -219,35 +96,45 @@ namespace cauldron
 
     ShadowMapResourcePool::ShadowMapView ShadowMapResourcePool::GetNewShadowMap(ShadowMapResolution resolution)
     {
-        ShadowMapView view;
         const uint32_t cellSize = g_ShadowMapTextureSize / static_cast<uint32_t>(resolution);
+        return GetNewShadowMap(cellSize, cellSize);
+    }
+
+    ShadowMapResourcePool::ShadowMapView ShadowMapResourcePool::GetNewShadowMap(uint32_t width, uint32_t height)
+    {
+        CauldronAssert(ASSERT_CRITICAL, width > 0 && height > 0 && width <= g_ShadowMapTextureSize && height <= g_ShadowMapTextureSize,
+                       L"Requested shadow map size %ux%u doesn't fit in a shadow map atlas.", width, height);
+
+        ShadowMapView view;
 
         std::lock_guard<std::mutex> lock(m_CriticalSection);
         view.index = -1;
         view.cellIndex = -1;
+        uint64_t bestLeftoverArea = 0;
         for (int i = 0; i < m_ShadowMapAtlases.size(); ++i)
         {
-            int32_t cellIndex = m_ShadowMapAtlases[i]->FindBestCell(cellSize);
-            if (cellIndex >= 0) // a cell was found
+            uint64_t leftoverArea = 0;
+            int32_t freeRectIndex = m_ShadowMapAtlases[i]->FindBestFreeRect(width, height, &leftoverArea);
+            if (freeRectIndex >= 0) // a free rect was found
             {
-                uint32_t foundCellSize = m_ShadowMapAtlases[i]->GetCell(cellIndex).size;
-                // if this isn't better than a previously found cell, skip to the next atlas
-                if (view.index >= 0 && foundCellSize >= m_ShadowMapAtlases[view.index]->GetCell(view.cellIndex).size)
+                // if this isn't better than a previously found rect, skip to the next atlas
+                if (view.index >= 0 && leftoverArea >= bestLeftoverArea)
                     continue;
 
-                // this cell is better, save it
+                // this rect is better, save it
                 view.index = i;
-                view.cellIndex = cellIndex;
+                view.cellIndex = freeRectIndex;
+                bestLeftoverArea = leftoverArea;
 
                 // if this is the best we can find, early exit
-                if (foundCellSize == cellSize)
+                if (leftoverArea == 0)
                     break;
             }
         }
 
         if (view.index >= 0 && view.cellIndex >= 0)
         {
-            view.cellIndex = m_ShadowMapAtlases[view.index]->AllocateCell(cellSize, view.cellIndex);
+            view.cellIndex = m_ShadowMapAtlases[view.index]->AllocateCell(width, height, view.cellIndex);
             CauldronAssert(ASSERT_CRITICAL, view.cellIndex >= 0, L"Failed to allocate cell.");
             view.rect = m_ShadowMapAtlases[view.index]->GetCell(view.cellIndex).rect;
             return view;
@@ -273,7 +160,7 @@ namespace cauldron
         ShadowMapAtlas* pShadowMapAtlas = new ShadowMapAtlas(g_ShadowMapTextureSize, pRenderTarget);
 
         view.index = static_cast<int>(m_ShadowMapAtlases.size());
-        view.cellIndex = pShadowMapAtlas->AllocateCell(cellSize, 0);
+        view.cellIndex = pShadowMapAtlas->AllocateCell(width, height, 0);
         view.rect = pShadowMapAtlas->GetCell(view.cellIndex).rect;
 
         m_ShadowMapAtlases.push_back(pShadowMapAtlas);
@@ -294,6 +181,26 @@ namespace cauldron
         }
     }
 
+    Rect ShadowMapResourcePool::GetShadowMapRect(int index, int32_t cellIndex)
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        CauldronAssert(ASSERT_CRITICAL, index >= 0 && index < m_ShadowMapAtlases.size(), L"This shadow map index %d doesn't exist.", index);
+        return m_ShadowMapAtlases[index]->GetCell(cellIndex).rect;
+    }
+
+    uint32_t ShadowMapResourcePool::Defragment(uint32_t maxMoves)
+    {
+        std::lock_guard<std::mutex> lock(m_CriticalSection);
+        uint32_t moveCount = 0;
+        for (auto pShadowMapAtlas : m_ShadowMapAtlases)
+        {
+            if (moveCount == maxMoves)
+                break;
+            moveCount += pShadowMapAtlas->Defragment(maxMoves - moveCount);
+        }
+        return moveCount;
+    }
+
     Viewport ShadowMapResourcePool::GetViewport(Rect rect)
     {
         return {
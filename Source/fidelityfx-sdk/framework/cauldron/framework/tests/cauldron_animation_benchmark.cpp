@@ -0,0 +1,361 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+// Benchmark of batched animation sampling. Random keyframe pairs are evaluated through EvaluateKeyframes, four
+// components at a time, and through the per-component math AnimationComponent::UpdateLocalMatrix uses, for a range
+// of component counts. The two must agree before the timings are reported, for one thread and for the chunks
+// SampleAnimationChunks spreads over a worker pool. The key cursors are checked against a linear search first.
+
+#include "render/animationbatch.h"
+#include "render/animationinterpolants.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace cauldron;
+
+static constexpr uint32_t s_ComponentCounts[] = { 64, 1024, 16384 };
+static constexpr uint32_t s_SampledComponents = 1 << 22;   // components evaluated per timing, whatever the scene size
+static constexpr float    s_MaxError          = 1e-5f;
+static constexpr uint32_t s_WorkerCount       = 3;
+static constexpr uint32_t s_KeyCount          = 64;
+
+// Stand-in for the task manager's thread pool: persistent threads taking tasks from one queue
+class WorkerPool
+{
+public:
+    explicit WorkerPool(uint32_t threadCount)
+    {
+        for (uint32_t i = 0; i < threadCount; ++i)
+            m_Threads.emplace_back([this]() { Execute(); });
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            m_ShuttingDown = true;
+        }
+        m_QueueCondition.notify_all();
+        for (std::thread& thread : m_Threads)
+            thread.join();
+    }
+
+    void Launch(uint32_t taskCount, const std::function<void()>& task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            for (uint32_t i = 0; i < taskCount; ++i)
+                m_Tasks.push(task);
+        }
+        m_QueueCondition.notify_all();
+    }
+
+private:
+    void Execute()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_CriticalSection);
+                m_QueueCondition.wait(lock, [this] { return !m_Tasks.empty() || m_ShuttingDown; });
+                if (m_Tasks.empty())
+                    break;
+                task = m_Tasks.front();
+                m_Tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread>            m_Threads;
+    std::queue<std::function<void()>>   m_Tasks;
+    std::mutex                          m_CriticalSection;
+    std::condition_variable             m_QueueCondition;
+    bool                                m_ShuttingDown = false;
+};
+
+// The last key at or before the time, -1 before the first one
+static int32_t FindKeyLinear(const std::vector<float>& keyTimes, float time)
+{
+    int32_t key = -1;
+    while (key + 1 < static_cast<int32_t>(keyTimes.size()) && keyTimes[key + 1] <= time)
+        ++key;
+    return key;
+}
+
+// Follows a cursor through the given times, as a component does from frame to frame
+static bool CheckCursorPath(const char* pName, const AnimInterpolants& keys, const std::vector<float>& keyTimes, const std::vector<float>& times)
+{
+    int32_t cursor = 0;
+    for (float time : times)
+    {
+        cursor = FindClosestInterpolant(&keys, time, cursor);
+        const int32_t expected = FindKeyLinear(keyTimes, time);
+        if (cursor != expected)
+        {
+            printf("%s: key %d found for time %g, expected %d\n", pName, cursor, time, expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Forward playback steps the cursor, everything else has to land on the same key as a full search
+static bool CheckKeyCursors()
+{
+    std::mt19937                          rng(s_KeyCount);
+    std::uniform_real_distribution<float> spacing(0.01f, 0.1f);
+
+    std::vector<float> keyTimes(s_KeyCount);
+    keyTimes[0] = 0.5f;
+    for (uint32_t i = 1; i < s_KeyCount; ++i)
+        keyTimes[i] = keyTimes[i - 1] + spacing(rng);
+    const float duration = keyTimes.back();
+
+    AnimInterpolants keys;
+    keys.Count     = s_KeyCount;
+    keys.Stride    = sizeof(float);
+    keys.Dimension = 1;
+    keys.Data.resize(s_KeyCount * sizeof(float));
+    memcpy(keys.Data.data(), keyTimes.data(), keys.Data.size());
+
+    // forward at a few frame rates, from one step per several keys to several steps per key, past the last key
+    std::vector<float> forward;
+    for (float step : { 0.004f, 0.033f, 0.25f })
+        for (float time = 0.0f; time < duration + 0.5f; time += step)
+            forward.push_back(time);
+
+    // looping playback wrapping from the end back to the start, twice
+    std::vector<float> wrap;
+    for (float time = 0.0f; time < 2.0f * duration; time += 0.016f)
+        wrap.push_back(fmodf(time, duration));
+
+    // backward playback, then random jumps including exact key times and times outside the animation
+    std::vector<float> jumps;
+    for (float time = duration + 0.1f; time > 0.0f; time -= 0.02f)
+        jumps.push_back(time);
+    std::uniform_real_distribution<float> anyTime(-0.5f, duration + 0.5f);
+    std::uniform_int_distribution<uint32_t> anyKey(0, s_KeyCount - 1);
+    for (uint32_t i = 0; i < 1024; ++i)
+        jumps.push_back((i & 1) ? anyTime(rng) : keyTimes[anyKey(rng)]);
+
+    return CheckCursorPath("forward", keys, keyTimes, forward) &&
+           CheckCursorPath("wraparound", keys, keyTimes, wrap) &&
+           CheckCursorPath("backward and random jumps", keys, keyTimes, jumps);
+}
+
+// Every component is sampled once, in chunks starting on a 4 lane boundary, whatever the worker count
+static bool CheckSampleChunks(WorkerPool& pool)
+{
+    const AnimationTaskLauncher launchTasks = [&pool](uint32_t taskCount, const std::function<void()>& task) { pool.Launch(taskCount, task); };
+
+    for (uint32_t componentCount : { 1u, 127u, 128u, 129u, 1000u, 16384u })
+    {
+        for (uint32_t workerCount = 0; workerCount <= s_WorkerCount; ++workerCount)
+        {
+            std::unique_ptr<std::atomic_uint[]> sampleCounts(new std::atomic_uint[componentCount]);
+            for (uint32_t i = 0; i < componentCount; ++i)
+                sampleCounts[i] = 0;
+            std::atomic_bool unaligned = { false };
+
+            SampleAnimationChunks(componentCount, workerCount, launchTasks, [&](uint32_t begin, uint32_t end) {
+                if (begin & 3)
+                    unaligned = true;
+                for (uint32_t i = begin; i < end; ++i)
+                    ++sampleCounts[i];
+            });
+
+            bool sampledOnce = !unaligned;
+            for (uint32_t i = 0; i < componentCount; ++i)
+                sampledOnce = sampledOnce && sampleCounts[i] == 1;
+            if (!sampledOnce)
+            {
+                printf("%u components on %u workers: chunks are unaligned or overlap\n", componentCount, workerCount);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The per-component path: translation * slerp rotation * scale from the same keyframe pair
+static Mat4 EvaluateComponent(const AnimationKeyframeBatch& batch, uint32_t lane)
+{
+    float frac = batch.TranslationFrac[lane];
+    const Vec4 translation = ((1.0f - frac) * Vec4(batch.TranslationCurr[0][lane], batch.TranslationCurr[1][lane], batch.TranslationCurr[2][lane], 0)) +
+                             (frac * Vec4(batch.TranslationNext[0][lane], batch.TranslationNext[1][lane], batch.TranslationNext[2][lane], 0));
+
+    frac = batch.ScaleFrac[lane];
+    const Vec4 scale = ((1.0f - frac) * Vec4(batch.ScaleCurr[0][lane], batch.ScaleCurr[1][lane], batch.ScaleCurr[2][lane], 0)) +
+                       (frac * Vec4(batch.ScaleNext[0][lane], batch.ScaleNext[1][lane], batch.ScaleNext[2][lane], 0));
+
+    const Mat4 rotation = Mat4(math::slerp(batch.RotationFrac[lane],
+                                           math::Quat(batch.RotationCurr[0][lane], batch.RotationCurr[1][lane], batch.RotationCurr[2][lane], batch.RotationCurr[3][lane]),
+                                           math::Quat(batch.RotationNext[0][lane], batch.RotationNext[1][lane], batch.RotationNext[2][lane], batch.RotationNext[3][lane])),
+                               Vec3(0.0f, 0.0f, 0.0f));
+
+    return Mat4::translation(translation.getXYZ()) * rotation * Mat4::scale(scale.getXYZ());
+}
+
+// Random keys, with near-aligned and opposite hemisphere rotation pairs to cover both slerp special cases
+static void FillBatch(AnimationKeyframeBatch& batch, uint32_t componentCount)
+{
+    std::mt19937                          rng(componentCount);
+    std::uniform_real_distribution<float> signedUnit(-1.0f, 1.0f), unit(0.0f, 1.0f);
+
+    batch.Resize(componentCount);
+    for (uint32_t lane = 0; lane < componentCount; ++lane)
+    {
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            batch.TranslationCurr[i][lane] = signedUnit(rng) * 10.0f;
+            batch.TranslationNext[i][lane] = signedUnit(rng) * 10.0f;
+            batch.ScaleCurr[i][lane]       = 1.0f + signedUnit(rng) * 0.5f;
+            batch.ScaleNext[i][lane]       = 1.0f + signedUnit(rng) * 0.5f;
+        }
+
+        const math::Quat curr = normalize(math::Quat(signedUnit(rng), signedUnit(rng), signedUnit(rng), signedUnit(rng)));
+        math::Quat       next = (lane % 3 == 0) ? normalize(curr + math::Quat(0.01f * signedUnit(rng), 0.01f * signedUnit(rng), 0.0f, 0.0f))
+                                                : normalize(math::Quat(signedUnit(rng), signedUnit(rng), signedUnit(rng), signedUnit(rng)));
+        if (lane % 5 == 0)
+            next = -next;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            batch.RotationCurr[i][lane] = curr[i];
+            batch.RotationNext[i][lane] = next[i];
+        }
+
+        batch.TranslationFrac[lane] = unit(rng);
+        batch.RotationFrac[lane]    = unit(rng);
+        batch.ScaleFrac[lane]       = unit(rng);
+        batch.Animated[lane]        = 1;
+    }
+}
+
+// Evaluates the batch the way AnimationComponentMgr::SampleLocalTransformRange does
+static void EvaluateRange(const AnimationKeyframeBatch& batch, uint32_t begin, uint32_t end, Mat4* pTransforms)
+{
+    for (uint32_t lane = begin; lane < end; lane += 4)
+        EvaluateKeyframes(batch, lane, &pTransforms[lane]);
+}
+
+int main()
+{
+    if (!CheckKeyCursors())
+        return 1;
+
+    WorkerPool pool(s_WorkerCount);
+    if (!CheckSampleChunks(pool))
+        return 1;
+
+    const AnimationTaskLauncher launchTasks = [&pool](uint32_t taskCount, const std::function<void()>& task) { pool.Launch(taskCount, task); };
+    for (uint32_t componentCount : s_ComponentCounts)
+    {
+        AnimationKeyframeBatch batch;
+        FillBatch(batch, componentCount);
+        const uint32_t laneCount = static_cast<uint32_t>(batch.TranslationFrac.size());
+
+        float maxError = 0.0f;
+        Mat4  transforms[4];
+        for (uint32_t lane = 0; lane < laneCount; lane += 4)
+        {
+            EvaluateKeyframes(batch, lane, transforms);
+            for (uint32_t i = 0; i < 4 && lane + i < componentCount; ++i)
+            {
+                const Mat4 reference = EvaluateComponent(batch, lane + i);
+                for (uint32_t column = 0; column < 4; ++column)
+                    for (uint32_t row = 0; row < 4; ++row)
+                        maxError = std::max(maxError, std::fabs(transforms[i][column][row] - reference[column][row]));
+            }
+        }
+        if (maxError > s_MaxError)
+        {
+            printf("%u components: batched and per-component transforms differ by %g\n", componentCount, maxError);
+            return 1;
+        }
+
+        // the chunks sampled on the workers must give exactly the single-threaded transforms
+        std::vector<Mat4> serialTransforms(laneCount), chunkedTransforms(laneCount);
+        EvaluateRange(batch, 0, laneCount, serialTransforms.data());
+        SampleAnimationChunks(componentCount, s_WorkerCount, launchTasks, [&](uint32_t begin, uint32_t end) {
+            EvaluateRange(batch, begin, end, chunkedTransforms.data());
+        });
+        if (memcmp(serialTransforms.data(), chunkedTransforms.data(), componentCount * sizeof(Mat4)) != 0)
+        {
+            printf("%u components: transforms sampled in chunks differ from the single-threaded ones\n", componentCount);
+            return 1;
+        }
+
+        const uint32_t iterationCount = std::max(1u, s_SampledComponents / componentCount);
+        volatile float sink           = 0.0f;
+
+        const auto batchedStart = std::chrono::high_resolution_clock::now();
+        for (uint32_t iteration = 0; iteration < iterationCount; ++iteration)
+        {
+            for (uint32_t lane = 0; lane < laneCount; lane += 4)
+            {
+                EvaluateKeyframes(batch, lane, transforms);
+                sink = sink + transforms[0][3][0];
+            }
+        }
+        const auto componentStart = std::chrono::high_resolution_clock::now();
+        for (uint32_t iteration = 0; iteration < iterationCount; ++iteration)
+        {
+            for (uint32_t lane = 0; lane < componentCount; ++lane)
+                sink = sink + EvaluateComponent(batch, lane)[3][0];
+        }
+        const auto chunkedStart = std::chrono::high_resolution_clock::now();
+        for (uint32_t iteration = 0; iteration < iterationCount; ++iteration)
+        {
+            SampleAnimationChunks(componentCount, s_WorkerCount, launchTasks, [&](uint32_t begin, uint32_t end) {
+                EvaluateRange(batch, begin, end, chunkedTransforms.data());
+            });
+            sink = sink + chunkedTransforms[0][3][0];
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        const double sampleCount   = double(iterationCount) * componentCount;
+        const double batchedNs     = std::chrono::duration<double, std::nano>(componentStart - batchedStart).count() / sampleCount;
+        const double componentNs   = std::chrono::duration<double, std::nano>(chunkedStart - componentStart).count() / sampleCount;
+        const double chunkedNs     = std::chrono::duration<double, std::nano>(end - chunkedStart).count() / sampleCount;
+        printf("%6u components: batched %.1f ns, per-component %.1f ns per transform (%.2fx), %u workers %.1f ns (%.2fx), max error %g\n",
+               componentCount, batchedNs, componentNs, componentNs / batchedNs, s_WorkerCount, chunkedNs, componentNs / chunkedNs, maxError);
+    }
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// Benchmark of the shadow map atlas packing. Lights come and go while the shadow map area they request drifts
+// between 60% and 100% of an atlas, with either the power of two sizes ShadowMapResolution gives or arbitrary
+// rectangular sizes. Each trace is replayed with and without per-frame defragmentation, checking the atlas
+// layout as it goes, and the failed request rate, mean occupancy and allocation time are reported.
+
+#include "render/shadowmapatlasallocator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace cauldron;
+
+static constexpr uint32_t s_AtlasSize       = 2048;
+static constexpr uint32_t s_Granularity     = 16;       // every requested size and so every rect edge is a multiple of this
+static constexpr uint32_t s_FrameCount      = 20000;
+static constexpr uint32_t s_SeedCount       = 3;
+static constexpr uint32_t s_CheckInterval   = 97;       // frames between two layout checks
+static constexpr uint32_t s_DefragmentMoves = 4;
+
+struct TraceOp
+{
+    enum class Type
+    {
+        Allocate,
+        Free,
+        EndFrame,
+    };
+
+    Type     type;
+    uint32_t light = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+static std::vector<TraceOp> MakeTrace(uint32_t seed, bool rectangular)
+{
+    std::mt19937          rng(seed);
+    std::vector<TraceOp>  trace;
+    std::vector<uint32_t> liveLights;
+    std::vector<uint64_t> lightAreas;
+    uint64_t              liveArea   = 0;
+    double                targetArea = 0.8;
+    for (uint32_t frame = 0; frame < s_FrameCount; ++frame)
+    {
+        if (frame % 500 == 0)
+            targetArea = 0.6 + 0.4 * (rng() % 1000) / 1000.0;
+
+        const uint32_t opCount = rng() % 3;
+        for (uint32_t op = 0; op < opCount; ++op)
+        {
+            if (!liveLights.empty() && (liveArea > targetArea * s_AtlasSize * s_AtlasSize || rng() % 100 < 15))
+            {
+                const size_t index = rng() % liveLights.size();
+                trace.push_back({ TraceOp::Type::Free, liveLights[index] });
+                liveArea -= lightAreas[liveLights[index]];
+                liveLights[index] = liveLights.back();
+                liveLights.pop_back();
+            }
+            else
+            {
+                uint32_t width = 256u << (rng() % 3), height = width;
+                if (rectangular)
+                {
+                    width  = s_Granularity * (8 + rng() % 57);
+                    height = s_Granularity * (8 + rng() % 57);
+                }
+                const uint32_t light = static_cast<uint32_t>(lightAreas.size());
+                trace.push_back({ TraceOp::Type::Allocate, light, width, height });
+                lightAreas.push_back(static_cast<uint64_t>(width) * height);
+                liveArea += lightAreas.back();
+                liveLights.push_back(light);
+            }
+        }
+        trace.push_back({ TraceOp::Type::EndFrame });
+    }
+    return trace;
+}
+
+// Allocated cells must be aligned, in bounds and disjoint, free rects must not overlap them and together they
+// must cover the whole atlas
+static bool CheckLayout(const ShadowMapAtlasAllocator& atlas)
+{
+    constexpr uint32_t  blockCount = s_AtlasSize / s_Granularity;
+    std::vector<uint8_t> blocks(blockCount * blockCount, 0);
+
+    for (uint32_t i = 0; i < atlas.GetCellCount(); ++i)
+    {
+        const Cell& cell = atlas.GetCell(i);
+        if (cell.status != CellStatus::Allocated)
+            continue;
+
+        const Rect& rect = cell.rect;
+        if (rect.Left % s_Granularity || rect.Top % s_Granularity || rect.Right % s_Granularity || rect.Bottom % s_Granularity ||
+            rect.Right > s_AtlasSize || rect.Bottom > s_AtlasSize)
+        {
+            printf("cell %u is unaligned or out of the atlas\n", i);
+            return false;
+        }
+        for (uint32_t y = rect.Top / s_Granularity; y < rect.Bottom / s_Granularity; ++y)
+        {
+            for (uint32_t x = rect.Left / s_Granularity; x < rect.Right / s_Granularity; ++x)
+            {
+                if (blocks[y * blockCount + x])
+                {
+                    printf("cell %u overlaps another cell\n", i);
+                    return false;
+                }
+                blocks[y * blockCount + x] = 1;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < atlas.GetFreeRectCount(); ++i)
+    {
+        const Rect& rect = atlas.GetFreeRect(i);
+        for (uint32_t y = rect.Top / s_Granularity; y < rect.Bottom / s_Granularity; ++y)
+        {
+            for (uint32_t x = rect.Left / s_Granularity; x < rect.Right / s_Granularity; ++x)
+            {
+                if (blocks[y * blockCount + x] == 1)
+                {
+                    printf("free rect %u overlaps an allocated cell\n", i);
+                    return false;
+                }
+                blocks[y * blockCount + x] = 2;
+            }
+        }
+    }
+
+    for (uint8_t block : blocks)
+    {
+        if (!block)
+        {
+            printf("part of the atlas is neither allocated nor free\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool Replay(const std::vector<TraceOp>& trace, uint32_t defragmentMoves)
+{
+    ShadowMapAtlasAllocator atlas(s_AtlasSize);
+    std::vector<int32_t>    lightCells;
+    std::vector<uint64_t>   lightAreas;
+    uint64_t                liveArea = 0, requestCount = 0, failCount = 0, moveCount = 0;
+    uint32_t                frameCount = 0, liveCellCount = 0;
+    double                  occupancy = 0.0, allocUs = 0.0;
+    for (const TraceOp& op : trace)
+    {
+        if (op.type == TraceOp::Type::EndFrame)
+        {
+            moveCount += atlas.Defragment(defragmentMoves);
+            occupancy += static_cast<double>(liveArea) / (static_cast<double>(s_AtlasSize) * s_AtlasSize);
+            if (++frameCount % s_CheckInterval == 0 && !CheckLayout(atlas))
+                return false;
+        }
+        else if (op.type == TraceOp::Type::Allocate)
+        {
+            const auto start = std::chrono::high_resolution_clock::now();
+            const int32_t freeRectIndex = atlas.FindBestFreeRect(op.width, op.height);
+            const int32_t cellIndex     = freeRectIndex >= 0 ? atlas.AllocateCell(op.width, op.height, freeRectIndex) : -1;
+            allocUs += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+
+            lightCells.resize(op.light + 1, -1);
+            lightAreas.resize(op.light + 1, 0);
+            lightCells[op.light] = cellIndex;
+            ++requestCount;
+            if (cellIndex < 0)
+            {
+                ++failCount;
+                continue;
+            }
+
+            const Rect& rect = atlas.GetCell(cellIndex).rect;
+            if (rect.Right - rect.Left != op.width || rect.Bottom - rect.Top != op.height)
+            {
+                printf("cell %d doesn't have the requested size %ux%u\n", cellIndex, op.width, op.height);
+                return false;
+            }
+            lightAreas[op.light] = static_cast<uint64_t>(op.width) * op.height;
+            liveArea += lightAreas[op.light];
+            ++liveCellCount;
+        }
+        else if (lightCells[op.light] >= 0)
+        {
+            atlas.FreeCell(lightCells[op.light]);
+            liveArea -= lightAreas[op.light];
+            lightCells[op.light] = -1;
+            --liveCellCount;
+        }
+    }
+
+    if (atlas.GetAllocatedCellCount() != liveCellCount)
+    {
+        printf("the atlas holds %u cells for %u live lights\n", atlas.GetAllocatedCellCount(), liveCellCount);
+        return false;
+    }
+
+    printf("  defragment(%u): fail rate %.3f, mean occupancy %.3f, alloc %.2f us, %llu cells moved\n", defragmentMoves,
+           static_cast<double>(failCount) / requestCount, occupancy / frameCount, allocUs / requestCount, static_cast<unsigned long long>(moveCount));
+    return true;
+}
+
+int main()
+{
+    for (bool rectangular : { false, true })
+    {
+        for (uint32_t seed = 1; seed <= s_SeedCount; ++seed)
+        {
+            const std::vector<TraceOp> trace = MakeTrace(seed, rectangular);
+            printf("%s sizes, seed %u\n", rectangular ? "rectangular" : "power of two", seed);
+            if (!Replay(trace, 0) || !Replay(trace, s_DefragmentMoves))
+                return 1;
+        }
+    }
+
+    return 0;
+}
@@ -308,6 +308,30 @@ void RasterShadowRenderModule::Execute(double deltaTime, CommandList* pCmdList)
     UpdateUIState(hasDirectionalLight);
 }
 
+void RasterShadowRenderModule::OnPreFrame()
+{
+    std::lock_guard<std::mutex> lock(m_CriticalSection);
+
+    ShadowMapResourcePool* pShadowMapResourcePool = GetFramework()->GetShadowMapResourcePool();
+    if (pShadowMapResourcePool->Defragment(s_MaxShadowMapMovesPerFrame) == 0)
+        return;
+
+    // Refresh the rects of every shadow map, this runs before the scene uploads light information for the frame
+    for (auto& shadowMapInfo : m_ShadowMapInfos)
+    {
+        for (auto pConstLightComponent : shadowMapInfo.LightComponents)
+        {
+            LightComponent*     pLightComponent = const_cast<LightComponent*>(pConstLightComponent);
+            LightComponentData& lightData       = pLightComponent->GetData();
+            for (int i = 0; i < pLightComponent->GetShadowMapCount(); ++i)
+            {
+                if (lightData.ShadowMapIndex[i] == shadowMapInfo.ShadowMapIndex)
+                    lightData.ShadowMapRect[i] = pShadowMapResourcePool->GetShadowMapRect(lightData.ShadowMapIndex[i], lightData.ShadowMapCellIndex[i]);
+            }
+        }
+    }
+}
+
 void RasterShadowRenderModule::OnNewContentLoaded(ContentBlock* pContentBlock)
 {
     MeshComponentMgr* pMeshComponentManager = MeshComponentMgr::Get();
@@ -77,6 +77,11 @@ public:
     */
     void Execute(double deltaTime, cauldron::CommandList* pCmdList) override;
 
+    /**
+    * @brief   Compacts the shadow map atlases a few shadow maps at a time and updates the rects of the lights that moved.
+    */
+    void OnPreFrame() override;
+
     /**
     * @brief   Callback invoked when new content is loaded so we can create additional pipelines and resources if needed.
     */
@@ -109,6 +114,9 @@ private:
     static constexpr uint32_t s_MaxTextureCount = 200;
     static constexpr uint32_t s_MaxSamplerCount = 20;
 
+    // Shadow maps are re-rendered every frame, so relocating one only costs updating its rect
+    static constexpr uint32_t s_MaxShadowMapMovesPerFrame = 4;
+
     cauldron::RootSignature* m_pRootSignature = nullptr;
     cauldron::ParameterSet*  m_pParameterSet  = nullptr;
 
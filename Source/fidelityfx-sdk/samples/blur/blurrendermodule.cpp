@@ -967,6 +967,8 @@ void BlurRenderModule::ExecuteBlurEffect(
 
     desc.output = SDKWrapper::ffxGetResource(inputOutputPair.second->GetResource(), L"BLUR_Output", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
+    desc.frameIndex = GetFramework()->GetFrameID();
+
     ffxBlurContextDispatch(&blurContext, &desc);
 
     // FidelityFX contexts modify the set resource view heaps, so set the cauldron one back
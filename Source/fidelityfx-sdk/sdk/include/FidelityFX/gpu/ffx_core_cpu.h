@@ -147,6 +147,19 @@ FFX_STATIC FfxFloat32 ffxFract(FfxFloat32 x)
     return x - FfxFloat32(floor(x));
 }
 
+/// Rounds to the nearest integer. In case the fractional part is 0.5, it will round to the nearest even integer.
+///
+/// @param [in] x               The value to be rounded.
+///
+/// @returns
+/// The nearest integer from <c><i>x</i></c>. The nearest even integer from <c><i>x</i></c> if equidistant from 2 integer.
+///
+/// @ingroup CPUCore
+FFX_STATIC FfxFloat32 ffxRound(FfxFloat32 x)
+{
+    return FfxFloat32(nearbyint(x));
+}
+
 /// Compute the reciprocal square root of a value.
 ///
 /// @param [in] x               The value to compute the reciprocal for.
@@ -20,33 +20,24 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
-#define SSSR_BIND_SRV_SOBOL_BUFFER             0
-#define SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER   1
 
-#define SSSR_BIND_UAV_BLUE_NOISE_TEXTURE    0
+#ifndef FFX_SSSR_BLUE_NOISE_H
+#define FFX_SSSR_BLUE_NOISE_H
 
-#define SSSR_BIND_CB_SSSR   0
+// Blue Noise Sampler by Eric Heitz with one sample per pixel. The Sobol value xor'd with the
+// scrambling tile entry of a pixel does not depend on the frame, so the blue noise texture holds
+// those values for the first two dimensions and the frame only adds its golden ratio offset here.
+// This header is also compiled on the CPU, where ffxSssrGenerateBlueNoiseCpu uses it.
 
-#include "sssr/ffx_sssr_callbacks_hlsl.h"
-#include "sssr/ffx_sssr_prepare_blue_noise_texture.h"
+#define FFX_SSSR_BLUE_NOISE_GOLDEN_RATIO 1.61803398875f
 
-#ifndef FFX_SSSR_THREAD_GROUP_WIDTH
-#define FFX_SSSR_THREAD_GROUP_WIDTH 8
-#endif // #ifndef FFX_SSSR_THREAD_GROUP_WIDTH
-#ifndef FFX_SSSR_THREAD_GROUP_HEIGHT
-#define FFX_SSSR_THREAD_GROUP_HEIGHT 8
-#endif // FFX_SSSR_THREAD_GROUP_HEIGHT
-#ifndef FFX_SSSR_THREAD_GROUP_DEPTH
-#define FFX_SSSR_THREAD_GROUP_DEPTH 1
-#endif // #ifndef FFX_SSSR_THREAD_GROUP_DEPTH
-#ifndef FFX_SSSR_NUM_THREADS
-#define FFX_SSSR_NUM_THREADS [numthreads(FFX_SSSR_THREAD_GROUP_WIDTH, FFX_SSSR_THREAD_GROUP_HEIGHT, FFX_SSSR_THREAD_GROUP_DEPTH)]
-#endif // #ifndef FFX_SSSR_NUM_THREADS
-
-FFX_PREFER_WAVE64
-FFX_SSSR_NUM_THREADS
-FFX_SSSR_EMBED_ROOTSIG_CONTENT
-void CS(FfxInt32x2 DispatchThreadId : SV_DispatchThreadID )
+// Returns the sample of the frame quantized to UNORM8, the values the prepare blue noise pass
+// used to store to its RG8 texture.
+FFX_STATIC FfxUInt32 FFX_SSSR_BlueNoiseSampleUnorm8(FfxUInt32 value, FfxUInt32 frameIndex)
 {
-    PrepareBlueNoiseTexture(DispatchThreadId);
+    FfxFloat32 sample = (FfxFloat32(value) + 0.5f) / 256.0f;
+    FfxFloat32 u      = ffxFract(sample + FfxFloat32(frameIndex & 0xFFu) * FFX_SSSR_BLUE_NOISE_GOLDEN_RATIO);
+    return FfxUInt32(ffxRound(ffxSaturate(u) * 255.0f));
 }
+
+#endif // #ifndef FFX_SSSR_BLUE_NOISE_H
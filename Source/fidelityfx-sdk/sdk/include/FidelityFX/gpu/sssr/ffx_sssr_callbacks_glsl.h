@@ -24,6 +24,7 @@
 
 #if defined(FFX_GPU)
 #include "ffx_core.h"
+#include "ffx_sssr_blue_noise.h"
 
 #ifndef FFX_PREFER_WAVE64
 #define FFX_PREFER_WAVE64
@@ -300,14 +301,8 @@ layout (set = 0, binding = 1001) uniform sampler s_LinearSampler;
 #if defined SSSR_BIND_SRV_EXTRACTED_ROUGHNESS
     layout (set = 0, binding = SSSR_BIND_SRV_EXTRACTED_ROUGHNESS)           uniform texture2D r_extracted_roughness;
 #endif
-#if defined SSSR_BIND_SRV_SOBOL_BUFFER
-    layout (set = 0, binding = SSSR_BIND_SRV_SOBOL_BUFFER)                  uniform utexture2D r_sobol_buffer;
-#endif
-#if defined SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER
-    layout (set = 0, binding = SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER)        uniform utexture2D r_scrambling_tile_buffer;
-#endif
 #if defined SSSR_BIND_SRV_BLUE_NOISE_TEXTURE
-    layout (set = 0, binding = SSSR_BIND_SRV_BLUE_NOISE_TEXTURE)            uniform texture2D r_blue_noise_texture;
+    layout (set = 0, binding = SSSR_BIND_SRV_BLUE_NOISE_TEXTURE)            uniform utexture2D r_blue_noise_texture;
 #endif
 #if defined SSSR_BIND_SRV_INPUT_BRDF_TEXTURE
     layout (set = 0, binding = SSSR_BIND_SRV_INPUT_BRDF_TEXTURE)            uniform texture2D r_input_brdf_texture;
@@ -350,9 +345,6 @@ layout (set = 0, binding = 1001) uniform sampler s_LinearSampler;
 #if defined SSSR_BIND_UAV_EXTRACTED_ROUGHNESS
         layout (set = 0, binding = SSSR_BIND_UAV_EXTRACTED_ROUGHNESS, r32f) uniform image2D rw_extracted_roughness;
 #endif
-#if defined SSSR_BIND_UAV_BLUE_NOISE_TEXTURE
-        layout (set = 0, binding = SSSR_BIND_UAV_BLUE_NOISE_TEXTURE, rg32f) uniform image2D rw_blue_noise_texture;
-#endif
 #if defined SSSR_BIND_UAV_DEPTH_HIERARCHY
         layout (set = 0, binding = SSSR_BIND_UAV_DEPTH_HIERARCHY, r32f)     uniform image2D rw_depth_hierarchy[13];
 #endif
@@ -408,7 +400,9 @@ FfxFloat32 FFX_SSSR_LoadDepth(FfxInt32x2 pixel_coordinate, FfxInt32 mip)
 #if defined(SSSR_BIND_SRV_BLUE_NOISE_TEXTURE)
 FfxFloat32x2 FFX_SSSR_SampleRandomVector2D(FfxUInt32x2 pixel)
 {
-    return texelFetch(r_blue_noise_texture, FfxInt32x2(pixel.xy % 128), 0).xy;
+    // Read back as the UNORM8 texture the prepare blue noise pass used to write.
+    FfxUInt32x2 value = texelFetch(r_blue_noise_texture, FfxInt32x2(pixel.xy % FFX_SSSR_BLUE_NOISE_TILE_SIZE), 0).xy;
+    return FfxFloat32x2(FFX_SSSR_BlueNoiseSampleUnorm8(value.x, FrameIndex()), FFX_SSSR_BlueNoiseSampleUnorm8(value.y, FrameIndex())) / 255.0f;
 }
 #endif // #if defined(SSSR_BIND_SRV_BLUE_NOISE_TEXTURE)
 
@@ -510,13 +504,6 @@ FfxUInt32 GetRaylist(FfxUInt32 ray_index)
 }
 #endif // #if defined (SSSR_BIND_UAV_RAY_LIST)
 
-#if defined (SSSR_BIND_UAV_BLUE_NOISE_TEXTURE)
-void FFX_SSSR_StoreBlueNoiseSample(FfxUInt32x2 coordinate, FfxFloat32x2 blue_noise_sample)
-{ 
-    imageStore(rw_blue_noise_texture, FfxInt32x2(coordinate), FfxFloat32x4(blue_noise_sample, 0.0f, 0.0f));
-}
-#endif // #if defined (SSSR_BIND_UAV_BLUE_NOISE_TEXTURE)
-
 #if defined (SSSR_BIND_SRV_VARIANCE)
 FfxFloat32 FFX_SSSR_LoadVarianceHistory(FfxInt32x3 coordinate)
 {
@@ -531,20 +518,6 @@ void FFX_SSSR_StoreRadiance(FfxUInt32x2 coordinate, FfxFloat32x4 radiance)
 }
 #endif // #if defined (SSSR_BIND_UAV_RADIANCE)
 
-#if defined (SSSR_BIND_SRV_SOBOL_BUFFER)
-FfxUInt32 FFX_SSSR_GetSobolSample(FfxUInt32x3 coordinate)
-{
-    return FfxUInt32(texelFetch(r_sobol_buffer, FfxInt32x2(coordinate.xy), FfxInt32(coordinate.z)).r);
-}
-#endif // #if defined (SSSR_BIND_SRV_SOBOL_BUFFER)
-
-#if defined (SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER)
-FfxUInt32 FFX_SSSR_GetScramblingTile(FfxUInt32x3 coordinate)
-{ 
-    return FfxUInt32(texelFetch(r_scrambling_tile_buffer, FfxInt32x2(coordinate.xy), FfxInt32(coordinate.z)).r);
-}
-#endif // #if defined (SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER)
-
 #if defined (SSSR_BIND_UAV_INTERSECTION_PASS_INDIRECT_ARGS)
 void FFX_SSSR_WriteIntersectIndirectArgs(FfxUInt32 index, FfxUInt32 data)
 {
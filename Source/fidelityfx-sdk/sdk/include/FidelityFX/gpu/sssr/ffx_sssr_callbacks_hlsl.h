@@ -31,6 +31,7 @@
 #ifdef __hlsl_dx_compiler
 #pragma dxc diagnostic pop
 #endif //__hlsl_dx_compiler
+#include "ffx_sssr_blue_noise.h"
 
 #ifndef FFX_PREFER_WAVE64
 #define FFX_PREFER_WAVE64
@@ -273,14 +274,8 @@ FfxBoolean TemporalVarianceGuidedTracingEnabled()
     #if defined SSSR_BIND_SRV_EXTRACTED_ROUGHNESS
         Texture2D<FfxFloat32>       r_extracted_roughness           : FFX_SSSR_DECLARE_SRV(SSSR_BIND_SRV_EXTRACTED_ROUGHNESS);
     #endif
-    #if defined SSSR_BIND_SRV_SOBOL_BUFFER
-        Texture2D<FfxUInt32>        r_sobol_buffer                  : FFX_SSSR_DECLARE_SRV(SSSR_BIND_SRV_SOBOL_BUFFER);
-    #endif
-    #if defined SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER
-        Texture2D<FfxUInt32>        r_scrambling_tile_buffer        : FFX_SSSR_DECLARE_SRV(SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER);
-    #endif
     #if defined SSSR_BIND_SRV_BLUE_NOISE_TEXTURE
-        Texture2D<FfxFloat32x2>     r_blue_noise_texture            : FFX_SSSR_DECLARE_SRV(SSSR_BIND_SRV_BLUE_NOISE_TEXTURE);
+        Texture2D<FfxUInt32x2>      r_blue_noise_texture            : FFX_SSSR_DECLARE_SRV(SSSR_BIND_SRV_BLUE_NOISE_TEXTURE);
     #endif
     #if defined SSSR_BIND_SRV_INPUT_BRDF_TEXTURE
         Texture2D<FfxFloat32x4>     r_input_brdf_texture            : FFX_SSSR_DECLARE_SRV(SSSR_BIND_SRV_INPUT_BRDF_TEXTURE);
@@ -311,9 +306,6 @@ FfxBoolean TemporalVarianceGuidedTracingEnabled()
     #if defined SSSR_BIND_UAV_EXTRACTED_ROUGHNESS
             RWTexture2D<FfxFloat32>                         rw_extracted_roughness              : FFX_SSSR_DECLARE_UAV(SSSR_BIND_UAV_EXTRACTED_ROUGHNESS);
     #endif
-    #if defined SSSR_BIND_UAV_BLUE_NOISE_TEXTURE
-            RWTexture2D<FfxFloat32x2>                       rw_blue_noise_texture               : FFX_SSSR_DECLARE_UAV(SSSR_BIND_UAV_BLUE_NOISE_TEXTURE);
-    #endif
     #if defined SSSR_BIND_UAV_DEPTH_HIERARCHY
             RWTexture2D<FfxFloat32>                         rw_depth_hierarchy[13]        : FFX_SSSR_DECLARE_UAV(SSSR_BIND_UAV_DEPTH_HIERARCHY);
     #endif
@@ -365,7 +357,9 @@ FfxFloat32 FFX_SSSR_LoadDepth(FfxInt32x2 pixel_coordinate, FfxInt32 mip)
 #if defined(SSSR_BIND_SRV_BLUE_NOISE_TEXTURE)
 FfxFloat32x2 FFX_SSSR_SampleRandomVector2D(FfxUInt32x2 pixel)
 {
-    return r_blue_noise_texture.Load(FfxInt32x3(pixel.xy % 128, 0));
+    // Read back as the UNORM8 texture the prepare blue noise pass used to write.
+    FfxUInt32x2 value = r_blue_noise_texture.Load(FfxInt32x3(pixel.xy % FFX_SSSR_BLUE_NOISE_TILE_SIZE, 0));
+    return FfxFloat32x2(FFX_SSSR_BlueNoiseSampleUnorm8(value.x, FrameIndex()), FFX_SSSR_BlueNoiseSampleUnorm8(value.y, FrameIndex())) / 255.0f;
 }
 #endif // #if defined(SSSR_BIND_SRV_BLUE_NOISE_TEXTURE)
 
@@ -468,13 +462,6 @@ FfxUInt32 GetRaylist(FfxUInt32 ray_index)
 }
 #endif // #if defined (SSSR_BIND_UAV_RAY_LIST)
 
-#if defined (SSSR_BIND_UAV_BLUE_NOISE_TEXTURE)
-void FFX_SSSR_StoreBlueNoiseSample(FfxUInt32x2 coordinate, FfxFloat32x2 blue_noise_sample)
-{
-    rw_blue_noise_texture[coordinate] = blue_noise_sample;
-}
-#endif // #if defined (SSSR_BIND_UAV_BLUE_NOISE_TEXTURE)
-
 #if defined (SSSR_BIND_SRV_VARIANCE)
 FfxFloat32 FFX_SSSR_LoadVarianceHistory(FfxInt32x3 coordinate)
 {
@@ -489,20 +476,6 @@ void FFX_SSSR_StoreRadiance(FfxUInt32x2 coordinate, FfxFloat32x4 radiance)
 }
 #endif // #if defined (SSSR_BIND_UAV_RADIANCE)
 
-#if defined (SSSR_BIND_SRV_SOBOL_BUFFER)
-FfxUInt32 FFX_SSSR_GetSobolSample(FfxUInt32x3 coordinate)
-{
-    return r_sobol_buffer.Load(coordinate);
-}
-#endif // #if defined (SSSR_BIND_SRV_SOBOL_BUFFER)
-
-#if defined (SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER)
-FfxUInt32 FFX_SSSR_GetScramblingTile(FfxUInt32x3 coordinate)
-{ 
-    return r_scrambling_tile_buffer.Load(coordinate);
-}
-#endif // #if defined (SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER)
-
 #if defined (SSSR_BIND_UAV_INTERSECTION_PASS_INDIRECT_ARGS)
 void FFX_SSSR_WriteIntersectIndirectArgs(FfxUInt32 index, FfxUInt32 data)
 {
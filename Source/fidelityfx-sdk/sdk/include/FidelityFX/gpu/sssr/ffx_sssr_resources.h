@@ -46,16 +46,16 @@
 #define FFX_SSSR_RESOURCE_IDENTIFIER_RADIANCE_1                         19
 #define FFX_SSSR_RESOURCE_IDENTIFIER_VARIANCE_0                         20
 #define FFX_SSSR_RESOURCE_IDENTIFIER_VARIANCE_1                         21
-#define FFX_SSSR_RESOURCE_IDENTIFIER_SOBOL_BUFFER                       22
-#define FFX_SSSR_RESOURCE_IDENTIFIER_RANKING_TILE_BUFFER                23
-#define FFX_SSSR_RESOURCE_IDENTIFIER_SCRAMBLING_TILE_BUFFER             24
-#define FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE                 25
-#define FFX_SSSR_RESOURCE_IDENTIFIER_SPD_GLOBAL_ATOMIC                  26
-#define FFX_SSSR_RESOURCE_IDENTIFIER_COUNT                              27
+#define FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE                 22
+#define FFX_SSSR_RESOURCE_IDENTIFIER_SPD_GLOBAL_ATOMIC                  23
+#define FFX_SSSR_RESOURCE_IDENTIFIER_COUNT                              24
 
 #define FFX_SSSR_CONSTANTBUFFER_IDENTIFIER_SSSR                         0
 #define FFX_SSSR_CONSTANTBUFFER_IDENTIFIER_COUNT                        1
 
+// The blue noise texture is one 128x128 tile, the samples repeat every 256 frames.
+#define FFX_SSSR_BLUE_NOISE_TILE_SIZE                                   128
+
 #endif // #if defined(FFX_CPU) || defined(FFX_GPU)
 
 #endif //!defined( FFX_SSSR_RESOURCES_H )
@@ -82,6 +82,169 @@ FFX_API FfxErrorCode ffxGetInterfaceDX12(
     size_t scratchBufferSize, 
     size_t maxContexts);
 
+/// Counters reported by <c><i>ffxGetPipelineCacheStatisticsDX12</i></c>.
+///
+/// Root signatures are shared by all pipelines of the backend whose serialized root signature is identical,
+/// and pipeline states by all pipelines with the same root signature and shader bytecode. Effect contexts
+/// created through separate backend interfaces do not share them; they only avoid compiling the same
+/// pipeline states again when their pipeline libraries are created from the same data.
+///
+/// @ingroup DX12Backend
+typedef struct FfxPipelineCacheStatisticsDX12
+{
+    uint32_t rootSignatureCount;                ///< The number of distinct root signatures currently alive.
+    uint32_t pipelineStateCount;                ///< The number of distinct pipeline states currently alive.
+    uint64_t rootSignatureHitCount;             ///< The number of pipelines that reused a root signature created for another pipeline.
+    uint64_t rootSignatureCreateCount;          ///< The number of root signatures created.
+    uint64_t pipelineStateHitCount;             ///< The number of pipelines that reused a pipeline state created for another pipeline.
+    uint64_t libraryHitCount;                   ///< The number of pipeline states loaded from the pipeline library.
+    uint64_t pipelineStateCreateCount;          ///< The number of pipeline states that had to be compiled.
+    bool     initialDataRejected;               ///< True if initial data was given but was corrupt or written for another adapter or driver, and was discarded.
+} FfxPipelineCacheStatisticsDX12;
+
+/// Create a <c><i>ID3D12PipelineLibrary</i></c> used by the backend for all pipeline states it creates from then on.
+///
+/// Call after <c><i>ffxGetInterfaceDX12</i></c>. The library outlives the effect contexts, so contexts
+/// that are destroyed and created again load the pipeline states compiled for the previous ones.
+/// Initial data is expected to come from <c><i>ffxGetPipelineLibraryDataDX12</i></c>; the backend keeps
+/// its own copy. Data that fails its checksum, or that the runtime rejects because it was written for
+/// another adapter or driver, is discarded and the library starts out empty.
+/// The library is kept when the scratch buffer is passed to <c><i>ffxGetInterfaceDX12</i></c> again for the
+/// same device, and released when it is passed for another device. The library holds a reference to the
+/// device until it is released.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceDX12</i></c>.
+/// @param [in] pInitialData                (optional) Data saved by a previous run.
+/// @param [in] initialDataSize             The size (in bytes) of <c><i>pInitialData</i></c>, 0 if there is none.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> or <c><i>pInitialData</i></c> pointer was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              The backend already has a pipeline library.
+/// @retval
+/// FFX_ERROR_OUT_OF_MEMORY                 The initial data could not be copied.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR             The device does not support pipeline libraries, or the library could not be created.
+///
+/// @ingroup DX12Backend
+FFX_API FfxErrorCode ffxCreatePipelineLibraryDX12(FfxInterface* backendInterface, const void* pInitialData, size_t initialDataSize);
+
+/// Serialize the backend pipeline library so it can be passed to <c><i>ffxCreatePipelineLibraryDX12</i></c> next run.
+///
+/// Call with <c><i>pData</i></c> set to <c><i>NULL</i></c> to query the size to allocate.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> with a pipeline library.
+/// @param [out] pData                      The buffer to write to, or <c><i>NULL</i></c>.
+/// @param [inout] pDataSize                The size (in bytes) of <c><i>pData</i></c>, receives the size written or required.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              The backend has no pipeline library.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY           <c><i>pData</i></c> is too small.
+///
+/// @ingroup DX12Backend
+FFX_API FfxErrorCode ffxGetPipelineLibraryDataDX12(FfxInterface* backendInterface, void* pData, size_t* pDataSize);
+
+/// Query the root signature and pipeline state reuse counters of the backend.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxPipelineCacheStatisticsDX12</i></c> to fill.
+///
+/// @ingroup DX12Backend
+FFX_API FfxErrorCode ffxGetPipelineCacheStatisticsDX12(FfxInterface* backendInterface, FfxPipelineCacheStatisticsDX12* pStatistics);
+
+/// Destroy the backend pipeline library. Pipeline states loaded from it stay valid.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+///
+/// @ingroup DX12Backend
+FFX_API FfxErrorCode ffxDestroyPipelineLibraryDX12(FfxInterface* backendInterface);
+
+/// Counters reported by <c><i>ffxGetDescriptorRingStatisticsDX12</i></c>.
+///
+/// The UAV and SRV tables of each compute dispatch are written to a shader visible descriptor ring. Each
+/// effect context writes a frame to its own part of the ring, which is written again only
+/// <c><i>FFX_MAX_QUEUED_FRAMES</i></c> frames later, a frame ending with <c><i>fpUnregisterResources</i></c>.
+/// A table with the same contents as the previous table of its type in the same frame is bound again
+/// instead of being written, unless resources were created or registered in between.
+///
+/// @ingroup DX12Backend
+typedef struct FfxDescriptorRingStatisticsDX12
+{
+    uint64_t reusedTableCount;                  ///< The number of descriptor tables bound again without writing any descriptor.
+    uint64_t writtenTableCount;                 ///< The number of descriptor tables written to the ring.
+    uint64_t copyCallCount;                     ///< The number of <c><i>CopyDescriptors</i></c> calls issued for the written tables.
+    uint64_t copiedDescriptorCount;             ///< The number of descriptors copied from the CPU heaps.
+    uint64_t createdViewCount;                  ///< The number of buffer views created directly in the ring.
+    uint64_t wrappedTableCount;                 ///< The number of tables that did not fit the part of the ring of their frame and overwrote earlier tables of it.
+} FfxDescriptorRingStatisticsDX12;
+
+/// Query the descriptor ring counters of the backend.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxDescriptorRingStatisticsDX12</i></c> to fill.
+///
+/// @ingroup DX12Backend
+FFX_API FfxErrorCode ffxGetDescriptorRingStatisticsDX12(FfxInterface* backendInterface, FfxDescriptorRingStatisticsDX12* pStatistics);
+
+/// Counters reported by <c><i>ffxGetBarrierStatisticsDX12</i></c>.
+///
+/// Before recording, <c><i>fpExecuteGpuJobs</i></c> looks ahead through the scheduled jobs. A transition
+/// of a resource that no job between its last and next use touches is split: it begins right after the
+/// last use and ends right before the next one. On devices that report
+/// <c><i>D3D12_FEATURE_DATA_D3D12_OPTIONS12::EnhancedBarriersSupported</i></c>, barriers are recorded
+/// through <c><i>ID3D12GraphicsCommandList7::Barrier</i></c> with sync and access scopes derived from the
+/// resource states.
+///
+/// @ingroup DX12Backend
+typedef struct FfxBarrierStatisticsDX12
+{
+    uint64_t transitionBarrierCount;            ///< The number of whole transitions recorded.
+    uint64_t splitBarrierCount;                 ///< The number of transitions recorded as a begin and an end half.
+    uint64_t uavBarrierCount;                   ///< The number of UAV barriers recorded.
+    uint64_t enhancedBarrierCount;              ///< The number of barriers, of any kind above, recorded through the Enhanced Barriers API.
+    bool     enhancedBarriersSupported;         ///< True if the device and headers the backend was built with support Enhanced Barriers.
+} FfxBarrierStatisticsDX12;
+
+/// Query the barrier counters of the backend.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxBarrierStatisticsDX12</i></c> to fill.
+///
+/// @ingroup DX12Backend
+FFX_API FfxErrorCode ffxGetBarrierStatisticsDX12(FfxInterface* backendInterface, FfxBarrierStatisticsDX12* pStatistics);
+
+/// Counters reported by <c><i>ffxGetImmutableResourceStatisticsDX12</i></c>.
+///
+/// Read only resources created with initial data, such as the upscaler lookup tables, are shared by the
+/// effect contexts created on the same <c><i>ID3D12Device</i></c> that create a resource with the same
+/// description and contents, compared byte for byte. This includes contexts on separate interfaces, such as
+/// the contexts created through the FidelityFX API which each get their own. Only the first context allocates
+/// and uploads the resource, the others reference it until the last one destroys it. The counters are kept per
+/// device and cover every interface on it.
+///
+/// @ingroup DX12Backend
+typedef struct FfxImmutableResourceStatisticsDX12
+{
+    uint32_t liveResourceCount;                 ///< The number of shared resources alive.
+    uint64_t createCount;                       ///< The number of shared resources allocated and uploaded.
+    uint64_t shareCount;                        ///< The number of resource creations satisfied by an existing shared resource.
+    uint64_t uploadedBytes;                     ///< The number of initial data bytes uploaded for shared resources.
+    uint64_t skippedUploadBytes;                ///< The number of initial data bytes not uploaded because the resource was shared.
+} FfxImmutableResourceStatisticsDX12;
+
+/// Query the counters of the resources shared between the effect contexts on the device of a backend interface.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxImmutableResourceStatisticsDX12</i></c> to fill.
+///
+/// @ingroup DX12Backend
+FFX_API FfxErrorCode ffxGetImmutableResourceStatisticsDX12(FfxInterface* backendInterface, FfxImmutableResourceStatisticsDX12* pStatistics);
+
 /// Create a <c><i>FfxCommandList</i></c> from a <c><i>ID3D12CommandList</i></c>.
 ///
 /// @param [in] cmdList                     A pointer to the DirectX12 command list.
@@ -90,6 +90,7 @@ typedef struct VkDeviceContext {
     VkDevice                vkDevice;           /// The Vulkan device
     VkPhysicalDevice        vkPhysicalDevice;   /// The Vulkan physical device
     PFN_vkGetDeviceProcAddr vkDeviceProcAddr;   /// The device's function address table
+    VkBool32                synchronization2;   /// VK_TRUE if the device was created with the synchronization2 feature enabled, which lets the backend record its barriers with vkCmdPipelineBarrier2
 } VkDeviceContext;
 
 /// Create a <c><i>FfxDevice</i></c> from a <c><i>VkDevice</i></c>.
@@ -111,6 +112,10 @@ FFX_API FfxDevice ffxGetDeviceVK(VkDeviceContext* vkDeviceContext);
 /// @param [in] maxContexts                 The maximum number of simultaneous effect contexts that will share the backend.
 ///                                         (Note that some effects contain internal contexts which count towards this maximum)
 ///
+/// Effect contexts sharing the backend may be dispatched from different threads at the same time,
+/// each into its own command buffer. GPU jobs and staged constants are kept per calling thread, so a
+/// dispatch has to schedule and execute its jobs on the same thread.
+///
 /// @retval
 /// FFX_OK                                  The operation completed successfully.
 /// @retval
@@ -124,6 +129,258 @@ FFX_API FfxErrorCode ffxGetInterfaceVK(
     size_t scratchBufferSize, 
     size_t maxContexts);
 
+/// Counters reported by <c><i>ffxGetPipelineCacheStatisticsVK</i></c>.
+///
+/// @ingroup VKBackend
+typedef struct FfxPipelineCacheStatisticsVK
+{
+    uint32_t hitCount;                          ///< The number of pipelines created that were already in the cache.
+    uint32_t missCount;                         ///< The number of pipelines that had to be compiled and were added to the cache.
+    uint32_t loadedPipelineCount;               ///< The number of pipelines in the initial data.
+    bool     initialDataRejected;               ///< True if initial data was given but did not match this device or driver, or was corrupt, and was discarded.
+} FfxPipelineCacheStatisticsVK;
+
+/// Create a <c><i>VkPipelineCache</i></c> used by the backend for all pipelines it creates from then on.
+///
+/// Call after <c><i>ffxGetInterfaceVK</i></c>. The cache outlives the effect contexts, so contexts
+/// that are destroyed and created again reuse the pipelines compiled for the previous ones.
+/// Initial data is expected to come from <c><i>ffxGetPipelineCacheDataVK</i></c>; data written
+/// for another vendor, device, driver version or driver UUID, or that fails its checksum, is
+/// discarded and the cache starts out empty.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceVK</i></c>.
+/// @param [in] pInitialData                (optional) Data saved by a previous run.
+/// @param [in] initialDataSize             The size (in bytes) of <c><i>pInitialData</i></c>, 0 if there is none.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> or <c><i>pInitialData</i></c> pointer was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              The backend already has a pipeline cache.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR             The pipeline cache could not be created.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxCreatePipelineCacheVK(FfxInterface* backendInterface, const void* pInitialData, size_t initialDataSize);
+
+/// Serialize the backend pipeline cache so it can be passed to <c><i>ffxCreatePipelineCacheVK</i></c> next run.
+///
+/// Call with <c><i>pData</i></c> set to <c><i>NULL</i></c> to query the size to allocate.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> with a pipeline cache.
+/// @param [out] pData                      The buffer to write to, or <c><i>NULL</i></c>.
+/// @param [inout] pDataSize                The size (in bytes) of <c><i>pData</i></c>, receives the size written or required.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              The backend has no pipeline cache.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY           <c><i>pData</i></c> is too small.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxGetPipelineCacheDataVK(FfxInterface* backendInterface, void* pData, size_t* pDataSize);
+
+/// Query the hit and miss counters of the backend pipeline cache.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxPipelineCacheStatisticsVK</i></c> to fill.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxGetPipelineCacheStatisticsVK(FfxInterface* backendInterface, FfxPipelineCacheStatisticsVK* pStatistics);
+
+/// Destroy the backend pipeline cache. Pipelines created with it stay valid.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxDestroyPipelineCacheVK(FfxInterface* backendInterface);
+
+/// Counters reported by <c><i>ffxGetImageViewCacheStatisticsVK</i></c>.
+///
+/// @ingroup VKBackend
+typedef struct FfxImageViewCacheStatisticsVK
+{
+    uint32_t residentViewCount;                 ///< The number of image views currently held by the cache.
+    uint64_t hitCount;                          ///< The number of registrations served by a cached image view.
+    uint64_t createCount;                       ///< The number of image views created and added to the cache.
+    uint64_t evictionCount;                     ///< The number of image views destroyed to stay within the budget.
+    uint64_t uncachedCreateCount;               ///< The number of image views created outside the cache because it was full of views still in flight.
+} FfxImageViewCacheStatisticsVK;
+
+/// Keep the image views of resources registered every frame alive across frames.
+///
+/// By default the backend creates the views of each dynamically registered image
+/// in <c><i>fpRegisterResource</i></c> and destroys them a few frames later. With a
+/// budget set, views are cached per effect context and keyed by image, format, aspect,
+/// mip range and usage, so steady state registration no longer calls into the driver.
+/// Views that have not been used for <c><i>FFX_MAX_QUEUED_FRAMES</i></c> frames are
+/// evicted least recently used first once the budget is reached.
+///
+/// Because the cache is keyed by <c><i>VkImage</i></c> handle, the application must call
+/// <c><i>ffxReleaseImageViewsVK</i></c> before destroying an image it registered while
+/// the cache is enabled. Setting a budget of 0 disables the cache and destroys all cached
+/// views; the GPU must be done with them.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceVK</i></c>.
+/// @param [in] maxViews                    The maximum number of cached views, clamped to the cache capacity. 0 disables the cache.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxSetImageViewCacheBudgetVK(FfxInterface* backendInterface, uint32_t maxViews);
+
+/// Destroy all cached image views of <c><i>image</i></c>.
+///
+/// Must be called before the image is destroyed, once the GPU is done with it.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [in] image                       The image that is about to be destroyed.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxReleaseImageViewsVK(FfxInterface* backendInterface, VkImage image);
+
+/// Query the counters of the image view cache.
+/// The counters are zero while no effect context exists, as they are reset with the last one.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxImageViewCacheStatisticsVK</i></c> to fill.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxGetImageViewCacheStatisticsVK(FfxInterface* backendInterface, FfxImageViewCacheStatisticsVK* pStatistics);
+
+/// Counters of how compute dispatches bound their descriptors, reported by <c><i>ffxGetDescriptorStatisticsVK</i></c>.
+///
+/// Pipelines whose descriptors fit in <c><i>maxPushDescriptors</i></c> push them when
+/// <c><i>VK_KHR_push_descriptor</i></c> is available. Other pipelines bind a descriptor set
+/// already holding the same bindings when there is one and only write a set otherwise.
+///
+/// @ingroup VKBackend
+typedef struct FfxDescriptorStatisticsVK
+{
+    uint64_t pushCount;                         ///< The number of dispatches that pushed their descriptors.
+    uint64_t reuseCount;                        ///< The number of dispatches that bound a set written by an earlier dispatch.
+    uint64_t writeCount;                        ///< The number of dispatches that had to write a descriptor set.
+    uint64_t transientCount;                    ///< The number of sets written to the transient pool because every cached set of the pipeline was in flight.
+} FfxDescriptorStatisticsVK;
+
+/// Query the descriptor binding counters of the backend.
+/// The counters are zero while no effect context exists, as they are reset with the last one.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxDescriptorStatisticsVK</i></c> to fill.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxGetDescriptorStatisticsVK(FfxInterface* backendInterface, FfxDescriptorStatisticsVK* pStatistics);
+
+/// Memory the backend reserved on demand, reported by <c><i>ffxGetDescriptorPoolStatisticsVK</i></c>.
+///
+/// Descriptor pools are added in chunks sized from the pipeline layouts created so far, and
+/// the GPU job list and bindless image views grow in chunks outside of the scratch buffer.
+/// Each recording thread has its own GPU job list; the capacity is summed over them.
+///
+/// @ingroup VKBackend
+typedef struct FfxDescriptorPoolStatisticsVK
+{
+    uint32_t poolCount;                         ///< The number of descriptor pools holding cached descriptor sets.
+    uint32_t reservedSetCount;                  ///< The number of descriptor sets those pools can hold.
+    uint32_t reservedDescriptorCount;           ///< The number of descriptors of all types those pools can hold.
+    uint32_t setCount;                          ///< The number of cached descriptor sets currently allocated.
+    uint32_t peakSetCount;                      ///< The highest number of cached descriptor sets allocated at once.
+    uint32_t gpuJobCapacity;                    ///< The number of GPU jobs that can be scheduled without allocating.
+    uint32_t peakGpuJobCount;                   ///< The highest number of GPU jobs scheduled before an execution.
+    uint32_t bindlessViewCapacity;              ///< The number of bindless image views that can be held without allocating.
+    uint32_t peakBindlessViewCount;             ///< The highest number of bindless image views reserved by effect contexts at once.
+} FfxDescriptorPoolStatisticsVK;
+
+/// Query the descriptor pool and on demand memory counters of the backend.
+/// The counters are zero while no effect context exists, as they are reset with the last one.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxDescriptorPoolStatisticsVK</i></c> to fill.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxGetDescriptorPoolStatisticsVK(FfxInterface* backendInterface, FfxDescriptorPoolStatisticsVK* pStatistics);
+
+/// Constant buffer memory use of the backend, reported by <c><i>ffxGetConstantBufferStatisticsVK</i></c>.
+///
+/// The uniform buffer is split into one partition per effect context and queued frame, which is
+/// only reused once its frame has come around again. A frame overflowing its partition makes the
+/// backend move to a uniform buffer with twice larger partitions, keeping the previous one alive.
+///
+/// @ingroup VKBackend
+typedef struct FfxConstantBufferStatisticsVK
+{
+    uint64_t uniformBufferSize;                 ///< The size in bytes of the current uniform buffer.
+    uint64_t partitionSize;                     ///< The size in bytes of the partition of each effect context and queued frame.
+    uint64_t alignment;                         ///< The alignment in bytes of each constant buffer in the uniform buffer.
+    uint64_t peakFrameUsage;                    ///< The most bytes used by an effect context in a single frame.
+    uint32_t growCount;                         ///< The number of times a frame overflowed its partition and the uniform buffer was reallocated.
+    uint32_t failedAllocationCount;             ///< The number of constant buffers that could not be allocated because the uniform buffer could not grow.
+    uint64_t peakStagingUsage;                  ///< The most bytes staged on the CPU between two executions of the GPU jobs.
+    uint32_t stagingOverflowCount;              ///< The number of constant buffers staged in heap memory because the staging ring was full.
+} FfxConstantBufferStatisticsVK;
+
+/// Query the constant buffer memory counters of the backend.
+/// The counters are zero while no effect context exists, as they are reset with the last one.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [out] pStatistics                The <c><i>FfxConstantBufferStatisticsVK</i></c> to fill.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxGetConstantBufferStatisticsVK(FfxInterface* backendInterface, FfxConstantBufferStatisticsVK* pStatistics);
+
+/// A batch of pipeline barriers recorded by the backend, reported to a <c><i>FfxBarrierFlushCallbackVK</i></c>.
+///
+/// Textures are tracked per mip, so a pass writing one mip while reading another only
+/// transitions the mips it binds. Transitions between identical read states are dropped.
+///
+/// @ingroup VKBackend
+typedef struct FfxBarrierFlushInfoVK
+{
+    uint32_t                    imageBarrierCount;      ///< The number of image barriers in the batch.
+    uint32_t                    bufferBarrierCount;     ///< The number of buffer barriers in the batch.
+    uint32_t                    droppedBarrierCount;    ///< The number of subresource transitions dropped since the previous batch because they changed nothing.
+    VkPipelineStageFlags2KHR    srcStageMask;           ///< The union of the source stages of the batch.
+    VkPipelineStageFlags2KHR    dstStageMask;           ///< The union of the destination stages of the batch.
+    bool                        synchronization2;       ///< Whether the batch was recorded with <c><i>vkCmdPipelineBarrier2KHR</i></c>, each barrier then only waits on its own stages.
+} FfxBarrierFlushInfoVK;
+
+/// Called by the backend after recording each batch of pipeline barriers.
+///
+/// Effect contexts dispatched from different threads call it concurrently, from the recording thread.
+///
+/// @param [in] pFlushInfo                  The barriers of the batch.
+/// @param [in] pUserData                   The pointer given to <c><i>ffxSetBarrierFlushCallbackVK</i></c>.
+///
+/// @ingroup VKBackend
+typedef void (*FfxBarrierFlushCallbackVK)(const FfxBarrierFlushInfoVK* pFlushInfo, void* pUserData);
+
+/// Install a hook that observes the pipeline barriers recorded by the backend, for tests and profiling.
+///
+/// The hook is kept when the last effect context is destroyed.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c>.
+/// @param [in] callback                    The hook, or <c><i>NULL</i></c> to remove it.
+/// @param [in] pUserData                   A pointer passed back to the hook.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxSetBarrierFlushCallbackVK(FfxInterface* backendInterface, FfxBarrierFlushCallbackVK callback, void* pUserData);
+
 /// Create a <c><i>FfxCommandList</i></c> from a <c><i>VkCommandBuffer</i></c>.
 ///
 /// @param [in] cmdBuf                      A pointer to the Vulkan command buffer.
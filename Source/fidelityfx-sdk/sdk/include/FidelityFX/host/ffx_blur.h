@@ -132,6 +132,31 @@ typedef enum FfxBlurFloatPrecision
 typedef uint32_t FfxBlurKernelPermutations;
 typedef uint32_t FfxBlurKernelSizes;
 
+/// The set of pipelines a context has dispatched, for each kernel permutation (indexed by the
+/// bit position of its FfxBlurKernelPermutation value) a bit mask of FfxBlurKernelSize values.
+/// Retrieve it with ffxBlurContextGetPipelineUsage before destroying a context, store it, and
+/// pass it to FfxBlurContextDescription::pPrewarmProfile next run to compile those pipelines upfront.
+///
+/// @ingroup ffxBlur
+typedef struct FfxBlurPipelineUsageProfile
+{
+    FfxBlurKernelSizes          kernelSizes[FFX_BLUR_KERNEL_PERMUTATION_COUNT];  ///< The kernel sizes used with each kernel permutation.
+} FfxBlurPipelineUsageProfile;
+
+/// Statistics about the pipelines of a context, see ffxBlurContextGetPipelineStatistics.
+///
+/// @ingroup ffxBlur
+typedef struct FfxBlurPipelineStatistics
+{
+    uint32_t                    residentPipelineCount;      ///< The number of pipelines currently compiled.
+    uint32_t                    peakResidentPipelineCount;  ///< The highest number of pipelines compiled at the same time.
+    uint32_t                    compiledPipelineCount;      ///< The number of pipelines compiled so far, including recompiles after eviction.
+    uint32_t                    evictedPipelineCount;       ///< The number of pipelines released to stay within FfxBlurContextDescription::maxResidentPipelines.
+    uint32_t                    retiredPipelineCount;       ///< The number of evicted pipelines not destroyed yet, see ffxBlurContextReleaseEvictedPipelines.
+    uint64_t                    contextCreateTimeUs;        ///< The time spent in ffxBlurContextCreate, including prewarming, in microseconds.
+    uint64_t                    pipelineCompileTimeUs;      ///< The total time spent compiling pipelines, in microseconds.
+} FfxBlurPipelineStatistics;
+
 /// FfxBlurContextDescription struct is used to create/initialize an FfxBlurContext.
 ///
 /// @ingroup ffxBlur
@@ -141,6 +166,8 @@ typedef struct FfxBlurContextDescription
     FfxBlurKernelSizes          kernelSizes;            ///< A bit mask of FfxBlurKernelSize values to indicated which kernel sizes to enable for use.
     FfxBlurFloatPrecision       floatPrecision;         ///< A flag indicating the desired floating point precision for use in ffxBlurContextDispatch
     FfxInterface                backendInterface;       ///< A set of pointers to the backend implementation for FidelityFX.
+    uint32_t                    maxResidentPipelines;   ///< The maximum number of pipelines kept compiled, least recently used ones are released past it, FFX_MAX_QUEUED_FRAMES frames after their eviction. 0 for no limit.
+    const FfxBlurPipelineUsageProfile* pPrewarmProfile; ///< An optional set of pipelines to compile during ffxBlurContextCreate, all others are compiled on their first dispatch.
 } FfxBlurContextDescription;
 
 /// FfxBlurContext must be created via ffxBlurContextCreate to use the FFX Blur effect.
@@ -177,8 +204,34 @@ typedef struct FfxBlurDispatchDescription
     FfxDimensions2D          inputAndOutputSize; ///< The width and height in pixels of the input and output resources.
     FfxResource              input;              ///< The <c><i>FfxResource</i></c> to blur.
     FfxResource              output;             ///< The <c><i>FfxResource</i></c> containing the output buffer for the blurred output.
+    uint64_t                 frameIndex;         ///< The index of the current frame. Pipelines evicted under FfxBlurContextDescription::maxResidentPipelines are destroyed once it advanced by FFX_MAX_QUEUED_FRAMES, callers leaving it at 0 must use ffxBlurContextReleaseEvictedPipelines instead.
 } FfxBlurDispatchDescription;
 
+/// Destroy the pipelines evicted under FfxBlurContextDescription::maxResidentPipelines that are still
+/// waiting for FfxBlurDispatchDescription::frameIndex to advance. The GPU must have finished all work
+/// dispatched with the context, e.g. call it after a device flush on resize or scene change.
+///
+/// @param [in] pContext             The FfxBlurContext to release the evicted pipelines of.
+///
+/// @ingroup ffxBlur
+FFX_API FfxErrorCode ffxBlurContextReleaseEvictedPipelines(FfxBlurContext* pContext);
+
+/// Retrieve the pipelines dispatched by an FfxBlurContext since it was created.
+///
+/// @param [in] pContext             The FfxBlurContext to query.
+/// @param [out] pProfile            The FfxBlurPipelineUsageProfile to fill.
+///
+/// @ingroup ffxBlur
+FFX_API FfxErrorCode ffxBlurContextGetPipelineUsage(FfxBlurContext* pContext, FfxBlurPipelineUsageProfile* pProfile);
+
+/// Retrieve pipeline compile and residency statistics of an FfxBlurContext.
+///
+/// @param [in] pContext             The FfxBlurContext to query.
+/// @param [out] pStatistics         The FfxBlurPipelineStatistics to fill.
+///
+/// @ingroup ffxBlur
+FFX_API FfxErrorCode ffxBlurContextGetPipelineStatistics(FfxBlurContext* pContext, FfxBlurPipelineStatistics* pStatistics);
+
 /// Create and initialize the FfxBlurContext.
 ///
 /// @param [in] pContext             The FfxBlurContext to use for the dispatch.
@@ -63,6 +63,17 @@
 /// @ingroup ffxBreadcrumbs
 #define FFX_BREADCRUMBS_MAX_MARKERS_PER_BLOCK ((1U << 31) - 1U)
 
+/// Size in bytes of chunks passed to <c><i>FfxBreadcrumbsStatusSink</i></c> while writing status.
+///
+/// @ingroup ffxBreadcrumbs
+#define FFX_BREADCRUMBS_STATUS_CHUNK_SIZE (4096)
+
+/// Maximal nesting level of markers displayed in status. Deeper markers are counted in a note after their command list
+/// and the status functions return <c><i>FFX_ERROR_OUT_OF_RANGE</i></c>.
+///
+/// @ingroup ffxBreadcrumbs
+#define FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL (256)
+
 /// List of marker types to be used in X() macro.
 ///
 /// @ingroup ffxBreadcrumbs
@@ -280,6 +291,22 @@ typedef struct FfxBreadcrumbsMarkersStatus
     char*                       pBuffer;                   ///< UTF-8 encoded buffer with log about markers execution. Have to be released with <c><i>FFX_FREE</i></c>.
 } FfxBreadcrumbsMarkersStatus;
 
+/// An enumeration of formats in which markers status can be written.
+///
+/// @ingroup ffxBreadcrumbs
+typedef enum FfxBreadcrumbsStatusFormat {
+
+    FFX_BREADCRUMBS_STATUS_FORMAT_TEXT,         ///< UTF-8 encoded log, same as returned by <c><i>ffxBreadcrumbsPrintStatus()</i></c>.
+    FFX_BREADCRUMBS_STATUS_FORMAT_BINARY,       ///< Compact binary form that can be turned into text later with <c><i>ffxBreadcrumbsDecodeStatus()</i></c>.
+} FfxBreadcrumbsStatusFormat;
+
+/// Callback receiving consecutive chunks of markers status, each at most <c><i>FFX_BREADCRUMBS_STATUS_CHUNK_SIZE</i></c> bytes.
+///
+/// Data is only valid for the duration of the call.
+///
+/// @ingroup ffxBreadcrumbs
+typedef void (*FfxBreadcrumbsStatusSink)(void* pUserData, const void* pData, size_t size);
+
 /// A structure encapsulating the FidelityFX Breadcrumbs context.
 ///
 /// This sets up an object which contains all persistent internal data and
@@ -470,10 +497,61 @@ FFX_API FfxErrorCode ffxBreadcrumbsEndMarker(FfxBreadcrumbsContext* pContext, Ff
 /// FFX_OK                              The operation completed successfully.
 /// @retval
 /// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>pContext</i></c> or <c><i>pMarkersStatus</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_OUT_OF_RANGE              The status was written, but markers nested deeper than <c><i>FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL</i></c> were left out.
 ///
 /// @ingroup ffxBreadcrumbs
 FFX_API FfxErrorCode ffxBreadcrumbsPrintStatus(FfxBreadcrumbsContext* pContext, FfxBreadcrumbsMarkersStatus* pMarkersStatus);
 
+/// Write information about current FidelityFX Breadcrumbs markers status through provided sink.
+///
+/// Streaming variant of <c><i>ffxBreadcrumbsPrintStatus()</i></c> that is safe to use inside device removed handlers.
+/// Output is staged in a fixed size buffer on the stack and no memory is allocated by the library,
+/// apart from device information gathered by the backend when <c><i>FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO</i></c> is not set.
+/// Should always be called from a single thread.
+///
+/// @param [in] pContext                A pointer to a <c><i>FfxBreadcrumbsContext</i></c> structure.
+/// @param [in] format                  Format of the written status.
+/// @param [in] sink                    Callback receiving status data.
+/// @param [in] pUserData               User data passed to <c><i>sink</i></c>.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>pContext</i></c> or <c><i>sink</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ENUM              The operation failed because <c><i>format</i></c> is not a valid <c><i>FfxBreadcrumbsStatusFormat</i></c>.
+/// @retval
+/// FFX_ERROR_OUT_OF_RANGE              The status was written, but markers nested deeper than <c><i>FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL</i></c> were left out.
+///
+/// @ingroup ffxBreadcrumbs
+FFX_API FfxErrorCode ffxBreadcrumbsWriteStatus(FfxBreadcrumbsContext* pContext, FfxBreadcrumbsStatusFormat format, FfxBreadcrumbsStatusSink sink, void* pUserData);
+
+/// Convert status written in <c><i>FFX_BREADCRUMBS_STATUS_FORMAT_BINARY</i></c> into text log.
+///
+/// Does not require a context, so it can be used offline. Data is validated before being printed.
+///
+/// @param [in] pData                   Binary status data.
+/// @param [in] dataSize                Size of <c><i>pData</i></c> in bytes.
+/// @param [in] sink                    Callback receiving text status.
+/// @param [in] pUserData               User data passed to <c><i>sink</i></c>.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>pData</i></c> or <c><i>sink</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_SIZE              The operation failed because <c><i>pData</i></c> is truncated.
+/// @retval
+/// FFX_ERROR_INVALID_VERSION           The operation failed because data was written by an incompatible version of the library.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because <c><i>pData</i></c> does not contain valid status.
+/// @retval
+/// FFX_ERROR_OUT_OF_RANGE              The status was written, but markers nested deeper than <c><i>FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL</i></c> were left out.
+///
+/// @ingroup ffxBreadcrumbs
+FFX_API FfxErrorCode ffxBreadcrumbsDecodeStatus(const void* pData, size_t dataSize, FfxBreadcrumbsStatusSink sink, void* pUserData);
+
 /// Queries the effect version number.
 ///
 /// @returns
@@ -188,6 +188,15 @@ typedef struct FfxBrixelizerInstanceDescription {
     FfxBrixelizerInstanceID    *outInstanceID;        ///< A pointer to an <c><i>FfxBrixelizerInstanceID</i></c> storing the ID of the created instance.
 } FfxBrixelizerInstanceDescription;
 
+/// A structure describing a new placement of a static Brixelizer instance.
+///
+/// @ingroup ffxBrixelizer
+typedef struct FfxBrixelizerInstanceTransformUpdate {
+    FfxBrixelizerInstanceID     instanceID;           ///< The ID of the static instance to move.
+    FfxBrixelizerAABB           aabb;                 ///< An AABB surrounding the instance at its new placement.
+    FfxFloat32x3x4              transform;            ///< A transform of the instance into world space. The transform is in row major order.
+} FfxBrixelizerInstanceTransformUpdate;
+
 /// Get the size in bytes needed for an <c><i>FfxBrixelizerContext</i></c> struct.
 /// Note that this function is provided for consistency, and the size of the
 /// <c><i>FfxBrixelizerContext</i></c> is a known compile time value which can be
@@ -270,6 +279,9 @@ FFX_API FfxErrorCode ffxBrixelizerBakeUpdate(FfxBrixelizerContext* context, cons
 ///
 /// @retval
 /// FFX_OK                        The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY Instance, job or debug data did not fit in upload buffer space not used by in-flight frames.
+///                               The rest of the update is still recorded, and pending instance uploads are retried by the next update.
 ///
 /// @ingroup ffxBrixelizer
 FFX_API FfxErrorCode ffxBrixelizerUpdate(FfxBrixelizerContext* context, FfxBrixelizerBakedUpdateDescription* desc, FfxResource scratchBuffer, FfxCommandList commandList);
@@ -321,6 +333,24 @@ FFX_API FfxErrorCode ffxBrixelizerCreateInstances(FfxBrixelizerContext* context,
 /// @ingroup ffxBrixelizer
 FFX_API FfxErrorCode ffxBrixelizerDeleteInstances(FfxBrixelizerContext* context, const FfxBrixelizerInstanceID* instanceIDs, uint32_t numInstanceIDs);
 
+/// Move static instances of a Brixelizer context without recreating them.
+///
+/// Only instances whose transform or AABB changed are uploaded, and static cascades are invalidated
+/// only in the areas covered by the previous and new AABBs of those instances. When more areas are
+/// pending than the context can hold until the next update, new ones are merged into nearby pending ones.
+///
+/// @param [inout] context      An <c><i>FfxBrixelizerContext</i></c> containing the Brixelizer context.
+/// @param [in]    updates      An array of <c><i>FfxBrixelizerInstanceTransformUpdate</i></c> structs with the new placements.
+/// @param [in]    numUpdates   The number of entries in the array passed in by <c><i>updates</i></c>.
+///
+/// @retval
+/// FFX_OK                      The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT  The operation failed because an instance ID is out of range or does not refer to a live static instance.
+///
+/// @ingroup ffxBrixelizer
+FFX_API FfxErrorCode ffxBrixelizerUpdateInstanceTransforms(FfxBrixelizerContext* context, const FfxBrixelizerInstanceTransformUpdate* updates, uint32_t numUpdates);
+
 /// Get a pointer to the underlying Brixelizer raw context from a Brixelizer context.
 ///
 /// @param [inout] context    An <c><i>FfxBrixelizerContext</i></c> containing the Brixelizer context.
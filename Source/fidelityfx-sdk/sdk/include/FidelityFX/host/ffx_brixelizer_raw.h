@@ -294,6 +294,17 @@ typedef struct FfxBrixelizerRawInstanceDescription
     FfxBrixelizerInstanceID  *outInstanceID;        ///< A pointer to an <c><i>FfxBrixelizerInstanceID</i></c> to be filled with the instance ID assigned for the instance.
 } FfxBrixelizerRawInstanceDescription;
 
+/// A structure describing a new placement of an existing Brixelizer instance.
+///
+/// @ingroup ffxBrixelizer
+typedef struct FfxBrixelizerRawInstanceTransformUpdate
+{
+    FfxBrixelizerInstanceID   instanceID;           ///< The ID of the instance to update.
+    float                     aabbMin[3];           ///< The minimum coordinates of an AABB surrounding the instance at its new placement.
+    float                     aabbMax[3];           ///< The maximum coordinates of an AABB surrounding the instance at its new placement.
+    FfxFloat32x3x4            transform;            ///< The new transform of the instance into world space. The transform is in row major order.
+} FfxBrixelizerRawInstanceTransformUpdate;
+
 
 /// Get the size in bytes needed for an <c><i>FfxBrixelizerRawContext</i></c> struct.
 /// Note that this function is provided for consistency, and the size of the
@@ -480,6 +491,8 @@ FFX_API FfxErrorCode ffxBrixelizerRawContextGetScratchMemorySize(FfxBrixelizerRa
 /// FFX_ERROR_INVALID_POINTER              The operation failed because <c><i>context</i></c> or <c><i>cascadeUpdateDescription</c></i> was <c><i>NULL</i></c>.
 /// @retval
 /// FFX_ERROR_NULL_DEVICE                  The operation failed because the <c><i>FfxDevice</i></c> provided to the <c><i>context</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY          The operation failed because the jobs did not fit in upload buffer space not used by in-flight frames. The cascade is left unchanged.
 ///
 /// @ingroup ffxBrixelizer
 FFX_API FfxErrorCode ffxBrixelizerRawContextUpdateCascade(FfxBrixelizerRawContext* context, const FfxBrixelizerRawCascadeUpdateDescription* cascadeUpdateDescription);
@@ -530,6 +543,8 @@ FFX_API FfxErrorCode ffxBrixelizerRawContextBuildAABBTree(FfxBrixelizerRawContex
 /// FFX_ERROR_INVALID_POINTER                   The operation failed because <c><i>context</i></c> or <c><i>debugVisualizationDescription</i></c> was <c><i>NULL</i></c>.
 /// @retval
 /// FFX_ERROR_NULL_DEVICE                       The operation failed because the <c><i>FfxDevice</i></c> provided to the <c><i>context</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY               The operation failed because debug instance IDs did not fit in upload buffer space not used by in-flight frames.
 ///
 /// @ingroup ffxBrixelizer
 FFX_API FfxErrorCode ffxBrixelizerRawContextDebugVisualization(FfxBrixelizerRawContext* context, const FfxBrixelizerDebugVisualizationDescription* debugVisualizationDescription);
@@ -592,7 +607,29 @@ FFX_API FfxErrorCode ffxBrixelizerRawContextCreateInstances(FfxBrixelizerRawCont
 /// @ingroup ffxBrixelizer
 FFX_API FfxErrorCode ffxBrixelizerRawContextDestroyInstances(FfxBrixelizerRawContext* context, const FfxBrixelizerInstanceID* instanceIDs, uint32_t numInstanceIDs);
 
-/// Flush all instances added to the Brixelizer context with <c><i>ffxBrixelizerRawContextCreateInstance</i></c> to the GPU.
+/// Update the transforms and AABBs of instances in a Brixelizer context without recreating them.
+///
+/// Only values that differ from the current ones are marked dirty, and only dirty ranges of instances are uploaded
+/// by the next call to <c><i>ffxBrixelizerRawContextFlushInstances</i></c>. Cascades are not invalidated, the caller
+/// is responsible for submitting <c><i>FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE</i></c> jobs for the areas that changed.
+///
+/// @param [out] context                        The <c><i>FfxBrixelizerRawContext</i></c> to update instances for.
+/// @param [in]  updates                        An array of <c><i>FfxBrixelizerRawInstanceTransformUpdate</i></c> structs describing the new placements.
+/// @param [in]  numUpdates                     The number of elements in the array passed in by <c><i>updates</i></c>.
+/// @param [out] outChanged                     An optional array of <c><i>numUpdates</i></c> elements, filled with whether the transform or AABB of each instance changed.
+///
+/// @retval
+/// FFX_OK                                      The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER                   The operation failed because <c><i>context</i></c> or <c><i>updates</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT                  The operation failed because an instance ID is out of range or not a live instance, or an AABB is inverted. No instance is updated.
+///
+/// @ingroup ffxBrixelizer
+FFX_API FfxErrorCode ffxBrixelizerRawContextUpdateInstanceTransforms(FfxBrixelizerRawContext* context, const FfxBrixelizerRawInstanceTransformUpdate* updates, uint32_t numUpdates, bool* outChanged);
+
+/// Flush all instances added to the Brixelizer context with <c><i>ffxBrixelizerRawContextCreateInstance</i></c>
+/// or updated with <c><i>ffxBrixelizerRawContextUpdateInstanceTransforms</i></c> to the GPU.
 ///
 /// @param [out] context                        The <c><i>FfxBrixelizerRawContext</i></c> to flush the instances for.
 /// @param [in]  cmdList                        An <c><i>FfxCommandList</i></c> to record GPU commands to.
@@ -601,6 +638,8 @@ FFX_API FfxErrorCode ffxBrixelizerRawContextDestroyInstances(FfxBrixelizerRawCon
 /// FFX_OK                                      The operation completed successfully.
 /// @retval
 /// FFX_ERROR_INVALID_POINTER                   The operation failed because <c><i>context</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY               Not all instances fit in upload buffer space not used by in-flight frames. Instances not uploaded stay dirty for the next flush.
 ///
 /// @ingroup ffxBrixelizer
 FFX_API FfxErrorCode ffxBrixelizerRawContextFlushInstances(FfxBrixelizerRawContext* context, FfxCommandList cmdList);
@@ -57,7 +57,7 @@
 /// The size of the context specified in 32bit values.
 ///
 /// @ingroup FfxLpm
-#define FFX_LPM_CONTEXT_SIZE (9300)
+#define FFX_LPM_CONTEXT_SIZE (9344)
 
 #if defined(__cplusplus)
 extern "C" {
@@ -232,6 +232,39 @@ FFX_API FfxErrorCode ffxLpmContextDispatch(FfxLpmContext* pContext, const FfxLpm
 /// @ingroup FfxLpm
 FFX_API FfxErrorCode ffxLpmContextDestroy(FfxLpmContext* pContext);
 
+/// Runs the LPM filter on the CPU, as a reference for the GPU pass.
+///
+/// The constants are calculated from the same fields of the
+/// <c><i>FfxLpmDispatchDescription</i></c> as <c><i>ffxLpmContextDispatch</i></c>
+/// uses, the command list and resources are ignored. Pixels are RGBA 32-bit
+/// floats, alpha is passed through and the output is encoded with the same
+/// gamma or PQ curve the shader applies for the display mode. Four pixels are
+/// processed at a time with SSE2 where available. Input and output may alias.
+///
+/// @param [in]  pDispatchDescription    A pointer to a <c><i>FfxLpmDispatchDescription</i></c> structure.
+/// @param [in]  pInput                  The linear input pixels.
+/// @param [out] pOutput                 The tone and gamut mapped output pixels.
+/// @param [in]  width                   The width of the image in pixels.
+/// @param [in]  height                  The height of the image in pixels.
+/// @param [in]  inputRowPitch           The distance in bytes between rows of <c><i>pInput</i></c>.
+/// @param [in]  outputRowPitch          The distance in bytes between rows of <c><i>pOutput</i></c>.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because one of the pointers was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_SIZE              The operation failed because a row pitch is smaller than a row.
+///
+/// @ingroup FfxLpm
+FFX_API FfxErrorCode ffxLpmFilterCpu(const FfxLpmDispatchDescription* pDispatchDescription,
+                                     const float*                     pInput,
+                                     float*                           pOutput,
+                                     uint32_t                         width,
+                                     uint32_t                         height,
+                                     size_t                           inputRowPitch,
+                                     size_t                           outputRowPitch);
+
 /// Sets up the constant buffer data necessary for LPM compute
 /// 
 /// @param [in] incon                   
@@ -76,7 +76,7 @@ typedef enum FfxSssrPass
 {
     FFX_SSSR_PASS_DEPTH_DOWNSAMPLE = 0,             ///< A pass which performs the hierarchical depth buffer generation
     FFX_SSSR_PASS_CLASSIFY_TILES = 1,               ///< A pass which classifies which pixels require screen space ray marching
-    FFX_SSSR_PASS_PREPARE_BLUE_NOISE_TEXTURE = 2,   ///< A pass which generates an optimized blue noise texture
+    FFX_SSSR_PASS_PREPARE_BLUE_NOISE_TEXTURE = 2,   ///< No longer dispatched, the blue noise is generated on the CPU. The value is kept so the other passes keep theirs.
     FFX_SSSR_PASS_PREPARE_INDIRECT_ARGS = 3,        ///< A pass which generates the indirect arguments for the intersection pass.
     FFX_SSSR_PASS_INTERSECTION = 4,                 ///< A pass which performs the actual hierarchical depth ray marching.
     FFX_SSSR_PASS_COUNT
@@ -255,6 +255,29 @@ FFX_API FfxErrorCode ffxSssrContextDestroy(FfxSssrContext* context);
 /// @ingroup ffxSssr
 FFX_API FfxVersionNumber ffxSssrGetEffectVersion();
 
+/// Generates one frame of the SSSR blue noise on the CPU.
+///
+/// These are the samples the intersection pass uses, Eric Heitz's 1spp
+/// blue noise offset by the golden ratio for the frame, and repeat every
+/// 256 frames. The context only uploads the frame independent values and
+/// the shader adds the offset, this function runs the same computation on
+/// the CPU for tools and verification. The output is a 128x128 RG8 UNORM
+/// tile. Four pixels are processed at a time with SSE2 where available.
+///
+/// @param [in]  frameIndex              The frame to generate, only the low 8 bits are used.
+/// @param [out] pOutput                 The 128x128 tile of RG8 texels.
+/// @param [in]  rowPitch                The distance in bytes between rows of <c><i>pOutput</i></c>.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_NULL_POINTER         The operation failed because <c><i>pOutput</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_SIZE              The operation failed because the row pitch is smaller than a row.
+///
+/// @ingroup ffxSssr
+FFX_API FfxErrorCode ffxSssrGenerateBlueNoiseCpu(uint32_t frameIndex, uint8_t* pOutput, size_t rowPitch);
+
 #if defined(__cplusplus)
 }
 #endif // #if defined(__cplusplus)
@@ -27,6 +27,10 @@
 #include <FidelityFX/host/backends/dx12/d3dx12.h>
 #include <ffx_shader_blobs.h>
 #include <ffx_breadcrumbs_list.h>
+#include "ffx_dx12_barrier_planner.h"
+#include "ffx_dx12_descriptor_table.h"
+#include "ffx_dx12_immutable_resources.h"
+#include "ffx_dx12_pipeline_cache.h"
 #include <codecvt>  // convert string to wstring
 #include <memoryapi.h> // for VirtualAlloc
 #include <mutex>
@@ -97,6 +101,27 @@ void RegisterConstantBufferAllocatorDX12(FfxInterface* backendInterface, FfxCons
 // Constant buffer allocation callback
 static FfxConstantBufferAllocator s_fpConstantAllocator = nullptr;
 
+// Barriers are queued in this form and translated to legacy or enhanced barriers when flushed
+typedef enum QueuedBarrierType {
+    FFX_QUEUED_BARRIER_TRANSITION,
+    FFX_QUEUED_BARRIER_UAV,
+} QueuedBarrierType;
+
+typedef enum SplitBarrierPhase {
+    FFX_SPLIT_BARRIER_NONE,
+    FFX_SPLIT_BARRIER_BEGIN,
+    FFX_SPLIT_BARRIER_END,
+} SplitBarrierPhase;
+
+typedef struct QueuedBarrier
+{
+    uint32_t          resourceIndex;
+    FfxResourceStates stateBefore;
+    FfxResourceStates stateAfter;
+    QueuedBarrierType type;
+    SplitBarrierPhase phase;
+} QueuedBarrier;
+
 typedef struct BackendContext_DX12 {
 
     // store for resources and resourceViews
@@ -109,6 +134,10 @@ typedef struct BackendContext_DX12 {
         FfxResourceDescription  resourceDescription;
         FfxResourceStates       initialState;
         FfxResourceStates       currentState;
+        FfxResourceStates       splitBarrierState;      // the state a begun split barrier transitions to
+        bool                    splitBarrierPending;
+        bool                    immutableResource;      // registered in the immutable resource table
+        bool                    sharedResource;         // references an immutable resource another slot allocated
         uint32_t                srvDescIndex;
         uint32_t                uavDescIndex;
         uint32_t                uavDescCount;
@@ -130,18 +159,65 @@ typedef struct BackendContext_DX12 {
     ID3D12DescriptorHeap*   descHeapUavGpu;
 
     uint32_t                descRingBufferSize;
-    uint32_t                descRingBufferBase;
     ID3D12DescriptorHeap*   descRingBuffer;
     uint32_t                descBindlessBase;
 
+    FfxDescriptorRingStatisticsDX12 descriptorRingStatistics;
+
     uint8_t*                pStagingRingBuffer;
     uint32_t                stagingRingBufferBase = 0;
 
-    D3D12_RESOURCE_BARRIER  barriers[FFX_MAX_BARRIERS];
+    QueuedBarrier           barrierQueue[FFX_MAX_BARRIERS];
     uint32_t                barrierCount;
+    D3D12_RESOURCE_BARRIER  barriers[FFX_MAX_BARRIERS];
+    BarrierPlan             barrierPlan;
+    uint32_t                nextSplitBarrier;
+
+    // Set for the duration of ExecuteGpuJobsDX12 when barriers on that command list go through the Enhanced Barriers API
+    bool                            enhancedBarriersSupported;
+    ID3D12GraphicsCommandList*      barrierCommandList;
+#ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+    ID3D12GraphicsCommandList7*     enhancedBarrierCommandList;
+    D3D12_TEXTURE_BARRIER           textureBarriers[FFX_MAX_BARRIERS];
+    D3D12_BUFFER_BARRIER            bufferBarriers[FFX_MAX_BARRIERS];
+#endif // #ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+    FfxBarrierStatisticsDX12        barrierStatistics;
 
     IDXGIFactory*           dxgiFactory = nullptr;
 
+    // Root signatures and pipeline states are shared by all pipelines of the backend with the same serialized root signature,
+    // respectively root signature and shader. Each entry holds a reference for as long as a pipeline uses it, and what it was
+    // created from so a hash collision is never mistaken for a match.
+    typedef struct RootSignatureEntry {
+        uint64_t                hash;
+        ID3D12RootSignature*    rootSignature;
+        ID3DBlob*               serializedRootSignature;
+        uint32_t                useCount;
+    } RootSignatureEntry;
+    typedef struct PipelineStateEntry {
+        uint64_t                key;
+        ID3D12PipelineState*    pipelineState;
+        ID3D12RootSignature*    rootSignature;
+        const void*             shaderBytecode;     // permutation blobs are static data, so the bytecode outlives the entry
+        size_t                  shaderSize;
+        uint32_t                useCount;
+    } PipelineStateEntry;
+    RootSignatureEntry*     pRootSignatures;
+    uint32_t                rootSignatureCount;
+    PipelineStateEntry*     pPipelineStates;
+    uint32_t                pipelineStateCount;
+
+    // Survives the backend being torn down when the last effect context is destroyed, and ffxGetInterfaceDX12 being called
+    // again for the same device. It is owned by the application through ffxCreatePipelineLibraryDX12 / ffxDestroyPipelineLibraryDX12
+    typedef struct PipelineLibrary {
+        ID3D12PipelineLibrary*  library;
+        ID3D12Device*           device;             // the library was created for, referenced so no new device can take its address
+        void*                   pLibraryData;       // the library reads its initial data for as long as it lives
+        size_t                  libraryDataSize;
+    } PipelineLibrary;
+    PipelineLibrary                 pipelineLibrary;
+    FfxPipelineCacheStatisticsDX12  pipelineCacheStatistics;
+
     typedef struct alignas(32) EffectContext {
 
         // Effect identifier -- used for various resource callbacks to application
@@ -168,6 +244,9 @@ typedef struct BackendContext_DX12 {
         uint32_t bindlessBufferHeapStart;
         uint32_t bindlessBufferHeapEnd;
 
+        // Descriptor tables of compute dispatches, fenced by the frames ended with UnregisterResourcesDX12
+        DescriptorRing      descriptorRing;
+
         // Usage
         bool                active;
 
@@ -211,14 +290,31 @@ static uint32_t getFreeBindlessDescriptorBlock(BackendContext_DX12 *context, uin
     return base;
 }
 
+static void releasePipelineLibrary(BackendContext_DX12::PipelineLibrary& pipelineLibrary)
+{
+    if (pipelineLibrary.library)
+        pipelineLibrary.library->Release();
+    if (pipelineLibrary.device)
+        pipelineLibrary.device->Release();
+    free(pipelineLibrary.pLibraryData);
+
+    memset(&pipelineLibrary, 0, sizeof(pipelineLibrary));
+}
+
 FFX_API size_t ffxGetScratchMemorySizeDX12(size_t maxContexts)
 {
     uint32_t resourceArraySize          = FFX_ALIGN_UP(maxContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BackendContext_DX12::Resource), sizeof(uint64_t));
     uint32_t contextArraySize           = FFX_ALIGN_UP(maxContexts * sizeof(BackendContext_DX12::EffectContext), sizeof(uint32_t));
     uint32_t stagingRingBufferArraySize = FFX_ALIGN_UP(maxContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE, sizeof(uint32_t));
     uint32_t gpuJobDescArraySize        = FFX_ALIGN_UP(maxContexts * FFX_MAX_GPU_JOBS * sizeof(FfxGpuJobDescription), sizeof(uint32_t));
-
-    return FFX_ALIGN_UP(sizeof(BackendContext_DX12) + resourceArraySize + contextArraySize + stagingRingBufferArraySize + gpuJobDescArraySize, sizeof(uint64_t));
+    uint32_t rootSignatureArraySize     = FFX_ALIGN_UP(maxContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_DX12::RootSignatureEntry), sizeof(uint64_t));
+    uint32_t pipelineStateArraySize     = FFX_ALIGN_UP(maxContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_DX12::PipelineStateEntry), sizeof(uint64_t));
+    uint32_t barrierPlanArraySize       = FFX_ALIGN_UP(maxContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BarrierPlanResource), sizeof(uint64_t));
+    uint32_t splitBarrierArraySize      = FFX_ALIGN_UP(maxContexts * FFX_MAX_GPU_JOBS * sizeof(SplitBarrier), sizeof(uint64_t));
+
+    return FFX_ALIGN_UP(sizeof(BackendContext_DX12) + resourceArraySize + contextArraySize + stagingRingBufferArraySize + gpuJobDescArraySize +
+                            rootSignatureArraySize + pipelineStateArraySize + barrierPlanArraySize + splitBarrierArraySize,
+                        sizeof(uint64_t));
 }
 
 // Create a FfxDevice from a ID3D12Device*
@@ -288,8 +384,13 @@ FfxErrorCode ffxGetInterfaceDX12(
         !backendContext->refCount,
         FFX_ERROR_BACKEND_API_ERROR);
 
-    // Clear everything out
+    // Clear everything out except the pipeline library, which is released if the memory now serves another device
+    BackendContext_DX12::PipelineLibrary pipelineLibrary = backendContext->pipelineLibrary;
+    if (pipelineLibrary.library && pipelineLibrary.device != reinterpret_cast<ID3D12Device*>(device))
+        releasePipelineLibrary(pipelineLibrary);
+
     memset(backendContext, 0, sizeof(*backendContext));
+    backendContext->pipelineLibrary = pipelineLibrary;
 
     // Set the device
     backendInterface->device = device;
@@ -335,6 +436,154 @@ FfxResource ffxGetResourceDX12(const ID3D12Resource* dx12Resource,
     return resource;
 }
 
+FfxErrorCode ffxCreatePipelineLibraryDX12(FfxInterface* backendInterface, const void* pInitialData, size_t initialDataSize)
+{
+    FFX_RETURN_ON_ERROR(backendInterface, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pInitialData || !initialDataSize, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    BackendContext_DX12::PipelineLibrary& pipelineLibrary = backendContext->pipelineLibrary;
+    FFX_RETURN_ON_ERROR(!pipelineLibrary.library, FFX_ERROR_INVALID_ARGUMENT);
+
+    ID3D12Device* dx12Device = reinterpret_cast<ID3D12Device*>(backendInterface->device);
+    FFX_RETURN_ON_ERROR(dx12Device, FFX_ERROR_NULL_DEVICE);
+
+    ID3D12Device1* dx12Device1 = nullptr;
+    FFX_RETURN_ON_ERROR(SUCCEEDED(dx12Device->QueryInterface(IID_PPV_ARGS(&dx12Device1))), FFX_ERROR_BACKEND_API_ERROR);
+
+    memset(&pipelineLibrary, 0, sizeof(pipelineLibrary));
+    backendContext->pipelineCacheStatistics.initialDataRejected = false;
+
+    // the library keeps reading its initial data, so it gets a copy of its own
+    if (initialDataSize)
+    {
+        if (validatePipelineLibraryBlob(pInitialData, initialDataSize))
+        {
+            pipelineLibrary.libraryDataSize = initialDataSize - sizeof(PipelineLibraryBlobHeader);
+            pipelineLibrary.pLibraryData    = malloc(pipelineLibrary.libraryDataSize);
+            if (!pipelineLibrary.pLibraryData)
+            {
+                dx12Device1->Release();
+                memset(&pipelineLibrary, 0, sizeof(pipelineLibrary));
+                return FFX_ERROR_OUT_OF_MEMORY;
+            }
+            memcpy(pipelineLibrary.pLibraryData, (const uint8_t*)pInitialData + sizeof(PipelineLibraryBlobHeader), pipelineLibrary.libraryDataSize);
+        }
+        else
+        {
+            backendContext->pipelineCacheStatistics.initialDataRejected = true;
+        }
+    }
+
+    HRESULT result = dx12Device1->CreatePipelineLibrary(pipelineLibrary.pLibraryData, pipelineLibrary.libraryDataSize, IID_PPV_ARGS(&pipelineLibrary.library));
+    if (FAILED(result) && pipelineLibrary.pLibraryData)
+    {
+        // data for another adapter or driver (D3D12_ERROR_ADAPTER_NOT_FOUND, D3D12_ERROR_DRIVER_VERSION_MISMATCH), start out empty
+        free(pipelineLibrary.pLibraryData);
+        pipelineLibrary.pLibraryData    = nullptr;
+        pipelineLibrary.libraryDataSize = 0;
+        backendContext->pipelineCacheStatistics.initialDataRejected = true;
+        result = dx12Device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&pipelineLibrary.library));
+    }
+    dx12Device1->Release();
+
+    if (FAILED(result))
+    {
+        memset(&pipelineLibrary, 0, sizeof(pipelineLibrary));
+        return FFX_ERROR_BACKEND_API_ERROR;
+    }
+
+    pipelineLibrary.library->SetName(L"FFX_DX12_PipelineLibrary");
+    pipelineLibrary.device = dx12Device;
+    pipelineLibrary.device->AddRef();
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetPipelineLibraryDataDX12(FfxInterface* backendInterface, void* pData, size_t* pDataSize)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pDataSize, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    ID3D12PipelineLibrary* library = backendContext->pipelineLibrary.library;
+    FFX_RETURN_ON_ERROR(library, FFX_ERROR_INVALID_ARGUMENT);
+
+    const size_t libraryDataSize = library->GetSerializedSize();
+    const size_t blobSize        = sizeof(PipelineLibraryBlobHeader) + libraryDataSize;
+    if (!pData)
+    {
+        *pDataSize = blobSize;
+        return FFX_OK;
+    }
+    FFX_RETURN_ON_ERROR(*pDataSize >= blobSize, FFX_ERROR_INSUFFICIENT_MEMORY);
+
+    uint8_t* pLibraryData = (uint8_t*)pData + sizeof(PipelineLibraryBlobHeader);
+    FFX_RETURN_ON_ERROR(SUCCEEDED(library->Serialize(pLibraryData, libraryDataSize)), FFX_ERROR_BACKEND_API_ERROR);
+
+    const PipelineLibraryBlobHeader header = getPipelineLibraryBlobHeader(pLibraryData, libraryDataSize);
+    memcpy(pData, &header, sizeof(header));
+
+    *pDataSize = blobSize;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetPipelineCacheStatisticsDX12(FfxInterface* backendInterface, FfxPipelineCacheStatisticsDX12* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    *pStatistics = backendContext->pipelineCacheStatistics;
+    pStatistics->rootSignatureCount = backendContext->rootSignatureCount;
+    pStatistics->pipelineStateCount = backendContext->pipelineStateCount;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxDestroyPipelineLibraryDX12(FfxInterface* backendInterface)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    releasePipelineLibrary(backendContext->pipelineLibrary);
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetDescriptorRingStatisticsDX12(FfxInterface* backendInterface, FfxDescriptorRingStatisticsDX12* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    *pStatistics = backendContext->descriptorRingStatistics;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetBarrierStatisticsDX12(FfxInterface* backendInterface, FfxBarrierStatisticsDX12* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    *pStatistics = backendContext->barrierStatistics;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetImmutableResourceStatisticsDX12(FfxInterface* backendInterface, FfxImmutableResourceStatisticsDX12* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    const ImmutableResourceStatistics statistics = getImmutableResourceStatistics(backendContext->device);
+    pStatistics->liveResourceCount  = statistics.liveResourceCount;
+    pStatistics->createCount        = statistics.createCount;
+    pStatistics->shareCount         = statistics.shareCount;
+    pStatistics->uploadedBytes      = statistics.uploadedBytes;
+    pStatistics->skippedUploadBytes = statistics.skippedUploadBytes;
+    return FFX_OK;
+}
+
 FfxErrorCode ffxLoadPixDll(const wchar_t* pixDllPath)
 {
 #if defined(ENABLE_PIX_CAPTURES)
@@ -893,19 +1142,38 @@ void addBarrier(BackendContext_DX12* backendContext, FfxResourceInternal* resour
     FFX_ASSERT(NULL != backendContext);
     FFX_ASSERT(NULL != resource);
 
-    ID3D12Resource* dx12Resource = getDX12ResourcePtr(backendContext, resource->internalIndex);
-    D3D12_RESOURCE_BARRIER* barrier = &backendContext->barriers[backendContext->barrierCount];
+    BackendContext_DX12::Resource& backendResource = backendContext->pResources[resource->internalIndex];
+
+    // a transition the planner has begun early only needs to be ended
+    if (backendResource.splitBarrierPending)
+    {
+        FFX_ASSERT(backendContext->barrierCount < FFX_MAX_BARRIERS);
+        QueuedBarrier& barrier = backendContext->barrierQueue[backendContext->barrierCount++];
+        barrier.resourceIndex = resource->internalIndex;
+        barrier.stateBefore   = backendResource.currentState;
+        barrier.stateAfter    = backendResource.splitBarrierState;
+        barrier.type          = FFX_QUEUED_BARRIER_TRANSITION;
+        barrier.phase         = FFX_SPLIT_BARRIER_END;
+
+        backendResource.currentState        = backendResource.splitBarrierState;
+        backendResource.splitBarrierPending = false;
+
+        if ((backendResource.currentState & newState) == newState)
+            return;
+    }
 
     FFX_ASSERT(backendContext->barrierCount < FFX_MAX_BARRIERS);
+    QueuedBarrier* barrier = &backendContext->barrierQueue[backendContext->barrierCount];
 
-    FfxResourceStates* currentState = &backendContext->pResources[resource->internalIndex].currentState;
+    FfxResourceStates* currentState = &backendResource.currentState;
 
     if ((*currentState & newState) != newState) {
 
-        *barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-            dx12Resource,
-            ffxGetDX12StateFromResourceState(*currentState),
-            ffxGetDX12StateFromResourceState(newState));
+        barrier->resourceIndex = resource->internalIndex;
+        barrier->stateBefore   = *currentState;
+        barrier->stateAfter    = newState;
+        barrier->type          = FFX_QUEUED_BARRIER_TRANSITION;
+        barrier->phase         = FFX_SPLIT_BARRIER_NONE;
 
         *currentState = newState;
         ++backendContext->barrierCount;
@@ -913,11 +1181,178 @@ void addBarrier(BackendContext_DX12* backendContext, FfxResourceInternal* resour
     }
     else if (newState == FFX_RESOURCE_STATE_UNORDERED_ACCESS) {
 
-        *barrier = CD3DX12_RESOURCE_BARRIER::UAV(dx12Resource);
+        barrier->resourceIndex = resource->internalIndex;
+        barrier->stateBefore   = newState;
+        barrier->stateAfter    = newState;
+        barrier->type          = FFX_QUEUED_BARRIER_UAV;
+        barrier->phase         = FFX_SPLIT_BARRIER_NONE;
         ++backendContext->barrierCount;
     }
 }
 
+static void countQueuedBarrier(FfxBarrierStatisticsDX12& statistics, const QueuedBarrier& barrier)
+{
+    if (barrier.type == FFX_QUEUED_BARRIER_UAV)
+        ++statistics.uavBarrierCount;
+    else if (barrier.phase == FFX_SPLIT_BARRIER_NONE)
+        ++statistics.transitionBarrierCount;
+    else if (barrier.phase == FFX_SPLIT_BARRIER_BEGIN)
+        ++statistics.splitBarrierCount;
+}
+
+#ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+// The sync and access scopes and the texture layout of the work a resource state stands for
+static void getEnhancedBarrierScope(FfxResourceStates state, D3D12_BARRIER_SYNC& sync, D3D12_BARRIER_ACCESS& access, D3D12_BARRIER_LAYOUT& layout)
+{
+    sync   = D3D12_BARRIER_SYNC_NONE;
+    access = D3D12_BARRIER_ACCESS_COMMON;
+
+    if (state & FFX_RESOURCE_STATE_COMMON)
+        sync |= D3D12_BARRIER_SYNC_ALL;
+    if (state & FFX_RESOURCE_STATE_UNORDERED_ACCESS)
+    {
+        sync |= D3D12_BARRIER_SYNC_COMPUTE_SHADING | D3D12_BARRIER_SYNC_CLEAR_UNORDERED_ACCESS_VIEW;
+        access |= D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+    }
+    if (state & FFX_RESOURCE_STATE_COMPUTE_READ)
+    {
+        sync |= D3D12_BARRIER_SYNC_COMPUTE_SHADING;
+        access |= D3D12_BARRIER_ACCESS_SHADER_RESOURCE;
+    }
+    if (state & FFX_RESOURCE_STATE_PIXEL_READ)
+    {
+        sync |= D3D12_BARRIER_SYNC_PIXEL_SHADING;
+        access |= D3D12_BARRIER_ACCESS_SHADER_RESOURCE;
+    }
+    if (state & FFX_RESOURCE_STATE_COPY_SRC)
+    {
+        sync |= D3D12_BARRIER_SYNC_COPY;
+        access |= D3D12_BARRIER_ACCESS_COPY_SOURCE;
+    }
+    if (state & FFX_RESOURCE_STATE_COPY_DEST)
+    {
+        sync |= D3D12_BARRIER_SYNC_COPY;
+        access |= D3D12_BARRIER_ACCESS_COPY_DEST;
+    }
+    if (state & FFX_RESOURCE_STATE_INDIRECT_ARGUMENT)
+    {
+        sync |= D3D12_BARRIER_SYNC_EXECUTE_INDIRECT;
+        access |= D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT;
+    }
+    if (state & FFX_RESOURCE_STATE_PRESENT)
+        sync |= D3D12_BARRIER_SYNC_ALL;
+    if (state & FFX_RESOURCE_STATE_RENDER_TARGET)
+    {
+        sync |= D3D12_BARRIER_SYNC_RENDER_TARGET;
+        access |= D3D12_BARRIER_ACCESS_RENDER_TARGET;
+    }
+
+    switch (state)
+    {
+    case FFX_RESOURCE_STATE_UNORDERED_ACCESS:
+        layout = D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS;
+        break;
+    case FFX_RESOURCE_STATE_COMPUTE_READ:
+    case FFX_RESOURCE_STATE_PIXEL_READ:
+    case FFX_RESOURCE_STATE_PIXEL_COMPUTE_READ:
+        layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+        break;
+    case FFX_RESOURCE_STATE_COPY_SRC:
+        layout = D3D12_BARRIER_LAYOUT_COPY_SOURCE;
+        break;
+    case FFX_RESOURCE_STATE_COPY_DEST:
+        layout = D3D12_BARRIER_LAYOUT_COPY_DEST;
+        break;
+    case FFX_RESOURCE_STATE_PRESENT:
+        layout = D3D12_BARRIER_LAYOUT_PRESENT;
+        break;
+    case FFX_RESOURCE_STATE_RENDER_TARGET:
+        layout = D3D12_BARRIER_LAYOUT_RENDER_TARGET;
+        break;
+    case FFX_RESOURCE_STATE_COMMON:
+        layout = D3D12_BARRIER_LAYOUT_COMMON;
+        break;
+    default:
+        layout = D3D12_BARRIER_LAYOUT_GENERIC_READ;
+        break;
+    }
+}
+
+static void flushEnhancedBarriers(BackendContext_DX12* backendContext)
+{
+    uint32_t textureBarrierCount = 0;
+    uint32_t bufferBarrierCount  = 0;
+
+    for (uint32_t i = 0; i < backendContext->barrierCount; ++i)
+    {
+        const QueuedBarrier& barrier = backendContext->barrierQueue[i];
+
+        D3D12_BARRIER_SYNC   syncBefore, syncAfter;
+        D3D12_BARRIER_ACCESS accessBefore, accessAfter;
+        D3D12_BARRIER_LAYOUT layoutBefore, layoutAfter;
+        getEnhancedBarrierScope(barrier.stateBefore, syncBefore, accessBefore, layoutBefore);
+        getEnhancedBarrierScope(barrier.stateAfter, syncAfter, accessAfter, layoutAfter);
+
+        // the two halves of a split barrier are joined by the split sync scope
+        if (barrier.phase == FFX_SPLIT_BARRIER_BEGIN)
+            syncAfter = D3D12_BARRIER_SYNC_SPLIT;
+        else if (barrier.phase == FFX_SPLIT_BARRIER_END)
+            syncBefore = D3D12_BARRIER_SYNC_SPLIT;
+
+        ID3D12Resource* dx12Resource = getDX12ResourcePtr(backendContext, barrier.resourceIndex);
+        if (backendContext->pResources[barrier.resourceIndex].resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
+        {
+            D3D12_BUFFER_BARRIER& bufferBarrier = backendContext->bufferBarriers[bufferBarrierCount++];
+            bufferBarrier.SyncBefore   = syncBefore;
+            bufferBarrier.SyncAfter    = syncAfter;
+            bufferBarrier.AccessBefore = accessBefore;
+            bufferBarrier.AccessAfter  = accessAfter;
+            bufferBarrier.pResource    = dx12Resource;
+            bufferBarrier.Offset       = 0;
+            bufferBarrier.Size         = UINT64_MAX;
+        }
+        else
+        {
+            D3D12_TEXTURE_BARRIER& textureBarrier = backendContext->textureBarriers[textureBarrierCount++];
+            textureBarrier.SyncBefore   = syncBefore;
+            textureBarrier.SyncAfter    = syncAfter;
+            textureBarrier.AccessBefore = accessBefore;
+            textureBarrier.AccessAfter  = accessAfter;
+            textureBarrier.LayoutBefore = layoutBefore;
+            textureBarrier.LayoutAfter  = layoutAfter;
+            textureBarrier.pResource    = dx12Resource;
+            textureBarrier.Subresources.IndexOrFirstMipLevel = 0xffffffff;
+            textureBarrier.Subresources.NumMipLevels         = 0;
+            textureBarrier.Subresources.FirstArraySlice      = 0;
+            textureBarrier.Subresources.NumArraySlices       = 0;
+            textureBarrier.Subresources.FirstPlane           = 0;
+            textureBarrier.Subresources.NumPlanes            = 0;
+            textureBarrier.Flags        = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+        }
+
+        countQueuedBarrier(backendContext->barrierStatistics, barrier);
+    }
+
+    D3D12_BARRIER_GROUP barrierGroups[2];
+    uint32_t            barrierGroupCount = 0;
+    if (textureBarrierCount)
+    {
+        barrierGroups[barrierGroupCount].Type              = D3D12_BARRIER_TYPE_TEXTURE;
+        barrierGroups[barrierGroupCount].NumBarriers       = textureBarrierCount;
+        barrierGroups[barrierGroupCount++].pTextureBarriers = backendContext->textureBarriers;
+    }
+    if (bufferBarrierCount)
+    {
+        barrierGroups[barrierGroupCount].Type              = D3D12_BARRIER_TYPE_BUFFER;
+        barrierGroups[barrierGroupCount].NumBarriers       = bufferBarrierCount;
+        barrierGroups[barrierGroupCount++].pBufferBarriers = backendContext->bufferBarriers;
+    }
+
+    backendContext->enhancedBarrierCommandList->Barrier(barrierGroupCount, barrierGroups);
+    backendContext->barrierStatistics.enhancedBarrierCount += backendContext->barrierCount;
+}
+#endif // #ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+
 void flushBarriers(BackendContext_DX12* backendContext, ID3D12GraphicsCommandList* dx12CommandList)
 {
     FFX_ASSERT(NULL != backendContext);
@@ -925,6 +1360,43 @@ void flushBarriers(BackendContext_DX12* backendContext, ID3D12GraphicsCommandLis
 
     if (backendContext->barrierCount > 0) {
 
+#ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+        if (backendContext->enhancedBarrierCommandList && backendContext->barrierCommandList == dx12CommandList)
+        {
+            flushEnhancedBarriers(backendContext);
+            backendContext->barrierCount = 0;
+            return;
+        }
+#endif // #ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+
+        for (uint32_t i = 0; i < backendContext->barrierCount; ++i)
+        {
+            const QueuedBarrier& barrier      = backendContext->barrierQueue[i];
+            ID3D12Resource*      dx12Resource = getDX12ResourcePtr(backendContext, barrier.resourceIndex);
+
+            if (barrier.type == FFX_QUEUED_BARRIER_UAV)
+            {
+                backendContext->barriers[i] = CD3DX12_RESOURCE_BARRIER::UAV(dx12Resource);
+            }
+            else
+            {
+                D3D12_RESOURCE_BARRIER_FLAGS flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                if (barrier.phase == FFX_SPLIT_BARRIER_BEGIN)
+                    flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+                else if (barrier.phase == FFX_SPLIT_BARRIER_END)
+                    flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+
+                backendContext->barriers[i] = CD3DX12_RESOURCE_BARRIER::Transition(
+                    dx12Resource,
+                    ffxGetDX12StateFromResourceState(barrier.stateBefore),
+                    ffxGetDX12StateFromResourceState(barrier.stateAfter),
+                    D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+                    flags);
+            }
+
+            countQueuedBarrier(backendContext->barrierStatistics, barrier);
+        }
+
         dx12CommandList->ResourceBarrier(backendContext->barrierCount, backendContext->barriers);
         backendContext->barrierCount = 0;
     }
@@ -991,6 +1463,15 @@ FfxErrorCode CreateBackendContextDX12(FfxInterface* backendInterface, FfxEffect
 
             dx12Device->AddRef();
             backendContext->device = dx12Device;
+            retainImmutableResourceDevice(dx12Device);
+
+#ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+            D3D12_FEATURE_DATA_D3D12_OPTIONS12 d3d12Options12 = {};
+            backendContext->enhancedBarriersSupported =
+                SUCCEEDED(dx12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &d3d12Options12, sizeof(d3d12Options12))) &&
+                d3d12Options12.EnhancedBarriersSupported;
+#endif // #ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+            backendContext->barrierStatistics.enhancedBarriersSupported = backendContext->enhancedBarriersSupported;
         }
 
         // Map all of our pointers
@@ -998,9 +1479,37 @@ FfxErrorCode CreateBackendContextDX12(FfxInterface* backendInterface, FfxEffect
         uint32_t resourceArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BackendContext_DX12::Resource), sizeof(uint64_t));
         uint32_t stagingRingBufferArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE, sizeof(uint32_t));
         uint32_t contextArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * sizeof(BackendContext_DX12::EffectContext), sizeof(uint32_t));
+        uint32_t rootSignatureArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_DX12::RootSignatureEntry), sizeof(uint64_t));
+        uint32_t pipelineStateArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_DX12::PipelineStateEntry), sizeof(uint64_t));
+        uint32_t barrierPlanArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BarrierPlanResource), sizeof(uint64_t));
+        uint32_t splitBarrierArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_GPU_JOBS * sizeof(SplitBarrier), sizeof(uint64_t));
 
         uint8_t* pMem = (uint8_t*)((BackendContext_DX12*)(backendContext + 1));
 
+        // Map the root signature and pipeline state tables
+        backendContext->pRootSignatures = (BackendContext_DX12::RootSignatureEntry*)pMem;
+        memset(backendContext->pRootSignatures, 0, rootSignatureArraySize);
+        pMem += rootSignatureArraySize;
+        backendContext->rootSignatureCount = 0;
+
+        backendContext->pPipelineStates = (BackendContext_DX12::PipelineStateEntry*)pMem;
+        memset(backendContext->pPipelineStates, 0, pipelineStateArraySize);
+        pMem += pipelineStateArraySize;
+        backendContext->pipelineStateCount = 0;
+
+        // Map the barrier planner state
+        BarrierPlan& barrierPlan = backendContext->barrierPlan;
+        barrierPlan.pResources = (BarrierPlanResource*)pMem;
+        memset(barrierPlan.pResources, 0, barrierPlanArraySize);
+        pMem += barrierPlanArraySize;
+        barrierPlan.resourceCount = backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT;
+        barrierPlan.epoch = 0;
+
+        barrierPlan.pSplitBarriers = (SplitBarrier*)pMem;
+        pMem += splitBarrierArraySize;
+        barrierPlan.splitBarrierCount = 0;
+        barrierPlan.maxSplitBarriers = backendContext->maxEffectContexts * FFX_MAX_GPU_JOBS;
+
         // Map gpu job array
         backendContext->pGpuJobs = (FfxGpuJobDescription*)pMem;
         memset(backendContext->pGpuJobs, 0, gpuJobDescArraySize);
@@ -1037,7 +1546,6 @@ FfxErrorCode CreateBackendContextDX12(FfxInterface* backendInterface, FfxEffect
         // descriptor ring buffer
         descHeap.NumDescriptors            = FFX_RING_BUFFER_DESCRIPTOR_COUNT * backendContext->maxEffectContexts + FFX_MAX_STATIC_DESCRIPTOR_COUNT;
         backendContext->descRingBufferSize = descHeap.NumDescriptors;
-        backendContext->descRingBufferBase = 0;
         result = dx12Device->CreateDescriptorHeap(&descHeap, IID_PPV_ARGS(&backendContext->descRingBuffer));
 
         // RTV descriptor heap to raster jobs
@@ -1074,6 +1582,8 @@ FfxErrorCode CreateBackendContextDX12(FfxInterface* backendInterface, FfxEffect
             effectContext.nextStaticUavDescriptor = (i * FFX_MAX_RESOURCE_COUNT);
             effectContext.nextDynamicUavDescriptor = (i * FFX_MAX_RESOURCE_COUNT) + FFX_MAX_RESOURCE_COUNT - 1;
 
+            initDescriptorRing(effectContext.descriptorRing, i * FFX_RING_BUFFER_DESCRIPTOR_COUNT, FFX_DESCRIPTOR_RING_PARTITION_SIZE);
+
             if (bindlessConfig)
             {
                 uint32_t numDescriptors = bindlessConfig->maxTextureSrvs + bindlessConfig->maxBufferSrvs + bindlessConfig->maxTextureUavs + bindlessConfig->maxBufferUavs;
@@ -1257,6 +1767,17 @@ FfxErrorCode DestroyBackendContextDX12(FfxInterface* backendInterface, FfxUInt32
         backendContext->gpuJobCount             = 0;
         backendContext->barrierCount            = 0;
 
+        // pipelines should all be destroyed by now, drop the references of any that leaked
+        for (uint32_t i = 0; i < backendContext->rootSignatureCount; ++i)
+        {
+            backendContext->pRootSignatures[i].rootSignature->Release();
+            backendContext->pRootSignatures[i].serializedRootSignature->Release();
+        }
+        backendContext->rootSignatureCount = 0;
+        for (uint32_t i = 0; i < backendContext->pipelineStateCount; ++i)
+            backendContext->pPipelineStates[i].pipelineState->Release();
+        backendContext->pipelineStateCount = 0;
+
         // release heaps
         backendContext->descHeapRtvCpu->Release();
         backendContext->descHeapSrvCpu->Release();
@@ -1265,6 +1786,7 @@ FfxErrorCode DestroyBackendContextDX12(FfxInterface* backendInterface, FfxUInt32
         backendContext->descRingBuffer->Release();
 
         if (backendContext->device != NULL) {
+            releaseImmutableResourceDevice(backendContext->device);
             backendContext->device->Release();
             backendContext->device = NULL;
         }
@@ -1278,6 +1800,11 @@ FfxErrorCode DestroyBackendContextDX12(FfxInterface* backendInterface, FfxUInt32
     return FFX_OK;
 }
 
+static void addImmutableResourceReference(void* resource)
+{
+    reinterpret_cast<ID3D12Resource*>(resource)->AddRef();
+}
+
 // create a internal resource that will stay alive until effect gets shut down
 FfxErrorCode CreateResourceDX12(
     FfxInterface* backendInterface,
@@ -1297,6 +1824,9 @@ FfxErrorCode CreateResourceDX12(
     BackendContext_DX12::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
     ID3D12Device* dx12Device = backendContext->device;
 
+    // the slot may have held a resource the live tables of the frame refer to
+    invalidateDescriptorTables(effectContext.descriptorRing);
+
     uint64_t resourceSize = 0;
     FFX_ASSERT(NULL != dx12Device);
 
@@ -1326,6 +1856,11 @@ FfxErrorCode CreateResourceDX12(
 
     const auto& initData = createResourceDescription->initData;
 
+    // immutable resources created before by any effect context on this device are referenced instead of allocated and uploaded again
+    backendResource->immutableResource = false;
+    backendResource->sharedResource    = false;
+    const bool immutableResource = isImmutableResource(createResourceDescription);
+
     D3D12_RESOURCE_DESC dx12ResourceDescription = {};
     dx12ResourceDescription.Format              = DXGI_FORMAT_UNKNOWN;
     dx12ResourceDescription.Width               = 1;
@@ -1444,12 +1979,29 @@ FfxErrorCode CreateResourceDX12(
         // Buffers ignore any input state and create in common (but issue a warning)
         const D3D12_RESOURCE_STATES dx12ResourceStates = dx12ResourceDescription.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER ? D3D12_RESOURCE_STATE_COMMON : ffxGetDX12StateFromResourceState(resourceStates);
 
-        TIF(dx12Device->CreateCommittedResource(&dx12HeapProperties, D3D12_HEAP_FLAG_NONE, &dx12ResourceDescription, dx12ResourceStates, nullptr, IID_PPV_ARGS(&dx12Resource)));
-        resourceSize = GetResourceGpuMemorySizeDX12(dx12Resource);
-        backendResource->initialState = resourceStates;
-        backendResource->currentState = resourceStates;
+        if (immutableResource)
+            dx12Resource = reinterpret_cast<ID3D12Resource*>(acquireImmutableResource(dx12Device, createResourceDescription, addImmutableResourceReference));
 
-        dx12Resource->SetName(createResourceDescription->name);
+        if (dx12Resource)
+        {
+            // the slot that allocated the resource leaves it readable by any shader once uploaded
+            backendResource->immutableResource = true;
+            backendResource->sharedResource    = true;
+            backendResource->initialState      = FFX_RESOURCE_STATE_PIXEL_COMPUTE_READ;
+            backendResource->currentState      = FFX_RESOURCE_STATE_PIXEL_COMPUTE_READ;
+        }
+        else
+        {
+            TIF(dx12Device->CreateCommittedResource(&dx12HeapProperties, D3D12_HEAP_FLAG_NONE, &dx12ResourceDescription, dx12ResourceStates, nullptr, IID_PPV_ARGS(&dx12Resource)));
+            resourceSize = GetResourceGpuMemorySizeDX12(dx12Resource);
+            backendResource->initialState = resourceStates;
+            backendResource->currentState = resourceStates;
+
+            dx12Resource->SetName(createResourceDescription->name);
+
+            if (immutableResource)
+                backendResource->immutableResource = addImmutableResource(dx12Device, createResourceDescription, dx12Resource);
+        }
         backendResource->resourcePtr = dx12Resource;
 
 #ifdef _DEBUG
@@ -1616,7 +2168,7 @@ FfxErrorCode CreateResourceDX12(
         }
 
         // create upload resource and upload job
-        if (initData.type != FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED) {
+        if (initData.type != FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED && !backendResource->sharedResource) {
 
             FfxResourceInternal copySrc;
             FfxCreateResourceDescription uploadDescription = { *createResourceDescription };
@@ -1635,6 +2187,14 @@ FfxErrorCode CreateResourceDX12(
             copyJob.copyJobDescriptor.size      = 0;
 
             backendInterface->fpScheduleGpuJob(backendInterface, &copyJob);
+
+            // leave shared resources in the state the slots referencing them start in
+            if (backendResource->immutableResource)
+            {
+                FfxGpuJobDescription barrierJob = { FFX_GPU_JOB_BARRIER };
+                barrierJob.barrierDescriptor = { *outTexture, FFX_BARRIER_TYPE_TRANSITION, FFX_RESOURCE_STATE_COPY_DEST, FFX_RESOURCE_STATE_PIXEL_COMPUTE_READ, 0 };
+                backendInterface->fpScheduleGpuJob(backendInterface, &barrierJob);
+            }
         }
     }
     
@@ -1661,7 +2221,15 @@ FfxErrorCode DestroyResourceDX12(
 
 		if (dx12Resource) {
 
-            uint64_t resourceSize = GetResourceGpuMemorySizeDX12(dx12Resource);
+            BackendContext_DX12::Resource& backendResource = backendContext->pResources[resource.internalIndex];
+
+            // only the slot that allocated a shared resource accounts for its memory
+            uint64_t resourceSize = backendResource.sharedResource ? 0 : GetResourceGpuMemorySizeDX12(dx12Resource);
+
+            if (backendResource.immutableResource)
+                releaseImmutableResource(backendContext->device, dx12Resource);
+            backendResource.immutableResource = false;
+            backendResource.sharedResource    = false;
 
 			dx12Resource->Release();
 
@@ -1765,6 +2333,9 @@ FfxErrorCode RegisterResourceDX12(
     FFX_ASSERT(effectContext.nextDynamicResource > effectContext.nextStaticResource);
     outFfxResourceInternal->internalIndex = effectContext.nextDynamicResource--;
 
+    // the descriptors written below may replace ones the live tables of the frame were copied from
+    invalidateDescriptorTables(effectContext.descriptorRing);
+
     BackendContext_DX12::Resource* backendResource = &backendContext->pResources[outFfxResourceInternal->internalIndex];
     backendResource->resourcePtr = dx12Resource;
     backendResource->initialState = state;
@@ -2029,6 +2600,9 @@ FfxErrorCode UnregisterResourcesDX12(FfxInterface* backendInterface, FfxCommandL
     effectContext.nextDynamicResource      = (effectContextId * FFX_MAX_RESOURCE_COUNT) + FFX_MAX_RESOURCE_COUNT - 1;
     effectContext.nextDynamicUavDescriptor = (effectContextId * FFX_MAX_RESOURCE_COUNT) + FFX_MAX_RESOURCE_COUNT - 1;
 
+    // the command list of this frame is recorded, its descriptor tables stay live until the frame comes round again
+    advanceDescriptorRingFrame(effectContext.descriptorRing);
+
     return FFX_OK;
 }
 
@@ -2379,6 +2953,144 @@ D3D12_TEXTURE_ADDRESS_MODE FfxGetAddressModeDX12(const FfxAddressMode& addressMo
     }
 }
 
+// Get the root signature for a serialized description, creating it only if no other pipeline uses the same one
+static FfxErrorCode acquireRootSignature(BackendContext_DX12* backendContext, ID3DBlob* serializedRootSignature, uint64_t* outHash, ID3D12RootSignature** outRootSignature)
+{
+    FfxPipelineCacheStatisticsDX12& statistics = backendContext->pipelineCacheStatistics;
+    const uint64_t hash = getRootSignatureHash(serializedRootSignature->GetBufferPointer(), serializedRootSignature->GetBufferSize());
+    *outHash = hash;
+
+    for (uint32_t i = 0; i < backendContext->rootSignatureCount; ++i)
+    {
+        BackendContext_DX12::RootSignatureEntry& entry = backendContext->pRootSignatures[i];
+        if (entry.hash == hash && entry.serializedRootSignature->GetBufferSize() == serializedRootSignature->GetBufferSize() &&
+            memcmp(entry.serializedRootSignature->GetBufferPointer(), serializedRootSignature->GetBufferPointer(), serializedRootSignature->GetBufferSize()) == 0)
+        {
+            entry.rootSignature->AddRef();
+            ++entry.useCount;
+            ++statistics.rootSignatureHitCount;
+            *outRootSignature = entry.rootSignature;
+            return FFX_OK;
+        }
+    }
+
+    ID3D12RootSignature* rootSignature = nullptr;
+    if (FAILED(backendContext->device->CreateRootSignature(0, serializedRootSignature->GetBufferPointer(), serializedRootSignature->GetBufferSize(), IID_PPV_ARGS(&rootSignature))))
+        return FFX_ERROR_BACKEND_API_ERROR;
+    ++statistics.rootSignatureCreateCount;
+
+    // when the table is full the root signature is simply not shared
+    if (backendContext->rootSignatureCount < backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT)
+    {
+        rootSignature->AddRef();
+        serializedRootSignature->AddRef();
+        backendContext->pRootSignatures[backendContext->rootSignatureCount++] = { hash, rootSignature, serializedRootSignature, 1 };
+    }
+
+    *outRootSignature = rootSignature;
+    return FFX_OK;
+}
+
+static void releaseRootSignature(BackendContext_DX12* backendContext, ID3D12RootSignature* rootSignature)
+{
+    for (uint32_t i = 0; i < backendContext->rootSignatureCount; ++i)
+    {
+        BackendContext_DX12::RootSignatureEntry& entry = backendContext->pRootSignatures[i];
+        if (entry.rootSignature == rootSignature)
+        {
+            if (--entry.useCount == 0)
+            {
+                entry.rootSignature->Release();
+                entry.serializedRootSignature->Release();
+                entry = backendContext->pRootSignatures[--backendContext->rootSignatureCount];
+            }
+            break;
+        }
+    }
+    rootSignature->Release();
+}
+
+// Get the pipeline state for a root signature and shader, from another pipeline or the pipeline library when possible
+static FfxErrorCode acquirePipelineState(BackendContext_DX12*                     backendContext,
+                                         uint64_t                                 key,
+                                         const D3D12_COMPUTE_PIPELINE_STATE_DESC& pipelineStateDescription,
+                                         const wchar_t*                           name,
+                                         ID3D12PipelineState**                    outPipelineState)
+{
+    FfxPipelineCacheStatisticsDX12& statistics = backendContext->pipelineCacheStatistics;
+    for (uint32_t i = 0; i < backendContext->pipelineStateCount; ++i)
+    {
+        BackendContext_DX12::PipelineStateEntry& entry = backendContext->pPipelineStates[i];
+        if (entry.key == key && entry.rootSignature == pipelineStateDescription.pRootSignature &&
+            entry.shaderSize == pipelineStateDescription.CS.BytecodeLength &&
+            (entry.shaderBytecode == pipelineStateDescription.CS.pShaderBytecode ||
+             memcmp(entry.shaderBytecode, pipelineStateDescription.CS.pShaderBytecode, entry.shaderSize) == 0))
+        {
+            entry.pipelineState->AddRef();
+            ++entry.useCount;
+            ++statistics.pipelineStateHitCount;
+            *outPipelineState = entry.pipelineState;
+            return FFX_OK;
+        }
+    }
+
+    ID3D12PipelineState*   pipelineState = nullptr;
+    ID3D12PipelineLibrary* library       = backendContext->pipelineLibrary.library;
+    wchar_t                libraryName[FFX_PIPELINE_LIBRARY_NAME_LENGTH];
+    if (library)
+    {
+        // the runtime checks the description against the stored pipeline, so a name shared by two keys only misses
+        getPipelineLibraryName(key, libraryName);
+        if (SUCCEEDED(library->LoadComputePipeline(libraryName, &pipelineStateDescription, IID_PPV_ARGS(&pipelineState))))
+            ++statistics.libraryHitCount;
+        else
+            pipelineState = nullptr;
+    }
+
+    if (!pipelineState)
+    {
+        if (FAILED(backendContext->device->CreateComputePipelineState(&pipelineStateDescription, IID_PPV_ARGS(&pipelineState))))
+            return FFX_ERROR_BACKEND_API_ERROR;
+        ++statistics.pipelineStateCreateCount;
+
+        // a failure to store only means the next run compiles it again
+        if (library)
+            library->StorePipeline(libraryName, pipelineState);
+    }
+
+    // Set the pipeline name
+    pipelineState->SetName(name);
+
+    // when the table is full the pipeline state is simply not shared
+    if (backendContext->pipelineStateCount < backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT)
+    {
+        pipelineState->AddRef();
+        backendContext->pPipelineStates[backendContext->pipelineStateCount++] = {
+            key, pipelineState, pipelineStateDescription.pRootSignature, pipelineStateDescription.CS.pShaderBytecode, pipelineStateDescription.CS.BytecodeLength, 1 };
+    }
+
+    *outPipelineState = pipelineState;
+    return FFX_OK;
+}
+
+static void releasePipelineState(BackendContext_DX12* backendContext, ID3D12PipelineState* pipelineState)
+{
+    for (uint32_t i = 0; i < backendContext->pipelineStateCount; ++i)
+    {
+        BackendContext_DX12::PipelineStateEntry& entry = backendContext->pPipelineStates[i];
+        if (entry.pipelineState == pipelineState)
+        {
+            if (--entry.useCount == 0)
+            {
+                entry.pipelineState->Release();
+                entry = backendContext->pPipelineStates[--backendContext->pipelineStateCount];
+            }
+            break;
+        }
+    }
+    pipelineState->Release();
+}
+
 FfxErrorCode CreatePipelineDX12(
     FfxInterface* backendInterface,
     FfxEffect effect,
@@ -2409,8 +3121,8 @@ FfxErrorCode CreatePipelineDX12(
     int32_t staticBufferUavSpace  = -1;
 
     // set up root signature
-    // easiest implementation: simply create one root signature per pipeline
-    // should add some management later on to avoid unnecessarily re-binding the root signature
+    // pipelines whose serialized root signature is identical share a single one
+    uint64_t rootSignatureHash = 0;
     {
         FFX_ASSERT(pipelineDescription->samplerCount <= FFX_MAX_SAMPLERS);
         const size_t samplerCount = pipelineDescription->samplerCount;
@@ -2726,14 +3438,14 @@ FfxErrorCode CreatePipelineDX12(
                     return FFX_ERROR_BACKEND_API_ERROR;
                 }
 
-                result = dx12Device->CreateRootSignature(0, outBlob->GetBufferPointer(), outBlob->GetBufferSize(), IID_PPV_ARGS(reinterpret_cast<ID3D12RootSignature**>(&outPipeline->rootSignature)));
+                FfxErrorCode errorCode = acquireRootSignature(backendContext, outBlob, &rootSignatureHash, reinterpret_cast<ID3D12RootSignature**>(&outPipeline->rootSignature));
                 if (outBlob != nullptr) {
                     
                     outBlob->Release();
                 }  
-                if (FAILED(result)) {
+                if (errorCode != FFX_OK) {
 
-                    return FFX_ERROR_BACKEND_API_ERROR;
+                    return errorCode;
                 }
             } else {
                 return FFX_ERROR_BACKEND_API_ERROR;
@@ -2925,11 +3637,11 @@ FfxErrorCode CreatePipelineDX12(
     dx12PipelineStateDescription.CS.pShaderBytecode = shaderBlob.data;
     dx12PipelineStateDescription.CS.BytecodeLength = shaderBlob.size;
 
-    if (FAILED(dx12Device->CreateComputePipelineState(&dx12PipelineStateDescription, IID_PPV_ARGS(reinterpret_cast<ID3D12PipelineState**>(&outPipeline->pipeline)))))
-        return FFX_ERROR_BACKEND_API_ERROR;
+    const uint64_t pipelineKey = getPipelineStateKey(rootSignatureHash, shaderBlob.data, shaderBlob.size);
+    FfxErrorCode errorCode = acquirePipelineState(backendContext, pipelineKey, dx12PipelineStateDescription, pipelineDescription->name, reinterpret_cast<ID3D12PipelineState**>(&outPipeline->pipeline));
+    if (errorCode != FFX_OK)
+        return errorCode;
 
-    // Set the pipeline name
-    reinterpret_cast<ID3D12PipelineState*>(outPipeline->pipeline)->SetName(pipelineDescription->name);
     wcscpy_s(outPipeline->name, pipelineDescription->name);
 
     return FFX_OK;
@@ -2945,10 +3657,12 @@ FfxErrorCode DestroyPipelineDX12(
         return FFX_OK;
     }
 
-    // destroy Rootsignature
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+
+    // destroy Rootsignature, the shared one goes once no pipeline uses it anymore
     ID3D12RootSignature* dx12RootSignature = reinterpret_cast<ID3D12RootSignature*>(pipeline->rootSignature);
     if (dx12RootSignature) {
-        dx12RootSignature->Release();
+        releaseRootSignature(backendContext, dx12RootSignature);
     }
     pipeline->rootSignature = nullptr;
 
@@ -2962,7 +3676,7 @@ FfxErrorCode DestroyPipelineDX12(
     // destroy pipeline
     ID3D12PipelineState* dx12Pipeline = reinterpret_cast<ID3D12PipelineState*>(pipeline->pipeline);
     if (dx12Pipeline) {
-        dx12Pipeline->Release();
+        releasePipelineState(backendContext, dx12Pipeline);
     }
     pipeline->pipeline = nullptr;
 
@@ -2987,6 +3701,103 @@ FfxErrorCode ScheduleGpuJobDX12(
     return FFX_OK;
 }
 
+// Get the heap offset of a descriptor table, writing it only if no identical table is live in the ring of the effect context
+static uint32_t writeDescriptorTable(BackendContext_DX12* backendContext, FfxUInt32 effectContextId, DescriptorTableType tableType, const DescriptorTable& table)
+{
+    FfxDescriptorRingStatisticsDX12& statistics = backendContext->descriptorRingStatistics;
+    const DescriptorTableAllocation  allocation = allocateDescriptorTable(backendContext->pEffectContexts[effectContextId].descriptorRing, tableType, table);
+    if (allocation.reused)
+    {
+        ++statistics.reusedTableCount;
+        return allocation.base;
+    }
+    if (allocation.wrapped)
+    {
+        FFX_ASSERT_MESSAGE(false, "The descriptor tables of a frame exceed the ring partition of the effect context");
+        ++statistics.wrappedTableCount;
+    }
+
+    const uint32_t tableBase = allocation.base;
+
+    ID3D12Device*        dx12Device      = backendContext->device;
+    const UINT           descriptorSize  = dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    ID3D12DescriptorHeap* srcHeap        = tableType == FFX_DESCRIPTOR_TABLE_UAV ? backendContext->descHeapUavCpu : backendContext->descHeapSrvCpu;
+    const D3D12_CPU_DESCRIPTOR_HANDLE srcHeapStart = srcHeap->GetCPUDescriptorHandleForHeapStart();
+    D3D12_CPU_DESCRIPTOR_HANDLE tableStart = backendContext->descRingBuffer->GetCPUDescriptorHandleForHeapStart();
+    tableStart.ptr += tableBase * descriptorSize;
+
+    // copy the descriptors of textures and static buffer views in one call
+    DescriptorCopyRanges ranges;
+    buildDescriptorCopyRanges(table, ranges);
+    if (ranges.dstRangeCount)
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE dstRangeStarts[FFX_MAX_DESCRIPTOR_TABLE_ENTRIES];
+        D3D12_CPU_DESCRIPTOR_HANDLE srcRangeStarts[FFX_MAX_DESCRIPTOR_TABLE_ENTRIES];
+        UINT                        copiedCount = 0;
+        for (uint32_t range = 0; range < ranges.dstRangeCount; ++range)
+        {
+            dstRangeStarts[range].ptr = tableStart.ptr + ranges.dstRangeStarts[range] * descriptorSize;
+            copiedCount += ranges.dstRangeSizes[range];
+        }
+        for (uint32_t range = 0; range < ranges.srcRangeCount; ++range)
+            srcRangeStarts[range].ptr = srcHeapStart.ptr + ranges.srcRangeStarts[range] * descriptorSize;
+
+        dx12Device->CopyDescriptors(ranges.dstRangeCount, dstRangeStarts, ranges.dstRangeSizes,
+                                    ranges.srcRangeCount, srcRangeStarts, ranges.srcRangeSizes,
+                                    D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        ++statistics.copyCallCount;
+        statistics.copiedDescriptorCount += copiedCount;
+    }
+
+    // buffers bound with a size get a dynamic descriptor created directly on the GPU heap
+    for (uint32_t i = 0; i < table.entryCount; ++i)
+    {
+        const DescriptorTableEntry& entry = table.entries[i];
+        if (entry.size == 0)
+            continue;
+
+        ID3D12Resource* buffer = getDX12ResourcePtr(backendContext, entry.source);
+        FFX_ASSERT(buffer != NULL);
+
+        D3D12_CPU_DESCRIPTOR_HANDLE cpuView = tableStart;
+        cpuView.ptr += entry.slot * descriptorSize;
+
+        bool     isStructured = entry.stride > 0;
+        uint32_t stride       = isStructured ? entry.stride : sizeof(uint32_t);
+
+        if (tableType == FFX_DESCRIPTOR_TABLE_UAV)
+        {
+            D3D12_UNORDERED_ACCESS_VIEW_DESC dx12UavDescription = {};
+            dx12UavDescription.Format                      = isStructured ? DXGI_FORMAT_UNKNOWN : DXGI_FORMAT_R32_TYPELESS;
+            dx12UavDescription.ViewDimension               = D3D12_UAV_DIMENSION_BUFFER;
+            dx12UavDescription.Buffer.FirstElement         = entry.offset / stride;
+            dx12UavDescription.Buffer.NumElements          = entry.size / stride;
+            dx12UavDescription.Buffer.StructureByteStride  = isStructured ? stride : 0;
+            dx12UavDescription.Buffer.CounterOffsetInBytes = 0;
+            dx12UavDescription.Buffer.Flags                = isStructured ? D3D12_BUFFER_UAV_FLAG_NONE : D3D12_BUFFER_UAV_FLAG_RAW;
+
+            dx12Device->CreateUnorderedAccessView(buffer, 0, &dx12UavDescription, cpuView);
+        }
+        else
+        {
+            D3D12_SHADER_RESOURCE_VIEW_DESC dx12SrvDescription = {};
+            dx12SrvDescription.Format                     = isStructured ? DXGI_FORMAT_UNKNOWN : DXGI_FORMAT_R32_TYPELESS;
+            dx12SrvDescription.ViewDimension              = D3D12_SRV_DIMENSION_BUFFER;
+            dx12SrvDescription.Buffer.FirstElement        = entry.offset / stride;
+            dx12SrvDescription.Buffer.NumElements         = entry.size / stride;
+            dx12SrvDescription.Buffer.StructureByteStride = isStructured ? stride : 0;
+            dx12SrvDescription.Buffer.Flags               = isStructured ? D3D12_BUFFER_SRV_FLAG_NONE : D3D12_BUFFER_SRV_FLAG_RAW;
+            dx12SrvDescription.Shader4ComponentMapping    = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+
+            dx12Device->CreateShaderResourceView(buffer, &dx12SrvDescription, cpuView);
+        }
+        ++statistics.createdViewCount;
+    }
+
+    ++statistics.writtenTableCount;
+    return tableBase;
+}
+
 static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendContext,
                                          FfxGpuJobDescription*      job,
                                          ID3D12GraphicsCommandList* dx12CommandList,
@@ -3005,6 +3816,8 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
     dx12CommandList->SetDescriptorHeaps(1, &dx12DescriptorHeap);
 
     uint32_t descriptorTableIndex = 0;
+    const UINT descriptorSize = dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    DescriptorTable descriptorTable;
 
     // bind texture & buffer UAVs (note the binding order here MUST match the root signature mapping order from CreatePipeline!)
     {
@@ -3023,7 +3836,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
         for (uint32_t uavBufferBinding = 0; uavBufferBinding < job->computeJobDescriptor.pipeline.uavBufferCount; uavBufferBinding++)
         {
             uint32_t slotIndex = job->computeJobDescriptor.pipeline.uavBufferBindings[uavBufferBinding].slotIndex +
-                                 job->computeJobDescriptor.pipeline.uavTextureBindings[uavBufferBinding].arrayIndex;
+                                 job->computeJobDescriptor.pipeline.uavBufferBindings[uavBufferBinding].arrayIndex;
 
             if (slotIndex > maximumUavIndex)
                 maximumUavIndex = slotIndex;
@@ -3031,12 +3844,8 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
 
         if (maximumUavIndex)
         {
-            // check if this fits into the ringbuffer, loop if not fitting
-            if (backendContext->descRingBufferBase + maximumUavIndex + 1 > FFX_RING_BUFFER_DESCRIPTOR_COUNT * backendContext->maxEffectContexts)
-                backendContext->descRingBufferBase = 0;
-
-            D3D12_GPU_DESCRIPTOR_HANDLE gpuView = dx12DescriptorHeap->GetGPUDescriptorHandleForHeapStart();
-            gpuView.ptr += backendContext->descRingBufferBase * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+            resetDescriptorTable(descriptorTable);
+            descriptorTable.slotCount = maximumUavIndex + 1;
 
             // Set Texture UAVs
             for (uint32_t currentPipelineUavIndex = 0; currentPipelineUavIndex < job->computeJobDescriptor.pipeline.uavTextureCount; ++currentPipelineUavIndex) {
@@ -3050,17 +3859,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
                 const uint32_t uavIndex = backendContext->pResources[resourceIndex].uavDescIndex + job->computeJobDescriptor.uavTextures[currentPipelineUavIndex].mip;
 
                 // where to bind it
-                const uint32_t currentUavResourceIndex = binding.slotIndex + binding.arrayIndex;
-
-                D3D12_CPU_DESCRIPTOR_HANDLE srcHandle = backendContext->descHeapUavCpu->GetCPUDescriptorHandleForHeapStart();
-                srcHandle.ptr += uavIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                D3D12_CPU_DESCRIPTOR_HANDLE cpuView = dx12DescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-                cpuView.ptr += backendContext->descRingBufferBase * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                cpuView.ptr += currentUavResourceIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                // Copy descriptor
-                dx12Device->CopyDescriptorsSimple(1, cpuView, srcHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                addDescriptorTableEntry(descriptorTable, binding.slotIndex + binding.arrayIndex, uavIndex);
             }
 
             // Set Buffer UAVs
@@ -3073,51 +3872,17 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
                 addBarrier(backendContext, &job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
                 const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.uavBufferBindings[currentPipelineUavIndex];
+                const FfxBufferUAV&      buffer  = job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex];
 
-                // where to bind it
-                const uint32_t currentUavResourceIndex = binding.slotIndex + binding.arrayIndex;
-
-                D3D12_CPU_DESCRIPTOR_HANDLE cpuView = dx12DescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-                cpuView.ptr += backendContext->descRingBufferBase * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                cpuView.ptr += currentUavResourceIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                if (job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].size > 0)
-                {
-                    // if size is non-zero create a dynamic descriptor directly on the GPU heap
-                    ID3D12Resource* buffer = getDX12ResourcePtr(backendContext, job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].resource.internalIndex);
-                    FFX_ASSERT(buffer != NULL);
-
-                    D3D12_UNORDERED_ACCESS_VIEW_DESC dx12UavDescription = {};
-
-                    bool     isStructured = job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].stride > 0;
-                    uint32_t stride       = isStructured ? job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].stride : sizeof(uint32_t);
-
-                    dx12UavDescription.Format                      = isStructured ? DXGI_FORMAT_UNKNOWN : DXGI_FORMAT_R32_TYPELESS;
-                    dx12UavDescription.ViewDimension               = D3D12_UAV_DIMENSION_BUFFER;
-                    dx12UavDescription.Buffer.FirstElement         = job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].offset / stride;
-                    dx12UavDescription.Buffer.NumElements          = job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].size / stride;
-                    dx12UavDescription.Buffer.StructureByteStride  = isStructured ? stride : 0;
-                    dx12UavDescription.Buffer.CounterOffsetInBytes = 0;
-                    dx12UavDescription.Buffer.Flags                = isStructured ? D3D12_BUFFER_UAV_FLAG_NONE : D3D12_BUFFER_UAV_FLAG_RAW;
-
-                    dx12Device->CreateUnorderedAccessView(buffer, 0, &dx12UavDescription, cpuView);
-                }
+                // if size is non-zero a dynamic descriptor is created, otherwise the static descriptor is copied from the CPU heap
+                if (buffer.size > 0)
+                    addDescriptorTableEntry(descriptorTable, binding.slotIndex + binding.arrayIndex, buffer.resource.internalIndex, buffer.offset, buffer.size, buffer.stride);
                 else
-                {
-                    // if size is zero assume it is a static descriptor and copy it from the CPU heap
-                    const uint32_t resourceIndex = job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].resource.internalIndex;
-          
-                    const uint32_t uavIndex  = backendContext->pResources[resourceIndex].uavDescIndex;
-
-                    D3D12_CPU_DESCRIPTOR_HANDLE srcHandle = backendContext->descHeapUavCpu->GetCPUDescriptorHandleForHeapStart();
-                    srcHandle.ptr += uavIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                    // Copy descriptor
-                    dx12Device->CopyDescriptorsSimple(1, cpuView, srcHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                }
+                    addDescriptorTableEntry(descriptorTable, binding.slotIndex + binding.arrayIndex, backendContext->pResources[buffer.resource.internalIndex].uavDescIndex);
             }
 
-            backendContext->descRingBufferBase += maximumUavIndex + 1;
+            D3D12_GPU_DESCRIPTOR_HANDLE gpuView = dx12DescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+            gpuView.ptr += writeDescriptorTable(backendContext, effectContextId, FFX_DESCRIPTOR_TABLE_UAV, descriptorTable) * descriptorSize;
             dx12CommandList->SetComputeRootDescriptorTable(descriptorTableIndex++, gpuView);
         }
     }
@@ -3139,7 +3904,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
         for (uint32_t srvBufferBinding = 0; srvBufferBinding < job->computeJobDescriptor.pipeline.srvBufferCount; srvBufferBinding++)
         {
             uint32_t slotIndex = job->computeJobDescriptor.pipeline.srvBufferBindings[srvBufferBinding].slotIndex +
-                                 job->computeJobDescriptor.pipeline.srvTextureBindings[srvBufferBinding].arrayIndex;
+                                 job->computeJobDescriptor.pipeline.srvBufferBindings[srvBufferBinding].arrayIndex;
 
             if (slotIndex > maximumSrvIndex)
                 maximumSrvIndex = slotIndex;
@@ -3147,14 +3912,8 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
 
         if (maximumSrvIndex)
         {
-            // check if this fits into the ringbuffer, loop if not fitting
-            if (backendContext->descRingBufferBase + maximumSrvIndex + 1 > FFX_RING_BUFFER_DESCRIPTOR_COUNT * backendContext->maxEffectContexts)
-            {
-                backendContext->descRingBufferBase = 0;
-            }
-
-            D3D12_GPU_DESCRIPTOR_HANDLE gpuView = dx12DescriptorHeap->GetGPUDescriptorHandleForHeapStart();
-            gpuView.ptr += backendContext->descRingBufferBase * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+            resetDescriptorTable(descriptorTable);
+            descriptorTable.slotCount = maximumSrvIndex + 1;
 
             for (uint32_t currentPipelineSrvIndex = 0; currentPipelineSrvIndex < job->computeJobDescriptor.pipeline.srvTextureCount; ++currentPipelineSrvIndex)
             {
@@ -3165,19 +3924,9 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
 
                 const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.srvTextureBindings[currentPipelineSrvIndex];
 
-                // source: SRV of resource to bind
-                const uint32_t              resourceIndex = job->computeJobDescriptor.srvTextures[currentPipelineSrvIndex].resource.internalIndex;
-                D3D12_CPU_DESCRIPTOR_HANDLE srcHandle     = backendContext->descHeapSrvCpu->GetCPUDescriptorHandleForHeapStart();
-                srcHandle.ptr += resourceIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                // Where to bind it
-                uint32_t currentSrvResourceIndex = binding.slotIndex + binding.arrayIndex;
-
-                D3D12_CPU_DESCRIPTOR_HANDLE cpuView = dx12DescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-                cpuView.ptr += backendContext->descRingBufferBase * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                cpuView.ptr += currentSrvResourceIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                dx12Device->CopyDescriptorsSimple(1, cpuView, srcHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                // source: SRV of resource to bind, where to bind it
+                const uint32_t resourceIndex = job->computeJobDescriptor.srvTextures[currentPipelineSrvIndex].resource.internalIndex;
+                addDescriptorTableEntry(descriptorTable, binding.slotIndex + binding.arrayIndex, resourceIndex);
             }
 
             // Set Buffer SRVs
@@ -3190,49 +3939,17 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_DX12*       backendConte
                 addBarrier(backendContext, &job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].resource, FFX_RESOURCE_STATE_COMPUTE_READ);
 
                 const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.srvBufferBindings[currentPipelineSrvIndex];
+                const FfxBufferSRV&      buffer  = job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex];
 
-                // where to bind it
-                const uint32_t currentSrvResourceIndex = binding.slotIndex + binding.arrayIndex;
-
-                D3D12_CPU_DESCRIPTOR_HANDLE cpuView = dx12DescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-                cpuView.ptr += backendContext->descRingBufferBase * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                cpuView.ptr += currentSrvResourceIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                if (job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].size > 0)
-                {
-                    // if size is non-zero create a dynamic descriptor directly on the GPU heap
-                    ID3D12Resource* buffer = getDX12ResourcePtr(backendContext, job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].resource.internalIndex);
-                    FFX_ASSERT(buffer != NULL);
-
-                    D3D12_SHADER_RESOURCE_VIEW_DESC dx12SrvDescription = {};
-
-                    bool     isStructured = job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].stride > 0;
-                    uint32_t stride       = isStructured ? job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].stride : sizeof(uint32_t);
-
-                    dx12SrvDescription.Format                     = isStructured ? DXGI_FORMAT_UNKNOWN : DXGI_FORMAT_R32_TYPELESS;
-                    dx12SrvDescription.ViewDimension              = D3D12_SRV_DIMENSION_BUFFER;
-                    dx12SrvDescription.Buffer.FirstElement        = job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].offset / stride;
-                    dx12SrvDescription.Buffer.NumElements         = job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].size / stride;
-                    dx12SrvDescription.Buffer.StructureByteStride = isStructured ? stride : 0;
-                    dx12SrvDescription.Buffer.Flags               = isStructured ? D3D12_BUFFER_SRV_FLAG_NONE : D3D12_BUFFER_SRV_FLAG_RAW;
-                    dx12SrvDescription.Shader4ComponentMapping    = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-
-                    dx12Device->CreateShaderResourceView(buffer, &dx12SrvDescription, cpuView);
-                }
+                // if size is non-zero a dynamic descriptor is created, otherwise the SRV of the buffer is copied from the CPU heap
+                if (buffer.size > 0)
+                    addDescriptorTableEntry(descriptorTable, binding.slotIndex + binding.arrayIndex, buffer.resource.internalIndex, buffer.offset, buffer.size, buffer.stride);
                 else
-                {
-                    // source: SRV of buffer to bind
-                    const uint32_t resourceIndex = job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].resource.internalIndex;
-
-                    D3D12_CPU_DESCRIPTOR_HANDLE srcHandle = backendContext->descHeapSrvCpu->GetCPUDescriptorHandleForHeapStart();
-                    srcHandle.ptr += resourceIndex * dx12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-                    // Copy descriptor
-                    dx12Device->CopyDescriptorsSimple(1, cpuView, srcHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                }
+                    addDescriptorTableEntry(descriptorTable, binding.slotIndex + binding.arrayIndex, buffer.resource.internalIndex);
             }
 
-            backendContext->descRingBufferBase += maximumSrvIndex + 1;
+            D3D12_GPU_DESCRIPTOR_HANDLE gpuView = dx12DescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+            gpuView.ptr += writeDescriptorTable(backendContext, effectContextId, FFX_DESCRIPTOR_TABLE_SRV, descriptorTable) * descriptorSize;
             dx12CommandList->SetComputeRootDescriptorTable(descriptorTableIndex++, gpuView);
         }
     }
@@ -3442,6 +4159,69 @@ static FfxErrorCode executeGpuJobDiscard(BackendContext_DX12*       backendConte
     return FFX_OK;
 }
 
+static FfxResourceStates getCurrentResourceState(const void* pUserData, uint32_t resourceIndex)
+{
+    const BackendContext_DX12* backendContext = static_cast<const BackendContext_DX12*>(pUserData);
+    return backendContext->pResources[resourceIndex].currentState;
+}
+
+static void planBarriers(BackendContext_DX12* backendContext)
+{
+    planGpuJobBarriers(backendContext->barrierPlan, backendContext->pGpuJobs, backendContext->gpuJobCount, getCurrentResourceState, backendContext);
+    backendContext->nextSplitBarrier = 0;
+}
+
+// Begin the split barriers planned to start after a job, the jobs that use the resources next end them
+static void beginSplitBarriers(BackendContext_DX12* backendContext, int32_t jobIndex, ID3D12GraphicsCommandList* dx12CommandList)
+{
+    const BarrierPlan& plan = backendContext->barrierPlan;
+    for (; backendContext->nextSplitBarrier < plan.splitBarrierCount; ++backendContext->nextSplitBarrier)
+    {
+        const SplitBarrier& splitBarrier = plan.pSplitBarriers[backendContext->nextSplitBarrier];
+        if (splitBarrier.beginAfterJob != jobIndex)
+            break;
+
+        // the resource is not in the planned state if a job went differently than planned, the job will transition it in full then
+        BackendContext_DX12::Resource& backendResource = backendContext->pResources[splitBarrier.resourceIndex];
+        if (backendResource.splitBarrierPending || backendResource.currentState != splitBarrier.stateBefore)
+            continue;
+
+        FFX_ASSERT(backendContext->barrierCount < FFX_MAX_BARRIERS);
+        QueuedBarrier& barrier = backendContext->barrierQueue[backendContext->barrierCount++];
+        barrier.resourceIndex = splitBarrier.resourceIndex;
+        barrier.stateBefore   = splitBarrier.stateBefore;
+        barrier.stateAfter    = splitBarrier.stateAfter;
+        barrier.type          = FFX_QUEUED_BARRIER_TRANSITION;
+        barrier.phase         = FFX_SPLIT_BARRIER_BEGIN;
+
+        backendResource.splitBarrierState   = splitBarrier.stateAfter;
+        backendResource.splitBarrierPending = true;
+
+        if (backendContext->barrierCount == FFX_MAX_BARRIERS)
+            flushBarriers(backendContext, dx12CommandList);
+    }
+
+    flushBarriers(backendContext, dx12CommandList);
+}
+
+// End any split barrier a failed job left open, so no transition is left half done past ExecuteGpuJobsDX12
+static void endSplitBarriers(BackendContext_DX12* backendContext, ID3D12GraphicsCommandList* dx12CommandList)
+{
+    const BarrierPlan& plan = backendContext->barrierPlan;
+    for (uint32_t i = 0; i < plan.splitBarrierCount; ++i)
+    {
+        FfxResourceInternal resource = { int32_t(plan.pSplitBarriers[i].resourceIndex) };
+        if (backendContext->pResources[resource.internalIndex].splitBarrierPending)
+        {
+            addBarrier(backendContext, &resource, backendContext->pResources[resource.internalIndex].splitBarrierState);
+            if (backendContext->barrierCount == FFX_MAX_BARRIERS)
+                flushBarriers(backendContext, dx12CommandList);
+        }
+    }
+
+    flushBarriers(backendContext, dx12CommandList);
+}
+
 FfxErrorCode ExecuteGpuJobsDX12(
     FfxInterface* backendInterface,
     FfxCommandList commandList, 
@@ -3455,6 +4235,21 @@ FfxErrorCode ExecuteGpuJobsDX12(
 
     FfxErrorCode errorCode = FFX_OK;
 
+    // look ahead through the jobs to begin transitions as early as possible
+    planBarriers(backendContext);
+
+    backendContext->barrierCommandList = dx12CommandList;
+#ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+    backendContext->enhancedBarrierCommandList = nullptr;
+    if (backendContext->enhancedBarriersSupported)
+    {
+        if (FAILED(dx12CommandList->QueryInterface(IID_PPV_ARGS(&backendContext->enhancedBarrierCommandList))))
+            backendContext->enhancedBarrierCommandList = nullptr;
+    }
+#endif // #ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+
+    beginSplitBarriers(backendContext, -1, dx12CommandList);
+
     // execute all GpuJobs
     for (uint32_t currentGpuJobIndex = 0; currentGpuJobIndex < backendContext->gpuJobCount; ++currentGpuJobIndex) {
 
@@ -3494,7 +4289,20 @@ FfxErrorCode ExecuteGpuJobsDX12(
         if (GpuJob->jobLabel[0]) {
             endMarkerDX12(backendContext, dx12CommandList);
         }
+
+        beginSplitBarriers(backendContext, int32_t(currentGpuJobIndex), dx12CommandList);
+    }
+
+    endSplitBarriers(backendContext, dx12CommandList);
+
+#ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+    if (backendContext->enhancedBarrierCommandList)
+    {
+        backendContext->enhancedBarrierCommandList->Release();
+        backendContext->enhancedBarrierCommandList = nullptr;
     }
+#endif // #ifdef __ID3D12GraphicsCommandList7_FWD_DEFINED__
+    backendContext->barrierCommandList = nullptr;
 
     // check the execute function returned cleanly.
     FFX_RETURN_ON_ERROR(
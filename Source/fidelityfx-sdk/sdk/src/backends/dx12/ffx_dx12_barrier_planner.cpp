@@ -0,0 +1,163 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <FidelityFX/host/ffx_assert.h>
+#include "ffx_dx12_barrier_planner.h"
+
+#include <string.h>
+
+void beginBarrierPlan(BarrierPlan& plan)
+{
+    // epoch 0 marks entries that were never planned, so they need a reset once the counter wraps
+    if (++plan.epoch == 0)
+    {
+        memset(plan.pResources, 0, plan.resourceCount * sizeof(BarrierPlanResource));
+        plan.epoch = 1;
+    }
+    plan.splitBarrierCount = 0;
+}
+
+void planResourceAccess(BarrierPlan& plan, int32_t jobIndex, uint32_t resourceIndex, FfxResourceStates currentState, FfxResourceStates newState)
+{
+    FFX_ASSERT(resourceIndex < plan.resourceCount);
+    BarrierPlanResource& resource = plan.pResources[resourceIndex];
+    if (resource.epoch != plan.epoch)
+    {
+        resource.epoch         = plan.epoch;
+        resource.lastAccessJob = -1;
+        resource.state         = currentState;
+    }
+
+    if ((resource.state & newState) != newState)
+    {
+        // the transition can start as soon as the previous user is done, if some other job runs in between
+        if (resource.lastAccessJob + 1 < jobIndex && plan.splitBarrierCount < plan.maxSplitBarriers)
+        {
+            SplitBarrier& splitBarrier = plan.pSplitBarriers[plan.splitBarrierCount++];
+            splitBarrier.beginAfterJob = resource.lastAccessJob;
+            splitBarrier.endJob        = jobIndex;
+            splitBarrier.resourceIndex = resourceIndex;
+            splitBarrier.stateBefore   = resource.state;
+            splitBarrier.stateAfter    = newState;
+        }
+        resource.state = newState;
+    }
+    resource.lastAccessJob = jobIndex;
+}
+
+void endBarrierPlan(BarrierPlan& plan)
+{
+    for (uint32_t i = 1; i < plan.splitBarrierCount; ++i)
+    {
+        SplitBarrier splitBarrier = plan.pSplitBarriers[i];
+        uint32_t     position     = i;
+        while (position > 0 && plan.pSplitBarriers[position - 1].beginAfterJob > splitBarrier.beginAfterJob)
+        {
+            plan.pSplitBarriers[position] = plan.pSplitBarriers[position - 1];
+            --position;
+        }
+        plan.pSplitBarriers[position] = splitBarrier;
+    }
+}
+
+static void addResourceAccess(ResourceAccess* pAccesses, uint32_t& accessCount, const FfxResourceInternal& resource, FfxResourceStates state)
+{
+    FFX_ASSERT(accessCount < FFX_MAX_JOB_RESOURCE_ACCESSES);
+    pAccesses[accessCount].resourceIndex = resource.internalIndex;
+    pAccesses[accessCount].state         = state;
+    ++accessCount;
+}
+
+uint32_t getGpuJobResourceAccesses(const FfxGpuJobDescription* job, ResourceAccess* pAccesses)
+{
+    uint32_t accessCount = 0;
+
+    switch (job->jobType)
+    {
+    case FFX_GPU_JOB_CLEAR_FLOAT:
+        addResourceAccess(pAccesses, accessCount, job->clearJobDescriptor.target, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        break;
+
+    case FFX_GPU_JOB_COPY:
+        addResourceAccess(pAccesses, accessCount, job->copyJobDescriptor.src, FFX_RESOURCE_STATE_COPY_SRC);
+        addResourceAccess(pAccesses, accessCount, job->copyJobDescriptor.dst, FFX_RESOURCE_STATE_COPY_DEST);
+        break;
+
+    case FFX_GPU_JOB_COMPUTE:
+    {
+        const FfxComputeJobDescription& compute = job->computeJobDescriptor;
+        for (uint32_t i = 0; i < compute.pipeline.uavTextureCount; ++i)
+            addResourceAccess(pAccesses, accessCount, compute.uavTextures[i].resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        for (uint32_t i = 0; i < compute.pipeline.uavBufferCount; ++i)
+        {
+            if (compute.uavBuffers[i].resource.internalIndex != 0)
+                addResourceAccess(pAccesses, accessCount, compute.uavBuffers[i].resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        }
+        for (uint32_t i = 0; i < compute.pipeline.srvTextureCount; ++i)
+        {
+            if (compute.srvTextures[i].resource.internalIndex == 0)
+                break;
+            addResourceAccess(pAccesses, accessCount, compute.srvTextures[i].resource, FFX_RESOURCE_STATE_COMPUTE_READ);
+        }
+        for (uint32_t i = 0; i < compute.pipeline.srvBufferCount; ++i)
+        {
+            if (compute.srvBuffers[i].resource.internalIndex != 0)
+                addResourceAccess(pAccesses, accessCount, compute.srvBuffers[i].resource, FFX_RESOURCE_STATE_COMPUTE_READ);
+        }
+        if (compute.pipeline.cmdSignature)
+            addResourceAccess(pAccesses, accessCount, compute.cmdArgument, FFX_RESOURCE_STATE_INDIRECT_ARGUMENT);
+        break;
+    }
+
+    case FFX_GPU_JOB_BARRIER:
+        addResourceAccess(pAccesses, accessCount, job->barrierDescriptor.resource, job->barrierDescriptor.newState);
+        break;
+
+    case FFX_GPU_JOB_DISCARD:
+        addResourceAccess(pAccesses, accessCount, job->discardJobDescriptor.target, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        break;
+
+    default:
+        break;
+    }
+
+    return accessCount;
+}
+
+void planGpuJobBarriers(BarrierPlan& plan, const FfxGpuJobDescription* pJobs, uint32_t jobCount, BarrierPlanStateCallback fpGetState, const void* pUserData)
+{
+    beginBarrierPlan(plan);
+
+    ResourceAccess accesses[FFX_MAX_JOB_RESOURCE_ACCESSES];
+    for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex)
+    {
+        const uint32_t accessCount = getGpuJobResourceAccesses(&pJobs[jobIndex], accesses);
+        for (uint32_t i = 0; i < accessCount; ++i)
+        {
+            const uint32_t resourceIndex = accesses[i].resourceIndex;
+            planResourceAccess(plan, int32_t(jobIndex), resourceIndex, fpGetState(pUserData, resourceIndex), accesses[i].state);
+        }
+    }
+
+    endBarrierPlan(plan);
+}
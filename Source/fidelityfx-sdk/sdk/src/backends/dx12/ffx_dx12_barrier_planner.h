@@ -0,0 +1,86 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Device-free barrier planning of the DX12 backend. Before recording, the scheduled jobs are walked in order to find
+// the transitions no job between the last and the next use of a resource depends on. ffx_dx12.cpp records those as
+// split barriers, the tests replay job streams through the plan.
+
+#pragma once
+
+#include <stdint.h>
+#include <FidelityFX/host/ffx_interface.h>
+
+// The most resources a single gpu job can transition
+#define FFX_MAX_JOB_RESOURCE_ACCESSES       (FFX_MAX_NUM_SRVS * 2 + FFX_MAX_NUM_UAVS * 2 + 1)
+
+typedef struct ResourceAccess
+{
+    uint32_t          resourceIndex;
+    FfxResourceStates state;
+} ResourceAccess;
+
+// A transition begun right after job beginAfterJob (-1 for before the first job) and ended by job endJob
+typedef struct SplitBarrier
+{
+    int32_t           beginAfterJob;
+    uint32_t          endJob;
+    uint32_t          resourceIndex;
+    FfxResourceStates stateBefore;
+    FfxResourceStates stateAfter;
+} SplitBarrier;
+
+// Entries older than the current epoch have not been accessed by the jobs planned so far
+typedef struct BarrierPlanResource
+{
+    uint32_t          epoch;
+    int32_t           lastAccessJob;
+    FfxResourceStates state;
+} BarrierPlanResource;
+
+typedef struct BarrierPlan
+{
+    BarrierPlanResource* pResources;
+    uint32_t             resourceCount;
+    uint32_t             epoch;
+    SplitBarrier*        pSplitBarriers;
+    uint32_t             splitBarrierCount;
+    uint32_t             maxSplitBarriers;
+} BarrierPlan;
+
+// The state a resource is in before the first planned job
+typedef FfxResourceStates (*BarrierPlanStateCallback)(const void* pUserData, uint32_t resourceIndex);
+
+// Start planning the barriers of a new list of jobs
+void beginBarrierPlan(BarrierPlan& plan);
+
+// Plan a job accessing a resource in a given state. currentState is the state the resource is in before the first planned job.
+void planResourceAccess(BarrierPlan& plan, int32_t jobIndex, uint32_t resourceIndex, FfxResourceStates currentState, FfxResourceStates newState);
+
+// Order the split barriers by the job they begin after, keeping the planned order among barriers of the same job
+void endBarrierPlan(BarrierPlan& plan);
+
+// The resources a job transitions, in the order the executeGpuJob functions add their barriers
+uint32_t getGpuJobResourceAccesses(const FfxGpuJobDescription* job, ResourceAccess* pAccesses);
+
+// Plan the split barriers of a list of jobs, sorted by the job they begin after
+void planGpuJobBarriers(BarrierPlan& plan, const FfxGpuJobDescription* pJobs, uint32_t jobCount, BarrierPlanStateCallback fpGetState, const void* pUserData);
@@ -0,0 +1,148 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <FidelityFX/host/ffx_assert.h>
+#include "ffx_dx12_descriptor_table.h"
+
+#include <string.h>
+
+void resetDescriptorTable(DescriptorTable& table)
+{
+    table.slotCount  = 0;
+    table.entryCount = 0;
+}
+
+void addDescriptorTableEntry(DescriptorTable& table, uint32_t slot, uint32_t source, uint32_t offset, uint32_t size, uint32_t stride)
+{
+    FFX_ASSERT(table.entryCount < FFX_MAX_DESCRIPTOR_TABLE_ENTRIES);
+
+    uint32_t position = table.entryCount;
+    while (position > 0 && table.entries[position - 1].slot > slot)
+    {
+        table.entries[position] = table.entries[position - 1];
+        --position;
+    }
+
+    DescriptorTableEntry& entry = table.entries[position];
+    entry.slot   = slot;
+    entry.source = source;
+    entry.offset = offset;
+    entry.size   = size;
+    entry.stride = stride;
+    ++table.entryCount;
+}
+
+bool isSameDescriptorTable(const DescriptorTable& a, const DescriptorTable& b)
+{
+    return a.slotCount == b.slotCount && a.entryCount == b.entryCount && memcmp(a.entries, b.entries, a.entryCount * sizeof(DescriptorTableEntry)) == 0;
+}
+
+void buildDescriptorCopyRanges(const DescriptorTable& table, DescriptorCopyRanges& ranges)
+{
+    ranges.dstRangeCount = 0;
+    ranges.srcRangeCount = 0;
+
+    const DescriptorTableEntry* previous = nullptr;
+    for (uint32_t i = 0; i < table.entryCount; ++i)
+    {
+        const DescriptorTableEntry& entry = table.entries[i];
+        if (entry.size > 0)
+            continue;
+
+        if (previous && entry.slot == previous->slot + 1)
+            ++ranges.dstRangeSizes[ranges.dstRangeCount - 1];
+        else
+        {
+            ranges.dstRangeStarts[ranges.dstRangeCount] = entry.slot;
+            ranges.dstRangeSizes[ranges.dstRangeCount++] = 1;
+        }
+
+        if (previous && entry.source == previous->source + 1)
+            ++ranges.srcRangeSizes[ranges.srcRangeCount - 1];
+        else
+        {
+            ranges.srcRangeStarts[ranges.srcRangeCount] = entry.source;
+            ranges.srcRangeSizes[ranges.srcRangeCount++] = 1;
+        }
+
+        previous = &entry;
+    }
+}
+
+void initDescriptorRing(DescriptorRing& ring, uint32_t base, uint32_t partitionSize)
+{
+    memset(&ring, 0, sizeof(ring));
+    ring.base          = base;
+    ring.partitionSize = partitionSize;
+}
+
+DescriptorTableAllocation allocateDescriptorTable(DescriptorRing& ring, DescriptorTableType tableType, const DescriptorTable& table)
+{
+    FFX_ASSERT(table.slotCount <= ring.partitionSize);
+
+    DescriptorTableAllocation allocation = {};
+    if (ring.lastTableValid[tableType] && isSameDescriptorTable(ring.lastTables[tableType], table))
+    {
+        allocation.base   = ring.lastTableBases[tableType];
+        allocation.reused = true;
+        return allocation;
+    }
+
+    // a frame that does not fit its partition overwrites its own first tables, which the GPU may not have read yet
+    if (ring.head + table.slotCount > ring.partitionSize)
+    {
+        ring.head          = 0;
+        allocation.wrapped = true;
+    }
+
+    allocation.base = ring.base + ring.frameIndex * ring.partitionSize + ring.head;
+    ring.head += table.slotCount;
+
+    // the last table of the other type stops being reusable once it gets overwritten
+    for (uint32_t type = 0; type < FFX_DESCRIPTOR_TABLE_TYPE_COUNT; ++type)
+    {
+        const uint32_t lastBase = ring.lastTableBases[type];
+        if (allocation.base < lastBase + ring.lastTables[type].slotCount && lastBase < allocation.base + table.slotCount)
+            ring.lastTableValid[type] = false;
+    }
+
+    ring.lastTables[tableType]     = table;
+    ring.lastTableBases[tableType] = allocation.base;
+    ring.lastTableValid[tableType] = true;
+    return allocation;
+}
+
+void invalidateDescriptorTables(DescriptorRing& ring)
+{
+    for (uint32_t type = 0; type < FFX_DESCRIPTOR_TABLE_TYPE_COUNT; ++type)
+        ring.lastTableValid[type] = false;
+}
+
+void advanceDescriptorRingFrame(DescriptorRing& ring)
+{
+    ring.frameIndex = (ring.frameIndex + 1) % FFX_MAX_QUEUED_FRAMES;
+    ring.head       = 0;
+
+    // the tables of the previous frame live in another partition, binding them again would extend them past their fence
+    invalidateDescriptorTables(ring);
+}
@@ -0,0 +1,113 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Device-free part of the DX12 descriptor tables: the CPU description of a table, the merging of its copies into
+// ranges and the descriptor ring each effect context writes its tables to. ffx_dx12.cpp turns the results into
+// CopyDescriptors calls and views, the tests drive them directly.
+
+#pragma once
+
+#include <stdint.h>
+#include <FidelityFX/host/ffx_types.h>
+
+#define FFX_MAX_DESCRIPTOR_TABLE_ENTRIES    (FFX_MAX_NUM_UAVS * 2)
+
+// Each effect context owns FFX_RING_BUFFER_DESCRIPTOR_COUNT descriptors of the ring, one partition per queued frame
+#define FFX_DESCRIPTOR_RING_PARTITION_SIZE  (FFX_RING_BUFFER_DESCRIPTOR_COUNT / FFX_MAX_QUEUED_FRAMES)
+
+typedef enum DescriptorTableType
+{
+    FFX_DESCRIPTOR_TABLE_UAV,
+    FFX_DESCRIPTOR_TABLE_SRV,
+
+    FFX_DESCRIPTOR_TABLE_TYPE_COUNT
+} DescriptorTableType;
+
+typedef struct DescriptorTableEntry
+{
+    uint32_t slot;
+    uint32_t source;        // descriptor index in the CPU heap, or resource index when a buffer view is created
+    uint32_t offset;        // the buffer view, size is 0 for copied descriptors
+    uint32_t size;
+    uint32_t stride;
+} DescriptorTableEntry;
+
+typedef struct DescriptorTable
+{
+    uint32_t             slotCount;
+    uint32_t             entryCount;
+    DescriptorTableEntry entries[FFX_MAX_DESCRIPTOR_TABLE_ENTRIES];
+} DescriptorTable;
+
+typedef struct DescriptorCopyRanges
+{
+    uint32_t dstRangeCount;
+    uint32_t dstRangeStarts[FFX_MAX_DESCRIPTOR_TABLE_ENTRIES];
+    uint32_t dstRangeSizes[FFX_MAX_DESCRIPTOR_TABLE_ENTRIES];
+    uint32_t srcRangeCount;
+    uint32_t srcRangeStarts[FFX_MAX_DESCRIPTOR_TABLE_ENTRIES];
+    uint32_t srcRangeSizes[FFX_MAX_DESCRIPTOR_TABLE_ENTRIES];
+} DescriptorCopyRanges;
+
+// The ring of one effect context. A frame writes its tables to its own partition, which is only written again once
+// the frame FFX_MAX_QUEUED_FRAMES later starts, so a table stays live for the whole frame it was written in.
+typedef struct DescriptorRing
+{
+    uint32_t        base;           // first descriptor of the ring in the shader visible heap
+    uint32_t        partitionSize;
+    uint32_t        frameIndex;
+    uint32_t        head;           // next free descriptor in the partition of frameIndex
+
+    // the last table of each type written in the current frame, reusable until its sources change
+    DescriptorTable lastTables[FFX_DESCRIPTOR_TABLE_TYPE_COUNT];
+    uint32_t        lastTableBases[FFX_DESCRIPTOR_TABLE_TYPE_COUNT];
+    bool            lastTableValid[FFX_DESCRIPTOR_TABLE_TYPE_COUNT];
+} DescriptorRing;
+
+typedef struct DescriptorTableAllocation
+{
+    uint32_t base;          // heap index of the first slot of the table
+    bool     reused;        // an identical table is live at base, nothing needs to be written
+    bool     wrapped;       // the partition was full and the table overwrote earlier tables of the same frame
+} DescriptorTableAllocation;
+
+void resetDescriptorTable(DescriptorTable& table);
+
+// Entries are kept sorted by slot so tables compare and copy independently of the binding order
+void addDescriptorTableEntry(DescriptorTable& table, uint32_t slot, uint32_t source, uint32_t offset = 0, uint32_t size = 0, uint32_t stride = 0);
+
+bool isSameDescriptorTable(const DescriptorTable& a, const DescriptorTable& b);
+
+// Merge the copied descriptors into runs of consecutive destination slots and consecutive source descriptors
+void buildDescriptorCopyRanges(const DescriptorTable& table, DescriptorCopyRanges& ranges);
+
+void initDescriptorRing(DescriptorRing& ring, uint32_t base, uint32_t partitionSize);
+
+// Find the slots of a table, either the live copy of an identical table or newly allocated ones the caller then writes
+DescriptorTableAllocation allocateDescriptorTable(DescriptorRing& ring, DescriptorTableType tableType, const DescriptorTable& table);
+
+// The sources of the live tables changed, as descriptors were written to the CPU heaps at indices they may refer to
+void invalidateDescriptorTables(DescriptorRing& ring);
+
+// Start the next frame of the effect context, in the partition of the frame FFX_MAX_QUEUED_FRAMES before
+void advanceDescriptorRingFrame(DescriptorRing& ring);
@@ -0,0 +1,227 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <FidelityFX/host/ffx_assert.h>
+#include "ffx_dx12_immutable_resources.h"
+#include "ffx_dx12_pipeline_cache.h"
+
+#include <mutex>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// The key only narrows the search, a hit also compares what the resource was created from byte for byte
+typedef struct ImmutableResourceEntry
+{
+    uint64_t                key;
+    FfxResourceDescription  description;
+    FfxResourceInitDataType initDataType;
+    size_t                  initDataSize;
+    void*                   pInitData;          // a copy of buffer initial data
+    uint8_t                 initValue;          // the fill value of value initial data
+    void*                   resource;
+    uint32_t                useCount;
+} ImmutableResourceEntry;
+
+typedef struct ImmutableResourceDevice
+{
+    void*                               device;
+    uint32_t                            refCount;
+    std::vector<ImmutableResourceEntry> entries;
+    ImmutableResourceStatistics         statistics;
+} ImmutableResourceDevice;
+
+static std::mutex                           s_ImmutableResourceMutex;
+static std::vector<ImmutableResourceDevice> s_ImmutableResourceDevices;
+
+bool isImmutableResource(const FfxCreateResourceDescription* createResourceDescription)
+{
+    const FfxResourceInitData& initData = createResourceDescription->initData;
+    if (initData.type != FFX_RESOURCE_INIT_DATA_TYPE_BUFFER && initData.type != FFX_RESOURCE_INIT_DATA_TYPE_VALUE)
+        return false;
+
+    const uint32_t writableUsages = FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV | FFX_RESOURCE_USAGE_DEPTHTARGET |
+                                    FFX_RESOURCE_USAGE_STENCILTARGET | FFX_RESOURCE_USAGE_DCC_RENDERTARGET;
+    return createResourceDescription->heapType == FFX_HEAP_TYPE_DEFAULT && !(createResourceDescription->resourceDescription.usage & writableUsages) &&
+           !(createResourceDescription->resourceDescription.flags & FFX_RESOURCE_FLAGS_ALIASABLE);
+}
+
+// The lookup key of an immutable resource, a hash of its description and initial contents
+static uint64_t getImmutableResourceKey(const FfxCreateResourceDescription* createResourceDescription)
+{
+    const FfxResourceInitData& initData = createResourceDescription->initData;
+    const uint64_t             dataSize = initData.size;
+
+    uint64_t hash = hashPipelineCacheBytes(FFX_PIPELINE_CACHE_HASH_BASIS, &createResourceDescription->resourceDescription, sizeof(FfxResourceDescription));
+    hash = hashPipelineCacheBytes(hash, &initData.type, sizeof(initData.type));
+    hash = hashPipelineCacheBytes(hash, &dataSize, sizeof(dataSize));
+    if (initData.type == FFX_RESOURCE_INIT_DATA_TYPE_BUFFER)
+        return hashPipelineCacheBytes(hash, initData.buffer, initData.size);
+    return hashPipelineCacheBytes(hash, &initData.value, sizeof(initData.value));
+}
+
+static bool isSameImmutableResource(const ImmutableResourceEntry& entry, uint64_t key, const FfxCreateResourceDescription* createResourceDescription)
+{
+    const FfxResourceInitData& initData = createResourceDescription->initData;
+    if (entry.key != key || entry.initDataType != initData.type || entry.initDataSize != initData.size ||
+        memcmp(&entry.description, &createResourceDescription->resourceDescription, sizeof(FfxResourceDescription)) != 0)
+        return false;
+
+    if (initData.type == FFX_RESOURCE_INIT_DATA_TYPE_BUFFER)
+        return memcmp(entry.pInitData, initData.buffer, initData.size) == 0;
+    return entry.initValue == initData.value;
+}
+
+// Must be called with s_ImmutableResourceMutex held
+static ImmutableResourceDevice* findImmutableResourceDevice(void* device)
+{
+    for (ImmutableResourceDevice& immutableDevice : s_ImmutableResourceDevices)
+    {
+        if (immutableDevice.device == device)
+            return &immutableDevice;
+    }
+    return nullptr;
+}
+
+void retainImmutableResourceDevice(void* device)
+{
+    std::lock_guard<std::mutex> lock(s_ImmutableResourceMutex);
+    ImmutableResourceDevice* immutableDevice = findImmutableResourceDevice(device);
+    if (immutableDevice)
+    {
+        ++immutableDevice->refCount;
+        return;
+    }
+
+    s_ImmutableResourceDevices.push_back({});
+    s_ImmutableResourceDevices.back().device   = device;
+    s_ImmutableResourceDevices.back().refCount = 1;
+}
+
+void releaseImmutableResourceDevice(void* device)
+{
+    std::lock_guard<std::mutex> lock(s_ImmutableResourceMutex);
+    ImmutableResourceDevice* immutableDevice = findImmutableResourceDevice(device);
+    FFX_ASSERT(immutableDevice && immutableDevice->refCount > 0);
+    if (!immutableDevice || --immutableDevice->refCount > 0)
+        return;
+
+    // every effect context on the device destroyed its resources before its backend released the device
+    FFX_ASSERT(immutableDevice->entries.empty());
+    for (ImmutableResourceEntry& entry : immutableDevice->entries)
+        free(entry.pInitData);
+
+    *immutableDevice = std::move(s_ImmutableResourceDevices.back());
+    s_ImmutableResourceDevices.pop_back();
+}
+
+void* acquireImmutableResource(void* device, const FfxCreateResourceDescription* createResourceDescription, ImmutableResourceAddReference fpAddReference)
+{
+    std::lock_guard<std::mutex> lock(s_ImmutableResourceMutex);
+    ImmutableResourceDevice* immutableDevice = findImmutableResourceDevice(device);
+    FFX_ASSERT(immutableDevice);
+    if (!immutableDevice)
+        return nullptr;
+
+    const uint64_t key = getImmutableResourceKey(createResourceDescription);
+    for (ImmutableResourceEntry& entry : immutableDevice->entries)
+    {
+        if (isSameImmutableResource(entry, key, createResourceDescription))
+        {
+            fpAddReference(entry.resource);
+            ++entry.useCount;
+            ++immutableDevice->statistics.shareCount;
+            immutableDevice->statistics.skippedUploadBytes += createResourceDescription->initData.size;
+            return entry.resource;
+        }
+    }
+    return nullptr;
+}
+
+bool addImmutableResource(void* device, const FfxCreateResourceDescription* createResourceDescription, void* resource)
+{
+    std::lock_guard<std::mutex> lock(s_ImmutableResourceMutex);
+    ImmutableResourceDevice* immutableDevice = findImmutableResourceDevice(device);
+    FFX_ASSERT(immutableDevice);
+    if (!immutableDevice || immutableDevice->entries.size() >= FFX_MAX_IMMUTABLE_RESOURCE_COUNT)
+        return false;
+
+    const FfxResourceInitData& initData = createResourceDescription->initData;
+    void* pInitData = nullptr;
+    if (initData.type == FFX_RESOURCE_INIT_DATA_TYPE_BUFFER)
+    {
+        pInitData = malloc(initData.size);
+        if (!pInitData)
+            return false;
+        memcpy(pInitData, initData.buffer, initData.size);
+    }
+
+    ImmutableResourceEntry entry = {};
+    entry.key          = getImmutableResourceKey(createResourceDescription);
+    entry.description  = createResourceDescription->resourceDescription;
+    entry.initDataType = initData.type;
+    entry.initDataSize = initData.size;
+    entry.pInitData    = pInitData;
+    entry.initValue    = initData.type == FFX_RESOURCE_INIT_DATA_TYPE_VALUE ? initData.value : 0;
+    entry.resource     = resource;
+    entry.useCount     = 1;
+    immutableDevice->entries.push_back(entry);
+
+    ++immutableDevice->statistics.liveResourceCount;
+    ++immutableDevice->statistics.createCount;
+    immutableDevice->statistics.uploadedBytes += initData.size;
+    return true;
+}
+
+void releaseImmutableResource(void* device, void* resource)
+{
+    std::lock_guard<std::mutex> lock(s_ImmutableResourceMutex);
+    ImmutableResourceDevice* immutableDevice = findImmutableResourceDevice(device);
+    FFX_ASSERT(immutableDevice);
+    if (!immutableDevice)
+        return;
+
+    for (size_t i = 0; i < immutableDevice->entries.size(); ++i)
+    {
+        ImmutableResourceEntry& entry = immutableDevice->entries[i];
+        if (entry.resource != resource)
+            continue;
+
+        FFX_ASSERT(entry.useCount > 0);
+        if (--entry.useCount == 0)
+        {
+            free(entry.pInitData);
+            entry = immutableDevice->entries.back();
+            immutableDevice->entries.pop_back();
+            --immutableDevice->statistics.liveResourceCount;
+        }
+        return;
+    }
+    FFX_ASSERT_MESSAGE(false, "FFXInterface: DX12: Released resource is not a shared immutable resource.");
+}
+
+ImmutableResourceStatistics getImmutableResourceStatistics(void* device)
+{
+    std::lock_guard<std::mutex> lock(s_ImmutableResourceMutex);
+    const ImmutableResourceDevice* immutableDevice = findImmutableResourceDevice(device);
+    return immutableDevice ? immutableDevice->statistics : ImmutableResourceStatistics{};
+}
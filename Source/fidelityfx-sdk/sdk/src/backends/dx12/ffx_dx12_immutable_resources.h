@@ -0,0 +1,69 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Device-free part of the DX12 immutable resource sharing: read only resources created with initial data, such as the
+// upscaler lookup tables, are shared by every effect context on the same device that creates one with the same
+// description and contents. The FidelityFX API gives each context a backend interface of its own, so the table is
+// global and keyed by device. ffx_dx12.cpp allocates, uploads and releases the resources, the tests drive the table
+// directly.
+
+#pragma once
+
+#include <stdint.h>
+#include <FidelityFX/host/ffx_types.h>
+
+// Shared resources per device, creations beyond it get a resource of their own
+#define FFX_MAX_IMMUTABLE_RESOURCE_COUNT    (64)
+
+typedef struct ImmutableResourceStatistics
+{
+    uint32_t liveResourceCount;
+    uint64_t createCount;
+    uint64_t shareCount;
+    uint64_t uploadedBytes;
+    uint64_t skippedUploadBytes;
+} ImmutableResourceStatistics;
+
+typedef void (*ImmutableResourceAddReference)(void* resource);
+
+// Resources that are never written after their initial upload can be shared between effect contexts
+bool isImmutableResource(const FfxCreateResourceDescription* createResourceDescription);
+
+// Every backend interface retains the device while it has effect contexts, the device's table and statistics live until
+// the last one releases it. Holding the device also keeps a new device from taking its address meanwhile.
+void retainImmutableResourceDevice(void* device);
+void releaseImmutableResourceDevice(void* device);
+
+// Returns a resource created before with the same description and contents and counts a use of it, or nullptr when the
+// caller has to allocate and upload it. fpAddReference is called before the table is unlocked, so the resource
+// cannot be released in between.
+void* acquireImmutableResource(void* device, const FfxCreateResourceDescription* createResourceDescription, ImmutableResourceAddReference fpAddReference);
+
+// Register a resource the caller allocated, false if it is not shared because the table is full or the initial data
+// cannot be kept for the comparisons
+bool addImmutableResource(void* device, const FfxCreateResourceDescription* createResourceDescription, void* resource);
+
+// Drop a use of a shared resource, the caller still releases its own reference
+void releaseImmutableResource(void* device, void* resource);
+
+ImmutableResourceStatistics getImmutableResourceStatistics(void* device);
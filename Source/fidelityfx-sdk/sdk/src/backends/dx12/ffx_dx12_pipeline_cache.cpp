@@ -0,0 +1,88 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ffx_dx12_pipeline_cache.h"
+
+#include <string.h>
+
+uint64_t hashPipelineCacheBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+uint64_t getRootSignatureHash(const void* serializedRootSignature, size_t size)
+{
+    const uint64_t sizeValue = size;
+    uint64_t hash = hashPipelineCacheBytes(FFX_PIPELINE_CACHE_HASH_BASIS, &sizeValue, sizeof(sizeValue));
+    return hashPipelineCacheBytes(hash, serializedRootSignature, size);
+}
+
+uint64_t getPipelineStateKey(uint64_t rootSignatureHash, const void* shaderBytecode, size_t shaderSize)
+{
+    uint64_t key = hashPipelineCacheBytes(FFX_PIPELINE_CACHE_HASH_BASIS, &rootSignatureHash, sizeof(rootSignatureHash));
+    key = hashPipelineCacheBytes(key, shaderBytecode, shaderSize);
+    return key;
+}
+
+void getPipelineLibraryName(uint64_t pipelineKey, wchar_t (&name)[FFX_PIPELINE_LIBRARY_NAME_LENGTH])
+{
+    static const wchar_t hexDigits[] = L"0123456789abcdef";
+    name[0] = L'f';
+    name[1] = L'f';
+    name[2] = L'x';
+    for (uint32_t digit = 0; digit < 16; ++digit)
+        name[3 + digit] = hexDigits[(pipelineKey >> (60 - digit * 4)) & 0xf];
+    name[FFX_PIPELINE_LIBRARY_NAME_LENGTH - 1] = L'\0';
+}
+
+PipelineLibraryBlobHeader getPipelineLibraryBlobHeader(const void* pLibraryData, size_t libraryDataSize)
+{
+    PipelineLibraryBlobHeader header = {};
+    header.magic    = FFX_PIPELINE_LIBRARY_BLOB_MAGIC;
+    header.version  = FFX_PIPELINE_LIBRARY_BLOB_VERSION;
+    header.dataSize = libraryDataSize;
+    header.checksum = hashPipelineCacheBytes(FFX_PIPELINE_CACHE_HASH_BASIS, pLibraryData, libraryDataSize);
+    return header;
+}
+
+bool validatePipelineLibraryBlob(const void* pData, size_t dataSize)
+{
+    if (dataSize < sizeof(PipelineLibraryBlobHeader))
+        return false;
+
+    PipelineLibraryBlobHeader header;
+    memcpy(&header, pData, sizeof(header));
+
+    if (header.magic != FFX_PIPELINE_LIBRARY_BLOB_MAGIC || header.version != FFX_PIPELINE_LIBRARY_BLOB_VERSION)
+        return false;
+
+    if (header.dataSize == 0 || dataSize - sizeof(header) != header.dataSize)
+        return false;
+
+    return hashPipelineCacheBytes(FFX_PIPELINE_CACHE_HASH_BASIS, (const uint8_t*)pData + sizeof(header), (size_t)header.dataSize) == header.checksum;
+}
@@ -0,0 +1,62 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Device-free part of the DX12 pipeline cache: the keys root signatures and pipeline states are cached and named by,
+// and the header of the blobs ffxGetPipelineLibraryDataDX12 writes. ffx_dx12.cpp pairs them with the
+// ID3D12PipelineLibrary, the tests drive them directly.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// FNV-1a, stable across runs and builds so keys can name pipelines in a serialized library
+#define FFX_PIPELINE_CACHE_HASH_BASIS       (0xcbf29ce484222325ull)
+
+// Pipeline library blob layout: PipelineLibraryBlobHeader, then the serialized ID3D12PipelineLibrary
+#define FFX_PIPELINE_LIBRARY_BLOB_MAGIC     (0x4c584646u) // "FFXL"
+#define FFX_PIPELINE_LIBRARY_BLOB_VERSION   (1)
+#define FFX_PIPELINE_LIBRARY_NAME_LENGTH    (20)          // "ffx" followed by the 16 hex digits of the pipeline key
+
+typedef struct PipelineLibraryBlobHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t dataSize;
+    uint64_t checksum;      // FNV-1a over the library data, the runtime checks adapter and driver itself
+} PipelineLibraryBlobHeader;
+
+uint64_t hashPipelineCacheBytes(uint64_t hash, const void* data, size_t size);
+
+uint64_t getRootSignatureHash(const void* serializedRootSignature, size_t size);
+
+// Pipeline states are identified by their root signature and shader bytecode
+uint64_t getPipelineStateKey(uint64_t rootSignatureHash, const void* shaderBytecode, size_t shaderSize);
+
+void getPipelineLibraryName(uint64_t pipelineKey, wchar_t (&name)[FFX_PIPELINE_LIBRARY_NAME_LENGTH]);
+
+// Header for libraryDataSize bytes of serialized library data
+PipelineLibraryBlobHeader getPipelineLibraryBlobHeader(const void* pLibraryData, size_t libraryDataSize);
+
+// Checks that a blob was written by ffxGetPipelineLibraryDataDX12 and has not been truncated or corrupted
+bool validatePipelineLibraryBlob(const void* pData, size_t dataSize);
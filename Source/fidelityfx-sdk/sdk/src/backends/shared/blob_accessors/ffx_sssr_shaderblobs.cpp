@@ -24,25 +24,21 @@
 #include "ffx_sssr_shaderblobs.h"
 #include "sssr/ffx_sssr_private.h"
 
-#include <ffx_sssr_prepare_blue_noise_texture_pass_permutations.h>
 #include <ffx_sssr_intersect_pass_permutations.h>
 #include <ffx_sssr_classify_tiles_pass_permutations.h>
 #include <ffx_sssr_prepare_indirect_args_pass_permutations.h>
 #include <ffx_sssr_depth_downsample_pass_permutations.h>
 
-#include <ffx_sssr_prepare_blue_noise_texture_pass_wave64_permutations.h>
 #include <ffx_sssr_intersect_pass_wave64_permutations.h>
 #include <ffx_sssr_classify_tiles_pass_wave64_permutations.h>
 #include <ffx_sssr_prepare_indirect_args_pass_wave64_permutations.h>
 #include <ffx_sssr_depth_downsample_pass_wave64_permutations.h>
 
-#include <ffx_sssr_prepare_blue_noise_texture_pass_16bit_permutations.h>
 #include <ffx_sssr_intersect_pass_16bit_permutations.h>
 #include <ffx_sssr_classify_tiles_pass_16bit_permutations.h>
 #include <ffx_sssr_prepare_indirect_args_pass_16bit_permutations.h>
 #include <ffx_sssr_depth_downsample_pass_16bit_permutations.h>
 
-#include <ffx_sssr_prepare_blue_noise_texture_pass_wave64_16bit_permutations.h>
 #include <ffx_sssr_intersect_pass_wave64_16bit_permutations.h>
 #include <ffx_sssr_classify_tiles_pass_wave64_16bit_permutations.h>
 #include <ffx_sssr_prepare_indirect_args_pass_wave64_16bit_permutations.h>
@@ -89,38 +85,6 @@ static FfxShaderBlob sssrGetClassifyTilesPassPermutationBlobByIndex(uint32_t per
     }
 }
 
-static FfxShaderBlob sssrGetPrepareBlueNoiseTexturePassPermutationBlobByIndex(uint32_t permutationOptions, bool isWave64, bool is16bit)
-{
-
-    ffx_sssr_prepare_blue_noise_texture_pass_PermutationKey key;
-
-    POPULATE_PERMUTATION_KEY(permutationOptions, key);
-
-    if (isWave64) {
-
-        if (is16bit) {
-
-            const int32_t tableIndex = g_ffx_sssr_prepare_blue_noise_texture_pass_wave64_16bit_IndirectionTable[key.index];
-            return POPULATE_SHADER_BLOB_FFX(g_ffx_sssr_prepare_blue_noise_texture_pass_wave64_16bit_PermutationInfo, tableIndex);
-        } else {
-
-            const int32_t tableIndex = g_ffx_sssr_prepare_blue_noise_texture_pass_wave64_IndirectionTable[key.index];
-            return POPULATE_SHADER_BLOB_FFX(g_ffx_sssr_prepare_blue_noise_texture_pass_wave64_PermutationInfo, tableIndex);
-        }
-    } else {
-
-        if (is16bit) {
-
-            const int32_t tableIndex = g_ffx_sssr_prepare_blue_noise_texture_pass_16bit_IndirectionTable[key.index];
-            return POPULATE_SHADER_BLOB_FFX(g_ffx_sssr_prepare_blue_noise_texture_pass_16bit_PermutationInfo, tableIndex);
-        } else {
-
-            const int32_t tableIndex = g_ffx_sssr_prepare_blue_noise_texture_pass_IndirectionTable[key.index];
-            return POPULATE_SHADER_BLOB_FFX(g_ffx_sssr_prepare_blue_noise_texture_pass_PermutationInfo, tableIndex);
-        }
-    }
-}
-
 static FfxShaderBlob sssrGetPrepareIndirectArgsPassPermutationBlobByIndex(uint32_t permutationOptions, bool isWave64, bool is16bit)
 {
 
@@ -237,13 +201,6 @@ FfxErrorCode sssrGetPermutationBlobByIndex(
             return FFX_OK;
         }
 
-        case FFX_SSSR_PASS_PREPARE_BLUE_NOISE_TEXTURE:
-        {
-            FfxShaderBlob blob = sssrGetPrepareBlueNoiseTexturePassPermutationBlobByIndex(permutationOptions, isWave64, is16bit);
-            memcpy(outBlob, &blob, sizeof(FfxShaderBlob));
-            return FFX_OK;
-        }
-
         case FFX_SSSR_PASS_PREPARE_INDIRECT_ARGS:
         {
             FfxShaderBlob blob = sssrGetPrepareIndirectArgsPassPermutationBlobByIndex(permutationOptions, isWave64, is16bit);
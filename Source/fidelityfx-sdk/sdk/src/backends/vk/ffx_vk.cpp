@@ -34,6 +34,9 @@
 #endif  // _WIN32
 
 #include <vulkan/vulkan.h>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
 
 // prototypes for functions in the interface
 FfxVersionNumber       GetSDKVersionVK(FfxInterface* backendInterface);
@@ -62,18 +65,77 @@ void                   BreadcrumbsPrintDeviceInfoVK(FfxInterface* backendInterfa
 void                   RegisterConstantBufferAllocatorVK(FfxInterface* backendInterface, FfxConstantBufferAllocator fpConstantAllocator);
 
 
-static VkDeviceContext sVkDeviceContext = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
+static VkDeviceContext sVkDeviceContext = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_FALSE };
 
-#define MAX_PIPELINE_USAGE_PER_FRAME      (10) // Required to make sure passes that are called more than once per-frame don't have their descriptors overwritten.
+#define MAX_PIPELINE_USAGE_PER_FRAME      (10) // Descriptor sets with distinct bindings cached per pipeline and queued frame, more go to the transient pool.
+#define FFX_MAX_CACHED_DESCRIPTOR_SETS    (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME)
+#define FFX_TRANSIENT_DESCRIPTOR_SET_COUNT (64)
 #define MAX_DESCRIPTOR_SET_LAYOUTS        (64)
 #define FFX_MAX_BINDLESS_DESCRIPTOR_COUNT (65536)
 
+// Memory reserved on demand rather than up front, see ffxGetDescriptorPoolStatisticsVK
+#define FFX_MAX_DESCRIPTOR_POOLS          (32)
+#define FFX_DESCRIPTOR_POOL_SET_COUNT     (64)  // sets in the first pool, each new pool doubles it up to 64x
+#define FFX_DESCRIPTOR_POOL_TYPE_COUNT    (5)
+#define FFX_GPU_JOB_CHUNK_SIZE            (16)
+#define FFX_BINDLESS_VIEW_CHUNK_SIZE      (1024)
+
+#define FFX_MAX_TRACKED_MIP_COUNT         (16)  // mips tracked individually by the barrier batching, enough for a 32768 texture, images with more are rejected
+
+#define FFX_MAX_RETIRED_UNIFORM_BUFFERS       (8)   // uniform buffers replaced after a frame overflowed its partition, kept until the backend is destroyed
+#define FFX_CONSTANT_BUFFER_STAGING_ALIGNMENT (16)
+
+#define FFX_MAX_RECORDERS                 (16)          // threads recording with the same backend at once
+#define FFX_RECORDER_STAGING_RING_SIZE    (64 * 1024)   // constants staged by a recorder before spilling to heap blocks
+
 // Constant buffer allocation callback
 static FfxConstantBufferAllocator s_fpConstantAllocator = nullptr;
 
 // Offset the binding of samplers to avoid collisions
 constexpr uint32_t SAMPLER_BINDING_SHIFT = 1000;
 
+// Descriptor types of the cached descriptor sets
+static const VkDescriptorType s_descriptorPoolTypes[FFX_DESCRIPTOR_POOL_TYPE_COUNT] = {
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+// Pipeline cache blob layout: PipelineCacheBlobHeader, keyCount pipeline keys, then the VkPipelineCache data
+#define FFX_PIPELINE_CACHE_KEY_CAPACITY   (2048)
+#define FFX_PIPELINE_CACHE_BLOB_MAGIC     (0x43584646u) // "FFXC"
+#define FFX_PIPELINE_CACHE_BLOB_VERSION   (1)
+
+// Image views of dynamically registered images kept alive across frames, see ffxSetImageViewCacheBudgetVK
+#define FFX_IMAGE_VIEW_CACHE_CAPACITY     (1024)
+#define FFX_DYNAMIC_VIEW_COUNT            (FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2)
+
+typedef struct PipelineCacheBlobHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint32_t keyCount;
+    uint8_t  pipelineCacheUUID[VK_UUID_SIZE];
+    uint8_t  driverUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+    uint64_t checksum;      // FNV-1a over the keys and the data
+} PipelineCacheBlobHeader;
+
+// Locks of the state shared by the effect contexts of a backend. They live in the scratch memory after BackendContext_VK,
+// constructed when the first effect context is created and destroyed with the last one, so clearing the context never
+// writes over a live lock
+typedef struct BackendLocks_VK {
+    std::mutex              imageViewCache;
+    std::mutex              descriptorPool;
+    std::mutex              recorder;
+    std::mutex              uniformBuffer;
+} BackendLocks_VK;
+
 typedef struct BackendContext_VK {
 
     // store for resources and resourceViews
@@ -89,7 +151,9 @@ typedef struct BackendContext_VK {
 
         FfxResourceDescription  resourceDescription;
         FfxResourceStates       initialState;
-        FfxResourceStates       currentState;
+        FfxResourceStates       currentStates[FFX_MAX_TRACKED_MIP_COUNT];   // per mip for images, buffers only use the first entry
+        uint32_t                scheduledMips;                              // mips already transitioned in the barrier batch scheduledBarrierBatch
+        uint64_t                scheduledBarrierBatch;
         int32_t                 srvViewIndex;
         int32_t                 uavViewIndex;
         uint32_t                uavViewCount;
@@ -103,12 +167,32 @@ typedef struct BackendContext_VK {
 
     } Resource;
 
+    // One descriptor written to a cached set, the sets are only reused when all of them match
+    typedef struct DescriptorSetKeyEntry {
+        uint32_t                binding;
+        uint32_t                arrayElement;
+        VkDescriptorType        descriptorType;
+        VkImageLayout           imageLayout;
+        uint64_t                handle;     // image view or buffer
+        VkDeviceSize            offset;
+        VkDeviceSize            range;
+    } DescriptorSetKeyEntry;
+
     typedef struct PipelineLayout {
 
         VkSampler               samplers[FFX_MAX_SAMPLERS];
         VkDescriptorSetLayout   descriptorSetLayout;
-        VkDescriptorSet         descriptorSets[FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME];
-        uint32_t                descriptorSetIndex;
+        VkDescriptorSet         descriptorSets[FFX_MAX_CACHED_DESCRIPTOR_SETS];
+        uint64_t                descriptorSetHashes[FFX_MAX_CACHED_DESCRIPTOR_SETS];    // hash of the bindings written to each set, 0 once invalidated
+        DescriptorSetKeyEntry*  descriptorSetKeys;                                      // descriptorSetKeyCapacity entries per set, allocated with the first set
+        uint32_t                descriptorSetKeyCapacity;                               // descriptors in the layout, each write holds one
+        uint32_t                descriptorSetKeyCounts[FFX_MAX_CACHED_DESCRIPTOR_SETS]; // descriptors written to each set
+        uint64_t                descriptorSetHandleMasks[FFX_MAX_CACHED_DESCRIPTOR_SETS];  // getDescriptorHandleBit of every view and buffer written to each set
+        uint64_t                descriptorSetExpiryFrames[FFX_MAX_CACHED_DESCRIPTOR_SETS]; // frameCount at which views created for the frame it was written in are destroyed
+        uint64_t                descriptorSetFrames[FFX_MAX_CACHED_DESCRIPTOR_SETS];    // frameCount of the effect context when each set was last bound
+        uint8_t                 descriptorSetPools[FFX_MAX_CACHED_DESCRIPTOR_SETS];     // index of the pool each set was allocated from
+        uint32_t                descriptorSetCount;                                     // sets are allocated on demand
+        bool                    pushDescriptors;
         VkPipelineLayout        pipelineLayout;
         int32_t                 staticTextureSrvSet;
         int32_t                 staticBufferSrvSet;
@@ -152,10 +236,13 @@ typedef struct BackendContext_VK {
         PFN_vkBindBufferMemory                  vkBindBufferMemory = 0;
         PFN_vkBindImageMemory                   vkBindImageMemory = 0;
         PFN_vkUpdateDescriptorSets              vkUpdateDescriptorSets = 0;
+        PFN_vkResetDescriptorPool               vkResetDescriptorPool = 0;
         PFN_vkFlushMappedMemoryRanges           vkFlushMappedMemoryRanges = 0;
         PFN_vkCmdPipelineBarrier                vkCmdPipelineBarrier = 0;
+        PFN_vkCmdPipelineBarrier2KHR            vkCmdPipelineBarrier2KHR = 0;
         PFN_vkCmdBindPipeline                   vkCmdBindPipeline = 0;
         PFN_vkCmdBindDescriptorSets             vkCmdBindDescriptorSets = 0;
+        PFN_vkCmdPushDescriptorSetKHR           vkCmdPushDescriptorSetKHR = 0;
         PFN_vkCmdDispatch                       vkCmdDispatch = 0;
         PFN_vkCmdDispatchIndirect               vkCmdDispatchIndirect = 0;
         PFN_vkCmdCopyBuffer                     vkCmdCopyBuffer = 0;
@@ -170,35 +257,128 @@ typedef struct BackendContext_VK {
 
     } VkFunctionTable;
 
+    // Survives the backend being torn down when the last effect context is destroyed,
+    // it is owned by the application through ffxCreatePipelineCacheVK / ffxDestroyPipelineCacheVK
+    typedef struct PipelineCache {
+
+        VkDevice                        device;
+        VkPipelineCache                 pipelineCache;
+        PFN_vkDestroyPipelineCache      vkDestroyPipelineCache;
+        PFN_vkGetPipelineCacheData      vkGetPipelineCacheData;
+        VkPhysicalDeviceProperties      physicalDeviceProperties;
+        uint8_t                         driverUUID[VK_UUID_SIZE];
+        FfxPipelineCacheStatisticsVK    statistics;
+        uint32_t                        keyCount;
+        uint64_t                        keys[FFX_PIPELINE_CACHE_KEY_CAPACITY];  // open addressing set, 0 marks an empty slot
+    } PipelineCache;
+
+    // Only the views of dynamically registered images are cached, all with identity swizzle and
+    // all array layers, so those are not part of the key. Empty slots have a null imageView.
+    typedef struct ImageViewCacheEntry {
+
+        VkImage             image;
+        VkImageViewType     viewType;
+        VkFormat            format;
+        VkImageAspectFlags  aspectMask;
+        uint32_t            baseMipLevel;
+        uint32_t            levelCount;
+        VkImageUsageFlags   usage;              // from VkImageViewUsageCreateInfo, 0 if not chained
+        uint32_t            effectContextId;
+        VkImageView         imageView;
+        uint64_t            lastUsedFrame;      // frameCount of the effect context when last registered
+        uint64_t            lastUsedTick;
+    } ImageViewCacheEntry;
+
+    typedef struct ImageViewCache {
+
+        uint32_t                        budget;     // 0 when the cache is disabled
+        uint32_t                        count;
+        uint64_t                        tick;
+        FfxImageViewCacheStatisticsVK   statistics;
+        ImageViewCacheEntry             entries[FFX_IMAGE_VIEW_CACHE_CAPACITY];  // open addressing with linear probing
+    } ImageViewCache;
+
     uint32_t refCount;
     uint32_t maxEffectContexts;
+    BackendLocks_VK* pLocks;    // null while no effect context exists
+
+    PipelineCache           pipelineCache;
+    ImageViewCache          imageViewCache;
 
     VkDevice                device = VK_NULL_HANDLE;
     VkPhysicalDevice        physicalDevice = VK_NULL_HANDLE;
     VkFunctionTable         vkFunctionTable = {};
 
-    FfxGpuJobDescription*   pGpuJobs;
-    uint32_t                gpuJobCount = 0;
-
     typedef struct VkResourceView {
         VkImageView imageView;
     } VkResourceView;
     VkResourceView*         pResourceViews;
-
-    uint8_t*                pStagingRingBuffer;
-    uint32_t                stagingRingBufferBase = 0;
+    VkResourceView*         bindlessViewChunks[FFX_MAX_BINDLESS_DESCRIPTOR_COUNT / FFX_BINDLESS_VIEW_CHUNK_SIZE];
+    uint32_t                peakBindlessViewCount = 0;
 
     PipelineLayout*         pPipelineLayouts;
 
-    VkDescriptorPool        descriptorPool;
+    // Pools of the cached descriptor sets, added when the existing ones are full
+    typedef struct DescriptorPool {
+        VkDescriptorPool    descriptorPool;
+        uint32_t            maxSets;
+        uint32_t            setCount;
+        uint32_t            descriptorCount;
+    } DescriptorPool;
+    DescriptorPool          descriptorPools[FFX_MAX_DESCRIPTOR_POOLS];
+    uint32_t                descriptorPoolCount = 0;
+    uint32_t                layoutDescriptorCounts[FFX_DESCRIPTOR_POOL_TYPE_COUNT];    // largest count of each type in a descriptor set layout so far
+    uint32_t                layoutDescriptorCountsVersion = 0;                          // advanced whenever layoutDescriptorCounts grows
+    uint32_t                descriptorSetCount = 0;
+    uint32_t                peakDescriptorSetCount = 0;
+
     uint32_t                bindlessBase;
 
-    VkImageMemoryBarrier    imageMemoryBarriers[FFX_MAX_BARRIERS] = {};
-    VkBufferMemoryBarrier   bufferMemoryBarriers[FFX_MAX_BARRIERS] = {};
-    uint32_t                scheduledImageBarrierCount = 0;
-    uint32_t                scheduledBufferBarrierCount = 0;
-    VkPipelineStageFlags    srcStageMask = 0;
-    VkPipelineStageFlags    dstStageMask = 0;
+    // Descriptors
+    uint32_t                    maxPushDescriptors = 0;     // 0 when VK_KHR_push_descriptor is not available
+
+    // Recording state of one thread, acquired when it first schedules a job or stages constants and released once
+    // ExecuteGpuJobsVK has recorded its jobs, so effect contexts can record into different command buffers in parallel
+    typedef struct StagingOverflowBlock {
+        StagingOverflowBlock*   pNext;
+        uint64_t                padding;    // keeps the constants that follow 16 byte aligned
+    } StagingOverflowBlock;
+    typedef struct Recorder {
+        std::thread::id             owner;
+        bool                        active;
+        uint32_t                    index;
+
+        FfxGpuJobDescription*       gpuJobChunks[FFX_MAX_GPU_JOBS / FFX_GPU_JOB_CHUNK_SIZE];
+        uint32_t                    gpuJobCount;
+        uint32_t                    peakGpuJobCount;
+
+        // CPU copies of the constants referenced by scheduled jobs, read when ExecuteGpuJobsVK copies them to the uniform buffer
+        uint8_t*                    pStagingRingBuffer;
+        uint32_t                    stagingRingBufferBase;
+        uint32_t                    stagingRingBufferPending;   // bytes of the ring not executed yet
+        StagingOverflowBlock*       pStagingOverflowBlocks;     // constants staged while the ring was full, freed after the next execution
+        uint64_t                    peakStagingUsage;
+        uint32_t                    stagingOverflowCount;
+
+        // Barriers are batched with per barrier stages, and converted to the legacy structures when synchronization2 is unavailable
+        VkImageMemoryBarrier2KHR    imageMemoryBarriers[FFX_MAX_BARRIERS];
+        VkBufferMemoryBarrier2KHR   bufferMemoryBarriers[FFX_MAX_BARRIERS];
+        VkImageMemoryBarrier        legacyImageMemoryBarriers[FFX_MAX_BARRIERS];
+        VkBufferMemoryBarrier       legacyBufferMemoryBarriers[FFX_MAX_BARRIERS];
+        uint32_t                    scheduledImageBarrierCount;
+        uint32_t                    scheduledBufferBarrierCount;
+        uint32_t                    droppedBarrierCount;
+        uint64_t                    barrierBatch;               // unique across recorders, the index is in the top bits
+
+        FfxDescriptorStatisticsVK   descriptorStatistics;
+    } Recorder;
+    Recorder*               recorders[FFX_MAX_RECORDERS];
+    uint32_t                recorderCount = 0;
+    uint64_t                recorderGeneration = 0;             // tells a thread its cached recorder belongs to an earlier backend in the same memory
+
+    bool                        synchronization2 = false;
+    FfxBarrierFlushCallbackVK   barrierFlushCallback = nullptr;
+    void*                       barrierFlushUserData = nullptr;
 
     typedef struct alignas(32) EffectContext {
 
@@ -236,6 +416,23 @@ typedef struct BackendContext_VK {
         // the frame index for the context
         uint32_t              frameIndex;
 
+        // the number of frames unregistered since the context was created
+        uint64_t              frameCount;
+
+        // dynamic resource views owned by the image view cache, which must not be destroyed with the frame
+        uint32_t              cachedDynamicViews[FFX_DYNAMIC_VIEW_COUNT / 32];
+
+        // descriptor sets for dispatches that find every cached set of their pipeline in flight, reset when the frame comes around again
+        VkDescriptorPool      transientDescriptorPools[FFX_MAX_QUEUED_FRAMES];
+        uint32_t              transientDescriptorPoolVersions[FFX_MAX_QUEUED_FRAMES];   // layoutDescriptorCountsVersion each pool was sized for
+
+        // getDescriptorHandleBit of the views and buffers destroyed before their frame ended since the cached descriptor sets
+        // were last checked, set from any thread as the image view cache evicts views of other effect contexts
+        std::atomic<uint64_t> destroyedDescriptorHandles;
+
+        // bytes used in the uniform buffer partition of the current frame
+        VkDeviceSize          uniformBufferOffset;
+
         // Usage
         bool                  active;
 
@@ -248,15 +445,22 @@ typedef struct BackendContext_VK {
     EffectContext*          pEffectContexts;
 
      // Allocation defaults
-    FfxConstantAllocation FallbackConstantAllocator(void* data, FfxUInt64 dataSize);
+    FfxConstantAllocation FallbackConstantAllocator(void* data, FfxUInt64 dataSize, FfxUInt32 effectContextId);
     VkDeviceMemory        uniformBufferMemory = VK_NULL_HANDLE;
     VkMemoryPropertyFlags uniformBufferMemoryProperties;
     VkDeviceSize          uniformBufferAlignment = 0;
     void*                 uniformBufferMem       = nullptr;
     VkBuffer              uniformBuffer          = VK_NULL_HANDLE;
     VkDeviceSize          uniformBufferSize      = 0;
-    VkDeviceSize          uniformBufferOffset    = 0;
-    std::mutex            uniformBufferMutex;
+    VkDeviceSize          uniformBufferPartitionSize = 0;    // per effect context and queued frame
+
+    typedef struct RetiredUniformBuffer {
+        VkBuffer            buffer;
+        VkDeviceMemory      memory;
+    } RetiredUniformBuffer;
+    RetiredUniformBuffer  retiredUniformBuffers[FFX_MAX_RETIRED_UNIFORM_BUFFERS + 1];
+    uint32_t              retiredUniformBufferCount = 0;
+    FfxConstantBufferStatisticsVK constantBufferStatistics = {};
 
     uint32_t                numDeviceExtensions = 0;
     VkExtensionProperties*  extensionProperties = nullptr;
@@ -279,16 +483,18 @@ FFX_API size_t ffxGetScratchMemorySizeVK(VkPhysicalDevice physicalDevice, size_t
     if (physicalDevice)
         vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &numExtensions, nullptr);
 
+    // gpu jobs, staging rings and bindless views are allocated with the recorders or in chunks when first needed
     uint32_t extensionPropArraySize = sizeof(VkExtensionProperties) * numExtensions;
-    uint32_t gpuJobDescArraySize = FFX_ALIGN_UP(maxContexts * FFX_MAX_GPU_JOBS * sizeof(FfxGpuJobDescription), sizeof(uint32_t));
-    uint32_t resourceViewArraySize = FFX_ALIGN_UP(((maxContexts * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2) + FFX_MAX_BINDLESS_DESCRIPTOR_COUNT) * sizeof(BackendContext_VK::VkResourceView), sizeof(uint32_t));
-    uint32_t stagingRingBufferArraySize = FFX_ALIGN_UP(maxContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE, sizeof(uint32_t));
+    uint32_t locksSize = FFX_ALIGN_UP(sizeof(BackendLocks_VK), sizeof(uint64_t));
+    uint32_t resourceViewArraySize = FFX_ALIGN_UP(maxContexts * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2 * sizeof(BackendContext_VK::VkResourceView), sizeof(uint32_t));
     uint32_t pipelineArraySize = FFX_ALIGN_UP(maxContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_VK::PipelineLayout), sizeof(uint32_t));
     uint32_t resourceArraySize = FFX_ALIGN_UP(maxContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BackendContext_VK::Resource), sizeof(uint32_t));
     uint32_t contextArraySize = FFX_ALIGN_UP(maxContexts * sizeof(BackendContext_VK::EffectContext), sizeof(uint32_t));
+    // the effect context array is placed at its alignment, which the scratch memory itself may not have
+    uint32_t contextAlignmentSize = alignof(BackendContext_VK::EffectContext);
     
-    return FFX_ALIGN_UP(sizeof(BackendContext_VK) + extensionPropArraySize + gpuJobDescArraySize + resourceViewArraySize + stagingRingBufferArraySize +
-                            pipelineArraySize + resourceArraySize + contextArraySize,
+    return FFX_ALIGN_UP(sizeof(BackendContext_VK) + locksSize + extensionPropArraySize + resourceViewArraySize +
+                            pipelineArraySize + resourceArraySize + contextAlignmentSize + contextArraySize,
                         sizeof(uint64_t));
 }
 
@@ -351,7 +557,7 @@ FfxErrorCode ffxGetInterfaceVK(
 
     FFX_RETURN_ON_ERROR(!backendContext->refCount, FFX_ERROR_BACKEND_API_ERROR);
 
-    // Clear everything out
+    // Clear everything out, the locks are only constructed while an effect context exists
     memset(backendContext, 0, sizeof(*backendContext));
 
     // Map the device
@@ -363,6 +569,582 @@ FfxErrorCode ffxGetInterfaceVK(
     return FFX_OK;
 }
 
+static uint64_t hashPipelineCacheBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static bool insertPipelineCacheKey(BackendContext_VK::PipelineCache& cache, uint64_t key)
+{
+    FFX_ASSERT(key != 0);
+    for (uint32_t probe = 0; probe < FFX_PIPELINE_CACHE_KEY_CAPACITY; ++probe)
+    {
+        uint64_t& slot = cache.keys[(key + probe) & (FFX_PIPELINE_CACHE_KEY_CAPACITY - 1)];
+        if (slot == key)
+            return false;
+        if (slot == 0)
+        {
+            // keep the table at most three quarters full so lookups stay short
+            if (cache.keyCount >= FFX_PIPELINE_CACHE_KEY_CAPACITY * 3 / 4)
+                return false;
+            slot = key;
+            ++cache.keyCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool containsPipelineCacheKey(const BackendContext_VK::PipelineCache& cache, uint64_t key)
+{
+    for (uint32_t probe = 0; probe < FFX_PIPELINE_CACHE_KEY_CAPACITY; ++probe)
+    {
+        const uint64_t slot = cache.keys[(key + probe) & (FFX_PIPELINE_CACHE_KEY_CAPACITY - 1)];
+        if (slot == key)
+            return true;
+        if (slot == 0)
+            return false;
+    }
+    return false;
+}
+
+// Checks that a blob was written for this device and driver and has not been truncated or corrupted
+static bool validatePipelineCacheBlob(const BackendContext_VK::PipelineCache& cache, const void* pData, size_t dataSize)
+{
+    if (dataSize < sizeof(PipelineCacheBlobHeader))
+        return false;
+
+    PipelineCacheBlobHeader header;
+    memcpy(&header, pData, sizeof(header));
+
+    if (header.magic != FFX_PIPELINE_CACHE_BLOB_MAGIC || header.version != FFX_PIPELINE_CACHE_BLOB_VERSION)
+        return false;
+
+    const VkPhysicalDeviceProperties& properties = cache.physicalDeviceProperties;
+    if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID || header.driverVersion != properties.driverVersion ||
+        memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0 ||
+        memcmp(header.driverUUID, cache.driverUUID, VK_UUID_SIZE) != 0)
+        return false;
+
+    const size_t keysSize = header.keyCount * sizeof(uint64_t);
+    if (header.keyCount > FFX_PIPELINE_CACHE_KEY_CAPACITY || dataSize - sizeof(header) < keysSize || dataSize - sizeof(header) - keysSize != header.dataSize)
+        return false;
+
+    const uint8_t* pPayload = (const uint8_t*)pData + sizeof(header);
+    if (hashPipelineCacheBytes(0xcbf29ce484222325ull, pPayload, keysSize + header.dataSize) != header.checksum)
+        return false;
+
+    // the driver's own header has to agree as well
+    VkPipelineCacheHeaderVersionOne vkHeader;
+    if (header.dataSize < sizeof(vkHeader))
+        return false;
+    memcpy(&vkHeader, pPayload + keysSize, sizeof(vkHeader));
+
+    return vkHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE && vkHeader.vendorID == properties.vendorID &&
+           vkHeader.deviceID == properties.deviceID && memcmp(vkHeader.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+FfxErrorCode ffxCreatePipelineCacheVK(FfxInterface* backendInterface, const void* pInitialData, size_t initialDataSize)
+{
+    FFX_RETURN_ON_ERROR(backendInterface, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pInitialData || !initialDataSize, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK::PipelineCache& cache = backendContext->pipelineCache;
+    FFX_RETURN_ON_ERROR(cache.pipelineCache == VK_NULL_HANDLE, FFX_ERROR_INVALID_ARGUMENT);
+
+    VkDeviceContext* vkDeviceContext = reinterpret_cast<VkDeviceContext*>(backendInterface->device);
+    FFX_RETURN_ON_ERROR(vkDeviceContext && vkDeviceContext->vkDevice && vkDeviceContext->vkPhysicalDevice, FFX_ERROR_NULL_DEVICE);
+
+    PFN_vkGetDeviceProcAddr getDeviceProcAddr = vkDeviceContext->vkDeviceProcAddr ? vkDeviceContext->vkDeviceProcAddr : vkGetDeviceProcAddr;
+    PFN_vkCreatePipelineCache createPipelineCache = (PFN_vkCreatePipelineCache)getDeviceProcAddr(vkDeviceContext->vkDevice, "vkCreatePipelineCache");
+
+    memset(&cache, 0, sizeof(cache));
+    cache.device                 = vkDeviceContext->vkDevice;
+    cache.vkDestroyPipelineCache = (PFN_vkDestroyPipelineCache)getDeviceProcAddr(vkDeviceContext->vkDevice, "vkDestroyPipelineCache");
+    cache.vkGetPipelineCacheData = (PFN_vkGetPipelineCacheData)getDeviceProcAddr(vkDeviceContext->vkDevice, "vkGetPipelineCacheData");
+    FFX_RETURN_ON_ERROR(createPipelineCache && cache.vkDestroyPipelineCache && cache.vkGetPipelineCacheData, FFX_ERROR_BACKEND_API_ERROR);
+
+    // the driver UUID identifies the driver build, on top of what the pipeline cache UUID covers
+    VkPhysicalDeviceIDProperties idProperties = {};
+    idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 deviceProperties2 = {};
+    deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    deviceProperties2.pNext = &idProperties;
+    vkGetPhysicalDeviceProperties2(vkDeviceContext->vkPhysicalDevice, &deviceProperties2);
+
+    cache.physicalDeviceProperties = deviceProperties2.properties;
+    memcpy(cache.driverUUID, idProperties.driverUUID, VK_UUID_SIZE);
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    // a blob from another device or driver is dropped and the cache starts out empty
+    if (initialDataSize)
+    {
+        if (validatePipelineCacheBlob(cache, pInitialData, initialDataSize))
+        {
+            PipelineCacheBlobHeader header;
+            memcpy(&header, pInitialData, sizeof(header));
+
+            const uint64_t* pKeys = (const uint64_t*)((const uint8_t*)pInitialData + sizeof(header));
+            for (uint32_t keyIndex = 0; keyIndex < header.keyCount; ++keyIndex)
+            {
+                uint64_t key;
+                memcpy(&key, pKeys + keyIndex, sizeof(key));
+                if (key != 0)
+                    insertPipelineCacheKey(cache, key);
+            }
+
+            createInfo.initialDataSize = (size_t)header.dataSize;
+            createInfo.pInitialData    = pKeys + header.keyCount;
+            cache.statistics.loadedPipelineCount = cache.keyCount;
+        }
+        else
+        {
+            cache.statistics.initialDataRejected = true;
+        }
+    }
+
+    if (createPipelineCache(cache.device, &createInfo, nullptr, &cache.pipelineCache) != VK_SUCCESS)
+    {
+        // the driver may still refuse data that passed our checks, fall back to an empty cache
+        memset(cache.keys, 0, sizeof(cache.keys));
+        cache.keyCount                          = 0;
+        cache.statistics.loadedPipelineCount = 0;
+        cache.statistics.initialDataRejected = initialDataSize != 0;
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData    = nullptr;
+        if (createPipelineCache(cache.device, &createInfo, nullptr, &cache.pipelineCache) != VK_SUCCESS)
+        {
+            memset(&cache, 0, sizeof(cache));
+            return FFX_ERROR_BACKEND_API_ERROR;
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetPipelineCacheDataVK(FfxInterface* backendInterface, void* pData, size_t* pDataSize)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pDataSize, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK::PipelineCache& cache = backendContext->pipelineCache;
+    FFX_RETURN_ON_ERROR(cache.pipelineCache != VK_NULL_HANDLE, FFX_ERROR_INVALID_ARGUMENT);
+
+    size_t vkDataSize = 0;
+    FFX_RETURN_ON_ERROR(cache.vkGetPipelineCacheData(cache.device, cache.pipelineCache, &vkDataSize, nullptr) == VK_SUCCESS, FFX_ERROR_BACKEND_API_ERROR);
+
+    const size_t keysSize = cache.keyCount * sizeof(uint64_t);
+    const size_t blobSize = sizeof(PipelineCacheBlobHeader) + keysSize + vkDataSize;
+    if (!pData)
+    {
+        *pDataSize = blobSize;
+        return FFX_OK;
+    }
+    FFX_RETURN_ON_ERROR(*pDataSize >= blobSize, FFX_ERROR_INSUFFICIENT_MEMORY);
+
+    uint8_t* pKeys   = (uint8_t*)pData + sizeof(PipelineCacheBlobHeader);
+    uint8_t* pVkData = pKeys + keysSize;
+    for (uint32_t slot = 0, keyIndex = 0; slot < FFX_PIPELINE_CACHE_KEY_CAPACITY; ++slot)
+    {
+        if (cache.keys[slot] != 0)
+            memcpy(pKeys + (keyIndex++) * sizeof(uint64_t), &cache.keys[slot], sizeof(uint64_t));
+    }
+
+    // the driver data can only have grown since the size query if pipelines were created in between
+    VkResult result = cache.vkGetPipelineCacheData(cache.device, cache.pipelineCache, &vkDataSize, pVkData);
+    FFX_RETURN_ON_ERROR(result == VK_SUCCESS, result == VK_INCOMPLETE ? FFX_ERROR_INSUFFICIENT_MEMORY : FFX_ERROR_BACKEND_API_ERROR);
+
+    PipelineCacheBlobHeader header = {};
+    header.magic         = FFX_PIPELINE_CACHE_BLOB_MAGIC;
+    header.version       = FFX_PIPELINE_CACHE_BLOB_VERSION;
+    header.vendorID      = cache.physicalDeviceProperties.vendorID;
+    header.deviceID      = cache.physicalDeviceProperties.deviceID;
+    header.driverVersion = cache.physicalDeviceProperties.driverVersion;
+    header.keyCount      = cache.keyCount;
+    memcpy(header.pipelineCacheUUID, cache.physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+    memcpy(header.driverUUID, cache.driverUUID, VK_UUID_SIZE);
+    header.dataSize      = vkDataSize;
+    header.checksum      = hashPipelineCacheBytes(0xcbf29ce484222325ull, pKeys, keysSize + vkDataSize);
+    memcpy(pData, &header, sizeof(header));
+
+    *pDataSize = sizeof(PipelineCacheBlobHeader) + keysSize + vkDataSize;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetPipelineCacheStatisticsVK(FfxInterface* backendInterface, FfxPipelineCacheStatisticsVK* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    *pStatistics = backendContext->pipelineCache.statistics;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxDestroyPipelineCacheVK(FfxInterface* backendInterface)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK::PipelineCache& cache = backendContext->pipelineCache;
+    if (cache.pipelineCache != VK_NULL_HANDLE)
+        cache.vkDestroyPipelineCache(cache.device, cache.pipelineCache, nullptr);
+
+    memset(&cache, 0, sizeof(cache));
+    return FFX_OK;
+}
+
+static uint32_t getImageViewCacheHomeSlot(const BackendContext_VK::ImageViewCacheEntry& entry)
+{
+    const uint32_t fields[] = { (uint32_t)entry.viewType, (uint32_t)entry.format, entry.aspectMask, entry.baseMipLevel, entry.levelCount, entry.usage, entry.effectContextId };
+    uint64_t hash = hashPipelineCacheBytes(0xcbf29ce484222325ull, &entry.image, sizeof(entry.image));
+    hash = hashPipelineCacheBytes(hash, fields, sizeof(fields));
+    return (uint32_t)(hash ^ (hash >> 32)) & (FFX_IMAGE_VIEW_CACHE_CAPACITY - 1);
+}
+
+// Bloom filter bit of a view or buffer handle written to a descriptor set
+template<typename Handle>
+static uint64_t getDescriptorHandleBit(Handle handle)
+{
+    return 1ull << (hashPipelineCacheBytes(0xcbf29ce484222325ull, &handle, sizeof(handle)) >> 58);
+}
+
+// A new view or buffer may be created with the handle of a destroyed one, so the cached descriptor sets that may
+// hold the handle must not be matched again. Called before the handle is destroyed, for views and buffers that
+// outlive a frame, the views created for a single frame are covered by the expiry of the sets holding them.
+template<typename Handle>
+static void retireDescriptorHandle(BackendContext_VK* backendContext, uint32_t effectContextId, Handle handle)
+{
+    backendContext->pEffectContexts[effectContextId].destroyedDescriptorHandles.fetch_or(getDescriptorHandleBit(handle), std::memory_order_release);
+}
+
+// Whether a view is destroyed once the frame it was created for comes around again, rather than with its resource or by the image view cache
+static bool isFrameImageView(BackendContext_VK* backendContext, uint32_t effectContextId, uint32_t viewIndex)
+{
+    const BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    if (viewIndex < effectContext.nextStaticResourceView)
+        return false;
+    return !(effectContext.cachedDynamicViews[(viewIndex % FFX_DYNAMIC_VIEW_COUNT) / 32] & (1u << (viewIndex % 32)));
+}
+
+static bool isSameImageView(const BackendContext_VK::ImageViewCacheEntry& a, const BackendContext_VK::ImageViewCacheEntry& b)
+{
+    return a.image == b.image && a.viewType == b.viewType && a.format == b.format && a.aspectMask == b.aspectMask &&
+           a.baseMipLevel == b.baseMipLevel && a.levelCount == b.levelCount && a.usage == b.usage && a.effectContextId == b.effectContextId;
+}
+
+// Destroy the view of a slot and shift the following entries of its probe sequence back so lookups still find them
+static void removeImageViewCacheEntry(BackendContext_VK* backendContext, uint32_t slot)
+{
+    BackendContext_VK::ImageViewCache& cache = backendContext->imageViewCache;
+    retireDescriptorHandle(backendContext, cache.entries[slot].effectContextId, cache.entries[slot].imageView);
+    backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, cache.entries[slot].imageView, nullptr);
+
+    uint32_t hole = slot;
+    for (uint32_t next = (slot + 1) & (FFX_IMAGE_VIEW_CACHE_CAPACITY - 1); cache.entries[next].imageView != VK_NULL_HANDLE;
+         next = (next + 1) & (FFX_IMAGE_VIEW_CACHE_CAPACITY - 1))
+    {
+        // entries whose home slot lies cyclically in (hole, next] are still reachable
+        const uint32_t home = getImageViewCacheHomeSlot(cache.entries[next]);
+        const bool reachable = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!reachable)
+        {
+            cache.entries[hole] = cache.entries[next];
+            hole = next;
+        }
+    }
+
+    memset(&cache.entries[hole], 0, sizeof(cache.entries[hole]));
+    --cache.count;
+    cache.statistics.residentViewCount = cache.count;
+}
+
+// Evict the least recently used view that no queued frame can reference anymore
+static bool evictImageView(BackendContext_VK* backendContext)
+{
+    BackendContext_VK::ImageViewCache& cache = backendContext->imageViewCache;
+
+    uint32_t victim = FFX_IMAGE_VIEW_CACHE_CAPACITY;
+    for (uint32_t slot = 0; slot < FFX_IMAGE_VIEW_CACHE_CAPACITY; ++slot)
+    {
+        const BackendContext_VK::ImageViewCacheEntry& entry = cache.entries[slot];
+        if (entry.imageView == VK_NULL_HANDLE)
+            continue;
+
+        const BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[entry.effectContextId];
+        if (effectContext.frameCount < entry.lastUsedFrame + FFX_MAX_QUEUED_FRAMES)
+            continue;
+
+        if (victim == FFX_IMAGE_VIEW_CACHE_CAPACITY || entry.lastUsedTick < cache.entries[victim].lastUsedTick)
+            victim = slot;
+    }
+
+    if (victim == FFX_IMAGE_VIEW_CACHE_CAPACITY)
+        return false;
+
+    removeImageViewCacheEntry(backendContext, victim);
+    ++cache.statistics.evictionCount;
+    return true;
+}
+
+static void destroyCachedImageViews(BackendContext_VK* backendContext, VkImage image, uint32_t effectContextId)
+{
+    // every cached view belongs to an effect context, and the lock only exists while there is one
+    if (!backendContext->pLocks)
+        return;
+
+    std::lock_guard<std::mutex> lock{backendContext->pLocks->imageViewCache};
+    BackendContext_VK::ImageViewCache& cache = backendContext->imageViewCache;
+    for (uint32_t slot = 0; slot < FFX_IMAGE_VIEW_CACHE_CAPACITY && cache.count;)
+    {
+        const BackendContext_VK::ImageViewCacheEntry& entry = cache.entries[slot];
+        if (entry.imageView != VK_NULL_HANDLE && (image == VK_NULL_HANDLE || entry.image == image) &&
+            (effectContextId == UINT32_MAX || entry.effectContextId == effectContextId))
+        {
+            // the backward shift may move another entry into this slot, so look at it again
+            removeImageViewCacheEntry(backendContext, slot);
+            continue;
+        }
+        ++slot;
+    }
+}
+
+// Get the view for a dynamic resource view slot, from the image view cache when it is enabled
+static VkResult acquireImageView(BackendContext_VK* backendContext, uint32_t effectContextId, const VkImageViewCreateInfo& createInfo, uint32_t viewIndex)
+{
+    BackendContext_VK::ImageViewCache& cache = backendContext->imageViewCache;
+    VkImageView& imageView = backendContext->pResourceViews[viewIndex].imageView;
+    if (!cache.budget)
+        return backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &createInfo, nullptr, &imageView);
+
+    // the cache is shared by the effect contexts, which may be recorded on different threads
+    std::lock_guard<std::mutex> lock{backendContext->pLocks->imageViewCache};
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+
+    BackendContext_VK::ImageViewCacheEntry key = {};
+    key.image           = createInfo.image;
+    key.viewType        = createInfo.viewType;
+    key.format          = createInfo.format;
+    key.aspectMask      = createInfo.subresourceRange.aspectMask;
+    key.baseMipLevel    = createInfo.subresourceRange.baseMipLevel;
+    key.levelCount      = createInfo.subresourceRange.levelCount;
+    key.usage           = createInfo.pNext ? ((const VkImageViewUsageCreateInfo*)createInfo.pNext)->usage : 0;
+    key.effectContextId = effectContextId;
+
+    const uint32_t home = getImageViewCacheHomeSlot(key);
+    for (uint32_t probe = 0; probe < FFX_IMAGE_VIEW_CACHE_CAPACITY; ++probe)
+    {
+        BackendContext_VK::ImageViewCacheEntry& entry = cache.entries[(home + probe) & (FFX_IMAGE_VIEW_CACHE_CAPACITY - 1)];
+        if (entry.imageView == VK_NULL_HANDLE)
+            break;
+
+        if (isSameImageView(entry, key))
+        {
+            entry.lastUsedFrame = effectContext.frameCount;
+            entry.lastUsedTick  = ++cache.tick;
+            imageView = entry.imageView;
+            effectContext.cachedDynamicViews[(viewIndex % FFX_DYNAMIC_VIEW_COUNT) / 32] |= 1u << (viewIndex % 32);
+            ++cache.statistics.hitCount;
+            return VK_SUCCESS;
+        }
+    }
+
+    const VkResult result = backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &createInfo, nullptr, &imageView);
+    if (result != VK_SUCCESS)
+        return result;
+
+    while (cache.count >= cache.budget && evictImageView(backendContext))
+        ;
+
+    // when every cached view may still be in flight, the new one lives for this frame only
+    if (cache.count >= cache.budget)
+    {
+        ++cache.statistics.uncachedCreateCount;
+        return VK_SUCCESS;
+    }
+
+    uint32_t slot = home;
+    while (cache.entries[slot].imageView != VK_NULL_HANDLE)
+        slot = (slot + 1) & (FFX_IMAGE_VIEW_CACHE_CAPACITY - 1);
+
+    key.imageView     = imageView;
+    key.lastUsedFrame = effectContext.frameCount;
+    key.lastUsedTick  = ++cache.tick;
+    cache.entries[slot] = key;
+    ++cache.count;
+
+    effectContext.cachedDynamicViews[(viewIndex % FFX_DYNAMIC_VIEW_COUNT) / 32] |= 1u << (viewIndex % 32);
+    cache.statistics.residentViewCount = cache.count;
+    ++cache.statistics.createCount;
+    return VK_SUCCESS;
+}
+
+FfxErrorCode ffxSetImageViewCacheBudgetVK(FfxInterface* backendInterface, uint32_t maxViews)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    BackendContext_VK::ImageViewCache& cache = backendContext->imageViewCache;
+
+    // keep the load factor low enough for short probe sequences
+    cache.budget = FFX_MINIMUM(maxViews, FFX_IMAGE_VIEW_CACHE_CAPACITY * 3 / 4);
+    if (!cache.budget)
+    {
+        destroyCachedImageViews(backendContext, VK_NULL_HANDLE, UINT32_MAX);
+
+        // the views still bound to dynamic resource view slots are gone now
+        for (uint32_t i = 0; i < backendContext->maxEffectContexts && backendContext->pEffectContexts; ++i)
+        {
+            BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[i];
+            for (uint32_t view = 0; view < FFX_DYNAMIC_VIEW_COUNT; ++view)
+            {
+                if (effectContext.cachedDynamicViews[view / 32] & (1u << (view % 32)))
+                    backendContext->pResourceViews[i * FFX_DYNAMIC_VIEW_COUNT + view].imageView = VK_NULL_HANDLE;
+            }
+            memset(effectContext.cachedDynamicViews, 0, sizeof(effectContext.cachedDynamicViews));
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxReleaseImageViewsVK(FfxInterface* backendInterface, VkImage image)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    if (image != VK_NULL_HANDLE)
+        destroyCachedImageViews(backendContext, image, UINT32_MAX);
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetImageViewCacheStatisticsVK(FfxInterface* backendInterface, FfxImageViewCacheStatisticsVK* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    memset(pStatistics, 0, sizeof(FfxImageViewCacheStatisticsVK));
+
+    // the statistics are cleared with the last effect context, along with the locks
+    if (!backendContext->pLocks)
+        return FFX_OK;
+
+    std::lock_guard<std::mutex> lock{backendContext->pLocks->imageViewCache};
+    *pStatistics = backendContext->imageViewCache.statistics;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetDescriptorStatisticsVK(FfxInterface* backendInterface, FfxDescriptorStatisticsVK* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    memset(pStatistics, 0, sizeof(FfxDescriptorStatisticsVK));
+    if (!backendContext->pLocks)
+        return FFX_OK;
+
+    // each recorder counts the descriptor sets of the jobs it recorded
+    std::lock_guard<std::mutex> lock{backendContext->pLocks->recorder};
+    for (uint32_t recorderIndex = 0; recorderIndex < backendContext->recorderCount; ++recorderIndex)
+    {
+        const FfxDescriptorStatisticsVK& recorderStatistics = backendContext->recorders[recorderIndex]->descriptorStatistics;
+        pStatistics->pushCount      += recorderStatistics.pushCount;
+        pStatistics->reuseCount     += recorderStatistics.reuseCount;
+        pStatistics->writeCount     += recorderStatistics.writeCount;
+        pStatistics->transientCount += recorderStatistics.transientCount;
+    }
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetDescriptorPoolStatisticsVK(FfxInterface* backendInterface, FfxDescriptorPoolStatisticsVK* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    memset(pStatistics, 0, sizeof(FfxDescriptorPoolStatisticsVK));
+    if (!backendContext->pLocks)
+        return FFX_OK;
+
+    std::unique_lock<std::mutex> poolLock{backendContext->pLocks->descriptorPool};
+    pStatistics->poolCount = backendContext->descriptorPoolCount;
+    for (uint32_t poolIndex = 0; poolIndex < backendContext->descriptorPoolCount; ++poolIndex)
+    {
+        pStatistics->reservedSetCount        += backendContext->descriptorPools[poolIndex].maxSets;
+        pStatistics->reservedDescriptorCount += backendContext->descriptorPools[poolIndex].descriptorCount;
+    }
+    pStatistics->setCount     = backendContext->descriptorSetCount;
+    pStatistics->peakSetCount = backendContext->peakDescriptorSetCount;
+    poolLock.unlock();
+
+    std::lock_guard<std::mutex> lock{backendContext->pLocks->recorder};
+    for (uint32_t recorderIndex = 0; recorderIndex < backendContext->recorderCount; ++recorderIndex)
+    {
+        const BackendContext_VK::Recorder* recorder = backendContext->recorders[recorderIndex];
+        for (uint32_t chunk = 0; chunk < FFX_MAX_GPU_JOBS / FFX_GPU_JOB_CHUNK_SIZE; ++chunk)
+            pStatistics->gpuJobCapacity += recorder->gpuJobChunks[chunk] ? FFX_GPU_JOB_CHUNK_SIZE : 0;
+        pStatistics->peakGpuJobCount = FFX_MAXIMUM(pStatistics->peakGpuJobCount, recorder->peakGpuJobCount);
+    }
+
+    for (uint32_t chunk = 0; chunk < FFX_MAX_BINDLESS_DESCRIPTOR_COUNT / FFX_BINDLESS_VIEW_CHUNK_SIZE; ++chunk)
+        pStatistics->bindlessViewCapacity += backendContext->bindlessViewChunks[chunk] ? FFX_BINDLESS_VIEW_CHUNK_SIZE : 0;
+    pStatistics->peakBindlessViewCount = backendContext->peakBindlessViewCount;
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxGetConstantBufferStatisticsVK(FfxInterface* backendInterface, FfxConstantBufferStatisticsVK* pStatistics)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pStatistics, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    memset(pStatistics, 0, sizeof(FfxConstantBufferStatisticsVK));
+    if (!backendContext->pLocks)
+        return FFX_OK;
+
+    std::lock_guard<std::mutex> cbLock{backendContext->pLocks->uniformBuffer};
+
+    *pStatistics = backendContext->constantBufferStatistics;
+    pStatistics->uniformBufferSize = backendContext->uniformBufferSize;
+    pStatistics->partitionSize     = backendContext->uniformBufferPartitionSize;
+    pStatistics->alignment         = backendContext->uniformBufferAlignment;
+
+    std::lock_guard<std::mutex> recorderLock{backendContext->pLocks->recorder};
+    for (uint32_t recorderIndex = 0; recorderIndex < backendContext->recorderCount; ++recorderIndex)
+    {
+        const BackendContext_VK::Recorder* recorder = backendContext->recorders[recorderIndex];
+        pStatistics->peakStagingUsage = FFX_MAXIMUM(pStatistics->peakStagingUsage, recorder->peakStagingUsage);
+        pStatistics->stagingOverflowCount += recorder->stagingOverflowCount;
+    }
+    return FFX_OK;
+}
+
+FfxErrorCode ffxSetBarrierFlushCallbackVK(FfxInterface* backendInterface, FfxBarrierFlushCallbackVK callback, void* pUserData)
+{
+    FFX_RETURN_ON_ERROR(backendInterface && backendInterface->scratchBuffer, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    backendContext->barrierFlushCallback = callback;
+    backendContext->barrierFlushUserData = pUserData;
+    return FFX_OK;
+}
+
 FfxCommandList ffxGetCommandListVK(VkCommandBuffer cmdBuf)
 {
     FFX_ASSERT(NULL != cmdBuf);
@@ -972,7 +1754,16 @@ void destroyDynamicViews(BackendContext_VK* backendContext, uint32_t effectConte
     for (uint32_t dynamicViewIndex = effectContext.nextDynamicResourceView[frameIndex] + 1; dynamicViewIndex <= dynamicResourceViewIndexStart;
          ++dynamicViewIndex)
     {
-        backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[dynamicViewIndex].imageView, VK_NULL_HANDLE);
+        // views owned by the image view cache outlive the frame
+        uint32_t& cachedViewBits = effectContext.cachedDynamicViews[(dynamicViewIndex % FFX_DYNAMIC_VIEW_COUNT) / 32];
+        const uint32_t cachedViewBit = 1u << (dynamicViewIndex % 32);
+        if (cachedViewBits & cachedViewBit)
+            cachedViewBits &= ~cachedViewBit;
+        else if (backendContext->pResourceViews[dynamicViewIndex].imageView != VK_NULL_HANDLE)
+        {
+            // descriptor sets holding the view have expired with this frame
+            backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[dynamicViewIndex].imageView, VK_NULL_HANDLE);
+        }
         backendContext->pResourceViews[dynamicViewIndex].imageView = VK_NULL_HANDLE;
     }
     effectContext.nextDynamicResourceView[frameIndex] = dynamicResourceViewIndexStart;
@@ -1076,13 +1867,20 @@ void addMutableViewForSRV(VkImageViewCreateInfo& imageViewCreateInfo, VkImageVie
     }
 }
 
+void setResourceState(BackendContext_VK::Resource* backendResource, FfxResourceStates state)
+{
+    for (uint32_t mip = 0; mip < FFX_MAX_TRACKED_MIP_COUNT; ++mip)
+        backendResource->currentStates[mip] = state;
+    backendResource->scheduledMips = 0;
+}
+
 void copyResourceState(BackendContext_VK::Resource* backendResource, const FfxResource* inFfxResource)
 {
     FfxResourceStates state = inFfxResource->state;
 
     // copy the new states
     backendResource->initialState = state;
-    backendResource->currentState = state;
+    setResourceState(backendResource, state);
     backendResource->undefined    = false;
     backendResource->dynamic      = true;
 
@@ -1149,153 +1947,363 @@ void endMarkerVK(BackendContext_VK* backendContext, VkCommandBuffer commandBuffe
     backendContext->vkFunctionTable.vkCmdEndDebugUtilsLabelEXT(commandBuffer);
 }
 
-void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource, FfxResourceStates newState)
+static bool isWriteState(FfxResourceStates state)
+{
+    return (getVKAccessFlagsFromResourceState(state) & (VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT)) != 0;
+}
+
+// A transition to the state a subresource is already in changes nothing when it is already part of the current
+// batch, or when the state is read only and there are no writes to make visible
+static bool isBarrierRedundant(const BackendContext_VK::Recorder* recorder, const BackendContext_VK::Resource& resource, uint32_t mip, FfxResourceStates newState)
+{
+    if (resource.undefined || resource.currentStates[mip] != newState)
+        return false;
+
+    if (resource.scheduledBarrierBatch == recorder->barrierBatch && (resource.scheduledMips & (1u << mip)))
+        return true;
+
+    return !isWriteState(newState);
+}
+
+static void markBarrierScheduled(const BackendContext_VK::Recorder* recorder, BackendContext_VK::Resource& resource, uint32_t mip)
+{
+    if (resource.scheduledBarrierBatch != recorder->barrierBatch)
+    {
+        resource.scheduledBarrierBatch = recorder->barrierBatch;
+        resource.scheduledMips         = 0;
+    }
+    resource.scheduledMips |= 1u << mip;
+}
+
+// Schedule the transition of a resource, or of a single mip of an image when mip is not negative
+void addBarrier(BackendContext_VK* backendContext, BackendContext_VK::Recorder* recorder, FfxResourceInternal* resource, FfxResourceStates newState, int32_t mip = -1)
 {
     FFX_ASSERT(NULL != backendContext);
+    FFX_ASSERT(NULL != recorder);
     FFX_ASSERT(NULL != resource);
 
     BackendContext_VK::Resource& ffxResource = backendContext->pResources[resource->internalIndex];
 
+    const VkPipelineStageFlags2KHR dstStageMask  = getVKPipelineStageFlagsFromResourceState(newState);
+    const VkAccessFlags2KHR        dstAccessMask = getVKAccessFlagsFromResourceState(newState);
+
     if (ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
     {
+        if (isBarrierRedundant(recorder, ffxResource, 0, newState))
+        {
+            ++recorder->droppedBarrierCount;
+            return;
+        }
+
+        FFX_ASSERT(recorder->scheduledBufferBarrierCount < FFX_MAX_BARRIERS);
         VkBuffer vkResource = ffxResource.bufferResource;
-        VkBufferMemoryBarrier* barrier = &backendContext->bufferMemoryBarriers[backendContext->scheduledBufferBarrierCount];
+        VkBufferMemoryBarrier2KHR* barrier = &recorder->bufferMemoryBarriers[recorder->scheduledBufferBarrierCount];
 
-        FfxResourceStates& curState = backendContext->pResources[resource->internalIndex].currentState;
+        FfxResourceStates& curState = ffxResource.currentStates[0];
 
-        barrier->sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier->sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR;
         barrier->pNext = nullptr;
+        barrier->srcStageMask = getVKPipelineStageFlagsFromResourceState(curState);
         barrier->srcAccessMask = getVKAccessFlagsFromResourceState(curState);
-        barrier->dstAccessMask = getVKAccessFlagsFromResourceState(newState);
+        barrier->dstStageMask = dstStageMask;
+        barrier->dstAccessMask = dstAccessMask;
         barrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier->buffer = vkResource;
         barrier->offset = 0;
         barrier->size = VK_WHOLE_SIZE;
 
-        backendContext->srcStageMask |= getVKPipelineStageFlagsFromResourceState(curState);
-        backendContext->dstStageMask |= getVKPipelineStageFlagsFromResourceState(newState);
-
         curState = newState;
+        markBarrierScheduled(recorder, ffxResource, 0);
 
-        ++backendContext->scheduledBufferBarrierCount;
+        ++recorder->scheduledBufferBarrierCount;
     }
     else
     {
         VkImage vkResource = ffxResource.imageResource;
-        VkImageMemoryBarrier* barrier = &backendContext->imageMemoryBarriers[backendContext->scheduledImageBarrierCount];
 
-        FfxResourceStates& curState = backendContext->pResources[resource->internalIndex].currentState;
+        const uint32_t trackedMipCount = FFX_MAXIMUM(ffxResource.resourceDescription.mipCount, 1u);
+        FFX_ASSERT(trackedMipCount <= FFX_MAX_TRACKED_MIP_COUNT);
 
-        VkImageSubresourceRange range;
-        range.aspectMask = getImageAspect(ffxResource.resourceDescription.usage);
-        range.baseMipLevel = 0;
-        range.levelCount = VK_REMAINING_MIP_LEVELS;
-        range.baseArrayLayer = 0;
-        range.layerCount = VK_REMAINING_ARRAY_LAYERS;
-
-        barrier->sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier->pNext = nullptr;
-        barrier->srcAccessMask = getVKAccessFlagsFromResourceState(curState);
-        barrier->dstAccessMask = getVKAccessFlagsFromResourceState(newState);
-        barrier->oldLayout = ffxResource.undefined ? VK_IMAGE_LAYOUT_UNDEFINED : getVKImageLayoutFromResourceState(curState);
-        barrier->newLayout = getVKImageLayoutFromResourceState(newState);
-        barrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier->image = vkResource;
-        barrier->subresourceRange = range;
+        // The first transition of an undefined image always covers all of it
+        uint32_t firstMip = 0;
+        uint32_t endMip   = trackedMipCount;
+        if (mip >= 0 && !ffxResource.undefined)
+        {
+            FFX_ASSERT(uint32_t(mip) < trackedMipCount);
+            firstMip = uint32_t(mip);
+            endMip   = firstMip + 1;
+        }
 
-        backendContext->srcStageMask |= getVKPipelineStageFlagsFromResourceState(curState);
-        backendContext->dstStageMask |= getVKPipelineStageFlagsFromResourceState(newState);
+        for (uint32_t runStart = firstMip; runStart < endMip;)
+        {
+            if (isBarrierRedundant(recorder, ffxResource, runStart, newState))
+            {
+                ++recorder->droppedBarrierCount;
+                ++runStart;
+                continue;
+            }
 
-        curState = newState;
+            // Cover the following mips sharing the same state with the same barrier
+            const FfxResourceStates curState = ffxResource.currentStates[runStart];
+            uint32_t runEnd = runStart + 1;
+            while (runEnd < endMip && ffxResource.currentStates[runEnd] == curState && !isBarrierRedundant(recorder, ffxResource, runEnd, newState))
+                ++runEnd;
+
+            FFX_ASSERT(recorder->scheduledImageBarrierCount < FFX_MAX_BARRIERS);
+            VkImageMemoryBarrier2KHR* barrier = &recorder->imageMemoryBarriers[recorder->scheduledImageBarrierCount];
+
+            VkImageSubresourceRange range;
+            range.aspectMask = getImageAspect(ffxResource.resourceDescription.usage);
+            range.baseMipLevel = runStart;
+            range.levelCount = (runEnd == trackedMipCount) ? VK_REMAINING_MIP_LEVELS : runEnd - runStart;  // registered images may leave mipCount at 0
+            range.baseArrayLayer = 0;
+            range.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+            barrier->sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+            barrier->pNext = nullptr;
+            barrier->srcStageMask = getVKPipelineStageFlagsFromResourceState(curState);
+            barrier->srcAccessMask = getVKAccessFlagsFromResourceState(curState);
+            barrier->dstStageMask = dstStageMask;
+            barrier->dstAccessMask = dstAccessMask;
+            barrier->oldLayout = ffxResource.undefined ? VK_IMAGE_LAYOUT_UNDEFINED : getVKImageLayoutFromResourceState(curState);
+            barrier->newLayout = getVKImageLayoutFromResourceState(newState);
+            barrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier->image = vkResource;
+            barrier->subresourceRange = range;
+
+            for (; runStart < runEnd; ++runStart)
+            {
+                ffxResource.currentStates[runStart] = newState;
+                markBarrierScheduled(recorder, ffxResource, runStart);
+            }
 
-        ++backendContext->scheduledImageBarrierCount;
+            ++recorder->scheduledImageBarrierCount;
+        }
     }
 
     if (ffxResource.undefined)
         ffxResource.undefined = false;
 }
 
-void flushBarriers(BackendContext_VK* backendContext, VkCommandBuffer vkCommandBuffer)
+void flushBarriers(BackendContext_VK* backendContext, BackendContext_VK::Recorder* recorder, VkCommandBuffer vkCommandBuffer)
 {
     FFX_ASSERT(NULL != backendContext);
+    FFX_ASSERT(NULL != recorder);
     FFX_ASSERT(NULL != vkCommandBuffer);
 
-    if (backendContext->scheduledImageBarrierCount > 0 || backendContext->scheduledBufferBarrierCount > 0)
+    const uint32_t imageBarrierCount  = recorder->scheduledImageBarrierCount;
+    const uint32_t bufferBarrierCount = recorder->scheduledBufferBarrierCount;
+    if (imageBarrierCount == 0 && bufferBarrierCount == 0 && recorder->droppedBarrierCount == 0)
+        return;
+
+    VkPipelineStageFlags2KHR srcStageMask = 0;
+    VkPipelineStageFlags2KHR dstStageMask = 0;
+    for (uint32_t i = 0; i < imageBarrierCount; ++i)
+    {
+        srcStageMask |= recorder->imageMemoryBarriers[i].srcStageMask;
+        dstStageMask |= recorder->imageMemoryBarriers[i].dstStageMask;
+    }
+    for (uint32_t i = 0; i < bufferBarrierCount; ++i)
+    {
+        srcStageMask |= recorder->bufferMemoryBarriers[i].srcStageMask;
+        dstStageMask |= recorder->bufferMemoryBarriers[i].dstStageMask;
+    }
+
+    if (imageBarrierCount > 0 || bufferBarrierCount > 0)
+    {
+        if (backendContext->synchronization2)
+        {
+            VkDependencyInfoKHR dependencyInfo = {};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+            dependencyInfo.pNext = nullptr;
+            dependencyInfo.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+            dependencyInfo.bufferMemoryBarrierCount = bufferBarrierCount;
+            dependencyInfo.pBufferMemoryBarriers = recorder->bufferMemoryBarriers;
+            dependencyInfo.imageMemoryBarrierCount = imageBarrierCount;
+            dependencyInfo.pImageMemoryBarriers = recorder->imageMemoryBarriers;
+            backendContext->vkFunctionTable.vkCmdPipelineBarrier2KHR(vkCommandBuffer, &dependencyInfo);
+        }
+        else
+        {
+            // The legacy stage and access bits are the low bits of their synchronization2 counterparts
+            for (uint32_t i = 0; i < imageBarrierCount; ++i)
+            {
+                const VkImageMemoryBarrier2KHR& barrier2 = recorder->imageMemoryBarriers[i];
+                VkImageMemoryBarrier& barrier = recorder->legacyImageMemoryBarriers[i];
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.pNext = nullptr;
+                barrier.srcAccessMask = VkAccessFlags(barrier2.srcAccessMask);
+                barrier.dstAccessMask = VkAccessFlags(barrier2.dstAccessMask);
+                barrier.oldLayout = barrier2.oldLayout;
+                barrier.newLayout = barrier2.newLayout;
+                barrier.srcQueueFamilyIndex = barrier2.srcQueueFamilyIndex;
+                barrier.dstQueueFamilyIndex = barrier2.dstQueueFamilyIndex;
+                barrier.image = barrier2.image;
+                barrier.subresourceRange = barrier2.subresourceRange;
+            }
+            for (uint32_t i = 0; i < bufferBarrierCount; ++i)
+            {
+                const VkBufferMemoryBarrier2KHR& barrier2 = recorder->bufferMemoryBarriers[i];
+                VkBufferMemoryBarrier& barrier = recorder->legacyBufferMemoryBarriers[i];
+                barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                barrier.pNext = nullptr;
+                barrier.srcAccessMask = VkAccessFlags(barrier2.srcAccessMask);
+                barrier.dstAccessMask = VkAccessFlags(barrier2.dstAccessMask);
+                barrier.srcQueueFamilyIndex = barrier2.srcQueueFamilyIndex;
+                barrier.dstQueueFamilyIndex = barrier2.dstQueueFamilyIndex;
+                barrier.buffer = barrier2.buffer;
+                barrier.offset = barrier2.offset;
+                barrier.size = barrier2.size;
+            }
+            backendContext->vkFunctionTable.vkCmdPipelineBarrier(vkCommandBuffer, VkPipelineStageFlags(srcStageMask), VkPipelineStageFlags(dstStageMask), VK_DEPENDENCY_BY_REGION_BIT, 0, nullptr, bufferBarrierCount, recorder->legacyBufferMemoryBarriers, imageBarrierCount, recorder->legacyImageMemoryBarriers);
+        }
+    }
+
+    if (backendContext->barrierFlushCallback)
     {
-        backendContext->vkFunctionTable.vkCmdPipelineBarrier(vkCommandBuffer, backendContext->srcStageMask, backendContext->dstStageMask, VK_DEPENDENCY_BY_REGION_BIT, 0, nullptr, backendContext->scheduledBufferBarrierCount, backendContext->bufferMemoryBarriers, backendContext->scheduledImageBarrierCount, backendContext->imageMemoryBarriers);
-        backendContext->scheduledImageBarrierCount = 0;
-        backendContext->scheduledBufferBarrierCount = 0;
-        backendContext->srcStageMask = 0;
-        backendContext->dstStageMask = 0;
+        FfxBarrierFlushInfoVK flushInfo = {};
+        flushInfo.imageBarrierCount   = imageBarrierCount;
+        flushInfo.bufferBarrierCount  = bufferBarrierCount;
+        flushInfo.droppedBarrierCount = recorder->droppedBarrierCount;
+        flushInfo.srcStageMask        = srcStageMask;
+        flushInfo.dstStageMask        = dstStageMask;
+        flushInfo.synchronization2    = backendContext->synchronization2;
+        backendContext->barrierFlushCallback(&flushInfo, backendContext->barrierFlushUserData);
     }
+
+    recorder->scheduledImageBarrierCount = 0;
+    recorder->scheduledBufferBarrierCount = 0;
+    recorder->droppedBarrierCount = 0;
+    ++recorder->barrierBatch;
 }
 
-FfxConstantAllocation BackendContext_VK::FallbackConstantAllocator(void* data, FfxUInt64 dataSize)
+// Create the uniform buffer with partitions of at least partitionSize bytes for each effect context and queued frame
+static FfxErrorCode createUniformBuffer(BackendContext_VK* backendContext, VkDeviceSize partitionSize)
 {
-    FfxConstantAllocation       allocation;
-    std::lock_guard<std::mutex> cbLock{uniformBufferMutex};
+    // dynamic offsets must be multiples of minUniformBufferOffsetAlignment, and flushed ranges of non coherent memory multiples of nonCoherentAtomSize
+    VkPhysicalDeviceProperties physicalDeviceProperties = {};
+    vkGetPhysicalDeviceProperties(backendContext->physicalDevice, &physicalDeviceProperties);
+    const VkDeviceSize alignment = FFX_MAXIMUM(physicalDeviceProperties.limits.minUniformBufferOffsetAlignment, physicalDeviceProperties.limits.nonCoherentAtomSize);
+
+    partitionSize = FFX_ALIGN_UP(partitionSize, alignment);
+    const VkDeviceSize bufferSize = partitionSize * backendContext->maxEffectContexts * FFX_MAX_QUEUED_FRAMES;
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size               = bufferSize;
+    bufferInfo.usage              = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
 
-    if (!uniformBufferMem)
+    VkBuffer buffer = VK_NULL_HANDLE;
+    if (backendContext->vkFunctionTable.vkCreateBuffer(backendContext->device, &bufferInfo, NULL, &buffer) != VK_SUCCESS)
     {
-        // allocate dynamic uniform buffer
+        return FFX_ERROR_BACKEND_API_ERROR;
+    }
 
-        // get alignment
-        VkPhysicalDeviceProperties physicalDeviceProperties = {};
-        vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
-        uniformBufferAlignment = physicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
+    // allocate memory block for all uniform buffers
+    VkMemoryRequirements memRequirements = {};
+    backendContext->vkFunctionTable.vkGetBufferMemoryRequirements(backendContext->device, buffer, &memRequirements);
 
-        uniformBufferSize = FFX_ALIGN_UP(FFX_BUFFER_SIZE, uniformBufferAlignment) * maxEffectContexts * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES;
+    VkMemoryPropertyFlags requiredMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    VkMemoryPropertyFlags memoryProperties = 0;
 
-        VkBufferCreateInfo bufferInfo = {};
-        bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferInfo.size               = static_cast<VkDeviceSize>(uniformBufferSize);
-        bufferInfo.usage              = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType          = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryTypeIndex(backendContext->physicalDevice, memRequirements, requiredMemoryProperties, memoryProperties);
 
-        VkResult res = vkFunctionTable.vkCreateBuffer(device, &bufferInfo, NULL, &uniformBuffer);
-        FFX_ASSERT(res == VK_SUCCESS);
+    if (allocInfo.memoryTypeIndex == UINT32_MAX)
+    {
+        requiredMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        allocInfo.memoryTypeIndex = findMemoryTypeIndex(backendContext->physicalDevice, memRequirements, requiredMemoryProperties, memoryProperties);
 
-        VkMemoryAllocateInfo allocInfo = {};
-        if (res == VK_SUCCESS)
+        if (allocInfo.memoryTypeIndex == UINT32_MAX)
         {
-            // allocate memory block for all uniform buffers
-            VkMemoryRequirements memRequirements = {};
-            vkFunctionTable.vkGetBufferMemoryRequirements(device, uniformBuffer, &memRequirements);
+            backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, buffer, VK_NULL_HANDLE);
+            return FFX_ERROR_BACKEND_API_ERROR;
+        }
+    }
 
-            // this is the real alignment
-            uniformBufferAlignment = memRequirements.alignment;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkResult result = backendContext->vkFunctionTable.vkAllocateMemory(backendContext->device, &allocInfo, nullptr, &memory);
 
-            VkMemoryPropertyFlags requiredMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    if (result != VK_SUCCESS)
+    {
+        backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, buffer, VK_NULL_HANDLE);
+        switch (result)
+        {
+        case (VK_ERROR_OUT_OF_HOST_MEMORY):
+        case (VK_ERROR_OUT_OF_DEVICE_MEMORY):
+            return FFX_ERROR_OUT_OF_MEMORY;
+        default:
+            return FFX_ERROR_BACKEND_API_ERROR;
+        }
+    }
 
-            allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocInfo.allocationSize  = uniformBufferSize;
-            allocInfo.memoryTypeIndex = findMemoryTypeIndex(physicalDevice, memRequirements, requiredMemoryProperties, uniformBufferMemoryProperties);
+    // map the memory block
+    void* mappedMemory = nullptr;
+    if (backendContext->vkFunctionTable.vkMapMemory(backendContext->device, memory, 0, bufferSize, 0, &mappedMemory) != VK_SUCCESS ||
+        backendContext->vkFunctionTable.vkBindBufferMemory(backendContext->device, buffer, memory, 0) != VK_SUCCESS)
+    {
+        backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, memory, VK_NULL_HANDLE);
+        backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, buffer, VK_NULL_HANDLE);
+        return FFX_ERROR_BACKEND_API_ERROR;
+    }
 
-            if (allocInfo.memoryTypeIndex == UINT32_MAX)
-            {
-                requiredMemoryProperties  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
-                allocInfo.memoryTypeIndex = findMemoryTypeIndex(physicalDevice, memRequirements, requiredMemoryProperties, uniformBufferMemoryProperties);
+    backendContext->uniformBuffer                 = buffer;
+    backendContext->uniformBufferMemory           = memory;
+    backendContext->uniformBufferMemoryProperties = memoryProperties;
+    backendContext->uniformBufferMem              = mappedMemory;
+    backendContext->uniformBufferAlignment        = alignment;
+    backendContext->uniformBufferSize             = bufferSize;
+    backendContext->uniformBufferPartitionSize    = partitionSize;
 
-                if (allocInfo.memoryTypeIndex == UINT32_MAX)
-                    res = VK_ERROR_INITIALIZATION_FAILED;
-            }
-        }
+    // every partition of the new buffer starts empty
+    for (uint32_t i = 0; i < backendContext->maxEffectContexts; ++i)
+        backendContext->pEffectContexts[i].uniformBufferOffset = 0;
+
+    return FFX_OK;
+}
 
-        if (res == VK_SUCCESS)
-            res = vkFunctionTable.vkAllocateMemory(device, &allocInfo, nullptr, &uniformBufferMemory);
-        FFX_ASSERT(res == VK_SUCCESS);
+// Move to a uniform buffer with partitions twice larger, keeping the current one alive for the frames in flight
+static FfxErrorCode growUniformBuffer(BackendContext_VK* backendContext, VkDeviceSize allocationSize)
+{
+    FFX_RETURN_ON_ERROR(backendContext->retiredUniformBufferCount < FFX_MAX_RETIRED_UNIFORM_BUFFERS, FFX_ERROR_OUT_OF_MEMORY);
+
+    BackendContext_VK::RetiredUniformBuffer retired = { backendContext->uniformBuffer, backendContext->uniformBufferMemory };
+    FfxErrorCode errorCode = createUniformBuffer(backendContext, FFX_MAXIMUM(backendContext->uniformBufferPartitionSize * 2, allocationSize));
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
 
-        if (res == VK_SUCCESS)
-            res = vkFunctionTable.vkBindBufferMemory(device, uniformBuffer, uniformBufferMemory, 0);
-        FFX_ASSERT(res == VK_SUCCESS);
+    backendContext->retiredUniformBuffers[backendContext->retiredUniformBufferCount++] = retired;
+    ++backendContext->constantBufferStatistics.growCount;
+    return FFX_OK;
+}
 
-        // map the memory block
-        if (res == VK_SUCCESS)
-            res = vkFunctionTable.vkMapMemory(device, uniformBufferMemory, 0, uniformBufferSize, 0, &uniformBufferMem);
-        FFX_ASSERT(res == VK_SUCCESS);
+static void destroyUniformBuffers(BackendContext_VK* backendContext)
+{
+    backendContext->retiredUniformBuffers[backendContext->retiredUniformBufferCount++] = { backendContext->uniformBuffer, backendContext->uniformBufferMemory };
+    for (uint32_t i = 0; i < backendContext->retiredUniformBufferCount; ++i)
+    {
+        BackendContext_VK::RetiredUniformBuffer& retired = backendContext->retiredUniformBuffers[i];
+        if (retired.memory != VK_NULL_HANDLE)
+        {
+            backendContext->vkFunctionTable.vkUnmapMemory(backendContext->device, retired.memory);
+            backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, retired.memory, VK_NULL_HANDLE);
+        }
+        backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, retired.buffer, VK_NULL_HANDLE);
     }
+    backendContext->retiredUniformBufferCount = 0;
+    backendContext->uniformBuffer             = VK_NULL_HANDLE;
+    backendContext->uniformBufferMemory       = VK_NULL_HANDLE;
+    backendContext->uniformBufferMem          = nullptr;
+}
+
+FfxConstantAllocation BackendContext_VK::FallbackConstantAllocator(void* data, FfxUInt64 dataSize, FfxUInt32 effectContextId)
+{
+    FfxConstantAllocation       allocation = {};
+    std::lock_guard<std::mutex> cbLock{pLocks->uniformBuffer};
 
     FFX_ASSERT(uniformBufferMem);
 
@@ -1304,15 +2312,26 @@ FfxConstantAllocation BackendContext_VK::FallbackConstantAllocator(void* data, F
 
     if (data)
     {
-        if (uniformBufferOffset + dataSize >= uniformBufferSize)
-            uniformBufferOffset = 0;
+        EffectContext&     effectContext  = pEffectContexts[effectContextId];
+        const VkDeviceSize allocationSize = FFX_ALIGN_UP(dataSize, uniformBufferAlignment);
 
-        allocation.handle = static_cast<FfxUInt64>(uniformBufferOffset);
+        // the partition of the frame is full, rather than wrapping over constants the GPU may still read
+        if (effectContext.uniformBufferOffset + allocationSize > uniformBufferPartitionSize)
+        {
+            if (growUniformBuffer(this, allocationSize) != FFX_OK)
+            {
+                ++constantBufferStatistics.failedAllocationCount;
+                allocation.resource.resource = nullptr;
+                return allocation;
+            }
+            allocation.resource.resource = uniformBuffer;
+        }
 
-        void* pBuffer = (void*)((uint8_t*)(uniformBufferMem) + uniformBufferOffset);
-        memcpy(pBuffer, data, dataSize);
+        const VkDeviceSize offset = (effectContextId * FFX_MAX_QUEUED_FRAMES + effectContext.frameIndex) * uniformBufferPartitionSize + effectContext.uniformBufferOffset;
+        allocation.handle = static_cast<FfxUInt64>(offset);
 
-        // TODO: ensure that we aren't writing on some used memory
+        void* pBuffer = (void*)((uint8_t*)(uniformBufferMem) + offset);
+        memcpy(pBuffer, data, dataSize);
 
         // flush mapped range if memory type is not coherent
         if ((uniformBufferMemoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
@@ -1322,29 +2341,210 @@ FfxConstantAllocation BackendContext_VK::FallbackConstantAllocator(void* data, F
 
             memoryRange.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
             memoryRange.memory = uniformBufferMemory;
-            memoryRange.offset = uniformBufferOffset;
-            memoryRange.size   = dataSize;
+            memoryRange.offset = offset;
+            memoryRange.size   = allocationSize;
 
             vkFunctionTable.vkFlushMappedMemoryRanges(device, 1, &memoryRange);
         }
 
-        uniformBufferOffset += FFX_ALIGN_UP(dataSize, uniformBufferAlignment);
-        if (uniformBufferOffset > uniformBufferSize)
-            uniformBufferOffset = 0;
+        effectContext.uniformBufferOffset += allocationSize;
+        constantBufferStatistics.peakFrameUsage = FFX_MAXIMUM(constantBufferStatistics.peakFrameUsage, uint64_t(effectContext.uniformBufferOffset));
     }
 
     return allocation;
 }
 
-void resetBackendContext(BackendContext_VK* backendContext)
+void resetBackendContext(BackendContext_VK* backendContext)
+{
+    // reset the context except the maxEffectContexts, pipeline cache, image view cache budget and barrier hook in case the memory is reused for a new context
+    uint32_t maxEffectContexts = backendContext->maxEffectContexts;
+    BackendContext_VK::PipelineCache pipelineCache = backendContext->pipelineCache;
+    uint32_t imageViewCacheBudget = backendContext->imageViewCache.budget;
+    FfxBarrierFlushCallbackVK barrierFlushCallback = backendContext->barrierFlushCallback;
+    void* barrierFlushUserData = backendContext->barrierFlushUserData;
+
+    // all cached views belong to an effect context and were destroyed with it, and so were the locks
+    FFX_ASSERT(backendContext->imageViewCache.count == 0);
+    FFX_ASSERT(!backendContext->pLocks);
+
+    memset(backendContext, 0, sizeof(BackendContext_VK));
+
+    // restore the maxEffectContexts, pipeline cache, image view cache budget and barrier hook
+    backendContext->maxEffectContexts = maxEffectContexts;
+    backendContext->pipelineCache = pipelineCache;
+    backendContext->imageViewCache.budget = imageViewCacheBudget;
+    backendContext->barrierFlushCallback = barrierFlushCallback;
+    backendContext->barrierFlushUserData = barrierFlushUserData;
+}
+
+static BackendContext_VK::VkResourceView& getBindlessView(BackendContext_VK* backendContext, uint32_t viewIndex)
+{
+    FFX_ASSERT(backendContext->bindlessViewChunks[viewIndex / FFX_BINDLESS_VIEW_CHUNK_SIZE]);
+    return backendContext->bindlessViewChunks[viewIndex / FFX_BINDLESS_VIEW_CHUNK_SIZE][viewIndex % FFX_BINDLESS_VIEW_CHUNK_SIZE];
+}
+
+// Reserve a range of bindless image views, allocating the chunks it covers
+static FfxErrorCode reserveBindlessViews(BackendContext_VK* backendContext, uint32_t viewCount, uint32_t* outViewStart)
+{
+    FFX_RETURN_ON_ERROR(backendContext->bindlessBase + viewCount <= FFX_MAX_BINDLESS_DESCRIPTOR_COUNT, FFX_ERROR_OUT_OF_MEMORY);
+
+    const uint32_t viewEnd = backendContext->bindlessBase + viewCount;
+    for (uint32_t chunk = backendContext->bindlessBase / FFX_BINDLESS_VIEW_CHUNK_SIZE; chunk * FFX_BINDLESS_VIEW_CHUNK_SIZE < viewEnd; ++chunk)
+    {
+        if (!backendContext->bindlessViewChunks[chunk])
+        {
+            backendContext->bindlessViewChunks[chunk] = (BackendContext_VK::VkResourceView*)calloc(FFX_BINDLESS_VIEW_CHUNK_SIZE, sizeof(BackendContext_VK::VkResourceView));
+            FFX_RETURN_ON_ERROR(backendContext->bindlessViewChunks[chunk], FFX_ERROR_OUT_OF_MEMORY);
+        }
+    }
+
+    *outViewStart = backendContext->bindlessBase;
+    backendContext->bindlessBase = viewEnd;
+    backendContext->peakBindlessViewCount = FFX_MAXIMUM(backendContext->peakBindlessViewCount, viewEnd);
+    return FFX_OK;
+}
+
+static FfxGpuJobDescription* getGpuJob(BackendContext_VK::Recorder* recorder, uint32_t jobIndex)
+{
+    return &recorder->gpuJobChunks[jobIndex / FFX_GPU_JOB_CHUNK_SIZE][jobIndex % FFX_GPU_JOB_CHUNK_SIZE];
+}
+
+// The recorder the calling thread acquired last, so it is only looked up when the thread starts recording
+typedef struct RecorderBinding {
+    const BackendContext_VK*        backendContext;
+    uint64_t                        generation;
+    BackendContext_VK::Recorder*    recorder;
+} RecorderBinding;
+static thread_local RecorderBinding s_recorderBinding = {};
+static std::atomic<uint64_t>        s_recorderGeneration{0};
+
+// Get the recorder of the calling thread, taking an idle one or adding one when it is not recording yet
+static BackendContext_VK::Recorder* acquireRecorder(BackendContext_VK* backendContext)
+{
+    if (s_recorderBinding.backendContext == backendContext && s_recorderBinding.generation == backendContext->recorderGeneration)
+        return s_recorderBinding.recorder;
+
+    std::lock_guard<std::mutex> lock{backendContext->pLocks->recorder};
+    const std::thread::id thread = std::this_thread::get_id();
+
+    BackendContext_VK::Recorder* recorder = nullptr;
+    BackendContext_VK::Recorder* idleRecorder = nullptr;
+    for (uint32_t i = 0; i < backendContext->recorderCount && !recorder; ++i)
+    {
+        BackendContext_VK::Recorder* candidate = backendContext->recorders[i];
+        if (candidate->active && candidate->owner == thread)
+            recorder = candidate;
+        else if (!candidate->active && !idleRecorder)
+            idleRecorder = candidate;
+    }
+
+    if (!recorder)
+        recorder = idleRecorder;
+
+    if (!recorder)
+    {
+        FFX_RETURN_ON_ERROR(backendContext->recorderCount < FFX_MAX_RECORDERS, nullptr);
+        recorder = (BackendContext_VK::Recorder*)calloc(1, sizeof(BackendContext_VK::Recorder));
+        FFX_RETURN_ON_ERROR(recorder, nullptr);
+
+        new (&recorder->owner) std::thread::id();
+        recorder->index = backendContext->recorderCount;
+        recorder->barrierBatch = uint64_t(recorder->index) << 48;
+        backendContext->recorders[backendContext->recorderCount++] = recorder;
+    }
+
+    recorder->active = true;
+    recorder->owner  = thread;
+    s_recorderBinding = { backendContext, backendContext->recorderGeneration, recorder };
+    return recorder;
+}
+
+// Give the recorder back once its jobs and staged constants are all executed
+static void releaseRecorder(BackendContext_VK* backendContext, BackendContext_VK::Recorder* recorder)
+{
+    if (recorder->gpuJobCount || recorder->stagingRingBufferPending || recorder->pStagingOverflowBlocks)
+        return;
+
+    FFX_ASSERT(recorder->scheduledImageBarrierCount == 0 && recorder->scheduledBufferBarrierCount == 0);
+
+    std::lock_guard<std::mutex> lock{backendContext->pLocks->recorder};
+    recorder->active = false;
+    recorder->owner  = std::thread::id();
+    if (s_recorderBinding.recorder == recorder)
+        s_recorderBinding = {};
+}
+
+// Release the staged constants once the jobs reading them have executed
+static void releaseStagedConstants(BackendContext_VK::Recorder* recorder)
+{
+    while (recorder->pStagingOverflowBlocks)
+    {
+        BackendContext_VK::StagingOverflowBlock* block = recorder->pStagingOverflowBlocks;
+        recorder->pStagingOverflowBlocks = block->pNext;
+        free(block);
+    }
+    recorder->stagingRingBufferPending = 0;
+}
+
+// Free the memory reserved on demand once the last effect context is gone
+static void releaseOnDemandMemory(BackendContext_VK* backendContext)
+{
+    for (uint32_t poolIndex = 0; poolIndex < backendContext->descriptorPoolCount; ++poolIndex)
+    {
+        FFX_ASSERT(backendContext->descriptorPools[poolIndex].setCount == 0);
+        backendContext->vkFunctionTable.vkDestroyDescriptorPool(backendContext->device, backendContext->descriptorPools[poolIndex].descriptorPool, VK_NULL_HANDLE);
+        backendContext->descriptorPools[poolIndex].descriptorPool = VK_NULL_HANDLE;
+    }
+    backendContext->descriptorPoolCount = 0;
+
+    for (uint32_t recorderIndex = 0; recorderIndex < backendContext->recorderCount; ++recorderIndex)
+    {
+        BackendContext_VK::Recorder* recorder = backendContext->recorders[recorderIndex];
+        releaseStagedConstants(recorder);
+        for (uint32_t chunk = 0; chunk < FFX_MAX_GPU_JOBS / FFX_GPU_JOB_CHUNK_SIZE; ++chunk)
+            free(recorder->gpuJobChunks[chunk]);
+        free(recorder->pStagingRingBuffer);
+        free(recorder);
+        backendContext->recorders[recorderIndex] = nullptr;
+    }
+    backendContext->recorderCount = 0;
+
+    // threads still bound to the freed recorders have to look theirs up again
+    backendContext->recorderGeneration = ++s_recorderGeneration;
+
+    for (uint32_t chunk = 0; chunk < FFX_MAX_BINDLESS_DESCRIPTOR_COUNT / FFX_BINDLESS_VIEW_CHUNK_SIZE; ++chunk)
+    {
+        free(backendContext->bindlessViewChunks[chunk]);
+        backendContext->bindlessViewChunks[chunk] = nullptr;
+    }
+}
+
+// The locks and the atomics of the effect contexts live from the creation of the first effect context to the destruction of
+// the last one, and the memory they occupy is only cleared outside of that
+static void constructBackendSynchronization(BackendContext_VK* backendContext, BackendLocks_VK* pLocks)
+{
+    FFX_ASSERT(!backendContext->pLocks);
+    backendContext->pLocks = new (pLocks) BackendLocks_VK();
+    for (uint32_t i = 0; i < backendContext->maxEffectContexts; ++i)
+        new (&backendContext->pEffectContexts[i].destroyedDescriptorHandles) std::atomic<uint64_t>(0);
+}
+
+static void destroyBackendSynchronization(BackendContext_VK* backendContext)
 {
-    // reset the context except the maxEffectContexts in case the memory is reused for a new context
-    uint32_t maxEffectContexts = backendContext->maxEffectContexts;
-
-    memset(backendContext, 0, sizeof(BackendContext_VK));
+    FFX_ASSERT(backendContext->pLocks);
+    for (uint32_t i = 0; i < backendContext->maxEffectContexts; ++i)
+        backendContext->pEffectContexts[i].destroyedDescriptorHandles.~atomic();
+    backendContext->pLocks->~BackendLocks_VK();
+    backendContext->pLocks = nullptr;
+}
 
-    // restore the maxEffectContexts
-    backendContext->maxEffectContexts = maxEffectContexts;
+// Undo the setup of the first effect context when it fails, so the memory can be cleared and set up again
+static FfxErrorCode abortBackendContextSetup(BackendContext_VK* backendContext, FfxErrorCode errorCode)
+{
+    destroyUniformBuffers(backendContext);
+    destroyBackendSynchronization(backendContext);
+    resetBackendContext(backendContext);
+    return errorCode;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1385,32 +2585,25 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
 
         resetBackendContext(backendContext);
 
-        new (&backendContext->uniformBufferMutex) std::mutex();
+        // bindings of recorders from a previous backend context in this scratch memory are stale
+        backendContext->recorderGeneration = ++s_recorderGeneration;
 
         // Map all of our pointers
-        uint32_t gpuJobDescArraySize   = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_GPU_JOBS * sizeof(FfxGpuJobDescription), sizeof(uint32_t));
-        uint32_t resourceViewArraySize = FFX_ALIGN_UP(((backendContext->maxEffectContexts * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2) + FFX_MAX_BINDLESS_DESCRIPTOR_COUNT) * sizeof(BackendContext_VK::VkResourceView), sizeof(uint32_t));
-        uint32_t stagingRingBufferArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE, sizeof(uint32_t));
+        uint32_t resourceViewArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2 * sizeof(BackendContext_VK::VkResourceView), sizeof(uint32_t));
         uint32_t pipelineArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * sizeof(BackendContext_VK::PipelineLayout), sizeof(uint32_t));
         uint32_t resourceArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * sizeof(BackendContext_VK::Resource), sizeof(uint32_t));
         uint32_t contextArraySize = FFX_ALIGN_UP(backendContext->maxEffectContexts * sizeof(BackendContext_VK::EffectContext), sizeof(uint32_t));
         uint8_t* pMem = (uint8_t*)((BackendContext_VK*)(backendContext + 1));
 
-        // Map gpu job array
-        backendContext->pGpuJobs = (FfxGpuJobDescription*)pMem;
-        memset(backendContext->pGpuJobs, 0, gpuJobDescArraySize);
-        pMem += gpuJobDescArraySize;
+        // The locks are constructed once the effect context array is mapped
+        BackendLocks_VK* pLocks = (BackendLocks_VK*)pMem;
+        pMem += FFX_ALIGN_UP(sizeof(BackendLocks_VK), sizeof(uint64_t));
 
         // Map the resource view array
         backendContext->pResourceViews = (BackendContext_VK::VkResourceView*)(pMem);
         memset(backendContext->pResourceViews, 0, resourceViewArraySize);
         pMem += resourceViewArraySize;
 
-        // Map the staging ring buffer array
-        backendContext->pStagingRingBuffer = (uint8_t*)pMem;
-        memset(backendContext->pStagingRingBuffer, 0, stagingRingBufferArraySize);
-        pMem += stagingRingBufferArraySize;
-
         // Map pipeline array
         backendContext->pPipelineLayouts = (BackendContext_VK::PipelineLayout*)pMem;
         memset(backendContext->pPipelineLayouts, 0, pipelineArraySize);
@@ -1427,8 +2620,10 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
         }
 
         // Map context array
+        pMem = (uint8_t*)FFX_ALIGN_UP((uintptr_t)pMem, alignof(BackendContext_VK::EffectContext));
         backendContext->pEffectContexts = (BackendContext_VK::EffectContext*)pMem;
         memset(backendContext->pEffectContexts, 0, contextArraySize);
+        constructBackendSynchronization(backendContext, pLocks);
         pMem += contextArraySize;
 
         // Map extension array
@@ -1481,9 +2676,14 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
         backendContext->vkFunctionTable.vkBindBufferMemory = (PFN_vkBindBufferMemory)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkBindBufferMemory");
         backendContext->vkFunctionTable.vkBindImageMemory = (PFN_vkBindImageMemory)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkBindImageMemory");
         backendContext->vkFunctionTable.vkUpdateDescriptorSets = (PFN_vkUpdateDescriptorSets)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkUpdateDescriptorSets");
+        backendContext->vkFunctionTable.vkResetDescriptorPool = (PFN_vkResetDescriptorPool)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkResetDescriptorPool");
         backendContext->vkFunctionTable.vkCmdPipelineBarrier = (PFN_vkCmdPipelineBarrier)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdPipelineBarrier");
+        backendContext->vkFunctionTable.vkCmdPipelineBarrier2KHR = (PFN_vkCmdPipelineBarrier2KHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdPipelineBarrier2KHR");
+        if (!backendContext->vkFunctionTable.vkCmdPipelineBarrier2KHR)
+            backendContext->vkFunctionTable.vkCmdPipelineBarrier2KHR = (PFN_vkCmdPipelineBarrier2KHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdPipelineBarrier2");
         backendContext->vkFunctionTable.vkCmdBindPipeline = (PFN_vkCmdBindPipeline)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdBindPipeline");
         backendContext->vkFunctionTable.vkCmdBindDescriptorSets = (PFN_vkCmdBindDescriptorSets)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdBindDescriptorSets");
+        backendContext->vkFunctionTable.vkCmdPushDescriptorSetKHR = (PFN_vkCmdPushDescriptorSetKHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdPushDescriptorSetKHR");
         backendContext->vkFunctionTable.vkCmdDispatch = (PFN_vkCmdDispatch)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdDispatch");
         backendContext->vkFunctionTable.vkCmdDispatchIndirect = (PFN_vkCmdDispatchIndirect)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdDispatchIndirect");
         backendContext->vkFunctionTable.vkCmdCopyBuffer = (PFN_vkCmdCopyBuffer)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdCopyBuffer");
@@ -1501,113 +2701,43 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
         vkEnumerateDeviceExtensionProperties(backendContext->physicalDevice, nullptr, &backendContext->numDeviceExtensions, nullptr);
         vkEnumerateDeviceExtensionProperties(backendContext->physicalDevice, nullptr, &backendContext->numDeviceExtensions, backendContext->extensionProperties);
 
-        // create a global descriptor pool to hold all descriptors we'll need
-        VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
-        VkDescriptorPoolSize poolSizes[] = {
-            { VK_DESCRIPTOR_TYPE_SAMPLER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_SAMPLER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-        };
-
-        descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        descriptorPoolCreateInfo.pNext = nullptr;
-        descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-        descriptorPoolCreateInfo.poolSizeCount = 5;
-        descriptorPoolCreateInfo.pPoolSizes = poolSizes;
-        descriptorPoolCreateInfo.maxSets = backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * MAX_PIPELINE_USAGE_PER_FRAME * FFX_MAX_QUEUED_FRAMES;
-
-        if (backendContext->vkFunctionTable.vkCreateDescriptorPool(backendContext->device, &descriptorPoolCreateInfo, nullptr, &backendContext->descriptorPool) != VK_SUCCESS) {
-            return FFX_ERROR_BACKEND_API_ERROR;
-        }
-
-        // set bindless resource view to base
-        backendContext->bindlessBase = (backendContext->maxEffectContexts * FFX_MAX_QUEUED_FRAMES * FFX_MAX_RESOURCE_COUNT * 2);
-
-        // allocate dynamic uniform buffer
+        // push descriptors replace descriptor set updates for pipelines that fit in the limit
+        backendContext->maxPushDescriptors = 0;
+        for (uint32_t i = 0; i < backendContext->numDeviceExtensions; i++)
         {
-            // get alignment
-            VkPhysicalDeviceProperties physicalDeviceProperties = {};
-            vkGetPhysicalDeviceProperties(backendContext->physicalDevice, &physicalDeviceProperties);
-            backendContext->uniformBufferAlignment = physicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
-
-            backendContext->uniformBufferSize =
-                FFX_ALIGN_UP(FFX_BUFFER_SIZE, backendContext->uniformBufferAlignment) * backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES;
-
-            VkBufferCreateInfo bufferInfo = {};
-            bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            bufferInfo.size               = static_cast<VkDeviceSize>(backendContext->uniformBufferSize);
-            bufferInfo.usage              = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-            bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
-
-            if (backendContext->vkFunctionTable.vkCreateBuffer(backendContext->device, &bufferInfo, NULL, &backendContext->uniformBuffer) != VK_SUCCESS)
+            if (strcmp(backendContext->extensionProperties[i].extensionName, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) == 0 && backendContext->vkFunctionTable.vkCmdPushDescriptorSetKHR)
             {
-                return FFX_ERROR_BACKEND_API_ERROR;
-            }
-
-            // allocate memory block for all uniform buffers
-            VkMemoryRequirements memRequirements = {};
-            backendContext->vkFunctionTable.vkGetBufferMemoryRequirements(backendContext->device, backendContext->uniformBuffer, &memRequirements);
-
-            // this is the real alignment
-            backendContext->uniformBufferAlignment = memRequirements.alignment;
-
-            VkMemoryPropertyFlags requiredMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+                VkPhysicalDevicePushDescriptorPropertiesKHR pushDescriptorProperties = {};
+                pushDescriptorProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
 
-            VkMemoryAllocateInfo allocInfo{};
-            allocInfo.sType          = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocInfo.allocationSize = backendContext->uniformBufferSize;
-            allocInfo.memoryTypeIndex =
-                findMemoryTypeIndex(backendContext->physicalDevice, memRequirements, requiredMemoryProperties, backendContext->uniformBufferMemoryProperties);
+                VkPhysicalDeviceProperties2 deviceProperties2 = {};
+                deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                deviceProperties2.pNext = &pushDescriptorProperties;
+                vkGetPhysicalDeviceProperties2(backendContext->physicalDevice, &deviceProperties2);
 
-            if (allocInfo.memoryTypeIndex == UINT32_MAX)
-            {
-                requiredMemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
-                allocInfo.memoryTypeIndex = findMemoryTypeIndex(
-                    backendContext->physicalDevice, memRequirements, requiredMemoryProperties, backendContext->uniformBufferMemoryProperties);
-
-                if (allocInfo.memoryTypeIndex == UINT32_MAX)
-                {
-                    return FFX_ERROR_BACKEND_API_ERROR;
-                }
+                backendContext->maxPushDescriptors = pushDescriptorProperties.maxPushDescriptors;
+                break;
             }
+        }
 
-            VkResult result = backendContext->vkFunctionTable.vkAllocateMemory(backendContext->device, &allocInfo, nullptr, &backendContext->uniformBufferMemory);
-
-            if (result != VK_SUCCESS)
-            {
-                switch (result)
-                {
-                case (VK_ERROR_OUT_OF_HOST_MEMORY):
-                case (VK_ERROR_OUT_OF_DEVICE_MEMORY):
-                    return FFX_ERROR_OUT_OF_MEMORY;
-                default:
-                    return FFX_ERROR_BACKEND_API_ERROR;
-                }
-            }
+        // descriptor pools are created in chunks when descriptor sets are first needed, sized from the pipeline layouts created by then
+        backendContext->descriptorPoolCount = 0;
 
-            // map the memory block
-            if (backendContext->vkFunctionTable.vkMapMemory(
-                    backendContext->device, backendContext->uniformBufferMemory, 0, backendContext->uniformBufferSize, 0, &backendContext->uniformBufferMem) !=
-                VK_SUCCESS)
-            {
-                return FFX_ERROR_BACKEND_API_ERROR;
-            }
+        // bindless resource views are indexed from the start of their own chunks
+        backendContext->bindlessBase = 0;
 
-            if (backendContext->vkFunctionTable.vkBindBufferMemory(
-                    backendContext->device, backendContext->uniformBuffer, backendContext->uniformBufferMemory, 0) != VK_SUCCESS)
-            {
-                return FFX_ERROR_BACKEND_API_ERROR;
-            }
+        // allocate dynamic uniform buffer, partitioned per effect context and queued frame
+        {
+            FfxErrorCode errorCode = createUniformBuffer(backendContext, FFX_BUFFER_SIZE * FFX_MAX_PASS_COUNT);
+            if (errorCode != FFX_OK)
+                return abortBackendContextSetup(backendContext, errorCode);
         }
 
         // Setup Breadcrumbs data
         {
             FfxDeviceCapabilities devCaps = {};
             if (GetDeviceCapabilitiesVK(backendInterface, &devCaps) != FFX_OK)
-                return FFX_ERROR_BACKEND_API_ERROR;
+                return abortBackendContextSetup(backendContext, FFX_ERROR_BACKEND_API_ERROR);
 
             // Get info for memory used as Breadcrumbs buffer
             VkBufferCreateInfo bufferInfo = {};
@@ -1624,7 +2754,7 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
             if (vkCreateBuffer(backendContext->device, &bufferInfo, nullptr, &testBuffer) != VK_SUCCESS)
             {
                 FFX_ASSERT_FAIL("Cannot create test Breadcrumbs buffer to find memory requirements!");
-                return FFX_ERROR_BACKEND_API_ERROR;
+                return abortBackendContextSetup(backendContext, FFX_ERROR_BACKEND_API_ERROR);
             }
 
             uint32_t memoryTypeBits = 0;
@@ -1693,7 +2823,7 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
             if (backendContext->breadcrumbsMemoryIndex == UINT32_MAX)
             {
                 FFX_ASSERT_FAIL("No memory that satisfies requirements requested by Breadcrumbs buffer type!");
-                return FFX_ERROR_BACKEND_API_ERROR;
+                return abortBackendContextSetup(backendContext, FFX_ERROR_BACKEND_API_ERROR);
             }
 
             // Will switch to use vkCmdWriteBufferMarkerAMD() to write breadcrumbs into the buffer instead of vkCmdFillBuffer() for ensuring proper ordering of writes
@@ -1703,6 +2833,10 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
             // Together with BREADCRUMBS_BUFFER_MARKER_ENABLED flag will switch to vkCmdWriteBufferMarker2AMD() to use new synchronization facilities
             if (devCaps.extendedSynchronizationSupported)
                 backendContext->breadcrumbsFlags |= BackendContext_VK::BREADCRUMBS_SYNCHRONIZATION2_ENABLED;
+
+            // Record barriers with vkCmdPipelineBarrier2KHR so each one only waits on its own stages. The device supporting the
+            // extension isn't enough: the application has to have enabled the feature when it created the device
+            backendContext->synchronization2 = vkDeviceContext->synchronization2 && backendContext->vkFunctionTable.vkCmdPipelineBarrier2KHR;
         }
     }
 
@@ -1728,21 +2862,24 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
             }
             effectContext.nextPipelineLayout = (i * FFX_MAX_PASS_COUNT);
             effectContext.frameIndex = 0;
+            effectContext.frameCount = 0;
+            effectContext.uniformBufferOffset = 0;
 
             if (bindlessConfig)
             {
-                effectContext.bindlessTextureSrvHeapStart = backendContext->bindlessBase;
-                effectContext.bindlessTextureSrvHeapSize  = bindlessConfig->maxTextureSrvs;
+                uint32_t bindlessViewStart = 0;
+                FfxErrorCode errorCode = reserveBindlessViews(backendContext, bindlessConfig->maxTextureSrvs + bindlessConfig->maxTextureUavs, &bindlessViewStart);
+                if (errorCode != FFX_OK)
+                    return errorCode;
 
-                backendContext->bindlessBase += bindlessConfig->maxTextureSrvs;
+                effectContext.bindlessTextureSrvHeapStart = bindlessViewStart;
+                effectContext.bindlessTextureSrvHeapSize  = bindlessConfig->maxTextureSrvs;
 
                 effectContext.bindlessBufferSrvHeapSize  = bindlessConfig->maxBufferSrvs;
 
-                effectContext.bindlessTextureUavHeapStart = backendContext->bindlessBase;
+                effectContext.bindlessTextureUavHeapStart = bindlessViewStart + bindlessConfig->maxTextureSrvs;
                 effectContext.bindlessTextureUavHeapSize  = bindlessConfig->maxTextureUavs;
 
-                backendContext->bindlessBase += bindlessConfig->maxTextureUavs;
-
                 effectContext.bindlessBufferUavHeapSize  = bindlessConfig->maxBufferUavs;
 
                 
@@ -2095,6 +3232,30 @@ FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 e
 
     for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
         destroyDynamicViews(backendContext, effectContextId, frameIndex);
+    destroyCachedImageViews(backendContext, VK_NULL_HANDLE, effectContextId);
+
+    for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
+    {
+        if (effectContext.transientDescriptorPools[frameIndex] != VK_NULL_HANDLE)
+        {
+            backendContext->vkFunctionTable.vkDestroyDescriptorPool(backendContext->device, effectContext.transientDescriptorPools[frameIndex], VK_NULL_HANDLE);
+            effectContext.transientDescriptorPools[frameIndex] = VK_NULL_HANDLE;
+        }
+    }
+
+    // destroy the bindless image views, and give their range back when no later context reserved views after it
+    const uint32_t bindlessViewCount = effectContext.bindlessTextureSrvHeapSize + effectContext.bindlessTextureUavHeapSize;
+    for (uint32_t viewIndex = effectContext.bindlessTextureSrvHeapStart; viewIndex < effectContext.bindlessTextureSrvHeapStart + bindlessViewCount; ++viewIndex)
+    {
+        BackendContext_VK::VkResourceView& bindlessView = getBindlessView(backendContext, viewIndex);
+        if (bindlessView.imageView != VK_NULL_HANDLE)
+        {
+            backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, bindlessView.imageView, VK_NULL_HANDLE);
+            bindlessView.imageView = VK_NULL_HANDLE;
+        }
+    }
+    if (bindlessViewCount && effectContext.bindlessTextureSrvHeapStart + bindlessViewCount == backendContext->bindlessBase)
+        backendContext->bindlessBase = effectContext.bindlessTextureSrvHeapStart;
 
     // clean up descriptor set layouts
     if (effectContext.bindlessTextureSrvDescriptorSetLayout)
@@ -2144,18 +3305,16 @@ FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 e
 
     if (!backendContext->refCount) {
 
-        // clean up descriptor pool
-        backendContext->vkFunctionTable.vkDestroyDescriptorPool(backendContext->device, backendContext->descriptorPool, VK_NULL_HANDLE);
-        backendContext->descriptorPool = VK_NULL_HANDLE;
+        // clean up descriptor pools, gpu jobs and bindless views
+        releaseOnDemandMemory(backendContext);
 
-        // clean up dynamic uniform buffer & memory
-        backendContext->vkFunctionTable.vkUnmapMemory(backendContext->device, backendContext->uniformBufferMemory);
-        backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, backendContext->uniformBufferMemory, VK_NULL_HANDLE);
-        backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, backendContext->uniformBuffer, VK_NULL_HANDLE);
+        // clean up dynamic uniform buffers & memory
+        destroyUniformBuffers(backendContext);
 
         backendContext->device = VK_NULL_HANDLE;
         backendContext->physicalDevice = VK_NULL_HANDLE;
 
+        destroyBackendSynchronization(backendContext);
         resetBackendContext(backendContext);
     }
 
@@ -2206,6 +3365,11 @@ FfxErrorCode CreateResourceVK(
             createResourceDescription->resourceDescription.height), createResourceDescription->resourceDescription.depth))));
     }
 
+    // every mip has its own tracked state
+    FFX_ASSERT_MESSAGE(resourceDesc.type == FFX_RESOURCE_TYPE_BUFFER || resourceDesc.mipCount <= FFX_MAX_TRACKED_MIP_COUNT,
+                       "FFXInterface: Vulkan: Too many mips. Please increase FFX_MAX_TRACKED_MIP_COUNT");
+    FFX_RETURN_ON_ERROR(resourceDesc.type == FFX_RESOURCE_TYPE_BUFFER || resourceDesc.mipCount <= FFX_MAX_TRACKED_MIP_COUNT, FFX_ERROR_INVALID_ARGUMENT);
+
     FFX_ASSERT(effectContext.nextStaticResource + 1 < effectContext.nextDynamicResource);
     outResource->internalIndex = effectContext.nextStaticResource++;
     BackendContext_VK::Resource* backendResource = &backendContext->pResources[outResource->internalIndex];
@@ -2221,7 +3385,7 @@ FfxErrorCode CreateResourceVK(
             ? FFX_RESOURCE_STATE_COPY_DEST
             : createResourceDescription->initialState;
     backendResource->initialState = resourceState;
-    backendResource->currentState = resourceState;
+    setResourceState(backendResource, resourceState);
 
 #ifdef _DEBUG
     size_t retval = 0;
@@ -2500,6 +3664,7 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
             // Destroy the resource
             if (backgroundResource.bufferResource != VK_NULL_HANDLE)
             {
+                retireDescriptorHandle(backendContext, effectContextId, backgroundResource.bufferResource);
                 backendContext->vkFunctionTable.vkDestroyBuffer(backendContext->device, backgroundResource.bufferResource, nullptr);
                 backgroundResource.bufferResource = VK_NULL_HANDLE;
             }
@@ -2509,6 +3674,7 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
             // Destroy SRV
             if (backgroundResource.srvViewIndex >= 0)
             {
+                retireDescriptorHandle(backendContext, effectContextId, backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView);
                 backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView, nullptr);
                 backendContext->pResourceViews[backgroundResource.srvViewIndex].imageView = VK_NULL_HANDLE;
                 backgroundResource.srvViewIndex                                           = 0;
@@ -2521,6 +3687,7 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
                  {
                      if (backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView != VK_NULL_HANDLE)
                      {
+                         retireDescriptorHandle(backendContext, effectContextId, backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView);
                          backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView, nullptr);
                          backendContext->pResourceViews[backgroundResource.uavViewIndex + i].imageView = VK_NULL_HANDLE;
                      }
@@ -2600,6 +3767,12 @@ FfxErrorCode RegisterResourceVK(
         return FFX_OK;
     }
 
+    // every mip has its own tracked state
+    FFX_ASSERT_MESSAGE(inFfxResource->description.type == FFX_RESOURCE_TYPE_BUFFER || inFfxResource->description.mipCount <= FFX_MAX_TRACKED_MIP_COUNT,
+                       "FFXInterface: Vulkan: Too many mips. Please increase FFX_MAX_TRACKED_MIP_COUNT");
+    FFX_RETURN_ON_ERROR(inFfxResource->description.type == FFX_RESOURCE_TYPE_BUFFER || inFfxResource->description.mipCount <= FFX_MAX_TRACKED_MIP_COUNT,
+                        FFX_ERROR_INVALID_ARGUMENT);
+
     // In vulkan we need to treat dynamic resources a little differently due to needing views to live as long as the GPU needs them.
     // We will treat them more like static resources and use the nextDynamicResource as a "hint" for where it should be.
     // Failure to find the pre-existing resource at the expected location will force a search until the resource is found.
@@ -2673,6 +3846,7 @@ FfxErrorCode RegisterResourceVK(
     switch (backendResource->resourceDescription.type)
     {
     case FFX_RESOURCE_TYPE_BUFFER:
+        // like images, a registered buffer is identified by its handle
         break;
     case FFX_RESOURCE_TYPE_TEXTURE1D:
     case FFX_RESOURCE_TYPE_TEXTURE2D:
@@ -2722,7 +3896,7 @@ FfxErrorCode RegisterResourceVK(
         VkImageViewUsageCreateInfo imageViewUsageCreateInfo = {};
         addMutableViewForSRV(imageViewCreateInfo, imageViewUsageCreateInfo, backendResource->resourceDescription);
 
-        if (backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->srvViewIndex].imageView) != VK_SUCCESS) {
+        if (acquireImageView(backendContext, effectContextId, imageViewCreateInfo, backendResource->srvViewIndex) != VK_SUCCESS) {
             return FFX_ERROR_BACKEND_API_ERROR;
         }
 #ifdef _DEBUG
@@ -2745,7 +3919,7 @@ FfxErrorCode RegisterResourceVK(
                 imageViewCreateInfo.subresourceRange.levelCount = 1;
                 imageViewCreateInfo.subresourceRange.baseMipLevel = mip;
 
-                if (backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->uavViewIndex + mip].imageView) != VK_SUCCESS) {
+                if (acquireImageView(backendContext, effectContextId, imageViewCreateInfo, backendResource->uavViewIndex + mip) != VK_SUCCESS) {
                     return FFX_ERROR_BACKEND_API_ERROR;
                 }
 #ifdef _DEBUG
@@ -2782,7 +3956,8 @@ FfxResource GetResourceVK(FfxInterface* backendInterface, FfxResourceInternal in
         // execution
         backendContext->pResources[inResource.internalIndex].undefined = false;
     }
-    resource.state = backendContext->pResources[inResource.internalIndex].currentState;
+    // mips only diverge between the dispatches of a frame, UnregisterResourcesVK returns them all to the initial state
+    resource.state = backendContext->pResources[inResource.internalIndex].currentStates[0];
     resource.description = ffxResDescription;
 
 #ifdef _DEBUG
@@ -2802,6 +3977,9 @@ FfxErrorCode UnregisterResourcesVK(FfxInterface* backendInterface, FfxCommandLis
     BackendContext_VK* backendContext = (BackendContext_VK*)(backendInterface->scratchBuffer);
     BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
 
+    BackendContext_VK::Recorder* recorder = acquireRecorder(backendContext);
+    FFX_RETURN_ON_ERROR(recorder, FFX_ERROR_OUT_OF_MEMORY);
+
     // Walk back all the resources that don't belong to us and reset them to their initial state
     const uint32_t dynamicResourceIndexStart = getDynamicResourcesStartIndex(effectContextId);
     for (uint32_t resourceIndex = ++effectContext.nextDynamicResource; resourceIndex <= dynamicResourceIndexStart; ++resourceIndex)
@@ -2816,13 +3994,14 @@ FfxErrorCode UnregisterResourcesVK(FfxInterface* backendInterface, FfxCommandLis
         backendResource->srvViewIndex = -1;
 
         // Add the barrier
-        addBarrier(backendContext, &internalResource, backendResource->initialState);
+        addBarrier(backendContext, recorder, &internalResource, backendResource->initialState);
     }
 
     FFX_ASSERT(nullptr != commandList);
     VkCommandBuffer pCmdList = reinterpret_cast<VkCommandBuffer>(commandList);
 
-    flushBarriers(backendContext, pCmdList);
+    flushBarriers(backendContext, recorder, pCmdList);
+    releaseRecorder(backendContext, recorder);
 
     // Just reset the dynamic resource index, but leave the images views.
     // They will be deleted in the first pipeline destroy call as they need to live until then
@@ -2830,8 +4009,29 @@ FfxErrorCode UnregisterResourcesVK(FfxInterface* backendInterface, FfxCommandLis
 
     // destroy the views of the next frame
     effectContext.frameIndex = (effectContext.frameIndex + 1) % FFX_MAX_QUEUED_FRAMES;
+    ++effectContext.frameCount;
     destroyDynamicViews(backendContext, effectContextId, effectContext.frameIndex);
 
+    // and the transient descriptor sets they were written to, recreating the pool on demand if a larger layout was created since
+    VkDescriptorPool& transientPool = effectContext.transientDescriptorPools[effectContext.frameIndex];
+    if (transientPool != VK_NULL_HANDLE)
+    {
+        std::unique_lock<std::mutex> lock{backendContext->pLocks->descriptorPool};
+        const bool poolOutdated = effectContext.transientDescriptorPoolVersions[effectContext.frameIndex] != backendContext->layoutDescriptorCountsVersion;
+        lock.unlock();
+
+        if (poolOutdated)
+        {
+            backendContext->vkFunctionTable.vkDestroyDescriptorPool(backendContext->device, transientPool, nullptr);
+            transientPool = VK_NULL_HANDLE;
+        }
+        else
+            backendContext->vkFunctionTable.vkResetDescriptorPool(backendContext->device, transientPool, 0);
+    }
+
+    // and the constant buffers of its uniform buffer partition
+    effectContext.uniformBufferOffset = 0;
+
     return FFX_OK;
 }
 
@@ -2896,13 +4096,13 @@ FfxErrorCode registerStaticTextureSrv(BackendContext_VK* backendContext, const F
         imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
         imageViewCreateInfo.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
 
-        uint32_t imageViewIndex = effectContext.bindlessTextureSrvHeapStart + index;
+        BackendContext_VK::VkResourceView& bindlessView = getBindlessView(backendContext, effectContext.bindlessTextureSrvHeapStart + index);
 
-        if (backendContext->pResourceViews[imageViewIndex].imageView)
-            backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[imageViewIndex].imageView, nullptr);
+        if (bindlessView.imageView)
+            backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, bindlessView.imageView, nullptr);
 
         if (backendContext->vkFunctionTable.vkCreateImageView(
-                backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[imageViewIndex].imageView) != VK_SUCCESS)
+                backendContext->device, &imageViewCreateInfo, NULL, &bindlessView.imageView) != VK_SUCCESS)
         {
             return FFX_ERROR_BACKEND_API_ERROR;
         }
@@ -2916,7 +4116,7 @@ FfxErrorCode registerStaticTextureSrv(BackendContext_VK* backendContext, const F
         setVKObjectName(backendContext->vkFunctionTable,
                         backendContext->device,
                         VK_OBJECT_TYPE_IMAGE_VIEW,
-                        (uint64_t)backendContext->pResourceViews[imageViewIndex].imageView,
+                        (uint64_t)bindlessView.imageView,
                         resourceName);
 #endif
 
@@ -2932,7 +4132,7 @@ FfxErrorCode registerStaticTextureSrv(BackendContext_VK* backendContext, const F
         writeDescriptorSet.dstArrayElement = index;
 
         imageDescriptorInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageDescriptorInfo.imageView   = backendContext->pResourceViews[imageViewIndex].imageView;
+        imageDescriptorInfo.imageView   = bindlessView.imageView;
 
         backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, 1, &writeDescriptorSet, 0, nullptr);
 
@@ -3047,13 +4247,13 @@ FfxErrorCode registerStaticTextureUav(BackendContext_VK* backendContext, const F
         imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
         imageViewCreateInfo.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
 
-        uint32_t imageViewIndex = effectContext.bindlessTextureUavHeapStart + index;
+        BackendContext_VK::VkResourceView& bindlessView = getBindlessView(backendContext, effectContext.bindlessTextureUavHeapStart + index);
 
-        if (backendContext->pResourceViews[imageViewIndex].imageView)
-            backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[imageViewIndex].imageView, nullptr);
+        if (bindlessView.imageView)
+            backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, bindlessView.imageView, nullptr);
 
         if (backendContext->vkFunctionTable.vkCreateImageView(
-                backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[imageViewIndex].imageView) != VK_SUCCESS)
+                backendContext->device, &imageViewCreateInfo, NULL, &bindlessView.imageView) != VK_SUCCESS)
         {
             return FFX_ERROR_BACKEND_API_ERROR;
         }
@@ -3067,7 +4267,7 @@ FfxErrorCode registerStaticTextureUav(BackendContext_VK* backendContext, const F
         setVKObjectName(backendContext->vkFunctionTable,
                         backendContext->device,
                         VK_OBJECT_TYPE_IMAGE_VIEW,
-                        (uint64_t)backendContext->pResourceViews[imageViewIndex].imageView,
+                        (uint64_t)bindlessView.imageView,
                         resourceName);
 #endif
 
@@ -3083,7 +4283,7 @@ FfxErrorCode registerStaticTextureUav(BackendContext_VK* backendContext, const F
         writeDescriptorSet.dstArrayElement = index;
 
         imageDescriptorInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-        imageDescriptorInfo.imageView   = backendContext->pResourceViews[imageViewIndex].imageView;
+        imageDescriptorInfo.imageView   = bindlessView.imageView;
 
         backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, 1, &writeDescriptorSet, 0, nullptr);
 
@@ -3177,18 +4377,52 @@ FfxErrorCode StageConstantBufferDataVK(FfxInterface* backendInterface, void* dat
 
     if (data && constantBuffer)
     {
-        if ((backendContext->stagingRingBufferBase + FFX_ALIGN_UP(size, 256)) >= FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE)
-            backendContext->stagingRingBufferBase = 0;
+        BackendContext_VK::Recorder* recorder = acquireRecorder(backendContext);
+        FFX_RETURN_ON_ERROR(recorder, FFX_ERROR_OUT_OF_MEMORY);
+
+        if (!recorder->pStagingRingBuffer)
+        {
+            recorder->pStagingRingBuffer = (uint8_t*)malloc(FFX_RECORDER_STAGING_RING_SIZE);
+            FFX_RETURN_ON_ERROR(recorder->pStagingRingBuffer, FFX_ERROR_OUT_OF_MEMORY);
+        }
+
+        // the ring may only wrap over constants already copied to the uniform buffer by ExecuteGpuJobsVK
+        const uint32_t stagingSize = FFX_ALIGN_UP(size, FFX_CONSTANT_BUFFER_STAGING_ALIGNMENT);
+        uint32_t stagingBase = recorder->stagingRingBufferBase;
+        uint32_t skippedSize = 0;
+        if (stagingBase + stagingSize > FFX_RECORDER_STAGING_RING_SIZE)
+        {
+            skippedSize = FFX_RECORDER_STAGING_RING_SIZE - stagingBase;
+            stagingBase = 0;
+        }
+
+        uint32_t* dstPtr = nullptr;
+        if (recorder->stagingRingBufferPending + skippedSize + stagingSize <= FFX_RECORDER_STAGING_RING_SIZE)
+        {
+            dstPtr = (uint32_t*)(recorder->pStagingRingBuffer + stagingBase);
+
+            recorder->stagingRingBufferBase = stagingBase + stagingSize;
+            recorder->stagingRingBufferPending += skippedSize + stagingSize;
+            recorder->peakStagingUsage = FFX_MAXIMUM(recorder->peakStagingUsage, uint64_t(recorder->stagingRingBufferPending));
+        }
+        else
+        {
+            // the ring is full of constants not executed yet, stage these in heap memory until the next execution
+            BackendContext_VK::StagingOverflowBlock* block = (BackendContext_VK::StagingOverflowBlock*)malloc(sizeof(BackendContext_VK::StagingOverflowBlock) + size);
+            FFX_RETURN_ON_ERROR(block, FFX_ERROR_OUT_OF_MEMORY);
+
+            block->pNext = recorder->pStagingOverflowBlocks;
+            recorder->pStagingOverflowBlocks = block;
+            ++recorder->stagingOverflowCount;
 
-        uint32_t* dstPtr = (uint32_t*)(backendContext->pStagingRingBuffer + backendContext->stagingRingBufferBase);
+            dstPtr = (uint32_t*)(block + 1);
+        }
 
         memcpy(dstPtr, data, size);
 
         constantBuffer->data            = dstPtr;
         constantBuffer->num32BitEntries = size / sizeof(uint32_t);
 
-        backendContext->stagingRingBufferBase += FFX_ALIGN_UP(size, 256);
-
         return FFX_OK;
     }
     else
@@ -3391,9 +4625,56 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
             shaderBlob.boundConstantBufferCounts[cbIndex], shaderStageFlags, nullptr };
     }
 
+    // Push the descriptors when they fit, otherwise bind cached descriptor sets
+    uint32_t descriptorCount = 0;
+    for (uint32_t bindingIndex = 0; bindingIndex < numLayoutBindings; ++bindingIndex)
+        descriptorCount += layoutBindings[bindingIndex].descriptorCount;
+    pPipelineLayout->pushDescriptors = backendContext->maxPushDescriptors > 0 && descriptorCount <= backendContext->maxPushDescriptors;
+    pPipelineLayout->descriptorSetCount = 0;
+    pPipelineLayout->descriptorSetKeys = nullptr;
+    pPipelineLayout->descriptorSetKeyCapacity = descriptorCount;
+
+    // Cached sets take the constant buffer offset at bind time so their contents stay the same between dispatches
+    if (!pPipelineLayout->pushDescriptors)
+    {
+        for (uint32_t bindingIndex = 0; bindingIndex < numLayoutBindings; ++bindingIndex)
+        {
+            if (layoutBindings[bindingIndex].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+            {
+                FFX_ASSERT_MESSAGE(layoutBindings[bindingIndex].descriptorCount == 1, "FFXInterface: Vulkan: Constant buffer arrays are not supported.");
+                layoutBindings[bindingIndex].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            }
+        }
+    }
+
+    // Size the descriptor pools added from now on to hold sets of this layout
+    if (!pPipelineLayout->pushDescriptors)
+    {
+        uint32_t typeCounts[FFX_DESCRIPTOR_POOL_TYPE_COUNT] = {};
+        for (uint32_t bindingIndex = 0; bindingIndex < numLayoutBindings; ++bindingIndex)
+        {
+            for (uint32_t typeIndex = 0; typeIndex < FFX_DESCRIPTOR_POOL_TYPE_COUNT; ++typeIndex)
+            {
+                if (layoutBindings[bindingIndex].descriptorType == s_descriptorPoolTypes[typeIndex])
+                    typeCounts[typeIndex] += layoutBindings[bindingIndex].descriptorCount;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock{backendContext->pLocks->descriptorPool};
+        for (uint32_t typeIndex = 0; typeIndex < FFX_DESCRIPTOR_POOL_TYPE_COUNT; ++typeIndex)
+        {
+            if (typeCounts[typeIndex] > backendContext->layoutDescriptorCounts[typeIndex])
+            {
+                backendContext->layoutDescriptorCounts[typeIndex] = typeCounts[typeIndex];
+                ++backendContext->layoutDescriptorCountsVersion;
+            }
+        }
+    }
+
     // Create the descriptor layout
     VkDescriptorSetLayoutCreateInfo layoutInfo = {};
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.flags = pPipelineLayout->pushDescriptors ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
     layoutInfo.bindingCount = numLayoutBindings;
     layoutInfo.pBindings = layoutBindings;
 
@@ -3401,22 +4682,6 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
         return FFX_ERROR_BACKEND_API_ERROR;
     }
 
-    // allocate descriptor sets
-    pPipelineLayout->descriptorSetIndex = 0;
-    for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME); i++)
-    {
-        VkDescriptorSetAllocateInfo allocateInfo = {};
-        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocateInfo.descriptorPool = backendContext->descriptorPool;
-        allocateInfo.descriptorSetCount = 1;
-        allocateInfo.pSetLayouts = &pPipelineLayout->descriptorSetLayout;
-
-        if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, &pPipelineLayout->descriptorSets[i]) != VK_SUCCESS)
-        {
-            return FFX_ERROR_BACKEND_API_ERROR;
-        }
-    }
-
     uint32_t setCount = 0;
 
     VkDescriptorSetLayout layouts[5];
@@ -3624,11 +4889,35 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
     pipelineCreateInfo.stage = shaderStageCreateInfo;
     pipelineCreateInfo.layout = pPipelineLayout->pipelineLayout;
 
+    // pipelines are identified in the cache by their code, subgroup size and layout inputs
+    BackendContext_VK::PipelineCache& pipelineCache = backendContext->pipelineCache;
+    uint64_t pipelineKey = 0;
+    if (pipelineCache.pipelineCache != VK_NULL_HANDLE)
+    {
+        const uint32_t layoutInputs[] = { shaderStageCreateInfo.pNext ? 64u : 0u, pipelineDescription->samplerCount, pipelineDescription->rootConstantBufferCount };
+        pipelineKey = hashPipelineCacheBytes(0xcbf29ce484222325ull, shaderBlob.data, shaderBlob.size);
+        pipelineKey = hashPipelineCacheBytes(pipelineKey, layoutInputs, sizeof(layoutInputs));
+        pipelineKey = pipelineKey ? pipelineKey : 1;
+    }
+
     VkPipeline computePipeline = VK_NULL_HANDLE;
-    if (backendContext->vkFunctionTable.vkCreateComputePipelines(backendContext->device, nullptr, 1, &pipelineCreateInfo, nullptr, &computePipeline) != VK_SUCCESS) {
+    if (backendContext->vkFunctionTable.vkCreateComputePipelines(backendContext->device, pipelineCache.pipelineCache, 1, &pipelineCreateInfo, nullptr, &computePipeline) != VK_SUCCESS) {
         return FFX_ERROR_BACKEND_API_ERROR;
     }
 
+    if (pipelineCache.pipelineCache != VK_NULL_HANDLE)
+    {
+        if (containsPipelineCacheKey(pipelineCache, pipelineKey))
+        {
+            ++pipelineCache.statistics.hitCount;
+        }
+        else
+        {
+            ++pipelineCache.statistics.missCount;
+            insertPipelineCacheKey(pipelineCache, pipelineKey);
+        }
+    }
+
     // done with shader module, so clean up
     backendContext->vkFunctionTable.vkDestroyShaderModule(backendContext->device, shaderModule, nullptr);
 
@@ -3671,11 +4960,20 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
             pPipelineLayout->pipelineLayout = VK_NULL_HANDLE;
         }
 
-        // Descriptor sets
-        for (uint32_t i = 0; i < FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME; i++) {
-            backendContext->vkFunctionTable.vkFreeDescriptorSets(backendContext->device, backendContext->descriptorPool, 1, &pPipelineLayout->descriptorSets[i]);
-            pPipelineLayout->descriptorSets[i] = VK_NULL_HANDLE;
+        // Descriptor sets, back to the pools shared by all effect contexts
+        {
+            std::lock_guard<std::mutex> lock{backendContext->pLocks->descriptorPool};
+            for (uint32_t i = 0; i < pPipelineLayout->descriptorSetCount; i++) {
+                BackendContext_VK::DescriptorPool& descriptorPool = backendContext->descriptorPools[pPipelineLayout->descriptorSetPools[i]];
+                backendContext->vkFunctionTable.vkFreeDescriptorSets(backendContext->device, descriptorPool.descriptorPool, 1, &pPipelineLayout->descriptorSets[i]);
+                pPipelineLayout->descriptorSets[i] = VK_NULL_HANDLE;
+                --descriptorPool.setCount;
+                --backendContext->descriptorSetCount;
+            }
         }
+        pPipelineLayout->descriptorSetCount = 0;
+        free(pPipelineLayout->descriptorSetKeys);
+        pPipelineLayout->descriptorSetKeys = nullptr;
 
         // Descriptor set layout
         if (pPipelineLayout->descriptorSetLayout != VK_NULL_HANDLE) {
@@ -3703,18 +5001,307 @@ FfxErrorCode ScheduleGpuJobVK(FfxInterface* backendInterface, const FfxGpuJobDes
 
     BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
 
-    FFX_ASSERT(backendContext->gpuJobCount < FFX_MAX_GPU_JOBS);
+    // jobs go to the recorder of the calling thread, and are recorded by its next ExecuteGpuJobsVK
+    BackendContext_VK::Recorder* recorder = acquireRecorder(backendContext);
+    FFX_RETURN_ON_ERROR(recorder, FFX_ERROR_OUT_OF_MEMORY);
+
+    FFX_ASSERT(recorder->gpuJobCount < FFX_MAX_GPU_JOBS);
+
+    // the job list grows a chunk at a time, and keeps its chunks for the following frames
+    FfxGpuJobDescription*& gpuJobChunk = recorder->gpuJobChunks[recorder->gpuJobCount / FFX_GPU_JOB_CHUNK_SIZE];
+    if (!gpuJobChunk)
+    {
+        gpuJobChunk = (FfxGpuJobDescription*)malloc(FFX_GPU_JOB_CHUNK_SIZE * sizeof(FfxGpuJobDescription));
+        FFX_RETURN_ON_ERROR(gpuJobChunk, FFX_ERROR_OUT_OF_MEMORY);
+    }
+
+    *getGpuJob(recorder, recorder->gpuJobCount) = *job;
+    recorder->gpuJobCount++;
+    recorder->peakGpuJobCount = FFX_MAXIMUM(recorder->peakGpuJobCount, recorder->gpuJobCount);
+
+    return FFX_OK;
+}
+
+// Hash of the descriptors written to a set, never 0, and the bloom filter of the views and buffers they reference
+static uint64_t hashDescriptorWrites(const VkWriteDescriptorSet* writeDescriptorSets, uint32_t writeCount, uint64_t* outHandleMask)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    uint64_t handleMask = 0;
+    for (uint32_t i = 0; i < writeCount; ++i)
+    {
+        const VkWriteDescriptorSet& write = writeDescriptorSets[i];
+        const uint32_t location[] = { write.dstBinding, write.dstArrayElement, (uint32_t)write.descriptorType };
+        hash = hashPipelineCacheBytes(hash, location, sizeof(location));
+
+        if (write.pImageInfo)
+        {
+            hash = hashPipelineCacheBytes(hash, &write.pImageInfo->imageView, sizeof(write.pImageInfo->imageView));
+            hash = hashPipelineCacheBytes(hash, &write.pImageInfo->imageLayout, sizeof(write.pImageInfo->imageLayout));
+            handleMask |= getDescriptorHandleBit(write.pImageInfo->imageView);
+        }
+        else
+        {
+            hash = hashPipelineCacheBytes(hash, &write.pBufferInfo->buffer, sizeof(write.pBufferInfo->buffer));
+            hash = hashPipelineCacheBytes(hash, &write.pBufferInfo->offset, sizeof(write.pBufferInfo->offset));
+            hash = hashPipelineCacheBytes(hash, &write.pBufferInfo->range, sizeof(write.pBufferInfo->range));
+
+            // uniform buffers are kept until the backend is destroyed
+            if (write.descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+                handleMask |= getDescriptorHandleBit(write.pBufferInfo->buffer);
+        }
+    }
+
+    *outHandleMask = handleMask;
+    return hash ? hash : 1;
+}
+
+static BackendContext_VK::DescriptorSetKeyEntry getDescriptorSetKeyEntry(const VkWriteDescriptorSet& write)
+{
+    BackendContext_VK::DescriptorSetKeyEntry entry = {};
+    entry.binding = write.dstBinding;
+    entry.arrayElement = write.dstArrayElement;
+    entry.descriptorType = write.descriptorType;
+    if (write.pImageInfo)
+    {
+        entry.imageLayout = write.pImageInfo->imageLayout;
+        entry.handle = (uint64_t)write.pImageInfo->imageView;
+    }
+    else
+    {
+        entry.handle = (uint64_t)write.pBufferInfo->buffer;
+        entry.offset = write.pBufferInfo->offset;
+        entry.range = write.pBufferInfo->range;
+    }
+    return entry;
+}
+
+// The hashes of different bindings can collide, so a cached set is only reused when every descriptor written to it matches
+static bool descriptorSetKeyMatches(const BackendContext_VK::PipelineLayout* pipelineLayout,
+                                    uint32_t                                 setIndex,
+                                    const VkWriteDescriptorSet*              writeDescriptorSets,
+                                    uint32_t                                 writeCount)
+{
+    if (pipelineLayout->descriptorSetKeyCounts[setIndex] != writeCount)
+        return false;
+
+    const BackendContext_VK::DescriptorSetKeyEntry* key = pipelineLayout->descriptorSetKeys + setIndex * pipelineLayout->descriptorSetKeyCapacity;
+    for (uint32_t i = 0; i < writeCount; ++i)
+    {
+        const BackendContext_VK::DescriptorSetKeyEntry entry = getDescriptorSetKeyEntry(writeDescriptorSets[i]);
+        if (memcmp(&entry, &key[i], sizeof(entry)) != 0)
+            return false;
+    }
+    return true;
+}
+
+// Forget the cached descriptor sets of an effect context that may hold a view or buffer destroyed since the last call
+static void invalidateDestroyedDescriptorHandles(BackendContext_VK* backendContext, FfxUInt32 effectContextId)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    if (!effectContext.destroyedDescriptorHandles.load(std::memory_order_relaxed))
+        return;
+
+    const uint64_t destroyedHandles = effectContext.destroyedDescriptorHandles.exchange(0, std::memory_order_acquire);
+    for (uint32_t layoutIndex = effectContextId * FFX_MAX_PASS_COUNT; layoutIndex < effectContext.nextPipelineLayout; ++layoutIndex)
+    {
+        BackendContext_VK::PipelineLayout& pipelineLayout = backendContext->pPipelineLayouts[layoutIndex];
+        for (uint32_t i = 0; i < pipelineLayout.descriptorSetCount; ++i)
+        {
+            if (pipelineLayout.descriptorSetHandleMasks[i] & destroyedHandles)
+                pipelineLayout.descriptorSetHashes[i] = 0;
+        }
+    }
+}
+
+// Allocate a set from the pool chain, adding a pool sized for the largest layouts seen so far when all of them are full
+static FfxErrorCode allocateCachedDescriptorSet(BackendContext_VK*    backendContext,
+                                                VkDescriptorSetLayout descriptorSetLayout,
+                                                VkDescriptorSet*      outDescriptorSet,
+                                                uint8_t*              outPoolIndex)
+{
+    VkDescriptorSetAllocateInfo allocateInfo = {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &descriptorSetLayout;
+
+    // pools added last are the most likely to have room
+    for (uint32_t poolIndex = backendContext->descriptorPoolCount; poolIndex-- > 0;)
+    {
+        BackendContext_VK::DescriptorPool& descriptorPool = backendContext->descriptorPools[poolIndex];
+        if (descriptorPool.setCount == descriptorPool.maxSets)
+            continue;
+
+        allocateInfo.descriptorPool = descriptorPool.descriptorPool;
+        if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, outDescriptorSet) == VK_SUCCESS)
+        {
+            ++descriptorPool.setCount;
+            *outPoolIndex = (uint8_t)poolIndex;
+            return FFX_OK;
+        }
+    }
+
+    FFX_RETURN_ON_ERROR(backendContext->descriptorPoolCount < FFX_MAX_DESCRIPTOR_POOLS, FFX_ERROR_OUT_OF_MEMORY);
+
+    BackendContext_VK::DescriptorPool& descriptorPool = backendContext->descriptorPools[backendContext->descriptorPoolCount];
+    descriptorPool.maxSets = FFX_DESCRIPTOR_POOL_SET_COUNT << FFX_MINIMUM(backendContext->descriptorPoolCount, 6u);
+    descriptorPool.setCount = 0;
+    descriptorPool.descriptorCount = 0;
+
+    VkDescriptorPoolSize poolSizes[FFX_DESCRIPTOR_POOL_TYPE_COUNT];
+    for (uint32_t typeIndex = 0; typeIndex < FFX_DESCRIPTOR_POOL_TYPE_COUNT; ++typeIndex)
+    {
+        poolSizes[typeIndex].type = s_descriptorPoolTypes[typeIndex];
+        poolSizes[typeIndex].descriptorCount = descriptorPool.maxSets * FFX_MAXIMUM(backendContext->layoutDescriptorCounts[typeIndex], 1u);
+        descriptorPool.descriptorCount += poolSizes[typeIndex].descriptorCount;
+    }
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    descriptorPoolCreateInfo.maxSets = descriptorPool.maxSets;
+    descriptorPoolCreateInfo.poolSizeCount = FFX_DESCRIPTOR_POOL_TYPE_COUNT;
+    descriptorPoolCreateInfo.pPoolSizes = poolSizes;
+
+    if (backendContext->vkFunctionTable.vkCreateDescriptorPool(backendContext->device, &descriptorPoolCreateInfo, nullptr, &descriptorPool.descriptorPool) != VK_SUCCESS)
+        return FFX_ERROR_BACKEND_API_ERROR;
+    ++backendContext->descriptorPoolCount;
+
+    allocateInfo.descriptorPool = descriptorPool.descriptorPool;
+    if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, outDescriptorSet) != VK_SUCCESS)
+        return FFX_ERROR_BACKEND_API_ERROR;
+
+    ++descriptorPool.setCount;
+    *outPoolIndex = (uint8_t)(backendContext->descriptorPoolCount - 1);
+    return FFX_OK;
+}
+
+// Find a descriptor set holding these bindings, or write them to one no queued frame can still be using.
+// Sets are matched on the handles they hold, which stay unique until the view or buffer is destroyed, and the
+// stored bindings are compared in full whenever the hash matches.
+static FfxErrorCode acquireDescriptorSet(BackendContext_VK*                  backendContext,
+                                         BackendContext_VK::Recorder*       recorder,
+                                         BackendContext_VK::PipelineLayout* pipelineLayout,
+                                         FfxUInt32                          effectContextId,
+                                         VkWriteDescriptorSet*              writeDescriptorSets,
+                                         uint32_t                           writeCount,
+                                         bool                               usesFrameViews,
+                                         VkDescriptorSet*                   outDescriptorSet)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    invalidateDestroyedDescriptorHandles(backendContext, effectContextId);
+
+    uint64_t       handleMask = 0;
+    const uint64_t hash       = hashDescriptorWrites(writeDescriptorSets, writeCount, &handleMask);
+
+    // a set with the same bindings can be bound again even while in flight, it is never written in that state
+    uint32_t setIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < pipelineLayout->descriptorSetCount; ++i)
+    {
+        if (pipelineLayout->descriptorSetHashes[i] == hash && effectContext.frameCount < pipelineLayout->descriptorSetExpiryFrames[i] &&
+            descriptorSetKeyMatches(pipelineLayout, i, writeDescriptorSets, writeCount))
+        {
+            pipelineLayout->descriptorSetFrames[i] = effectContext.frameCount;
+            *outDescriptorSet = pipelineLayout->descriptorSets[i];
+            ++recorder->descriptorStatistics.reuseCount;
+            return FFX_OK;
+        }
+
+        if (pipelineLayout->descriptorSetFrames[i] + FFX_MAX_QUEUED_FRAMES <= effectContext.frameCount &&
+            (setIndex == UINT32_MAX || pipelineLayout->descriptorSetFrames[i] < pipelineLayout->descriptorSetFrames[setIndex]))
+            setIndex = i;
+    }
+
+    VkDescriptorSetAllocateInfo allocateInfo = {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &pipelineLayout->descriptorSetLayout;
+
+    FFX_ASSERT(writeCount <= pipelineLayout->descriptorSetKeyCapacity);
+    if (!pipelineLayout->descriptorSetKeys)
+    {
+        const size_t keysSize = FFX_MAX_CACHED_DESCRIPTOR_SETS * pipelineLayout->descriptorSetKeyCapacity * sizeof(BackendContext_VK::DescriptorSetKeyEntry);
+        pipelineLayout->descriptorSetKeys = (BackendContext_VK::DescriptorSetKeyEntry*)malloc(FFX_MAXIMUM(keysSize, sizeof(BackendContext_VK::DescriptorSetKeyEntry)));
+        FFX_RETURN_ON_ERROR(pipelineLayout->descriptorSetKeys, FFX_ERROR_OUT_OF_MEMORY);
+    }
+
+    if (setIndex == UINT32_MAX && pipelineLayout->descriptorSetCount < FFX_MAX_CACHED_DESCRIPTOR_SETS)
+    {
+        // the pools are shared by all effect contexts
+        std::lock_guard<std::mutex> lock{backendContext->pLocks->descriptorPool};
+        const uint32_t newSetIndex = pipelineLayout->descriptorSetCount;
+        if (allocateCachedDescriptorSet(backendContext,
+                                        pipelineLayout->descriptorSetLayout,
+                                        &pipelineLayout->descriptorSets[newSetIndex],
+                                        &pipelineLayout->descriptorSetPools[newSetIndex]) == FFX_OK)
+        {
+            setIndex = pipelineLayout->descriptorSetCount++;
+            ++backendContext->descriptorSetCount;
+            backendContext->peakDescriptorSetCount = FFX_MAXIMUM(backendContext->peakDescriptorSetCount, backendContext->descriptorSetCount);
+        }
+    }
+
+    if (setIndex != UINT32_MAX)
+    {
+        pipelineLayout->descriptorSetHashes[setIndex] = hash;
+        pipelineLayout->descriptorSetKeyCounts[setIndex] = writeCount;
+        BackendContext_VK::DescriptorSetKeyEntry* key = pipelineLayout->descriptorSetKeys + setIndex * pipelineLayout->descriptorSetKeyCapacity;
+        for (uint32_t i = 0; i < writeCount; ++i)
+            key[i] = getDescriptorSetKeyEntry(writeDescriptorSets[i]);
+        pipelineLayout->descriptorSetHandleMasks[setIndex] = handleMask;
+        pipelineLayout->descriptorSetExpiryFrames[setIndex] = usesFrameViews ? effectContext.frameCount + FFX_MAX_QUEUED_FRAMES : UINT64_MAX;
+        pipelineLayout->descriptorSetFrames[setIndex] = effectContext.frameCount;
+        *outDescriptorSet = pipelineLayout->descriptorSets[setIndex];
+    }
+    else
+    {
+        // every cached set is in flight, use one that lives until this frame comes around again
+        VkDescriptorPool& transientPool = effectContext.transientDescriptorPools[effectContext.frameIndex];
+        if (transientPool == VK_NULL_HANDLE)
+        {
+            // room for FFX_TRANSIENT_DESCRIPTOR_SET_COUNT sets of the largest layouts created so far
+            VkDescriptorPoolSize poolSizes[FFX_DESCRIPTOR_POOL_TYPE_COUNT];
+            {
+                std::lock_guard<std::mutex> lock{backendContext->pLocks->descriptorPool};
+                for (uint32_t typeIndex = 0; typeIndex < FFX_DESCRIPTOR_POOL_TYPE_COUNT; ++typeIndex)
+                {
+                    poolSizes[typeIndex].type = s_descriptorPoolTypes[typeIndex];
+                    poolSizes[typeIndex].descriptorCount = FFX_TRANSIENT_DESCRIPTOR_SET_COUNT * FFX_MAXIMUM(backendContext->layoutDescriptorCounts[typeIndex], 1u);
+                }
+                effectContext.transientDescriptorPoolVersions[effectContext.frameIndex] = backendContext->layoutDescriptorCountsVersion;
+            }
+
+            VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
+            descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            descriptorPoolCreateInfo.maxSets = FFX_TRANSIENT_DESCRIPTOR_SET_COUNT;
+            descriptorPoolCreateInfo.poolSizeCount = FFX_DESCRIPTOR_POOL_TYPE_COUNT;
+            descriptorPoolCreateInfo.pPoolSizes = poolSizes;
+
+            if (backendContext->vkFunctionTable.vkCreateDescriptorPool(backendContext->device, &descriptorPoolCreateInfo, nullptr, &transientPool) != VK_SUCCESS)
+                return FFX_ERROR_BACKEND_API_ERROR;
+        }
+
+        allocateInfo.descriptorPool = transientPool;
+        if (backendContext->vkFunctionTable.vkAllocateDescriptorSets(backendContext->device, &allocateInfo, outDescriptorSet) != VK_SUCCESS)
+        {
+            FFX_ASSERT_MESSAGE(false, "FFXInterface: Vulkan: Ran out of transient descriptor sets. Please increase FFX_TRANSIENT_DESCRIPTOR_SET_COUNT");
+            return FFX_ERROR_OUT_OF_MEMORY;
+        }
+        ++recorder->descriptorStatistics.transientCount;
+    }
 
-    backendContext->pGpuJobs[backendContext->gpuJobCount] = *job;
-    backendContext->gpuJobCount++;
+    for (uint32_t i = 0; i < writeCount; ++i)
+        writeDescriptorSets[i].dstSet = *outDescriptorSet;
+    backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, writeCount, writeDescriptorSets, 0, nullptr);
+    ++recorder->descriptorStatistics.writeCount;
 
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
-                                         FfxGpuJobDescription* job,
-                                         VkCommandBuffer       vkCommandBuffer,
-                                         FfxUInt32             effectContextId)
+static FfxErrorCode executeGpuJobCompute(BackendContext_VK*           backendContext,
+                                         BackendContext_VK::Recorder* recorder,
+                                         FfxGpuJobDescription*        job,
+                                         VkCommandBuffer              vkCommandBuffer,
+                                         FfxUInt32                    effectContextId)
 {
     BackendContext_VK::PipelineLayout* pipelineLayout = reinterpret_cast<BackendContext_VK::PipelineLayout*>(job->computeJobDescriptor.pipeline.rootSignature);
 
@@ -3725,9 +5312,15 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
     // These MUST be initialized
     uint32_t               imageDescriptorIndex = 0;
     VkDescriptorImageInfo  imageDescriptorInfos[FFX_MAX_RESOURCE_COUNT];
+    bool                   usesFrameViews = false;
     for (int i = 0; i < FFX_MAX_RESOURCE_COUNT; ++i)
         imageDescriptorInfos[i] = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
 
+    // Dynamic constant buffer offsets of cached descriptor sets
+    uint32_t               dynamicOffsetCount = 0;
+    uint32_t               dynamicOffsetBindings[FFX_MAX_NUM_CONST_BUFFERS];
+    uint32_t               dynamicOffsets[FFX_MAX_NUM_CONST_BUFFERS];
+
     // These MUST be initialized
     uint32_t               bufferDescriptorIndex = 0;
     VkDescriptorBufferInfo bufferDescriptorInfos[FFX_MAX_RESOURCE_COUNT];
@@ -3743,8 +5336,6 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.uavTextures[currentPipelineUavIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &textureUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
-
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.uavTextureBindings[currentPipelineUavIndex];
 
         // where to bind it
@@ -3757,9 +5348,12 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
             mipOffset = backendContext->pResources[resourceIndex].resourceDescription.mipCount - 1;
         const uint32_t uavViewIndex  = backendContext->pResources[resourceIndex].uavViewIndex + mipOffset;
 
+        // only the bound mip is written
+        addBarrier(backendContext, recorder, &textureUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS, int32_t(mipOffset));
+
         writeDescriptorSets[descriptorWriteIndex]                 = {};
         writeDescriptorSets[descriptorWriteIndex].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeDescriptorSets[descriptorWriteIndex].dstSet          = pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex];
+        writeDescriptorSets[descriptorWriteIndex].dstSet          = VK_NULL_HANDLE;
         writeDescriptorSets[descriptorWriteIndex].descriptorCount = 1;
         writeDescriptorSets[descriptorWriteIndex].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
         writeDescriptorSets[descriptorWriteIndex].pImageInfo      = &imageDescriptorInfos[imageDescriptorIndex];
@@ -3769,6 +5363,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         imageDescriptorInfos[imageDescriptorIndex]             = {};
         imageDescriptorInfos[imageDescriptorIndex].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
         imageDescriptorInfos[imageDescriptorIndex].imageView   = backendContext->pResourceViews[uavViewIndex].imageView;
+        usesFrameViews |= isFrameImageView(backendContext, effectContextId, uavViewIndex);
 
         imageDescriptorIndex++;
         descriptorWriteIndex++;
@@ -3783,7 +5378,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.uavBuffers[currentPipelineUavIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &bufferUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        addBarrier(backendContext, recorder, &bufferUAV.resource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.uavBufferBindings[currentPipelineUavIndex];
 
@@ -3795,7 +5390,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
 
         writeDescriptorSets[descriptorWriteIndex] = {};
         writeDescriptorSets[descriptorWriteIndex].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeDescriptorSets[descriptorWriteIndex].dstSet = pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex];
+        writeDescriptorSets[descriptorWriteIndex].dstSet = VK_NULL_HANDLE;
         writeDescriptorSets[descriptorWriteIndex].descriptorCount = 1;
         writeDescriptorSets[descriptorWriteIndex].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         writeDescriptorSets[descriptorWriteIndex].pBufferInfo = &bufferDescriptorInfos[bufferDescriptorIndex];
@@ -3820,7 +5415,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.srvTextures[currentPipelineSrvIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &textureSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
+        addBarrier(backendContext, recorder, &textureSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.srvTextureBindings[currentPipelineSrvIndex];
 
@@ -3829,7 +5424,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
 
         writeDescriptorSets[descriptorWriteIndex]                 = {};
         writeDescriptorSets[descriptorWriteIndex].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeDescriptorSets[descriptorWriteIndex].dstSet          = pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex];
+        writeDescriptorSets[descriptorWriteIndex].dstSet          = VK_NULL_HANDLE;
         writeDescriptorSets[descriptorWriteIndex].descriptorCount = 1;
         writeDescriptorSets[descriptorWriteIndex].descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
         writeDescriptorSets[descriptorWriteIndex].pImageInfo      = &imageDescriptorInfos[imageDescriptorIndex];
@@ -3842,6 +5437,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         imageDescriptorInfos[imageDescriptorIndex]             = {};
         imageDescriptorInfos[imageDescriptorIndex].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
         imageDescriptorInfos[imageDescriptorIndex].imageView   = backendContext->pResourceViews[srvViewIndex].imageView;
+        usesFrameViews |= isFrameImageView(backendContext, effectContextId, srvViewIndex);
 
         imageDescriptorIndex++;
         descriptorWriteIndex++;
@@ -3856,7 +5452,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (job->computeJobDescriptor.srvBuffers[currentPipelineSrvIndex].resource.internalIndex == 0)
             continue;
 
-        addBarrier(backendContext, &bufferSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
+        addBarrier(backendContext, recorder, &bufferSRV.resource, FFX_RESOURCE_STATE_COMPUTE_READ);
 
         const FfxResourceBinding binding = job->computeJobDescriptor.pipeline.srvBufferBindings[currentPipelineSrvIndex];
 
@@ -3868,7 +5464,7 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
 
         writeDescriptorSets[descriptorWriteIndex]                 = {};
         writeDescriptorSets[descriptorWriteIndex].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeDescriptorSets[descriptorWriteIndex].dstSet          = pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex];
+        writeDescriptorSets[descriptorWriteIndex].dstSet          = VK_NULL_HANDLE;
         writeDescriptorSets[descriptorWriteIndex].descriptorCount = 1;
         writeDescriptorSets[descriptorWriteIndex].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         writeDescriptorSets[descriptorWriteIndex].pBufferInfo     = &bufferDescriptorInfos[bufferDescriptorIndex];
@@ -3894,22 +5490,36 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         if (s_fpConstantAllocator)
             allocation = s_fpConstantAllocator(job->computeJobDescriptor.cbs[currentRootConstantIndex].data, dataSize);
         else
-            allocation = backendContext->FallbackConstantAllocator(job->computeJobDescriptor.cbs[currentRootConstantIndex].data, dataSize);
-            
+            allocation = backendContext->FallbackConstantAllocator(job->computeJobDescriptor.cbs[currentRootConstantIndex].data, dataSize, effectContextId);
+        FFX_RETURN_ON_ERROR(allocation.resource.resource, FFX_ERROR_OUT_OF_MEMORY);
+
         writeDescriptorSets[descriptorWriteIndex]                 = {};
         writeDescriptorSets[descriptorWriteIndex].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeDescriptorSets[descriptorWriteIndex].dstSet          = pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex];
+        writeDescriptorSets[descriptorWriteIndex].dstSet          = VK_NULL_HANDLE;
         writeDescriptorSets[descriptorWriteIndex].descriptorCount = 1;
-        writeDescriptorSets[descriptorWriteIndex].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        writeDescriptorSets[descriptorWriteIndex].descriptorType  = pipelineLayout->pushDescriptors ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         writeDescriptorSets[descriptorWriteIndex].pBufferInfo     = &bufferDescriptorInfos[bufferDescriptorIndex];
         writeDescriptorSets[descriptorWriteIndex].dstBinding =
             job->computeJobDescriptor.pipeline.constantBufferBindings[currentRootConstantIndex].slotIndex;
         writeDescriptorSets[descriptorWriteIndex].dstArrayElement = 0;
 
         bufferDescriptorInfos[bufferDescriptorIndex].buffer = static_cast<VkBuffer>(allocation.resource.resource);
-        bufferDescriptorInfos[bufferDescriptorIndex].offset = static_cast<VkDeviceSize>(allocation.handle);
+        bufferDescriptorInfos[bufferDescriptorIndex].offset = pipelineLayout->pushDescriptors ? static_cast<VkDeviceSize>(allocation.handle) : 0;
         bufferDescriptorInfos[bufferDescriptorIndex].range  = dataSize;
 
+        // dynamic offsets are consumed in binding order
+        if (!pipelineLayout->pushDescriptors)
+        {
+            uint32_t offsetIndex = dynamicOffsetCount++;
+            for (; offsetIndex > 0 && dynamicOffsetBindings[offsetIndex - 1] > writeDescriptorSets[descriptorWriteIndex].dstBinding; --offsetIndex)
+            {
+                dynamicOffsetBindings[offsetIndex] = dynamicOffsetBindings[offsetIndex - 1];
+                dynamicOffsets[offsetIndex]        = dynamicOffsets[offsetIndex - 1];
+            }
+            dynamicOffsetBindings[offsetIndex] = writeDescriptorSets[descriptorWriteIndex].dstBinding;
+            dynamicOffsets[offsetIndex]        = static_cast<uint32_t>(allocation.handle);
+        }
+
         bufferDescriptorIndex++;
         descriptorWriteIndex++;
     }
@@ -3917,22 +5527,33 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
     // If we are dispatching indirectly, transition the argument resource to indirect argument
     if (job->computeJobDescriptor.pipeline.cmdSignature)
     {
-        addBarrier(backendContext, &job->computeJobDescriptor.cmdArgument, FFX_RESOURCE_STATE_INDIRECT_ARGUMENT);
+        addBarrier(backendContext, recorder, &job->computeJobDescriptor.cmdArgument, FFX_RESOURCE_STATE_INDIRECT_ARGUMENT);
     }
 
     // insert all the barriers
-    flushBarriers(backendContext, vkCommandBuffer);
-
-    // update all uavs and srvs
-    backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, descriptorWriteIndex, writeDescriptorSets, 0, nullptr);
+    flushBarriers(backendContext, recorder, vkCommandBuffer);
 
     // bind pipeline
     backendContext->vkFunctionTable.vkCmdBindPipeline(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reinterpret_cast<VkPipeline>(job->computeJobDescriptor.pipeline.pipeline));
 
-    // bind descriptor sets
+    // bind all uavs, srvs and constant buffers
+    if (pipelineLayout->pushDescriptors)
+    {
+        backendContext->vkFunctionTable.vkCmdPushDescriptorSetKHR(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout->pipelineLayout, 0, descriptorWriteIndex, writeDescriptorSets);
+        ++recorder->descriptorStatistics.pushCount;
+    }
+    else
     {
-        backendContext->vkFunctionTable.vkCmdBindDescriptorSets(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout->pipelineLayout, 0, 1, &pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex], 0, nullptr);
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        FfxErrorCode errorCode = acquireDescriptorSet(backendContext, recorder, pipelineLayout, effectContextId, writeDescriptorSets, descriptorWriteIndex, usesFrameViews, &descriptorSet);
+        if (errorCode != FFX_OK)
+            return errorCode;
+
+        backendContext->vkFunctionTable.vkCmdBindDescriptorSets(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout->pipelineLayout, 0, 1, &descriptorSet, dynamicOffsetCount, dynamicOffsets);
+    }
 
+    // bind static descriptor sets
+    {
         BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
 
         if (job->computeJobDescriptor.pipeline.staticTextureSrvCount > 0)
@@ -3960,22 +5581,17 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
         backendContext->vkFunctionTable.vkCmdDispatch(vkCommandBuffer, job->computeJobDescriptor.dimensions[0], job->computeJobDescriptor.dimensions[1], job->computeJobDescriptor.dimensions[2]);
     }
 
-    // move to another descriptor set for the next compute render job so that we don't overwrite descriptors in-use
-    ++pipelineLayout->descriptorSetIndex;
-    if (pipelineLayout->descriptorSetIndex >= (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME))
-        pipelineLayout->descriptorSetIndex = 0;
-
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobCopy(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobCopy(BackendContext_VK* backendContext, BackendContext_VK::Recorder* recorder, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
 {
     BackendContext_VK::Resource ffxResourceSrc = backendContext->pResources[job->copyJobDescriptor.src.internalIndex];
     BackendContext_VK::Resource ffxResourceDst = backendContext->pResources[job->copyJobDescriptor.dst.internalIndex];
 
-    addBarrier(backendContext, &job->copyJobDescriptor.src, FFX_RESOURCE_STATE_COPY_SRC);
-    addBarrier(backendContext, &job->copyJobDescriptor.dst, FFX_RESOURCE_STATE_COPY_DEST);
-    flushBarriers(backendContext, vkCommandBuffer);
+    addBarrier(backendContext, recorder, &job->copyJobDescriptor.src, FFX_RESOURCE_STATE_COPY_SRC);
+    addBarrier(backendContext, recorder, &job->copyJobDescriptor.dst, FFX_RESOURCE_STATE_COPY_DEST);
+    flushBarriers(backendContext, recorder, vkCommandBuffer);
 
     if (ffxResourceSrc.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER && ffxResourceDst.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
     {
@@ -4082,28 +5698,28 @@ static FfxErrorCode executeGpuJobCopy(BackendContext_VK* backendContext, FfxGpuJ
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobBarrier(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobBarrier(BackendContext_VK* backendContext, BackendContext_VK::Recorder* recorder, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
 {
-    addBarrier(backendContext, &job->barrierDescriptor.resource, job->barrierDescriptor.newState);
-    flushBarriers(backendContext, vkCommandBuffer);
+    addBarrier(backendContext, recorder, &job->barrierDescriptor.resource, job->barrierDescriptor.newState);
+    flushBarriers(backendContext, recorder, vkCommandBuffer);
 
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobTimestamp(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobTimestamp(BackendContext_VK* backendContext, BackendContext_VK::Recorder* recorder, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
 {
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobClearFloat(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+static FfxErrorCode executeGpuJobClearFloat(BackendContext_VK* backendContext, BackendContext_VK::Recorder* recorder, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
 {
     uint32_t idx = job->clearJobDescriptor.target.internalIndex;
     BackendContext_VK::Resource ffxResource = backendContext->pResources[idx];
 
     if (ffxResource.resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
     {
-        addBarrier(backendContext, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
-        flushBarriers(backendContext, vkCommandBuffer);
+        addBarrier(backendContext, recorder, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
+        flushBarriers(backendContext, recorder, vkCommandBuffer);
 
         VkBuffer vkResource = ffxResource.bufferResource;
 
@@ -4111,8 +5727,8 @@ static FfxErrorCode executeGpuJobClearFloat(BackendContext_VK* backendContext, F
     }
     else
     {
-        addBarrier(backendContext, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
-        flushBarriers(backendContext, vkCommandBuffer);
+        addBarrier(backendContext, recorder, &job->clearJobDescriptor.target, FFX_RESOURCE_STATE_COPY_DEST);
+        flushBarriers(backendContext, recorder, vkCommandBuffer);
 
         VkImage vkResource = ffxResource.imageResource;
 
@@ -4147,12 +5763,16 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
     FFX_ASSERT(nullptr != commandList);
     VkCommandBuffer vkCommandBuffer = reinterpret_cast<VkCommandBuffer>(commandList);
 
+    // record the jobs this thread scheduled, other threads may be recording other effect contexts meanwhile
+    BackendContext_VK::Recorder* recorder = acquireRecorder(backendContext);
+    FFX_RETURN_ON_ERROR(recorder, FFX_ERROR_OUT_OF_MEMORY);
+
     FfxErrorCode errorCode = FFX_OK;
 
     // execute all renderjobs
-    for (uint32_t i = 0; i < backendContext->gpuJobCount; ++i)
+    for (uint32_t i = 0; i < recorder->gpuJobCount; ++i)
     {
-        FfxGpuJobDescription* gpuJob = &backendContext->pGpuJobs[i];
+        FfxGpuJobDescription* gpuJob = getGpuJob(recorder, i);
 
         // If we have a label for the job, drop a marker for it
         if (gpuJob->jobLabel[0]) {
@@ -4164,22 +5784,22 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
         {
         case FFX_GPU_JOB_CLEAR_FLOAT:
         {
-            errorCode = executeGpuJobClearFloat(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobClearFloat(backendContext, recorder, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_COPY:
         {
-            errorCode = executeGpuJobCopy(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobCopy(backendContext, recorder, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_COMPUTE:
         {
-            errorCode = executeGpuJobCompute(backendContext, gpuJob, vkCommandBuffer, effectContextId);
+            errorCode = executeGpuJobCompute(backendContext, recorder, gpuJob, vkCommandBuffer, effectContextId);
             break;
         }
         case FFX_GPU_JOB_BARRIER:
         {
-            errorCode = executeGpuJobBarrier(backendContext, gpuJob, vkCommandBuffer);
+            errorCode = executeGpuJobBarrier(backendContext, recorder, gpuJob, vkCommandBuffer);
             break;
         }
         default:;
@@ -4195,7 +5815,11 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
         errorCode == FFX_OK,
         FFX_ERROR_BACKEND_API_ERROR);
 
-    backendContext->gpuJobCount = 0;
+    recorder->gpuJobCount = 0;
+
+    // the staged constants have all been copied to the uniform buffer
+    releaseStagedConstants(recorder);
+    releaseRecorder(backendContext, recorder);
 
     return FFX_OK;
 }
@@ -24,6 +24,7 @@
 #include <string.h>     // for memset
 #include <stdlib.h>     // for _countof
 #include <cmath>        // for fabs, abs, sinf, sqrt, etc.
+#include <chrono>       // for steady_clock
 
 #include <FidelityFX/host/ffx_blur.h>
 #include <FidelityFX/gpu/ffx_core.h>
@@ -229,6 +230,18 @@ static uint32_t countNumberOfSetBits(uint32_t bits)
     return count;
 }
 
+static uint32_t getSingleBitIndex(uint32_t bit)
+{
+    uint32_t index = 0;
+    while (bit > 1)
+    {
+        bit >>= 1;
+        ++index;
+    }
+
+    return index;
+}
+
 #ifdef _DEBUG
 
 #define FFX_ASSERT_OR_RETURN(condition, falseValue) FFX_ASSERT(condition)
@@ -240,10 +253,13 @@ static uint32_t countNumberOfSetBits(uint32_t bits)
 #endif
 
 
-static FfxErrorCode createPipelineStateObjects(FfxBlurContext_Private* context)
+static uint64_t getTimeMicroseconds()
 {
-    FFX_ASSERT(context);
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
+static FfxErrorCode createPipeline(FfxBlurContext_Private* context, uint32_t kernPermIndex, uint32_t kernelSizeIndex, FfxPipelineState* pBlurPipeline)
+{
     FfxPipelineDescription pipelineDescription  = {};
     pipelineDescription.contextFlags = 0;
 
@@ -256,10 +272,137 @@ static FfxErrorCode createPipelineStateObjects(FfxBlurContext_Private* context)
     FfxRootConstantDescription rootConstantDesc = { sizeof(BlurConstants) / sizeof(uint32_t), FFX_BIND_COMPUTE_SHADER_STAGE };
     pipelineDescription.rootConstants = &rootConstantDesc;
 
+    const FfxBlurKernelPermutation kernelPermutation = (FfxBlurKernelPermutation)(FFX_BLUR_KERNEL_PERMUTATION_0 << kernPermIndex);
+    const FfxBlurKernelSize        kernelSize        = (FfxBlurKernelSize)(FFX_BLUR_KERNEL_SIZE_3x3 << kernelSizeIndex);
+
+    wcscpy_s(pipelineDescription.name, L"BLUR-BLUR_");
+
+    wchar_t kernelPermStr[32];
+    swprintf_s(kernelPermStr, L"PERM%d_", kernPermIndex);
+
+    wcscat_s(pipelineDescription.name, kernelPermStr);
+
+    wchar_t kernel[10] = {}; // 3x3 through 21x21, getKernelSizeString does not terminate it
+    getKernelSizeString(kernel, kernelSize);
+
+    wcscat_s(pipelineDescription.name, kernel);
+
+    const uint64_t compileStart = getTimeMicroseconds();
+
+    // Set up pipeline descriptors (basically RootSignature and binding)
+    FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(
+        &context->contextDescription.backendInterface,
+        FFX_EFFECT_BLUR,
+        FFX_BLUR_PASS_BLUR,
+        getPipelinePermutationFlags(
+            kernelPermutation,
+            kernelSize,
+            context->contextDescription.floatPrecision,
+            context->deviceCapabilities.fp16Supported,
+            context->canForceWave64),
+        &pipelineDescription,
+        context->effectContextId,
+        pBlurPipeline));
+
+    context->pipelineStatistics.pipelineCompileTimeUs += getTimeMicroseconds() - compileStart;
+    ++context->pipelineStatistics.compiledPipelineCount;
+
+    // For each pipeline: re-route/fix-up IDs based on names
+    auto patchStatus = patchResourceBindings(pBlurPipeline);
+    if (patchStatus != FFX_OK)
+    {
+        ffxSafeReleasePipeline(&context->contextDescription.backendInterface, pBlurPipeline, context->effectContextId);
+        return patchStatus;
+    }
+
+    return FFX_OK;
+}
+
+// Destroys the evicted pipelines that frames still in flight can no longer reference, or all of them when the GPU is idle.
+static void releaseRetiredPipelines(FfxBlurContext_Private* context, bool gpuIdle)
+{
+    for (uint32_t slotIndex = 0; slotIndex < context->numPipelines; ++slotIndex)
+    {
+        BlurRetiredPipeline& retired = context->retiredPipelines[slotIndex];
+        if (retired.pPipeline != nullptr && (gpuIdle || context->frameIndex >= retired.retiredFrame + FFX_MAX_QUEUED_FRAMES))
+        {
+            ffxSafeReleasePipeline(&context->contextDescription.backendInterface, retired.pPipeline, context->effectContextId);
+            free(retired.pPipeline);
+            retired.pPipeline = nullptr;
+            --context->pipelineStatistics.retiredPipelineCount;
+        }
+    }
+}
+
+// Compiles the pipeline of a slot, releasing the least recently used one first if the context is at its limit.
+static FfxErrorCode makePipelineResident(FfxBlurContext_Private* context, uint32_t pipelineIndex, uint32_t kernPermIndex, uint32_t kernelSizeIndex)
+{
+    BlurPipelineSlot& slot = context->pipelineSlots[pipelineIndex];
+    if (slot.pPipeline != nullptr)
+        return FFX_OK;
+
+    // Evicted pipelines stay in their slot's retire entry until released, which also bounds them to one per slot.
+    BlurRetiredPipeline& retired = context->retiredPipelines[pipelineIndex];
+
+    const uint32_t maxResidentPipelines = context->contextDescription.maxResidentPipelines;
+    if (maxResidentPipelines != 0 && context->pipelineStatistics.residentPipelineCount >= maxResidentPipelines)
+    {
+        BlurPipelineSlot* pVictim = nullptr;
+        for (uint32_t slotIndex = 0; slotIndex < context->numPipelines; ++slotIndex)
+        {
+            BlurPipelineSlot& candidate = context->pipelineSlots[slotIndex];
+            if (candidate.pPipeline != nullptr && (pVictim == nullptr || candidate.lastUsedDispatch < pVictim->lastUsedDispatch))
+                pVictim = &candidate;
+        }
+        FFX_ASSERT(pVictim);
+
+        BlurRetiredPipeline& victimRetired = context->retiredPipelines[pVictim - context->pipelineSlots];
+        FFX_ASSERT(victimRetired.pPipeline == nullptr);
+        victimRetired.pPipeline    = pVictim->pPipeline;
+        victimRetired.retiredFrame = context->frameIndex;
+        pVictim->pPipeline = nullptr;
+        --context->pipelineStatistics.residentPipelineCount;
+        ++context->pipelineStatistics.evictedPipelineCount;
+        ++context->pipelineStatistics.retiredPipelineCount;
+    }
+
+    // A pipeline used again before it was released is taken back rather than compiled again.
+    FfxPipelineState* pPipeline = retired.pPipeline;
+    retired.pPipeline = nullptr;
+    if (pPipeline != nullptr)
+    {
+        --context->pipelineStatistics.retiredPipelineCount;
+    }
+    else
+    {
+        pPipeline = (FfxPipelineState*)calloc(1u, sizeof(FfxPipelineState));
+        FFX_RETURN_ON_ERROR(pPipeline, FFX_ERROR_OUT_OF_MEMORY);
+
+        const FfxErrorCode errorCode = createPipeline(context, kernPermIndex, kernelSizeIndex, pPipeline);
+        if (errorCode != FFX_OK)
+        {
+            free(pPipeline);
+            return errorCode;
+        }
+    }
+
+    slot.pPipeline        = pPipeline;
+    slot.lastUsedDispatch = context->dispatchIndex;
+
+    FfxBlurPipelineStatistics& statistics = context->pipelineStatistics;
+    ++statistics.residentPipelineCount;
+    statistics.peakResidentPipelineCount = FFX_MAXIMUM(statistics.peakResidentPipelineCount, statistics.residentPipelineCount);
+
+    return FFX_OK;
+}
+
+static FfxErrorCode createPipelineStateObjects(FfxBlurContext_Private* context)
+{
+    FFX_ASSERT(context);
+
     FfxDeviceCapabilities& capabilities = context->deviceCapabilities;
     // Setup a few options used to determine permutation flags
     bool haveShaderModel66 = capabilities.maximumSupportedShaderModel >= FFX_SHADER_MODEL_6_6;
-    bool fp16Supported     = capabilities.fp16Supported;
     bool canForceWave64    = false;
 
     const uint32_t waveLaneCountMin = capabilities.waveLaneCountMin;
@@ -269,6 +412,8 @@ static FfxErrorCode createPipelineStateObjects(FfxBlurContext_Private* context)
     else
         canForceWave64 = false;
 
+    context->canForceWave64 = canForceWave64;
+
     uint32_t numberOfKernelPermutations = countNumberOfSetBits(context->contextDescription.kernelPermutations);
 
     FFX_ASSERT_OR_RETURN(numberOfKernelPermutations <= FFX_BLUR_KERNEL_PERMUTATION_COUNT && numberOfKernelPermutations != 0, FFX_ERROR_INVALID_ARGUMENT);
@@ -277,12 +422,16 @@ static FfxErrorCode createPipelineStateObjects(FfxBlurContext_Private* context)
 
     FFX_ASSERT_OR_RETURN(numberOfKernelSizes <= FFX_BLUR_KERNEL_SIZE_COUNT && numberOfKernelSizes != 0, FFX_ERROR_INVALID_ARGUMENT);
 
-    context->pBlurPipelines =
-        (FfxPipelineState*)calloc(1u, numberOfKernelSizes * numberOfKernelPermutations * sizeof(FfxPipelineState));
+    context->numKernelSizes = numberOfKernelSizes;
+    context->numPipelines   = numberOfKernelSizes * numberOfKernelPermutations;
 
-    FFX_RETURN_ON_ERROR(context->pBlurPipelines, FFX_ERROR_OUT_OF_MEMORY);
+    // Pipelines are compiled on first use, only the ones in the prewarm profile are compiled now.
+    const FfxBlurPipelineUsageProfile* pPrewarmProfile = context->contextDescription.pPrewarmProfile;
+    context->contextDescription.pPrewarmProfile = nullptr;
+    if (pPrewarmProfile == nullptr)
+        return FFX_OK;
 
-    context->numKernelSizes = numberOfKernelSizes;
+    const uint32_t maxResidentPipelines = context->contextDescription.maxResidentPipelines;
 
     uint32_t curPipelineIndex = 0;
     uint32_t curKernelPermutation = FFX_BLUR_KERNEL_PERMUTATION_0;
@@ -295,41 +444,10 @@ static FfxErrorCode createPipelineStateObjects(FfxBlurContext_Private* context)
             {
                 if (curKernelSize & context->contextDescription.kernelSizes)
                 {
-                    wcscpy_s(pipelineDescription.name, L"BLUR-BLUR_");
-
-                    wchar_t kernelPermStr[32];
-                    swprintf_s(kernelPermStr, L"PERM%d_", kernPermIndex);
-
-                    wcscat_s(pipelineDescription.name, kernelPermStr);
-
-                    wchar_t kernel[10]; // 3x3 through 21x21
-                    getKernelSizeString(kernel, (FfxBlurKernelSize)curKernelSize);
-
-                    wcscat_s(pipelineDescription.name, kernel);
-
-                    FfxPipelineState* pBlurPipeline = &context->pBlurPipelines[curPipelineIndex];
-                    // Set up pipeline descriptors (basically RootSignature and binding)
-                    FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(
-                        &context->contextDescription.backendInterface,
-                        FFX_EFFECT_BLUR,
-                        FFX_BLUR_PASS_BLUR,
-                        getPipelinePermutationFlags(
-                            (FfxBlurKernelPermutation)curKernelPermutation,
-                            (FfxBlurKernelSize)curKernelSize,
-                            context->contextDescription.floatPrecision,
-                            fp16Supported,
-                            canForceWave64),
-                        &pipelineDescription,
-                        context->effectContextId,
-                        pBlurPipeline));
-
-                    // For each pipeline: re-route/fix-up IDs based on names
-                    auto patchStatus = patchResourceBindings(pBlurPipeline);
-                    if (patchStatus != FFX_OK)
+                    if ((curKernelSize & pPrewarmProfile->kernelSizes[kernPermIndex])
+                        && (maxResidentPipelines == 0 || context->pipelineStatistics.residentPipelineCount < maxResidentPipelines))
                     {
-                        free(context->pBlurPipelines);
-                        context->pBlurPipelines = nullptr;
-                        return patchStatus;
+                        FFX_VALIDATE(makePipelineResident(context, curPipelineIndex, kernPermIndex, psoIndex));
                     }
 
                     ++curPipelineIndex;
@@ -346,6 +464,8 @@ static FfxErrorCode blurCreate(FfxBlurContext_Private* context, const FfxBlurCon
     FFX_ASSERT(context);
     FFX_ASSERT(contextDescription);
 
+    const uint64_t createStart = getTimeMicroseconds();
+
     // Setup the data for implementation.
     memset(context, 0, sizeof(FfxBlurContext_Private));
     context->device = contextDescription->backendInterface.device;
@@ -383,6 +503,8 @@ static FfxErrorCode blurCreate(FfxBlurContext_Private* context, const FfxBlurCon
     errorCode = createPipelineStateObjects(context);
     FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
 
+    context->pipelineStatistics.contextCreateTimeUs = getTimeMicroseconds() - createStart;
+
     return FFX_OK;
 }
 
@@ -425,23 +547,21 @@ static FfxErrorCode blurRelease(FfxBlurContext_Private* context)
 {
     FFX_ASSERT(context);
 
-    if (context->pBlurPipelines != nullptr)
+    // Release all pipelines, including the ones waiting to be retired
+    releaseRetiredPipelines(context, true);
+    for (uint32_t curPipelineIndex = 0; curPipelineIndex < context->numPipelines; ++curPipelineIndex)
     {
-        // Release all pipelines
-        uint32_t kernPermCount = countNumberOfSetBits(context->contextDescription.kernelPermutations);
-        for (uint32_t curKernPermIndex = 0; curKernPermIndex < kernPermCount; ++curKernPermIndex)
+        BlurPipelineSlot& slot = context->pipelineSlots[curPipelineIndex];
+        if (slot.pPipeline != nullptr)
         {
-            for (uint32_t curPipelineIndex = 0; curPipelineIndex < context->numKernelSizes; ++curPipelineIndex)
-            {
-                FfxPipelineState* pBlurPipeline = &context->pBlurPipelines[(curKernPermIndex * context->numKernelSizes) + curPipelineIndex];
-                ffxSafeReleasePipeline(&context->contextDescription.backendInterface, pBlurPipeline, context->effectContextId);
-            }
+            ffxSafeReleasePipeline(&context->contextDescription.backendInterface, slot.pPipeline, context->effectContextId);
+            free(slot.pPipeline);
+            slot.pPipeline = nullptr;
         }
-
-        free(context->pBlurPipelines);
-        context->pBlurPipelines = nullptr;
     }
 
+    context->pipelineStatistics.residentPipelineCount = 0;
+
     // Unregister resources not created internally
     context->srvResources[FFX_BLUR_RESOURCE_IDENTIFIER_INPUT_SRC] = {FFX_BLUR_RESOURCE_IDENTIFIER_NULL};
     context->srvResources[FFX_BLUR_RESOURCE_IDENTIFIER_OUTPUT] = {FFX_BLUR_RESOURCE_IDENTIFIER_NULL};
@@ -568,6 +688,31 @@ static FfxErrorCode blurDispatch(FfxBlurContext_Private* context, const FfxBlurD
     // take a short cut to the command list
     FfxCommandList commandList = params->commandList;
 
+    // Validate that specified kernel permutation and size were used during FFX Blur Context creation.
+    FFX_ASSERT_OR_RETURN(context->contextDescription.kernelPermutations & params->kernelPermutation, FFX_ERROR_INVALID_ENUM);
+    FFX_ASSERT_OR_RETURN(context->contextDescription.kernelSizes & params->kernelSize, FFX_ERROR_INVALID_ENUM);
+
+    uint32_t pipelineIndex =
+        getPipelineIndex(
+            context->contextDescription.kernelPermutations, params->kernelPermutation,
+            context->numKernelSizes,
+            context->contextDescription.kernelSizes, params->kernelSize);
+
+    // Dispatch order picks the least recently used pipeline, the frame index decides when an evicted one can be destroyed.
+    ++context->dispatchIndex;
+    context->frameIndex = params->frameIndex;
+    releaseRetiredPipelines(context, false);
+
+    // Compile the pipeline if this is its first use, or its first use since it was evicted.
+    const uint32_t kernPermIndex   = getSingleBitIndex((uint32_t)params->kernelPermutation);
+    const uint32_t kernelSizeIndex = getSingleBitIndex((uint32_t)params->kernelSize);
+    FfxErrorCode errorCode = makePipelineResident(context, pipelineIndex, kernPermIndex, kernelSizeIndex);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    BlurPipelineSlot& pipelineSlot = context->pipelineSlots[pipelineIndex];
+    pipelineSlot.lastUsedDispatch = context->dispatchIndex;
+    context->pipelineUsage.kernelSizes[kernPermIndex] |= params->kernelSize;
+
     // Register resources for frame
     context->contextDescription.backendInterface.fpRegisterResource(
         &context->contextDescription.backendInterface, &params->input, context->effectContextId,
@@ -587,18 +732,8 @@ static FfxErrorCode blurDispatch(FfxBlurContext_Private* context, const FfxBlurD
 
     context->contextDescription.backendInterface.fpStageConstantBufferDataFunc(
         &context->contextDescription.backendInterface, &constants, sizeof(BlurConstants), &context->blurConstants);
-    
-    // Validate that specified kernel permutation and size were used during FFX Blur Context creation.
-    FFX_ASSERT_OR_RETURN(context->contextDescription.kernelPermutations & params->kernelPermutation, FFX_ERROR_INVALID_ENUM);
-    FFX_ASSERT_OR_RETURN(context->contextDescription.kernelSizes & params->kernelSize, FFX_ERROR_INVALID_ENUM);
-
-    uint32_t pipelineIndex =
-        getPipelineIndex(
-            context->contextDescription.kernelPermutations, params->kernelPermutation,
-            context->numKernelSizes,
-            context->contextDescription.kernelSizes, params->kernelSize);
 
-    scheduleDispatch(context, &context->pBlurPipelines[pipelineIndex], dispatchX, dispatchY, dispatchZ);
+    scheduleDispatch(context, pipelineSlot.pPipeline, dispatchX, dispatchY, dispatchZ);
 
     // Execute all the work for the frame
     context->contextDescription.backendInterface.fpExecuteGpuJobs(&context->contextDescription.backendInterface, commandList, context->effectContextId);
@@ -626,6 +761,35 @@ FfxErrorCode ffxBlurContextDispatch(FfxBlurContext* context, const FfxBlurDispat
     return errorCode;
 }
 
+FfxErrorCode ffxBlurContextReleaseEvictedPipelines(FfxBlurContext* context)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+
+    FfxBlurContext_Private* contextPrivate = (FfxBlurContext_Private*)(context);
+    releaseRetiredPipelines(contextPrivate, true);
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBlurContextGetPipelineUsage(FfxBlurContext* context, FfxBlurPipelineUsageProfile* profile)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(profile, FFX_ERROR_INVALID_POINTER);
+
+    const FfxBlurContext_Private* contextPrivate = (FfxBlurContext_Private*)(context);
+    *profile = contextPrivate->pipelineUsage;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBlurContextGetPipelineStatistics(FfxBlurContext* context, FfxBlurPipelineStatistics* statistics)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(statistics, FFX_ERROR_INVALID_POINTER);
+
+    const FfxBlurContext_Private* contextPrivate = (FfxBlurContext_Private*)(context);
+    *statistics = contextPrivate->pipelineStatistics;
+    return FFX_OK;
+}
+
 FFX_API FfxVersionNumber ffxBlurGetEffectVersion()
 {
     return FFX_SDK_MAKE_VERSION(FFX_BLUR_VERSION_MAJOR, FFX_BLUR_VERSION_MINOR, FFX_BLUR_VERSION_PATCH);
@@ -49,6 +49,22 @@ typedef struct BlurConstants
     uint32_t height; ///< Height in pixels of input image.
 } BlurConstants;
 
+// A pipeline variant, compiled on its first use.
+typedef struct BlurPipelineSlot
+{
+    FfxPipelineState* pPipeline;
+    uint64_t          lastUsedDispatch;
+} BlurPipelineSlot;
+
+// A pipeline evicted from its slot, destroyed once FFX_MAX_QUEUED_FRAMES frames have passed.
+typedef struct BlurRetiredPipeline
+{
+    FfxPipelineState* pPipeline;
+    uint64_t          retiredFrame;
+} BlurRetiredPipeline;
+
+#define BLUR_PIPELINE_SLOT_COUNT (FFX_BLUR_KERNEL_PERMUTATION_COUNT * FFX_BLUR_KERNEL_SIZE_COUNT)
+
 struct FfxBlurContextDescription;
 struct FfxDeviceCapabilities;
 struct FfxPipelineState;
@@ -64,7 +80,14 @@ typedef struct FfxBlurContext_Private
     FfxDevice                 device;
     FfxDeviceCapabilities     deviceCapabilities;
     FfxUInt32                 numKernelSizes;
-    FfxPipelineState*         pBlurPipelines;
+    FfxUInt32                 numPipelines;
+    bool                      canForceWave64;
+    BlurPipelineSlot          pipelineSlots[BLUR_PIPELINE_SLOT_COUNT];
+    BlurRetiredPipeline       retiredPipelines[BLUR_PIPELINE_SLOT_COUNT];
+    uint64_t                  dispatchIndex;
+    uint64_t                  frameIndex;
+    FfxBlurPipelineUsageProfile pipelineUsage;
+    FfxBlurPipelineStatistics pipelineStatistics;
     FfxResourceInternal       srvResources[FFX_BLUR_RESOURCE_IDENTIFIER_COUNT];
     FfxResourceInternal       uavResources[FFX_BLUR_RESOURCE_IDENTIFIER_COUNT];
 } FfxBlurContext_Private;
@@ -59,8 +59,13 @@ static void breadcrumbsSetName(FfxAllocationCallbacks* allocs, BreadcrumbsCustom
         nameBuffer->currentNamesOffset += length;
         if (nameBuffer->bufferSize < nameBuffer->currentNamesOffset)
         {
+            // Grow geometrically so appending names stays amortized O(1).
+            size_t newSize = nameBuffer->bufferSize * 2;
+            if (newSize < nameBuffer->currentNamesOffset)
+                newSize = nameBuffer->currentNamesOffset;
             nameBuffer->pBuffer = (char*)ffxBreadcrumbsAppendList(nameBuffer->pBuffer,
-                nameBuffer->bufferSize, 1, nameBuffer->currentNamesOffset - nameBuffer->bufferSize, allocs);
+                nameBuffer->bufferSize, 1, newSize - nameBuffer->bufferSize, allocs);
+            nameBuffer->bufferSize = newSize;
         }
         memcpy(nameBuffer->pBuffer + nameOffset, tag->pName, length);
 
@@ -91,17 +96,168 @@ static char* breadcrumbsGetName(BreadcrumbsCustomNameBuffer* nameBuffer, const B
     return name->pName;
 }
 
+static uint32_t breadcrumbsHashKey(const void* key, uint32_t capacity)
+{
+    // Fibonacci hashing, handles are aligned so the low bits carry little entropy.
+    const uint64_t hash = (uint64_t)(uintptr_t)key * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(hash >> 32) & (capacity - 1);
+}
+
+static uint32_t breadcrumbsMapFind(const BreadcrumbsHashMap* map, const void* key)
+{
+    // Lock placed externally
+    FFX_ASSERT(map);
+    if (map->count == 0)
+        return UINT32_MAX;
+
+    for (uint32_t i = breadcrumbsHashKey(key, map->capacity);; i = (i + 1) & (map->capacity - 1))
+    {
+        const BreadcrumbsHashEntry* entry = map->pEntries + i;
+        if (entry->generation != map->generation)
+            return UINT32_MAX;
+        if (entry->key == key)
+            return entry->index;
+    }
+}
+
+static void breadcrumbsMapInsert(FfxAllocationCallbacks* allocs, BreadcrumbsHashMap* map, const void* key, uint32_t index)
+{
+    // Lock placed externally
+    FFX_ASSERT(map);
+
+    // Keep load factor under 3/4 so probe sequences stay short and always terminate.
+    if ((map->count + 1) * 4 > map->capacity * 3)
+    {
+        const uint32_t             oldCapacity = map->capacity;
+        const uint32_t             oldGeneration = map->generation;
+        BreadcrumbsHashEntry*      oldEntries = map->pEntries;
+
+        map->capacity = oldCapacity ? oldCapacity * 2 : 64;
+        map->generation = 1;
+        map->count = 0;
+        map->pEntries = (BreadcrumbsHashEntry*)allocs->fpAlloc(sizeof(BreadcrumbsHashEntry) * map->capacity);
+        FFX_ASSERT(map->pEntries);
+        memset(map->pEntries, 0, sizeof(BreadcrumbsHashEntry) * map->capacity);
+
+        for (uint32_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldEntries[i].generation == oldGeneration)
+                breadcrumbsMapInsert(allocs, map, oldEntries[i].key, oldEntries[i].index);
+        }
+        FFX_SAFE_FREE(oldEntries, allocs->fpFree);
+    }
+
+    uint32_t i = breadcrumbsHashKey(key, map->capacity);
+    while (map->pEntries[i].generation == map->generation)
+        i = (i + 1) & (map->capacity - 1);
+    map->pEntries[i] = { key, index, map->generation };
+    ++map->count;
+}
+
+static void breadcrumbsMapClear(BreadcrumbsHashMap* map)
+{
+    // Lock placed externally
+    FFX_ASSERT(map);
+    map->count = 0;
+    if (++map->generation == 0)
+    {
+        // Generation wrapped around, stale entries could match again.
+        if (map->pEntries)
+            memset(map->pEntries, 0, sizeof(BreadcrumbsHashEntry) * map->capacity);
+        map->generation = 1;
+    }
+}
+
+static void* breadcrumbsArenaAlloc(FfxAllocationCallbacks* allocs, BreadcrumbsArena* arena, size_t size)
+{
+    // Lock placed externally
+    FFX_ASSERT(arena);
+    const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    size = (size + 7) & ~(size_t)7;
+
+    BreadcrumbsArenaChunk* chunk = arena->pCurrentChunk;
+    if (chunk == nullptr || arena->currentOffset + size > chunk->size)
+    {
+        // Reuse chunks left from previous frames first, allocate new one only when none is big enough.
+        BreadcrumbsArenaChunk* prev = chunk;
+        chunk = chunk ? chunk->pNext : arena->pFirstChunk;
+        while (chunk && chunk->size < size)
+        {
+            prev = chunk;
+            chunk = chunk->pNext;
+        }
+        if (chunk == nullptr)
+        {
+            const size_t chunkSize = size > DEFAULT_CHUNK_SIZE ? size : DEFAULT_CHUNK_SIZE;
+            chunk = (BreadcrumbsArenaChunk*)allocs->fpAlloc(sizeof(BreadcrumbsArenaChunk) + chunkSize);
+            FFX_ASSERT(chunk);
+            chunk->pNext = nullptr;
+            chunk->size = chunkSize;
+            if (prev)
+                prev->pNext = chunk;
+            else
+                arena->pFirstChunk = chunk;
+        }
+        arena->pCurrentChunk = chunk;
+        arena->currentOffset = 0;
+    }
+
+    void* memory = (uint8_t*)(chunk + 1) + arena->currentOffset;
+    arena->currentOffset += size;
+    return memory;
+}
+
+static void breadcrumbsArenaReset(BreadcrumbsArena* arena)
+{
+    // Lock placed externally
+    FFX_ASSERT(arena);
+    arena->pCurrentChunk = nullptr;
+    arena->currentOffset = 0;
+}
+
+static void breadcrumbsArenaRelease(FfxAllocationCallbacks* allocs, BreadcrumbsArena* arena)
+{
+    // Lock placed externally
+    FFX_ASSERT(arena);
+    while (arena->pFirstChunk)
+    {
+        BreadcrumbsArenaChunk* next = arena->pFirstChunk->pNext;
+        allocs->fpFree(arena->pFirstChunk);
+        arena->pFirstChunk = next;
+    }
+    breadcrumbsArenaReset(arena);
+}
+
+static void* breadcrumbsGrowArray(FfxAllocationCallbacks* allocs, BreadcrumbsFrameData* frame, bool lockEnable,
+    void* src, uint32_t count, uint32_t* capacity, size_t elementSize)
+{
+    // Old array stays in the arena until the frame is reused, doubling keeps the waste bounded.
+    FFX_ASSERT(count == *capacity);
+    const uint32_t newCapacity = *capacity ? *capacity * 2 : 16;
+
+    if (lockEnable)
+    {
+        FFX_MUTEX_LOCK(frame->arenaMutex);
+    }
+    void* dst = breadcrumbsArenaAlloc(allocs, &frame->markersArena, elementSize * newCapacity);
+    if (lockEnable)
+    {
+        FFX_MUTEX_UNLOCK(frame->arenaMutex);
+    }
+
+    if (count)
+        memcpy(dst, src, elementSize * count);
+    *capacity = newCapacity;
+    return dst;
+}
+
 static BreadcrumbsListData* breadcrumbsSearchList(BreadcrumbsFrameData* frame, FfxCommandList list)
 {
     // Lock placed externally
     FFX_ASSERT(frame);
     FFX_ASSERT(list);
-    for (size_t i = 0; i < frame->usedListsCount; ++i)
-    {
-        if (frame->pUsedLists[i].list == list)
-            return frame->pUsedLists + i;
-    }
-    return nullptr;
+    const uint32_t index = breadcrumbsMapFind(&frame->usedListsMap, list);
+    return index == UINT32_MAX ? nullptr : frame->pUsedLists + index;
 }
 
 static BreadcrumbsPipelineData* breadcrumbsSearchPipeline(FfxBreadcrumbsContext_Private* context, FfxPipeline pipeline)
@@ -109,12 +265,8 @@ static BreadcrumbsPipelineData* breadcrumbsSearchPipeline(FfxBreadcrumbsContext_
     // Lock placed externally
     FFX_ASSERT(context);
     FFX_ASSERT(pipeline);
-    for (size_t i = 0; i < context->registeredPipelinesCount; ++i)
-    {
-        if (context->pRegisteredPipelines[i].pipeline == pipeline)
-            return context->pRegisteredPipelines + i;
-    }
-    return nullptr;
+    const uint32_t index = breadcrumbsMapFind(&context->registeredPipelinesMap, pipeline);
+    return index == UINT32_MAX ? nullptr : context->pRegisteredPipelines + index;
 }
 
 static bool breadcrumbsIsCorrectPipeline(FfxBreadcrumbsContext_Private* context, FfxPipeline pipeline, bool newPipeline)
@@ -192,11 +344,9 @@ static FfxErrorCode breadcrumbsRelease(FfxBreadcrumbsContext_Private* context)
         for (uint32_t f = 0; f < context->contextDescription.frameHistoryLength; ++f)
         {
             BreadcrumbsFrameData* frame = context->pFrameData + f;
-            for (uint32_t list = 0; list < frame->usedListsCount; ++list)
-            {
-                FFX_SAFE_FREE(frame->pUsedLists->pMarkers, context->contextDescription.allocCallbacks.fpFree);
-            }
+            breadcrumbsArenaRelease(&context->contextDescription.allocCallbacks, &frame->markersArena);
             FFX_SAFE_FREE(frame->pUsedLists, context->contextDescription.allocCallbacks.fpFree);
+            FFX_SAFE_FREE(frame->usedListsMap.pEntries, context->contextDescription.allocCallbacks.fpFree);
 
             for (uint32_t queue = 0; queue < context->contextDescription.usedGpuQueuesCount; ++queue)
             {
@@ -223,6 +373,7 @@ static FfxErrorCode breadcrumbsRelease(FfxBreadcrumbsContext_Private* context)
         context->contextDescription.allocCallbacks.fpFree(context->pFrameData);
     }
     FFX_SAFE_FREE(context->pRegisteredPipelines, context->contextDescription.allocCallbacks.fpFree);
+    FFX_SAFE_FREE(context->registeredPipelinesMap.pEntries, context->contextDescription.allocCallbacks.fpFree);
     FFX_SAFE_FREE(context->pipelinesNamesBuffer.pBuffer, context->contextDescription.allocCallbacks.fpFree);
 
     // Destroy the context
@@ -356,12 +507,10 @@ FfxErrorCode ffxBreadcrumbsStartFrame(FfxBreadcrumbsContext* context)
     ++contextPrivate->frameIndex;
     BreadcrumbsFrameData* frame = breadcrumbsGetCurrentFrame(contextPrivate);
     frame->namesBuffer.currentNamesOffset = 0;
-    for (uint32_t list = 0; list < frame->usedListsCount; ++list)
-    {
-        FFX_SAFE_FREE(frame->pUsedLists->pMarkers, contextPrivate->contextDescription.allocCallbacks.fpFree);
-    }
-    FFX_SAFE_FREE(frame->pUsedLists, contextPrivate->contextDescription.allocCallbacks.fpFree);
+    // Lists, their markers and lookup entries are kept allocated and reused by the frame that takes this slot.
     frame->usedListsCount = 0;
+    breadcrumbsMapClear(&frame->usedListsMap);
+    breadcrumbsArenaReset(&frame->markersArena);
 
     for (uint32_t queue = 0; queue < contextPrivate->contextDescription.usedGpuQueuesCount; ++queue)
     {
@@ -400,7 +549,13 @@ FfxErrorCode ffxBreadcrumbsRegisterCommandList(FfxBreadcrumbsContext* context, c
         }
         return FFX_ERROR_INVALID_ARGUMENT;
     }
-    frame->pUsedLists = (BreadcrumbsListData*)ffxBreadcrumbsAppendList(frame->pUsedLists, frame->usedListsCount, sizeof(BreadcrumbsListData), 1, &contextPrivate->contextDescription.allocCallbacks);
+    if (frame->usedListsCount == frame->usedListsCapacity)
+    {
+        const size_t newCapacity = frame->usedListsCapacity ? frame->usedListsCapacity * 2 : 16;
+        frame->pUsedLists = (BreadcrumbsListData*)ffxBreadcrumbsAppendList(frame->pUsedLists, frame->usedListsCapacity, sizeof(BreadcrumbsListData),
+            newCapacity - frame->usedListsCapacity, &contextPrivate->contextDescription.allocCallbacks);
+        frame->usedListsCapacity = newCapacity;
+    }
     frame->pUsedLists[frame->usedListsCount] =
     {
         commandListDescription->commandList,
@@ -409,10 +564,13 @@ FfxErrorCode ffxBreadcrumbsRegisterCommandList(FfxBreadcrumbsContext* context, c
         name,
         FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_PIPELINE_INFO) ? nullptr : commandListDescription->pipeline,
         0,
+        0,
         nullptr,
         0,
+        0,
         nullptr
     };
+    breadcrumbsMapInsert(&contextPrivate->contextDescription.allocCallbacks, &frame->usedListsMap, commandListDescription->commandList, (uint32_t)frame->usedListsCount);
     ++frame->usedListsCount;
     if (lockEnable)
     {
@@ -456,9 +614,17 @@ FfxErrorCode ffxBreadcrumbsRegisterPipeline(FfxBreadcrumbsContext* context, cons
         FFX_MUTEX_LOCK(contextPrivate->pipelinesNamesBuffer.mutex);
     }
 
-    contextPrivate->pRegisteredPipelines = (BreadcrumbsPipelineData*)ffxBreadcrumbsAppendList(contextPrivate->pRegisteredPipelines,
-        contextPrivate->registeredPipelinesCount, sizeof(BreadcrumbsPipelineData), 1, &contextPrivate->contextDescription.allocCallbacks);
+    if (contextPrivate->registeredPipelinesCount == contextPrivate->registeredPipelinesCapacity)
+    {
+        const size_t newCapacity = contextPrivate->registeredPipelinesCapacity ? contextPrivate->registeredPipelinesCapacity * 2 : 16;
+        contextPrivate->pRegisteredPipelines = (BreadcrumbsPipelineData*)ffxBreadcrumbsAppendList(contextPrivate->pRegisteredPipelines,
+            contextPrivate->registeredPipelinesCapacity, sizeof(BreadcrumbsPipelineData), newCapacity - contextPrivate->registeredPipelinesCapacity,
+            &contextPrivate->contextDescription.allocCallbacks);
+        contextPrivate->registeredPipelinesCapacity = newCapacity;
+    }
     BreadcrumbsPipelineData* newPipeline = contextPrivate->pRegisteredPipelines + contextPrivate->registeredPipelinesCount;
+    breadcrumbsMapInsert(&contextPrivate->contextDescription.allocCallbacks, &contextPrivate->registeredPipelinesMap,
+        pipelineDescription->pipeline, (uint32_t)contextPrivate->registeredPipelinesCount);
     ++contextPrivate->registeredPipelinesCount;
 
     FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
@@ -579,7 +745,11 @@ FfxErrorCode ffxBreadcrumbsBeginMarker(FfxBreadcrumbsContext* context, FfxComman
             block = breadcrumbsGetLastBlock(queueBlocks);
         }
         else
+        {
+            // Block kept from the frame that used this slot before, its markers are no longer needed.
+            block = breadcrumbsGetLastBlock(queueBlocks);
             block->nextMarker = 0;
+        }
     }
 
     markerData.block = queueBlocks->currentBlock;
@@ -599,9 +769,17 @@ FfxErrorCode ffxBreadcrumbsBeginMarker(FfxBreadcrumbsContext* context, FfxComman
     markerData.usedPipeline = listData->currentPipeline;
     markerData.nestingLevel = listData->currentStackCount;
 
-    listData->pCurrentStack = (uint32_t*)ffxBreadcrumbsAppendList(listData->pCurrentStack, listData->currentStackCount, sizeof(uint32_t), 1, allocs);
+    if (listData->currentStackCount == listData->currentStackCapacity)
+    {
+        listData->pCurrentStack = (uint32_t*)breadcrumbsGrowArray(allocs, frame, lockEnable,
+            listData->pCurrentStack, listData->currentStackCount, &listData->currentStackCapacity, sizeof(uint32_t));
+    }
     listData->pCurrentStack[listData->currentStackCount++] = listData->markersCount;
-    listData->pMarkers = (BreadcrumbsMarkerData*)ffxBreadcrumbsAppendList(listData->pMarkers, listData->markersCount, sizeof(BreadcrumbsMarkerData), 1, allocs);
+    if (listData->markersCount == listData->markersCapacity)
+    {
+        listData->pMarkers = (BreadcrumbsMarkerData*)breadcrumbsGrowArray(allocs, frame, lockEnable,
+            listData->pMarkers, listData->markersCount, &listData->markersCapacity, sizeof(BreadcrumbsMarkerData));
+    }
     listData->pMarkers[listData->markersCount++] = markerData;
 
     if (lockEnable)
@@ -643,8 +821,6 @@ FfxErrorCode ffxBreadcrumbsEndMarker(FfxBreadcrumbsContext* context, FfxCommandL
     // Retrieve data about which marker is being closed now.
     uint32_t markerIndex = listData->pCurrentStack[--listData->currentStackCount];
     FFX_ASSERT(markerIndex < listData->markersCount);
-    listData->pCurrentStack = (uint32_t*)ffxBreadcrumbsPopList(listData->pCurrentStack, listData->currentStackCount, sizeof(uint32_t),
-        &contextPrivate->contextDescription.allocCallbacks);
 
     // Get correct location for writing
     BreadcrumbsMarkerData* marker = listData->pMarkers + markerIndex;
@@ -664,380 +840,929 @@ FfxErrorCode ffxBreadcrumbsEndMarker(FfxBreadcrumbsContext* context, FfxCommandL
     return FFX_OK;
 }
 
-FfxErrorCode ffxBreadcrumbsPrintStatus(FfxBreadcrumbsContext* context, FfxBreadcrumbsMarkersStatus* markersStatus)
+// Fixed size staging for status output, handed to the sink whenever full so printing never allocates.
+struct BreadcrumbsStatusWriter
 {
-    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
-    FFX_RETURN_ON_ERROR(markersStatus, FFX_ERROR_INVALID_POINTER);
-    
-    FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
-    markersStatus->bufferSize = 0;
-    markersStatus->pBuffer = nullptr;
+    FfxBreadcrumbsStatusSink            sink;
+    void*                               pUserData;
+    size_t                              used;
+    char                                chunk[FFX_BREADCRUMBS_STATUS_CHUNK_SIZE];
 
-    const bool skipFinishedLists = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_FINISHED_LISTS);
-    const bool skipNotStartedLists = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS);
-    const bool skipFinishedNodes = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_FINISHED_NODES);
-    const bool skipNotStartedNodes = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_NODES);
-    
-    FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
-    if (!FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO))
+    void Write(const void* data, size_t size)
     {
-        FFX_RETURN_ON_ERROR(contextPrivate->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo, FFX_ERROR_INVALID_ARGUMENT);
-        contextPrivate->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo(&contextPrivate->contextDescription.backendInterface, allocs,
-            FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_EXTENDED_DEVICE_INFO),
-            &markersStatus->pBuffer, &markersStatus->bufferSize);
+        const char* src = (const char*)data;
+        while (size)
+        {
+            size_t copySize = FFX_BREADCRUMBS_STATUS_CHUNK_SIZE - used;
+            if (copySize > size)
+                copySize = size;
+            memcpy(chunk + used, src, copySize);
+            used += copySize;
+            src += copySize;
+            size -= copySize;
+            if (used == FFX_BREADCRUMBS_STATUS_CHUNK_SIZE)
+                Flush();
+        }
+    }
+
+    void Flush()
+    {
+        if (used)
+        {
+            sink(pUserData, chunk, used);
+            used = 0;
+        }
     }
-    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "[BREADCRUMBS]\n");
-    for (uint32_t i = contextPrivate->contextDescription.frameHistoryLength; i--;)
+
+    template<size_t N>
+    void Literal(const char (&str)[N]) { Write(str, N - 1); }
+    void String(const char* str) { Write(str, strlen(str)); }
+    void Char(char c) { Write(&c, 1); }
+
+    void Uint(uint64_t value)
     {
-        if (i > contextPrivate->frameIndex)
-            continue;
-        const uint32_t currentFrame = contextPrivate->frameIndex - i;
-        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "<Frame ");
-        FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, currentFrame);
-        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">\n");
+        char   digits[20];
+        size_t count = 0;
+        do
+        {
+            digits[sizeof(digits) - ++count] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value);
+        Write(digits + sizeof(digits) - count, count);
+    }
 
-        // Move backwards in recorded frames inside ring buffer for frames in flight.
-        BreadcrumbsFrameData* frame = contextPrivate->pFrameData + (currentFrame % contextPrivate->contextDescription.frameHistoryLength);
-        if (frame->usedListsCount == 0)
+    template<typename T>
+    void Raw(const T& value) { Write(&value, sizeof(T)); }
+};
+
+// Shader and pipeline names used for the status, nullptr when not set.
+typedef struct BreadcrumbsPipelineView {
+
+    const char*                         name;
+    const char*                         vertexShader;
+    const char*                         hullShader;
+    const char*                         domainShader;
+    const char*                         geometryShader;
+    const char*                         meshShader;
+    const char*                         amplificationShader;
+    const char*                         pixelShader;
+    const char*                         computeShader;
+    const char*                         rayTracingShader;
+} BreadcrumbsPipelineView;
+
+typedef struct BreadcrumbsMarkerView {
+
+    FfxBreadcrumbsMarkerType            type;
+    uint32_t                            nestingLevel;
+    char                                status;
+    const char*                         name;
+    bool                                hasPipeline;
+    BreadcrumbsPipelineView             pipeline;
+} BreadcrumbsMarkerView;
+
+#define X(marker) + 1
+static const uint32_t BREADCRUMBS_MARKER_TYPE_COUNT = 1 FFX_BREADCRUMBS_MARKER_LIST;
+#undef X
+
+// Layout of FFX_BREADCRUMBS_STATUS_FORMAT_BINARY, all values little endian. Strings are stored as offsets into
+// null terminated string blobs, BREADCRUMBS_BINARY_NONE marks missing names and pipelines.
+//
+// BreadcrumbsBinaryHeader
+// BreadcrumbsBinaryPipeline[pipelineCount], uint32_t stringsSize, char strings[stringsSize]
+// uint32_t deviceInfoSize, char deviceInfo[deviceInfoSize]
+// uint32_t frameCount, for each frame:
+//     BreadcrumbsBinaryFrame, for each list:
+//         BreadcrumbsBinaryList, BreadcrumbsBinaryMarker[markersCount], uint32_t stringsSize, char strings[stringsSize]
+static const uint32_t BREADCRUMBS_BINARY_MAGIC = 0x53434246; // "FBCS"
+static const uint32_t BREADCRUMBS_BINARY_VERSION = 1;
+static const uint32_t BREADCRUMBS_BINARY_NONE = UINT32_MAX;
+
+typedef struct BreadcrumbsBinaryHeader {
+
+    uint32_t                            magic;
+    uint32_t                            version;
+    uint32_t                            flags;
+    uint32_t                            pipelineCount;
+} BreadcrumbsBinaryHeader;
+
+typedef struct BreadcrumbsBinaryPipeline {
+
+    uint32_t                            name;
+    uint32_t                            vertexShader;
+    uint32_t                            hullShader;
+    uint32_t                            domainShader;
+    uint32_t                            geometryShader;
+    uint32_t                            meshShader;
+    uint32_t                            amplificationShader;
+    uint32_t                            pixelShader;
+    uint32_t                            computeShader;
+    uint32_t                            rayTracingShader;
+} BreadcrumbsBinaryPipeline;
+
+typedef struct BreadcrumbsBinaryFrame {
+
+    uint32_t                            frameIndex;
+    uint32_t                            listCount;
+} BreadcrumbsBinaryFrame;
+
+typedef struct BreadcrumbsBinaryList {
+
+    uint32_t                            queueType;
+    uint32_t                            submissionIndex;
+    uint32_t                            markersCount;
+    uint32_t                            name;
+    char                                status;
+    char                                padding[3];
+} BreadcrumbsBinaryList;
+
+typedef struct BreadcrumbsBinaryMarker {
+
+    uint32_t                            type;
+    uint32_t                            nestingLevel;
+    uint32_t                            name;
+    uint32_t                            pipeline;
+    char                                status;
+    char                                padding[3];
+} BreadcrumbsBinaryMarker;
+
+static const char* breadcrumbsGetOptionalName(BreadcrumbsCustomNameBuffer* nameBuffer, const BreadcrumbsCustomName* name)
+{
+    return name->pName ? breadcrumbsGetName(nameBuffer, name) : nullptr;
+}
+
+static void breadcrumbsGetPipelineView(FfxBreadcrumbsContext_Private* context, BreadcrumbsPipelineData* pipeline, BreadcrumbsPipelineView* view)
+{
+    BreadcrumbsCustomNameBuffer* names = &context->pipelinesNamesBuffer;
+    view->name                = breadcrumbsGetOptionalName(names, &pipeline->name);
+    view->vertexShader        = breadcrumbsGetOptionalName(names, &pipeline->vertexShader);
+    view->hullShader          = breadcrumbsGetOptionalName(names, &pipeline->hullShader);
+    view->domainShader        = breadcrumbsGetOptionalName(names, &pipeline->domainShader);
+    view->geometryShader      = breadcrumbsGetOptionalName(names, &pipeline->geometryShader);
+    view->meshShader          = breadcrumbsGetOptionalName(names, &pipeline->meshShader);
+    view->amplificationShader = breadcrumbsGetOptionalName(names, &pipeline->amplificationShader);
+    view->pixelShader         = breadcrumbsGetOptionalName(names, &pipeline->pixelShader);
+    view->computeShader       = breadcrumbsGetOptionalName(names, &pipeline->computeShader);
+    view->rayTracingShader    = breadcrumbsGetOptionalName(names, &pipeline->rayTracingShader);
+}
+
+static const uint32_t* breadcrumbsGetMarkerLocation(const BreadcrumbsBlockVector* queueBlocks, const BreadcrumbsMarkerData* marker)
+{
+    return (uint32_t*)(queueBlocks->pMemoryBlocks[marker->block].memory) + marker->offset;
+}
+
+// Frame value is coded in 31-1 bits of saved data minus 1, bit 0 tells whether marker has finished.
+static uint32_t breadcrumbsGetMarkerFrame(const uint32_t* location)
+{
+    return (*location >> 1) - 1;
+}
+
+// Decodes marker status from its memory location: ' ' not started, '>' started, 'X' finished.
+static char breadcrumbsGetMarkerStatus(const BreadcrumbsBlockVector* queueBlocks, const BreadcrumbsMarkerData* marker, uint32_t currentFrame)
+{
+    const uint32_t* location = breadcrumbsGetMarkerLocation(queueBlocks, marker);
+    const uint32_t markerFrame = breadcrumbsGetMarkerFrame(location);
+    FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
+
+    if (markerFrame == currentFrame)
+        return (*location & 1) ? 'X' : '>';
+    return ' ';
+}
+
+static char breadcrumbsGetListStatus(const BreadcrumbsBlockVector* queueBlocks, const BreadcrumbsListData* cl, uint32_t currentFrame)
+{
+    if (cl->markersCount == 0)
+        return ' ';
+
+    // Inspect last marker to determine list status, if finished then all previous have also finished.
+    const char lastStatus = breadcrumbsGetMarkerStatus(queueBlocks, cl->pMarkers + cl->markersCount - 1, currentFrame);
+    if (lastStatus != ' ')
+        return lastStatus;
+
+    // Same check for first marker, if it have not started yet then none in this command list has started too.
+    const uint32_t markerFrame = breadcrumbsGetMarkerFrame(breadcrumbsGetMarkerLocation(queueBlocks, cl->pMarkers));
+    FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
+    return markerFrame < currentFrame ? ' ' : '>';
+}
+
+static bool breadcrumbsSkipList(uint32_t flags, char status, uint32_t markersCount)
+{
+    if (markersCount == 0)
+        return true;
+    if (status == 'X')
+        return !FFX_CONTAINS_FLAG(flags, FFX_BREADCRUMBS_PRINT_FINISHED_LISTS);
+    if (status == ' ')
+        return !FFX_CONTAINS_FLAG(flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS);
+    return false;
+}
+
+static void breadcrumbsWriteListHeader(BreadcrumbsStatusWriter& writer, char status, uint32_t queueType, uint32_t submissionIndex, uint64_t listNumber, const char* name)
+{
+    writer.Literal(" - [");
+    writer.Char(status);
+    writer.Literal("] Queue type <");
+    writer.Uint(queueType);
+    writer.Literal(">, submission no. ");
+    writer.Uint(submissionIndex);
+    writer.Literal(", command list ");
+    writer.Uint(listNumber);
+    if (name)
+    {
+        writer.Literal(": \"");
+        writer.String(name);
+        writer.Literal("\"");
+    }
+    writer.Literal("\n");
+}
+
+static void breadcrumbsWriteShader(BreadcrumbsStatusWriter& writer, bool& before, const char (&label)[6], const char* shader)
+{
+    if (shader == nullptr)
+        return;
+    if (before)
+        writer.Literal(" |");
+    before = true;
+    writer.Literal(label);
+    writer.String(shader);
+}
+
+static void breadcrumbsWritePipeline(BreadcrumbsStatusWriter& writer, const BreadcrumbsPipelineView& pipeline)
+{
+    const bool isCompute = pipeline.computeShader != nullptr;
+    const bool isRT = pipeline.rayTracingShader != nullptr;
+    const bool isVertexShading = pipeline.vertexShader || pipeline.hullShader || pipeline.domainShader || pipeline.geometryShader;
+    const bool isMeshShading = pipeline.meshShader || pipeline.amplificationShader;
+    const bool isGfx = isVertexShading || isMeshShading || pipeline.pixelShader;
+    FFX_ASSERT_MESSAGE((!isCompute && !isRT) || (!isCompute && !isGfx) || (!isRT && !isGfx), "Wrong combination of shaders for pipeline!");
+    FFX_ASSERT_MESSAGE(!(isVertexShading && isMeshShading), "Wrong combination of geometry processing for graphics pipeline!");
+
+    writer.Literal(", ");
+    if (isCompute)
+        writer.Literal("compute ");
+    else if (isRT)
+        writer.Literal("ray tracing ");
+    else if (isGfx)
+        writer.Literal("graphics ");
+    writer.Literal("pipeline");
+    if (pipeline.name)
+    {
+        writer.Literal(" \"");
+        writer.String(pipeline.name);
+        writer.Literal("\"");
+    }
+
+    if (isCompute)
+    {
+        writer.Literal(" [ CS: ");
+        writer.String(pipeline.computeShader);
+        writer.Literal(" ]");
+    }
+    else if (isRT)
+    {
+        writer.Literal(" [ RT: ");
+        writer.String(pipeline.rayTracingShader);
+        writer.Literal(" ]");
+    }
+    else if (isGfx)
+    {
+        writer.Literal(" [");
+        bool before = false;
+        if (isVertexShading)
         {
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " - No command lists\n");
-            continue;
+            breadcrumbsWriteShader(writer, before, " VS: ", pipeline.vertexShader);
+            breadcrumbsWriteShader(writer, before, " HS: ", pipeline.hullShader);
+            breadcrumbsWriteShader(writer, before, " DS: ", pipeline.domainShader);
+            breadcrumbsWriteShader(writer, before, " GS: ", pipeline.geometryShader);
         }
-        for (size_t j = 0; j < frame->usedListsCount; ++j)
+        else if (isMeshShading)
         {
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " - [");
+            breadcrumbsWriteShader(writer, before, " MS: ", pipeline.meshShader);
+            breadcrumbsWriteShader(writer, before, " AS: ", pipeline.amplificationShader);
+        }
+        breadcrumbsWriteShader(writer, before, " PS: ", pipeline.pixelShader);
+        writer.Literal(" ]");
+    }
+}
 
-            BreadcrumbsListData* cl = frame->pUsedLists + j;
-            bool skipList = false;
-            uint32_t markerFrame = UINT32_MAX;
-            const uint32_t* location = nullptr;
-            const BreadcrumbsBlockVector* queueBlocks = frame->pBlockPerQueue + cl->queueType;
-            // Check for finished or not started CLs
-            if (cl->markersCount > 0)
-            {
-                // Inspect last marker's memory location to determine it's status and decode it's frame value (coded in 31-1 bits of saved data minus 1)
-                BreadcrumbsMarkerData* lastMarker = cl->pMarkers + cl->markersCount - 1;
-                location = (uint32_t*)(queueBlocks->pMemoryBlocks[lastMarker->block].memory) + lastMarker->offset;
-                markerFrame = (*location >> 1) - 1;
-                FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
+// Prints markers of a single command list as a tree. MarkerSource provides Count(), Type(m), NestingLevel(m) and Get(m, view),
+// so the same code serves live context data and decoded binary status.
+// Returns number of markers nested too deep to be printed, a note about them is written after the tree.
+template<typename MarkerSource>
+static uint32_t breadcrumbsWriteMarkerTree(BreadcrumbsStatusWriter& writer, uint32_t flags, const MarkerSource& markers)
+{
+    const bool skipFinishedNodes = !FFX_CONTAINS_FLAG(flags, FFX_BREADCRUMBS_PRINT_FINISHED_NODES);
+    const bool skipNotStartedNodes = !FFX_CONTAINS_FLAG(flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_NODES);
+
+    // Indices determining how long given nesting level will be present before moving up in hierarchy.
+    // Kept on stack so printing never allocates, markers nested deeper than FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL
+    // are counted and reported instead of printed.
+    uint32_t nestingLevelIndicatorIndices[FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL];
+    nestingLevelIndicatorIndices[0] = 0;
+    uint32_t nestingLevelIndicesCount = 1;
+
+    // Display level informs from which point deeper markers can be cut out
+    // in case of collapsing uniform nodes (markers that all nested markers have same finished or not started status).
+    uint32_t displayLevel = UINT32_MAX;
+    uint32_t markerId = 0;
+    uint32_t skippedMarkers = 0;
+
+    FfxBreadcrumbsMarkerType currentType = FFX_BREADCRUMBS_MARKER_PASS;
+    const uint32_t markersCount = markers.Count();
+    // Go through every marker in command list and display it's info
+    for (uint32_t m = 0; m < markersCount; ++m)
+    {
+        BreadcrumbsMarkerView marker;
+        markers.Get(m, marker);
+        if (marker.nestingLevel >= FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL)
+        {
+            ++skippedMarkers;
+            continue;
+        }
+        const char status = marker.status;
 
-                if (markerFrame == currentFrame)
+        // When going deeper into hierarchy allocate new index for marker.
+        if (marker.nestingLevel >= nestingLevelIndicesCount)
+        {
+            markerId = 0;
+            nestingLevelIndicatorIndices[nestingLevelIndicesCount++] = 0;
+            // Check whether deeper nodes will be collapsed or not.
+            if (((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' ')) && displayLevel == UINT32_MAX)
+                displayLevel = marker.nestingLevel;
+        }
+        else
+        {
+            if (skipFinishedNodes || skipNotStartedNodes)
+            {
+                // If going up in hierarchy check wheter displayLevel can be relaxed or restricted to upper level.
+                if (displayLevel != UINT32_MAX)
                 {
-                    // Check marker status: 0 - started, 1 - finished
-                    // If finished then all previous have also finished
-                    if (*location & 1)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "X");
-                        skipList = skipFinishedLists;
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">");
-                    }
+                    if (displayLevel > marker.nestingLevel)
+                        displayLevel = status == '>' ? UINT32_MAX : marker.nestingLevel;
+                    else if (displayLevel == marker.nestingLevel && status == '>')
+                        displayLevel = UINT32_MAX;
                 }
-                else // markerFrame < currentFrame, last case is asserted for
-                {
-                    // Same check for first marker
-                    location = (uint32_t*)(queueBlocks->pMemoryBlocks[cl->pMarkers->block].memory) + cl->pMarkers->offset;
-                    markerFrame = (*location >> 1) - 1;
-                    FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
+                else if ((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' '))
+                    displayLevel = marker.nestingLevel;
+            }
+            // Pop indicators when moving to up in nesting levels
+            if (marker.nestingLevel + 1 < nestingLevelIndicesCount)
+            {
+                markerId = 0;
+                nestingLevelIndicesCount = marker.nestingLevel + 1;
+            }
+        }
+        if (marker.type != currentType)
+        {
+            currentType = marker.type;
+            markerId = 0;
+        }
 
-                    // If first marker have not started yet, then none in this command list has started too
-                    if (markerFrame < currentFrame)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                        skipList = skipNotStartedLists;
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">");
-                    }
-                }
+        if (marker.nestingLevel > displayLevel)
+            continue;
+
+        // When on next level, check for newer indices
+        uint32_t* lastIdx = nestingLevelIndicatorIndices + nestingLevelIndicesCount - 1;
+        if (*lastIdx != UINT32_MAX && *lastIdx <= m)
+        {
+            *lastIdx = UINT32_MAX;
+            // Detect how long given level will be present to calculate proper tree branches
+            for (uint32_t next = m + 1; next < markersCount; ++next)
+            {
+                const uint32_t nestingLevel = markers.NestingLevel(next);
+                if (nestingLevel < marker.nestingLevel)
+                    break;
+                else if (nestingLevel == marker.nestingLevel)
+                    *lastIdx = next;
             }
+        }
+
+        // Mark previous levels in tree and display current entry
+        writer.Literal("  ");
+        for (uint32_t k = 0; k < marker.nestingLevel; ++k)
+        {
+            writer.Literal("  ");
+            if (nestingLevelIndicatorIndices[k] != UINT32_MAX && nestingLevelIndicatorIndices[k] > m)
+                writer.Literal("\xe2\x94\x82"); // `|`
             else
+                writer.Literal(" ");
+        }
+
+        writer.Literal("  ");
+        if (*lastIdx == UINT32_MAX || *lastIdx == m)
+            writer.Literal("\xe2\x94\x94"); // `'-`
+        else
+            writer.Literal("\xe2\x94\x9c"); // `|-`
+
+        writer.Literal("\xe2\x94\x80["); // `-`
+        writer.Char(status);
+        writer.Literal("] ");
+
+        if (marker.type == FFX_BREADCRUMBS_MARKER_PASS)
+        {
+            FFX_ASSERT_MESSAGE(marker.name, "Custom passes should always have names!");
+            writer.String(marker.name ? marker.name : "");
+        }
+        else
+        {
+            writer.String(breadDecodeMarkerType(marker.type));
+            if (markerId != 0 || (m + 1 < markersCount && markers.Type(m + 1) == marker.type))
+            {
+                writer.Literal(" ");
+                writer.Uint(++markerId);
+            }
+            if (marker.name)
             {
-                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                skipList = true;
+                writer.Literal(": \"");
+                writer.String(marker.name);
+                writer.Literal("\"");
             }
+        }
+        if (marker.hasPipeline)
+            breadcrumbsWritePipeline(writer, marker.pipeline);
+        writer.Literal("\n");
+    }
 
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "] Queue type <");
-            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->queueType);
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">, submission no. ");
-            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->submissionIndex);
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", command list ");
-            FFX_BREADCRUMBS_APPEND_UINT64(markersStatus->pBuffer, markersStatus->bufferSize, j + 1);
-            if (cl->name.pName)
+    if (skippedMarkers)
+    {
+        writer.Literal("  <");
+        writer.Uint(skippedMarkers);
+        writer.Literal(" markers nested deeper than ");
+        writer.Uint(FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL);
+        writer.Literal(" levels not printed>\n");
+    }
+    return skippedMarkers;
+}
+
+// Markers of a command list recorded in the context, status read back from breadcrumbs memory.
+struct BreadcrumbsLiveMarkers
+{
+    FfxBreadcrumbsContext_Private*      context;
+    BreadcrumbsFrameData*               frame;
+    const BreadcrumbsListData*          cl;
+    const BreadcrumbsBlockVector*       queueBlocks;
+    uint32_t                            currentFrame;
+
+    uint32_t Count() const { return cl->markersCount; }
+    FfxBreadcrumbsMarkerType Type(uint32_t m) const { return cl->pMarkers[m].type; }
+    uint32_t NestingLevel(uint32_t m) const { return cl->pMarkers[m].nestingLevel; }
+
+    void Get(uint32_t m, BreadcrumbsMarkerView& view) const
+    {
+        const BreadcrumbsMarkerData* marker = cl->pMarkers + m;
+        view.type = marker->type;
+        view.nestingLevel = marker->nestingLevel;
+        view.status = breadcrumbsGetMarkerStatus(queueBlocks, marker, currentFrame);
+        view.name = breadcrumbsGetOptionalName(&frame->namesBuffer, &marker->name);
+        view.hasPipeline = false;
+        if (marker->usedPipeline)
+        {
+            BreadcrumbsPipelineData* pipeline = breadcrumbsSearchPipeline(context, marker->usedPipeline);
+            FFX_ASSERT_MESSAGE(pipeline, "When pipeline has been properly set on command list it should always be present here!");
+            if (pipeline)
             {
-                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ": \"");
-                FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&frame->namesBuffer, &cl->name));
-                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+                view.hasPipeline = true;
+                breadcrumbsGetPipelineView(context, pipeline, &view.pipeline);
             }
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n");
-            if (skipList)
+        }
+    }
+};
+
+static void breadcrumbsWriteDeviceInfo(FfxBreadcrumbsContext_Private* context, BreadcrumbsStatusWriter& writer, bool binary)
+{
+    char*  deviceInfo = nullptr;
+    size_t deviceInfoSize = 0;
+    if (!FFX_CONTAINS_FLAG(context->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO))
+    {
+        // Only part of the output produced by the backend, may allocate.
+        context->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo(&context->contextDescription.backendInterface,
+            &context->contextDescription.allocCallbacks,
+            FFX_CONTAINS_FLAG(context->contextDescription.flags, FFX_BREADCRUMBS_PRINT_EXTENDED_DEVICE_INFO),
+            &deviceInfo, &deviceInfoSize);
+    }
+    if (binary)
+        writer.Raw((uint32_t)deviceInfoSize);
+    writer.Write(deviceInfo, deviceInfoSize);
+    FFX_SAFE_FREE(deviceInfo, context->contextDescription.allocCallbacks.fpFree);
+}
+
+static FfxErrorCode breadcrumbsWriteTextStatus(FfxBreadcrumbsContext_Private* context, BreadcrumbsStatusWriter& writer)
+{
+    const uint32_t flags = context->contextDescription.flags;
+    FfxErrorCode errorCode = FFX_OK;
+
+    writer.Literal("[BREADCRUMBS]\n");
+    for (uint32_t i = context->contextDescription.frameHistoryLength; i--;)
+    {
+        if (i > context->frameIndex)
+            continue;
+        const uint32_t currentFrame = context->frameIndex - i;
+        writer.Literal("<Frame ");
+        writer.Uint(currentFrame);
+        writer.Literal(">\n");
+
+        // Move backwards in recorded frames inside ring buffer for frames in flight.
+        BreadcrumbsFrameData* frame = context->pFrameData + (currentFrame % context->contextDescription.frameHistoryLength);
+        if (frame->usedListsCount == 0)
+        {
+            writer.Literal(" - No command lists\n");
+            continue;
+        }
+        for (size_t j = 0; j < frame->usedListsCount; ++j)
+        {
+            const BreadcrumbsListData* cl = frame->pUsedLists + j;
+            const BreadcrumbsBlockVector* queueBlocks = frame->pBlockPerQueue + cl->queueType;
+            const char status = breadcrumbsGetListStatus(queueBlocks, cl, currentFrame);
+
+            breadcrumbsWriteListHeader(writer, status, cl->queueType, cl->submissionIndex, j + 1, breadcrumbsGetOptionalName(&frame->namesBuffer, &cl->name));
+            if (breadcrumbsSkipList(flags, status, cl->markersCount))
                 continue;
 
-            // Indices determining how long given nesting level will be present before moving up in hierarchy.
-            uint32_t* nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsAppendList(nullptr, 0, sizeof(uint32_t), 1, allocs);
-            nestingLevelIndicatorIndices[0] = 0;
-            uint32_t nestingLevelIndicesCount = 1;
+            const BreadcrumbsLiveMarkers markers = { context, frame, cl, queueBlocks, currentFrame };
+            if (breadcrumbsWriteMarkerTree(writer, flags, markers))
+                errorCode = FFX_ERROR_OUT_OF_RANGE;
+        }
+    }
+    return errorCode;
+}
 
-            // Display level informs from which point deeper markers can be cut out
-            // in case of collapsing uniform nodes (markers that all nested markers have same finished or not started status).
-            uint32_t displayLevel = UINT32_MAX;
-            uint32_t markerId = 0;
+static uint32_t breadcrumbsBinaryString(const char* str, uint32_t& stringsSize)
+{
+    if (str == nullptr)
+        return BREADCRUMBS_BINARY_NONE;
+    const uint32_t offset = stringsSize;
+    stringsSize += (uint32_t)strlen(str) + 1;
+    return offset;
+}
+
+static void breadcrumbsWriteBinaryString(BreadcrumbsStatusWriter& writer, const char* str)
+{
+    if (str)
+        writer.Write(str, strlen(str) + 1);
+}
+
+static void breadcrumbsWriteBinaryStatus(FfxBreadcrumbsContext_Private* context, BreadcrumbsStatusWriter& writer)
+{
+    // Every table is written in two passes, first one computing string offsets and second one emitting the strings,
+    // so nothing has to be gathered in memory.
+    const BreadcrumbsBinaryHeader header = { BREADCRUMBS_BINARY_MAGIC, BREADCRUMBS_BINARY_VERSION, context->contextDescription.flags, (uint32_t)context->registeredPipelinesCount };
+    writer.Raw(header);
+
+    uint32_t stringsSize = 0;
+    for (size_t p = 0; p < context->registeredPipelinesCount; ++p)
+    {
+        BreadcrumbsPipelineView view;
+        breadcrumbsGetPipelineView(context, context->pRegisteredPipelines + p, &view);
+        BreadcrumbsBinaryPipeline pipeline;
+        pipeline.name                = breadcrumbsBinaryString(view.name, stringsSize);
+        pipeline.vertexShader        = breadcrumbsBinaryString(view.vertexShader, stringsSize);
+        pipeline.hullShader          = breadcrumbsBinaryString(view.hullShader, stringsSize);
+        pipeline.domainShader        = breadcrumbsBinaryString(view.domainShader, stringsSize);
+        pipeline.geometryShader      = breadcrumbsBinaryString(view.geometryShader, stringsSize);
+        pipeline.meshShader          = breadcrumbsBinaryString(view.meshShader, stringsSize);
+        pipeline.amplificationShader = breadcrumbsBinaryString(view.amplificationShader, stringsSize);
+        pipeline.pixelShader         = breadcrumbsBinaryString(view.pixelShader, stringsSize);
+        pipeline.computeShader       = breadcrumbsBinaryString(view.computeShader, stringsSize);
+        pipeline.rayTracingShader    = breadcrumbsBinaryString(view.rayTracingShader, stringsSize);
+        writer.Raw(pipeline);
+    }
+    writer.Raw(stringsSize);
+    for (size_t p = 0; p < context->registeredPipelinesCount; ++p)
+    {
+        BreadcrumbsPipelineView view;
+        breadcrumbsGetPipelineView(context, context->pRegisteredPipelines + p, &view);
+        breadcrumbsWriteBinaryString(writer, view.name);
+        breadcrumbsWriteBinaryString(writer, view.vertexShader);
+        breadcrumbsWriteBinaryString(writer, view.hullShader);
+        breadcrumbsWriteBinaryString(writer, view.domainShader);
+        breadcrumbsWriteBinaryString(writer, view.geometryShader);
+        breadcrumbsWriteBinaryString(writer, view.meshShader);
+        breadcrumbsWriteBinaryString(writer, view.amplificationShader);
+        breadcrumbsWriteBinaryString(writer, view.pixelShader);
+        breadcrumbsWriteBinaryString(writer, view.computeShader);
+        breadcrumbsWriteBinaryString(writer, view.rayTracingShader);
+    }
+
+    breadcrumbsWriteDeviceInfo(context, writer, true);
+
+    uint32_t frameCount = 0;
+    for (uint32_t i = context->contextDescription.frameHistoryLength; i--;)
+    {
+        if (i <= context->frameIndex)
+            ++frameCount;
+    }
+    writer.Raw(frameCount);
+
+    for (uint32_t i = context->contextDescription.frameHistoryLength; i--;)
+    {
+        if (i > context->frameIndex)
+            continue;
+        const uint32_t currentFrame = context->frameIndex - i;
+        BreadcrumbsFrameData* frame = context->pFrameData + (currentFrame % context->contextDescription.frameHistoryLength);
+        const BreadcrumbsBinaryFrame frameHeader = { currentFrame, (uint32_t)frame->usedListsCount };
+        writer.Raw(frameHeader);
+
+        for (size_t j = 0; j < frame->usedListsCount; ++j)
+        {
+            const BreadcrumbsListData* cl = frame->pUsedLists + j;
+            const BreadcrumbsBlockVector* queueBlocks = frame->pBlockPerQueue + cl->queueType;
+
+            // List name goes first into the list's string blob.
+            const char* listName = breadcrumbsGetOptionalName(&frame->namesBuffer, &cl->name);
+            stringsSize = 0;
+            BreadcrumbsBinaryList list = {};
+            list.queueType = cl->queueType;
+            list.submissionIndex = cl->submissionIndex;
+            list.markersCount = cl->markersCount;
+            list.name = breadcrumbsBinaryString(listName, stringsSize);
+            list.status = breadcrumbsGetListStatus(queueBlocks, cl, currentFrame);
+            writer.Raw(list);
 
-            FfxBreadcrumbsMarkerType currentType = FFX_BREADCRUMBS_MARKER_PASS;
-            // Go through every marker in command list and display it's info
             for (uint32_t m = 0; m < cl->markersCount; ++m)
             {
-                BreadcrumbsMarkerData* marker = cl->pMarkers + m;
-                // Same checks as before with determining if marker is finished or not started
-                location = (uint32_t*)(queueBlocks->pMemoryBlocks[marker->block].memory) + marker->offset;
-                markerFrame = (*location >> 1) - 1;
-                FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
-
-                char status = ' ';
-                if (markerFrame == currentFrame)
-                {
-                    if (*location & 1)
-                        status = 'X';
-                    else
-                        status = '>';
-                }
+                const BreadcrumbsMarkerData* markerData = cl->pMarkers + m;
+                BreadcrumbsBinaryMarker marker = {};
+                marker.type = markerData->type;
+                marker.nestingLevel = markerData->nestingLevel;
+                marker.name = breadcrumbsBinaryString(breadcrumbsGetOptionalName(&frame->namesBuffer, &markerData->name), stringsSize);
+                marker.pipeline = markerData->usedPipeline ? breadcrumbsMapFind(&context->registeredPipelinesMap, markerData->usedPipeline) : BREADCRUMBS_BINARY_NONE;
+                marker.status = breadcrumbsGetMarkerStatus(queueBlocks, markerData, currentFrame);
+                writer.Raw(marker);
+            }
 
-                // When going deeper into hierarchy allocate new index for marker.
-                if (marker->nestingLevel >= nestingLevelIndicesCount)
-                {
-                    markerId = 0;
-                    nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsAppendList(nestingLevelIndicatorIndices, nestingLevelIndicesCount, sizeof(uint32_t), 1, allocs);
-                    nestingLevelIndicatorIndices[nestingLevelIndicesCount++] = 0;
-                    // Check whether deeper nodes will be collapsed or not.
-                    if (((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' ')) && displayLevel == UINT32_MAX)
-                        displayLevel = marker->nestingLevel;
-                }
-                else
-                {
-                    if (skipFinishedNodes || skipNotStartedNodes)
-                    {
-                        // If going up in hierarchy check wheter displayLevel can be relaxed or restricted to upper level.
-                        if (displayLevel != UINT32_MAX)
-                        {
-                            if (displayLevel > marker->nestingLevel)
-                                displayLevel = status == '>' ? UINT32_MAX : marker->nestingLevel;
-                            else if (displayLevel == marker->nestingLevel && status == '>')
-                                displayLevel = UINT32_MAX;
-                        }
-                        else if ((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' '))
-                            displayLevel = marker->nestingLevel;
-                    }
-                    // Pop indicators when moving to up in nesting levels
-                    if (marker->nestingLevel + 1 < nestingLevelIndicesCount)
-                        markerId = 0;
-                    while (marker->nestingLevel + 1 < nestingLevelIndicesCount)
-                        nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsPopList(nestingLevelIndicatorIndices, --nestingLevelIndicesCount, sizeof(uint32_t), allocs);
-                }
-                if (marker->type != currentType)
-                {
-                    currentType = marker->type;
-                    markerId = 0;
-                }
+            writer.Raw(stringsSize);
+            breadcrumbsWriteBinaryString(writer, listName);
+            for (uint32_t m = 0; m < cl->markersCount; ++m)
+                breadcrumbsWriteBinaryString(writer, breadcrumbsGetOptionalName(&frame->namesBuffer, &cl->pMarkers[m].name));
+        }
+    }
+}
 
-                if (marker->nestingLevel <= displayLevel)
-                {
-                    // When on next level, check for newer indices
-                    uint32_t* lastIdx = nestingLevelIndicatorIndices + nestingLevelIndicesCount - 1;
-                    if (*lastIdx != UINT32_MAX && *lastIdx <= m)
-                    {
-                        *lastIdx = UINT32_MAX;
-                        // Detect how long given level will be present to calculate proper tree branches
-                        for (uint32_t next = m + 1; next < cl->markersCount; ++next)
-                        {
-                            const uint32_t nestingLevel = cl->pMarkers[next].nestingLevel;
-                            if (nestingLevel < marker->nestingLevel)
-                                break;
-                            else if (nestingLevel == marker->nestingLevel)
-                                *lastIdx = next;
-                        }
-                    }
+FfxErrorCode ffxBreadcrumbsWriteStatus(FfxBreadcrumbsContext* context, FfxBreadcrumbsStatusFormat format, FfxBreadcrumbsStatusSink sink, void* pUserData)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(sink, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(format == FFX_BREADCRUMBS_STATUS_FORMAT_TEXT || format == FFX_BREADCRUMBS_STATUS_FORMAT_BINARY, FFX_ERROR_INVALID_ENUM);
 
-                    // Mark previous levels in tree and display current entry
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
-                    for (uint32_t k = 0; k < marker->nestingLevel; ++k)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
-                        if (nestingLevelIndicatorIndices[k] != UINT32_MAX && nestingLevelIndicatorIndices[k] > m)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x82"); // `|`
-                        }
-                        else
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                        }
-                    }
+    FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
+    if (!FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO))
+    {
+        FFX_RETURN_ON_ERROR(contextPrivate->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo, FFX_ERROR_INVALID_ARGUMENT);
+    }
 
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
-                    if (nestingLevelIndicatorIndices[nestingLevelIndicesCount - 1] == UINT32_MAX || nestingLevelIndicatorIndices[nestingLevelIndicesCount - 1] == m)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x94"); // `'-`
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x9c"); // `|-`
-                    }
+    BreadcrumbsStatusWriter writer;
+    writer.sink = sink;
+    writer.pUserData = pUserData;
+    writer.used = 0;
+
+    FfxErrorCode errorCode = FFX_OK;
+    if (format == FFX_BREADCRUMBS_STATUS_FORMAT_BINARY)
+    {
+        breadcrumbsWriteBinaryStatus(contextPrivate, writer);
+    }
+    else
+    {
+        breadcrumbsWriteDeviceInfo(contextPrivate, writer, false);
+        errorCode = breadcrumbsWriteTextStatus(contextPrivate, writer);
+    }
+    writer.Flush();
 
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x80["); // `-`
-                    markersStatus->pBuffer = (char*)ffxBreadcrumbsAppendList(markersStatus->pBuffer, markersStatus->bufferSize, sizeof(char), 1, allocs);
-                    markersStatus->pBuffer[markersStatus->bufferSize++] = status;
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "] ");
+    return errorCode;
+}
 
-                    if (marker->type == FFX_BREADCRUMBS_MARKER_PASS)
-                    {
-                        FFX_ASSERT_MESSAGE(marker->name.pName, "Custom passes should always have names!");
-                        FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&frame->namesBuffer, &marker->name));
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadDecodeMarkerType(marker->type));
-                        if (markerId != 0 || m + 1 < cl->markersCount && cl->pMarkers[m + 1].type == marker->type)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, ++markerId);
-                        }
-                        if (marker->name.pName)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ": \"");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&frame->namesBuffer, &marker->name));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
-                        }
-                    }
-                    if (marker->usedPipeline)
-                    {
-                        BreadcrumbsPipelineData* pipeline = breadcrumbsSearchPipeline(contextPrivate, marker->usedPipeline);
-                        FFX_ASSERT_MESSAGE(pipeline, "When pipeline has been properly set on command list it should always be present here!");
-
-                        const bool isCompute = pipeline->computeShader.pName != nullptr;
-                        const bool isRT = pipeline->rayTracingShader.pName != nullptr;
-                        const bool isVertexShading = pipeline->vertexShader.pName || pipeline->hullShader.pName || pipeline->domainShader.pName || pipeline->geometryShader.pName;
-                        const bool isMeshShading = pipeline->meshShader.pName || pipeline->amplificationShader.pName;
-                        const bool isGfx = isVertexShading || isMeshShading || pipeline->pixelShader.pName;
-                        FFX_ASSERT_MESSAGE((!isCompute && !isRT) || (!isCompute && !isGfx) || (!isRT && !isGfx), "Wrong combination of shaders for pipeline!");
-                        FFX_ASSERT_MESSAGE(!(isVertexShading && isMeshShading), "Wrong combination of geometry processing for graphics pipeline!");
-
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", ");
-                        if (isCompute)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "compute ");
-                        }
-                        else if (isRT)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "ray tracing ");
-                        }
-                        else if (isGfx)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "graphics ");
-                        }
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "pipeline");
-                        if (pipeline->name.pName)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " \"");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->name));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
-                        }
-
-                        if (isCompute)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [ CS: ");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->computeShader));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
-                        }
-                        else if (isRT)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [ RT: ");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->rayTracingShader));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
-                        }
-                        else if (isGfx)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [");
-                            bool before = false;
-                            if (isVertexShading)
-                            {
-                                if (pipeline->vertexShader.pName)
-                                {
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " VS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->vertexShader));
-                                }
-                                if (pipeline->hullShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " HS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->hullShader));
-                                }
-                                if (pipeline->domainShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " DS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->domainShader));
-                                }
-                                if (pipeline->geometryShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " GS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->geometryShader));
-                                }
-                            }
-                            else if (isMeshShading)
-                            {
-                                if (pipeline->meshShader.pName)
-                                {
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " MS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->meshShader));
-                                }
-                                if (pipeline->amplificationShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " AS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->amplificationShader));
-                                }
-                            }
-                            if (pipeline->pixelShader.pName)
-                            {
-                                if (before)
-                                {
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                }
-                                before = true;
-                                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " PS: ");
-                                FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->pixelShader));
-                            }
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
-                        }
-                    }
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n");
-                }
-            }
+// Bounds checked access to FFX_BREADCRUMBS_STATUS_FORMAT_BINARY data.
+struct BreadcrumbsBinaryReader
+{
+    const uint8_t*                      data;
+    size_t                              size;
+    size_t                              offset;
+
+    const void* Take(size_t bytes)
+    {
+        if (bytes > size - offset)
+            return nullptr;
+        const void* ptr = data + offset;
+        offset += bytes;
+        return ptr;
+    }
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        const void* ptr = Take(sizeof(T));
+        if (ptr)
+            memcpy(&value, ptr, sizeof(T));
+        return ptr != nullptr;
+    }
+
+    // Reads size prefixed, null terminated string blob.
+    bool ReadStrings(const char*& strings, uint32_t& stringsSize)
+    {
+        if (!Read(stringsSize))
+            return false;
+        strings = (const char*)Take(stringsSize);
+        return strings && (stringsSize == 0 || strings[stringsSize - 1] == '\0');
+    }
+};
+
+static bool breadcrumbsDecodeString(const char* strings, uint32_t stringsSize, uint32_t offset, const char*& str)
+{
+    if (offset == BREADCRUMBS_BINARY_NONE)
+    {
+        str = nullptr;
+        return true;
+    }
+    str = strings + offset;
+    return offset < stringsSize;
+}
+
+static bool breadcrumbsDecodePipeline(const BreadcrumbsBinaryPipeline& pipeline, const char* strings, uint32_t stringsSize, BreadcrumbsPipelineView& view)
+{
+    return breadcrumbsDecodeString(strings, stringsSize, pipeline.name, view.name)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.vertexShader, view.vertexShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.hullShader, view.hullShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.domainShader, view.domainShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.geometryShader, view.geometryShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.meshShader, view.meshShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.amplificationShader, view.amplificationShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.pixelShader, view.pixelShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.computeShader, view.computeShader)
+        && breadcrumbsDecodeString(strings, stringsSize, pipeline.rayTracingShader, view.rayTracingShader);
+}
+
+// Markers of a command list stored in binary status, validated before printing.
+struct BreadcrumbsBinaryMarkers
+{
+    const uint8_t*                      markers;
+    uint32_t                            markersCount;
+    const char*                         strings;
+    uint32_t                            stringsSize;
+    const uint8_t*                      pipelines;
+    uint32_t                            pipelineCount;
+    const char*                         pipelineStrings;
+    uint32_t                            pipelineStringsSize;
+
+    BreadcrumbsBinaryMarker Load(uint32_t m) const
+    {
+        BreadcrumbsBinaryMarker marker;
+        memcpy(&marker, markers + sizeof(BreadcrumbsBinaryMarker) * m, sizeof(BreadcrumbsBinaryMarker));
+        return marker;
+    }
+
+    bool Validate() const
+    {
+        for (uint32_t m = 0; m < markersCount; ++m)
+        {
+            const BreadcrumbsBinaryMarker marker = Load(m);
+            const char* name;
+            if (marker.type >= BREADCRUMBS_MARKER_TYPE_COUNT || !breadcrumbsDecodeString(strings, stringsSize, marker.name, name))
+                return false;
+            if (marker.pipeline != BREADCRUMBS_BINARY_NONE && marker.pipeline >= pipelineCount)
+                return false;
+            // Nesting can only grow one level at a time.
+            if (marker.nestingLevel > (m ? Load(m - 1).nestingLevel + 1 : 0))
+                return false;
         }
+        return true;
     }
 
-    return FFX_OK;
+    uint32_t Count() const { return markersCount; }
+    FfxBreadcrumbsMarkerType Type(uint32_t m) const { return (FfxBreadcrumbsMarkerType)Load(m).type; }
+    uint32_t NestingLevel(uint32_t m) const { return Load(m).nestingLevel; }
+
+    void Get(uint32_t m, BreadcrumbsMarkerView& view) const
+    {
+        const BreadcrumbsBinaryMarker marker = Load(m);
+        view.type = (FfxBreadcrumbsMarkerType)marker.type;
+        view.nestingLevel = marker.nestingLevel;
+        view.status = marker.status;
+        breadcrumbsDecodeString(strings, stringsSize, marker.name, view.name);
+        view.hasPipeline = marker.pipeline != BREADCRUMBS_BINARY_NONE;
+        if (view.hasPipeline)
+        {
+            BreadcrumbsBinaryPipeline pipeline;
+            memcpy(&pipeline, pipelines + sizeof(BreadcrumbsBinaryPipeline) * marker.pipeline, sizeof(BreadcrumbsBinaryPipeline));
+            breadcrumbsDecodePipeline(pipeline, pipelineStrings, pipelineStringsSize, view.pipeline);
+        }
+    }
+};
+
+static FfxErrorCode breadcrumbsDecodeStatus(BreadcrumbsBinaryReader& reader, BreadcrumbsStatusWriter& writer)
+{
+    BreadcrumbsBinaryHeader header;
+    FFX_RETURN_ON_ERROR(reader.Read(header), FFX_ERROR_INVALID_SIZE);
+    FFX_RETURN_ON_ERROR(header.magic == BREADCRUMBS_BINARY_MAGIC, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(header.version == BREADCRUMBS_BINARY_VERSION, FFX_ERROR_INVALID_VERSION);
+
+    BreadcrumbsBinaryMarkers markers = {};
+    markers.pipelineCount = header.pipelineCount;
+    FFX_RETURN_ON_ERROR(header.pipelineCount <= (reader.size - reader.offset) / sizeof(BreadcrumbsBinaryPipeline), FFX_ERROR_INVALID_SIZE);
+    markers.pipelines = (const uint8_t*)reader.Take(sizeof(BreadcrumbsBinaryPipeline) * header.pipelineCount);
+    FFX_RETURN_ON_ERROR(markers.pipelines, FFX_ERROR_INVALID_SIZE);
+    FFX_RETURN_ON_ERROR(reader.ReadStrings(markers.pipelineStrings, markers.pipelineStringsSize), FFX_ERROR_INVALID_SIZE);
+    for (uint32_t p = 0; p < header.pipelineCount; ++p)
+    {
+        BreadcrumbsBinaryPipeline pipeline;
+        BreadcrumbsPipelineView view;
+        memcpy(&pipeline, markers.pipelines + sizeof(BreadcrumbsBinaryPipeline) * p, sizeof(BreadcrumbsBinaryPipeline));
+        FFX_RETURN_ON_ERROR(breadcrumbsDecodePipeline(pipeline, markers.pipelineStrings, markers.pipelineStringsSize, view), FFX_ERROR_INVALID_ARGUMENT);
+    }
+
+    uint32_t deviceInfoSize;
+    FFX_RETURN_ON_ERROR(reader.Read(deviceInfoSize), FFX_ERROR_INVALID_SIZE);
+    const void* deviceInfo = reader.Take(deviceInfoSize);
+    FFX_RETURN_ON_ERROR(deviceInfo, FFX_ERROR_INVALID_SIZE);
+    writer.Write(deviceInfo, deviceInfoSize);
+
+    FfxErrorCode errorCode = FFX_OK;
+    uint32_t frameCount;
+    FFX_RETURN_ON_ERROR(reader.Read(frameCount), FFX_ERROR_INVALID_SIZE);
+    writer.Literal("[BREADCRUMBS]\n");
+    for (uint32_t f = 0; f < frameCount; ++f)
+    {
+        BreadcrumbsBinaryFrame frame;
+        FFX_RETURN_ON_ERROR(reader.Read(frame), FFX_ERROR_INVALID_SIZE);
+        writer.Literal("<Frame ");
+        writer.Uint(frame.frameIndex);
+        writer.Literal(">\n");
+        if (frame.listCount == 0)
+        {
+            writer.Literal(" - No command lists\n");
+            continue;
+        }
+
+        for (uint32_t j = 0; j < frame.listCount; ++j)
+        {
+            BreadcrumbsBinaryList list;
+            FFX_RETURN_ON_ERROR(reader.Read(list), FFX_ERROR_INVALID_SIZE);
+            FFX_RETURN_ON_ERROR(list.markersCount <= (reader.size - reader.offset) / sizeof(BreadcrumbsBinaryMarker), FFX_ERROR_INVALID_SIZE);
+            markers.markers = (const uint8_t*)reader.Take(sizeof(BreadcrumbsBinaryMarker) * list.markersCount);
+            markers.markersCount = list.markersCount;
+            FFX_RETURN_ON_ERROR(markers.markers, FFX_ERROR_INVALID_SIZE);
+            FFX_RETURN_ON_ERROR(reader.ReadStrings(markers.strings, markers.stringsSize), FFX_ERROR_INVALID_SIZE);
+
+            const char* listName;
+            FFX_RETURN_ON_ERROR(breadcrumbsDecodeString(markers.strings, markers.stringsSize, list.name, listName), FFX_ERROR_INVALID_ARGUMENT);
+            FFX_RETURN_ON_ERROR(markers.Validate(), FFX_ERROR_INVALID_ARGUMENT);
+
+            breadcrumbsWriteListHeader(writer, list.status, list.queueType, list.submissionIndex, j + 1, listName);
+            if (breadcrumbsSkipList(header.flags, list.status, list.markersCount))
+                continue;
+            if (breadcrumbsWriteMarkerTree(writer, header.flags, markers))
+                errorCode = FFX_ERROR_OUT_OF_RANGE;
+        }
+    }
+    return errorCode;
+}
+
+FfxErrorCode ffxBreadcrumbsDecodeStatus(const void* pData, size_t dataSize, FfxBreadcrumbsStatusSink sink, void* pUserData)
+{
+    FFX_RETURN_ON_ERROR(pData, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(sink, FFX_ERROR_INVALID_POINTER);
+
+    BreadcrumbsBinaryReader reader = { (const uint8_t*)pData, dataSize, 0 };
+    BreadcrumbsStatusWriter writer;
+    writer.sink = sink;
+    writer.pUserData = pUserData;
+    writer.used = 0;
+
+    const FfxErrorCode errorCode = breadcrumbsDecodeStatus(reader, writer);
+    writer.Flush();
+    return errorCode;
+}
+
+typedef struct BreadcrumbsStatusBuffer {
+
+    FfxAllocationCallbacks*             allocs;
+    FfxBreadcrumbsMarkersStatus*        markersStatus;
+    size_t                              capacity;
+} BreadcrumbsStatusBuffer;
+
+static void breadcrumbsAppendStatus(void* pUserData, const void* pData, size_t size)
+{
+    BreadcrumbsStatusBuffer* buffer = (BreadcrumbsStatusBuffer*)pUserData;
+    FfxBreadcrumbsMarkersStatus* markersStatus = buffer->markersStatus;
+    if (markersStatus->bufferSize + size > buffer->capacity)
+    {
+        size_t newCapacity = buffer->capacity * 2;
+        if (newCapacity < markersStatus->bufferSize + size)
+            newCapacity = markersStatus->bufferSize + size;
+        markersStatus->pBuffer = (char*)ffxBreadcrumbsAppendList(markersStatus->pBuffer, buffer->capacity, 1, newCapacity - buffer->capacity, buffer->allocs);
+        buffer->capacity = newCapacity;
+    }
+    memcpy(markersStatus->pBuffer + markersStatus->bufferSize, pData, size);
+    markersStatus->bufferSize += size;
+}
+
+FfxErrorCode ffxBreadcrumbsPrintStatus(FfxBreadcrumbsContext* context, FfxBreadcrumbsMarkersStatus* markersStatus)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(markersStatus, FFX_ERROR_INVALID_POINTER);
+
+    FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
+    markersStatus->bufferSize = 0;
+    markersStatus->pBuffer = nullptr;
+
+    BreadcrumbsStatusBuffer buffer = { &contextPrivate->contextDescription.allocCallbacks, markersStatus, 0 };
+    return ffxBreadcrumbsWriteStatus(context, FFX_BREADCRUMBS_STATUS_FORMAT_TEXT, breadcrumbsAppendStatus, &buffer);
 }
 
 FFX_API FfxVersionNumber ffxBreadcrumbsGetEffectVersion()
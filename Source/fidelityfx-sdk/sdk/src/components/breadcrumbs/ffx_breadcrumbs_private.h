@@ -23,6 +23,37 @@
 #pragma once
 #include <FidelityFX/host/ffx_breadcrumbs.h>
 
+typedef struct BreadcrumbsHashEntry {
+
+    const void*                         key;
+    uint32_t                            index;
+    uint32_t                            generation;
+} BreadcrumbsHashEntry;
+
+// Open addressing map from command list or pipeline handle to index in the owning array.
+// Clearing only advances the generation, entries from older generations count as empty.
+typedef struct BreadcrumbsHashMap {
+
+    uint32_t                            capacity;
+    uint32_t                            count;
+    uint32_t                            generation;
+    BreadcrumbsHashEntry*               pEntries;
+} BreadcrumbsHashMap;
+
+typedef struct BreadcrumbsArenaChunk {
+
+    struct BreadcrumbsArenaChunk*       pNext;
+    size_t                              size;
+} BreadcrumbsArenaChunk;
+
+// Chunked allocator holding per frame marker data, chunks are kept and reused when the frame ring wraps around.
+typedef struct BreadcrumbsArena {
+
+    BreadcrumbsArenaChunk*              pFirstChunk;
+    BreadcrumbsArenaChunk*              pCurrentChunk;
+    size_t                              currentOffset;
+} BreadcrumbsArena;
+
 typedef struct BreadcrumbsBlockVector {
 
     size_t                              memoryBlocksCount;
@@ -62,20 +93,26 @@ typedef struct BreadcrumbsListData {
     BreadcrumbsCustomName               name;
     FfxPipeline                         currentPipeline;
     uint32_t                            markersCount;
+    uint32_t                            markersCapacity;
     BreadcrumbsMarkerData*              pMarkers;
     // Indices for ending markers.
     uint32_t                            currentStackCount;
+    uint32_t                            currentStackCapacity;
     uint32_t*                           pCurrentStack;
 } BreadcrumbsListData;
 
 typedef struct BreadcrumbsFrameData {
 
     size_t                              usedListsCount;
+    size_t                              usedListsCapacity;
     BreadcrumbsListData*                pUsedLists;
+    BreadcrumbsHashMap                  usedListsMap;
+    BreadcrumbsArena                    markersArena;
     BreadcrumbsBlockVector*             pBlockPerQueue;
     BreadcrumbsCustomNameBuffer         namesBuffer;
     FFX_MUTEX                           listMutex;
     FFX_MUTEX                           blockMutex;
+    FFX_MUTEX                           arenaMutex;
 } BreadcrumbsFrameData;
 
 typedef struct BreadcrumbsPipelineData {
@@ -102,6 +139,8 @@ typedef struct FfxBreadcrumbsContext_Private {
     FfxUInt32                           effectContextId;
     BreadcrumbsFrameData*               pFrameData;
     size_t                              registeredPipelinesCount;
+    size_t                              registeredPipelinesCapacity;
     BreadcrumbsPipelineData*            pRegisteredPipelines;
+    BreadcrumbsHashMap                  registeredPipelinesMap;
     BreadcrumbsCustomNameBuffer         pipelinesNamesBuffer;
 } FfxBreadcrumbsContext_Private;
@@ -27,6 +27,8 @@
 #include <math.h> // floorf
 #include <stdbool.h>
 
+#include "ffx_brixelizer_private.h"
+
 #define ifor(n) for (uint32_t i = 0; i < n; ++i)
 #define jfor(n) for (uint32_t j = 0; j < n; ++j)
 
@@ -47,63 +49,23 @@ static bool aabbsOverlap(FfxBrixelizerAABB x, FfxBrixelizerAABB y)
     return true;
 }
 
-typedef struct FfxBrixelizerBakedUpdateDescription_Private {
-    FfxBrixelizerResources                      resources;
-    FfxBrixelizerRawCascadeUpdateDescription    cascadeUpdateDesc;
-    FfxBrixelizerPopulateDebugAABBsFlags        populateDebugAABBsFlags;
-    FfxBrixelizerStats*                         outStats;
-    FfxBrixelizerDebugVisualizationDescription* debugVisualizationDesc;
-    uint32_t                            numStaticJobs;
-    FfxBrixelizerRawJobDescription                 staticJobs[3 * FFX_BRIXELIZER_MAX_INSTANCES];
-    uint32_t                            numDynamicJobs;
-    FfxBrixelizerRawJobDescription                 dynamicJobs[FFX_BRIXELIZER_MAX_INSTANCES];
-} FfxBrixelizerBakedUpdateDescription_Private;
+static FfxBrixelizerAABB aabbUnion(FfxBrixelizerAABB x, FfxBrixelizerAABB y)
+{
+    FfxBrixelizerAABB aabb = {};
+    ifor (3) {
+        aabb.min[i] = x.min[i] < y.min[i] ? x.min[i] : y.min[i];
+        aabb.max[i] = x.max[i] > y.max[i] ? x.max[i] : y.max[i];
+    }
+    return aabb;
+}
+
+static float aabbVolume(FfxBrixelizerAABB aabb)
+{
+    return (aabb.max[0] - aabb.min[0]) * (aabb.max[1] - aabb.min[1]) * (aabb.max[2] - aabb.min[2]);
+}
 
 FFX_STATIC_ASSERT(sizeof(FfxBrixelizerBakedUpdateDescription) == sizeof(FfxBrixelizerBakedUpdateDescription_Private));
 
-typedef struct FfxBrixelizerCascadePrivate {
-    FfxBrixelizerCascadeFlag flags;
-    float                    voxelSize;
-    uint32_t                 staticIndex;
-    uint32_t                 dynamicIndex;
-    uint32_t                 mergedIndex;
-} FfxBrixelizerCascadePrivate;
-
-typedef struct FfxBrixelizerInvalidation {
-    uint32_t          cascades;
-    FfxBrixelizerAABB aabb;
-} FfxBrixelizerInvalidation;
-
-typedef struct FfxBrixelizerInstance {
-    FfxBrixelizerInstanceID id;
-    FfxBrixelizerAABB       aabb;
-} FfxBrixelizerInstance;
-
-typedef struct FfxBrixelizerScratchSpace {
-    union {
-        struct {
-            FfxBrixelizerRawInstanceDescription rawInstanceDescs[FFX_BRIXELIZER_MAX_INSTANCES];
-            FfxBrixelizerInstanceID             instanceIDs[FFX_BRIXELIZER_MAX_INSTANCES];
-        } createInstances;
-        struct {
-            FfxBrixelizerInstanceID instanceIDs[FFX_BRIXELIZER_MAX_INSTANCES];
-        } update;
-    };
-} FfxBrixelizerScratchSpace;
-
-typedef struct FfxBrixelizerContext_Private {
-    FfxBrixelizerRawContext     context;
-    uint32_t                    numCascades;
-    FfxBrixelizerCascadePrivate cascades[FFX_BRIXELIZER_MAX_CASCADES];
-    uint32_t                    numInvalidations;
-    FfxBrixelizerInvalidation   invalidations[FFX_BRIXELIZER_MAX_INSTANCES];
-    uint32_t                    numStaticInstances;
-    uint32_t                    dynamicInstanceStartIndex;
-    uint32_t                    instanceIndices[FFX_BRIXELIZER_MAX_INSTANCES];
-    FfxBrixelizerInstance       instances[FFX_BRIXELIZER_MAX_INSTANCES];
-    FfxBrixelizerScratchSpace   scratchSpace;
-} FfxBrixelizerContext_Private;
-
 FFX_STATIC_ASSERT(sizeof(FfxBrixelizerContext) >= sizeof(FfxBrixelizerContext_Private));
 
 FfxErrorCode ffxBrixelizerContextCreate(const FfxBrixelizerContextDescription* desc, FfxBrixelizerContext* uncastOutContext)
@@ -325,7 +287,8 @@ FfxErrorCode ffxBrixelizerUpdate(FfxBrixelizerContext* uncastContext, FfxBrixeli
     FfxBrixelizerContext_Private *context = (FfxBrixelizerContext_Private*)uncastContext;
     FfxBrixelizerBakedUpdateDescription_Private *desc = (FfxBrixelizerBakedUpdateDescription_Private*)uncastDesc;
 
-    ffxBrixelizerRawContextFlushInstances(&context->context, commandList);
+    // Running out of upload space is reported after recording the rest of the update, failed uploads are retried next frame.
+    FfxErrorCode errorCode = ffxBrixelizerRawContextFlushInstances(&context->context, commandList);
 
     uint32_t cascadeIndex = desc->cascadeUpdateDesc.cascadeIndex;
     FfxBrixelizerCascadePrivate *cascadePrivate = &context->cascades[cascadeIndex];
@@ -345,7 +308,8 @@ FfxErrorCode ffxBrixelizerUpdate(FfxBrixelizerContext* uncastContext, FfxBrixeli
         desc->cascadeUpdateDesc.numJobs = desc->numStaticJobs;
         desc->cascadeUpdateDesc.jobs = desc->staticJobs;
         desc->cascadeUpdateDesc.flags = FFX_BRIXELIZER_CASCADE_UPDATE_FLAG_NONE;
-        ffxBrixelizerRawContextUpdateCascade(&context->context, &desc->cascadeUpdateDesc);
+        const FfxErrorCode updateErrorCode = ffxBrixelizerRawContextUpdateCascade(&context->context, &desc->cascadeUpdateDesc);
+        errorCode = errorCode == FFX_OK ? updateErrorCode : errorCode;
     }
 
     // update dynamic cascade
@@ -354,7 +318,8 @@ FfxErrorCode ffxBrixelizerUpdate(FfxBrixelizerContext* uncastContext, FfxBrixeli
         desc->cascadeUpdateDesc.numJobs = desc->numDynamicJobs;
         desc->cascadeUpdateDesc.jobs = desc->dynamicJobs;
         desc->cascadeUpdateDesc.flags = FFX_BRIXELIZER_CASCADE_UPDATE_FLAG_RESET;
-        ffxBrixelizerRawContextUpdateCascade(&context->context, &desc->cascadeUpdateDesc);
+        const FfxErrorCode updateErrorCode = ffxBrixelizerRawContextUpdateCascade(&context->context, &desc->cascadeUpdateDesc);
+        errorCode = errorCode == FFX_OK ? updateErrorCode : errorCode;
     }
 
 
@@ -430,7 +395,8 @@ FfxErrorCode ffxBrixelizerUpdate(FfxBrixelizerContext* uncastContext, FfxBrixeli
             }
         }
 
-        ffxBrixelizerRawContextDebugVisualization(&context->context, &debugVisDesc);
+        const FfxErrorCode debugErrorCode = ffxBrixelizerRawContextDebugVisualization(&context->context, &debugVisDesc);
+        errorCode = errorCode == FFX_OK ? debugErrorCode : errorCode;
     }
 
     ffxBrixelizerRawContextSubmit(&context->context, commandList);
@@ -477,7 +443,7 @@ FfxErrorCode ffxBrixelizerUpdate(FfxBrixelizerContext* uncastContext, FfxBrixeli
         }
     }
 
-    return FFX_OK;
+    return errorCode;
 }
 
 FfxErrorCode ffxBrixelizerRegisterBuffers(FfxBrixelizerContext* uncastContext, const FfxBrixelizerBufferDescription *bufferDescs, uint32_t numBufferDescs)
@@ -507,8 +473,25 @@ static void addInvalidationJob(FfxBrixelizerContext_Private* context, FfxBrixeli
     invalidation.cascades = cascadesMask;
     invalidation.aabb = aabb;
 
-    FFX_ASSERT(context->numInvalidations < FFX_ARRAY_ELEMENTS(context->invalidations));
-    context->invalidations[context->numInvalidations++] = invalidation;
+    if (context->numInvalidations < FFX_ARRAY_ELEMENTS(context->invalidations)) {
+        context->invalidations[context->numInvalidations++] = invalidation;
+        return;
+    }
+
+    // Full, grow the recent invalidation that grows the least to also cover this one. Invalidating more
+    // than needed only costs rebuilding extra bricks, while dropping an invalidation leaves stale ones.
+    FfxBrixelizerInvalidation *merge = NULL;
+    float mergeGrowth = FLT_MAX;
+    for (uint32_t i = context->numInvalidations - FFX_BRIXELIZER_INVALIDATION_MERGE_WINDOW; i < context->numInvalidations; ++i) {
+        FfxBrixelizerInvalidation *candidate = &context->invalidations[i];
+        float growth = aabbVolume(aabbUnion(candidate->aabb, aabb)) - aabbVolume(candidate->aabb);
+        if (growth < mergeGrowth) {
+            merge = candidate;
+            mergeGrowth = growth;
+        }
+    }
+    merge->cascades |= invalidation.cascades;
+    merge->aabb = aabbUnion(merge->aabb, aabb);
 }
 
 FfxErrorCode ffxBrixelizerCreateInstances(FfxBrixelizerContext* uncastContext, const FfxBrixelizerInstanceDescription* descs, uint32_t numDescs)
@@ -601,6 +584,62 @@ FfxErrorCode ffxBrixelizerDeleteInstances(FfxBrixelizerContext* uncastContext, c
     return FFX_OK;
 }
 
+FfxErrorCode ffxBrixelizerUpdateInstanceTransforms(FfxBrixelizerContext* uncastContext, const FfxBrixelizerInstanceTransformUpdate* updates, uint32_t numUpdates)
+{
+    FfxBrixelizerContext_Private *context = (FfxBrixelizerContext_Private*)uncastContext;
+
+    FFX_RETURN_ON_ERROR(numUpdates <= FFX_BRIXELIZER_MAX_INSTANCES, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(updates || numUpdates == 0, FFX_ERROR_INVALID_POINTER);
+
+    FfxBrixelizerRawInstanceTransformUpdate *rawUpdates = context->scratchSpace.updateTransforms.rawUpdates;
+    bool *changed = context->scratchSpace.updateTransforms.changed;
+
+    ifor (numUpdates) {
+        const FfxBrixelizerInstanceTransformUpdate *update = &updates[i];
+
+        // Only static instances persist between updates, dynamic ones are resubmitted every frame.
+        // Indices of destroyed instances are stale, so the instance slot has to point back at the same ID.
+        if (update->instanceID >= FFX_BRIXELIZER_MAX_INSTANCES) {
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+        uint32_t index = context->instanceIndices[update->instanceID];
+        if (index >= context->numStaticInstances || context->instances[index].id != update->instanceID) {
+            return FFX_ERROR_INVALID_ARGUMENT;
+        }
+
+        FfxBrixelizerRawInstanceTransformUpdate *rawUpdate = &rawUpdates[i];
+        rawUpdate->instanceID = update->instanceID;
+        jfor (3) {
+            rawUpdate->aabbMin[j] = update->aabb.min[j];
+            rawUpdate->aabbMax[j] = update->aabb.max[j];
+        }
+        memcpy(&rawUpdate->transform, &update->transform, sizeof(rawUpdate->transform));
+    }
+
+    RETURN_ON_FAIL(ffxBrixelizerRawContextUpdateInstanceTransforms(&context->context, rawUpdates, numUpdates, changed));
+
+    ifor (numUpdates) {
+        if (!changed[i]) {
+            continue;
+        }
+
+        const FfxBrixelizerInstanceTransformUpdate *update = &updates[i];
+        FfxBrixelizerInstance *instance = &context->instances[context->instanceIndices[update->instanceID]];
+
+        // Small moves keep overlapping the previous placement, a single invalidation of both covers it.
+        if (aabbsOverlap(instance->aabb, update->aabb)) {
+            addInvalidationJob(context, aabbUnion(instance->aabb, update->aabb));
+        } else {
+            addInvalidationJob(context, instance->aabb);
+            addInvalidationJob(context, update->aabb);
+        }
+
+        instance->aabb = update->aabb;
+    }
+
+    return FFX_OK;
+}
+
 FfxErrorCode ffxBrixelizerGetContextInfo(FfxBrixelizerContext* uncastContext, FfxBrixelizerContextInfo* contextInfo)
 {
     FfxBrixelizerContext_Private *context = (FfxBrixelizerContext_Private*)uncastContext;
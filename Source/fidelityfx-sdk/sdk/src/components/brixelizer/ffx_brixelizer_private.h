@@ -0,0 +1,88 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <FidelityFX/host/ffx_brixelizer.h>
+
+typedef struct FfxBrixelizerBakedUpdateDescription_Private {
+    FfxBrixelizerResources                      resources;
+    FfxBrixelizerRawCascadeUpdateDescription    cascadeUpdateDesc;
+    FfxBrixelizerPopulateDebugAABBsFlags        populateDebugAABBsFlags;
+    FfxBrixelizerStats*                         outStats;
+    FfxBrixelizerDebugVisualizationDescription* debugVisualizationDesc;
+    uint32_t                            numStaticJobs;
+    FfxBrixelizerRawJobDescription                 staticJobs[3 * FFX_BRIXELIZER_MAX_INSTANCES];
+    uint32_t                            numDynamicJobs;
+    FfxBrixelizerRawJobDescription                 dynamicJobs[FFX_BRIXELIZER_MAX_INSTANCES];
+} FfxBrixelizerBakedUpdateDescription_Private;
+
+typedef struct FfxBrixelizerCascadePrivate {
+    FfxBrixelizerCascadeFlag flags;
+    float                    voxelSize;
+    uint32_t                 staticIndex;
+    uint32_t                 dynamicIndex;
+    uint32_t                 mergedIndex;
+} FfxBrixelizerCascadePrivate;
+
+// Once all invalidation slots are in use new invalidations are merged into one of this many most recent ones.
+#define FFX_BRIXELIZER_INVALIDATION_MERGE_WINDOW 64
+
+// An area of the static cascades to rebuild, each cascade clears its bit once it took it.
+typedef struct FfxBrixelizerInvalidation {
+    uint32_t          cascades;
+    FfxBrixelizerAABB aabb;
+} FfxBrixelizerInvalidation;
+
+typedef struct FfxBrixelizerInstance {
+    FfxBrixelizerInstanceID id;
+    FfxBrixelizerAABB       aabb;
+} FfxBrixelizerInstance;
+
+typedef struct FfxBrixelizerScratchSpace {
+    union {
+        struct {
+            FfxBrixelizerRawInstanceDescription rawInstanceDescs[FFX_BRIXELIZER_MAX_INSTANCES];
+            FfxBrixelizerInstanceID             instanceIDs[FFX_BRIXELIZER_MAX_INSTANCES];
+        } createInstances;
+        struct {
+            FfxBrixelizerInstanceID instanceIDs[FFX_BRIXELIZER_MAX_INSTANCES];
+        } update;
+        struct {
+            FfxBrixelizerRawInstanceTransformUpdate rawUpdates[FFX_BRIXELIZER_MAX_INSTANCES];
+            bool                                    changed[FFX_BRIXELIZER_MAX_INSTANCES];
+        } updateTransforms;
+    };
+} FfxBrixelizerScratchSpace;
+
+typedef struct FfxBrixelizerContext_Private {
+    FfxBrixelizerRawContext     context;
+    uint32_t                    numCascades;
+    FfxBrixelizerCascadePrivate cascades[FFX_BRIXELIZER_MAX_CASCADES];
+    uint32_t                    numInvalidations;
+    FfxBrixelizerInvalidation   invalidations[FFX_BRIXELIZER_MAX_INSTANCES];
+    uint32_t                    numStaticInstances;
+    uint32_t                    dynamicInstanceStartIndex;
+    uint32_t                    instanceIndices[FFX_BRIXELIZER_MAX_INSTANCES];
+    FfxBrixelizerInstance       instances[FFX_BRIXELIZER_MAX_INSTANCES];
+    FfxBrixelizerScratchSpace   scratchSpace;
+} FfxBrixelizerContext_Private;
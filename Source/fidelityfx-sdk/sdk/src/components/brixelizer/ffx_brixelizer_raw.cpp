@@ -804,20 +804,26 @@ static size_t getScratchMemorySize(FfxBrixelizerRawContext_Private*
     return getTotalScratchMemorySize(&scratchPartition);
 }
 
-static FfxBrixelizerInstanceID popBackHostNewInstanceList(FfxBrixelizerRawContext_Private* context)
+static void markHostInstanceDirty(uint32_t* dirtyBits, FfxBrixelizerInstanceID instanceID)
 {
-    if (context->hostNewInstanceListSize > 0)
-    {
-        context->hostNewInstanceListSize--;
-        return context->hostNewInstanceList[context->hostNewInstanceListSize];
-    }
-    else
-        return FFX_BRIXELIZER_INVALID_ID;
+    dirtyBits[instanceID / 32] |= 1u << (instanceID % 32);
+}
+
+static bool isHostInstanceDirty(const uint32_t* dirtyBits, FfxBrixelizerInstanceID instanceID)
+{
+    return (dirtyBits[instanceID / 32] >> (instanceID % 32)) & 1u;
+}
+
+static bool isHostInstanceLive(const FfxBrixelizerRawContext_Private* context, FfxBrixelizerInstanceID instanceID)
+{
+    return instanceID < FFX_BRIXELIZER_MAX_INSTANCES && ((context->hostLiveInstances[instanceID / 32] >> (instanceID % 32)) & 1u);
 }
 
-static void clearHostNewInstanceList(FfxBrixelizerRawContext_Private* context)
+static void clearHostDirtyInstances(FfxBrixelizerRawContext_Private* context)
 {
-    context->hostNewInstanceListSize = 0;
+    memset(context->hostDirtyInstanceInfos, 0, sizeof(context->hostDirtyInstanceInfos));
+    memset(context->hostDirtyTransforms, 0, sizeof(context->hostDirtyTransforms));
+    context->hostNumDirtyInstances = 0;
 }
 
 static FfxBrixelizerInstanceInfo* getFlatInstancePtr(FfxBrixelizerRawContext_Private* context)
@@ -830,32 +836,61 @@ static FfxFloat32x3x4* getFlatTransformPtr(FfxBrixelizerRawContext_Private* cont
     return &context->hostTransforms[0];
 }
 
-static uint32_t copyToUploadBuffer(FfxBrixelizerRawContext_Private* context, uint32_t id, void* data, size_t size, size_t alignedSize = 0)
+// Returns nullptr when the buffer has no room left that is not still read by in-flight frames.
+static uint8_t* allocateUploadBuffer(FfxBrixelizerRawContext_Private* context, uint32_t id, size_t size, size_t alignedSize, uint32_t* outOffset)
 {
-    if (id >= FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_INFO_BUFFER)
+    uint32_t stagingId = getUploadBufferID(id);
+    uint32_t offset    = context->uploadBufferOffsets[stagingId];
+    uint32_t totalSize = context->uploadBufferSizes[stagingId];
+    uint32_t* frameUsage = &context->uploadBufferFrameUsage[context->frameIndex % FFX_BRIXELIZER_NUM_IN_FLIGHT_FRAMES][stagingId];
+    uint32_t allocSize = (uint32_t)(alignedSize == 0 ? size : alignedSize);
+
+    if (size > totalSize)
+        return nullptr;
+
+    // If there's not enough space, wrap the offset back to the beginning. Skipped tail is accounted to the current frame.
+    uint32_t skippedSize = 0;
+    if ((totalSize - offset) < size)
     {
-        uint32_t stagingId = getUploadBufferID(id);
-        uint8_t* ptr       = context->uploadBufferMappedPointers[stagingId];
-        uint32_t offset    = context->uploadBufferOffsets[stagingId];
-        uint32_t totalSize = context->uploadBufferSizes[stagingId];
+        skippedSize = totalSize - offset;
+        offset      = 0;
+    }
 
-        // If there's not enough space, wrap the offset back to the beginning.
-        if ((totalSize - offset) < size)
-        {
-            context->uploadBufferOffsets[stagingId] = 0;
-            offset                                  = 0;
-        }
+    // Upload buffers are sized for FFX_BRIXELIZER_NUM_IN_FLIGHT_FRAMES frames, make sure data still read by previous frames is not overwritten.
+    // Alignment padding may run past the end, clamp so the next allocation wraps.
+    uint32_t usedSize = ffxMin(allocSize, totalSize - offset);
+    uint32_t inFlightUsage = skippedSize;
+    for (uint32_t i = 0; i < FFX_BRIXELIZER_NUM_IN_FLIGHT_FRAMES; ++i) {
+        inFlightUsage += context->uploadBufferFrameUsage[i][stagingId];
+    }
+    if (inFlightUsage + usedSize > totalSize)
+        return nullptr;
 
-        ptr += offset;
+    *frameUsage += skippedSize + usedSize;
+    context->uploadBufferOffsets[stagingId] = offset + usedSize;
 
-        memcpy(ptr, data, size);
+    *outOffset = offset;
+    return context->uploadBufferMappedPointers[stagingId] + offset;
+}
 
-        context->uploadBufferOffsets[stagingId] += alignedSize == 0 ? size : alignedSize;
+static FfxErrorCode copyToUploadBuffer(FfxBrixelizerRawContext_Private* context, uint32_t id, void* data, size_t size, uint32_t* outOffset, size_t alignedSize = 0)
+{
+    *outOffset = 0;
+    if (id >= FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_INFO_BUFFER)
+    {
+        uint8_t* ptr = allocateUploadBuffer(context, id, size, alignedSize, outOffset);
+        FFX_RETURN_ON_ERROR(ptr, FFX_ERROR_INSUFFICIENT_MEMORY);
 
-        return offset;
+        memcpy(ptr, data, size);
     }
-    else
-        return 0;
+    return FFX_OK;
+}
+
+// Frame has left flight, so its part of every upload buffer can be reused.
+static void retireUploadBufferFrame(FfxBrixelizerRawContext_Private* context)
+{
+    uint32_t* frameUsage = context->uploadBufferFrameUsage[context->frameIndex % FFX_BRIXELIZER_NUM_IN_FLIGHT_FRAMES];
+    memset(frameUsage, 0, sizeof(context->uploadBufferFrameUsage[0]));
 }
 
 static void updateConstantBuffer(FfxBrixelizerRawContext_Private* context, uint32_t id, void* data)
@@ -902,7 +937,7 @@ static FfxErrorCode brixelizerCreate(FfxBrixelizerRawContext_Private* context, c
     context->doInit                  = true;
     context->numInstances            = 0;
     context->hostFreelistSize        = FFX_BRIXELIZER_MAX_INSTANCES;
-    context->hostNewInstanceListSize = 0;
+    context->hostNumDirtyInstances   = 0;
     context->bufferIndexFreeListSize = FFX_BRIXELIZER_MAX_INSTANCES;
 
     // Fill out Instance ID freelist.
@@ -1280,6 +1315,7 @@ static FfxErrorCode brixelizerDispatchBegin(FfxBrixelizerRawContext_Private* con
     }
  
     context->frameIndex += 1;
+    retireUploadBufferFrame(context);
 
     FfxBrixelizerContextInfo contextInfo = getContextInfo(context);
 
@@ -1365,6 +1401,7 @@ static FfxErrorCode brixelizerDispatchUpdateCascade(FfxBrixelizerRawContext_Priv
 {
     FfxBrixelizerCascade_Private* cascade     = (FfxBrixelizerCascade_Private*)&context->cascades[desc->cascadeIndex];
     FfxBrixelizerContextInfo      contextinfo = getContextInfo(context);
+    const FfxBrixelizerCascadeInfo previousCascadeInfo = cascade->info;
 
     {  
         // Update cascade parameters
@@ -1464,10 +1501,19 @@ static FfxErrorCode brixelizerDispatchUpdateCascade(FfxBrixelizerRawContext_Priv
     }
 
     uint32_t jobBufferSize   = (numJobs ? numJobs : 1) * sizeof(FfxBrixelizerBrixelizationJob);
-    uint32_t jobBufferOffset = copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_BUFFER, &context->jobs[0], jobBufferSize, alignUp(jobBufferSize));
-
     uint32_t jobIndexBufferSize = (numJobs ? numJobs : 1) * sizeof(uint32_t);
-    uint32_t jobIndexBufferOffset = copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_INDEX_BUFFER, &context->indexOffsets[0], jobIndexBufferSize, alignUp(jobIndexBufferSize));
+    uint32_t jobBufferOffset = 0;
+    uint32_t jobIndexBufferOffset = 0;
+
+    // Too many jobs for the upload space not read by in-flight frames, keep the cascade as it was so the update can be retried.
+    FfxErrorCode errorCode = copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_BUFFER, &context->jobs[0], jobBufferSize, &jobBufferOffset, alignUp(jobBufferSize));
+    if (errorCode == FFX_OK)
+        errorCode = copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_INDEX_BUFFER, &context->indexOffsets[0], jobIndexBufferSize, &jobIndexBufferOffset, alignUp(jobIndexBufferSize));
+    if (errorCode != FFX_OK)
+    {
+        cascade->info = previousCascadeInfo;
+        return errorCode;
+    }
 
     setSRVBindingInfo(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_BUFFER, jobBufferOffset, jobBufferSize, sizeof(FfxBrixelizerBrixelizationJob));
     setSRVBindingInfo(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_INDEX_BUFFER, jobIndexBufferOffset, jobIndexBufferSize, sizeof(uint32_t));
@@ -1642,7 +1688,8 @@ static FfxErrorCode brixelizerDispatchDebugVisualization(FfxBrixelizerRawContext
             updateConstantBuffer(context, FFX_BRIXELIZER_CONSTANTBUFFER_IDENTIFIER_DEBUG_INFO, &debugInfo);
 
             size_t instanceIDBufferSize = debugVisualizationDescription->numDebugAABBInstanceIDs * sizeof(FfxBrixelizerInstanceID);
-            uint32_t offset = copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_DEBUG_INSTANCE_ID_BUFFER, (void*)debugVisualizationDescription->debugAABBInstanceIDs, instanceIDBufferSize);
+            uint32_t offset = 0;
+            FFX_VALIDATE(copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_DEBUG_INSTANCE_ID_BUFFER, (void*)debugVisualizationDescription->debugAABBInstanceIDs, instanceIDBufferSize, &offset));
 
             setSRVBindingInfo(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_DEBUG_INSTANCE_ID_BUFFER, offset, instanceIDBufferSize, sizeof(FfxBrixelizerInstanceID));
 
@@ -1692,42 +1739,76 @@ static FfxErrorCode brixelizerDispatchDebugVisualization(FfxBrixelizerRawContext
     return FFX_OK;
 }
 
-static void brixelizerFlushInstances(FfxBrixelizerRawContext_Private* context, FfxCommandList cmdList)
+// Copy jobs issued by a single flush before executing them, leaves room for jobs already scheduled by the caller.
+#define FFX_BRIXELIZER_MAX_INSTANCE_COPY_JOBS (FFX_MAX_GPU_JOBS / 2)
+
+// Uploads contiguous ranges of dirty instances from a host array to the matching GPU buffer.
+static FfxErrorCode flushDirtyInstanceRanges(FfxBrixelizerRawContext_Private* context, FfxCommandList cmdList, const uint32_t* dirtyBits, const void* hostData, uint32_t elementSize,
+                                     uint32_t uploadBufferID, uint32_t bufferID, const wchar_t* name, uint32_t* numCopyJobs)
 {
-    for (uint32_t i = 0; i < context->hostNewInstanceListSize; i++)
+    uint32_t instanceID = 0;
+    while (instanceID < FFX_BRIXELIZER_MAX_INSTANCES)
     {
-        FfxBrixelizerInstanceID idx = context->hostNewInstanceList[i];
-
-        FfxBrixelizerInstanceInfo instanceInfo = getFlatInstancePtr(context)[idx];
-        FfxFloat32x3x4 transform;
-        memcpy(&transform, getFlatTransformPtr(context) + idx, sizeof(transform));
+        uint32_t bits = dirtyBits[instanceID / 32] >> (instanceID % 32);
+        if (bits == 0) {
+            instanceID = (instanceID / 32 + 1) * 32;
+            continue;
+        }
+        while ((bits & 1u) == 0) {
+            bits >>= 1;
+            ++instanceID;
+        }
 
-        // Copy into mapped pointer of staging buffer
-        uint32_t instanceInfoOffset =
-            copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_INFO_BUFFER, &instanceInfo, sizeof(instanceInfo));
-        uint32_t instanceTransformOffset =
-            copyToUploadBuffer(context, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_TRANSFORM_BUFFER, &transform, sizeof(transform));
+        FfxBrixelizerInstanceID firstIdx = instanceID;
+        while (instanceID < FFX_BRIXELIZER_MAX_INSTANCES && isHostInstanceDirty(dirtyBits, instanceID))
+            ++instanceID;
+        uint32_t numInRange = instanceID - firstIdx;
 
-        scheduleCopy(context,
-                     context->resources[FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_INFO_BUFFER],
-                     instanceInfoOffset,
-                     context->resources[FFX_BRIXELIZER_RESOURCE_IDENTIFIER_INSTANCE_INFO_BUFFER],
-                     idx * sizeof(FfxBrixelizerInstanceInfo),
-                     sizeof(FfxBrixelizerInstanceInfo),
-                     L"Instance Info");
+        // Host arrays are indexed by instance ID, so whole range is staged as a single packed block.
+        uint32_t uploadOffset = 0;
+        FFX_VALIDATE(copyToUploadBuffer(context, uploadBufferID, (uint8_t*)hostData + firstIdx * elementSize, numInRange * elementSize, &uploadOffset));
 
         scheduleCopy(context,
-                     context->resources[FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_TRANSFORM_BUFFER],
-                     instanceTransformOffset,
-                     context->resources[FFX_BRIXELIZER_RESOURCE_IDENTIFIER_INSTANCE_TRANSFORM_BUFFER],
-                     idx * sizeof(FfxFloat32x3x4),
-                     sizeof(FfxFloat32x3x4),
-                     L"Instance Transform");
+                     context->resources[uploadBufferID],
+                     uploadOffset,
+                     context->resources[bufferID],
+                     firstIdx * elementSize,
+                     numInRange * elementSize,
+                     name);
+
+        // Heavily fragmented ranges may exceed backend job capacity, execute what has been scheduled so far.
+        if (++*numCopyJobs >= FFX_BRIXELIZER_MAX_INSTANCE_COPY_JOBS)
+        {
+            context->contextDescription.backendInterface.fpExecuteGpuJobs(&context->contextDescription.backendInterface, cmdList, context->effectContextId);
+            *numCopyJobs = 0;
+        }
+    }
+    return FFX_OK;
+}
 
+static FfxErrorCode brixelizerFlushInstances(FfxBrixelizerRawContext_Private* context, FfxCommandList cmdList)
+{
+    if (context->hostNumDirtyInstances == 0)
+        return FFX_OK;
+
+    // Walking the dirty bitsets yields sorted IDs, so instances allocated together from the freelist
+    // or updated together form contiguous ranges. Instances marked several times are uploaded once.
+    uint32_t numCopyJobs = 0;
+    FfxErrorCode errorCode = flushDirtyInstanceRanges(context, cmdList, context->hostDirtyInstanceInfos, getFlatInstancePtr(context), sizeof(FfxBrixelizerInstanceInfo),
+                             FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_INFO_BUFFER, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_INSTANCE_INFO_BUFFER, L"Instance Info", &numCopyJobs);
+    if (errorCode == FFX_OK)
+        errorCode = flushDirtyInstanceRanges(context, cmdList, context->hostDirtyTransforms, getFlatTransformPtr(context), sizeof(FfxFloat32x3x4),
+                             FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_INSTANCE_TRANSFORM_BUFFER, FFX_BRIXELIZER_RESOURCE_IDENTIFIER_INSTANCE_TRANSFORM_BUFFER, L"Instance Transform", &numCopyJobs);
+
+    // Copies staged before running out of upload space are valid, execute them either way.
+    if (numCopyJobs)
         context->contextDescription.backendInterface.fpExecuteGpuJobs(&context->contextDescription.backendInterface, cmdList, context->effectContextId);
-    }
 
-    clearHostNewInstanceList(context);
+    // On failure instances stay dirty and are uploaded again by the next flush, once in-flight frames released their upload space.
+    if (errorCode == FFX_OK)
+        clearHostDirtyInstances(context);
+
+    return errorCode;
 }
 
 FfxErrorCode ffxBrixelizerRawContextCreate(FfxBrixelizerRawContext* context, const FfxBrixelizerRawContextDescription* contextDescription)
@@ -2021,8 +2102,7 @@ FfxErrorCode ffxBrixelizerRawContextCreateInstances(FfxBrixelizerRawContext* unc
 
     context->hostFreelistSize -= numInstanceDescriptions;
     FfxBrixelizerInstanceID *instanceIDs = &context->hostFreelist[context->hostFreelistSize];
-    memcpy(&context->hostNewInstanceList[context->hostNewInstanceListSize], instanceIDs, sizeof(*instanceIDs) * numInstanceDescriptions);
-    context->hostNewInstanceListSize += numInstanceDescriptions;
+    context->hostNumDirtyInstances += numInstanceDescriptions;
     context->numInstances += numInstanceDescriptions;
 
     for (uint32_t i = 0; i < numInstanceDescriptions; ++i) {
@@ -2062,6 +2142,10 @@ FfxErrorCode ffxBrixelizerRawContextCreateInstances(FfxBrixelizerRawContext* unc
 
         memcpy(transform, &desc->transform, sizeof(*transform));
 
+        markHostInstanceDirty(context->hostDirtyInstanceInfos, instanceID);
+        markHostInstanceDirty(context->hostDirtyTransforms, instanceID);
+        context->hostLiveInstances[instanceID / 32] |= 1u << (instanceID % 32);
+
         *desc->outInstanceID = instanceID;
     }
 
@@ -2077,6 +2161,8 @@ FfxErrorCode ffxBrixelizerRawContextDestroyInstances(FfxBrixelizerRawContext* un
     FFX_ASSERT(context->numInstances >= numInstanceIDs);
     for (uint32_t i = 0; i < numInstanceIDs; ++i) {
         FFX_ASSERT(instanceIDs[i] != FFX_BRIXELIZER_INVALID_ID);
+        if (instanceIDs[i] < FFX_BRIXELIZER_MAX_INSTANCES)
+            context->hostLiveInstances[instanceIDs[i] / 32] &= ~(1u << (instanceIDs[i] % 32));
     }
 
     memcpy(&context->hostFreelist[context->hostFreelistSize], instanceIDs, sizeof(*instanceIDs) * numInstanceIDs);
@@ -2086,15 +2172,62 @@ FfxErrorCode ffxBrixelizerRawContextDestroyInstances(FfxBrixelizerRawContext* un
     return FFX_OK;
 }
 
+FfxErrorCode ffxBrixelizerRawContextUpdateInstanceTransforms(FfxBrixelizerRawContext* uncastContext, const FfxBrixelizerRawInstanceTransformUpdate* updates, uint32_t numUpdates, bool* outChanged)
+{
+    FFX_RETURN_ON_ERROR(uncastContext, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(updates || numUpdates == 0, FFX_ERROR_INVALID_POINTER);
+
+    FfxBrixelizerRawContext_Private* context = (FfxBrixelizerRawContext_Private*)(uncastContext);
+
+    // Validate everything first so a bad entry leaves all instances untouched.
+    for (uint32_t i = 0; i < numUpdates; ++i) {
+        const FfxBrixelizerRawInstanceTransformUpdate *update = &updates[i];
+        FFX_RETURN_ON_ERROR(isHostInstanceLive(context, update->instanceID), FFX_ERROR_INVALID_ARGUMENT);
+        FFX_RETURN_ON_ERROR(update->aabbMax[0] >= update->aabbMin[0] && update->aabbMax[1] >= update->aabbMin[1] && update->aabbMax[2] >= update->aabbMin[2], FFX_ERROR_INVALID_ARGUMENT);
+    }
+
+    uint32_t numChanged = 0;
+    for (uint32_t i = 0; i < numUpdates; ++i) {
+        const FfxBrixelizerRawInstanceTransformUpdate *update = &updates[i];
+
+        FfxBrixelizerInstanceInfo *instanceInfo = &context->hostInstances[update->instanceID];
+        FfxFloat32x3x4 *transform = &context->hostTransforms[update->instanceID];
+        bool changed = false;
+
+        // AABB lives in the instance info, keep it clean when only the transform moved within the same bounds.
+        if (memcmp(instanceInfo->aabbMin, update->aabbMin, sizeof(update->aabbMin)) || memcmp(instanceInfo->aabbMax, update->aabbMax, sizeof(update->aabbMax))) {
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                instanceInfo->aabbMin[j] = update->aabbMin[j];
+                instanceInfo->aabbMax[j] = update->aabbMax[j];
+            }
+            markHostInstanceDirty(context->hostDirtyInstanceInfos, update->instanceID);
+            changed = true;
+        }
+
+        if (memcmp(transform, &update->transform, sizeof(*transform))) {
+            memcpy(transform, &update->transform, sizeof(*transform));
+            markHostInstanceDirty(context->hostDirtyTransforms, update->instanceID);
+            changed = true;
+        }
+
+        numChanged += changed ? 1 : 0;
+        if (outChanged)
+            outChanged[i] = changed;
+    }
+
+    context->hostNumDirtyInstances += numChanged;
+
+    return FFX_OK;
+}
+
 FfxErrorCode ffxBrixelizerRawContextFlushInstances(FfxBrixelizerRawContext* context, FfxCommandList cmdList)
 {
     FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
 
     FfxBrixelizerRawContext_Private* contextPrivate = (FfxBrixelizerRawContext_Private*)(context);
 
-    brixelizerFlushInstances(contextPrivate, cmdList);
-
-    return FFX_OK;
+    return brixelizerFlushInstances(contextPrivate, cmdList);
 }
 
 FfxErrorCode ffxBrixelizerRawContextRegisterBuffers(FfxBrixelizerRawContext* uncastContext, const FfxBrixelizerBufferDescription* bufferDescs, uint32_t numBufferDescs)
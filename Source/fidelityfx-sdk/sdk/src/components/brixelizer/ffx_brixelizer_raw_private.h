@@ -177,6 +177,7 @@ typedef struct FfxBrixelizerRawContext_Private
     uint8_t*                uploadBufferMappedPointers[FFX_BRIXELIZER_NUM_UPLOAD_BUFFERS];
     uint32_t                uploadBufferOffsets[FFX_BRIXELIZER_NUM_UPLOAD_BUFFERS];
     uint32_t                uploadBufferSizes[FFX_BRIXELIZER_NUM_UPLOAD_BUFFERS];
+    uint32_t                uploadBufferFrameUsage[FFX_BRIXELIZER_NUM_IN_FLIGHT_FRAMES][FFX_BRIXELIZER_NUM_UPLOAD_BUFFERS];
     void*                   cascadeReadbackBufferMappedPointers[FFX_BRIXELIZER_MAX_CASCADES * 3];
     uint8_t*                readbackBufferMappedPointers[3];
     uint32_t                totalBricks;
@@ -191,8 +192,10 @@ typedef struct FfxBrixelizerRawContext_Private
     FfxFloat32x3x4                  hostTransforms[FFX_BRIXELIZER_MAX_INSTANCES];
     FfxBrixelizerInstanceID         hostFreelist[FFX_BRIXELIZER_MAX_INSTANCES];
     uint32_t                hostFreelistSize;
-    FfxBrixelizerInstanceID         hostNewInstanceList[FFX_BRIXELIZER_MAX_INSTANCES];
-    uint32_t                hostNewInstanceListSize;
+    uint32_t                        hostLiveInstances[FFX_BRIXELIZER_MAX_INSTANCES / 32];
+    uint32_t                        hostDirtyInstanceInfos[FFX_BRIXELIZER_MAX_INSTANCES / 32];
+    uint32_t                        hostDirtyTransforms[FFX_BRIXELIZER_MAX_INSTANCES / 32];
+    uint32_t                        hostNumDirtyInstances;
     uint32_t                        bufferIndexFreeList[FFX_BRIXELIZER_MAX_INSTANCES];
     uint32_t                        bufferIndexFreeListSize;
     uint32_t                refCount;
@@ -836,6 +836,12 @@ FFX_API FfxErrorCode ffxFrameInterpolationPrepare(FfxFrameInterpolationContext*
         sizeof(contextPrivate->constants),
         &contextPrivate->constantBuffers[FFX_FRAMEINTERPOLATION_CONSTANTBUFFER_IDENTIFIER]);
 
+    // dilated depth, dilated motion vectors and reconstructed previous depth are already up to date
+    if (params->flags & FFX_FRAMEINTERPOLATION_PREPARE_SKIP_RECONSTRUCT)
+    {
+        return FFX_OK;
+    }
+
     FFX_ASSERT(!ffxFrameInterpolationResourceIsNull(params->depth));
     FFX_ASSERT(!ffxFrameInterpolationResourceIsNull(params->motionVectors));
 
@@ -29,19 +29,6 @@
 
 #define FFX_CPU
 #include <FidelityFX/gpu/ffx_core.h>
-
-static float    fs2S;
-static float    hdr10S;
-static uint32_t ctl[24 * 4];
-
-static void LpmSetupOut(uint32_t i, uint32_t* v)
-{
-    for (int j = 0; j < 4; ++j)
-    {
-        ctl[i * 4 + j] = v[j];
-    }
-}
-#include <FidelityFX/gpu/lpm/ffx_lpm.h>
 #include <ffx_object_management.h>
 
 #include "ffx_lpm_private.h"
@@ -234,308 +221,20 @@ static FfxErrorCode lpmDispatch(FfxLpmContext_Private* context, const FfxLpmDisp
     int dispatchX = FFX_DIVIDE_ROUNDING_UP(desc.width, threadGroupWorkRegionDim);
     int dispatchY = FFX_DIVIDE_ROUNDING_UP(desc.height, threadGroupWorkRegionDim);
 
-    FfxFloat32x2 fs2R;
-    FfxFloat32x2 fs2G;
-    FfxFloat32x2 fs2B;
-    FfxFloat32x2 fs2W;
-    FfxFloat32x2 displayMinMaxLuminance;
-    if (params->displayMode != FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR)
-    {
-        // Only used in fs2 modes
-        fs2R[0] = params->displayRedPrimary[0];
-        fs2R[1] = params->displayRedPrimary[1];
-        fs2G[0] = params->displayGreenPrimary[0];
-        fs2G[1] = params->displayGreenPrimary[1];
-        fs2B[0] = params->displayBluePrimary[0];
-        fs2B[1] = params->displayBluePrimary[1];
-        fs2W[0] = params->displayWhitePoint[0];
-        fs2W[1] = params->displayWhitePoint[1];
-
-        // Used in all HDR modes
-        displayMinMaxLuminance[0] = params->displayMinLuminance;
-        displayMinMaxLuminance[1] = params->displayMaxLuminance;
-    }
-
-    FfxFloat32x3 saturation;
-    saturation[0] = params->saturation[0];
-    saturation[1] = params->saturation[1];
-    saturation[2] = params->saturation[2];
-
-    FfxFloat32x3 crosstalk;
-    crosstalk[0] = params->crosstalk[0];
-    crosstalk[1] = params->crosstalk[1];
-    crosstalk[2] = params->crosstalk[2];
-
-    LpmConstants lpmConsts = {};
-
-    lpmConsts.displayMode = static_cast<FfxUInt32>(params->displayMode);
-
-    switch (params->colorSpace)
+    // The constants only depend on the tone and gamut mapping parameters, so only rerun the setup when those change.
+    LpmSetupParameters setup;
+    lpmGetSetupParameters(params, &setup);
+    const uint64_t setupHash = lpmHashSetupParameters(&setup);
+    if (!context->constantsValid || context->setupParametersHash != setupHash || memcmp(&context->setupParameters, &setup, sizeof(setup)) != 0)
     {
-        case FfxLpmColorSpace::FFX_LPM_ColorSpace_REC709:
-        {
-            switch (params->displayMode)
-            {
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR:
-                {
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_709_709,
-                                          LPM_COLORS_709_709,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_709_709, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084:
-                {
-                    hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_FS2RAWPQ_709,
-                                          LPM_COLORS_FS2RAWPQ_709,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_FS2RAWPQ_709, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_SCRGB:
-                {
-                    fs2S = LpmFs2ScrgbScalar(displayMinMaxLuminance[0], displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_FS2SCRGB_709,
-                                          LPM_COLORS_FS2SCRGB_709,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_FS2SCRGB_709, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084:
-                {
-                    hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_HDR10RAW_709,
-                                          LPM_COLORS_HDR10RAW_709,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10RAW_709, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_SCRGB:
-                {
-                    hdr10S = LpmHdr10ScrgbScalar(displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_HDR10SCRGB_709,
-                                          LPM_COLORS_HDR10SCRGB_709,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10SCRGB_709, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-            }
-        }
-        break;
-        case FfxLpmColorSpace::FFX_LPM_ColorSpace_P3:
-        {
-            switch (params->displayMode)
-            {
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR:
-                {
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_709_P3,
-                                          LPM_COLORS_709_P3,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_709_P3, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084:
-                {
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_FS2RAWPQ_P3,
-                                          LPM_COLORS_FS2RAWPQ_P3,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_FS2RAWPQ_P3, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_SCRGB:
-                {
-                    fs2S = LpmFs2ScrgbScalar(displayMinMaxLuminance[0], displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_FS2SCRGB_P3,
-                                          LPM_COLORS_FS2SCRGB_P3,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_FS2SCRGB_P3, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084:
-                {
-                    hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_HDR10RAW_P3,
-                                          LPM_COLORS_HDR10RAW_P3,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10RAW_P3, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_SCRGB:
-                {
-                    hdr10S = LpmHdr10ScrgbScalar(displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_HDR10SCRGB_P3,
-                                          LPM_COLORS_HDR10SCRGB_P3,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10SCRGB_P3, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-            }
-        }
-        break;
-        case FfxLpmColorSpace::FFX_LPM_ColorSpace_REC2020:
-        {
-            switch (params->displayMode)
-            {
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR:
-                {
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_709_2020,
-                                          LPM_COLORS_709_2020,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_709_2020, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084:
-                {
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_FS2RAWPQ_2020,
-                                          LPM_COLORS_FS2RAWPQ_2020,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_FS2RAWPQ_2020, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_SCRGB:
-                {
-                    fs2S = LpmFs2ScrgbScalar(displayMinMaxLuminance[0], displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_FS2SCRGB_2020,
-                                          LPM_COLORS_FS2SCRGB_2020,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_FS2SCRGB_2020, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084:
-                {
-                    hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_HDR10RAW_2020,
-                                          LPM_COLORS_HDR10RAW_2020,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10RAW_2020, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_SCRGB:
-                {
-                    hdr10S = LpmHdr10ScrgbScalar(displayMinMaxLuminance[1]);
-                    FfxCalculateLpmConsts(params->shoulder,
-                                          LPM_CONFIG_HDR10SCRGB_2020,
-                                          LPM_COLORS_HDR10SCRGB_2020,
-                                          params->softGap,
-                                          params->hdrMax,
-                                          params->lpmExposure,
-                                          params->contrast,
-                                          params->shoulderContrast,
-                                          saturation,
-                                          crosstalk);
-                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10SCRGB_2020, lpmConsts.con, lpmConsts.soft, lpmConsts.con2, lpmConsts.clip, lpmConsts.scaleOnly);
-                }
-                break;
-            }
-        }
-        break;
-        default:
-            break;
+        lpmCalculateConstants(&setup, &context->constants);
+        context->setupParameters     = setup;
+        context->setupParametersHash = setupHash;
+        context->constantsValid      = true;
     }
 
-    memcpy(lpmConsts.ctl, ctl, sizeof(ctl));
-
     context->contextDescription.backendInterface.fpStageConstantBufferDataFunc(&context->contextDescription.backendInterface, 
-                                                                               &lpmConsts, 
+                                                                               &context->constants, 
                                                                                sizeof(LpmConstants), 
                                                                                &context->constantBuffer);
     
@@ -662,26 +361,6 @@ FfxErrorCode ffxLpmContextDispatch(FfxLpmContext* context, const FfxLpmDispatchD
     return errorCode;
 }
 
-FFX_API FfxErrorCode FfxPopulateLpmConsts(bool      incon,
-                                          bool      insoft,
-                                          bool      incon2,
-                                          bool      inclip,
-                                          bool      inscaleOnly,
-                                          uint32_t& outcon,
-                                          uint32_t& outsoft,
-                                          uint32_t& outcon2,
-                                          uint32_t& outclip,
-                                          uint32_t& outscaleOnly)
-{
-    outcon = incon;
-    outsoft = insoft;
-    outcon2 = incon2;
-    outclip = inclip;
-    outscaleOnly = inscaleOnly;
-
-    return FFX_OK;
-}
-
 FFX_API FfxVersionNumber ffxLpmGetEffectVersion()
 {
     return FFX_SDK_MAKE_VERSION(FFX_LPM_VERSION_MAJOR, FFX_LPM_VERSION_MINOR, FFX_LPM_VERSION_PATCH);
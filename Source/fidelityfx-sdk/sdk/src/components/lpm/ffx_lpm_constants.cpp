@@ -0,0 +1,393 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Constant setup for the LPM filter pass. A pure function of the LpmSetupParameters, shared by
+// ffxLpmContextDispatch() and the CPU reference so both use the same constants.
+
+#include <string.h>  // for memset, memcpy
+#include <cmath>     // for fabs, abs, sinf, sqrt, etc.
+
+#include <FidelityFX/host/ffx_lpm.h>
+
+#define FFX_CPU
+#include <FidelityFX/gpu/ffx_core.h>
+
+// Destination of the control block rows written by FfxCalculateLpmConsts(), only set while
+// lpmCalculateConstants() runs. Thread local so contexts can be dispatched from different threads.
+static thread_local uint32_t* lpmSetupOutCtl = nullptr;
+
+static void LpmSetupOut(uint32_t i, uint32_t* v)
+{
+    for (int j = 0; j < 4; ++j)
+    {
+        lpmSetupOutCtl[i * 4 + j] = v[j];
+    }
+}
+#include <FidelityFX/gpu/lpm/ffx_lpm.h>
+
+#include "ffx_lpm_private.h"
+
+void lpmGetSetupParameters(const FfxLpmDispatchDescription* params, LpmSetupParameters* outSetup)
+{
+    // Clear first so the display fields unused in LDR never cause a cache miss.
+    memset(outSetup, 0, sizeof(LpmSetupParameters));
+
+    outSetup->shoulder         = params->shoulder ? 1 : 0;
+    outSetup->softGap          = params->softGap;
+    outSetup->hdrMax           = params->hdrMax;
+    outSetup->lpmExposure      = params->lpmExposure;
+    outSetup->contrast         = params->contrast;
+    outSetup->shoulderContrast = params->shoulderContrast;
+    memcpy(outSetup->saturation, params->saturation, sizeof(outSetup->saturation));
+    memcpy(outSetup->crosstalk, params->crosstalk, sizeof(outSetup->crosstalk));
+    outSetup->colorSpace  = static_cast<FfxUInt32>(params->colorSpace);
+    outSetup->displayMode = static_cast<FfxUInt32>(params->displayMode);
+
+    if (params->displayMode != FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR)
+    {
+        memcpy(outSetup->displayRedPrimary, params->displayRedPrimary, sizeof(outSetup->displayRedPrimary));
+        memcpy(outSetup->displayGreenPrimary, params->displayGreenPrimary, sizeof(outSetup->displayGreenPrimary));
+        memcpy(outSetup->displayBluePrimary, params->displayBluePrimary, sizeof(outSetup->displayBluePrimary));
+        memcpy(outSetup->displayWhitePoint, params->displayWhitePoint, sizeof(outSetup->displayWhitePoint));
+        outSetup->displayMinLuminance = params->displayMinLuminance;
+        outSetup->displayMaxLuminance = params->displayMaxLuminance;
+    }
+}
+
+uint64_t lpmHashSetupParameters(const LpmSetupParameters* setup)
+{
+    // FNV-1a over the raw bytes, the struct is fully initialized by lpmGetSetupParameters().
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(setup);
+    uint64_t       hash  = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < sizeof(LpmSetupParameters); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+void lpmCalculateConstants(const LpmSetupParameters* setup, LpmConstants* outConstants)
+{
+    // Display primaries are only used by the fs2 modes and luminance by all HDR modes, LDR leaves them zeroed.
+    FfxFloat32x2 fs2R                   = {setup->displayRedPrimary[0], setup->displayRedPrimary[1]};
+    FfxFloat32x2 fs2G                   = {setup->displayGreenPrimary[0], setup->displayGreenPrimary[1]};
+    FfxFloat32x2 fs2B                   = {setup->displayBluePrimary[0], setup->displayBluePrimary[1]};
+    FfxFloat32x2 fs2W                   = {setup->displayWhitePoint[0], setup->displayWhitePoint[1]};
+    FfxFloat32x2 displayMinMaxLuminance = {setup->displayMinLuminance, setup->displayMaxLuminance};
+
+    // FfxCalculateLpmConsts() modifies these in place, so work on copies.
+    FfxFloat32x3 saturation = {setup->saturation[0], setup->saturation[1], setup->saturation[2]};
+    FfxFloat32x3 crosstalk  = {setup->crosstalk[0], setup->crosstalk[1], setup->crosstalk[2]};
+
+    memset(outConstants, 0, sizeof(LpmConstants));
+    outConstants->displayMode = setup->displayMode;
+
+    // Route the packed control block rows from FfxCalculateLpmConsts() into the output.
+    lpmSetupOutCtl = outConstants->ctl;
+
+    switch (static_cast<FfxLpmColorSpace>(setup->colorSpace))
+    {
+        case FfxLpmColorSpace::FFX_LPM_ColorSpace_REC709:
+        {
+            switch (static_cast<FfxLpmDisplayMode>(setup->displayMode))
+            {
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR:
+                {
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_709_709,
+                                          LPM_COLORS_709_709,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_709_709, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_FS2RAWPQ_709,
+                                          LPM_COLORS_FS2RAWPQ_709,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_FS2RAWPQ_709, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_SCRGB:
+                {
+                    const FfxFloat32 fs2S = LpmFs2ScrgbScalar(displayMinMaxLuminance[0], displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_FS2SCRGB_709,
+                                          LPM_COLORS_FS2SCRGB_709,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_FS2SCRGB_709, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_HDR10RAW_709,
+                                          LPM_COLORS_HDR10RAW_709,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10RAW_709, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_SCRGB:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10ScrgbScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_HDR10SCRGB_709,
+                                          LPM_COLORS_HDR10SCRGB_709,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10SCRGB_709, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+            }
+        }
+        break;
+        case FfxLpmColorSpace::FFX_LPM_ColorSpace_P3:
+        {
+            switch (static_cast<FfxLpmDisplayMode>(setup->displayMode))
+            {
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR:
+                {
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_709_P3,
+                                          LPM_COLORS_709_P3,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_709_P3, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_FS2RAWPQ_P3,
+                                          LPM_COLORS_FS2RAWPQ_P3,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_FS2RAWPQ_P3, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_SCRGB:
+                {
+                    const FfxFloat32 fs2S = LpmFs2ScrgbScalar(displayMinMaxLuminance[0], displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_FS2SCRGB_P3,
+                                          LPM_COLORS_FS2SCRGB_P3,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_FS2SCRGB_P3, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_HDR10RAW_P3,
+                                          LPM_COLORS_HDR10RAW_P3,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10RAW_P3, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_SCRGB:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10ScrgbScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_HDR10SCRGB_P3,
+                                          LPM_COLORS_HDR10SCRGB_P3,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10SCRGB_P3, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+            }
+        }
+        break;
+        case FfxLpmColorSpace::FFX_LPM_ColorSpace_REC2020:
+        {
+            switch (static_cast<FfxLpmDisplayMode>(setup->displayMode))
+            {
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR:
+                {
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_709_2020,
+                                          LPM_COLORS_709_2020,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_709_2020, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_FS2RAWPQ_2020,
+                                          LPM_COLORS_FS2RAWPQ_2020,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_FS2RAWPQ_2020, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_SCRGB:
+                {
+                    const FfxFloat32 fs2S = LpmFs2ScrgbScalar(displayMinMaxLuminance[0], displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_FS2SCRGB_2020,
+                                          LPM_COLORS_FS2SCRGB_2020,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_FS2SCRGB_2020, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10RawScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_HDR10RAW_2020,
+                                          LPM_COLORS_HDR10RAW_2020,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10RAW_2020, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+                case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_SCRGB:
+                {
+                    const FfxFloat32 hdr10S = LpmHdr10ScrgbScalar(displayMinMaxLuminance[1]);
+                    FfxCalculateLpmConsts(setup->shoulder,
+                                          LPM_CONFIG_HDR10SCRGB_2020,
+                                          LPM_COLORS_HDR10SCRGB_2020,
+                                          setup->softGap,
+                                          setup->hdrMax,
+                                          setup->lpmExposure,
+                                          setup->contrast,
+                                          setup->shoulderContrast,
+                                          saturation,
+                                          crosstalk);
+                    FfxPopulateLpmConsts(LPM_CONFIG_HDR10SCRGB_2020, outConstants->con, outConstants->soft, outConstants->con2, outConstants->clip, outConstants->scaleOnly);
+                }
+                break;
+            }
+        }
+        break;
+        default:
+            break;
+    }
+
+    lpmSetupOutCtl = nullptr;
+}
+
+FFX_API FfxErrorCode FfxPopulateLpmConsts(bool      incon,
+                                          bool      insoft,
+                                          bool      incon2,
+                                          bool      inclip,
+                                          bool      inscaleOnly,
+                                          uint32_t& outcon,
+                                          uint32_t& outsoft,
+                                          uint32_t& outcon2,
+                                          uint32_t& outclip,
+                                          uint32_t& outscaleOnly)
+{
+    outcon = incon;
+    outsoft = insoft;
+    outcon2 = incon2;
+    outclip = inclip;
+    outscaleOnly = inscaleOnly;
+
+    return FFX_OK;
+}
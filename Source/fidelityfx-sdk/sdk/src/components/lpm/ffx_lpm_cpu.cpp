@@ -0,0 +1,479 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// CPU implementation of the LPM filter pass, mirroring LpmMap() and CurrFilter() from
+// FidelityFX/gpu/lpm so GPU output can be validated and the per-pixel cost measured
+// without a device. Pixels are processed four at a time in SoA form.
+
+#include <string.h>  // for memcpy
+#include <cmath>     // for exp2, log2, fabs
+
+#include <FidelityFX/host/ffx_lpm.h>
+
+#define FFX_CPU
+#include <FidelityFX/gpu/ffx_core.h>
+
+#include "ffx_lpm_private.h"
+
+#if !defined(FFX_LPM_CPU_SSE2)
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define FFX_LPM_CPU_SSE2 1
+#else
+#define FFX_LPM_CPU_SSE2 0
+#endif
+#endif // #if !defined(FFX_LPM_CPU_SSE2)
+
+#if FFX_LPM_CPU_SSE2
+#include <emmintrin.h>
+#endif // #if FFX_LPM_CPU_SSE2
+
+//-------------------------------------------------------------------------------------------------
+// Four wide float helpers. The SSE2 path has its own log2/exp2, like the GPU transcendentals
+// they flush denormals and follow IEEE for zero, infinity and NaN.
+//-------------------------------------------------------------------------------------------------
+#if FFX_LPM_CPU_SSE2
+
+typedef __m128 LpmFloat4;
+
+static inline LpmFloat4 lpmSplat(float x)                   { return _mm_set1_ps(x); }
+static inline LpmFloat4 lpmAdd(LpmFloat4 a, LpmFloat4 b)     { return _mm_add_ps(a, b); }
+static inline LpmFloat4 lpmSub(LpmFloat4 a, LpmFloat4 b)     { return _mm_sub_ps(a, b); }
+static inline LpmFloat4 lpmMul(LpmFloat4 a, LpmFloat4 b)     { return _mm_mul_ps(a, b); }
+static inline LpmFloat4 lpmDiv(LpmFloat4 a, LpmFloat4 b)     { return _mm_div_ps(a, b); }
+static inline LpmFloat4 lpmMin(LpmFloat4 a, LpmFloat4 b)     { return _mm_min_ps(a, b); }
+static inline LpmFloat4 lpmMax(LpmFloat4 a, LpmFloat4 b)     { return _mm_max_ps(a, b); }
+static inline LpmFloat4 lpmAbs(LpmFloat4 a)                  { return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff))); }
+
+static inline LpmFloat4 lpmSelect(LpmFloat4 mask, LpmFloat4 a, LpmFloat4 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Saturate sends NaN to zero like the GPU, _mm_max_ps returns the second operand for NaN.
+static inline LpmFloat4 lpmSaturate(LpmFloat4 a)
+{
+    return _mm_min_ps(_mm_max_ps(a, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+static inline LpmFloat4 lpmLog2(LpmFloat4 x)
+{
+    // Split into exponent and a mantissa centered on 1, m in [sqrt(0.5), sqrt(2)).
+    __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(127));
+    __m128  mantissa = _mm_or_ps(_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007fffff))), _mm_set1_ps(1.0f));
+    const __m128 large = _mm_cmpgt_ps(mantissa, _mm_set1_ps(1.41421356f));
+    mantissa = lpmSelect(large, _mm_mul_ps(mantissa, _mm_set1_ps(0.5f)), mantissa);
+    exponent = _mm_sub_epi32(exponent, _mm_castps_si128(large));
+
+    // log2(m) = 2/ln(2) * atanh(t), t = (m-1)/(m+1), |t| <= 0.172.
+    const __m128 t  = _mm_div_ps(_mm_sub_ps(mantissa, _mm_set1_ps(1.0f)), _mm_add_ps(mantissa, _mm_set1_ps(1.0f)));
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 poly = _mm_set1_ps(0.32059889f);  // 2/(9*ln(2))
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(0.41219858f));  // 2/(7*ln(2))
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(0.57707801f));  // 2/(5*ln(2))
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(0.96179669f));  // 2/(3*ln(2))
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(2.88539008f));  // 2/ln(2)
+    __m128 result = _mm_add_ps(_mm_cvtepi32_ps(exponent), _mm_mul_ps(poly, t));
+
+    const __m128 infinity = _mm_castsi128_ps(_mm_set1_epi32(0x7f800000));
+    const __m128 zero     = _mm_setzero_ps();
+    const __m128 tiny     = _mm_and_ps(_mm_cmpge_ps(x, zero), _mm_cmplt_ps(x, _mm_set1_ps(1.17549435e-38f)));
+    const __m128 invalid  = _mm_or_ps(_mm_cmplt_ps(x, zero), _mm_cmpunord_ps(x, x));
+    result = lpmSelect(_mm_cmpeq_ps(x, infinity), infinity, result);
+    result = lpmSelect(tiny, _mm_sub_ps(zero, infinity), result);
+    result = lpmSelect(invalid, _mm_castsi128_ps(_mm_set1_epi32(0x7fc00000)), result);
+    return result;
+}
+
+static inline LpmFloat4 lpmExp2(LpmFloat4 x)
+{
+    // Clamping to -127 produces a zero scale below, 128 produces infinity.
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-127.0f)), _mm_set1_ps(128.0f));
+
+    // Floor via truncation, stepping down where truncation rounded up.
+    __m128i whole = _mm_cvttps_epi32(clamped);
+    whole = _mm_add_epi32(whole, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(whole), clamped)));
+    const __m128 fraction = _mm_sub_ps(clamped, _mm_cvtepi32_ps(whole));
+
+    // 2^f = sqrt(2) * e^y with y = (f - 0.5) * ln(2), |y| <= 0.347, Taylor series to y^7.
+    const __m128 y = _mm_mul_ps(_mm_sub_ps(fraction, _mm_set1_ps(0.5f)), _mm_set1_ps(0.69314718f));
+    __m128 poly = _mm_set1_ps(1.0f / 5040.0f);
+    poly = _mm_add_ps(_mm_mul_ps(poly, y), _mm_set1_ps(1.0f / 720.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, y), _mm_set1_ps(1.0f / 120.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, y), _mm_set1_ps(1.0f / 24.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, y), _mm_set1_ps(1.0f / 6.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, y), _mm_set1_ps(0.5f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, y), _mm_set1_ps(1.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, y), _mm_set1_ps(1.0f));
+    poly = _mm_mul_ps(poly, _mm_set1_ps(1.41421356f));
+
+    const __m128 scale  = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(whole, _mm_set1_epi32(127)), 23));
+    const __m128 result = _mm_mul_ps(poly, scale);
+    return lpmSelect(_mm_cmpunord_ps(x, x), x, result);
+}
+
+#else
+
+typedef struct LpmFloat4
+{
+    float v[4];
+} LpmFloat4;
+
+#define LPM_FLOAT4_OP(expr)         \
+    LpmFloat4 r;                    \
+    for (int i = 0; i < 4; ++i)     \
+        r.v[i] = (expr);            \
+    return r
+
+static inline LpmFloat4 lpmSplat(float x)                   { LPM_FLOAT4_OP(x); }
+static inline LpmFloat4 lpmAdd(LpmFloat4 a, LpmFloat4 b)     { LPM_FLOAT4_OP(a.v[i] + b.v[i]); }
+static inline LpmFloat4 lpmSub(LpmFloat4 a, LpmFloat4 b)     { LPM_FLOAT4_OP(a.v[i] - b.v[i]); }
+static inline LpmFloat4 lpmMul(LpmFloat4 a, LpmFloat4 b)     { LPM_FLOAT4_OP(a.v[i] * b.v[i]); }
+static inline LpmFloat4 lpmDiv(LpmFloat4 a, LpmFloat4 b)     { LPM_FLOAT4_OP(a.v[i] / b.v[i]); }
+static inline LpmFloat4 lpmMin(LpmFloat4 a, LpmFloat4 b)     { LPM_FLOAT4_OP(a.v[i] < b.v[i] ? a.v[i] : b.v[i]); }
+static inline LpmFloat4 lpmMax(LpmFloat4 a, LpmFloat4 b)     { LPM_FLOAT4_OP(a.v[i] > b.v[i] ? a.v[i] : b.v[i]); }
+static inline LpmFloat4 lpmAbs(LpmFloat4 a)                  { LPM_FLOAT4_OP(fabsf(a.v[i])); }
+static inline LpmFloat4 lpmSaturate(LpmFloat4 a)             { LPM_FLOAT4_OP(a.v[i] > 0.0f ? (a.v[i] < 1.0f ? a.v[i] : 1.0f) : 0.0f); }
+static inline LpmFloat4 lpmLog2(LpmFloat4 a)                 { LPM_FLOAT4_OP(log2f(a.v[i])); }
+static inline LpmFloat4 lpmExp2(LpmFloat4 a)                 { LPM_FLOAT4_OP(exp2f(a.v[i])); }
+
+#undef LPM_FLOAT4_OP
+
+#endif  // #if FFX_LPM_CPU_SSE2
+
+// pow() as the GPU evaluates it, so pow(0, y) is 0 for positive y.
+static inline LpmFloat4 lpmPow(LpmFloat4 x, float y)
+{
+    return lpmExp2(lpmMul(lpmLog2(x), lpmSplat(y)));
+}
+
+// a * b + c
+static inline LpmFloat4 lpmMad(LpmFloat4 a, float b, LpmFloat4 c)
+{
+    return lpmAdd(lpmMul(a, lpmSplat(b)), c);
+}
+
+static inline LpmFloat4 lpmMax3(LpmFloat4 a, LpmFloat4 b, LpmFloat4 c)
+{
+    return lpmMax(lpmMax(a, b), c);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Control block decoded to floats, laid out as LpmFilter() reads it.
+//-------------------------------------------------------------------------------------------------
+typedef struct LpmCpuConstants
+{
+    float lumaW[3];
+    float lumaT[3];
+    float rcpLumaT[3];
+    float saturation[3];
+    float contrast;
+    float shoulderContrast;
+    float toneScaleBias[2];
+    float crosstalk[3];
+    float conR[3];
+    float conG[3];
+    float conB[3];
+    float softGap[2];
+    float con2R[3];
+    float con2G[3];
+    float con2B[3];
+
+    bool shoulder;
+    bool con;
+    bool soft;
+    bool con2;
+    bool clip;
+    bool scaleOnly;
+    FfxLpmDisplayMode displayMode;
+} LpmCpuConstants;
+
+static void lpmDecodeConstants(const LpmConstants* constants, LpmCpuConstants* outConstants)
+{
+    float map[24 * 4];
+    memcpy(map, constants->ctl, sizeof(map));
+
+    const float* map0 = map + 0 * 4;
+    const float* map1 = map + 1 * 4;
+    const float* map2 = map + 2 * 4;
+    const float* map3 = map + 3 * 4;
+    const float* map4 = map + 4 * 4;
+    const float* map5 = map + 5 * 4;
+    const float* map6 = map + 6 * 4;
+    const float* map7 = map + 7 * 4;
+    const float* map8 = map + 8 * 4;
+    const float* map9 = map + 9 * 4;
+
+    LpmCpuConstants& c = *outConstants;
+    c.lumaW[0]         = map6[1];  c.lumaW[1]       = map6[2];  c.lumaW[2]       = map6[3];
+    c.lumaT[0]         = map1[2];  c.lumaT[1]       = map1[3];  c.lumaT[2]       = map2[0];
+    c.rcpLumaT[0]      = map3[0];  c.rcpLumaT[1]    = map3[1];  c.rcpLumaT[2]    = map3[2];
+    c.saturation[0]    = map0[0];  c.saturation[1]  = map0[1];  c.saturation[2]  = map0[2];
+    c.contrast         = map0[3];
+    c.shoulderContrast = map6[0];
+    c.toneScaleBias[0] = map1[0];  c.toneScaleBias[1] = map1[1];
+    c.crosstalk[0]     = map2[1];  c.crosstalk[1]   = map2[2];  c.crosstalk[2]   = map2[3];
+    c.conR[0]          = map7[2];  c.conR[1]        = map7[3];  c.conR[2]        = map8[0];
+    c.conG[0]          = map8[1];  c.conG[1]        = map8[2];  c.conG[2]        = map8[3];
+    c.conB[0]          = map9[0];  c.conB[1]        = map9[1];  c.conB[2]        = map9[2];
+    c.softGap[0]       = map7[0];  c.softGap[1]     = map7[1];
+    c.con2R[0]         = map3[3];  c.con2R[1]       = map4[0];  c.con2R[2]       = map4[1];
+    c.con2G[0]         = map4[2];  c.con2G[1]       = map4[3];  c.con2G[2]       = map5[0];
+    c.con2B[0]         = map5[1];  c.con2B[1]       = map5[2];  c.con2B[2]       = map5[3];
+
+    // Same flags the shader reads from cbLPM.
+    c.shoulder    = constants->shoulder != 0;
+    c.con         = constants->con != 0;
+    c.soft        = constants->soft != 0;
+    c.con2        = constants->con2 != 0;
+    c.clip        = constants->clip != 0;
+    c.scaleOnly   = constants->scaleOnly != 0;
+    c.displayMode = static_cast<FfxLpmDisplayMode>(constants->displayMode);
+}
+
+// Four pixel version of LpmMap(), see the GPU source for the reasoning behind each step.
+static inline void lpmMap(const LpmCpuConstants& c, LpmFloat4& colorR, LpmFloat4& colorG, LpmFloat4& colorB)
+{
+    const LpmFloat4 one = lpmSplat(1.0f);
+
+    LpmFloat4 rcpMax = lpmDiv(one, lpmMax3(colorR, colorG, colorB));
+    LpmFloat4 ratioR = lpmMul(colorR, rcpMax);
+    LpmFloat4 ratioG = lpmMul(colorG, rcpMax);
+    LpmFloat4 ratioB = lpmMul(colorB, rcpMax);
+
+    ratioR = lpmPow(ratioR, c.saturation[0]);
+    ratioG = lpmPow(ratioG, c.saturation[1]);
+    ratioB = lpmPow(ratioB, c.saturation[2]);
+
+    const float* lumaCoef = c.soft ? c.lumaW : c.lumaT;
+    LpmFloat4    luma     = lpmMad(colorG, lumaCoef[1], lpmMad(colorR, lumaCoef[0], lpmMul(colorB, lpmSplat(lumaCoef[2]))));
+    luma                  = lpmPow(luma, c.contrast);
+    const LpmFloat4 lumaShoulder = c.shoulder ? lpmPow(luma, c.shoulderContrast) : luma;
+    luma = lpmDiv(luma, lpmMad(lumaShoulder, c.toneScaleBias[0], lpmSplat(c.toneScaleBias[1])));
+
+    if (c.soft)
+    {
+        if (c.con)
+        {
+            colorR = ratioR;
+            colorG = ratioG;
+            colorB = ratioB;
+            ratioR = lpmMad(colorR, c.conR[0], lpmMad(colorG, c.conR[1], lpmMul(colorB, lpmSplat(c.conR[2]))));
+            ratioG = lpmMad(colorG, c.conG[1], lpmMad(colorR, c.conG[0], lpmMul(colorB, lpmSplat(c.conG[2]))));
+            ratioB = lpmMad(colorB, c.conB[2], lpmMad(colorG, c.conB[1], lpmMul(colorR, lpmSplat(c.conB[0]))));
+
+            rcpMax = lpmDiv(one, lpmMax3(ratioR, ratioG, ratioB));
+            ratioR = lpmMul(ratioR, rcpMax);
+            ratioG = lpmMul(ratioG, rcpMax);
+            ratioB = lpmMul(ratioB, rcpMax);
+        }
+
+        const LpmFloat4 gap = lpmSplat(c.softGap[0]);
+        ratioR = lpmMin(lpmMax(gap, lpmSaturate(lpmMad(ratioR, -c.softGap[0], ratioR))), lpmSaturate(lpmMul(gap, lpmExp2(lpmMul(ratioR, lpmSplat(c.softGap[1]))))));
+        ratioG = lpmMin(lpmMax(gap, lpmSaturate(lpmMad(ratioG, -c.softGap[0], ratioG))), lpmSaturate(lpmMul(gap, lpmExp2(lpmMul(ratioG, lpmSplat(c.softGap[1]))))));
+        ratioB = lpmMin(lpmMax(gap, lpmSaturate(lpmMad(ratioB, -c.softGap[0], ratioB))), lpmSaturate(lpmMul(gap, lpmExp2(lpmMul(ratioB, lpmSplat(c.softGap[1]))))));
+    }
+
+    const LpmFloat4 lumaRatio  = lpmMad(ratioB, c.lumaT[2], lpmMad(ratioG, c.lumaT[1], lpmMul(ratioR, lpmSplat(c.lumaT[0]))));
+    const LpmFloat4 ratioScale = lpmSaturate(lpmDiv(luma, lumaRatio));
+
+    colorR = lpmSaturate(lpmMul(ratioR, ratioScale));
+    colorG = lpmSaturate(lpmMul(ratioG, ratioScale));
+    colorB = lpmSaturate(lpmMul(ratioB, ratioScale));
+
+    const LpmFloat4 capR = lpmMad(colorR, -c.crosstalk[0], lpmSplat(c.crosstalk[0]));
+    const LpmFloat4 capG = lpmMad(colorG, -c.crosstalk[1], lpmSplat(c.crosstalk[1]));
+    const LpmFloat4 capB = lpmMad(colorB, -c.crosstalk[2], lpmSplat(c.crosstalk[2]));
+
+    LpmFloat4 lumaAdd = lpmSaturate(lpmMad(colorB, -c.lumaT[2], lpmMad(colorR, -c.lumaT[0], lpmMad(colorG, -c.lumaT[1], luma))));
+
+    const LpmFloat4 t = lpmDiv(lumaAdd, lpmMad(capG, c.lumaT[1], lpmMad(capR, c.lumaT[0], lpmMul(capB, lpmSplat(c.lumaT[2])))));
+
+    colorR = lpmSaturate(lpmAdd(lpmMul(t, capR), colorR));
+    colorG = lpmSaturate(lpmAdd(lpmMul(t, capG), colorG));
+    colorB = lpmSaturate(lpmAdd(lpmMul(t, capB), colorB));
+
+    lumaAdd = lpmSaturate(lpmMad(colorB, -c.lumaT[2], lpmMad(colorR, -c.lumaT[0], lpmMad(colorG, -c.lumaT[1], luma))));
+
+    colorR = lpmSaturate(lpmMad(lumaAdd, c.rcpLumaT[0], colorR));
+    colorG = lpmSaturate(lpmMad(lumaAdd, c.rcpLumaT[1], colorG));
+    colorB = lpmSaturate(lpmMad(lumaAdd, c.rcpLumaT[2], colorB));
+
+    if (c.con2)
+    {
+        ratioR = colorR;
+        ratioG = colorG;
+        ratioB = colorB;
+
+        colorR = lpmMad(ratioR, c.con2R[0], lpmMad(ratioG, c.con2R[1], lpmMul(ratioB, lpmSplat(c.con2R[2]))));
+        colorG = lpmMad(ratioG, c.con2G[1], lpmMad(ratioR, c.con2G[0], lpmMul(ratioB, lpmSplat(c.con2G[2]))));
+        colorB = lpmMad(ratioB, c.con2B[2], lpmMad(ratioG, c.con2B[1], lpmMul(ratioR, lpmSplat(c.con2B[0]))));
+
+        if (c.clip)
+        {
+            colorR = lpmSaturate(colorR);
+            colorG = lpmSaturate(colorG);
+            colorB = lpmSaturate(colorB);
+        }
+    }
+
+    if (c.scaleOnly)
+    {
+        const LpmFloat4 scale = lpmSplat(c.con2R[0]);
+        colorR = lpmMul(colorR, scale);
+        colorG = lpmMul(colorG, scale);
+        colorB = lpmMul(colorB, scale);
+    }
+}
+
+// ST2084 encoding, matches ApplyPQ() in the shader callbacks.
+static inline LpmFloat4 lpmApplyPQ(LpmFloat4 color)
+{
+    const float     m1 = 2610.0f / 4096.0f / 4.0f;
+    const float     m2 = 2523.0f / 4096.0f * 128.0f;
+    const float     c1 = 3424.0f / 4096.0f;
+    const float     c2 = 2413.0f / 4096.0f * 32.0f;
+    const float     c3 = 2392.0f / 4096.0f * 32.0f;
+    const LpmFloat4 cp = lpmPow(lpmAbs(color), m1);
+    return lpmPow(lpmDiv(lpmMad(cp, c2, lpmSplat(c1)), lpmMad(cp, c3, lpmSplat(1.0f))), m2);
+}
+
+static inline void lpmFilterPixels(const LpmCpuConstants& c, LpmFloat4& colorR, LpmFloat4& colorG, LpmFloat4& colorB)
+{
+    lpmMap(c, colorR, colorG, colorB);
+
+    switch (c.displayMode)
+    {
+        case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR:
+            colorR = lpmPow(colorR, 1.0f / 2.2f);
+            colorG = lpmPow(colorG, 1.0f / 2.2f);
+            colorB = lpmPow(colorB, 1.0f / 2.2f);
+            break;
+
+        case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084:
+        case FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084:
+            colorR = lpmApplyPQ(colorR);
+            colorG = lpmApplyPQ(colorG);
+            colorB = lpmApplyPQ(colorB);
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Filters up to four RGBA pixels, converting between AoS and SoA.
+static inline void lpmFilterQuad(const LpmCpuConstants& c, const float* input, float* output, uint32_t count)
+{
+#if FFX_LPM_CPU_SSE2
+    float padded[4 * 4];
+    if (count < 4)
+    {
+        memset(padded, 0, sizeof(padded));
+        memcpy(padded, input, count * 4 * sizeof(float));
+        input = padded;
+    }
+
+    LpmFloat4 r = _mm_loadu_ps(input + 0);
+    LpmFloat4 g = _mm_loadu_ps(input + 4);
+    LpmFloat4 b = _mm_loadu_ps(input + 8);
+    LpmFloat4 a = _mm_loadu_ps(input + 12);
+    _MM_TRANSPOSE4_PS(r, g, b, a);
+
+    lpmFilterPixels(c, r, g, b);
+
+    _MM_TRANSPOSE4_PS(r, g, b, a);
+    if (count == 4)
+    {
+        _mm_storeu_ps(output + 0, r);
+        _mm_storeu_ps(output + 4, g);
+        _mm_storeu_ps(output + 8, b);
+        _mm_storeu_ps(output + 12, a);
+    }
+    else
+    {
+        _mm_storeu_ps(padded + 0, r);
+        _mm_storeu_ps(padded + 4, g);
+        _mm_storeu_ps(padded + 8, b);
+        _mm_storeu_ps(padded + 12, a);
+        memcpy(output, padded, count * 4 * sizeof(float));
+    }
+#else
+    LpmFloat4 r = lpmSplat(0.0f);
+    LpmFloat4 g = lpmSplat(0.0f);
+    LpmFloat4 b = lpmSplat(0.0f);
+    float     alpha[4];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        r.v[i]   = input[i * 4 + 0];
+        g.v[i]   = input[i * 4 + 1];
+        b.v[i]   = input[i * 4 + 2];
+        alpha[i] = input[i * 4 + 3];
+    }
+
+    lpmFilterPixels(c, r, g, b);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        output[i * 4 + 0] = r.v[i];
+        output[i * 4 + 1] = g.v[i];
+        output[i * 4 + 2] = b.v[i];
+        output[i * 4 + 3] = alpha[i];
+    }
+#endif  // #if FFX_LPM_CPU_SSE2
+}
+
+FfxErrorCode ffxLpmFilterCpu(const FfxLpmDispatchDescription* pDispatchDescription,
+                             const float*                     pInput,
+                             float*                           pOutput,
+                             uint32_t                         width,
+                             uint32_t                         height,
+                             size_t                           inputRowPitch,
+                             size_t                           outputRowPitch)
+{
+    FFX_RETURN_ON_ERROR(pDispatchDescription, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pInput, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pOutput, FFX_ERROR_INVALID_POINTER);
+
+    const size_t rowSize = size_t(width) * 4 * sizeof(float);
+    FFX_RETURN_ON_ERROR(inputRowPitch >= rowSize && outputRowPitch >= rowSize, FFX_ERROR_INVALID_SIZE);
+
+    // Same constants the GPU dispatch would upload.
+    LpmSetupParameters setup;
+    lpmGetSetupParameters(pDispatchDescription, &setup);
+    LpmConstants constants;
+    lpmCalculateConstants(&setup, &constants);
+    LpmCpuConstants cpuConstants;
+    lpmDecodeConstants(&constants, &cpuConstants);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const float* inputRow  = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(pInput) + y * inputRowPitch);
+        float*       outputRow = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(pOutput) + y * outputRowPitch);
+        for (uint32_t x = 0; x < width; x += 4)
+        {
+            const uint32_t count = (width - x) < 4 ? (width - x) : 4;
+            lpmFilterQuad(cpuConstants, inputRow + x * 4, outputRow + x * 4, count);
+        }
+    }
+
+    return FFX_OK;
+}
@@ -51,6 +51,28 @@ typedef struct LpmConstants
     FfxUInt32 pad;          // Struct padding
 } LpmConstants;
 
+// Parameters the LPM constants are derived from, a subset of FfxLpmDispatchDescription.
+// Kept free of padding and bools so it can be hashed and compared bytewise.
+typedef struct LpmSetupParameters
+{
+    FfxUInt32 shoulder;
+    float     softGap;
+    float     hdrMax;
+    float     lpmExposure;
+    float     contrast;
+    float     shoulderContrast;
+    float     saturation[3];
+    float     crosstalk[3];
+    FfxUInt32 colorSpace;
+    FfxUInt32 displayMode;
+    float     displayRedPrimary[2];
+    float     displayGreenPrimary[2];
+    float     displayBluePrimary[2];
+    float     displayWhitePoint[2];
+    float     displayMinLuminance;
+    float     displayMaxLuminance;
+} LpmSetupParameters;
+
 struct FfxLpmContextDescription;
 struct FfxDeviceCapabilities;
 struct FfxPipelineState;
@@ -63,6 +85,9 @@ typedef struct FfxLpmContext_Private
     FfxLpmContextDescription    contextDescription;
     FfxUInt32                   effectContextId;
     LpmConstants                constants;
+    LpmSetupParameters          setupParameters;      // Parameters the cached constants were calculated from.
+    uint64_t                    setupParametersHash;
+    bool                        constantsValid;
     FfxDevice                   device;
     FfxDeviceCapabilities       deviceCapabilities;
     FfxConstantBuffer           constantBuffer;
@@ -73,3 +98,12 @@ typedef struct FfxLpmContext_Private
     FfxResourceInternal uavResources[FFX_LPM_RESOURCE_IDENTIFIER_COUNT];
 
 } FfxSpdContext_Private;
+
+// Fills the setup parameters from a dispatch description, zeroing anything the display mode does not use.
+void lpmGetSetupParameters(const FfxLpmDispatchDescription* params, LpmSetupParameters* outSetup);
+
+// FNV-1a hash of the setup parameters, the key contexts cache their constants under.
+uint64_t lpmHashSetupParameters(const LpmSetupParameters* setup);
+
+// Runs the LPM setup math for a set of parameters, depends on nothing but its inputs.
+void lpmCalculateConstants(const LpmSetupParameters* setup, LpmConstants* outConstants);
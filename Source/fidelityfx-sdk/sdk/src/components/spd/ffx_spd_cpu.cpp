@@ -0,0 +1,365 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// CPU implementation of the single pass downsampler. Follows SpdDownsample() in
+// FidelityFX/gpu/spd: every 64x64 tile produces its part of mips 1 to 6 from a small
+// ping-pong buffer standing in for LDS, and the tile that completes last carries on
+// from mip 6 to the end of the chain, as the last workgroup does on the GPU.
+// A task reduces a horizontal strip of neighbouring tiles together, so mip 0 is read
+// as a few long row streams rather than 64 short ones per tile.
+
+#include <string.h>     // for memcpy, memset
+#include <cmath>        // for floor, sqrt, etc.
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <FidelityFX/host/ffx_spd.h>
+
+#define FFX_CPU
+#include <FidelityFX/gpu/ffx_core.h>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define FFX_SPD_CPU_SSE2 1
+#include <emmintrin.h>
+#else
+#define FFX_SPD_CPU_SSE2 0
+#endif
+
+// Tile size in mip 0 and the number of mips a tile reduces, same as a GPU workgroup.
+#define SPD_CPU_TILE_SIZE       64
+#define SPD_CPU_TILE_MIP_COUNT  6
+
+// Tiles per task, a strip row of mip 0 spans 2 KiB for any channel count (8 KiB for 3 channels).
+#define SPD_CPU_STRIP_TILES(channels)   ((channels) == 1 ? 8 : (channels) == 2 ? 4 : 2)
+
+// A mip as seen by the tile reduction, pitch in floats.
+typedef struct SpdCpuImage
+{
+    float*   data;
+    size_t   pitch;
+    uint32_t width;
+    uint32_t height;
+} SpdCpuImage;
+
+typedef struct SpdCpuJob
+{
+    SpdCpuImage                           mips[SPD_MAX_MIP_LEVELS + 1];  // mips[0] is the source
+    uint32_t                              mipCount;
+    uint32_t                              tileCountX;
+    uint32_t                              stripTiles;
+    uint32_t                              stripCountX;
+    uint32_t                              stripCount;
+    std::atomic<uint32_t>                 nextStrip;
+    std::atomic<uint32_t>                 completedStrips;
+} SpdCpuJob;
+
+//-------------------------------------------------------------------------------------------------
+// 2x2 reductions, matching SpdReduce4() for each filter.
+//-------------------------------------------------------------------------------------------------
+template<FfxSpdDownsampleFilter Filter>
+static inline float spdReduce4(float v0, float v1, float v2, float v3)
+{
+    if (Filter == FFX_SPD_DOWNSAMPLE_FILTER_MIN)
+        return ffxMin(ffxMin(v0, v1), ffxMin(v2, v3));
+    if (Filter == FFX_SPD_DOWNSAMPLE_FILTER_MAX)
+        return ffxMax(ffxMax(v0, v1), ffxMax(v2, v3));
+    return (v0 + v1 + v2 + v3) * 0.25f;
+}
+
+#if FFX_SPD_CPU_SSE2
+template<FfxSpdDownsampleFilter Filter>
+static inline __m128 spdReduce2(__m128 a, __m128 b)
+{
+    if (Filter == FFX_SPD_DOWNSAMPLE_FILTER_MIN)
+        return _mm_min_ps(a, b);
+    if (Filter == FFX_SPD_DOWNSAMPLE_FILTER_MAX)
+        return _mm_max_ps(a, b);
+    return _mm_add_ps(a, b);
+}
+
+template<FfxSpdDownsampleFilter Filter>
+static inline __m128 spdReduceFinish(__m128 v)
+{
+    return (Filter == FFX_SPD_DOWNSAMPLE_FILTER_MEAN) ? _mm_mul_ps(v, _mm_set1_ps(0.25f)) : v;
+}
+#endif  // #if FFX_SPD_CPU_SSE2
+
+// Reduces src to dst, where dst is half the size of src in both dimensions and fully in bounds of it.
+template<FfxSpdDownsampleFilter Filter, uint32_t Channels>
+static void spdReduceLevel(const float* src, size_t srcPitch, float* dst, size_t dstPitch, uint32_t dstWidth, uint32_t dstHeight)
+{
+    for (uint32_t y = 0; y < dstHeight; ++y)
+    {
+        const float* row0 = src + (2 * y) * srcPitch;
+        const float* row1 = row0 + srcPitch;
+        float*       out  = dst + y * dstPitch;
+        uint32_t     x    = 0;
+
+#if FFX_SPD_CPU_SSE2
+        if (Channels == 4)
+        {
+            // One pixel per register.
+            for (; x < dstWidth; ++x)
+            {
+                const __m128 v0 = _mm_loadu_ps(row0 + (2 * x) * 4);
+                const __m128 v1 = _mm_loadu_ps(row0 + (2 * x + 1) * 4);
+                const __m128 v2 = _mm_loadu_ps(row1 + (2 * x) * 4);
+                const __m128 v3 = _mm_loadu_ps(row1 + (2 * x + 1) * 4);
+                _mm_storeu_ps(out + x * 4, spdReduceFinish<Filter>(spdReduce2<Filter>(spdReduce2<Filter>(v0, v1), spdReduce2<Filter>(v2, v3))));
+            }
+        }
+        else if (Channels == 2)
+        {
+            // Two outputs per iteration, reduce vertically then pair up neighbouring pixels.
+            for (; x + 2 <= dstWidth; x += 2)
+            {
+                const __m128 lo = spdReduce2<Filter>(_mm_loadu_ps(row0 + 4 * x), _mm_loadu_ps(row1 + 4 * x));
+                const __m128 hi = spdReduce2<Filter>(_mm_loadu_ps(row0 + 4 * x + 4), _mm_loadu_ps(row1 + 4 * x + 4));
+                const __m128 a  = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(1, 0, 1, 0));
+                const __m128 b  = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 2, 3, 2));
+                _mm_storeu_ps(out + x * 2, spdReduceFinish<Filter>(spdReduce2<Filter>(a, b)));
+            }
+        }
+        else if (Channels == 1)
+        {
+            // Four outputs per iteration, reduce vertically then split even and odd columns.
+            for (; x + 4 <= dstWidth; x += 4)
+            {
+                const __m128 lo    = spdReduce2<Filter>(_mm_loadu_ps(row0 + 2 * x), _mm_loadu_ps(row1 + 2 * x));
+                const __m128 hi    = spdReduce2<Filter>(_mm_loadu_ps(row0 + 2 * x + 4), _mm_loadu_ps(row1 + 2 * x + 4));
+                const __m128 even  = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+                const __m128 odd   = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+                _mm_storeu_ps(out + x, spdReduceFinish<Filter>(spdReduce2<Filter>(even, odd)));
+            }
+        }
+#endif  // #if FFX_SPD_CPU_SSE2
+
+        for (; x < dstWidth; ++x)
+        {
+            for (uint32_t c = 0; c < Channels; ++c)
+            {
+                out[x * Channels + c] = spdReduce4<Filter>(row0[(2 * x) * Channels + c],
+                                                           row0[(2 * x + 1) * Channels + c],
+                                                           row1[(2 * x) * Channels + c],
+                                                           row1[(2 * x + 1) * Channels + c]);
+            }
+        }
+    }
+}
+
+// First level of a strip that crosses the edge of its source, reads outside of it return zero.
+// The part whose quads lie fully inside the source takes the unclamped path.
+template<FfxSpdDownsampleFilter Filter, uint32_t Channels>
+static void spdReduceLevelClamped(const SpdCpuImage& src, uint32_t srcX, uint32_t srcY, float* dst, size_t dstPitch, uint32_t dstWidth, uint32_t dstHeight)
+{
+    const uint32_t innerWidth  = srcX < src.width ? ffxMin(dstWidth, (src.width - srcX) / 2) : 0;
+    const uint32_t innerHeight = srcY < src.height ? ffxMin(dstHeight, (src.height - srcY) / 2) : 0;
+    if (innerWidth && innerHeight)
+        spdReduceLevel<Filter, Channels>(src.data + srcY * src.pitch + srcX * Channels, src.pitch, dst, dstPitch, innerWidth, innerHeight);
+
+    for (uint32_t y = 0; y < dstHeight; ++y)
+    {
+        for (uint32_t x = (y < innerHeight ? innerWidth : 0); x < dstWidth; ++x)
+        {
+            float v[4][Channels];
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                const uint32_t sx = srcX + 2 * x + (i & 1);
+                const uint32_t sy = srcY + 2 * y + (i >> 1);
+                for (uint32_t c = 0; c < Channels; ++c)
+                    v[i][c] = (sx < src.width && sy < src.height) ? src.data[sy * src.pitch + sx * Channels + c] : 0.0f;
+            }
+            for (uint32_t c = 0; c < Channels; ++c)
+                dst[y * dstPitch + x * Channels + c] = spdReduce4<Filter>(v[0][c], v[1][c], v[2][c], v[3][c]);
+        }
+    }
+}
+
+// Copies the part of a strip level that lies inside its mip.
+template<uint32_t Channels>
+static void spdStoreLevel(const float* level, uint32_t levelWidth, uint32_t levelHeight, const SpdCpuImage& mip, uint32_t mipX, uint32_t mipY)
+{
+    if (mipX >= mip.width || mipY >= mip.height)
+        return;
+
+    const uint32_t width  = ffxMin(levelWidth, mip.width - mipX);
+    const uint32_t height = ffxMin(levelHeight, mip.height - mipY);
+    for (uint32_t y = 0; y < height; ++y)
+        memcpy(mip.data + (mipY + y) * mip.pitch + mipX * Channels, level + y * levelWidth * Channels, width * Channels * sizeof(float));
+}
+
+// Reduces tileCount 64x64 tiles in a row, starting at tile (tileX, tileY) of mips[firstMip - 1], into up to six following mips.
+// Tiles are aligned to every level, so the strip reduces as one wide image with the same result as separate tiles.
+template<FfxSpdDownsampleFilter Filter, uint32_t Channels>
+static void spdProcessStrip(const SpdCpuJob* job, uint32_t firstMip, uint32_t tileX, uint32_t tileY, uint32_t tileCount)
+{
+    // Ping-pong storage for the strip levels, the first level is 32 rows of 32 pixels per tile.
+    // Every second level goes to the smaller buffer, it is at most a quarter of the first one.
+    const uint32_t maxLevelSize = (SPD_CPU_TILE_SIZE / 2) * (SPD_CPU_TILE_SIZE / 2) * Channels * SPD_CPU_STRIP_TILES(Channels);
+    float          level0[maxLevelSize];
+    float          level1[maxLevelSize / 4];
+    float*         levels[2] = { level0, level1 };
+
+    const SpdCpuImage& src         = job->mips[firstMip - 1];
+    const uint32_t     srcX        = tileX * SPD_CPU_TILE_SIZE;
+    const uint32_t     srcY        = tileY * SPD_CPU_TILE_SIZE;
+    const uint32_t     lastMip     = ffxMin(job->mipCount, firstMip + SPD_CPU_TILE_MIP_COUNT - 1);
+    uint32_t           levelSize   = SPD_CPU_TILE_SIZE / 2;
+    uint32_t           levelWidth  = levelSize * tileCount;
+
+    if (srcX + SPD_CPU_TILE_SIZE * tileCount <= src.width && srcY + SPD_CPU_TILE_SIZE <= src.height)
+        spdReduceLevel<Filter, Channels>(src.data + srcY * src.pitch + srcX * Channels, src.pitch, levels[0], levelWidth * Channels, levelWidth, levelSize);
+    else
+        spdReduceLevelClamped<Filter, Channels>(src, srcX, srcY, levels[0], levelWidth * Channels, levelWidth, levelSize);
+    spdStoreLevel<Channels>(levels[0], levelWidth, levelSize, job->mips[firstMip], tileX * levelSize, tileY * levelSize);
+
+    for (uint32_t mip = firstMip + 1; mip <= lastMip; ++mip)
+    {
+        const float* level     = levels[(mip - firstMip - 1) & 1];
+        float*       nextLevel = levels[(mip - firstMip) & 1];
+        spdReduceLevel<Filter, Channels>(level, levelWidth * Channels, nextLevel, (levelWidth / 2) * Channels, levelWidth / 2, levelSize / 2);
+        levelSize  /= 2;
+        levelWidth /= 2;
+        spdStoreLevel<Channels>(nextLevel, levelWidth, levelSize, job->mips[mip], tileX * levelSize, tileY * levelSize);
+    }
+}
+
+template<FfxSpdDownsampleFilter Filter, uint32_t Channels>
+static void spdRunStrip(void* pTaskData, uint32_t stripIndex)
+{
+    SpdCpuJob*     job       = static_cast<SpdCpuJob*>(pTaskData);
+    const uint32_t tileX     = (stripIndex % job->stripCountX) * job->stripTiles;
+    const uint32_t tileCount = ffxMin(job->stripTiles, job->tileCountX - tileX);
+    spdProcessStrip<Filter, Channels>(job, 1, tileX, stripIndex / job->stripCountX, tileCount);
+
+    // Like the global atomic on the GPU, whoever completes the last strip finishes the chain.
+    if (job->mipCount > SPD_CPU_TILE_MIP_COUNT && job->completedStrips.fetch_add(1, std::memory_order_acq_rel) + 1 == job->stripCount)
+        spdProcessStrip<Filter, Channels>(job, SPD_CPU_TILE_MIP_COUNT + 1, 0, 0, 1);
+}
+
+template<FfxSpdDownsampleFilter Filter>
+static FfxSpdCpuTaskFunc spdGetTileFunc(uint32_t channelCount)
+{
+    switch (channelCount)
+    {
+    case 1: return spdRunStrip<Filter, 1>;
+    case 2: return spdRunStrip<Filter, 2>;
+    case 3: return spdRunStrip<Filter, 3>;
+    case 4: return spdRunStrip<Filter, 4>;
+    default: return nullptr;
+    }
+}
+
+static FfxSpdCpuTaskFunc spdGetTileFunc(FfxSpdDownsampleFilter filter, uint32_t channelCount)
+{
+    switch (filter)
+    {
+    case FFX_SPD_DOWNSAMPLE_FILTER_MEAN: return spdGetTileFunc<FFX_SPD_DOWNSAMPLE_FILTER_MEAN>(channelCount);
+    case FFX_SPD_DOWNSAMPLE_FILTER_MIN:  return spdGetTileFunc<FFX_SPD_DOWNSAMPLE_FILTER_MIN>(channelCount);
+    case FFX_SPD_DOWNSAMPLE_FILTER_MAX:  return spdGetTileFunc<FFX_SPD_DOWNSAMPLE_FILTER_MAX>(channelCount);
+    default: return nullptr;
+    }
+}
+
+// Default parallel for, workers pull strips until none are left.
+static void spdRunWorker(SpdCpuJob* job, FfxSpdCpuTaskFunc fpTask)
+{
+    for (uint32_t strip = job->nextStrip.fetch_add(1, std::memory_order_relaxed); strip < job->stripCount; strip = job->nextStrip.fetch_add(1, std::memory_order_relaxed))
+        fpTask(job, strip);
+}
+
+FfxErrorCode ffxSpdDownsampleCpu(const FfxSpdCpuDownsampleDescription* pDescription)
+{
+    FFX_RETURN_ON_ERROR(pDescription, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pDescription->pSource, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(pDescription->width && pDescription->height, FFX_ERROR_INVALID_SIZE);
+
+    const FfxSpdCpuTaskFunc fpTileFunc = spdGetTileFunc(pDescription->downsampleFilter, pDescription->channelCount);
+    FFX_RETURN_ON_ERROR(fpTileFunc, FFX_ERROR_INVALID_ARGUMENT);
+
+    // Same mip count as ffxSpdSetup() when not specified.
+    uint32_t mipCount = pDescription->mipCount;
+    if (mipCount == 0)
+    {
+        const uint32_t resolution = ffxMax(pDescription->width, pDescription->height);
+        while (mipCount < SPD_MAX_MIP_LEVELS && (resolution >> (mipCount + 1)) != 0)
+            ++mipCount;
+    }
+    FFX_RETURN_ON_ERROR(mipCount <= SPD_MAX_MIP_LEVELS, FFX_ERROR_INVALID_ARGUMENT);
+
+    // Past mip 6 a single tile finishes the chain, so mip 6 must fit in it.
+    FFX_RETURN_ON_ERROR(mipCount <= SPD_CPU_TILE_MIP_COUNT || (pDescription->width <= 4096 && pDescription->height <= 4096), FFX_ERROR_INVALID_SIZE);
+
+    if (mipCount == 0)
+        return FFX_OK;
+
+    const size_t pixelSize = pDescription->channelCount * sizeof(float);
+    FFX_RETURN_ON_ERROR(pDescription->sourceRowPitch >= pDescription->width * pixelSize && pDescription->sourceRowPitch % sizeof(float) == 0, FFX_ERROR_INVALID_SIZE);
+
+    SpdCpuJob job;
+    job.mipCount    = mipCount;
+    job.mips[0].data   = const_cast<float*>(pDescription->pSource);
+    job.mips[0].pitch  = pDescription->sourceRowPitch / sizeof(float);
+    job.mips[0].width  = pDescription->width;
+    job.mips[0].height = pDescription->height;
+
+    for (uint32_t mip = 1; mip <= mipCount; ++mip)
+    {
+        SpdCpuImage& image = job.mips[mip];
+        image.data   = pDescription->pMips[mip - 1];
+        image.width  = ffxMax(pDescription->width >> mip, 1u);
+        image.height = ffxMax(pDescription->height >> mip, 1u);
+
+        const size_t rowPitch = pDescription->mipRowPitches[mip - 1] ? pDescription->mipRowPitches[mip - 1] : image.width * pixelSize;
+        FFX_RETURN_ON_ERROR(image.data, FFX_ERROR_INVALID_POINTER);
+        FFX_RETURN_ON_ERROR(rowPitch >= image.width * pixelSize && rowPitch % sizeof(float) == 0, FFX_ERROR_INVALID_SIZE);
+        image.pitch = rowPitch / sizeof(float);
+    }
+
+    job.tileCountX  = (pDescription->width + SPD_CPU_TILE_SIZE - 1) / SPD_CPU_TILE_SIZE;
+    job.stripTiles  = SPD_CPU_STRIP_TILES(pDescription->channelCount);
+    job.stripCountX = (job.tileCountX + job.stripTiles - 1) / job.stripTiles;
+    job.stripCount  = job.stripCountX * ((pDescription->height + SPD_CPU_TILE_SIZE - 1) / SPD_CPU_TILE_SIZE);
+    job.nextStrip.store(0, std::memory_order_relaxed);
+    job.completedStrips.store(0, std::memory_order_relaxed);
+
+    if (pDescription->fpParallelFor)
+    {
+        pDescription->fpParallelFor(pDescription->pParallelForUserData, fpTileFunc, &job, job.stripCount);
+        return FFX_OK;
+    }
+
+    uint32_t threadCount = pDescription->threadCount ? pDescription->threadCount : std::thread::hardware_concurrency();
+    threadCount          = ffxMin(ffxMax(threadCount, 1u), job.stripCount);
+
+    // The calling thread is one of the workers.
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(spdRunWorker, &job, fpTileFunc);
+    spdRunWorker(&job, fpTileFunc);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    return FFX_OK;
+}
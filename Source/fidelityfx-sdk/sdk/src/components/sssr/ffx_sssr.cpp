@@ -23,6 +23,7 @@
 #include <string.h>     // for memset
 #include <math.h>       // for ceil, log2
 #include <algorithm>    // for max
+#include <vector>       // for vector
 using namespace std;
 
 #include <FidelityFX/host/ffx_sssr.h>
@@ -32,11 +33,6 @@ using namespace std;
 #include <FidelityFX/host/ffx_denoiser.h>
 #include "ffx_sssr_private.h"
 
-namespace _noiseBuffers
-{
-#include "samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp.cpp"
-}
-
 // lists to map shader resource bindpoint name to resource identifier
 typedef struct ResourceBinding
 {
@@ -57,8 +53,6 @@ static const ResourceBinding srvTextureBindingTable[] =
     {FFX_SSSR_RESOURCE_IDENTIFIER_RADIANCE_HISTORY,             L"r_radiance_history"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_VARIANCE,                     L"r_variance"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_EXTRACTED_ROUGHNESS,          L"r_extracted_roughness"},
-    {FFX_SSSR_RESOURCE_IDENTIFIER_SOBOL_BUFFER,                 L"r_sobol_buffer"},
-    {FFX_SSSR_RESOURCE_IDENTIFIER_SCRAMBLING_TILE_BUFFER,       L"r_scrambling_tile_buffer"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE,           L"r_blue_noise_texture"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_INPUT_BRDF_TEXTURE,           L"r_input_brdf_texture"},
 };
@@ -68,7 +62,6 @@ static const ResourceBinding uavTextureBindingTable[] =
     {FFX_SSSR_RESOURCE_IDENTIFIER_RADIANCE,                        L"rw_radiance"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_VARIANCE,                        L"rw_variance"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_EXTRACTED_ROUGHNESS,             L"rw_extracted_roughness"},
-    {FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE,              L"rw_blue_noise_texture"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_DEPTH_HIERARCHY,                 L"rw_depth_hierarchy"},
 };
 
@@ -213,9 +206,6 @@ static FfxErrorCode createPipelineStates(FfxSssrContext_Private* context)
     wcscpy_s(pipelineDescription.name, L"SSSR-CLASSIFY_TILES");
     FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(&context->contextDescription.backendInterface, FFX_EFFECT_SSSR, FFX_SSSR_PASS_CLASSIFY_TILES,
         getPipelinePermutationFlags(contextFlags, FFX_SSSR_PASS_CLASSIFY_TILES, supportedFP16, canForceWave64), &pipelineDescription, context->effectContextId, &context->pipelineClassifyTiles));
-    wcscpy_s(pipelineDescription.name, L"SSSR-PREPARE_BLUE_NOISE_TEXTURE");
-    FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(&context->contextDescription.backendInterface, FFX_EFFECT_SSSR, FFX_SSSR_PASS_PREPARE_BLUE_NOISE_TEXTURE, 
-        getPipelinePermutationFlags(contextFlags, FFX_SSSR_PASS_PREPARE_BLUE_NOISE_TEXTURE, supportedFP16, canForceWave64), &pipelineDescription, context->effectContextId, &context->pipelinePrepareBlueNoiseTexture));
     wcscpy_s(pipelineDescription.name, L"SSSR-PREPARE_INDIRECT_ARGS");
     FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(&context->contextDescription.backendInterface, FFX_EFFECT_SSSR, FFX_SSSR_PASS_PREPARE_INDIRECT_ARGS, 
         getPipelinePermutationFlags(contextFlags, FFX_SSSR_PASS_PREPARE_INDIRECT_ARGS, supportedFP16, canForceWave64), &pipelineDescription, context->effectContextId, &context->pipelinePrepareIndirectArgs));
@@ -227,11 +217,10 @@ static FfxErrorCode createPipelineStates(FfxSssrContext_Private* context)
         getPipelinePermutationFlags(contextFlags ,FFX_SSSR_PASS_INTERSECTION, supportedFP16, canForceWave64), &pipelineDescription, context->effectContextId, &context->pipelineIntersection));
 
     // for each pipeline: re-route/fix-up IDs based on names
-    FFX_ASSERT(patchResourceBindings(&context->pipelineDepthDownsample)         == FFX_OK);
-    FFX_ASSERT(patchResourceBindings(&context->pipelineClassifyTiles)           == FFX_OK);
-    FFX_ASSERT(patchResourceBindings(&context->pipelinePrepareBlueNoiseTexture) == FFX_OK);
-    FFX_ASSERT(patchResourceBindings(&context->pipelinePrepareIndirectArgs)     == FFX_OK);
-    FFX_ASSERT(patchResourceBindings(&context->pipelineIntersection)            == FFX_OK);
+    FFX_ASSERT(patchResourceBindings(&context->pipelineDepthDownsample)     == FFX_OK);
+    FFX_ASSERT(patchResourceBindings(&context->pipelineClassifyTiles)       == FFX_OK);
+    FFX_ASSERT(patchResourceBindings(&context->pipelinePrepareIndirectArgs) == FFX_OK);
+    FFX_ASSERT(patchResourceBindings(&context->pipelineIntersection)        == FFX_OK);
 
     return FFX_OK;
 }
@@ -269,6 +258,13 @@ static FfxErrorCode sssrCreate(FfxSssrContext_Private* context, const FfxSssrCon
     uint32_t depthHierarchyMipCount = (uint32_t)ceil(log2(max(contextDescription->renderSize.width, contextDescription->renderSize.height)));
     depthHierarchyMipCount = min(7u, depthHierarchyMipCount);  // We generate 6 mips from the input depth buffer and keep a copy of it at mip 0 
 
+    // The blue noise values do not depend on the frame, the intersection pass adds the offset of the frame.
+    const size_t blueNoiseRowPitch = FFX_SSSR_BLUE_NOISE_TILE_SIZE * 2;
+    const size_t blueNoiseSize     = blueNoiseRowPitch * FFX_SSSR_BLUE_NOISE_TILE_SIZE;
+    std::vector<uint8_t> blueNoiseData(blueNoiseSize);
+    uint8_t* blueNoise = blueNoiseData.data();
+    sssrGenerateBlueNoiseValues(blueNoise, blueNoiseRowPitch);
+
     const FfxInternalResourceDescription internalSurfaceDesc[] = {
 
         {FFX_SSSR_RESOURCE_IDENTIFIER_DEPTH_HIERARCHY,
@@ -381,38 +377,16 @@ static FfxErrorCode sssrCreate(FfxSssrContext_Private* context, const FfxSssrCon
          FFX_RESOURCE_FLAGS_NONE,
          {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
 
-        {FFX_SSSR_RESOURCE_IDENTIFIER_SOBOL_BUFFER,
-         L"SSSR_SobolBuffer",
-         FFX_RESOURCE_TYPE_TEXTURE2D,
-         FFX_RESOURCE_USAGE_READ_ONLY,
-         FFX_SURFACE_FORMAT_R32_UINT,
-         256,
-         256,
-         1,
-         FFX_RESOURCE_FLAGS_NONE,
-         {FFX_RESOURCE_INIT_DATA_TYPE_BUFFER, sizeof(_noiseBuffers::sobol_256spp_256d), (void*)_noiseBuffers::sobol_256spp_256d}},
-
-        {FFX_SSSR_RESOURCE_IDENTIFIER_SCRAMBLING_TILE_BUFFER,
-         L"SSSR_ScramblingTileBuffer",
-         FFX_RESOURCE_TYPE_TEXTURE2D,
-         FFX_RESOURCE_USAGE_READ_ONLY,
-         FFX_SURFACE_FORMAT_R32_UINT,
-         128 * 4,
-         128 * 2,
-         1,
-         FFX_RESOURCE_FLAGS_NONE,
-         {FFX_RESOURCE_INIT_DATA_TYPE_BUFFER, sizeof(_noiseBuffers::scramblingTile), (void*)_noiseBuffers::scramblingTile}},
-
         {FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE,
          L"SSSR_BlueNoiseTexture",
          FFX_RESOURCE_TYPE_TEXTURE2D,
-         FFX_RESOURCE_USAGE_UAV,
-         FFX_SURFACE_FORMAT_R8G8_UNORM,
-         128,
-         128,
+         FFX_RESOURCE_USAGE_READ_ONLY,
+         FFX_SURFACE_FORMAT_R8G8_UINT,
+         FFX_SSSR_BLUE_NOISE_TILE_SIZE,
+         FFX_SSSR_BLUE_NOISE_TILE_SIZE,
          1,
          FFX_RESOURCE_FLAGS_NONE,
-         {FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED}},
+         {FFX_RESOURCE_INIT_DATA_TYPE_BUFFER, blueNoiseSize, blueNoise}},
 
         {FFX_SSSR_RESOURCE_IDENTIFIER_SPD_GLOBAL_ATOMIC,
          L"SSSR_SpdAtomicCounter",
@@ -476,7 +450,6 @@ static FfxErrorCode sssrRelease(FfxSssrContext_Private* context)
 
     ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineDepthDownsample, context->effectContextId);
     ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineClassifyTiles, context->effectContextId);
-    ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelinePrepareBlueNoiseTexture, context->effectContextId);
     ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelinePrepareIndirectArgs, context->effectContextId);
     ffxSafeReleasePipeline(&context->contextDescription.backendInterface, &context->pipelineIntersection, context->effectContextId);
 
@@ -494,8 +467,7 @@ static FfxErrorCode sssrRelease(FfxSssrContext_Private* context)
     context->srvResources[FFX_SSSR_RESOURCE_IDENTIFIER_OUTPUT]                      = { FFX_SSSR_RESOURCE_IDENTIFIER_NULL };
 
     // Release the copy resources for those that had init data
-    ffxSafeReleaseCopyResource(&context->contextDescription.backendInterface, context->srvResources[FFX_SSSR_RESOURCE_IDENTIFIER_SOBOL_BUFFER], context->effectContextId);
-    ffxSafeReleaseCopyResource(&context->contextDescription.backendInterface, context->srvResources[FFX_SSSR_RESOURCE_IDENTIFIER_SCRAMBLING_TILE_BUFFER], context->effectContextId);
+    ffxSafeReleaseCopyResource(&context->contextDescription.backendInterface, context->srvResources[FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE], context->effectContextId);
     ffxSafeReleaseCopyResource(&context->contextDescription.backendInterface, context->srvResources[FFX_SSSR_RESOURCE_IDENTIFIER_SPD_GLOBAL_ATOMIC], context->effectContextId);
     ffxSafeReleaseCopyResource(&context->contextDescription.backendInterface, context->srvResources[FFX_SSSR_RESOURCE_IDENTIFIER_RAY_COUNTER], context->effectContextId);
 
@@ -682,7 +654,6 @@ static FfxErrorCode sssrDispatch(FfxSssrContext_Private* context, const FfxSssrD
 
     // SSSR
     scheduleDispatch(context, &context->pipelineClassifyTiles, DivideRoundingUp(width, 8u), DivideRoundingUp(height, 8u));
-    scheduleDispatch(context, &context->pipelinePrepareBlueNoiseTexture, 128 / 8u, 128 / 8u);
     scheduleDispatch(context, &context->pipelinePrepareIndirectArgs, 1, 1);
     scheduleIndirectDispatch(context, &context->pipelineIntersection, &context->uavResources[FFX_SSSR_RESOURCE_IDENTIFIER_INTERSECTION_PASS_INDIRECT_ARGS], 0);
 
@@ -0,0 +1,135 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// CPU side of the SSSR blue noise (Eric Heitz's sampler with the 1spp Sobol and scrambling tables).
+// The context uploads the frame independent scrambled values once and the intersection pass adds
+// the golden ratio offset of the frame with FFX_SSSR_BlueNoiseSampleUnorm8. ffxSssrGenerateBlueNoiseCpu
+// produces the samples of a frame with that same function, or four pixels at a time with SSE2
+// where available. FFX_SSSR_CPU_SSE2 can be defined to 0 to build the scalar path only.
+
+#include <cmath>     // for floor, nearbyint
+
+#include <FidelityFX/host/ffx_sssr.h>
+
+#define FFX_CPU
+#include <FidelityFX/gpu/ffx_core.h>
+#include <FidelityFX/gpu/sssr/ffx_sssr_blue_noise.h>
+
+#include "ffx_sssr_private.h"
+
+#if !defined(FFX_SSSR_CPU_SSE2)
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define FFX_SSSR_CPU_SSE2 1
+#else
+#define FFX_SSSR_CPU_SSE2 0
+#endif
+#endif // #if !defined(FFX_SSSR_CPU_SSE2)
+
+#if FFX_SSSR_CPU_SSE2
+#include <emmintrin.h>
+#endif // #if FFX_SSSR_CPU_SSE2
+
+namespace _noiseBuffers
+{
+#include "samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp.cpp"
+}
+
+// SampleRandomNumber() with sample_index 0 before the conversion to float: the Sobol value of
+// the dimension xor'd with the scrambling tile entry of the pixel.
+static inline uint32_t sssrBlueNoiseValue(uint32_t pixelI, uint32_t pixelJ, uint32_t sampleDimension)
+{
+    const uint32_t originalIndex = (sampleDimension % 8u) + (pixelI + pixelJ * FFX_SSSR_BLUE_NOISE_TILE_SIZE) * 8u;
+    return uint32_t(_noiseBuffers::sobol_256spp_256d[sampleDimension & 255u]) ^ uint32_t(_noiseBuffers::scramblingTile[originalIndex]);
+}
+
+#if FFX_SSSR_CPU_SSE2
+
+// Four consecutive pixels of one dimension, the scrambling entries are 8 apart so they are gathered.
+static inline __m128i sssrBlueNoiseSampleUnorm8x4(uint32_t pixelI, uint32_t pixelJ, uint32_t sampleDimension, __m128 frameOffset)
+{
+    const int* scrambling = _noiseBuffers::scramblingTile + (sampleDimension % 8u) + (pixelI + pixelJ * FFX_SSSR_BLUE_NOISE_TILE_SIZE) * 8u;
+    const __m128i value   = _mm_xor_si128(_mm_set_epi32(scrambling[24], scrambling[16], scrambling[8], scrambling[0]),
+                                          _mm_set1_epi32(_noiseBuffers::sobol_256spp_256d[sampleDimension & 255u]));
+
+    // The values are positive, so truncation is floor() and the fraction is exact as in ffxFract.
+    const __m128 sample   = _mm_div_ps(_mm_add_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(0.5f)), _mm_set1_ps(256.0f));
+    const __m128 sum      = _mm_add_ps(sample, frameOffset);
+    const __m128 fraction = _mm_sub_ps(sum, _mm_cvtepi32_ps(_mm_cvttps_epi32(sum)));
+
+    // _mm_cvtps_epi32 rounds with the MXCSR mode, round to nearest even like ffxRound.
+    const __m128 saturated = _mm_min_ps(_mm_max_ps(fraction, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(saturated, _mm_set1_ps(255.0f)));
+}
+
+static void sssrGenerateBlueNoiseRow(uint32_t pixelJ, uint32_t frameIndex, uint8_t* pOutput)
+{
+    // Same product FFX_SSSR_BlueNoiseSampleUnorm8 forms from the wrapped frame index.
+    const __m128 offset = _mm_set1_ps(FfxFloat32(frameIndex & 0xFFu) * FFX_SSSR_BLUE_NOISE_GOLDEN_RATIO);
+    for (uint32_t pixelI = 0; pixelI < FFX_SSSR_BLUE_NOISE_TILE_SIZE; pixelI += 4)
+    {
+        const __m128i r = sssrBlueNoiseSampleUnorm8x4(pixelI, pixelJ, 0, offset);
+        const __m128i g = sssrBlueNoiseSampleUnorm8x4(pixelI, pixelJ, 1, offset);
+
+        // Narrow both channels to bytes and interleave them into four RG8 texels.
+        const __m128i rBytes = _mm_packus_epi16(_mm_packs_epi32(r, r), _mm_setzero_si128());
+        const __m128i gBytes = _mm_packus_epi16(_mm_packs_epi32(g, g), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pOutput + pixelI * 2), _mm_unpacklo_epi8(rBytes, gBytes));
+    }
+}
+
+#else
+
+static void sssrGenerateBlueNoiseRow(uint32_t pixelJ, uint32_t frameIndex, uint8_t* pOutput)
+{
+    for (uint32_t pixelI = 0; pixelI < FFX_SSSR_BLUE_NOISE_TILE_SIZE; ++pixelI)
+    {
+        pOutput[pixelI * 2 + 0] = uint8_t(FFX_SSSR_BlueNoiseSampleUnorm8(sssrBlueNoiseValue(pixelI, pixelJ, 0), frameIndex));
+        pOutput[pixelI * 2 + 1] = uint8_t(FFX_SSSR_BlueNoiseSampleUnorm8(sssrBlueNoiseValue(pixelI, pixelJ, 1), frameIndex));
+    }
+}
+
+#endif  // #if FFX_SSSR_CPU_SSE2
+
+void sssrGenerateBlueNoiseValues(uint8_t* pOutput, size_t rowPitch)
+{
+    for (uint32_t pixelJ = 0; pixelJ < FFX_SSSR_BLUE_NOISE_TILE_SIZE; ++pixelJ)
+    {
+        uint8_t* row = pOutput + pixelJ * rowPitch;
+        for (uint32_t pixelI = 0; pixelI < FFX_SSSR_BLUE_NOISE_TILE_SIZE; ++pixelI)
+        {
+            row[pixelI * 2 + 0] = uint8_t(sssrBlueNoiseValue(pixelI, pixelJ, 0));
+            row[pixelI * 2 + 1] = uint8_t(sssrBlueNoiseValue(pixelI, pixelJ, 1));
+        }
+    }
+}
+
+FfxErrorCode ffxSssrGenerateBlueNoiseCpu(uint32_t frameIndex, uint8_t* pOutput, size_t rowPitch)
+{
+    FFX_RETURN_ON_ERROR(pOutput, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(rowPitch >= FFX_SSSR_BLUE_NOISE_TILE_SIZE * 2, FFX_ERROR_INVALID_SIZE);
+
+    for (uint32_t pixelJ = 0; pixelJ < FFX_SSSR_BLUE_NOISE_TILE_SIZE; ++pixelJ)
+        sssrGenerateBlueNoiseRow(pixelJ, frameIndex, pOutput + pixelJ * rowPitch);
+
+    return FFX_OK;
+}
@@ -70,7 +70,6 @@ typedef struct FfxSssrContext_Private
     FfxDeviceCapabilities       deviceCapabilities;
     FfxPipelineState            pipelineDepthDownsample;
     FfxPipelineState            pipelineClassifyTiles;
-    FfxPipelineState            pipelinePrepareBlueNoiseTexture;
     FfxPipelineState            pipelinePrepareIndirectArgs;
     FfxPipelineState            pipelineIntersection;
 
@@ -83,3 +82,7 @@ typedef struct FfxSssrContext_Private
     bool        refreshPipelineStates;
     uint32_t    resourceFrameIndex;
 } FfxSssrContext_Private;
+
+// Writes the frame independent blue noise values of the first two dimensions to a 128x128 RG8
+// UINT tile, the contents of the blue noise texture. See ffx_sssr_blue_noise.h for their use.
+void sssrGenerateBlueNoiseValues(uint8_t* pOutput, size_t rowPitch);
@@ -0,0 +1,343 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Blur pipeline residency over a fake backend that only counts pipelines.
+// Checks that pipelines are compiled on their first dispatch or from a prewarm profile, that maxResidentPipelines
+// evicts the least recently used one, that evicted pipelines are destroyed FFX_MAX_QUEUED_FRAMES frames later,
+// on ffxBlurContextReleaseEvictedPipelines or on destroy, and that the statistics follow.
+
+#include <FidelityFX/host/ffx_blur.h>
+#include "ffx_test.h"
+
+#include <cstring>
+#include <cwchar>
+#include <set>
+#include <string>
+
+// Every pipeline the fake backend created and has not destroyed yet, by the name the effect gave it.
+static std::set<std::wstring> s_LivePipelines;
+static uint32_t               s_CreatedPipelineCount = 0;
+static std::wstring           s_LastDispatchedPipeline;
+
+static FfxVersionNumber getSDKVersion(FfxInterface*)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+static FfxErrorCode createBackendContext(FfxInterface*, FfxEffect, FfxEffectBindlessConfig*, FfxUInt32* effectContextId)
+{
+    *effectContextId = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode getDeviceCapabilities(FfxInterface*, FfxDeviceCapabilities* deviceCapabilities)
+{
+    memset(deviceCapabilities, 0, sizeof(*deviceCapabilities));
+    deviceCapabilities->maximumSupportedShaderModel = FFX_SHADER_MODEL_6_6;
+    deviceCapabilities->waveLaneCountMin            = 32;
+    deviceCapabilities->waveLaneCountMax            = 64;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyBackendContext(FfxInterface*, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode createPipeline(FfxInterface*, FfxEffect, FfxPass, uint32_t, const FfxPipelineDescription* pipelineDescription, FfxUInt32, FfxPipelineState* outPipeline)
+{
+    // The pipeline object points at its name in the live set, set nodes do not move
+    const auto inserted = s_LivePipelines.insert(pipelineDescription->name);
+    FFX_TEST_CHECK(inserted.second);
+    outPipeline->pipeline = (FfxPipeline)&*inserted.first;
+    ++s_CreatedPipelineCount;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyPipeline(FfxInterface*, FfxPipelineState* pipeline, FfxUInt32)
+{
+    FFX_TEST_CHECK(pipeline->pipeline != nullptr);
+    if (pipeline->pipeline != nullptr)
+        s_LivePipelines.erase(*(const std::wstring*)pipeline->pipeline);
+    pipeline->pipeline = nullptr;
+    return FFX_OK;
+}
+
+static FfxErrorCode registerResource(FfxInterface*, const FfxResource*, FfxUInt32, FfxResourceInternal* outResource)
+{
+    outResource->internalIndex = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode unregisterResources(FfxInterface*, FfxCommandList, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode stageConstantBufferData(FfxInterface*, void*, FfxUInt32, FfxConstantBuffer*)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode scheduleGpuJob(FfxInterface*, const FfxGpuJobDescription* job)
+{
+    const FfxPipeline pipeline = job->computeJobDescriptor.pipeline.pipeline;
+    FFX_TEST_CHECK(pipeline != nullptr);
+    s_LastDispatchedPipeline = pipeline ? *(const std::wstring*)pipeline : std::wstring();
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobs(FfxInterface*, FfxCommandList, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxBlurContextDescription makeContextDescription(uint32_t maxResidentPipelines, const FfxBlurPipelineUsageProfile* pPrewarmProfile)
+{
+    FfxBlurContextDescription contextDescription = {};
+    contextDescription.kernelPermutations = FFX_BLUR_KERNEL_PERMUTATIONS_ALL;
+    contextDescription.kernelSizes        = FFX_BLUR_KERNEL_SIZE_ALL;
+    contextDescription.floatPrecision     = FFX_BLUR_FLOAT_PRECISION_32BIT;
+
+    FfxInterface& backendInterface                 = contextDescription.backendInterface;
+    backendInterface.fpGetSDKVersion               = getSDKVersion;
+    backendInterface.fpCreateBackendContext        = createBackendContext;
+    backendInterface.fpGetDeviceCapabilities       = getDeviceCapabilities;
+    backendInterface.fpDestroyBackendContext       = destroyBackendContext;
+    backendInterface.fpCreatePipeline              = createPipeline;
+    backendInterface.fpDestroyPipeline             = destroyPipeline;
+    backendInterface.fpRegisterResource            = registerResource;
+    backendInterface.fpUnregisterResources         = unregisterResources;
+    backendInterface.fpStageConstantBufferDataFunc = stageConstantBufferData;
+    backendInterface.fpScheduleGpuJob              = scheduleGpuJob;
+    backendInterface.fpExecuteGpuJobs              = executeGpuJobs;
+    backendInterface.device                        = (FfxDevice)&s_LivePipelines;
+
+    contextDescription.maxResidentPipelines = maxResidentPipelines;
+    contextDescription.pPrewarmProfile      = pPrewarmProfile;
+    return contextDescription;
+}
+
+static FfxErrorCode dispatch(FfxBlurContext& context, FfxBlurKernelPermutation kernelPermutation, FfxBlurKernelSize kernelSize, uint64_t frameIndex)
+{
+    FfxBlurDispatchDescription dispatchDescription = {};
+    dispatchDescription.kernelPermutation  = kernelPermutation;
+    dispatchDescription.kernelSize         = kernelSize;
+    dispatchDescription.inputAndOutputSize = {1920, 1080};
+    dispatchDescription.frameIndex         = frameIndex;
+    return ffxBlurContextDispatch(&context, &dispatchDescription);
+}
+
+static FfxBlurPipelineStatistics getStatistics(FfxBlurContext& context)
+{
+    FfxBlurPipelineStatistics statistics = {};
+    FFX_TEST_CHECK(ffxBlurContextGetPipelineStatistics(&context, &statistics) == FFX_OK);
+    return statistics;
+}
+
+static void resetBackend()
+{
+    s_LivePipelines.clear();
+    s_CreatedPipelineCount = 0;
+    s_LastDispatchedPipeline.clear();
+}
+
+// Nothing is compiled upfront, each pipeline once on its first dispatch.
+static void testLazyCreation()
+{
+    resetBackend();
+
+    FfxBlurContext                  context;
+    const FfxBlurContextDescription contextDescription = makeContextDescription(0, nullptr);
+    FFX_TEST_CHECK(ffxBlurContextCreate(&context, &contextDescription) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 0);
+    FFX_TEST_CHECK(getStatistics(context).residentPipelineCount == 0);
+
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_1, FFX_BLUR_KERNEL_SIZE_9x9, 0) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 1);
+    FFX_TEST_CHECK(s_LastDispatchedPipeline == L"BLUR-BLUR_PERM1_9x9");
+
+    for (uint64_t frameIndex = 1; frameIndex < 16; ++frameIndex)
+        FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_1, FFX_BLUR_KERNEL_SIZE_9x9, frameIndex) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 1);
+
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_2, FFX_BLUR_KERNEL_SIZE_21x21, 16) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 2);
+    FFX_TEST_CHECK(s_LastDispatchedPipeline == L"BLUR-BLUR_PERM2_21x21");
+
+    const FfxBlurPipelineStatistics statistics = getStatistics(context);
+    FFX_TEST_CHECK(statistics.residentPipelineCount == 2);
+    FFX_TEST_CHECK(statistics.peakResidentPipelineCount == 2);
+    FFX_TEST_CHECK(statistics.compiledPipelineCount == 2);
+    FFX_TEST_CHECK(statistics.evictedPipelineCount == 0);
+    FFX_TEST_CHECK(statistics.retiredPipelineCount == 0);
+
+    FfxBlurPipelineUsageProfile usage = {};
+    FFX_TEST_CHECK(ffxBlurContextGetPipelineUsage(&context, &usage) == FFX_OK);
+    FFX_TEST_CHECK(usage.kernelSizes[0] == 0);
+    FFX_TEST_CHECK(usage.kernelSizes[1] == FFX_BLUR_KERNEL_SIZE_9x9);
+    FFX_TEST_CHECK(usage.kernelSizes[2] == FFX_BLUR_KERNEL_SIZE_21x21);
+
+    FFX_TEST_CHECK(ffxBlurContextDestroy(&context) == FFX_OK);
+    FFX_TEST_CHECK(s_LivePipelines.empty());
+}
+
+// A usage profile from one context prewarms the next, which then compiles nothing on dispatch.
+static void testPrewarm()
+{
+    resetBackend();
+
+    FfxBlurPipelineUsageProfile profile = {};
+    profile.kernelSizes[0] = FFX_BLUR_KERNEL_SIZE_3x3 | FFX_BLUR_KERNEL_SIZE_5x5;
+    profile.kernelSizes[2] = FFX_BLUR_KERNEL_SIZE_15x15;
+
+    FfxBlurContext                  context;
+    const FfxBlurContextDescription contextDescription = makeContextDescription(0, &profile);
+    FFX_TEST_CHECK(ffxBlurContextCreate(&context, &contextDescription) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 3);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM0_3x3") == 1);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM0_5x5") == 1);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM2_15x15") == 1);
+
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_5x5, 0) == FFX_OK);
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_2, FFX_BLUR_KERNEL_SIZE_15x15, 1) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 3);
+
+    const FfxBlurPipelineStatistics statistics = getStatistics(context);
+    FFX_TEST_CHECK(statistics.residentPipelineCount == 3);
+    FFX_TEST_CHECK(statistics.compiledPipelineCount == 3);
+
+    FFX_TEST_CHECK(ffxBlurContextDestroy(&context) == FFX_OK);
+    FFX_TEST_CHECK(s_LivePipelines.empty());
+
+    // Prewarming stops at the residency limit rather than evicting what it just compiled
+    resetBackend();
+    const FfxBlurContextDescription limitedDescription = makeContextDescription(2, &profile);
+    FFX_TEST_CHECK(ffxBlurContextCreate(&context, &limitedDescription) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 2);
+    FFX_TEST_CHECK(getStatistics(context).evictedPipelineCount == 0);
+    FFX_TEST_CHECK(ffxBlurContextDestroy(&context) == FFX_OK);
+    FFX_TEST_CHECK(s_LivePipelines.empty());
+}
+
+// Past the limit the least recently dispatched pipeline is evicted, and destroyed once frames in flight are done with it.
+static void testEviction()
+{
+    resetBackend();
+
+    FfxBlurContext                  context;
+    const FfxBlurContextDescription contextDescription = makeContextDescription(3, nullptr);
+    FFX_TEST_CHECK(ffxBlurContextCreate(&context, &contextDescription) == FFX_OK);
+
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_3x3, 10) == FFX_OK);
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_5x5, 10) == FFX_OK);
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_7x7, 10) == FFX_OK);
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_3x3, 11) == FFX_OK);
+
+    // 5x5 is now the least recently used
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_1, FFX_BLUR_KERNEL_SIZE_3x3, 11) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 4);
+
+    FfxBlurPipelineStatistics statistics = getStatistics(context);
+    FFX_TEST_CHECK(statistics.residentPipelineCount == 3);
+    FFX_TEST_CHECK(statistics.peakResidentPipelineCount == 3);
+    FFX_TEST_CHECK(statistics.evictedPipelineCount == 1);
+    FFX_TEST_CHECK(statistics.retiredPipelineCount == 1);
+
+    // Evicted but not destroyed, a frame in flight may still use it
+    FFX_TEST_CHECK(s_LivePipelines.size() == 4);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM0_5x5") == 1);
+
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_3x3, 11 + FFX_MAX_QUEUED_FRAMES - 1) == FFX_OK);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM0_5x5") == 1);
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_3x3, 11 + FFX_MAX_QUEUED_FRAMES) == FFX_OK);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM0_5x5") == 0);
+    FFX_TEST_CHECK(s_LivePipelines.size() == 3);
+    FFX_TEST_CHECK(getStatistics(context).retiredPipelineCount == 0);
+
+    // Dispatching it again compiles it again, evicting 7x7 which was used least recently since
+    const uint64_t frameIndex = 11 + FFX_MAX_QUEUED_FRAMES;
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_5x5, frameIndex) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 5);
+    FFX_TEST_CHECK(s_LastDispatchedPipeline == L"BLUR-BLUR_PERM0_5x5");
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM0_7x7") == 1);
+
+    // An evicted pipeline dispatched again before it was destroyed is taken back without compiling
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_0, FFX_BLUR_KERNEL_SIZE_7x7, frameIndex) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == 5);
+    FFX_TEST_CHECK(s_LastDispatchedPipeline == L"BLUR-BLUR_PERM0_7x7");
+
+    statistics = getStatistics(context);
+    FFX_TEST_CHECK(statistics.residentPipelineCount == 3);
+    FFX_TEST_CHECK(statistics.compiledPipelineCount == 5);
+    FFX_TEST_CHECK(statistics.evictedPipelineCount == 3);
+    FFX_TEST_CHECK(statistics.retiredPipelineCount == 1);
+
+    // Destroying releases resident and retired pipelines alike
+    FFX_TEST_CHECK(ffxBlurContextDestroy(&context) == FFX_OK);
+    FFX_TEST_CHECK(s_LivePipelines.empty());
+}
+
+// With frameIndex left at 0 evicted pipelines wait for ffxBlurContextReleaseEvictedPipelines.
+static void testReleaseWithoutFrameIndex()
+{
+    resetBackend();
+
+    FfxBlurContext                  context;
+    const FfxBlurContextDescription contextDescription = makeContextDescription(2, nullptr);
+    FFX_TEST_CHECK(ffxBlurContextCreate(&context, &contextDescription) == FFX_OK);
+
+    uint32_t kernelSize = FFX_BLUR_KERNEL_SIZE_3x3;
+    for (uint32_t sizeIndex = 0; sizeIndex < FFX_BLUR_KERNEL_SIZE_COUNT; ++sizeIndex, kernelSize <<= 1)
+        FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_2, (FfxBlurKernelSize)kernelSize, 0) == FFX_OK);
+
+    FfxBlurPipelineStatistics statistics = getStatistics(context);
+    FFX_TEST_CHECK(statistics.residentPipelineCount == 2);
+    FFX_TEST_CHECK(statistics.evictedPipelineCount == FFX_BLUR_KERNEL_SIZE_COUNT - 2);
+    FFX_TEST_CHECK(statistics.retiredPipelineCount == FFX_BLUR_KERNEL_SIZE_COUNT - 2);
+    FFX_TEST_CHECK(s_LivePipelines.size() == FFX_BLUR_KERNEL_SIZE_COUNT);
+
+    FFX_TEST_CHECK(ffxBlurContextReleaseEvictedPipelines(&context) == FFX_OK);
+    FFX_TEST_CHECK(getStatistics(context).retiredPipelineCount == 0);
+    FFX_TEST_CHECK(s_LivePipelines.size() == 2);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM2_19x19") == 1);
+    FFX_TEST_CHECK(s_LivePipelines.count(L"BLUR-BLUR_PERM2_21x21") == 1);
+
+    // The resident ones keep working
+    FFX_TEST_CHECK(dispatch(context, FFX_BLUR_KERNEL_PERMUTATION_2, FFX_BLUR_KERNEL_SIZE_19x19, 0) == FFX_OK);
+    FFX_TEST_CHECK(s_CreatedPipelineCount == FFX_BLUR_KERNEL_SIZE_COUNT);
+
+    FFX_TEST_CHECK(ffxBlurContextReleaseEvictedPipelines(nullptr) == FFX_ERROR_INVALID_POINTER);
+    FFX_TEST_CHECK(ffxBlurContextDestroy(&context) == FFX_OK);
+    FFX_TEST_CHECK(s_LivePipelines.empty());
+}
+
+int main()
+{
+    testLazyCreation();
+    testPrewarm();
+    testEviction();
+    testReleaseWithoutFrameIndex();
+
+    return FFX_TEST_RESULT();
+}
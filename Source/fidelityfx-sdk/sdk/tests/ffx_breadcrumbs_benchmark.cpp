@@ -0,0 +1,213 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Breadcrumbs recording cost with thousands of command lists and markers per frame, over a fake backend that writes
+// markers into host memory. Records more frames than the history holds so frame slots are reused, checks that frames
+// recorded into a reused slot do no host or marker block allocations, and that the status still holds every marker.
+
+#include <FidelityFX/host/ffx_breadcrumbs.h>
+#include "ffx_test.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static constexpr uint32_t s_FrameHistoryLength = 2;
+static constexpr uint32_t s_FrameCount         = 8;
+static constexpr uint32_t s_ListCount          = 2000;
+static constexpr uint32_t s_MarkersPerList     = 100;
+static constexpr uint32_t s_PipelineCount      = 64;
+
+static uint32_t s_HostAllocations  = 0;
+static uint32_t s_BlockAllocations = 0;
+
+static void* countedAlloc(size_t size)
+{
+    ++s_HostAllocations;
+    return malloc(size);
+}
+
+static void* countedRealloc(void* pMemory, size_t size)
+{
+    ++s_HostAllocations;
+    return realloc(pMemory, size);
+}
+
+static FfxVersionNumber getSDKVersion(FfxInterface*)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+static FfxErrorCode createBackendContext(FfxInterface*, FfxEffect, FfxEffectBindlessConfig*, FfxUInt32* effectContextId)
+{
+    *effectContextId = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyBackendContext(FfxInterface*, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode allocBlock(FfxInterface*, uint64_t blockBytes, FfxBreadcrumbsBlockData* blockData)
+{
+    ++s_BlockAllocations;
+    blockData->memory      = calloc(1, (size_t)blockBytes);
+    blockData->heap        = blockData->memory;
+    blockData->buffer      = blockData->memory;
+    blockData->baseAddress = (uint64_t)(uintptr_t)blockData->memory;
+    blockData->nextMarker  = 0;
+    return blockData->memory ? FFX_OK : FFX_ERROR_OUT_OF_MEMORY;
+}
+
+static void freeBlock(FfxInterface*, FfxBreadcrumbsBlockData* blockData)
+{
+    free(blockData->memory);
+    blockData->memory = blockData->heap = blockData->buffer = nullptr;
+}
+
+// Writes land immediately, as if the GPU executed every marker.
+static void writeMarker(FfxInterface*, FfxCommandList, uint32_t value, uint64_t gpuLocation, void*, bool)
+{
+    *(uint32_t*)(uintptr_t)gpuLocation = value;
+}
+
+static size_t countOccurrences(const std::string& text, const char* pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        ++count;
+    return count;
+}
+
+static FfxCommandList getCommandList(uint32_t index)
+{
+    // Aligned like real handles.
+    return (FfxCommandList)(uintptr_t)(0x10000 + index * 64);
+}
+
+static FfxPipeline getPipeline(uint32_t index)
+{
+    return (FfxPipeline)(uintptr_t)(0x1000000 + index * 64);
+}
+
+static void recordFrame(FfxBreadcrumbsContext* context)
+{
+    FFX_TEST_CHECK(ffxBreadcrumbsStartFrame(context) == FFX_OK);
+
+    for (uint32_t l = 0; l < s_ListCount; ++l)
+    {
+        FfxBreadcrumbsCommandListDescription list = {};
+        list.commandList = getCommandList(l);
+        list.name        = { "Copied list name", true };
+        FFX_TEST_CHECK(ffxBreadcrumbsRegisterCommandList(context, &list) == FFX_OK);
+    }
+
+    // Lists are recorded interleaved, the way several recording threads would feed them, so every marker looks its list up.
+    const FfxBreadcrumbsNameTag passName     = { "Pass", false };
+    const FfxBreadcrumbsNameTag dispatchName = { nullptr, false };
+    for (uint32_t m = 0; m < s_MarkersPerList; m += 5)
+    {
+        for (uint32_t l = 0; l < s_ListCount; ++l)
+        {
+            const FfxCommandList commandList = getCommandList(l);
+            FFX_TEST_CHECK(ffxBreadcrumbsBeginMarker(context, commandList, FFX_BREADCRUMBS_MARKER_PASS, &passName) == FFX_OK);
+            ffxBreadcrumbsSetPipeline(context, commandList, getPipeline((l + m) % s_PipelineCount));
+            for (uint32_t d = 0; d < 4; ++d)
+            {
+                FFX_TEST_CHECK(ffxBreadcrumbsBeginMarker(context, commandList, FFX_BREADCRUMBS_MARKER_DISPATCH, &dispatchName) == FFX_OK);
+                FFX_TEST_CHECK(ffxBreadcrumbsEndMarker(context, commandList) == FFX_OK);
+            }
+            FFX_TEST_CHECK(ffxBreadcrumbsEndMarker(context, commandList) == FFX_OK);
+        }
+    }
+}
+
+int main()
+{
+    static uint32_t queues[] = { 0 };
+
+    FfxBreadcrumbsContextDescription description = {};
+    description.flags = FFX_BREADCRUMBS_PRINT_FINISHED_LISTS | FFX_BREADCRUMBS_PRINT_FINISHED_NODES | FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO;
+    description.frameHistoryLength       = s_FrameHistoryLength;
+    description.maxMarkersPerMemoryBlock = 10000;
+    description.usedGpuQueuesCount       = 1;
+    description.pUsedGpuQueues           = queues;
+    description.allocCallbacks           = { countedAlloc, countedRealloc, free };
+    description.backendInterface.fpGetSDKVersion         = getSDKVersion;
+    description.backendInterface.fpCreateBackendContext  = createBackendContext;
+    description.backendInterface.fpDestroyBackendContext = destroyBackendContext;
+    description.backendInterface.fpBreadcrumbsAllocBlock = allocBlock;
+    description.backendInterface.fpBreadcrumbsFreeBlock  = freeBlock;
+    description.backendInterface.fpBreadcrumbsWrite      = writeMarker;
+
+    FfxBreadcrumbsContext context;
+    FFX_TEST_CHECK(ffxBreadcrumbsContextCreate(&context, &description) == FFX_OK);
+
+    for (uint32_t p = 0; p < s_PipelineCount; ++p)
+    {
+        FfxBreadcrumbsPipelineStateDescription pipeline = {};
+        pipeline.pipeline      = getPipeline(p);
+        pipeline.name          = { "Pipeline", false };
+        pipeline.computeShader = { "CS_Main", false };
+        FFX_TEST_CHECK(ffxBreadcrumbsRegisterPipeline(&context, &pipeline) == FFX_OK);
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    double firstPassMs = 0.0, reusedMs = 0.0;
+    for (uint32_t frame = 0; frame < s_FrameCount; ++frame)
+    {
+        const uint32_t hostAllocations  = s_HostAllocations;
+        const uint32_t blockAllocations = s_BlockAllocations;
+        const auto start = Clock::now();
+        recordFrame(&context);
+        const double frameMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (frame < s_FrameHistoryLength)
+            firstPassMs += frameMs;
+        else
+        {
+            // A reused slot already holds enough memory for the same workload.
+            reusedMs += frameMs;
+            FFX_TEST_CHECK(s_HostAllocations == hostAllocations);
+            FFX_TEST_CHECK(s_BlockAllocations == blockAllocations);
+        }
+    }
+
+    FfxBreadcrumbsMarkersStatus status = {};
+    FFX_TEST_CHECK(ffxBreadcrumbsPrintStatus(&context, &status) == FFX_OK);
+    const std::string text(status.pBuffer, status.bufferSize);
+    free(status.pBuffer);
+
+    // Every marker of every frame still in the history has a `-[status] entry.
+    FFX_TEST_CHECK(countOccurrences(text, "\xe2\x94\x80[") == s_FrameHistoryLength * s_ListCount * s_MarkersPerList);
+
+    const uint32_t markersPerFrame = s_ListCount * s_MarkersPerList;
+    printf("%u lists x %u markers per frame: first %u frames %.2f ms/frame, %u reused frames %.2f ms/frame (%.1f ns/marker)\n",
+        s_ListCount, s_MarkersPerList, s_FrameHistoryLength, firstPassMs / s_FrameHistoryLength, s_FrameCount - s_FrameHistoryLength,
+        reusedMs / (s_FrameCount - s_FrameHistoryLength), reusedMs * 1e6 / ((double)(s_FrameCount - s_FrameHistoryLength) * markersPerFrame));
+
+    FFX_TEST_CHECK(ffxBreadcrumbsContextDestroy(&context) == FFX_OK);
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,217 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Breadcrumbs status output over a fake backend that writes markers into host memory.
+// Records a frame of 100k markers and checks that every marker is printed, that the streamed text matches
+// ffxBreadcrumbsPrintStatus() and decoded binary status, and that markers nested past the status limit are reported.
+
+#include <FidelityFX/host/ffx_breadcrumbs.h>
+#include "ffx_test.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static constexpr uint32_t s_MarkerCount = 100000;
+
+static FfxVersionNumber getSDKVersion(FfxInterface*)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+static FfxErrorCode createBackendContext(FfxInterface*, FfxEffect, FfxEffectBindlessConfig*, FfxUInt32* effectContextId)
+{
+    *effectContextId = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyBackendContext(FfxInterface*, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode allocBlock(FfxInterface*, uint64_t blockBytes, FfxBreadcrumbsBlockData* blockData)
+{
+    blockData->memory      = calloc(1, (size_t)blockBytes);
+    blockData->heap        = blockData->memory;
+    blockData->buffer      = blockData->memory;
+    blockData->baseAddress = (uint64_t)(uintptr_t)blockData->memory;
+    blockData->nextMarker  = 0;
+    return blockData->memory ? FFX_OK : FFX_ERROR_OUT_OF_MEMORY;
+}
+
+static void freeBlock(FfxInterface*, FfxBreadcrumbsBlockData* blockData)
+{
+    free(blockData->memory);
+    blockData->memory = blockData->heap = blockData->buffer = nullptr;
+}
+
+// Writes land immediately, as if the GPU executed every marker.
+static void writeMarker(FfxInterface*, FfxCommandList, uint32_t value, uint64_t gpuLocation, void*, bool)
+{
+    *(uint32_t*)(uintptr_t)gpuLocation = value;
+}
+
+static void appendString(void* pUserData, const void* pData, size_t size)
+{
+    FFX_TEST_CHECK(size <= FFX_BREADCRUMBS_STATUS_CHUNK_SIZE);
+    ((std::string*)pUserData)->append((const char*)pData, size);
+}
+
+static size_t countOccurrences(const std::string& text, const char* pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        ++count;
+    return count;
+}
+
+static bool createContext(FfxBreadcrumbsContext* context)
+{
+    static uint32_t queues[] = { 0 };
+
+    FfxBreadcrumbsContextDescription description = {};
+    description.flags = FFX_BREADCRUMBS_PRINT_FINISHED_LISTS | FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS | FFX_BREADCRUMBS_PRINT_FINISHED_NODES |
+                        FFX_BREADCRUMBS_PRINT_NOT_STARTED_NODES | FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO;
+    description.frameHistoryLength       = 2;
+    description.maxMarkersPerMemoryBlock = 1000;
+    description.usedGpuQueuesCount       = 1;
+    description.pUsedGpuQueues           = queues;
+    description.allocCallbacks           = { malloc, realloc, free };
+    description.backendInterface.fpGetSDKVersion         = getSDKVersion;
+    description.backendInterface.fpCreateBackendContext  = createBackendContext;
+    description.backendInterface.fpDestroyBackendContext = destroyBackendContext;
+    description.backendInterface.fpBreadcrumbsAllocBlock = allocBlock;
+    description.backendInterface.fpBreadcrumbsFreeBlock  = freeBlock;
+    description.backendInterface.fpBreadcrumbsWrite      = writeMarker;
+    return ffxBreadcrumbsContextCreate(context, &description) == FFX_OK;
+}
+
+static void testManyMarkers()
+{
+    FfxBreadcrumbsContext context;
+    FFX_TEST_CHECK(createContext(&context));
+
+    FfxBreadcrumbsPipelineStateDescription pipeline = {};
+    pipeline.pipeline      = (FfxPipeline)0x1000;
+    pipeline.name          = { "Pipeline", false };
+    pipeline.computeShader = { "CS_Main", false };
+    FFX_TEST_CHECK(ffxBreadcrumbsRegisterPipeline(&context, &pipeline) == FFX_OK);
+
+    FFX_TEST_CHECK(ffxBreadcrumbsStartFrame(&context) == FFX_OK);
+    FfxBreadcrumbsCommandListDescription list = {};
+    list.commandList = (FfxCommandList)0x10;
+    list.name        = { "List", false };
+    FFX_TEST_CHECK(ffxBreadcrumbsRegisterCommandList(&context, &list) == FFX_OK);
+
+    // Passes holding a few dispatches each, so the tree has both siblings and nesting.
+    const FfxBreadcrumbsNameTag passName     = { "Pass", false };
+    const FfxBreadcrumbsNameTag dispatchName = { nullptr, false };
+    uint32_t recorded = 0;
+    while (recorded < s_MarkerCount)
+    {
+        FFX_TEST_CHECK(ffxBreadcrumbsBeginMarker(&context, list.commandList, FFX_BREADCRUMBS_MARKER_PASS, &passName) == FFX_OK);
+        ffxBreadcrumbsSetPipeline(&context, list.commandList, pipeline.pipeline);
+        ++recorded;
+        for (uint32_t d = 0; d < 4 && recorded < s_MarkerCount; ++d, ++recorded)
+        {
+            FFX_TEST_CHECK(ffxBreadcrumbsBeginMarker(&context, list.commandList, FFX_BREADCRUMBS_MARKER_DISPATCH, &dispatchName) == FFX_OK);
+            FFX_TEST_CHECK(ffxBreadcrumbsEndMarker(&context, list.commandList) == FFX_OK);
+        }
+        FFX_TEST_CHECK(ffxBreadcrumbsEndMarker(&context, list.commandList) == FFX_OK);
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    const auto start = Clock::now();
+    FfxBreadcrumbsMarkersStatus status = {};
+    FFX_TEST_CHECK(ffxBreadcrumbsPrintStatus(&context, &status) == FFX_OK);
+    const auto printed = Clock::now();
+    const std::string printedText(status.pBuffer, status.bufferSize);
+    free(status.pBuffer);
+
+    std::string text, binary, decoded;
+    FFX_TEST_CHECK(ffxBreadcrumbsWriteStatus(&context, FFX_BREADCRUMBS_STATUS_FORMAT_TEXT, appendString, &text) == FFX_OK);
+    const auto streamed = Clock::now();
+    FFX_TEST_CHECK(ffxBreadcrumbsWriteStatus(&context, FFX_BREADCRUMBS_STATUS_FORMAT_BINARY, appendString, &binary) == FFX_OK);
+    const auto written = Clock::now();
+    FFX_TEST_CHECK(ffxBreadcrumbsDecodeStatus(binary.data(), binary.size(), appendString, &decoded) == FFX_OK);
+    const auto decodedTime = Clock::now();
+
+    FFX_TEST_CHECK(text == printedText);
+    FFX_TEST_CHECK(decoded == text);
+    // Every marker has a `-[status] entry.
+    FFX_TEST_CHECK(countOccurrences(text, "\xe2\x94\x80[") == s_MarkerCount);
+    FFX_TEST_CHECK(countOccurrences(text, "not printed>") == 0);
+
+    // Truncated binary status has to be rejected, not read out of bounds.
+    std::string ignored;
+    FFX_TEST_CHECK(ffxBreadcrumbsDecodeStatus(binary.data(), binary.size() / 2, appendString, &ignored) != FFX_OK);
+
+    auto ms = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    printf("%u markers: print %.2f ms, streamed text %.2f ms (%zu bytes), binary %.2f ms (%zu bytes), decode %.2f ms\n",
+        s_MarkerCount, ms(start, printed), ms(printed, streamed), text.size(), ms(streamed, written), binary.size(), ms(written, decodedTime));
+
+    FFX_TEST_CHECK(ffxBreadcrumbsContextDestroy(&context) == FFX_OK);
+}
+
+static void testDeepNesting()
+{
+    FfxBreadcrumbsContext context;
+    FFX_TEST_CHECK(createContext(&context));
+
+    FFX_TEST_CHECK(ffxBreadcrumbsStartFrame(&context) == FFX_OK);
+    FfxBreadcrumbsCommandListDescription list = {};
+    list.commandList = (FfxCommandList)0x10;
+    FFX_TEST_CHECK(ffxBreadcrumbsRegisterCommandList(&context, &list) == FFX_OK);
+
+    const uint32_t depth = FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL + 44;
+    const FfxBreadcrumbsNameTag passName = { "Nested", false };
+    for (uint32_t i = 0; i < depth; ++i)
+        FFX_TEST_CHECK(ffxBreadcrumbsBeginMarker(&context, list.commandList, FFX_BREADCRUMBS_MARKER_PASS, &passName) == FFX_OK);
+    for (uint32_t i = 0; i < depth; ++i)
+        FFX_TEST_CHECK(ffxBreadcrumbsEndMarker(&context, list.commandList) == FFX_OK);
+
+    std::string text, binary, decoded;
+    FFX_TEST_CHECK(ffxBreadcrumbsWriteStatus(&context, FFX_BREADCRUMBS_STATUS_FORMAT_TEXT, appendString, &text) == (FfxErrorCode)FFX_ERROR_OUT_OF_RANGE);
+    FFX_TEST_CHECK(ffxBreadcrumbsWriteStatus(&context, FFX_BREADCRUMBS_STATUS_FORMAT_BINARY, appendString, &binary) == FFX_OK);
+    FFX_TEST_CHECK(ffxBreadcrumbsDecodeStatus(binary.data(), binary.size(), appendString, &decoded) == (FfxErrorCode)FFX_ERROR_OUT_OF_RANGE);
+
+    FFX_TEST_CHECK(decoded == text);
+    FFX_TEST_CHECK(countOccurrences(text, "\xe2\x94\x80[") == FFX_BREADCRUMBS_STATUS_MAX_NESTING_LEVEL);
+    FFX_TEST_CHECK(text.find("<44 markers nested deeper than 256 levels not printed>") != std::string::npos);
+
+    FfxBreadcrumbsMarkersStatus status = {};
+    FFX_TEST_CHECK(ffxBreadcrumbsPrintStatus(&context, &status) == (FfxErrorCode)FFX_ERROR_OUT_OF_RANGE);
+    FFX_TEST_CHECK(std::string(status.pBuffer, status.bufferSize) == text);
+    free(status.pBuffer);
+
+    FFX_TEST_CHECK(ffxBreadcrumbsContextDestroy(&context) == FFX_OK);
+}
+
+int main()
+{
+    testManyMarkers();
+    testDeepNesting();
+    return FFX_TEST_RESULT();
+}
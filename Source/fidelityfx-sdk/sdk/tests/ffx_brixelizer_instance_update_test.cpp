@@ -0,0 +1,485 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Brixelizer static instance moves over a fake backend that keeps upload buffers in host memory and tallies copies.
+// Checks that flushes upload exactly the instance infos and transforms that changed, that baked updates only invalidate
+// the bricks under the previous and new placements of moved instances, and that more pending invalidations than the
+// context holds are merged instead of overflowing, still covering every moved instance.
+
+#include <FidelityFX/host/ffx_brixelizer.h>
+#include <FidelityFX/gpu/ffx_core.h>
+#include <FidelityFX/gpu/brixelizer/ffx_brixelizer_host_gpu_shared_private.h>
+#include "ffx_brixelizer_private.h"
+#include "ffx_test.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static constexpr float    s_VoxelSize     = 0.1f;
+static constexpr float    s_InstanceSize  = 0.05f;
+static constexpr uint32_t s_CellsPerSide  = FFX_BRIXELIZER_CASCADE_RESOLUTION;
+
+static std::vector<void*> s_MappedResources;
+static uint64_t           s_InstanceInfoBytes      = 0;
+static uint64_t           s_InstanceTransformBytes = 0;
+static uint32_t           s_InstanceCopyJobs       = 0;
+
+static FfxVersionNumber getSDKVersion(FfxInterface*)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+static FfxErrorCode createBackendContext(FfxInterface*, FfxEffect, FfxEffectBindlessConfig*, FfxUInt32* effectContextId)
+{
+    *effectContextId = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode getDeviceCapabilities(FfxInterface*, FfxDeviceCapabilities* deviceCapabilities)
+{
+    memset(deviceCapabilities, 0, sizeof(*deviceCapabilities));
+    deviceCapabilities->maximumSupportedShaderModel                = FFX_SHADER_MODEL_6_6;
+    deviceCapabilities->waveLaneCountMin                           = 32;
+    deviceCapabilities->waveLaneCountMax                           = 64;
+    deviceCapabilities->shaderStorageBufferArrayNonUniformIndexing = true;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyBackendContext(FfxInterface*, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode createPipeline(FfxInterface*, FfxEffect, FfxPass, uint32_t, const FfxPipelineDescription*, FfxUInt32, FfxPipelineState*)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyPipeline(FfxInterface*, FfxPipelineState*, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+// Every resource gets host memory, only upload and readback buffers are ever mapped.
+static FfxErrorCode createResource(FfxInterface*, const FfxCreateResourceDescription* createResourceDescription, FfxUInt32, FfxResourceInternal* outResource)
+{
+    const FfxResourceDescription& resourceDescription = createResourceDescription->resourceDescription;
+    const size_t size = resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER ? resourceDescription.size : 16;
+    outResource->internalIndex = (int32_t)s_MappedResources.size();
+    s_MappedResources.push_back(calloc(1, size));
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyResource(FfxInterface*, FfxResourceInternal resource, FfxUInt32)
+{
+    free(s_MappedResources[resource.internalIndex]);
+    s_MappedResources[resource.internalIndex] = nullptr;
+    return FFX_OK;
+}
+
+static FfxErrorCode mapResource(FfxInterface*, FfxResourceInternal resource, void** ptr)
+{
+    *ptr = s_MappedResources[resource.internalIndex];
+    return FFX_OK;
+}
+
+static FfxErrorCode unmapResource(FfxInterface*, FfxResourceInternal)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode registerResource(FfxInterface*, const FfxResource*, FfxUInt32, FfxResourceInternal* outResource)
+{
+    outResource->internalIndex = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode unregisterResources(FfxInterface*, FfxCommandList, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode registerStaticResource(FfxInterface*, const FfxStaticResourceDescription*, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode stageConstantBufferData(FfxInterface*, void*, FfxUInt32, FfxConstantBuffer*)
+{
+    return FFX_OK;
+}
+
+static bool isJobLabel(const FfxGpuJobDescription* job, const wchar_t* label)
+{
+    uint32_t i = 0;
+    while (label[i] != 0 && job->jobLabel[i] == label[i])
+        ++i;
+    return job->jobLabel[i] == label[i];
+}
+
+static FfxErrorCode scheduleGpuJob(FfxInterface*, const FfxGpuJobDescription* job)
+{
+    if (job->jobType != FFX_GPU_JOB_COPY)
+        return FFX_OK;
+
+    if (isJobLabel(job, L"Instance Info"))
+    {
+        s_InstanceInfoBytes += job->copyJobDescriptor.size;
+        ++s_InstanceCopyJobs;
+    }
+    else if (isJobLabel(job, L"Instance Transform"))
+    {
+        s_InstanceTransformBytes += job->copyJobDescriptor.size;
+        ++s_InstanceCopyJobs;
+    }
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobs(FfxInterface*, FfxCommandList, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static void resetUploadTally()
+{
+    s_InstanceInfoBytes      = 0;
+    s_InstanceTransformBytes = 0;
+    s_InstanceCopyJobs       = 0;
+}
+
+// A single static cascade of s_VoxelSize voxels centered on the origin.
+static FfxErrorCode createContext(FfxBrixelizerContext* context)
+{
+    FfxBrixelizerContextDescription contextDescription = {};
+    contextDescription.numCascades               = 1;
+    contextDescription.cascadeDescs[0].flags     = FFX_BRIXELIZER_CASCADE_STATIC;
+    contextDescription.cascadeDescs[0].voxelSize = s_VoxelSize;
+
+    FfxInterface& backendInterface                 = contextDescription.backendInterface;
+    backendInterface.fpGetSDKVersion               = getSDKVersion;
+    backendInterface.fpCreateBackendContext        = createBackendContext;
+    backendInterface.fpGetDeviceCapabilities       = getDeviceCapabilities;
+    backendInterface.fpDestroyBackendContext       = destroyBackendContext;
+    backendInterface.fpCreatePipeline              = createPipeline;
+    backendInterface.fpDestroyPipeline             = destroyPipeline;
+    backendInterface.fpCreateResource              = createResource;
+    backendInterface.fpDestroyResource             = destroyResource;
+    backendInterface.fpMapResource                 = mapResource;
+    backendInterface.fpUnmapResource               = unmapResource;
+    backendInterface.fpRegisterResource            = registerResource;
+    backendInterface.fpUnregisterResources         = unregisterResources;
+    backendInterface.fpRegisterStaticResource      = registerStaticResource;
+    backendInterface.fpStageConstantBufferDataFunc = stageConstantBufferData;
+    backendInterface.fpScheduleGpuJob              = scheduleGpuJob;
+    backendInterface.fpExecuteGpuJobs              = executeGpuJobs;
+    backendInterface.device                        = (FfxDevice)&s_MappedResources;
+
+    return ffxBrixelizerContextCreate(&contextDescription, context);
+}
+
+static FfxBrixelizerAABB makeAABB(float x, float y, float z)
+{
+    return {{x, y, z}, {x + s_InstanceSize, y + s_InstanceSize, z + s_InstanceSize}};
+}
+
+static void setTranslation(FfxFloat32x3x4 transform, const FfxBrixelizerAABB& aabb)
+{
+    const FfxFloat32x3x4 translation = {1.0f, 0.0f, 0.0f, aabb.min[0], 0.0f, 1.0f, 0.0f, aabb.min[1], 0.0f, 0.0f, 1.0f, aabb.min[2]};
+    memcpy(transform, translation, sizeof(translation));
+}
+
+// Instances on a grid with 0.15 spacing around the origin, well inside the cascade.
+static FfxBrixelizerAABB gridAABB(uint32_t index)
+{
+    const uint32_t side = 34;
+    return makeAABB(-2.5f + 0.15f * (float)(index % side), -2.5f + 0.15f * (float)(index / side % side), -2.5f + 0.15f * (float)(index / (side * side)));
+}
+
+static std::vector<FfxBrixelizerInstanceID> createInstances(FfxBrixelizerContext* context, uint32_t numInstances)
+{
+    std::vector<FfxBrixelizerInstanceID>          instanceIDs(numInstances);
+    std::vector<FfxBrixelizerInstanceDescription> descs(numInstances);
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        FfxBrixelizerInstanceDescription& desc = descs[i];
+        desc.aabb          = gridAABB(i);
+        setTranslation(desc.transform, desc.aabb);
+        desc.indexFormat   = FFX_INDEX_TYPE_UINT32;
+        desc.triangleCount = 12;
+        desc.vertexStride  = 12;
+        desc.vertexCount   = 8;
+        desc.vertexFormat  = FFX_SURFACE_FORMAT_R32G32B32_FLOAT;
+        desc.outInstanceID = &instanceIDs[i];
+    }
+    FFX_TEST_CHECK(ffxBrixelizerCreateInstances(context, descs.data(), numInstances) == FFX_OK);
+    return instanceIDs;
+}
+
+static FfxErrorCode flushInstances(FfxBrixelizerContext* context)
+{
+    FfxBrixelizerRawContext* rawContext = nullptr;
+    FFX_TEST_CHECK(ffxBrixelizerGetRawContext(context, &rawContext) == FFX_OK);
+    resetUploadTally();
+    return ffxBrixelizerRawContextFlushInstances(rawContext, nullptr);
+}
+
+// Brick cells of the cascade covered by an AABB, set in a bit per cell.
+static void markBricks(std::vector<bool>& bricks, const float* aabbMin, const float* aabbMax)
+{
+    const float gridMin = -0.5f * (float)s_CellsPerSide * s_VoxelSize;
+    uint32_t    cellMin[3], cellMax[3];
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        cellMin[i] = (uint32_t)fmaxf(0.0f, floorf((aabbMin[i] - gridMin) / s_VoxelSize));
+        cellMax[i] = (uint32_t)fminf((float)(s_CellsPerSide - 1), fmaxf(0.0f, floorf((aabbMax[i] - gridMin) / s_VoxelSize)));
+    }
+    for (uint32_t z = cellMin[2]; z <= cellMax[2]; ++z)
+        for (uint32_t y = cellMin[1]; y <= cellMax[1]; ++y)
+            for (uint32_t x = cellMin[0]; x <= cellMax[0]; ++x)
+                bricks[(z * s_CellsPerSide + y) * s_CellsPerSide + x] = true;
+}
+
+static uint32_t countBricks(const std::vector<bool>& bricks)
+{
+    uint32_t count = 0;
+    for (bool brick : bricks)
+        count += brick ? 1 : 0;
+    return count;
+}
+
+// Bakes an update of the cascade and returns the bricks its invalidation jobs cover.
+static std::vector<bool> bakeInvalidatedBricks(FfxBrixelizerContext* context, FfxBrixelizerBakedUpdateDescription* bakedUpdate, uint32_t* outNumJobs = nullptr)
+{
+    FfxBrixelizerUpdateDescription updateDescription = {};
+    updateDescription.maxReferences    = 1 << 20;
+    updateDescription.triangleSwapSize = 1 << 20;
+    updateDescription.maxBricksPerBake = 1 << 14;
+    FFX_TEST_CHECK(ffxBrixelizerBakeUpdate(context, &updateDescription, bakedUpdate) == FFX_OK);
+
+    const FfxBrixelizerBakedUpdateDescription_Private* bakedPrivate = (const FfxBrixelizerBakedUpdateDescription_Private*)bakedUpdate;
+    std::vector<bool> bricks(s_CellsPerSide * s_CellsPerSide * s_CellsPerSide);
+    uint32_t          numJobs = 0;
+    for (uint32_t i = 0; i < bakedPrivate->numStaticJobs; ++i)
+    {
+        const FfxBrixelizerRawJobDescription& job = bakedPrivate->staticJobs[i];
+        if (job.flags & FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE)
+        {
+            markBricks(bricks, job.aabbMin, job.aabbMax);
+            ++numJobs;
+        }
+    }
+    if (outNumJobs)
+        *outNumJobs = numJobs;
+    return bricks;
+}
+
+static FfxBrixelizerInstanceTransformUpdate makeUpdate(FfxBrixelizerInstanceID instanceID, FfxBrixelizerAABB aabb)
+{
+    FfxBrixelizerInstanceTransformUpdate update = {};
+    update.instanceID = instanceID;
+    update.aabb       = aabb;
+    setTranslation(update.transform, aabb);
+    return update;
+}
+
+static FfxBrixelizerAABB offsetAABB(FfxBrixelizerAABB aabb, float offset)
+{
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        aabb.min[i] += offset;
+        aabb.max[i] += offset;
+    }
+    return aabb;
+}
+
+// Flushes upload the changed instances only, in as few copies as their IDs allow.
+static void testUploadBytes(FfxBrixelizerContext* context, FfxBrixelizerBakedUpdateDescription* bakedUpdate)
+{
+    const uint32_t numInstances = 1000;
+    const std::vector<FfxBrixelizerInstanceID> instanceIDs = createInstances(context, numInstances);
+
+    FFX_TEST_CHECK(flushInstances(context) == FFX_OK);
+    FFX_TEST_CHECK(s_InstanceInfoBytes == numInstances * sizeof(FfxBrixelizerInstanceInfo));
+    FFX_TEST_CHECK(s_InstanceTransformBytes == numInstances * sizeof(FfxFloat32x3x4));
+    FFX_TEST_CHECK(s_InstanceCopyJobs == 2);
+
+    FFX_TEST_CHECK(flushInstances(context) == FFX_OK);
+    FFX_TEST_CHECK(s_InstanceInfoBytes == 0 && s_InstanceTransformBytes == 0);
+
+    // Moving every 100th instance uploads just those
+    std::vector<FfxBrixelizerInstanceTransformUpdate> updates;
+    for (uint32_t i = 0; i < numInstances; i += 100)
+        updates.push_back(makeUpdate(instanceIDs[i], offsetAABB(gridAABB(i), 0.01f)));
+    FFX_TEST_CHECK(ffxBrixelizerUpdateInstanceTransforms(context, updates.data(), (uint32_t)updates.size()) == FFX_OK);
+    FFX_TEST_CHECK(flushInstances(context) == FFX_OK);
+    FFX_TEST_CHECK(s_InstanceInfoBytes == updates.size() * sizeof(FfxBrixelizerInstanceInfo));
+    FFX_TEST_CHECK(s_InstanceTransformBytes == updates.size() * sizeof(FfxFloat32x3x4));
+
+    // A new transform within the same bounds leaves the instance info alone
+    for (FfxBrixelizerInstanceTransformUpdate& update : updates)
+        update.transform[3] += 0.001f;
+    FFX_TEST_CHECK(ffxBrixelizerUpdateInstanceTransforms(context, updates.data(), (uint32_t)updates.size()) == FFX_OK);
+    FFX_TEST_CHECK(flushInstances(context) == FFX_OK);
+    FFX_TEST_CHECK(s_InstanceInfoBytes == 0);
+    FFX_TEST_CHECK(s_InstanceTransformBytes == updates.size() * sizeof(FfxFloat32x3x4));
+
+    // Resubmitting the same placements uploads nothing
+    FFX_TEST_CHECK(ffxBrixelizerUpdateInstanceTransforms(context, updates.data(), (uint32_t)updates.size()) == FFX_OK);
+    FFX_TEST_CHECK(flushInstances(context) == FFX_OK);
+    FFX_TEST_CHECK(s_InstanceInfoBytes == 0 && s_InstanceTransformBytes == 0);
+
+    FFX_TEST_CHECK(ffxBrixelizerDeleteInstances(context, instanceIDs.data(), numInstances) == FFX_OK);
+    bakeInvalidatedBricks(context, bakedUpdate);
+}
+
+// Only the bricks under the previous and new placements of moved instances are invalidated.
+static void testInvalidatedBricks(FfxBrixelizerContext* context, FfxBrixelizerBakedUpdateDescription* bakedUpdate)
+{
+    const uint32_t numInstances = 1000;
+    const std::vector<FfxBrixelizerInstanceID> instanceIDs = createInstances(context, numInstances);
+
+    // Creating instances invalidates all of them, once
+    std::vector<bool> expected(s_CellsPerSide * s_CellsPerSide * s_CellsPerSide);
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        const FfxBrixelizerAABB aabb = gridAABB(i);
+        markBricks(expected, aabb.min, aabb.max);
+    }
+    FFX_TEST_CHECK(bakeInvalidatedBricks(context, bakedUpdate) == expected);
+
+    uint32_t numJobs = 0;
+    FFX_TEST_CHECK(countBricks(bakeInvalidatedBricks(context, bakedUpdate, &numJobs)) == 0);
+    FFX_TEST_CHECK(numJobs == 0);
+
+    // Small moves overlap the previous placement and take one job each
+    std::vector<FfxBrixelizerInstanceTransformUpdate> updates;
+    expected.assign(expected.size(), false);
+    for (uint32_t i = 0; i < numInstances; i += 100)
+    {
+        const FfxBrixelizerAABB from = gridAABB(i);
+        const FfxBrixelizerAABB to   = offsetAABB(from, 0.02f);
+        updates.push_back(makeUpdate(instanceIDs[i], to));
+        markBricks(expected, from.min, from.max);
+        markBricks(expected, to.min, to.max);
+    }
+    FFX_TEST_CHECK(ffxBrixelizerUpdateInstanceTransforms(context, updates.data(), (uint32_t)updates.size()) == FFX_OK);
+    FFX_TEST_CHECK(bakeInvalidatedBricks(context, bakedUpdate, &numJobs) == expected);
+    FFX_TEST_CHECK(numJobs == updates.size());
+
+    // Far moves invalidate both placements but not the space in between
+    updates.clear();
+    expected.assign(expected.size(), false);
+    for (uint32_t i = 0; i < numInstances; i += 100)
+    {
+        const FfxBrixelizerAABB from = offsetAABB(gridAABB(i), 0.02f);
+        FfxBrixelizerAABB       to   = from;
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            const float offset = from.min[j] < 0.0f ? 1.0f : -1.0f;
+            to.min[j] += offset;
+            to.max[j] += offset;
+        }
+        updates.push_back(makeUpdate(instanceIDs[i], to));
+        markBricks(expected, from.min, from.max);
+        markBricks(expected, to.min, to.max);
+    }
+    FFX_TEST_CHECK(ffxBrixelizerUpdateInstanceTransforms(context, updates.data(), (uint32_t)updates.size()) == FFX_OK);
+    const std::vector<bool> invalidated = bakeInvalidatedBricks(context, bakedUpdate, &numJobs);
+    FFX_TEST_CHECK(invalidated == expected);
+    FFX_TEST_CHECK(numJobs == 2 * updates.size());
+    FFX_TEST_CHECK(countBricks(invalidated) <= 2 * updates.size() * 8);
+
+    FFX_TEST_CHECK(ffxBrixelizerDeleteInstances(context, instanceIDs.data(), numInstances) == FFX_OK);
+    bakeInvalidatedBricks(context, bakedUpdate);
+}
+
+// Far moves of 40k instances queue 80k invalidations, more than the context holds until the next update.
+static void testInvalidationOverflow(FfxBrixelizerContext* context, FfxBrixelizerBakedUpdateDescription* bakedUpdate)
+{
+    const uint32_t numInstances = 40000;
+    const std::vector<FfxBrixelizerInstanceID> instanceIDs = createInstances(context, numInstances);
+    bakeInvalidatedBricks(context, bakedUpdate);
+    FFX_TEST_CHECK(flushInstances(context) == FFX_OK);
+
+    std::vector<FfxBrixelizerInstanceTransformUpdate> updates;
+    std::vector<bool>                                 expected(s_CellsPerSide * s_CellsPerSide * s_CellsPerSide);
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        const FfxBrixelizerAABB from = gridAABB(i);
+        const FfxBrixelizerAABB to   = offsetAABB(from, 0.07f);
+        updates.push_back(makeUpdate(instanceIDs[i], to));
+        markBricks(expected, from.min, from.max);
+        markBricks(expected, to.min, to.max);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    FFX_TEST_CHECK(ffxBrixelizerUpdateInstanceTransforms(context, updates.data(), numInstances) == FFX_OK);
+    const double updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const FfxBrixelizerContext_Private* contextPrivate = (const FfxBrixelizerContext_Private*)context;
+    FFX_TEST_CHECK(contextPrivate->numInvalidations == FFX_BRIXELIZER_MAX_INSTANCES);
+    FFX_TEST_CHECK(contextPrivate->numStaticInstances == numInstances);
+
+    FFX_TEST_CHECK(flushInstances(context) == FFX_OK);
+    FFX_TEST_CHECK(s_InstanceInfoBytes == numInstances * sizeof(FfxBrixelizerInstanceInfo));
+    FFX_TEST_CHECK(s_InstanceTransformBytes == numInstances * sizeof(FfxFloat32x3x4));
+
+    // Merged invalidations cover every moved instance, at the cost of some extra bricks
+    uint32_t                numJobs     = 0;
+    const std::vector<bool> invalidated = bakeInvalidatedBricks(context, bakedUpdate, &numJobs);
+    uint32_t                missed      = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+        missed += (expected[i] && !invalidated[i]) ? 1 : 0;
+    FFX_TEST_CHECK(missed == 0);
+    FFX_TEST_CHECK(numJobs == FFX_BRIXELIZER_MAX_INSTANCES);
+
+    const uint32_t expectedBricks    = countBricks(expected);
+    const uint32_t invalidatedBricks = countBricks(invalidated);
+    FFX_TEST_CHECK(invalidatedBricks <= 2 * expectedBricks);
+    printf("%u moves: %.2f ms, %u bricks invalidated for %u under the instances\n", numInstances, updateMs, invalidatedBricks, expectedBricks);
+
+    FFX_TEST_CHECK(countBricks(bakeInvalidatedBricks(context, bakedUpdate)) == 0);
+    FFX_TEST_CHECK(ffxBrixelizerDeleteInstances(context, instanceIDs.data(), numInstances) == FFX_OK);
+}
+
+int main()
+{
+    // Both are too large for the stack
+    FfxBrixelizerContext*                 context     = (FfxBrixelizerContext*)calloc(1, sizeof(FfxBrixelizerContext));
+    FfxBrixelizerBakedUpdateDescription*  bakedUpdate = (FfxBrixelizerBakedUpdateDescription*)calloc(1, sizeof(FfxBrixelizerBakedUpdateDescription));
+
+    FFX_TEST_CHECK(createContext(context) == FFX_OK);
+
+    testUploadBytes(context, bakedUpdate);
+    testInvalidatedBricks(context, bakedUpdate);
+    testInvalidationOverflow(context, bakedUpdate);
+
+    FFX_TEST_CHECK(ffxBrixelizerContextDestroy(context) == FFX_OK);
+    free(bakedUpdate);
+    free(context);
+
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,393 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Replays job streams through the DX12 barrier planner the way ExecuteGpuJobsDX12 records them: a job ends the split
+// barriers of the resources it uses and transitions the others in full, then begins the splits planned after it.
+// Each stream checks the plan itself, and that the replay ends in the states of a replay without the plan, with every
+// transition the plan splits taken out of the full ones.
+
+#include "ffx_dx12_barrier_planner.h"
+#include "ffx_test.h"
+
+#include <random>
+#include <string.h>
+#include <vector>
+
+#define TEST_RESOURCE_COUNT     (16)
+#define TEST_MAX_SPLIT_BARRIERS (256)
+
+typedef std::vector<FfxGpuJobDescription> JobStream;
+
+typedef struct ReplayResource
+{
+    FfxResourceStates state;
+    bool              splitPending;
+    FfxResourceStates splitState;
+    uint32_t          splitEndJob;
+} ReplayResource;
+
+typedef struct ReplayResult
+{
+    FfxResourceStates finalStates[TEST_RESOURCE_COUNT];
+    uint32_t          transitionCount;
+    uint32_t          splitBeginCount;
+    uint32_t          splitEndCount;
+    uint32_t          skippedSplitCount;
+    uint32_t          uavBarrierCount;
+    uint32_t          misplacedEndCount;      // splits ended by another job than the one they were planned for
+} ReplayResult;
+
+static FfxResourceStates s_initialStates[TEST_RESOURCE_COUNT];
+
+static FfxResourceStates getInitialState(const void*, uint32_t resourceIndex)
+{
+    return s_initialStates[resourceIndex];
+}
+
+static FfxGpuJobDescription& addJob(JobStream& jobs, FfxGpuJobType type)
+{
+    jobs.emplace_back();
+    FfxGpuJobDescription& job = jobs.back();
+    memset(&job, 0, sizeof(job));
+    job.jobType = type;
+    return job;
+}
+
+static void addCompute(JobStream& jobs, std::initializer_list<uint32_t> srvs, std::initializer_list<uint32_t> uavs, uint32_t indirectArgument = 0)
+{
+    FfxComputeJobDescription& compute = addJob(jobs, FFX_GPU_JOB_COMPUTE).computeJobDescriptor;
+    for (uint32_t srv : srvs)
+        compute.srvTextures[compute.pipeline.srvTextureCount++].resource.internalIndex = int32_t(srv);
+    for (uint32_t uav : uavs)
+        compute.uavTextures[compute.pipeline.uavTextureCount++].resource.internalIndex = int32_t(uav);
+    if (indirectArgument)
+    {
+        compute.pipeline.cmdSignature     = reinterpret_cast<FfxCommandSignature>(uintptr_t(1));
+        compute.cmdArgument.internalIndex = int32_t(indirectArgument);
+    }
+}
+
+static void addCopy(JobStream& jobs, uint32_t src, uint32_t dst)
+{
+    FfxCopyJobDescription& copy = addJob(jobs, FFX_GPU_JOB_COPY).copyJobDescriptor;
+    copy.src.internalIndex = int32_t(src);
+    copy.dst.internalIndex = int32_t(dst);
+}
+
+static void addClear(JobStream& jobs, uint32_t target)
+{
+    addJob(jobs, FFX_GPU_JOB_CLEAR_FLOAT).clearJobDescriptor.target.internalIndex = int32_t(target);
+}
+
+static void addBarrierJob(JobStream& jobs, uint32_t resource, FfxResourceStates state)
+{
+    FfxBarrierDescription& barrier = addJob(jobs, FFX_GPU_JOB_BARRIER).barrierDescriptor;
+    barrier.resource.internalIndex = int32_t(resource);
+    barrier.newState               = state;
+}
+
+// addBarrier of the backend
+static void replayAccess(ReplayResource& resource, uint32_t jobIndex, FfxResourceStates newState, ReplayResult& result)
+{
+    if (resource.splitPending)
+    {
+        if (resource.splitEndJob != jobIndex)
+            ++result.misplacedEndCount;
+
+        resource.state        = resource.splitState;
+        resource.splitPending = false;
+        ++result.splitEndCount;
+        if ((resource.state & newState) == newState)
+            return;
+    }
+
+    if ((resource.state & newState) != newState)
+    {
+        resource.state = newState;
+        ++result.transitionCount;
+    }
+    else if (newState == FFX_RESOURCE_STATE_UNORDERED_ACCESS)
+        ++result.uavBarrierCount;
+}
+
+// beginSplitBarriers of the backend
+static void replaySplitBarriers(const BarrierPlan& plan, uint32_t& nextSplitBarrier, int32_t jobIndex, ReplayResource* pResources, ReplayResult& result)
+{
+    for (; nextSplitBarrier < plan.splitBarrierCount; ++nextSplitBarrier)
+    {
+        const SplitBarrier& splitBarrier = plan.pSplitBarriers[nextSplitBarrier];
+        if (splitBarrier.beginAfterJob != jobIndex)
+            break;
+
+        ReplayResource& resource = pResources[splitBarrier.resourceIndex];
+        if (resource.splitPending || resource.state != splitBarrier.stateBefore)
+        {
+            ++result.skippedSplitCount;
+            continue;
+        }
+
+        resource.splitPending = true;
+        resource.splitState   = splitBarrier.stateAfter;
+        resource.splitEndJob  = splitBarrier.endJob;
+        ++result.splitBeginCount;
+    }
+}
+
+static ReplayResult replay(const JobStream& jobs, const BarrierPlan* pPlan)
+{
+    ReplayResult   result = {};
+    ReplayResource resources[TEST_RESOURCE_COUNT] = {};
+    for (uint32_t i = 0; i < TEST_RESOURCE_COUNT; ++i)
+        resources[i].state = s_initialStates[i];
+
+    uint32_t nextSplitBarrier = 0;
+    if (pPlan)
+        replaySplitBarriers(*pPlan, nextSplitBarrier, -1, resources, result);
+
+    ResourceAccess accesses[FFX_MAX_JOB_RESOURCE_ACCESSES];
+    for (uint32_t jobIndex = 0; jobIndex < uint32_t(jobs.size()); ++jobIndex)
+    {
+        const uint32_t accessCount = getGpuJobResourceAccesses(&jobs[jobIndex], accesses);
+        for (uint32_t i = 0; i < accessCount; ++i)
+            replayAccess(resources[accesses[i].resourceIndex], jobIndex, accesses[i].state, result);
+
+        if (pPlan)
+            replaySplitBarriers(*pPlan, nextSplitBarrier, int32_t(jobIndex), resources, result);
+    }
+
+    // endSplitBarriers of the backend
+    for (uint32_t i = 0; i < TEST_RESOURCE_COUNT; ++i)
+    {
+        if (resources[i].splitPending)
+            replayAccess(resources[i], uint32_t(jobs.size()), resources[i].splitState, result);
+        result.finalStates[i] = resources[i].state;
+    }
+    return result;
+}
+
+static bool jobAccesses(const FfxGpuJobDescription& job, uint32_t resourceIndex, FfxResourceStates* pLastState = nullptr)
+{
+    ResourceAccess accesses[FFX_MAX_JOB_RESOURCE_ACCESSES];
+    const uint32_t accessCount = getGpuJobResourceAccesses(&job, accesses);
+    bool           accessed    = false;
+    for (uint32_t i = 0; i < accessCount; ++i)
+    {
+        if (accesses[i].resourceIndex == resourceIndex)
+        {
+            accessed = true;
+            if (pLastState)
+                *pLastState = accesses[i].state;
+        }
+    }
+    return accessed;
+}
+
+static void checkPlan(const JobStream& jobs, const BarrierPlan& plan)
+{
+    for (uint32_t i = 0; i < plan.splitBarrierCount; ++i)
+    {
+        const SplitBarrier& splitBarrier = plan.pSplitBarriers[i];
+        if (i > 0)
+            FFX_TEST_CHECK(plan.pSplitBarriers[i - 1].beginAfterJob <= splitBarrier.beginAfterJob);
+
+        // a split only pays off with a job in between, and that job must not use the resource
+        FFX_TEST_CHECK(splitBarrier.beginAfterJob + 1 < int32_t(splitBarrier.endJob));
+        FFX_TEST_CHECK(splitBarrier.endJob < jobs.size());
+        for (int32_t job = splitBarrier.beginAfterJob + 1; job < int32_t(splitBarrier.endJob); ++job)
+            FFX_TEST_CHECK(!jobAccesses(jobs[job], splitBarrier.resourceIndex));
+
+        // it starts from the state the previous user leaves the resource in
+        FfxResourceStates lastState = s_initialStates[splitBarrier.resourceIndex];
+        if (splitBarrier.beginAfterJob >= 0)
+        {
+            FFX_TEST_CHECK(jobAccesses(jobs[splitBarrier.beginAfterJob], splitBarrier.resourceIndex, &lastState));
+            if ((splitBarrier.stateBefore & lastState) != lastState)
+                FFX_TEST_CHECK(splitBarrier.stateBefore == lastState);
+        }
+        else
+            FFX_TEST_CHECK(splitBarrier.stateBefore == lastState);
+
+        FFX_TEST_CHECK(jobAccesses(jobs[splitBarrier.endJob], splitBarrier.resourceIndex));
+        FFX_TEST_CHECK(splitBarrier.stateBefore != splitBarrier.stateAfter);
+    }
+}
+
+static void checkStream(const JobStream& jobs, BarrierPlan& plan, uint32_t minSplitBarrierCount = 0)
+{
+    planGpuJobBarriers(plan, jobs.data(), uint32_t(jobs.size()), getInitialState, nullptr);
+    checkPlan(jobs, plan);
+    FFX_TEST_CHECK(plan.splitBarrierCount >= minSplitBarrierCount);
+
+    const ReplayResult whole = replay(jobs, nullptr);
+    const ReplayResult split = replay(jobs, &plan);
+
+    FFX_TEST_CHECK(memcmp(whole.finalStates, split.finalStates, sizeof(whole.finalStates)) == 0);
+    FFX_TEST_CHECK(split.transitionCount + split.splitBeginCount == whole.transitionCount);
+    FFX_TEST_CHECK(split.splitBeginCount == split.splitEndCount);
+    FFX_TEST_CHECK(split.splitBeginCount == plan.splitBarrierCount);
+    FFX_TEST_CHECK(split.skippedSplitCount == 0);
+    FFX_TEST_CHECK(split.misplacedEndCount == 0);
+    FFX_TEST_CHECK(split.uavBarrierCount == whole.uavBarrierCount);
+}
+
+static void resetInitialStates()
+{
+    for (uint32_t i = 0; i < TEST_RESOURCE_COUNT; ++i)
+        s_initialStates[i] = FFX_RESOURCE_STATE_COMPUTE_READ;
+}
+
+// Streams shaped like the dispatches of the effects: chains of passes feeding each other, history copies and clears
+static void testEffectStreams(BarrierPlan& plan)
+{
+    // a temporal upscaler: inputs 1-3 are read, 4 is a history written then copied to 5, 6 is cleared and accumulated into
+    resetInitialStates();
+    s_initialStates[4] = FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+    s_initialStates[5] = FFX_RESOURCE_STATE_COPY_DEST;
+    {
+        JobStream jobs;
+        addClear(jobs, 6);
+        addCompute(jobs, { 1, 2 }, { 7 });
+        addCompute(jobs, { 7, 3 }, { 8 });
+        addCompute(jobs, { 8, 5 }, { 4, 6 });
+        addCompute(jobs, { 4, 6 }, { 9 });
+        addCopy(jobs, 4, 5);
+        addBarrierJob(jobs, 9, FFX_RESOURCE_STATE_PIXEL_COMPUTE_READ);
+        checkStream(jobs, plan, 2);
+    }
+
+    // a downsampler writing a chain of mips, 10 holds the indirect arguments written by the first pass
+    resetInitialStates();
+    {
+        JobStream jobs;
+        addCompute(jobs, { 1 }, { 10, 2 });
+        addCompute(jobs, { 2 }, { 3 });
+        addCompute(jobs, { 3 }, { 4 });
+        addCompute(jobs, { 4 }, { 5 }, 10);
+        addCompute(jobs, { 5, 2 }, { 6 }, 10);
+        checkStream(jobs, plan, 1);
+    }
+
+    // the same resource read and written by one job, and used twice in a row
+    resetInitialStates();
+    {
+        JobStream jobs;
+        addCompute(jobs, { 1 }, { 1 });
+        addCompute(jobs, { 1 }, { 2 });
+        addCompute(jobs, { 3 }, { 4 });
+        addCopy(jobs, 2, 1);
+        addCompute(jobs, { 4 }, { 2 });
+        checkStream(jobs, plan);
+    }
+}
+
+static void testRandomStreams(BarrierPlan& plan)
+{
+    const FfxResourceStates barrierStates[] = { FFX_RESOURCE_STATE_COMPUTE_READ, FFX_RESOURCE_STATE_UNORDERED_ACCESS,
+                                                FFX_RESOURCE_STATE_PIXEL_COMPUTE_READ, FFX_RESOURCE_STATE_COPY_SRC,
+                                                FFX_RESOURCE_STATE_GENERIC_READ };
+
+    std::mt19937 random(12345);
+    auto         resource = [&]() { return 1 + uint32_t(random() % (TEST_RESOURCE_COUNT - 1)); };
+    for (uint32_t stream = 0; stream < 2000; ++stream)
+    {
+        for (uint32_t i = 0; i < TEST_RESOURCE_COUNT; ++i)
+            s_initialStates[i] = barrierStates[random() % 5];
+
+        JobStream      jobs;
+        const uint32_t jobCount = 1 + random() % 48;
+        for (uint32_t job = 0; job < jobCount; ++job)
+        {
+            switch (random() % 6)
+            {
+            case 0:  addCopy(jobs, resource(), resource()); break;
+            case 1:  addClear(jobs, resource()); break;
+            case 2:  addBarrierJob(jobs, resource(), barrierStates[random() % 5]); break;
+            case 3:  addCompute(jobs, { resource() }, { resource() }, resource()); break;
+            default: addCompute(jobs, { resource(), resource() }, { resource() }); break;
+            }
+        }
+        checkStream(jobs, plan);
+    }
+}
+
+// A plan that runs out of split barriers transitions the other resources in full
+static void testSplitBarrierLimit(BarrierPlan& plan)
+{
+    resetInitialStates();
+    JobStream jobs;
+    for (uint32_t i = 1; i < TEST_RESOURCE_COUNT; ++i)
+        addCompute(jobs, {}, { i });
+    for (uint32_t i = 1; i < TEST_RESOURCE_COUNT; ++i)
+        addCompute(jobs, { i }, {});
+
+    const uint32_t maxSplitBarriers = plan.maxSplitBarriers;
+    plan.maxSplitBarriers = 3;
+    checkStream(jobs, plan, 3);
+    FFX_TEST_CHECK(plan.splitBarrierCount == 3);
+    plan.maxSplitBarriers = maxSplitBarriers;
+}
+
+// Resources are planned from their current state again in every plan, also when the epoch counter wraps
+static void testEpochWrap(BarrierPlan& plan)
+{
+    JobStream jobs;
+    addCompute(jobs, {}, { 1 });
+    addCompute(jobs, {}, { 3 });
+    addCompute(jobs, { 1 }, { 2 });
+
+    resetInitialStates();
+    plan.epoch = UINT32_MAX - 1;
+    checkStream(jobs, plan, 2);
+    FFX_TEST_CHECK(plan.epoch == UINT32_MAX);
+
+    // an entry left by the plan 2^32 plans ago, which would be taken for one of the next plan without the reset
+    plan.pResources[2].epoch         = 1;
+    plan.pResources[2].lastAccessJob = 0;
+    plan.pResources[2].state         = FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+
+    s_initialStates[1] = FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+    s_initialStates[3] = FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+    checkStream(jobs, plan, 2);
+    FFX_TEST_CHECK(plan.epoch == 1);
+    FFX_TEST_CHECK(plan.splitBarrierCount == 2);
+    FFX_TEST_CHECK(plan.pSplitBarriers[0].resourceIndex == 2 && plan.pSplitBarriers[0].beginAfterJob == -1);
+    FFX_TEST_CHECK(plan.pSplitBarriers[1].resourceIndex == 1 && plan.pSplitBarriers[1].beginAfterJob == 0);
+}
+
+int main()
+{
+    static BarrierPlanResource resources[TEST_RESOURCE_COUNT];
+    static SplitBarrier        splitBarriers[TEST_MAX_SPLIT_BARRIERS];
+
+    BarrierPlan plan      = {};
+    plan.pResources       = resources;
+    plan.resourceCount    = TEST_RESOURCE_COUNT;
+    plan.pSplitBarriers   = splitBarriers;
+    plan.maxSplitBarriers = TEST_MAX_SPLIT_BARRIERS;
+
+    testEffectStreams(plan);
+    testRandomStreams(plan);
+    testSplitBarrierLimit(plan);
+    testEpochWrap(plan);
+    return FFX_TEST_RESULT();
+}
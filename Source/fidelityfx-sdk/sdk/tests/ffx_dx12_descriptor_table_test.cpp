@@ -0,0 +1,187 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// The device-free part of the DX12 descriptor tables: merging of the copies into ranges, reuse of identical tables
+// within a frame, invalidation when sources change, and the frame partitions of the ring.
+
+#include "ffx_dx12_descriptor_table.h"
+#include "ffx_test.h"
+
+static DescriptorRing s_ring;
+
+static void makeTable(DescriptorTable& table, uint32_t slotCount, uint32_t firstSource)
+{
+    resetDescriptorTable(table);
+    table.slotCount = slotCount;
+    for (uint32_t slot = 0; slot < slotCount; ++slot)
+        addDescriptorTableEntry(table, slot, firstSource + slot);
+}
+
+static void testCopyRanges()
+{
+    DescriptorTable      table;
+    DescriptorCopyRanges ranges;
+
+    // bound out of order, the entries come out sorted and merge into one range on both sides
+    resetDescriptorTable(table);
+    table.slotCount = 4;
+    addDescriptorTableEntry(table, 2, 12);
+    addDescriptorTableEntry(table, 0, 10);
+    addDescriptorTableEntry(table, 3, 13);
+    addDescriptorTableEntry(table, 1, 11);
+    for (uint32_t i = 0; i < table.entryCount; ++i)
+        FFX_TEST_CHECK(table.entries[i].slot == i);
+
+    buildDescriptorCopyRanges(table, ranges);
+    FFX_TEST_CHECK(ranges.dstRangeCount == 1 && ranges.dstRangeStarts[0] == 0 && ranges.dstRangeSizes[0] == 4);
+    FFX_TEST_CHECK(ranges.srcRangeCount == 1 && ranges.srcRangeStarts[0] == 10 && ranges.srcRangeSizes[0] == 4);
+
+    // consecutive slots copied from scattered descriptors, and the reverse
+    resetDescriptorTable(table);
+    table.slotCount = 5;
+    addDescriptorTableEntry(table, 0, 20);
+    addDescriptorTableEntry(table, 1, 40);
+    addDescriptorTableEntry(table, 3, 41);
+    addDescriptorTableEntry(table, 4, 42);
+    buildDescriptorCopyRanges(table, ranges);
+    FFX_TEST_CHECK(ranges.dstRangeCount == 2);
+    FFX_TEST_CHECK(ranges.dstRangeStarts[0] == 0 && ranges.dstRangeSizes[0] == 2);
+    FFX_TEST_CHECK(ranges.dstRangeStarts[1] == 3 && ranges.dstRangeSizes[1] == 2);
+    FFX_TEST_CHECK(ranges.srcRangeCount == 2);
+    FFX_TEST_CHECK(ranges.srcRangeStarts[0] == 20 && ranges.srcRangeSizes[0] == 1);
+    FFX_TEST_CHECK(ranges.srcRangeStarts[1] == 40 && ranges.srcRangeSizes[1] == 3);
+
+    // buffer views are created in place, so they break the ranges around them without being copied
+    resetDescriptorTable(table);
+    table.slotCount = 3;
+    addDescriptorTableEntry(table, 0, 30);
+    addDescriptorTableEntry(table, 1, 7, 256, 1024, 16);
+    addDescriptorTableEntry(table, 2, 31);
+    buildDescriptorCopyRanges(table, ranges);
+    FFX_TEST_CHECK(ranges.dstRangeCount == 2 && ranges.dstRangeSizes[0] == 1 && ranges.dstRangeStarts[1] == 2);
+    FFX_TEST_CHECK(ranges.srcRangeCount == 1 && ranges.srcRangeStarts[0] == 30 && ranges.srcRangeSizes[0] == 2);
+
+    // only buffer views, nothing to copy
+    resetDescriptorTable(table);
+    table.slotCount = 1;
+    addDescriptorTableEntry(table, 0, 7, 0, 64);
+    buildDescriptorCopyRanges(table, ranges);
+    FFX_TEST_CHECK(ranges.dstRangeCount == 0 && ranges.srcRangeCount == 0);
+
+    // a view of another range of the same buffer is another table
+    DescriptorTable other = table;
+    other.entries[0].offset = 64;
+    FFX_TEST_CHECK(isSameDescriptorTable(table, table));
+    FFX_TEST_CHECK(!isSameDescriptorTable(table, other));
+}
+
+static void testReuse()
+{
+    const uint32_t partitionSize = 64;
+    initDescriptorRing(s_ring, 1000, partitionSize);
+
+    DescriptorTable uavs, srvs, otherSrvs;
+    makeTable(uavs, 4, 100);
+    makeTable(srvs, 8, 200);
+    makeTable(otherSrvs, 8, 300);
+
+    const DescriptorTableAllocation firstUavs = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+    const DescriptorTableAllocation firstSrvs = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_SRV, srvs);
+    FFX_TEST_CHECK(!firstUavs.reused && !firstUavs.wrapped && firstUavs.base == 1000);
+    FFX_TEST_CHECK(!firstSrvs.reused && firstSrvs.base == 1004);
+
+    // the same tables in the next dispatch, also across fpExecuteGpuJobs calls of the frame
+    DescriptorTableAllocation allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+    FFX_TEST_CHECK(allocation.reused && allocation.base == firstUavs.base);
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_SRV, srvs);
+    FFX_TEST_CHECK(allocation.reused && allocation.base == firstSrvs.base);
+
+    // a different SRV table replaces the last one of its type only
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_SRV, otherSrvs);
+    FFX_TEST_CHECK(!allocation.reused && allocation.base == 1012);
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+    FFX_TEST_CHECK(allocation.reused && allocation.base == firstUavs.base);
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_SRV, srvs);
+    FFX_TEST_CHECK(!allocation.reused && allocation.base == 1020);
+
+    // resources registered at the same indices change what the tables were copied from
+    invalidateDescriptorTables(s_ring);
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+    FFX_TEST_CHECK(!allocation.reused && allocation.base == 1028);
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_SRV, srvs);
+    FFX_TEST_CHECK(!allocation.reused && allocation.base == 1032);
+
+    // each frame starts at its own partition, and the tables of the previous frame are not bound again
+    for (uint32_t frame = 1; frame <= FFX_MAX_QUEUED_FRAMES; ++frame)
+    {
+        advanceDescriptorRingFrame(s_ring);
+        const uint32_t partitionBase = 1000 + (frame % FFX_MAX_QUEUED_FRAMES) * partitionSize;
+
+        allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+        FFX_TEST_CHECK(!allocation.reused && allocation.base == partitionBase);
+        allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+        FFX_TEST_CHECK(allocation.reused && allocation.base == partitionBase);
+    }
+}
+
+static void testWrap()
+{
+    const uint32_t partitionSize = 16;
+    initDescriptorRing(s_ring, 0, partitionSize);
+
+    DescriptorTable uavs, srvs, otherSrvs;
+    makeTable(uavs, 6, 100);
+    makeTable(srvs, 6, 200);
+    makeTable(otherSrvs, 6, 300);
+
+    DescriptorTableAllocation allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+    FFX_TEST_CHECK(allocation.base == 0 && !allocation.wrapped);
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_SRV, srvs);
+    FFX_TEST_CHECK(allocation.base == 6 && !allocation.wrapped);
+
+    // does not fit the 4 remaining slots, goes back to the start of the partition over the UAV table
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_SRV, otherSrvs);
+    FFX_TEST_CHECK(allocation.base == 0 && allocation.wrapped);
+    allocation = allocateDescriptorTable(s_ring, FFX_DESCRIPTOR_TABLE_UAV, uavs);
+    FFX_TEST_CHECK(!allocation.reused && allocation.base == 6 && !allocation.wrapped);
+
+    // never into the partition of another frame
+    for (uint32_t frame = 0; frame < 3 * FFX_MAX_QUEUED_FRAMES; ++frame)
+    {
+        advanceDescriptorRingFrame(s_ring);
+        const uint32_t partitionBase = s_ring.frameIndex * partitionSize;
+        for (uint32_t table = 0; table < 5; ++table)
+        {
+            allocation = allocateDescriptorTable(s_ring, (table & 1) ? FFX_DESCRIPTOR_TABLE_SRV : FFX_DESCRIPTOR_TABLE_UAV, (table & 1) ? srvs : uavs);
+            FFX_TEST_CHECK(allocation.base >= partitionBase && allocation.base + 6 <= partitionBase + partitionSize);
+        }
+    }
+}
+
+int main()
+{
+    testCopyRanges();
+    testReuse();
+    testWrap();
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,231 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Immutable resources are shared per device: several upscaler contexts, each on a backend interface of its own as the
+// FidelityFX API creates them, allocate and upload their lookup tables once, and only contents that match byte for
+// byte are shared. The contexts follow what CreateResourceDX12 and DestroyResourceDX12 do with the table.
+
+#include "ffx_dx12_immutable_resources.h"
+#include "ffx_test.h"
+
+#include <vector>
+
+// Stands in for an ID3D12Resource
+typedef struct FakeResource
+{
+    uint32_t refCount;
+} FakeResource;
+
+static uint32_t s_AllocatedResources = 0;
+static uint64_t s_UploadedBytes      = 0;
+
+static void addFakeReference(void* resource)
+{
+    ++reinterpret_cast<FakeResource*>(resource)->refCount;
+}
+
+static void releaseFakeReference(FakeResource* resource)
+{
+    FFX_TEST_CHECK(resource->refCount > 0);
+    if (--resource->refCount == 0)
+    {
+        --s_AllocatedResources;
+        delete resource;
+    }
+}
+
+// The lookup tables of an upscaler context, as the FSR upscaler creates them
+static int16_t s_LanczosWeights[128];
+static float   s_DefaultExposure[2] = { 0.0f, 1.0f };
+
+static FfxCreateResourceDescription getLanczosLut(void* weights = s_LanczosWeights)
+{
+    FfxCreateResourceDescription description = { FFX_HEAP_TYPE_DEFAULT };
+    description.resourceDescription = { FFX_RESOURCE_TYPE_TEXTURE2D, FFX_SURFACE_FORMAT_R16_SNORM, 128, 1, 1, 1, FFX_RESOURCE_FLAGS_NONE, FFX_RESOURCE_USAGE_READ_ONLY };
+    description.initData = FfxResourceInitData::FfxResourceInitBuffer(sizeof(s_LanczosWeights), weights);
+    return description;
+}
+
+static FfxCreateResourceDescription getDefaultReactivity()
+{
+    FfxCreateResourceDescription description = { FFX_HEAP_TYPE_DEFAULT };
+    description.resourceDescription = { FFX_RESOURCE_TYPE_TEXTURE2D, FFX_SURFACE_FORMAT_R8_UNORM, 1, 1, 1, 1, FFX_RESOURCE_FLAGS_NONE, FFX_RESOURCE_USAGE_READ_ONLY };
+    description.initData = FfxResourceInitData::FfxResourceInitValue(1, 0);
+    return description;
+}
+
+static FfxCreateResourceDescription getDefaultExposure()
+{
+    FfxCreateResourceDescription description = { FFX_HEAP_TYPE_DEFAULT };
+    description.resourceDescription = { FFX_RESOURCE_TYPE_TEXTURE2D, FFX_SURFACE_FORMAT_R32G32_FLOAT, 1, 1, 1, 1, FFX_RESOURCE_FLAGS_NONE, FFX_RESOURCE_USAGE_READ_ONLY };
+    description.initData = FfxResourceInitData::FfxResourceInitBuffer(sizeof(s_DefaultExposure), s_DefaultExposure);
+    return description;
+}
+
+static const uint64_t s_UpscalerLutBytes = sizeof(s_LanczosWeights) + 1 + sizeof(s_DefaultExposure);
+
+// A backend interface with one upscaler context on it
+class UpscalerContext
+{
+public:
+    explicit UpscalerContext(void* device) : m_device(device)
+    {
+        retainImmutableResourceDevice(m_device);
+        create(getLanczosLut());
+        create(getDefaultReactivity());
+        create(getDefaultExposure());
+    }
+
+    ~UpscalerContext()
+    {
+        for (Slot& slot : m_slots)
+        {
+            if (slot.immutableResource)
+                releaseImmutableResource(m_device, slot.resource);
+            releaseFakeReference(slot.resource);
+        }
+        releaseImmutableResourceDevice(m_device);
+    }
+
+    void create(const FfxCreateResourceDescription& description)
+    {
+        Slot slot = {};
+        const bool immutableResource = isImmutableResource(&description);
+        if (immutableResource)
+            slot.resource = reinterpret_cast<FakeResource*>(acquireImmutableResource(m_device, &description, addFakeReference));
+
+        if (slot.resource)
+        {
+            slot.immutableResource = true;
+        }
+        else
+        {
+            slot.resource = new FakeResource{ 1 };
+            ++s_AllocatedResources;
+            s_UploadedBytes += description.initData.size;
+            if (immutableResource)
+                slot.immutableResource = addImmutableResource(m_device, &description, slot.resource);
+        }
+        m_slots.push_back(slot);
+    }
+
+    FakeResource* resource(size_t index) const { return m_slots[index].resource; }
+
+private:
+    typedef struct Slot
+    {
+        FakeResource* resource;
+        bool          immutableResource;
+    } Slot;
+
+    void*             m_device;
+    std::vector<Slot> m_slots;
+};
+
+static int s_Devices[2];
+
+static void testUpscalerContexts()
+{
+    const uint32_t contextCount = 4;
+    {
+        std::vector<UpscalerContext*> contexts;
+        for (uint32_t i = 0; i < contextCount; ++i)
+            contexts.push_back(new UpscalerContext(&s_Devices[0]));
+
+        // Only the first context allocated and uploaded its tables, every context references them
+        const ImmutableResourceStatistics statistics = getImmutableResourceStatistics(&s_Devices[0]);
+        FFX_TEST_CHECK(statistics.liveResourceCount == 3);
+        FFX_TEST_CHECK(statistics.createCount == 3);
+        FFX_TEST_CHECK(statistics.shareCount == 3 * (contextCount - 1));
+        FFX_TEST_CHECK(statistics.uploadedBytes == s_UpscalerLutBytes);
+        FFX_TEST_CHECK(statistics.skippedUploadBytes == s_UpscalerLutBytes * (contextCount - 1));
+        FFX_TEST_CHECK(s_AllocatedResources == 3);
+        FFX_TEST_CHECK(s_UploadedBytes == s_UpscalerLutBytes);
+        for (uint32_t i = 1; i < contextCount; ++i)
+            FFX_TEST_CHECK(contexts[i]->resource(0) == contexts[0]->resource(0));
+        FFX_TEST_CHECK(contexts[0]->resource(0)->refCount == contextCount);
+
+        // The tables outlive the context that created them
+        delete contexts[0];
+        FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[0]).liveResourceCount == 3);
+        FFX_TEST_CHECK(s_AllocatedResources == 3);
+
+        // and a context created after it still shares them
+        contexts[0] = new UpscalerContext(&s_Devices[0]);
+        FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[0]).createCount == 3);
+        FFX_TEST_CHECK(s_UploadedBytes == s_UpscalerLutBytes);
+
+        for (UpscalerContext* context : contexts)
+            delete context;
+    }
+
+    // The last context released them, and the device's counters went with it
+    FFX_TEST_CHECK(s_AllocatedResources == 0);
+    FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[0]).createCount == 0);
+}
+
+static void testSeparateContents()
+{
+    s_UploadedBytes = 0;
+
+    UpscalerContext first(&s_Devices[0]);
+
+    // Different weights of the same size, a different description, or a writable resource are not shared
+    int16_t otherWeights[128] = {};
+    otherWeights[64] = 1;
+    first.create(getLanczosLut(otherWeights));
+
+    FfxCreateResourceDescription wider = getLanczosLut();
+    wider.resourceDescription.width = 256;
+    first.create(wider);
+
+    FfxCreateResourceDescription writable = getLanczosLut();
+    writable.resourceDescription.usage = FFX_RESOURCE_USAGE_UAV;
+    first.create(writable);
+
+    FFX_TEST_CHECK(first.resource(3) != first.resource(0));
+    FFX_TEST_CHECK(first.resource(4) != first.resource(0));
+    FFX_TEST_CHECK(first.resource(5) != first.resource(0));
+    FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[0]).createCount == 5);
+    FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[0]).shareCount == 0);
+    FFX_TEST_CHECK(s_UploadedBytes == s_UpscalerLutBytes + 3 * sizeof(s_LanczosWeights));
+
+    // A context on another device gets its own copies and counters
+    {
+        UpscalerContext other(&s_Devices[1]);
+        FFX_TEST_CHECK(other.resource(0) != first.resource(0));
+        FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[1]).createCount == 3);
+        FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[1]).shareCount == 0);
+        FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[0]).shareCount == 0);
+    }
+    FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[1]).liveResourceCount == 0);
+    FFX_TEST_CHECK(getImmutableResourceStatistics(&s_Devices[0]).liveResourceCount == 5);
+}
+
+int main()
+{
+    testUpscalerContexts();
+    testSeparateContents();
+    FFX_TEST_CHECK(s_AllocatedResources == 0);
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// The device-free part of the DX12 pipeline cache: keys must not change between runs or builds, since they name the
+// pipelines stored in serialized libraries, and blobs with a wrong header, size or checksum must be rejected.
+
+#include "ffx_dx12_pipeline_cache.h"
+#include "ffx_test.h"
+
+#include <string.h>
+#include <vector>
+#include <wchar.h>
+
+static const uint8_t s_RootSignature[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+static const char    s_ShaderBytecode[]  = "DXBC shader bytecode";
+
+static void testKeyStability()
+{
+    // FNV-1a reference values
+    FFX_TEST_CHECK(hashPipelineCacheBytes(FFX_PIPELINE_CACHE_HASH_BASIS, nullptr, 0) == FFX_PIPELINE_CACHE_HASH_BASIS);
+    FFX_TEST_CHECK(hashPipelineCacheBytes(FFX_PIPELINE_CACHE_HASH_BASIS, "a", 1) == 0xaf63dc4c8601ec8cull);
+
+    const uint64_t rootSignatureHash = getRootSignatureHash(s_RootSignature, sizeof(s_RootSignature));
+    FFX_TEST_CHECK(rootSignatureHash == 0xe0b1906ded607c25ull);
+
+    const uint64_t key = getPipelineStateKey(rootSignatureHash, s_ShaderBytecode, strlen(s_ShaderBytecode));
+    FFX_TEST_CHECK(key == 0x72bfd5234499c528ull);
+
+    wchar_t name[FFX_PIPELINE_LIBRARY_NAME_LENGTH];
+    getPipelineLibraryName(key, name);
+    FFX_TEST_CHECK(wcscmp(name, L"ffx72bfd5234499c528") == 0);
+
+    // Either input changes the key, and the root signature size is part of its hash.
+    FFX_TEST_CHECK(getPipelineStateKey(rootSignatureHash + 1, s_ShaderBytecode, strlen(s_ShaderBytecode)) != key);
+    FFX_TEST_CHECK(getPipelineStateKey(rootSignatureHash, s_ShaderBytecode, strlen(s_ShaderBytecode) - 1) != key);
+    FFX_TEST_CHECK(getRootSignatureHash(s_RootSignature, sizeof(s_RootSignature) - 1) != rootSignatureHash);
+}
+
+// A blob as ffxGetPipelineLibraryDataDX12 writes it
+static std::vector<uint8_t> makeBlob(size_t libraryDataSize)
+{
+    std::vector<uint8_t> blob(sizeof(PipelineLibraryBlobHeader) + libraryDataSize);
+    for (size_t i = 0; i < libraryDataSize; ++i)
+        blob[sizeof(PipelineLibraryBlobHeader) + i] = (uint8_t)(i * 31 + 7);
+
+    const PipelineLibraryBlobHeader header = getPipelineLibraryBlobHeader(blob.data() + sizeof(PipelineLibraryBlobHeader), libraryDataSize);
+    memcpy(blob.data(), &header, sizeof(header));
+    return blob;
+}
+
+static void patchHeader(std::vector<uint8_t>& blob, size_t offset, uint32_t value)
+{
+    memcpy(blob.data() + offset, &value, sizeof(value));
+}
+
+static void testBlobValidation()
+{
+    const std::vector<uint8_t> blob = makeBlob(4096);
+    FFX_TEST_CHECK(validatePipelineLibraryBlob(blob.data(), blob.size()));
+
+    // Truncated, with trailing bytes, and too short to hold the header
+    FFX_TEST_CHECK(!validatePipelineLibraryBlob(blob.data(), blob.size() - 1));
+    std::vector<uint8_t> padded = blob;
+    padded.push_back(0);
+    FFX_TEST_CHECK(!validatePipelineLibraryBlob(padded.data(), padded.size()));
+    FFX_TEST_CHECK(!validatePipelineLibraryBlob(blob.data(), sizeof(PipelineLibraryBlobHeader) - 1));
+
+    // An empty library is never written
+    const std::vector<uint8_t> empty = makeBlob(0);
+    FFX_TEST_CHECK(!validatePipelineLibraryBlob(empty.data(), empty.size()));
+
+    std::vector<uint8_t> badMagic = blob;
+    patchHeader(badMagic, offsetof(PipelineLibraryBlobHeader, magic), FFX_PIPELINE_LIBRARY_BLOB_MAGIC + 1);
+    FFX_TEST_CHECK(!validatePipelineLibraryBlob(badMagic.data(), badMagic.size()));
+
+    std::vector<uint8_t> badVersion = blob;
+    patchHeader(badVersion, offsetof(PipelineLibraryBlobHeader, version), FFX_PIPELINE_LIBRARY_BLOB_VERSION + 1);
+    FFX_TEST_CHECK(!validatePipelineLibraryBlob(badVersion.data(), badVersion.size()));
+
+    // A size that disagrees with the blob, even when the checksum covers the bytes it claims
+    std::vector<uint8_t> badSize = blob;
+    PipelineLibraryBlobHeader shorter = getPipelineLibraryBlobHeader(blob.data() + sizeof(PipelineLibraryBlobHeader), 4095);
+    memcpy(badSize.data(), &shorter, sizeof(shorter));
+    FFX_TEST_CHECK(!validatePipelineLibraryBlob(badSize.data(), badSize.size()));
+
+    // Any flipped bit of the data or the checksum
+    for (size_t offset : { sizeof(PipelineLibraryBlobHeader), blob.size() / 2, blob.size() - 1, offsetof(PipelineLibraryBlobHeader, checksum) })
+    {
+        std::vector<uint8_t> corrupt = blob;
+        corrupt[offset] ^= 0x10;
+        FFX_TEST_CHECK(!validatePipelineLibraryBlob(corrupt.data(), corrupt.size()));
+    }
+}
+
+int main()
+{
+    testKeyStability();
+    testBlobValidation();
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,198 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Frame interpolation prepare over a fake backend that records the GPU jobs it is given.
+// Checks that a prepare with FFX_FRAMEINTERPOLATION_PREPARE_SKIP_RECONSTRUCT, used when the upscaler already produced the
+// dilated intermediates this frame, schedules and executes nothing but still stages the frame's constants.
+
+#include <FidelityFX/host/ffx_frameinterpolation.h>
+#include "ffx_frameinterpolation_private.h"
+#include "ffx_test.h"
+
+#include <cstring>
+#include <vector>
+
+static uint32_t s_ComputeJobCount  = 0;
+static uint32_t s_ClearJobCount    = 0;
+static uint32_t s_ExecuteCount     = 0;
+static uint32_t s_StagedCount      = 0;
+static std::vector<uint8_t> s_LastStagedConstants;
+
+static FfxVersionNumber getSDKVersion(FfxInterface*)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+static FfxErrorCode createBackendContext(FfxInterface*, FfxEffect, FfxEffectBindlessConfig*, FfxUInt32* effectContextId)
+{
+    *effectContextId = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode getDeviceCapabilities(FfxInterface*, FfxDeviceCapabilities* deviceCapabilities)
+{
+    memset(deviceCapabilities, 0, sizeof(*deviceCapabilities));
+    deviceCapabilities->maximumSupportedShaderModel = FFX_SHADER_MODEL_6_6;
+    deviceCapabilities->waveLaneCountMin            = 32;
+    deviceCapabilities->waveLaneCountMax            = 64;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyBackendContext(FfxInterface*, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode createResource(FfxInterface*, const FfxCreateResourceDescription* createResourceDescription, FfxUInt32, FfxResourceInternal* outResource)
+{
+    outResource->internalIndex = (int32_t)createResourceDescription->id;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyResource(FfxInterface*, FfxResourceInternal, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode createPipeline(FfxInterface*, FfxEffect, FfxPass, uint32_t, const FfxPipelineDescription*, FfxUInt32, FfxPipelineState* outPipeline)
+{
+    memset(outPipeline, 0, sizeof(*outPipeline));
+    outPipeline->pipeline = (FfxPipeline)outPipeline;
+    return FFX_OK;
+}
+
+static FfxErrorCode destroyPipeline(FfxInterface*, FfxPipelineState* pipeline, FfxUInt32)
+{
+    pipeline->pipeline = nullptr;
+    return FFX_OK;
+}
+
+static FfxErrorCode registerResource(FfxInterface*, const FfxResource*, FfxUInt32, FfxResourceInternal* outResource)
+{
+    outResource->internalIndex = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode unregisterResources(FfxInterface*, FfxCommandList, FfxUInt32)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode stageConstantBufferData(FfxInterface*, void* data, FfxUInt32 size, FfxConstantBuffer*)
+{
+    ++s_StagedCount;
+    s_LastStagedConstants.assign((const uint8_t*)data, (const uint8_t*)data + size);
+    return FFX_OK;
+}
+
+static FfxErrorCode scheduleGpuJob(FfxInterface*, const FfxGpuJobDescription* job)
+{
+    s_ComputeJobCount += job->jobType == FFX_GPU_JOB_COMPUTE;
+    s_ClearJobCount += job->jobType == FFX_GPU_JOB_CLEAR_FLOAT;
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobs(FfxInterface*, FfxCommandList, FfxUInt32)
+{
+    ++s_ExecuteCount;
+    return FFX_OK;
+}
+
+static void resetCounts()
+{
+    s_ComputeJobCount = s_ClearJobCount = s_ExecuteCount = s_StagedCount = 0;
+}
+
+static bool stagedJitter(float x, float y)
+{
+    FrameInterpolationConstants constants = {};
+    if (s_LastStagedConstants.size() != sizeof(constants))
+        return false;
+    memcpy(&constants, s_LastStagedConstants.data(), sizeof(constants));
+    return constants.jitter[0] == x && constants.jitter[1] == y;
+}
+
+int main()
+{
+    FfxFrameInterpolationContextDescription contextDescription = {};
+    contextDescription.flags            = FFX_FRAMEINTERPOLATION_ENABLE_DEPTH_INVERTED;
+    contextDescription.maxRenderSize    = {1280, 720};
+    contextDescription.displaySize      = {1920, 1080};
+    contextDescription.backBufferFormat = FFX_SURFACE_FORMAT_R8G8B8A8_UNORM;
+    contextDescription.previousInterpolationSourceFormat = FFX_SURFACE_FORMAT_R8G8B8A8_UNORM;
+
+    FfxInterface& backendInterface                 = contextDescription.backendInterface;
+    backendInterface.device                        = (FfxDevice)0x100;
+    backendInterface.fpGetSDKVersion               = getSDKVersion;
+    backendInterface.fpCreateBackendContext        = createBackendContext;
+    backendInterface.fpGetDeviceCapabilities       = getDeviceCapabilities;
+    backendInterface.fpDestroyBackendContext       = destroyBackendContext;
+    backendInterface.fpCreateResource              = createResource;
+    backendInterface.fpDestroyResource             = destroyResource;
+    backendInterface.fpCreatePipeline              = createPipeline;
+    backendInterface.fpDestroyPipeline             = destroyPipeline;
+    backendInterface.fpRegisterResource            = registerResource;
+    backendInterface.fpUnregisterResources         = unregisterResources;
+    backendInterface.fpStageConstantBufferDataFunc = stageConstantBufferData;
+    backendInterface.fpScheduleGpuJob              = scheduleGpuJob;
+    backendInterface.fpExecuteGpuJobs              = executeGpuJobs;
+
+    FfxFrameInterpolationContext context;
+    FFX_TEST_CHECK(ffxFrameInterpolationContextCreate(&context, &contextDescription) == FFX_OK);
+
+    FfxFrameInterpolationPrepareDescription prepare = {};
+    prepare.commandList            = (FfxCommandList)0x200;
+    prepare.renderSize             = {1280, 720};
+    prepare.jitterOffset           = {0.25f, -0.25f};
+    prepare.motionVectorScale      = {1280.0f, 720.0f};
+    prepare.depth.resource         = (void*)0x300;
+    prepare.motionVectors.resource = (void*)0x301;
+    prepare.dilatedDepth.resource           = (void*)0x302;
+    prepare.dilatedMotionVectors.resource   = (void*)0x303;
+    prepare.reconstructedPrevDepth.resource = (void*)0x304;
+
+    // Frame interpolation reconstructs the intermediates itself.
+    resetCounts();
+    FFX_TEST_CHECK(ffxFrameInterpolationPrepare(&context, &prepare) == FFX_OK);
+    FFX_TEST_CHECK(s_ClearJobCount == 1);
+    FFX_TEST_CHECK(s_ComputeJobCount == 1);
+    FFX_TEST_CHECK(s_ExecuteCount == 1);
+    FFX_TEST_CHECK(s_StagedCount == 1);
+    FFX_TEST_CHECK(stagedJitter(0.25f, -0.25f));
+
+    // The upscaler produced them, the clear and the reconstruct and dilate dispatch are skipped.
+    resetCounts();
+    prepare.flags          = FFX_FRAMEINTERPOLATION_PREPARE_SKIP_RECONSTRUCT;
+    prepare.jitterOffset   = {-0.125f, 0.375f};
+    prepare.depth          = {};
+    prepare.motionVectors  = {};
+    FFX_TEST_CHECK(ffxFrameInterpolationPrepare(&context, &prepare) == FFX_OK);
+    FFX_TEST_CHECK(s_ClearJobCount == 0);
+    FFX_TEST_CHECK(s_ComputeJobCount == 0);
+    FFX_TEST_CHECK(s_ExecuteCount == 0);
+    FFX_TEST_CHECK(s_StagedCount == 1);
+    FFX_TEST_CHECK(stagedJitter(-0.125f, 0.375f));
+
+    FFX_TEST_CHECK(ffxFrameInterpolationContextDestroy(&context) == FFX_OK);
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,343 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// ffxLpmFilterCpu against a double precision transcription of LpmMap() and the filter pass for every color space and
+// display mode, then checks of the constant setup it shares with the GPU dispatch, the argument validation, and
+// timings of a 1920x1080 image per display mode. The GPU pass is not timed here since the test runs without a device.
+
+#include <FidelityFX/host/ffx_lpm.h>
+#include "ffx_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#define FFX_CPU
+#include <FidelityFX/gpu/ffx_core.h>
+#include "ffx_lpm_private.h"
+
+typedef std::vector<float> Image;
+
+static const uint32_t s_ColorSpaceCount  = 3;   // FFX_LPM_ColorSapce_Display has no constant setup
+static const uint32_t s_DisplayModeCount = 5;
+// Below one step of an 8-bit output. The float rounding is amplified by the steep start of the gamma and PQ curves.
+static const double   s_MaxError         = 1.0 / 256.0;
+
+static FfxLpmDispatchDescription makeDescription(FfxLpmColorSpace colorSpace, FfxLpmDisplayMode displayMode)
+{
+    FfxLpmDispatchDescription description = {};
+    description.shoulder                  = true;
+    description.softGap                   = 0.005f;
+    description.hdrMax                    = 64.0f;
+    description.lpmExposure               = 6.0f;
+    description.contrast                  = 0.2f;
+    description.shoulderContrast          = 1.1f;
+    description.saturation[0]             = 0.1f;
+    description.saturation[1]             = -0.1f;
+    description.crosstalk[0]              = 1.0f;
+    description.crosstalk[1]              = 0.5f;
+    description.crosstalk[2]              = 1.0f / 32.0f;
+    description.colorSpace                = colorSpace;
+    description.displayMode               = displayMode;
+    description.displayRedPrimary[0]      = 0.68f;
+    description.displayRedPrimary[1]      = 0.32f;
+    description.displayGreenPrimary[0]    = 0.265f;
+    description.displayGreenPrimary[1]    = 0.69f;
+    description.displayBluePrimary[0]     = 0.15f;
+    description.displayBluePrimary[1]     = 0.06f;
+    description.displayWhitePoint[0]      = 0.3127f;
+    description.displayWhitePoint[1]      = 0.329f;
+    description.displayMinLuminance       = 0.01f;
+    description.displayMaxLuminance       = 1000.0f;
+    return description;
+}
+
+// LpmMap() followed by the output encoding of the filter pass, in double precision from the packed control block.
+static void referenceFilter(const LpmConstants& constants, double color[3])
+{
+    float control[24 * 4];
+    memcpy(control, constants.ctl, sizeof(control));
+    auto c = [&](uint32_t row, uint32_t column) { return (double)control[row * 4 + column]; };
+
+    const double lumaW[3]    = { c(6, 1), c(6, 2), c(6, 3) };
+    const double lumaT[3]    = { c(1, 2), c(1, 3), c(2, 0) };
+    const double rcpLumaT[3] = { c(3, 0), c(3, 1), c(3, 2) };
+    const double saturation[3] = { c(0, 0), c(0, 1), c(0, 2) };
+    const double crosstalk[3]  = { c(2, 1), c(2, 2), c(2, 3) };
+    const double toneScaleBias[2] = { c(1, 0), c(1, 1) };
+    const double softGap[2]       = { c(7, 0), c(7, 1) };
+    const double con[3][3]  = { { c(7, 2), c(7, 3), c(8, 0) }, { c(8, 1), c(8, 2), c(8, 3) }, { c(9, 0), c(9, 1), c(9, 2) } };
+    const double con2[3][3] = { { c(3, 3), c(4, 0), c(4, 1) }, { c(4, 2), c(4, 3), c(5, 0) }, { c(5, 1), c(5, 2), c(5, 3) } };
+    const double contrast = c(0, 3), shoulderContrast = c(6, 0);
+
+    auto saturate = [](double x) { return x > 0.0 ? (x < 1.0 ? x : 1.0) : 0.0; };
+    auto power    = [](double x, double y) { return std::exp2(std::log2(x) * y); };
+    auto dot      = [](const double a[3], const double b[3]) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+
+    const double rcpMax = 1.0 / std::max(color[0], std::max(color[1], color[2]));
+    double ratio[3];
+    for (uint32_t i = 0; i < 3; ++i)
+        ratio[i] = power(color[i] * rcpMax, saturation[i]);
+
+    double luma = power(dot(constants.soft ? lumaW : lumaT, color), contrast);
+    const double lumaShoulder = constants.shoulder ? power(luma, shoulderContrast) : luma;
+    luma = luma / (lumaShoulder * toneScaleBias[0] + toneScaleBias[1]);
+
+    if (constants.soft)
+    {
+        if (constants.con)
+        {
+            const double unconverted[3] = { ratio[0], ratio[1], ratio[2] };
+            for (uint32_t i = 0; i < 3; ++i)
+                ratio[i] = dot(con[i], unconverted);
+            const double rcpRatioMax = 1.0 / std::max(ratio[0], std::max(ratio[1], ratio[2]));
+            for (uint32_t i = 0; i < 3; ++i)
+                ratio[i] *= rcpRatioMax;
+        }
+        for (uint32_t i = 0; i < 3; ++i)
+            ratio[i] = std::min(std::max(softGap[0], saturate(ratio[i] - ratio[i] * softGap[0])), saturate(softGap[0] * std::exp2(ratio[i] * softGap[1])));
+    }
+
+    const double ratioScale = saturate(luma / dot(ratio, lumaT));
+    for (uint32_t i = 0; i < 3; ++i)
+        color[i] = saturate(ratio[i] * ratioScale);
+
+    double crosstalkColor[3];
+    for (uint32_t i = 0; i < 3; ++i)
+        crosstalkColor[i] = crosstalk[i] - crosstalk[i] * color[i];
+    double lumaAdd = saturate(luma - dot(color, lumaT));
+    const double t = lumaAdd / dot(crosstalkColor, lumaT);
+    for (uint32_t i = 0; i < 3; ++i)
+        color[i] = saturate(t * crosstalkColor[i] + color[i]);
+    lumaAdd = saturate(luma - dot(color, lumaT));
+    for (uint32_t i = 0; i < 3; ++i)
+        color[i] = saturate(lumaAdd * rcpLumaT[i] + color[i]);
+
+    if (constants.con2)
+    {
+        const double unconverted[3] = { color[0], color[1], color[2] };
+        for (uint32_t i = 0; i < 3; ++i)
+            color[i] = constants.clip ? saturate(dot(con2[i], unconverted)) : dot(con2[i], unconverted);
+    }
+    if (constants.scaleOnly)
+    {
+        for (uint32_t i = 0; i < 3; ++i)
+            color[i] *= con2[0][0];
+    }
+
+    const FfxLpmDisplayMode displayMode = (FfxLpmDisplayMode)constants.displayMode;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        if (displayMode == FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR)
+            color[i] = power(color[i], 1.0 / 2.2);
+        else if (displayMode == FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084 || displayMode == FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_FSHDR_2084)
+        {
+            const double m1 = 2610.0 / 4096.0 / 4.0, m2 = 2523.0 / 4096.0 * 128.0;
+            const double c1 = 3424.0 / 4096.0, c2 = 2413.0 / 4096.0 * 32.0, c3 = 2392.0 / 4096.0 * 32.0;
+            const double cp = power(std::fabs(color[i]), m1);
+            color[i] = power((c1 + c2 * cp) / (1.0 + c3 * cp), m2);
+        }
+    }
+}
+
+// HDR content up to 64, with some black pixels and an odd width so the last quad of a row is partial.
+static Image makeInput(uint32_t width, uint32_t height)
+{
+    std::mt19937                          rng(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    Image                                 input(width * height * 4);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        const float value = distribution(rng);
+        input[i] = (i % 4 == 3) ? value : std::pow(value, 3.0f) * 64.0f * (distribution(rng) < 0.02f ? 0.0f : 1.0f);
+    }
+    return input;
+}
+
+static void testAgainstReference()
+{
+    const uint32_t width  = 643;
+    const uint32_t height = 360;
+    const Image    input  = makeInput(width, height);
+
+    // Padded output rows, the padding must be left alone
+    const size_t outputRowFloats = width * 4 + 8;
+    for (uint32_t colorSpace = 0; colorSpace < s_ColorSpaceCount; ++colorSpace)
+        for (uint32_t displayMode = 0; displayMode < s_DisplayModeCount; ++displayMode)
+        {
+            const FfxLpmDispatchDescription description = makeDescription((FfxLpmColorSpace)colorSpace, (FfxLpmDisplayMode)displayMode);
+            Image output(outputRowFloats * height, -1.0f);
+            FFX_TEST_CHECK(ffxLpmFilterCpu(&description, input.data(), output.data(), width, height, width * 4 * sizeof(float), outputRowFloats * sizeof(float)) == FFX_OK);
+
+            LpmSetupParameters setup;
+            lpmGetSetupParameters(&description, &setup);
+            LpmConstants constants;
+            lpmCalculateConstants(&setup, &constants);
+
+            double   maxError   = 0.0;
+            uint32_t mismatches = 0;
+            for (uint32_t y = 0; y < height; ++y)
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    const float* inputPixel  = &input[(y * width + x) * 4];
+                    const float* outputPixel = &output[y * outputRowFloats + x * 4];
+                    double       expected[3] = { inputPixel[0], inputPixel[1], inputPixel[2] };
+                    referenceFilter(constants, expected);
+                    for (uint32_t i = 0; i < 3; ++i)
+                    {
+                        if (std::isnan(expected[i]) || std::isnan(outputPixel[i]))
+                            mismatches += std::isnan(expected[i]) != std::isnan(outputPixel[i]);
+                        else
+                            maxError = std::max(maxError, std::fabs(outputPixel[i] - expected[i]) / std::max(1.0, std::fabs(expected[i])));
+                    }
+                    mismatches += outputPixel[3] != inputPixel[3];
+                }
+            for (uint32_t y = 0; y < height; ++y)
+                for (size_t i = width * 4; i < outputRowFloats; ++i)
+                    mismatches += output[y * outputRowFloats + i] != -1.0f;
+
+            if (maxError > s_MaxError || mismatches)
+                printf("color space %u, display mode %u: error %g, %u mismatches\n", colorSpace, displayMode, maxError, mismatches);
+            FFX_TEST_CHECK(maxError <= s_MaxError);
+            FFX_TEST_CHECK(mismatches == 0);
+
+            // In place gives the same result
+            Image inPlace = input;
+            FFX_TEST_CHECK(ffxLpmFilterCpu(&description, inPlace.data(), inPlace.data(), width, height, width * 4 * sizeof(float), width * 4 * sizeof(float)) == FFX_OK);
+            for (uint32_t y = 0; y < height; ++y)
+                FFX_TEST_CHECK(memcmp(&inPlace[y * width * 4], &output[y * outputRowFloats], width * 4 * sizeof(float)) == 0);
+        }
+}
+
+static bool sameConstants(const FfxLpmDispatchDescription& a, const FfxLpmDispatchDescription& b)
+{
+    LpmSetupParameters setupA, setupB;
+    lpmGetSetupParameters(&a, &setupA);
+    lpmGetSetupParameters(&b, &setupB);
+    LpmConstants constantsA, constantsB;
+    lpmCalculateConstants(&setupA, &constantsA);
+    lpmCalculateConstants(&setupB, &constantsB);
+    return memcmp(&constantsA, &constantsB, sizeof(LpmConstants)) == 0;
+}
+
+static uint64_t setupHash(const FfxLpmDispatchDescription& description)
+{
+    LpmSetupParameters setup;
+    lpmGetSetupParameters(&description, &setup);
+    return lpmHashSetupParameters(&setup);
+}
+
+static void testConstants()
+{
+    for (uint32_t colorSpace = 0; colorSpace < s_ColorSpaceCount; ++colorSpace)
+        for (uint32_t displayMode = 0; displayMode < s_DisplayModeCount; ++displayMode)
+        {
+            const FfxLpmDispatchDescription description = makeDescription((FfxLpmColorSpace)colorSpace, (FfxLpmDisplayMode)displayMode);
+
+            // The setup only depends on its parameters, and the command list and resources are not among them
+            FfxLpmDispatchDescription other = description;
+            other.commandList               = (FfxCommandList)&other;
+            other.inputColor.resource       = &other;
+            FFX_TEST_CHECK(sameConstants(description, other));
+            FFX_TEST_CHECK(setupHash(description) == setupHash(other));
+
+            other          = description;
+            other.contrast = 0.3f;
+            FFX_TEST_CHECK(!sameConstants(description, other));
+            FFX_TEST_CHECK(setupHash(description) != setupHash(other));
+
+            // Every HDR mode scales its output by the display luminance, LDR ignores it
+            other                     = description;
+            other.displayMaxLuminance = 600.0f;
+            if (displayMode == (uint32_t)FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR)
+            {
+                FFX_TEST_CHECK(sameConstants(description, other));
+                FFX_TEST_CHECK(setupHash(description) == setupHash(other));
+            }
+            else
+                FFX_TEST_CHECK(!sameConstants(description, other));
+        }
+}
+
+static void testInvalidArguments()
+{
+    const FfxLpmDispatchDescription description = makeDescription(FfxLpmColorSpace::FFX_LPM_ColorSpace_REC709, FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_LDR);
+    Image                           image(16 * 4);
+    const size_t                    pitch = 16 * 4 * sizeof(float);
+
+    FFX_TEST_CHECK(ffxLpmFilterCpu(nullptr, image.data(), image.data(), 16, 1, pitch, pitch) == FfxErrorCode(FFX_ERROR_INVALID_POINTER));
+    FFX_TEST_CHECK(ffxLpmFilterCpu(&description, nullptr, image.data(), 16, 1, pitch, pitch) == FfxErrorCode(FFX_ERROR_INVALID_POINTER));
+    FFX_TEST_CHECK(ffxLpmFilterCpu(&description, image.data(), nullptr, 16, 1, pitch, pitch) == FfxErrorCode(FFX_ERROR_INVALID_POINTER));
+    FFX_TEST_CHECK(ffxLpmFilterCpu(&description, image.data(), image.data(), 16, 1, pitch - 1, pitch) == FfxErrorCode(FFX_ERROR_INVALID_SIZE));
+    FFX_TEST_CHECK(ffxLpmFilterCpu(&description, image.data(), image.data(), 16, 1, pitch, pitch - 1) == FfxErrorCode(FFX_ERROR_INVALID_SIZE));
+    FFX_TEST_CHECK(ffxLpmFilterCpu(&description, image.data(), image.data(), 0, 0, 0, 0) == FFX_OK);
+}
+
+static void benchmark()
+{
+    const uint32_t width  = 1920;
+    const uint32_t height = 1080;
+    const Image    input  = makeInput(width, height);
+    Image          output(input.size());
+
+    for (uint32_t displayMode = 0; displayMode < s_DisplayModeCount; ++displayMode)
+    {
+        const FfxLpmDispatchDescription description = makeDescription(FfxLpmColorSpace::FFX_LPM_ColorSpace_REC2020, (FfxLpmDisplayMode)displayMode);
+        FFX_TEST_CHECK(ffxLpmFilterCpu(&description, input.data(), output.data(), width, height, width * 4 * sizeof(float), width * 4 * sizeof(float)) == FFX_OK);
+
+        using Clock             = std::chrono::high_resolution_clock;
+        const uint32_t   runs   = 5;
+        Clock::time_point start = Clock::now();
+        for (uint32_t run = 0; run < runs; ++run)
+            ffxLpmFilterCpu(&description, input.data(), output.data(), width, height, width * 4 * sizeof(float), width * 4 * sizeof(float));
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / runs;
+        printf("%ux%u, display mode %u: %.2f ms, %.1f ns per pixel\n", width, height, displayMode, ns * 1e-6, ns / (width * height));
+    }
+
+    // The constant setup the dispatch skips when its parameters did not change
+    const FfxLpmDispatchDescription description = makeDescription(FfxLpmColorSpace::FFX_LPM_ColorSpace_REC2020, FfxLpmDisplayMode::FFX_LPM_DISPLAYMODE_HDR10_2084);
+    LpmSetupParameters              setup;
+    lpmGetSetupParameters(&description, &setup);
+    LpmConstants                    constants;
+    using Clock                     = std::chrono::high_resolution_clock;
+    const uint32_t    runs          = 10000;
+    Clock::time_point start         = Clock::now();
+    for (uint32_t run = 0; run < runs; ++run)
+    {
+        setup.hdrMax = 64.0f + (run & 1);
+        lpmCalculateConstants(&setup, &constants);
+    }
+    printf("constant setup: %.0f ns\n", std::chrono::duration<double, std::nano>(Clock::now() - start).count() / runs);
+}
+
+int main()
+{
+    testAgainstReference();
+    testConstants();
+    testInvalidArguments();
+    benchmark();
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,248 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// ffxSpdDownsampleCpu against a straightforward reference pyramid for a range of sizes, filters and channel counts,
+// then timings of a 3840x2160 chain for every thread count up to the hardware thread count. The GPU pass is not
+// timed here since the test runs without a device.
+
+#include <FidelityFX/host/ffx_spd.h>
+#include "ffx_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+typedef std::vector<float> Image;
+
+static float reduceQuad(FfxSpdDownsampleFilter filter, float a, float b, float c, float d)
+{
+    switch (filter)
+    {
+    case FFX_SPD_DOWNSAMPLE_FILTER_MIN: return std::min(std::min(a, b), std::min(c, d));
+    case FFX_SPD_DOWNSAMPLE_FILTER_MAX: return std::max(std::max(a, b), std::max(c, d));
+    default:                            return (a + b + c + d) * 0.25f;
+    }
+}
+
+// Halves a zero padded level, both dimensions are even.
+static Image reduceLevel(FfxSpdDownsampleFilter filter, uint32_t channels, const Image& level, uint32_t width, uint32_t height)
+{
+    const uint32_t nextWidth = width / 2;
+    Image          next(nextWidth * (height / 2) * channels);
+    for (uint32_t y = 0; y < height / 2; ++y)
+        for (uint32_t x = 0; x < nextWidth; ++x)
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                auto texel = [&](uint32_t tx, uint32_t ty) { return level[(ty * width + tx) * channels + c]; };
+                next[(y * nextWidth + x) * channels + c] =
+                    reduceQuad(filter, texel(2 * x, 2 * y), texel(2 * x + 1, 2 * y), texel(2 * x, 2 * y + 1), texel(2 * x + 1, 2 * y + 1));
+            }
+    return next;
+}
+
+// Copies the top left of a padded level into a tightly packed mip.
+static Image cropLevel(uint32_t channels, const Image& level, uint32_t levelWidth, uint32_t width, uint32_t height)
+{
+    Image mip(width * height * channels);
+    for (uint32_t y = 0; y < height; ++y)
+        std::copy_n(&level[y * levelWidth * channels], width * channels, &mip[y * width * channels]);
+    return mip;
+}
+
+// The GPU result: mip 0 is padded with zeros to whole 64x64 tiles, and mip 6 to 64x64 for the mips after it.
+static std::vector<Image> referenceChain(
+    FfxSpdDownsampleFilter filter, uint32_t channels, uint32_t width, uint32_t height, uint32_t mipCount, const Image& source)
+{
+    uint32_t levelWidth  = (width + 63) / 64 * 64;
+    uint32_t levelHeight = (height + 63) / 64 * 64;
+    Image    level(levelWidth * levelHeight * channels, 0.0f);
+    for (uint32_t y = 0; y < height; ++y)
+        std::copy_n(&source[y * width * channels], width * channels, &level[y * levelWidth * channels]);
+
+    std::vector<Image> mips;
+    for (uint32_t mip = 1; mip <= mipCount; ++mip)
+    {
+        const uint32_t mipWidth  = std::max(width >> mip, 1u);
+        const uint32_t mipHeight = std::max(height >> mip, 1u);
+        if (mip == 7)
+        {
+            level       = Image(64 * 64 * channels, 0.0f);
+            levelWidth  = 64;
+            levelHeight = 64;
+            for (uint32_t y = 0; y < std::max(height >> 6, 1u); ++y)
+                std::copy_n(&mips[5][y * std::max(width >> 6, 1u) * channels], std::max(width >> 6, 1u) * channels, &level[y * 64 * channels]);
+        }
+        level = reduceLevel(filter, channels, level, levelWidth, levelHeight);
+        levelWidth /= 2;
+        levelHeight /= 2;
+        mips.push_back(cropLevel(channels, level, levelWidth, mipWidth, mipHeight));
+    }
+    return mips;
+}
+
+// Runs the tasks serially in reverse, so the last strip is not the one to finish the chain.
+static void reverseParallelFor(void*, FfxSpdCpuTaskFunc fpTask, void* pTaskData, uint32_t taskCount)
+{
+    for (uint32_t task = taskCount; task-- > 0;)
+        fpTask(pTaskData, task);
+}
+
+static void testAgainstReference()
+{
+    static const uint32_t sizes[][2] = { { 1, 1 },     { 1, 2 },     { 2, 1 },     { 3, 3 },       { 1, 300 },   { 300, 1 },    { 65, 63 },   { 127, 129 },
+                                         { 256, 256 }, { 1000, 700 }, { 4096, 17 }, { 3, 4096 }, { 1920, 1080 }, { 4096, 4096 }, { 5000, 300 } };
+
+    std::mt19937                          rng(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (const auto& size : sizes)
+        for (uint32_t filterIndex = 0; filterIndex < 3; ++filterIndex)
+            for (uint32_t channels = 1; channels <= 4; ++channels)
+            {
+                const uint32_t               width  = size[0];
+                const uint32_t               height = size[1];
+                const FfxSpdDownsampleFilter filter = (FfxSpdDownsampleFilter)filterIndex;
+                if (width * height > 4096 * 2048 && channels > 1)
+                    continue;
+
+                Image source(width * height * channels);
+                for (float& value : source)
+                    value = distribution(rng);
+
+                // As many mips as the GPU pass, which stops at mip 6 past 4096.
+                uint32_t mipCount = 0;
+                while (mipCount < SPD_MAX_MIP_LEVELS && (std::max(width, height) >> (mipCount + 1)))
+                    ++mipCount;
+                const bool large = width > 4096 || height > 4096;
+                if (large)
+                    mipCount = std::min(mipCount, 6u);
+
+                const std::vector<Image> reference = referenceChain(filter, channels, width, height, mipCount, source);
+                std::vector<Image>       mips(mipCount);
+
+                FfxSpdCpuDownsampleDescription description = {};
+                description.downsampleFilter               = filter;
+                description.width                          = width;
+                description.height                         = height;
+                description.channelCount                   = channels;
+                description.mipCount                       = large ? mipCount : 0;
+                description.pSource                        = source.data();
+                description.sourceRowPitch                 = width * channels * sizeof(float);
+                description.threadCount                    = (width * height) % 3 + 1;
+                description.fpParallelFor                  = width == 65 ? reverseParallelFor : nullptr;
+                for (uint32_t mip = 0; mip < mipCount; ++mip)
+                {
+                    mips[mip].assign(reference[mip].size(), -1.0f);
+                    description.pMips[mip] = mips[mip].data();
+                }
+                FFX_TEST_CHECK(ffxSpdDownsampleCpu(&description) == FFX_OK);
+
+                // Min and max are exact, the mean may round differently as it is computed in a different order.
+                float maxError = 0.0f;
+                for (uint32_t mip = 0; mip < mipCount; ++mip)
+                    for (size_t i = 0; i < reference[mip].size(); ++i)
+                        maxError = std::max(maxError, std::fabs(reference[mip][i] - mips[mip][i]));
+                if (filter == FFX_SPD_DOWNSAMPLE_FILTER_MEAN ? maxError > 1e-5f : maxError != 0.0f)
+                {
+                    printf("%ux%u filter %u, %u channels: error %g\n", width, height, filterIndex, channels, maxError);
+                    FFX_TEST_CHECK(false);
+                }
+            }
+}
+
+static void testInvalidDescriptions()
+{
+    Image                          source(100 * 100);
+    Image                          mip(50 * 50);
+    FfxSpdCpuDownsampleDescription description = {};
+    description.width                          = 100;
+    description.height                         = 100;
+    description.channelCount                   = 5;
+    description.mipCount                       = 1;
+    description.pSource                        = source.data();
+    description.sourceRowPitch                 = 100 * sizeof(float);
+    description.pMips[0]                       = mip.data();
+    FFX_TEST_CHECK(ffxSpdDownsampleCpu(&description) == (FfxErrorCode)FFX_ERROR_INVALID_ARGUMENT);
+
+    description.channelCount = 1;
+    description.pMips[0]     = nullptr;
+    FFX_TEST_CHECK(ffxSpdDownsampleCpu(&description) == (FfxErrorCode)FFX_ERROR_INVALID_POINTER);
+
+    description.pMips[0]       = mip.data();
+    description.sourceRowPitch = 99 * sizeof(float);
+    FFX_TEST_CHECK(ffxSpdDownsampleCpu(&description) == (FfxErrorCode)FFX_ERROR_INVALID_SIZE);
+
+    description.sourceRowPitch = 100 * sizeof(float);
+    FFX_TEST_CHECK(ffxSpdDownsampleCpu(&description) == FFX_OK);
+}
+
+static void benchmark()
+{
+    const uint32_t width  = 3840;
+    const uint32_t height = 2160;
+    const uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (uint32_t channels : { 1u, 4u })
+    {
+        Image              source(width * height * channels, 0.5f);
+        std::vector<Image> mips(SPD_MAX_MIP_LEVELS);
+
+        FfxSpdCpuDownsampleDescription description = {};
+        description.downsampleFilter               = FFX_SPD_DOWNSAMPLE_FILTER_MAX;
+        description.width                          = width;
+        description.height                         = height;
+        description.channelCount                   = channels;
+        description.pSource                        = source.data();
+        description.sourceRowPitch                 = width * channels * sizeof(float);
+        for (uint32_t mip = 0; mip < SPD_MAX_MIP_LEVELS; ++mip)
+        {
+            mips[mip].resize(std::max(width >> (mip + 1), 1u) * std::max(height >> (mip + 1), 1u) * channels);
+            description.pMips[mip] = mips[mip].data();
+        }
+
+        for (uint32_t threads = 1; threads <= threadCount; ++threads)
+        {
+            description.threadCount = threads;
+            FFX_TEST_CHECK(ffxSpdDownsampleCpu(&description) == FFX_OK);
+
+            using Clock             = std::chrono::high_resolution_clock;
+            const uint32_t   runs   = 10;
+            Clock::time_point start = Clock::now();
+            for (uint32_t run = 0; run < runs; ++run)
+                ffxSpdDownsampleCpu(&description);
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / runs;
+            printf("%ux%u, %u channels, %u threads: %.2f ms, %.1f GB/s of mip 0\n",
+                width, height, channels, threads, ms, source.size() * sizeof(float) / (ms * 1e6));
+        }
+    }
+}
+
+int main()
+{
+    testAgainstReference();
+    testInvalidDescriptions();
+    benchmark();
+    return FFX_TEST_RESULT();
+}
@@ -0,0 +1,136 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// The SSSR blue noise without a GPU: ffxSssrGenerateBlueNoiseCpu and the shader function applied to the uploaded
+// values against a transcription of the prepare blue noise pass they replace. Built once as is and once with the SSE2
+// path compiled out, so both generator paths are checked.
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <FidelityFX/host/ffx_sssr.h>
+
+#define FFX_CPU
+#include <FidelityFX/gpu/ffx_core.h>
+#include <FidelityFX/gpu/sssr/ffx_sssr_blue_noise.h>
+
+#include "ffx_sssr_private.h"
+#include "ffx_test.h"
+
+namespace _noiseBuffers
+{
+#include "samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp.cpp"
+}
+
+static const uint32_t s_tileSize = FFX_SSSR_BLUE_NOISE_TILE_SIZE;
+
+// SampleRandomNumber() of the removed ffx_sssr_prepare_blue_noise_texture.h with sample_index 0.
+static float referenceSampleRandomNumber(uint32_t pixel_i, uint32_t pixel_j, uint32_t sample_dimension)
+{
+    pixel_i          = pixel_i & 127u;
+    pixel_j          = pixel_j & 127u;
+    sample_dimension = sample_dimension & 255u;
+
+    uint32_t value = uint32_t(_noiseBuffers::sobol_256spp_256d[sample_dimension]);
+
+    uint32_t originalIndex = (sample_dimension % 8u) + (pixel_i + pixel_j * 128u) * 8u;
+    value                  = value ^ uint32_t(_noiseBuffers::scramblingTile[(originalIndex / 512u) * 512u + originalIndex % 512u]);
+
+    return (value + 0.5f) / 256.0f;
+}
+
+// SampleRandomVector2D() of the removed pass followed by the store to its RG8 UNORM texture.
+static uint8_t referenceSample(uint32_t pixel_i, uint32_t pixel_j, uint32_t sample_dimension, uint32_t frameIndex)
+{
+    const float u         = fmodf(referenceSampleRandomNumber(pixel_i, pixel_j, sample_dimension) + (frameIndex & 0xFFu) * 1.61803398875f, 1.0f);
+    const float saturated = u < 0.0f ? 0.0f : (u > 1.0f ? 1.0f : u);
+    return uint8_t(lrintf(saturated * 255.0f));
+}
+
+static void testValues(std::vector<uint8_t>& values)
+{
+    // the scrambled values must fit the RG8 UINT texture
+    for (uint32_t i = 0; i < 256; ++i)
+        FFX_TEST_CHECK(_noiseBuffers::sobol_256spp_256d[i] >= 0 && _noiseBuffers::sobol_256spp_256d[i] < 256);
+    for (uint32_t i = 0; i < s_tileSize * s_tileSize * 8; ++i)
+        FFX_TEST_CHECK(_noiseBuffers::scramblingTile[i] >= 0 && _noiseBuffers::scramblingTile[i] < 256);
+
+    values.assign(s_tileSize * s_tileSize * 2, 0);
+    sssrGenerateBlueNoiseValues(values.data(), s_tileSize * 2);
+}
+
+static void testFrames(const std::vector<uint8_t>& values)
+{
+    // two cycles, the second one must repeat the first
+    const size_t         rowPitch = s_tileSize * 2;
+    std::vector<uint8_t> generated(rowPitch * s_tileSize);
+    uint32_t             mismatches = 0;
+    for (uint32_t frameIndex = 0; frameIndex < 512; ++frameIndex)
+    {
+        FFX_TEST_CHECK(ffxSssrGenerateBlueNoiseCpu(frameIndex, generated.data(), rowPitch) == FFX_OK);
+        for (uint32_t pixelJ = 0; pixelJ < s_tileSize; ++pixelJ)
+        {
+            for (uint32_t pixelI = 0; pixelI < s_tileSize; ++pixelI)
+            {
+                for (uint32_t dimension = 0; dimension < 2; ++dimension)
+                {
+                    const size_t  offset    = pixelJ * rowPitch + pixelI * 2 + dimension;
+                    const uint8_t reference = referenceSample(pixelI, pixelJ, dimension, frameIndex);
+                    const uint8_t shader    = uint8_t(FFX_SSSR_BlueNoiseSampleUnorm8(values[offset], frameIndex));
+                    if (generated[offset] != reference || shader != reference)
+                        ++mismatches;
+                }
+            }
+        }
+    }
+    FFX_TEST_CHECK(mismatches == 0);
+}
+
+static void testRowPitch()
+{
+    // a padded row pitch leaves the padding alone
+    const size_t         rowPitch = s_tileSize * 2 + 16;
+    std::vector<uint8_t> padded(rowPitch * s_tileSize, 0xCD);
+    std::vector<uint8_t> packed(s_tileSize * s_tileSize * 2);
+    FFX_TEST_CHECK(ffxSssrGenerateBlueNoiseCpu(7, padded.data(), rowPitch) == FFX_OK);
+    FFX_TEST_CHECK(ffxSssrGenerateBlueNoiseCpu(7, packed.data(), s_tileSize * 2) == FFX_OK);
+    for (uint32_t pixelJ = 0; pixelJ < s_tileSize; ++pixelJ)
+    {
+        FFX_TEST_CHECK(memcmp(padded.data() + pixelJ * rowPitch, packed.data() + pixelJ * s_tileSize * 2, s_tileSize * 2) == 0);
+        for (size_t i = s_tileSize * 2; i < rowPitch; ++i)
+            FFX_TEST_CHECK(padded[pixelJ * rowPitch + i] == 0xCD);
+    }
+
+    FFX_TEST_CHECK(ffxSssrGenerateBlueNoiseCpu(0, nullptr, s_tileSize * 2) == FfxErrorCode(FFX_ERROR_INVALID_POINTER));
+    FFX_TEST_CHECK(ffxSssrGenerateBlueNoiseCpu(0, packed.data(), s_tileSize * 2 - 1) == FfxErrorCode(FFX_ERROR_INVALID_SIZE));
+}
+
+int main()
+{
+    std::vector<uint8_t> values;
+    testValues(values);
+    testFrames(values);
+    testRowPitch();
+    return FFX_TEST_RESULT();
+}
@@ -20,36 +20,24 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
-#version 450
 
-#extension GL_GOOGLE_include_directive : require
-#extension GL_EXT_samplerless_texture_functions : require
+// Minimal checking helpers shared by the device-free SDK tests. Each test is a standalone executable registered with
+// CTest, returning non-zero when any check failed.
 
-#define SSSR_BIND_SRV_SOBOL_BUFFER             0
-#define SSSR_BIND_SRV_SCRAMBLING_TILE_BUFFER   1
+#pragma once
 
-#define SSSR_BIND_UAV_BLUE_NOISE_TEXTURE    2000
+#include <cstdio>
 
-#define SSSR_BIND_CB_SSSR   3000
+static int s_ffxTestFailures = 0;
 
-#include "sssr/ffx_sssr_callbacks_glsl.h"
-#include "sssr/ffx_sssr_prepare_blue_noise_texture.h"
+#define FFX_TEST_CHECK(cond)                                                        \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #cond);         \
+            ++s_ffxTestFailures;                                                    \
+        }                                                                           \
+    } while (0)
 
-#ifndef FFX_SSSR_THREAD_GROUP_WIDTH
-#define FFX_SSSR_THREAD_GROUP_WIDTH 8
-#endif // #ifndef FFX_SSSR_THREAD_GROUP_WIDTH
-#ifndef FFX_SSSR_THREAD_GROUP_HEIGHT
-#define FFX_SSSR_THREAD_GROUP_HEIGHT 8
-#endif // FFX_SSSR_THREAD_GROUP_HEIGHT
-#ifndef FFX_SSSR_THREAD_GROUP_DEPTH
-#define FFX_SSSR_THREAD_GROUP_DEPTH 1
-#endif // #ifndef FFX_SSSR_THREAD_GROUP_DEPTH
-#ifndef FFX_SSSR_NUM_THREADS
-#define FFX_SSSR_NUM_THREADS layout (local_size_x = FFX_SSSR_THREAD_GROUP_WIDTH, local_size_y = FFX_SSSR_THREAD_GROUP_HEIGHT, local_size_z = FFX_SSSR_THREAD_GROUP_DEPTH) in;
-#endif // #ifndef FFX_SSSR_NUM_THREADS
-
-FFX_SSSR_NUM_THREADS
-void main()
-{
-    PrepareBlueNoiseTexture(gl_GlobalInvocationID.xy);
-}
+#define FFX_TEST_RESULT() (s_ffxTestFailures ? (printf("%d checks failed\n", s_ffxTestFailures), 1) : 0)
@@ -0,0 +1,432 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Thread safety of the Vulkan backend over a fake device that only tracks buffers and host memory.
+// Worker threads stage constants, execute and end frames of their own effect contexts while another thread polls the
+// statistics and the main thread creates and destroys an extra effect context. Every round destroys all effect contexts,
+// so the locks are torn down and built again in the same scratch memory, and the statistics are read before and after.
+//
+// The backend calls a few instance level functions directly, which are defined here in place of the Vulkan loader's.
+// This only works when the backend is linked statically, see CMakeLists.txt.
+
+#include <FidelityFX/host/backends/vk/ffx_vk.h>
+#include "ffx_test.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t s_WorkerCount   = 6;
+static constexpr uint32_t s_RoundCount    = 8;
+static constexpr uint32_t s_FrameCount    = 2000;
+static constexpr uint32_t s_ConstantsSize = 256;
+
+// Fake device objects, keyed on the value of their handles
+static std::mutex                                s_objectMutex;
+static std::map<uint64_t, VkDeviceSize>          s_buffers;
+static std::map<uint64_t, std::vector<uint8_t>>  s_memory;
+static uint64_t                                  s_nextHandle = 1;
+
+static uint64_t createObject()
+{
+    return s_nextHandle++;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeCreateBuffer(VkDevice, const VkBufferCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkBuffer* pBuffer)
+{
+    std::lock_guard<std::mutex> lock{s_objectMutex};
+    const uint64_t handle = createObject();
+    s_buffers[handle] = pCreateInfo->size;
+    *pBuffer = (VkBuffer)handle;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL fakeDestroyBuffer(VkDevice, VkBuffer buffer, const VkAllocationCallbacks*)
+{
+    std::lock_guard<std::mutex> lock{s_objectMutex};
+    if (buffer != VK_NULL_HANDLE)
+        FFX_TEST_CHECK(s_buffers.erase((uint64_t)buffer) == 1);
+}
+
+static VKAPI_ATTR void VKAPI_CALL fakeGetBufferMemoryRequirements(VkDevice, VkBuffer buffer, VkMemoryRequirements* pMemoryRequirements)
+{
+    std::lock_guard<std::mutex> lock{s_objectMutex};
+    FFX_TEST_CHECK(s_buffers.count((uint64_t)buffer) == 1);
+    pMemoryRequirements->size           = s_buffers[(uint64_t)buffer];
+    pMemoryRequirements->alignment      = 256;
+    pMemoryRequirements->memoryTypeBits = 3;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeAllocateMemory(VkDevice, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks*, VkDeviceMemory* pMemory)
+{
+    std::lock_guard<std::mutex> lock{s_objectMutex};
+    const uint64_t handle = createObject();
+    s_memory[handle].resize((size_t)pAllocateInfo->allocationSize);
+    *pMemory = (VkDeviceMemory)handle;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL fakeFreeMemory(VkDevice, VkDeviceMemory memory, const VkAllocationCallbacks*)
+{
+    std::lock_guard<std::mutex> lock{s_objectMutex};
+    if (memory != VK_NULL_HANDLE)
+        FFX_TEST_CHECK(s_memory.erase((uint64_t)memory) == 1);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeMapMemory(VkDevice, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize, VkMemoryMapFlags, void** ppData)
+{
+    std::lock_guard<std::mutex> lock{s_objectMutex};
+    FFX_TEST_CHECK(s_memory.count((uint64_t)memory) == 1);
+    *ppData = s_memory[(uint64_t)memory].data() + offset;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL fakeUnmapMemory(VkDevice, VkDeviceMemory)
+{
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeBindBufferMemory(VkDevice, VkBuffer, VkDeviceMemory, VkDeviceSize)
+{
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL fakeFlushMappedMemoryRanges(VkDevice, uint32_t, const VkMappedMemoryRange*)
+{
+    return VK_SUCCESS;
+}
+
+static std::atomic<uint32_t> s_barrierCount{0};
+static std::atomic<uint32_t> s_barrier2Count{0};
+
+static VKAPI_ATTR void VKAPI_CALL fakeCmdPipelineBarrier(VkCommandBuffer, VkPipelineStageFlags, VkPipelineStageFlags, VkDependencyFlags, uint32_t, const VkMemoryBarrier*, uint32_t, const VkBufferMemoryBarrier*, uint32_t, const VkImageMemoryBarrier*)
+{
+    ++s_barrierCount;
+}
+
+static VKAPI_ATTR void VKAPI_CALL fakeCmdPipelineBarrier2(VkCommandBuffer, const VkDependencyInfoKHR*)
+{
+    ++s_barrier2Count;
+}
+
+static VKAPI_ATTR void VKAPI_CALL fakeCmdFillBuffer(VkCommandBuffer, VkBuffer, VkDeviceSize, VkDeviceSize, uint32_t)
+{
+}
+
+// Functions the backend does not load are left null, as they would be for a missing extension
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL fakeGetDeviceProcAddr(VkDevice, const char* pName)
+{
+    static const struct
+    {
+        const char*        name;
+        PFN_vkVoidFunction function;
+    } functions[] = {
+        { "vkCreateBuffer", (PFN_vkVoidFunction)fakeCreateBuffer },
+        { "vkDestroyBuffer", (PFN_vkVoidFunction)fakeDestroyBuffer },
+        { "vkGetBufferMemoryRequirements", (PFN_vkVoidFunction)fakeGetBufferMemoryRequirements },
+        { "vkAllocateMemory", (PFN_vkVoidFunction)fakeAllocateMemory },
+        { "vkFreeMemory", (PFN_vkVoidFunction)fakeFreeMemory },
+        { "vkMapMemory", (PFN_vkVoidFunction)fakeMapMemory },
+        { "vkUnmapMemory", (PFN_vkVoidFunction)fakeUnmapMemory },
+        { "vkBindBufferMemory", (PFN_vkVoidFunction)fakeBindBufferMemory },
+        { "vkFlushMappedMemoryRanges", (PFN_vkVoidFunction)fakeFlushMappedMemoryRanges },
+        { "vkCmdPipelineBarrier", (PFN_vkVoidFunction)fakeCmdPipelineBarrier },
+        { "vkCmdPipelineBarrier2KHR", (PFN_vkVoidFunction)fakeCmdPipelineBarrier2 },
+        { "vkCmdFillBuffer", (PFN_vkVoidFunction)fakeCmdFillBuffer },
+    };
+
+    for (const auto& entry : functions)
+    {
+        if (strcmp(entry.name, pName) == 0)
+            return entry.function;
+    }
+    return nullptr;
+}
+
+// Instance level functions the backend links against
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateBuffer(VkDevice device, const VkBufferCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkBuffer* pBuffer)
+{
+    return fakeCreateBuffer(device, pCreateInfo, pAllocator, pBuffer);
+}
+
+// The device supports synchronization2, whether or not the test enabled it
+VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateDeviceExtensionProperties(VkPhysicalDevice, const char*, uint32_t* pPropertyCount, VkExtensionProperties* pProperties)
+{
+    if (pProperties && *pPropertyCount >= 1)
+    {
+        memset(pProperties, 0, sizeof(VkExtensionProperties));
+        strcpy(pProperties->extensionName, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+    }
+    *pPropertyCount = 1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceProperties(VkPhysicalDevice, VkPhysicalDeviceProperties* pProperties)
+{
+    memset(pProperties, 0, sizeof(VkPhysicalDeviceProperties));
+    pProperties->limits.minUniformBufferOffsetAlignment = 256;
+    pProperties->limits.nonCoherentAtomSize             = 64;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceProperties2(VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties2* pProperties)
+{
+    vkGetPhysicalDeviceProperties(physicalDevice, &pProperties->properties);
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceFeatures(VkPhysicalDevice, VkPhysicalDeviceFeatures* pFeatures)
+{
+    memset(pFeatures, 0, sizeof(VkPhysicalDeviceFeatures));
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceFeatures2(VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures2* pFeatures)
+{
+    vkGetPhysicalDeviceFeatures(physicalDevice, &pFeatures->features);
+    for (VkBaseOutStructure* feature = (VkBaseOutStructure*)pFeatures->pNext; feature; feature = feature->pNext)
+    {
+        if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR)
+            ((VkPhysicalDeviceSynchronization2FeaturesKHR*)feature)->synchronization2 = VK_TRUE;
+    }
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceMemoryProperties(VkPhysicalDevice, VkPhysicalDeviceMemoryProperties* pMemoryProperties)
+{
+    memset(pMemoryProperties, 0, sizeof(VkPhysicalDeviceMemoryProperties));
+    pMemoryProperties->memoryTypeCount              = 2;
+    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    pMemoryProperties->memoryTypes[0].heapIndex     = 0;
+    pMemoryProperties->memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    pMemoryProperties->memoryTypes[1].heapIndex     = 0;
+    pMemoryProperties->memoryHeapCount              = 1;
+    pMemoryProperties->memoryHeaps[0].size          = 1ull << 30;
+    pMemoryProperties->memoryHeaps[0].flags         = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+}
+
+static bool statisticsAreZero(FfxInterface* backendInterface)
+{
+    FfxImageViewCacheStatisticsVK  imageViewStatistics;
+    FfxDescriptorStatisticsVK      descriptorStatistics;
+    FfxDescriptorPoolStatisticsVK  poolStatistics;
+    FfxConstantBufferStatisticsVK  constantBufferStatistics;
+    memset(&imageViewStatistics, 0xff, sizeof(imageViewStatistics));
+    memset(&descriptorStatistics, 0xff, sizeof(descriptorStatistics));
+    memset(&poolStatistics, 0xff, sizeof(poolStatistics));
+    memset(&constantBufferStatistics, 0xff, sizeof(constantBufferStatistics));
+
+    bool succeeded = ffxGetImageViewCacheStatisticsVK(backendInterface, &imageViewStatistics) == FFX_OK;
+    succeeded &= ffxGetDescriptorStatisticsVK(backendInterface, &descriptorStatistics) == FFX_OK;
+    succeeded &= ffxGetDescriptorPoolStatisticsVK(backendInterface, &poolStatistics) == FFX_OK;
+    succeeded &= ffxGetConstantBufferStatisticsVK(backendInterface, &constantBufferStatistics) == FFX_OK;
+
+    static const uint8_t zeros[256] = {};
+    return succeeded && memcmp(&imageViewStatistics, zeros, sizeof(imageViewStatistics)) == 0 &&
+           memcmp(&descriptorStatistics, zeros, sizeof(descriptorStatistics)) == 0 && memcmp(&poolStatistics, zeros, sizeof(poolStatistics)) == 0 &&
+           memcmp(&constantBufferStatistics, zeros, sizeof(constantBufferStatistics)) == 0;
+}
+
+// Frames of one effect context: a few constant buffers staged, checked, executed and the frame ended
+static void recordFrames(FfxInterface* backendInterface, FfxUInt32 effectContextId, FfxCommandList commandList, uint32_t frameCount)
+{
+    uint32_t constants[s_ConstantsSize / sizeof(uint32_t)];
+    for (uint32_t frame = 0; frame < frameCount; ++frame)
+    {
+        FfxConstantBuffer constantBuffers[4] = {};
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            for (uint32_t& value : constants)
+                value = (effectContextId << 24) ^ (frame << 4) ^ i;
+            FFX_TEST_CHECK(backendInterface->fpStageConstantBufferDataFunc(backendInterface, constants, sizeof(constants), &constantBuffers[i]) == FFX_OK);
+        }
+
+        // constants of other threads never land in this thread's staging memory
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            FFX_TEST_CHECK(constantBuffers[i].num32BitEntries == s_ConstantsSize / sizeof(uint32_t));
+            FFX_TEST_CHECK(constantBuffers[i].data[0] == ((effectContextId << 24) ^ (frame << 4) ^ i));
+            FFX_TEST_CHECK(constantBuffers[i].data[constantBuffers[i].num32BitEntries - 1] == constantBuffers[i].data[0]);
+        }
+
+        FFX_TEST_CHECK(backendInterface->fpExecuteGpuJobs(backendInterface, commandList, effectContextId) == FFX_OK);
+        FFX_TEST_CHECK(backendInterface->fpUnregisterResources(backendInterface, commandList, effectContextId) == FFX_OK);
+    }
+}
+
+static void testThreadedRecording()
+{
+    VkDeviceContext deviceContext = {};
+    deviceContext.vkDevice         = (VkDevice)(uintptr_t)0x1000;
+    deviceContext.vkPhysicalDevice = (VkPhysicalDevice)(uintptr_t)0x2000;
+    deviceContext.vkDeviceProcAddr = fakeGetDeviceProcAddr;
+
+    const size_t maxContexts = s_WorkerCount + 1;
+    const size_t scratchSize = ffxGetScratchMemorySizeVK(deviceContext.vkPhysicalDevice, maxContexts);
+    void*        scratch     = calloc(1, scratchSize);
+
+    FfxInterface backendInterface = {};
+    FFX_TEST_CHECK(ffxGetInterfaceVK(&backendInterface, ffxGetDeviceVK(&deviceContext), scratch, scratchSize, maxContexts) == FFX_OK);
+
+    // nothing is locked before the first effect context is created
+    FFX_TEST_CHECK(statisticsAreZero(&backendInterface));
+    FFX_TEST_CHECK(ffxSetImageViewCacheBudgetVK(&backendInterface, 0) == FFX_OK);
+    FFX_TEST_CHECK(ffxReleaseImageViewsVK(&backendInterface, (VkImage)(uintptr_t)0x3000) == FFX_OK);
+    FFX_TEST_CHECK(ffxSetImageViewCacheBudgetVK(&backendInterface, 256) == FFX_OK);
+
+    uint32_t mainThreadCommandBuffer = 0;
+    const FfxCommandList mainThreadCommandList = ffxGetCommandListVK((VkCommandBuffer)&mainThreadCommandBuffer);
+
+    for (uint32_t round = 0; round < s_RoundCount; ++round)
+    {
+        FfxUInt32 effectContextIds[s_WorkerCount];
+        for (uint32_t worker = 0; worker < s_WorkerCount; ++worker)
+            FFX_TEST_CHECK(backendInterface.fpCreateBackendContext(&backendInterface, FFX_EFFECT_SPD, nullptr, &effectContextIds[worker]) == FFX_OK);
+
+        // the main thread keeps the recorder it bound in the previous round, which was freed with the last effect context
+        recordFrames(&backendInterface, effectContextIds[0], mainThreadCommandList, 1);
+
+        std::atomic<uint32_t> runningWorkers{s_WorkerCount};
+        std::vector<std::thread> threads;
+        for (uint32_t worker = 0; worker < s_WorkerCount; ++worker)
+        {
+            threads.emplace_back([&, worker]() {
+                uint32_t commandBuffer = 0;
+                recordFrames(&backendInterface, effectContextIds[worker], ffxGetCommandListVK((VkCommandBuffer)&commandBuffer), s_FrameCount);
+                --runningWorkers;
+            });
+        }
+
+        threads.emplace_back([&]() {
+            while (runningWorkers)
+            {
+                FfxImageViewCacheStatisticsVK imageViewStatistics = {};
+                FFX_TEST_CHECK(ffxGetImageViewCacheStatisticsVK(&backendInterface, &imageViewStatistics) == FFX_OK);
+
+                FfxDescriptorStatisticsVK descriptorStatistics = {};
+                FFX_TEST_CHECK(ffxGetDescriptorStatisticsVK(&backendInterface, &descriptorStatistics) == FFX_OK);
+                FFX_TEST_CHECK(descriptorStatistics.writeCount == 0);
+
+                FfxDescriptorPoolStatisticsVK poolStatistics = {};
+                FFX_TEST_CHECK(ffxGetDescriptorPoolStatisticsVK(&backendInterface, &poolStatistics) == FFX_OK);
+                FFX_TEST_CHECK(poolStatistics.setCount == 0);
+
+                FfxConstantBufferStatisticsVK constantBufferStatistics = {};
+                FFX_TEST_CHECK(ffxGetConstantBufferStatisticsVK(&backendInterface, &constantBufferStatistics) == FFX_OK);
+                FFX_TEST_CHECK(constantBufferStatistics.uniformBufferSize > 0);
+                FFX_TEST_CHECK(constantBufferStatistics.stagingOverflowCount == 0);
+            }
+        });
+
+        // an extra effect context comes and goes while the others record
+        while (runningWorkers)
+        {
+            FfxUInt32 extraContextId = 0;
+            FFX_TEST_CHECK(backendInterface.fpCreateBackendContext(&backendInterface, FFX_EFFECT_SPD, nullptr, &extraContextId) == FFX_OK);
+            recordFrames(&backendInterface, extraContextId, mainThreadCommandList, 4);
+            FFX_TEST_CHECK(backendInterface.fpDestroyBackendContext(&backendInterface, extraContextId) == FFX_OK);
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        FfxConstantBufferStatisticsVK constantBufferStatistics = {};
+        FFX_TEST_CHECK(ffxGetConstantBufferStatisticsVK(&backendInterface, &constantBufferStatistics) == FFX_OK);
+        FFX_TEST_CHECK(constantBufferStatistics.peakStagingUsage >= 4 * s_ConstantsSize);
+
+        for (uint32_t worker = 0; worker < s_WorkerCount; ++worker)
+            FFX_TEST_CHECK(backendInterface.fpDestroyBackendContext(&backendInterface, effectContextIds[worker]) == FFX_OK);
+
+        // the locks are gone with the last effect context, and so are the counters
+        FFX_TEST_CHECK(statisticsAreZero(&backendInterface));
+    }
+
+    // every buffer and allocation was released with the last effect context
+    FFX_TEST_CHECK(s_buffers.empty());
+    FFX_TEST_CHECK(s_memory.empty());
+
+    // the memory can be handed to a new backend interface once no effect context is left
+    FFX_TEST_CHECK(ffxGetInterfaceVK(&backendInterface, ffxGetDeviceVK(&deviceContext), scratch, scratchSize, maxContexts) == FFX_OK);
+    FFX_TEST_CHECK(statisticsAreZero(&backendInterface));
+
+    free(scratch);
+}
+
+// Barriers only go through vkCmdPipelineBarrier2KHR when the device was created with synchronization2 enabled,
+// supporting it is not enough
+static void testBarrierPath(VkBool32 synchronization2Enabled)
+{
+    VkDeviceContext deviceContext = {};
+    deviceContext.vkDevice         = (VkDevice)(uintptr_t)0x1000;
+    deviceContext.vkPhysicalDevice = (VkPhysicalDevice)(uintptr_t)0x2000;
+    deviceContext.vkDeviceProcAddr = fakeGetDeviceProcAddr;
+    deviceContext.synchronization2 = synchronization2Enabled;
+
+    const size_t scratchSize = ffxGetScratchMemorySizeVK(deviceContext.vkPhysicalDevice, 1);
+    void*        scratch     = calloc(1, scratchSize);
+
+    FfxInterface backendInterface = {};
+    FFX_TEST_CHECK(ffxGetInterfaceVK(&backendInterface, ffxGetDeviceVK(&deviceContext), scratch, scratchSize, 1) == FFX_OK);
+
+    FfxUInt32 effectContextId = 0;
+    FFX_TEST_CHECK(backendInterface.fpCreateBackendContext(&backendInterface, FFX_EFFECT_SPD, nullptr, &effectContextId) == FFX_OK);
+
+    FfxCreateResourceDescription createResourceDescription = {};
+    createResourceDescription.heapType                   = FFX_HEAP_TYPE_DEFAULT;
+    createResourceDescription.resourceDescription.type   = FFX_RESOURCE_TYPE_BUFFER;
+    createResourceDescription.resourceDescription.size   = 256;
+    createResourceDescription.resourceDescription.stride = sizeof(uint32_t);
+    createResourceDescription.resourceDescription.usage  = FFX_RESOURCE_USAGE_UAV;
+    createResourceDescription.initialState               = FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+    createResourceDescription.name                       = L"BarrierTarget";
+    createResourceDescription.initData.type              = FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED;
+
+    FfxResourceInternal resource = {};
+    FFX_TEST_CHECK(backendInterface.fpCreateResource(&backendInterface, &createResourceDescription, effectContextId, &resource) == FFX_OK);
+
+    FfxGpuJobDescription clearJob = {};
+    clearJob.jobType                   = FFX_GPU_JOB_CLEAR_FLOAT;
+    clearJob.clearJobDescriptor.target = resource;
+    FFX_TEST_CHECK(backendInterface.fpScheduleGpuJob(&backendInterface, &clearJob) == FFX_OK);
+
+    s_barrierCount  = 0;
+    s_barrier2Count = 0;
+    uint32_t commandBuffer = 0;
+    FFX_TEST_CHECK(backendInterface.fpExecuteGpuJobs(&backendInterface, ffxGetCommandListVK((VkCommandBuffer)&commandBuffer), effectContextId) == FFX_OK);
+    FFX_TEST_CHECK((synchronization2Enabled ? s_barrier2Count.load() : s_barrierCount.load()) > 0);
+    FFX_TEST_CHECK((synchronization2Enabled ? s_barrierCount.load() : s_barrier2Count.load()) == 0);
+
+    FFX_TEST_CHECK(backendInterface.fpDestroyResource(&backendInterface, resource, effectContextId) == FFX_OK);
+    FFX_TEST_CHECK(backendInterface.fpDestroyBackendContext(&backendInterface, effectContextId) == FFX_OK);
+    FFX_TEST_CHECK(s_buffers.empty());
+    FFX_TEST_CHECK(s_memory.empty());
+
+    free(scratch);
+}
+
+int main()
+{
+    testThreadedRecording();
+    testBarrierPath(VK_FALSE);
+    testBarrierPath(VK_TRUE);
+    return FFX_TEST_RESULT();
+}